@@ -0,0 +1,494 @@
+#include "Commands/UnrealCompanionActorIndex.h"
+#include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "EngineUtils.h"
+#include "Editor.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+#include "Algo/Sort.h"
+#include "Misc/StringBuilder.h"
+#include "String/Find.h"
+
+// Edge length of a spatial grid cell, in world units (100 m)
+static const double ActorGridCellSize = 10000.0;
+
+namespace
+{
+    template<typename KeyType>
+    void AddToBucket(TMap<KeyType, TArray<TWeakObjectPtr<AActor>>>& Map, const KeyType& Key, AActor* Actor)
+    {
+        Map.FindOrAdd(Key).AddUnique(Actor);
+    }
+
+    template<typename KeyType>
+    void RemoveFromBucket(TMap<KeyType, TArray<TWeakObjectPtr<AActor>>>& Map, const KeyType& Key, AActor* Actor)
+    {
+        if (TArray<TWeakObjectPtr<AActor>>* Bucket = Map.Find(Key))
+        {
+            // Also drops entries whose actor was garbage collected
+            Bucket->RemoveAllSwap([Actor](const TWeakObjectPtr<AActor>& Weak) { return !Weak.IsValid() || Weak.Get() == Actor; });
+            if (Bucket->Num() == 0)
+            {
+                Map.Remove(Key);
+            }
+        }
+    }
+
+    void AppendValid(const TArray<TWeakObjectPtr<AActor>>& Bucket, TArray<AActor*>& OutActors)
+    {
+        for (const TWeakObjectPtr<AActor>& Weak : Bucket)
+        {
+            if (AActor* Actor = Weak.Get())
+            {
+                if (IsValid(Actor))
+                {
+                    OutActors.Add(Actor);
+                }
+            }
+        }
+    }
+}
+
+FUnrealCompanionActorIndex& FUnrealCompanionActorIndex::Get()
+{
+    static FUnrealCompanionActorIndex Instance;
+    return Instance;
+}
+
+void FUnrealCompanionActorIndex::Initialize()
+{
+    check(IsInGameThread());
+    if (ActorAddedHandle.IsValid() || !GEngine)
+    {
+        return;
+    }
+
+    ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FUnrealCompanionActorIndex::OnActorAdded);
+    ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FUnrealCompanionActorIndex::OnActorDeleted);
+    ActorMovedHandle = GEngine->OnActorMoved().AddRaw(this, &FUnrealCompanionActorIndex::OnActorChanged);
+    LabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddRaw(this, &FUnrealCompanionActorIndex::OnActorChanged);
+    PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FUnrealCompanionActorIndex::OnObjectPropertyChanged);
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FUnrealCompanionActorIndex::OnLevelChanged);
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FUnrealCompanionActorIndex::OnLevelChanged);
+    UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FUnrealCompanionActorIndex::Invalidate);
+    MapOpenedHandle = FEditorDelegates::OnMapOpened.AddLambda([this](const FString&, bool) { Invalidate(); });
+    if (GEditor)
+    {
+        BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FUnrealCompanionActorIndex::Invalidate);
+    }
+}
+
+void FUnrealCompanionActorIndex::Shutdown()
+{
+    if (ActorAddedHandle.IsValid())
+    {
+        if (GEngine)
+        {
+            GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+            GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+            GEngine->OnActorMoved().Remove(ActorMovedHandle);
+        }
+        FCoreDelegates::OnActorLabelChanged.Remove(LabelChangedHandle);
+        FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+        FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+        FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+        FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+        FEditorDelegates::OnMapOpened.Remove(MapOpenedHandle);
+        if (GEditor)
+        {
+            GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+        }
+        ActorAddedHandle.Reset();
+    }
+
+    Invalidate();
+    ResetEntries();
+}
+
+// =========================================================================
+// BUILD / MAINTENANCE
+// =========================================================================
+
+void FUnrealCompanionActorIndex::EnsureBuilt(UWorld* World)
+{
+    check(IsInGameThread());
+    if (IndexedWorld.Get() == World)
+    {
+        return;
+    }
+
+    ResetEntries();
+    IndexedWorld = World;
+
+    if (!World)
+    {
+        return;
+    }
+
+    // The only full walk: once per world (or after an invalidation)
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        AddActor(*It);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("UnrealCompanionActorIndex: Indexed %d actors in %s"), Entries.Num(), *World->GetName());
+}
+
+FIntVector FUnrealCompanionActorIndex::CellFor(const FVector& Location)
+{
+    return FIntVector(
+        FMath::FloorToInt32(Location.X / ActorGridCellSize),
+        FMath::FloorToInt32(Location.Y / ActorGridCellSize),
+        FMath::FloorToInt32(Location.Z / ActorGridCellSize));
+}
+
+bool FUnrealCompanionActorIndex::IsIndexed(const AActor* Actor) const
+{
+    return IsValid(Actor) && IndexedWorld.IsValid() && Actor->GetWorld() == IndexedWorld.Get()
+        && !Actor->IsTemplate();
+}
+
+void FUnrealCompanionActorIndex::AddActor(AActor* Actor)
+{
+    if (!IsIndexed(Actor) || Entries.Contains(Actor))
+    {
+        return;
+    }
+
+    FEntry Entry;
+    Entry.Name = Actor->GetFName();
+    Entry.Label = FName(*Actor->GetActorLabel());
+    Entry.Tags = Actor->Tags;
+    Entry.ClassName = Actor->GetClass()->GetFName();
+    Entry.Cell = CellFor(Actor->GetActorLocation());
+
+    AddToBucket(ByName, Entry.Name, Actor);
+    AddToBucket(ByName, Entry.Label, Actor);
+    for (const FName& Tag : Entry.Tags)
+    {
+        AddToBucket(ByTag, Tag, Actor);
+    }
+    AddToBucket(ByClass, Entry.ClassName, Actor);
+    AddToBucket(Grid, Entry.Cell, Actor);
+
+    // OnActorMoved only fires for editor moves; the root's transform update fires for every move
+    if (USceneComponent* Root = Actor->GetRootComponent())
+    {
+        Entry.Root = Root;
+        Entry.RootMovedHandle = Root->TransformUpdated.AddLambda([this](USceneComponent* Component, EUpdateTransformFlags, ETeleportType)
+        {
+            UpdateCell(Component->GetOwner());
+        });
+    }
+
+    Entries.Add(Actor, MoveTemp(Entry));
+}
+
+void FUnrealCompanionActorIndex::RemoveActor(AActor* Actor)
+{
+    FEntry Entry;
+    if (!Entries.RemoveAndCopyValue(Actor, Entry))
+    {
+        return;
+    }
+
+    RemoveFromBucket(ByName, Entry.Name, Actor);
+    RemoveFromBucket(ByName, Entry.Label, Actor);
+    for (const FName& Tag : Entry.Tags)
+    {
+        RemoveFromBucket(ByTag, Tag, Actor);
+    }
+    RemoveFromBucket(ByClass, Entry.ClassName, Actor);
+    RemoveFromBucket(Grid, Entry.Cell, Actor);
+    if (USceneComponent* Root = Entry.Root.Get())
+    {
+        Root->TransformUpdated.Remove(Entry.RootMovedHandle);
+    }
+}
+
+void FUnrealCompanionActorIndex::UpdateCell(AActor* Actor)
+{
+    FEntry* Entry = IsValid(Actor) ? Entries.Find(Actor) : nullptr;
+    if (!Entry)
+    {
+        return;
+    }
+
+    const FIntVector Cell = CellFor(Actor->GetActorLocation());
+    if (Cell != Entry->Cell)
+    {
+        RemoveFromBucket(Grid, Entry->Cell, Actor);
+        AddToBucket(Grid, Cell, Actor);
+        Entry->Cell = Cell;
+    }
+}
+
+void FUnrealCompanionActorIndex::ResetEntries()
+{
+    for (TPair<TObjectKey<AActor>, FEntry>& Pair : Entries)
+    {
+        if (USceneComponent* Root = Pair.Value.Root.Get())
+        {
+            Root->TransformUpdated.Remove(Pair.Value.RootMovedHandle);
+        }
+    }
+
+    Entries.Reset();
+    ByName.Reset();
+    ByTag.Reset();
+    ByClass.Reset();
+    Grid.Reset();
+}
+
+void FUnrealCompanionActorIndex::ReindexActor(AActor* Actor)
+{
+    RemoveActor(Actor);
+    AddActor(Actor);
+}
+
+void FUnrealCompanionActorIndex::OnActorAdded(AActor* Actor)
+{
+    if (IndexedWorld.IsValid())
+    {
+        AddActor(Actor);
+    }
+}
+
+void FUnrealCompanionActorIndex::OnActorDeleted(AActor* Actor)
+{
+    if (IndexedWorld.IsValid())
+    {
+        RemoveActor(Actor);
+    }
+}
+
+void FUnrealCompanionActorIndex::OnActorChanged(AActor* Actor)
+{
+    if (IndexedWorld.IsValid() && Actor && Entries.Contains(Actor))
+    {
+        ReindexActor(Actor);
+    }
+}
+
+void FUnrealCompanionActorIndex::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+    // Tags (and transforms edited through the details panel) change through property edits
+    if (AActor* Actor = Cast<AActor>(Object))
+    {
+        OnActorChanged(Actor);
+    }
+    // So does the root component itself (its transform, or a new root after a component edit)
+    else if (USceneComponent* Component = Cast<USceneComponent>(Object))
+    {
+        AActor* Owner = Component->GetOwner();
+        if (Owner && Owner->GetRootComponent() == Component)
+        {
+            OnActorChanged(Owner);
+        }
+    }
+}
+
+void FUnrealCompanionActorIndex::OnLevelChanged(ULevel* Level, UWorld* World)
+{
+    if (World && World == IndexedWorld.Get())
+    {
+        Invalidate();
+    }
+}
+
+// =========================================================================
+// QUERIES
+// =========================================================================
+
+AActor* FUnrealCompanionActorIndex::FindByName(UWorld* World, const FString& NameOrLabel, const UClass* RequiredClass)
+{
+    if (NameOrLabel.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    EnsureBuilt(World);
+
+    // FName keys are case-insensitive; confirm the exact string on the candidates.
+    // FNAME_Find: a name no actor has must not grow the global name table.
+    const FName Key(*NameOrLabel, FNAME_Find);
+    const TArray<TWeakObjectPtr<AActor>>* Bucket = Key.IsNone() ? nullptr : ByName.Find(Key);
+    if (!Bucket)
+    {
+        return nullptr;
+    }
+
+    for (const TWeakObjectPtr<AActor>& Weak : *Bucket)
+    {
+        AActor* Actor = Weak.Get();
+        if (IsValid(Actor) && (Actor->GetName() == NameOrLabel || Actor->GetActorLabel() == NameOrLabel)
+            && (!RequiredClass || Actor->IsA(RequiredClass)))
+        {
+            return Actor;
+        }
+    }
+    return nullptr;
+}
+
+void FUnrealCompanionActorIndex::FindAllByName(UWorld* World, const FString& NameOrLabel, TArray<AActor*>& OutActors)
+{
+    EnsureBuilt(World);
+
+    const FName Key(*NameOrLabel, FNAME_Find);
+    if (Key.IsNone())
+    {
+        return;
+    }
+    if (const TArray<TWeakObjectPtr<AActor>>* Bucket = ByName.Find(Key))
+    {
+        AppendValid(*Bucket, OutActors);
+    }
+}
+
+void FUnrealCompanionActorIndex::FindByNameSubstring(UWorld* World, const FString& Pattern, TArray<AActor*>& OutActors)
+{
+    EnsureBuilt(World);
+
+    // Match against the distinct name/label keys rather than every actor, without allocating a string per key
+    TSet<AActor*> Seen;
+    TStringBuilder<256> KeyString;
+    for (const TPair<FName, TArray<TWeakObjectPtr<AActor>>>& Pair : ByName)
+    {
+        KeyString.Reset();
+        Pair.Key.AppendString(KeyString);
+        if (UE::String::FindFirst(KeyString.ToView(), Pattern, ESearchCase::IgnoreCase) == INDEX_NONE)
+        {
+            continue;
+        }
+
+        for (const TWeakObjectPtr<AActor>& Weak : Pair.Value)
+        {
+            AActor* Actor = Weak.Get();
+            bool bAlreadyAdded = false;
+            if (IsValid(Actor))
+            {
+                Seen.Add(Actor, &bAlreadyAdded);
+                if (!bAlreadyAdded)
+                {
+                    OutActors.Add(Actor);
+                }
+            }
+        }
+    }
+}
+
+void FUnrealCompanionActorIndex::GetAllActors(UWorld* World, TArray<AActor*>& OutActors)
+{
+    EnsureBuilt(World);
+
+    OutActors.Reserve(OutActors.Num() + Entries.Num());
+    for (const TPair<TObjectKey<AActor>, FEntry>& Pair : Entries)
+    {
+        AActor* Actor = Pair.Key.ResolveObjectPtr();
+        if (IsValid(Actor))
+        {
+            OutActors.Add(Actor);
+        }
+    }
+}
+
+void FUnrealCompanionActorIndex::FindByTag(UWorld* World, FName Tag, TArray<AActor*>& OutActors)
+{
+    EnsureBuilt(World);
+
+    if (const TArray<TWeakObjectPtr<AActor>>* Bucket = ByTag.Find(Tag))
+    {
+        AppendValid(*Bucket, OutActors);
+    }
+}
+
+void FUnrealCompanionActorIndex::FindByClassName(UWorld* World, const FString& ClassFilter, TArray<AActor*>& OutActors)
+{
+    EnsureBuilt(World);
+
+    // There are far fewer distinct classes than actors
+    for (const TPair<FName, TArray<TWeakObjectPtr<AActor>>>& Pair : ByClass)
+    {
+        if (Pair.Key.ToString().Contains(ClassFilter))
+        {
+            AppendValid(Pair.Value, OutActors);
+        }
+    }
+}
+
+void FUnrealCompanionActorIndex::GatherCandidatesInBox(const FBox& Box, TArray<AActor*>& OutActors) const
+{
+    const FIntVector MinCell = CellFor(Box.Min);
+    const FIntVector MaxCell = CellFor(Box.Max);
+    const int64 CellCount = (int64)(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1) * (MaxCell.Z - MinCell.Z + 1);
+
+    // A huge box touches more cells than there are occupied ones: walk the occupied cells instead
+    if (CellCount > Grid.Num())
+    {
+        for (const TPair<FIntVector, TArray<TWeakObjectPtr<AActor>>>& Pair : Grid)
+        {
+            const FIntVector& Cell = Pair.Key;
+            if (Cell.X >= MinCell.X && Cell.X <= MaxCell.X
+                && Cell.Y >= MinCell.Y && Cell.Y <= MaxCell.Y
+                && Cell.Z >= MinCell.Z && Cell.Z <= MaxCell.Z)
+            {
+                AppendValid(Pair.Value, OutActors);
+            }
+        }
+        return;
+    }
+
+    for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+        {
+            for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+            {
+                if (const TArray<TWeakObjectPtr<AActor>>* Bucket = Grid.Find(FIntVector(X, Y, Z)))
+                {
+                    AppendValid(*Bucket, OutActors);
+                }
+            }
+        }
+    }
+}
+
+void FUnrealCompanionActorIndex::FindInRadius(UWorld* World, const FVector& Center, double Radius, TArray<AActor*>& OutActors)
+{
+    EnsureBuilt(World);
+
+    TArray<AActor*> Candidates;
+    GatherCandidatesInBox(FBox(Center - FVector(Radius), Center + FVector(Radius)), Candidates);
+
+    const double RadiusSquared = Radius * Radius;
+    const int32 FirstResult = OutActors.Num();
+    for (AActor* Actor : Candidates)
+    {
+        if (FVector::DistSquared(Actor->GetActorLocation(), Center) <= RadiusSquared)
+        {
+            OutActors.Add(Actor);
+        }
+    }
+
+    // Nearest first, so max_results keeps the closest actors
+    TArrayView<AActor*> Results(OutActors.GetData() + FirstResult, OutActors.Num() - FirstResult);
+    Algo::SortBy(Results, [&Center](const AActor* Actor) { return FVector::DistSquared(Actor->GetActorLocation(), Center); });
+}
+
+void FUnrealCompanionActorIndex::FindInBox(UWorld* World, const FBox& Box, TArray<AActor*>& OutActors)
+{
+    EnsureBuilt(World);
+
+    TArray<AActor*> Candidates;
+    GatherCandidatesInBox(Box, Candidates);
+
+    for (AActor* Actor : Candidates)
+    {
+        if (Box.IsInsideOrOn(Actor->GetActorLocation()))
+        {
+            OutActors.Add(Actor);
+        }
+    }
+}
@@ -1,10 +1,16 @@
 #include "Commands/UnrealCompanionAssetCommands.h"
 #include "Commands/UnrealCompanionCommonUtils.h"
+#include "Commands/UnrealCompanionPackageSaver.h"
 #include "Commands/UnrealCompanionEditorFocus.h"
 #include "EditorAssetLibrary.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetRegistry/IAssetRegistry.h"
 #include "FileHelpers.h"
+#include "AssetToolsModule.h"
+#include "IAssetTools.h"
+#include "ObjectTools.h"
+#include "Misc/PackageName.h"
+#include "UObject/ObjectRedirector.h"
 #include "Engine/Blueprint.h"
 #include "Engine/StaticMesh.h"
 #include "Materials/Material.h"
@@ -121,6 +127,12 @@ static FString NormalizePath(const FString& Path)
     return NormalizedPath;
 }
 
+// "/Game/Dir/Asset" -> "/Game/Dir/Asset.Asset"
+static FSoftObjectPath ToObjectPath(const FString& PackagePath)
+{
+    return FSoftObjectPath(PackagePath + TEXT(".") + FPackageName::GetShortName(PackagePath));
+}
+
 // Helper to normalize folder path (ensure ends with /)
 static FString NormalizeFolderPath(const FString& Path)
 {
@@ -183,33 +195,14 @@ TSharedPtr<FJsonObject> FUnrealCompanionAssetCommands::HandleListAssets(const TS
     
     PathFilter = NormalizePath(PathFilter);
     
-    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    // Runs on a worker thread (AnyThread affinity): only use the thread-safe registry interface
+    IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
     
     // Build filter
     FARFilter Filter;
     if (!ClassFilter.IsEmpty())
     {
-        // Handle common class names
-        if (ClassFilter == TEXT("Blueprint"))
-        {
-            Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
-        }
-        else if (ClassFilter == TEXT("StaticMesh"))
-        {
-            Filter.ClassPaths.Add(UStaticMesh::StaticClass()->GetClassPathName());
-        }
-        else if (ClassFilter == TEXT("Material"))
-        {
-            Filter.ClassPaths.Add(UMaterial::StaticClass()->GetClassPathName());
-        }
-        else if (ClassFilter == TEXT("Texture2D"))
-        {
-            Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
-        }
-        else
-        {
-            Filter.ClassPaths.Add(FTopLevelAssetPath(TEXT("/Script/Engine"), *ClassFilter));
-        }
+        Filter.ClassPaths.Add(FUnrealCompanionCommonUtils::ResolveAssetClassPath(ClassFilter));
     }
     
     Filter.PackagePaths.Add(FName(*PathFilter));
@@ -476,15 +469,10 @@ TSharedPtr<FJsonObject> FUnrealCompanionAssetCommands::HandleSaveAll(const TShar
     bool bOnlyIfDirty = true;
     Params->TryGetBoolField(TEXT("only_if_dirty"), bOnlyIfDirty);
     
-    if (FEditorFileUtils::SaveDirtyPackages(/*bPromptUserToSave=*/false, /*bSaveMapPackages=*/true, /*bSaveContentPackages=*/true))
-    {
-        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-        ResultObj->SetBoolField(TEXT("success"), true);
-        ResultObj->SetStringField(TEXT("message"), TEXT("All dirty packages saved"));
-        return ResultObj;
-    }
-    
-    return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to save all packages"));
+    // Batched save: async file writes, time-sliced (deferred reply) for large batches
+    TArray<UPackage*> Packages;
+    FUnrealCompanionPackageSaver::GatherDirtyPackages(/*bIncludeMaps=*/true, /*bIncludeContent=*/true, Packages);
+    return FUnrealCompanionPackageSaver::Get().Save(Packages);
 }
 
 TSharedPtr<FJsonObject> FUnrealCompanionAssetCommands::HandleDoesAssetExist(const TSharedPtr<FJsonObject>& Params)
@@ -499,7 +487,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionAssetCommands::HandleDoesAssetExist(cons
     
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("path"), AssetPath);
-    ResultObj->SetBoolField(TEXT("exists"), UEditorAssetLibrary::DoesAssetExist(AssetPath));
+    ResultObj->SetBoolField(TEXT("exists"), FUnrealCompanionCommonUtils::DoesAssetExistInRegistry(AssetPath));
     return ResultObj;
 }
 
@@ -515,7 +503,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionAssetCommands::HandleDoesFolderExist(con
     
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("path"), FolderPath);
-    ResultObj->SetBoolField(TEXT("exists"), UEditorAssetLibrary::DoesDirectoryExist(FolderPath));
+    ResultObj->SetBoolField(TEXT("exists"), FUnrealCompanionCommonUtils::DoesFolderExistInRegistry(FolderPath));
     return ResultObj;
 }
 
@@ -541,6 +529,9 @@ TSharedPtr<FJsonObject> FUnrealCompanionAssetCommands::HandleModifyBatch(const T
         return FUnrealCompanionCommonUtils::CreateDryRunResponse(true, TArray<FString>(), TArray<FString>(), WouldDoData);
     }
     
+    bool bFixupRedirectors = false;
+    Params->TryGetBoolField(TEXT("fixup_redirectors"), bFixupRedirectors);
+    
     int32 Renamed = 0;
     int32 Moved = 0;
     int32 Duplicated = 0;
@@ -548,6 +539,27 @@ TSharedPtr<FJsonObject> FUnrealCompanionAssetCommands::HandleModifyBatch(const T
     TArray<TSharedPtr<FJsonObject>> Results;
     TArray<TSharedPtr<FJsonObject>> Errors;
     
+    auto AddError = [&Errors, &Failed](const FString& Path, const FString& Error)
+    {
+        Failed++;
+        TSharedPtr<FJsonObject> ErrorObj = MakeShared<FJsonObject>();
+        ErrorObj->SetStringField(TEXT("path"), Path);
+        ErrorObj->SetStringField(TEXT("error"), Error);
+        Errors.Add(ErrorObj);
+    };
+    
+    // Renames and moves are collected and submitted to AssetTools in one RenameAssets call,
+    // so reference fixup and redirector creation run once for the whole batch. An operation
+    // on the destination of an earlier one (rename then move) extends that pending entry.
+    struct FPendingRename
+    {
+        FString OldPath;
+        FString NewPath;
+        TArray<TSharedPtr<FJsonObject>> Results;  // One per operation folded into this entry
+    };
+    TArray<FPendingRename> PendingRenames;
+    TMap<FString, int32> PendingByNewPath;
+    
     for (int32 i = 0; i < OperationsArray->Num(); i++)
     {
         const TSharedPtr<FJsonObject>& OpObj = (*OperationsArray)[i]->AsObject();
@@ -556,57 +568,52 @@ TSharedPtr<FJsonObject> FUnrealCompanionAssetCommands::HandleModifyBatch(const T
         FString Action = OpObj->GetStringField(TEXT("action"));
         FString AssetPath = NormalizePath(OpObj->GetStringField(TEXT("path")));
         
-        if (!UEditorAssetLibrary::DoesAssetExist(AssetPath))
+        const int32* PendingIndex = PendingByNewPath.Find(AssetPath);
+        if (!PendingIndex && !UEditorAssetLibrary::DoesAssetExist(AssetPath))
         {
-            Failed++;
-            TSharedPtr<FJsonObject> ErrorObj = MakeShared<FJsonObject>();
-            ErrorObj->SetStringField(TEXT("path"), AssetPath);
-            ErrorObj->SetStringField(TEXT("error"), TEXT("Asset not found"));
-            Errors.Add(ErrorObj);
-            
+            AddError(AssetPath, TEXT("Asset not found"));
             if (StdParams.OnError == TEXT("stop")) break;
             continue;
         }
         
-        if (Action == TEXT("rename"))
+        if (Action == TEXT("rename") || Action == TEXT("move"))
         {
-            FString NewName = OpObj->GetStringField(TEXT("new_name"));
-            FString Directory = FPaths::GetPath(AssetPath);
-            FString NewPath = Directory / NewName;
-            
-            if (UEditorAssetLibrary::RenameAsset(AssetPath, NewPath))
+            FString NewPath;
+            if (Action == TEXT("rename"))
             {
-                Renamed++;
-                TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-                ResultObj->SetStringField(TEXT("action"), TEXT("rename"));
-                ResultObj->SetStringField(TEXT("old_path"), AssetPath);
-                ResultObj->SetStringField(TEXT("new_path"), NewPath);
-                Results.Add(ResultObj);
+                NewPath = FPaths::GetPath(AssetPath) / OpObj->GetStringField(TEXT("new_name"));
             }
             else
             {
-                Failed++;
+                NewPath = NormalizeFolderPath(OpObj->GetStringField(TEXT("destination"))) / FPaths::GetBaseFilename(AssetPath);
             }
-        }
-        else if (Action == TEXT("move"))
-        {
-            FString Destination = NormalizeFolderPath(OpObj->GetStringField(TEXT("destination")));
-            FString AssetName = FPaths::GetBaseFilename(AssetPath);
-            FString NewPath = Destination / AssetName;
             
-            if (UEditorAssetLibrary::RenameAsset(AssetPath, NewPath))
+            if (PendingByNewPath.Contains(NewPath) || UEditorAssetLibrary::DoesAssetExist(NewPath))
             {
-                Moved++;
-                TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-                ResultObj->SetStringField(TEXT("action"), TEXT("move"));
-                ResultObj->SetStringField(TEXT("old_path"), AssetPath);
-                ResultObj->SetStringField(TEXT("new_path"), NewPath);
-                Results.Add(ResultObj);
+                AddError(AssetPath, FString::Printf(TEXT("Destination already exists: %s"), *NewPath));
+                if (StdParams.OnError == TEXT("stop")) break;
+                continue;
+            }
+            
+            int32 EntryIndex;
+            if (PendingIndex)
+            {
+                EntryIndex = *PendingIndex;
+                PendingByNewPath.Remove(AssetPath);
             }
             else
             {
-                Failed++;
+                EntryIndex = PendingRenames.AddDefaulted();
+                PendingRenames[EntryIndex].OldPath = AssetPath;
             }
+            PendingRenames[EntryIndex].NewPath = NewPath;
+            PendingByNewPath.Add(NewPath, EntryIndex);
+            
+            TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+            ResultObj->SetStringField(TEXT("action"), Action);
+            ResultObj->SetStringField(TEXT("old_path"), AssetPath);
+            ResultObj->SetStringField(TEXT("new_path"), NewPath);
+            PendingRenames[EntryIndex].Results.Add(ResultObj);
         }
         else if (Action == TEXT("duplicate"))
         {
@@ -628,7 +635,9 @@ TSharedPtr<FJsonObject> FUnrealCompanionAssetCommands::HandleModifyBatch(const T
                 TargetPath = NormalizeFolderPath(Destination) / NewName;
             }
             
-            if (UEditorAssetLibrary::DuplicateAsset(AssetPath, TargetPath))
+            // Renames are applied at the end: a pending asset is still at its old path
+            const FString SourcePath = PendingIndex ? PendingRenames[*PendingIndex].OldPath : AssetPath;
+            if (UEditorAssetLibrary::DuplicateAsset(SourcePath, TargetPath))
             {
                 Duplicated++;
                 TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -639,9 +648,66 @@ TSharedPtr<FJsonObject> FUnrealCompanionAssetCommands::HandleModifyBatch(const T
             }
             else
             {
-                Failed++;
+                AddError(AssetPath, FString::Printf(TEXT("Failed to duplicate to %s"), *TargetPath));
             }
         }
+        else
+        {
+            AddError(AssetPath, FString::Printf(TEXT("Unknown action: %s"), *Action));
+        }
+    }
+    
+    // One RenameAssets call for every rename/move
+    int32 RedirectorsFixed = 0;
+    if (PendingRenames.Num() > 0)
+    {
+        TArray<FAssetRenameData> RenameData;
+        RenameData.Reserve(PendingRenames.Num());
+        for (const FPendingRename& Rename : PendingRenames)
+        {
+            RenameData.Emplace(ToObjectPath(Rename.OldPath), ToObjectPath(Rename.NewPath));
+        }
+        
+        IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools").Get();
+        AssetTools.RenameAssets(RenameData);
+        
+        TArray<UObjectRedirector*> Redirectors;
+        for (const FPendingRename& Rename : PendingRenames)
+        {
+            const bool bSucceeded = UEditorAssetLibrary::DoesAssetExist(Rename.NewPath);
+            for (const TSharedPtr<FJsonObject>& ResultObj : Rename.Results)
+            {
+                if (!bSucceeded)
+                {
+                    AddError(ResultObj->GetStringField(TEXT("old_path")), TEXT("Rename failed"));
+                    continue;
+                }
+                if (ResultObj->GetStringField(TEXT("action")) == TEXT("rename"))
+                {
+                    Renamed++;
+                }
+                else
+                {
+                    Moved++;
+                }
+                Results.Add(ResultObj);
+            }
+            
+            if (bSucceeded && bFixupRedirectors)
+            {
+                if (UObjectRedirector* Redirector = FindObject<UObjectRedirector>(nullptr, *ToObjectPath(Rename.OldPath).ToString()))
+                {
+                    Redirectors.Add(Redirector);
+                }
+            }
+        }
+        
+        // Consolidate every redirector left behind in one pass
+        if (Redirectors.Num() > 0)
+        {
+            AssetTools.FixupReferencers(Redirectors, /*bCheckoutDialogPrompt=*/false);
+            RedirectorsFixed = Redirectors.Num();
+        }
     }
     
     TSharedPtr<FJsonObject> ResponseData = MakeShared<FJsonObject>();
@@ -650,6 +716,10 @@ TSharedPtr<FJsonObject> FUnrealCompanionAssetCommands::HandleModifyBatch(const T
     ResponseData->SetNumberField(TEXT("moved"), Moved);
     ResponseData->SetNumberField(TEXT("duplicated"), Duplicated);
     ResponseData->SetNumberField(TEXT("failed"), Failed);
+    if (bFixupRedirectors)
+    {
+        ResponseData->SetNumberField(TEXT("redirectors_fixed"), RedirectorsFixed);
+    }
     
     if (Results.Num() > 0)
     {
@@ -693,6 +763,10 @@ TSharedPtr<FJsonObject> FUnrealCompanionAssetCommands::HandleDeleteBatch(const T
     int32 Failed = 0;
     TArray<FString> DeletedAssets;
     
+    // Load everything first, then delete as one set: reference checks, the delete and the
+    // garbage collection that follows run once instead of once per asset
+    TArray<UObject*> ObjectsToDelete;
+    TArray<FString> RequestedPaths;
     for (int32 i = 0; i < AssetsArray->Num(); i++)
     {
         FString AssetPath = NormalizePath((*AssetsArray)[i]->AsString());
@@ -703,10 +777,10 @@ TSharedPtr<FJsonObject> FUnrealCompanionAssetCommands::HandleDeleteBatch(const T
             continue;
         }
         
-        if (UEditorAssetLibrary::DeleteAsset(AssetPath))
+        if (UObject* Asset = UEditorAssetLibrary::LoadAsset(AssetPath))
         {
-            Deleted++;
-            DeletedAssets.Add(AssetPath);
+            ObjectsToDelete.Add(Asset);
+            RequestedPaths.Add(AssetPath);
         }
         else
         {
@@ -714,6 +788,32 @@ TSharedPtr<FJsonObject> FUnrealCompanionAssetCommands::HandleDeleteBatch(const T
         }
     }
     
+    if (ObjectsToDelete.Num() > 0)
+    {
+        if (bForce)
+        {
+            ObjectTools::ForceDeleteObjects(ObjectsToDelete, /*ShowConfirmation=*/false);
+        }
+        else
+        {
+            ObjectTools::DeleteObjects(ObjectsToDelete, /*bShowConfirmation=*/false);
+        }
+        ObjectsToDelete.Reset();
+        
+        for (const FString& AssetPath : RequestedPaths)
+        {
+            if (UEditorAssetLibrary::DoesAssetExist(AssetPath))
+            {
+                Failed++;
+            }
+            else
+            {
+                Deleted++;
+                DeletedAssets.Add(AssetPath);
+            }
+        }
+    }
+    
     TSharedPtr<FJsonObject> ResponseData = MakeShared<FJsonObject>();
     ResponseData->SetBoolField(TEXT("success"), Failed == 0);
     ResponseData->SetNumberField(TEXT("deleted"), Deleted);
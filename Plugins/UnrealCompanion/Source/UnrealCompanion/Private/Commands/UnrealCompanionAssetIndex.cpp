@@ -0,0 +1,263 @@
+#include "Commands/UnrealCompanionAssetIndex.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/PackageName.h"
+
+FUnrealCompanionAssetIndex& FUnrealCompanionAssetIndex::Get()
+{
+    static FUnrealCompanionAssetIndex Instance;
+    return Instance;
+}
+
+void FUnrealCompanionAssetIndex::Initialize()
+{
+    check(IsInGameThread());
+    if (AddedHandle.IsValid())
+    {
+        return;
+    }
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FUnrealCompanionAssetIndex::OnAssetAdded);
+    RemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FUnrealCompanionAssetIndex::OnAssetRemoved);
+    RenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FUnrealCompanionAssetIndex::OnAssetRenamed);
+}
+
+void FUnrealCompanionAssetIndex::Shutdown()
+{
+    if (AddedHandle.IsValid())
+    {
+        // The registry module may already be gone during engine shutdown
+        if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+        {
+            AssetRegistry->OnAssetAdded().Remove(AddedHandle);
+            AssetRegistry->OnAssetRemoved().Remove(RemovedHandle);
+            AssetRegistry->OnAssetRenamed().Remove(RenamedHandle);
+        }
+        AddedHandle.Reset();
+        RemovedHandle.Reset();
+        RenamedHandle.Reset();
+    }
+
+    FWriteScopeLock WriteLock(Lock);
+    ByName.Empty();
+    ByObjectPath.Empty();
+    bBuilt = false;
+}
+
+void FUnrealCompanionAssetIndex::EnsureBuilt()
+{
+    {
+        FReadScopeLock ReadLock(Lock);
+        if (bBuilt)
+        {
+            return;
+        }
+    }
+
+    // GetAllAssets is thread-safe; assets discovered later arrive through OnAssetAdded
+    TArray<FAssetData> AllAssets;
+    IAssetRegistry::GetChecked().GetAllAssets(AllAssets);
+
+    FWriteScopeLock WriteLock(Lock);
+    if (bBuilt)
+    {
+        return;
+    }
+
+    ByName.Reserve(AllAssets.Num());
+    ByObjectPath.Reserve(AllAssets.Num());
+    for (const FAssetData& AssetData : AllAssets)
+    {
+        AddAsset_Locked(AssetData);
+    }
+    bBuilt = true;
+
+    UE_LOG(LogTemp, Log, TEXT("UnrealCompanionAssetIndex: Indexed %d assets"), ByObjectPath.Num());
+}
+
+void FUnrealCompanionAssetIndex::AddAsset_Locked(const FAssetData& AssetData)
+{
+    const FSoftObjectPath ObjectPath = AssetData.GetSoftObjectPath();
+    if (FTopLevelAssetPath* ExistingClass = ByObjectPath.Find(ObjectPath))
+    {
+        // Seen during the initial build and again from OnAssetAdded; refresh the class only
+        *ExistingClass = AssetData.AssetClassPath;
+        for (FEntry& Entry : ByName.FindOrAdd(AssetData.AssetName))
+        {
+            if (Entry.ObjectPath == ObjectPath)
+            {
+                Entry.ClassPath = AssetData.AssetClassPath;
+            }
+        }
+        return;
+    }
+
+    ByObjectPath.Add(ObjectPath, AssetData.AssetClassPath);
+    ByName.FindOrAdd(AssetData.AssetName).Add({ ObjectPath, AssetData.AssetClassPath });
+}
+
+void FUnrealCompanionAssetIndex::RemoveAsset_Locked(const FSoftObjectPath& ObjectPath)
+{
+    if (ByObjectPath.Remove(ObjectPath) == 0)
+    {
+        return;
+    }
+
+    const FName AssetName(*ObjectPath.GetAssetName());
+    if (TArray<FEntry>* Entries = ByName.Find(AssetName))
+    {
+        Entries->RemoveAll([&ObjectPath](const FEntry& Entry) { return Entry.ObjectPath == ObjectPath; });
+        if (Entries->Num() == 0)
+        {
+            ByName.Remove(AssetName);
+        }
+    }
+}
+
+bool FUnrealCompanionAssetIndex::MatchesClass(const FEntry& Entry, const UClass* Class, bool bIncludeSubclasses)
+{
+    if (!Class)
+    {
+        return true;
+    }
+    if (Entry.ClassPath == Class->GetClassPathName())
+    {
+        return true;
+    }
+    if (!bIncludeSubclasses)
+    {
+        return false;
+    }
+
+    // Asset classes are native (UBlueprint, UAnimBlueprint, ...) and therefore already loaded
+    const UClass* AssetClass = FindObject<UClass>(Entry.ClassPath);
+    return AssetClass && AssetClass->IsChildOf(Class);
+}
+
+bool FUnrealCompanionAssetIndex::FindAsset(const FString& NameOrPath, const UClass* Class, bool bIncludeSubclasses,
+    bool bAllowPartialMatch, FSoftObjectPath& OutObjectPath)
+{
+    if (NameOrPath.IsEmpty())
+    {
+        return false;
+    }
+
+    EnsureBuilt();
+    FReadScopeLock ReadLock(Lock);
+
+    // Package or object path
+    if (NameOrPath.StartsWith(TEXT("/")))
+    {
+        FString ObjectPathString = NameOrPath;
+        if (!FPackageName::GetShortName(ObjectPathString).Contains(TEXT(".")))
+        {
+            ObjectPathString = FString::Printf(TEXT("%s.%s"), *NameOrPath, *FPackageName::GetShortName(NameOrPath));
+        }
+
+        const FSoftObjectPath ObjectPath(ObjectPathString);
+        if (const FTopLevelAssetPath* ClassPath = ByObjectPath.Find(ObjectPath))
+        {
+            if (MatchesClass({ ObjectPath, *ClassPath }, Class, bIncludeSubclasses))
+            {
+                OutObjectPath = ObjectPath;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Exact name: prefer the candidate with identical casing. FNAME_Find: a name no
+    // asset has must not grow the global name table, and cannot match exactly anyway
+    const FName ExactName(*NameOrPath, FNAME_Find);
+    if (const TArray<FEntry>* Entries = ExactName.IsNone() ? nullptr : ByName.Find(ExactName))
+    {
+        const FEntry* CaseInsensitiveMatch = nullptr;
+        for (const FEntry& Entry : *Entries)
+        {
+            if (!MatchesClass(Entry, Class, bIncludeSubclasses))
+            {
+                continue;
+            }
+            if (Entry.ObjectPath.GetAssetName().Equals(NameOrPath, ESearchCase::CaseSensitive))
+            {
+                OutObjectPath = Entry.ObjectPath;
+                return true;
+            }
+            if (!CaseInsensitiveMatch)
+            {
+                CaseInsensitiveMatch = &Entry;
+            }
+        }
+        if (CaseInsensitiveMatch)
+        {
+            OutObjectPath = CaseInsensitiveMatch->ObjectPath;
+            return true;
+        }
+    }
+
+    if (!bAllowPartialMatch)
+    {
+        return false;
+    }
+
+    // Substring match has no index; scan names only, not the whole registry
+    for (const TPair<FName, TArray<FEntry>>& Pair : ByName)
+    {
+        if (!Pair.Key.ToString().Contains(NameOrPath))
+        {
+            continue;
+        }
+        for (const FEntry& Entry : Pair.Value)
+        {
+            if (MatchesClass(Entry, Class, bIncludeSubclasses))
+            {
+                OutObjectPath = Entry.ObjectPath;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+FTopLevelAssetPath FUnrealCompanionAssetIndex::GetAssetClass(const FSoftObjectPath& ObjectPath)
+{
+    EnsureBuilt();
+    FReadScopeLock ReadLock(Lock);
+    return ByObjectPath.FindRef(ObjectPath);
+}
+
+int32 FUnrealCompanionAssetIndex::Num()
+{
+    EnsureBuilt();
+    FReadScopeLock ReadLock(Lock);
+    return ByObjectPath.Num();
+}
+
+void FUnrealCompanionAssetIndex::OnAssetAdded(const FAssetData& AssetData)
+{
+    FWriteScopeLock WriteLock(Lock);
+    if (bBuilt)
+    {
+        AddAsset_Locked(AssetData);
+    }
+}
+
+void FUnrealCompanionAssetIndex::OnAssetRemoved(const FAssetData& AssetData)
+{
+    FWriteScopeLock WriteLock(Lock);
+    if (bBuilt)
+    {
+        RemoveAsset_Locked(AssetData.GetSoftObjectPath());
+    }
+}
+
+void FUnrealCompanionAssetIndex::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    FWriteScopeLock WriteLock(Lock);
+    if (bBuilt)
+    {
+        RemoveAsset_Locked(FSoftObjectPath(OldObjectPath));
+        AddAsset_Locked(AssetData);
+    }
+}
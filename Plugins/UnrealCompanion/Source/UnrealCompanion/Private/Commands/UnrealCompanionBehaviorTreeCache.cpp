@@ -0,0 +1,188 @@
+#include "Commands/UnrealCompanionBehaviorTreeCache.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BTCompositeNode.h"
+#include "BehaviorTree/BTDecorator.h"
+#include "BehaviorTree/BTService.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "Dom/JsonObject.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+    FIoHash GetSavedHash(FName PackageName)
+    {
+        const IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+        if (!AssetRegistry)
+        {
+            return FIoHash();
+        }
+        const TOptional<FAssetPackageData> PackageData = AssetRegistry->GetAssetPackageDataCopy(PackageName);
+        return PackageData.IsSet() ? PackageData->GetPackageSavedHash() : FIoHash();
+    }
+
+    template <typename NodeType>
+    void AddAuxiliaryNodes(const TSharedPtr<FJsonObject>& NodeObj, const TCHAR* Field, const TArray<NodeType*>& AuxNodes)
+    {
+        TArray<TSharedPtr<FJsonValue>> AuxArray;
+        for (NodeType* AuxNode : AuxNodes)
+        {
+            if (!AuxNode) continue;
+            TSharedPtr<FJsonObject> AuxObj = MakeShared<FJsonObject>();
+            AuxObj->SetStringField(TEXT("class"), AuxNode->GetClass()->GetName());
+            AuxObj->SetStringField(TEXT("node_name"), AuxNode->GetNodeName());
+            AuxArray.Add(MakeShared<FJsonValueObject>(AuxObj));
+        }
+        if (AuxArray.Num() > 0)
+        {
+            NodeObj->SetArrayField(Field, AuxArray);
+        }
+    }
+
+    TSharedPtr<FJsonObject> MakeNodeObject(const UBTNode* Node, int32 Index, const TCHAR* Category, int32 Depth, int32 ParentIndex)
+    {
+        TSharedPtr<FJsonObject> NodeObj = MakeShared<FJsonObject>();
+        NodeObj->SetStringField(TEXT("id"), FString::Printf(TEXT("node_%d"), Index));
+        NodeObj->SetStringField(TEXT("class"), Node->GetClass()->GetName());
+        NodeObj->SetStringField(TEXT("node_name"), Node->GetNodeName());
+        NodeObj->SetStringField(TEXT("category"), Category);
+        NodeObj->SetNumberField(TEXT("depth"), Depth);
+        if (ParentIndex != INDEX_NONE)
+        {
+            NodeObj->SetStringField(TEXT("parent_id"), FString::Printf(TEXT("node_%d"), ParentIndex));
+        }
+        return NodeObj;
+    }
+}
+
+FUnrealCompanionBehaviorTreeCache& FUnrealCompanionBehaviorTreeCache::Get()
+{
+    static FUnrealCompanionBehaviorTreeCache Instance;
+    return Instance;
+}
+
+int32 FUnrealCompanionBehaviorTreeCache::ParseNodeId(const FString& NodeId)
+{
+    FString Digits = NodeId;
+    Digits.RemoveFromStart(TEXT("node_"));
+    if (Digits.IsEmpty() || !Digits.IsNumeric())
+    {
+        return INDEX_NONE;
+    }
+    return FCString::Atoi(*Digits);
+}
+
+TSharedPtr<const FUnrealCompanionBehaviorTreeCache::FTree> FUnrealCompanionBehaviorTreeCache::Find(UBehaviorTree* Tree, bool& bOutFromCache)
+{
+    check(IsInGameThread());
+    bOutFromCache = false;
+    if (!Tree)
+    {
+        return nullptr;
+    }
+    EnsureSubscribed();
+
+    const FName PackageName = Tree->GetOutermost()->GetFName();
+    const FIoHash SavedHash = GetSavedHash(PackageName);
+    if (const FEntry* Entry = Entries.Find(PackageName))
+    {
+        if (Entry->Tree.Get() == Tree && Entry->Summary->SavedHash == SavedHash)
+        {
+            bOutFromCache = true;
+            return Entry->Summary;
+        }
+    }
+
+    TSharedPtr<const FTree> Summary = Build(Tree, SavedHash);
+    Entries.Add(PackageName, FEntry{Tree, Summary});
+    return Summary;
+}
+
+TSharedPtr<const FUnrealCompanionBehaviorTreeCache::FTree> FUnrealCompanionBehaviorTreeCache::Build(UBehaviorTree* Tree, const FIoHash& SavedHash)
+{
+    TSharedPtr<FTree> Summary = MakeShared<FTree>();
+    Summary->SavedHash = SavedHash;
+
+    // Preorder: a node's index is its id, and its subtree is the range up to SubtreeEnd
+    TFunction<void(UBTCompositeNode*, int32, int32, const TArray<UBTDecorator*>*)> Visit;
+    Visit = [&Summary, &Visit](UBTCompositeNode* Composite, int32 Depth, int32 ParentIndex, const TArray<UBTDecorator*>* Decorators)
+    {
+        const int32 Index = Summary->Nodes.Num();
+        Summary->TreeDepth = FMath::Max(Summary->TreeDepth, Depth);
+
+        TSharedPtr<FJsonObject> NodeObj = MakeNodeObject(Composite, Index, TEXT("composite"), Depth, ParentIndex);
+        NodeObj->SetNumberField(TEXT("children_count"), Composite->Children.Num());
+        if (Decorators)
+        {
+            AddAuxiliaryNodes(NodeObj, TEXT("decorators"), *Decorators);
+        }
+        AddAuxiliaryNodes(NodeObj, TEXT("services"), Composite->Services);
+        Summary->Nodes.Add(FNode{Depth, Index + 1, MakeShared<FJsonValueObject>(NodeObj)});
+
+        TArray<TSharedPtr<FJsonValue>> ChildIds;
+        for (const FBTCompositeChild& Child : Composite->Children)
+        {
+            if (Child.ChildTask)
+            {
+                const int32 TaskIndex = Summary->Nodes.Num();
+                Summary->TreeDepth = FMath::Max(Summary->TreeDepth, Depth + 1);
+
+                TSharedPtr<FJsonObject> TaskObj = MakeNodeObject(Child.ChildTask, TaskIndex, TEXT("task"), Depth + 1, Index);
+                AddAuxiliaryNodes(TaskObj, TEXT("decorators"), Child.Decorators);
+                AddAuxiliaryNodes(TaskObj, TEXT("services"), Child.ChildTask->Services);
+                Summary->Nodes.Add(FNode{Depth + 1, TaskIndex + 1, MakeShared<FJsonValueObject>(TaskObj)});
+                ChildIds.Add(MakeShared<FJsonValueString>(FString::Printf(TEXT("node_%d"), TaskIndex)));
+            }
+            if (Child.ChildComposite)
+            {
+                ChildIds.Add(MakeShared<FJsonValueString>(FString::Printf(TEXT("node_%d"), Summary->Nodes.Num())));
+                Visit(Child.ChildComposite, Depth + 1, Index, &Child.Decorators);
+            }
+        }
+
+        NodeObj->SetArrayField(TEXT("children"), ChildIds);
+        Summary->Nodes[Index].SubtreeEnd = Summary->Nodes.Num();
+    };
+
+    if (Tree->RootNode)
+    {
+        Visit(Tree->RootNode, 0, INDEX_NONE, nullptr);
+    }
+    return Summary;
+}
+
+void FUnrealCompanionBehaviorTreeCache::EnsureSubscribed()
+{
+    if (ObjectModifiedHandle.IsValid())
+    {
+        return;
+    }
+    ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FUnrealCompanionBehaviorTreeCache::OnObjectChanged);
+    PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([this](UObject* Object, FPropertyChangedEvent&)
+    {
+        OnObjectChanged(Object);
+    });
+}
+
+void FUnrealCompanionBehaviorTreeCache::OnObjectChanged(UObject* Object)
+{
+    // Runs on every Modify() in the editor: one map lookup, nothing else
+    if (Object && Entries.Num() > 0)
+    {
+        Entries.Remove(Object->GetOutermost()->GetFName());
+    }
+}
+
+void FUnrealCompanionBehaviorTreeCache::Shutdown()
+{
+    if (ObjectModifiedHandle.IsValid())
+    {
+        FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+        FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+        ObjectModifiedHandle.Reset();
+        PropertyChangedHandle.Reset();
+    }
+    Entries.Reset();
+}
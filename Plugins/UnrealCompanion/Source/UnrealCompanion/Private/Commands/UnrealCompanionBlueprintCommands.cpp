@@ -1,6 +1,9 @@
 #include "Commands/UnrealCompanionBlueprintCommands.h"
 #include "Commands/UnrealCompanionCommonUtils.h"
+#include "UnrealCompanionStats.h"
 #include "Commands/UnrealCompanionEditorFocus.h"
+#include "Commands/UnrealCompanionCompileSession.h"
+#include "HAL/PlatformTime.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "Factories/BlueprintFactory.h"
@@ -30,6 +33,161 @@
 #include "AssetToolsModule.h"
 #include "IAssetTools.h"
 
+// =========================================================================
+// PARAM SCHEMAS (batch shape checks, connection thread)
+// =========================================================================
+
+namespace
+{
+    /** The handler's per-operation checks that don't need the Blueprint */
+    void CheckVariableOperations(const TArray<TSharedPtr<FJsonValue>>& Operations, TArray<FString>& OutErrors)
+    {
+        for (int32 i = 0; i < Operations.Num(); i++)
+        {
+            const TSharedPtr<FJsonObject>* OpObj = nullptr;
+            if (!Operations[i]->TryGetObject(OpObj))
+            {
+                OutErrors.Add(FString::Printf(TEXT("Operation %d: Invalid JSON object"), i));
+                continue;
+            }
+
+            FString Action;
+            if (!(*OpObj)->TryGetStringField(TEXT("action"), Action))
+            {
+                OutErrors.Add(FString::Printf(TEXT("Operation %d: Missing 'action' field"), i));
+                continue;
+            }
+            if (Action != TEXT("add") && Action != TEXT("set_default") && Action != TEXT("remove"))
+            {
+                OutErrors.Add(FString::Printf(TEXT("Operation %d: Unknown action '%s' (use: add, set_default, remove)"), i, *Action));
+                continue;
+            }
+            if (!(*OpObj)->HasTypedField<EJson::String>(TEXT("name")))
+            {
+                OutErrors.Add(FString::Printf(TEXT("Operation %d (%s): Missing 'name' field"), i, *Action));
+            }
+            if (Action == TEXT("add") && !(*OpObj)->HasTypedField<EJson::String>(TEXT("type")))
+            {
+                OutErrors.Add(FString::Printf(TEXT("Operation %d (add): Missing 'type' field"), i));
+            }
+        }
+    }
+
+    void CheckComponents(const TSharedPtr<FJsonObject>& Params, TArray<FString>& OutErrors)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* ComponentsArray = nullptr;
+        if (!Params->TryGetArrayField(TEXT("components"), ComponentsArray))
+        {
+            return;
+        }
+
+        TSet<FString> DeclaredRefs;
+        for (int32 i = 0; i < ComponentsArray->Num(); i++)
+        {
+            const TSharedPtr<FJsonObject>* CompObj = nullptr;
+            if (!(*ComponentsArray)[i]->TryGetObject(CompObj))
+            {
+                OutErrors.Add(FString::Printf(TEXT("Component %d: Invalid JSON object"), i));
+                continue;
+            }
+
+            FString Ref, ClassName;
+            (*CompObj)->TryGetStringField(TEXT("ref"), Ref);
+            (*CompObj)->TryGetStringField(TEXT("class"), ClassName);
+
+            if (Ref.IsEmpty())
+            {
+                OutErrors.Add(FString::Printf(TEXT("Component %d: Missing 'ref' field"), i));
+            }
+            else
+            {
+                bool bDuplicate = false;
+                DeclaredRefs.Add(Ref, &bDuplicate);
+                if (bDuplicate)
+                {
+                    OutErrors.Add(FString::Printf(TEXT("Component %d: Duplicate ref '%s'"), i, *Ref));
+                }
+            }
+            if (ClassName.IsEmpty())
+            {
+                OutErrors.Add(FString::Printf(TEXT("Component %d (%s): Missing 'class' field"), i, *Ref));
+            }
+        }
+    }
+
+    bool FailValidation(const TArray<FString>& Errors, FString& OutError)
+    {
+        if (Errors.Num() == 0)
+        {
+            return true;
+        }
+        OutError = FString::Printf(TEXT("Validation failed with %d errors: %s"), Errors.Num(), *Errors[0]);
+        return false;
+    }
+}
+
+const TMCPParamSchema<FMCPBlueprintVariableBatchParams>& FMCPBlueprintVariableBatchParams::Schema()
+{
+    static const TMCPParamSchema<FMCPBlueprintVariableBatchParams> Instance = TMCPParamSchema<FMCPBlueprintVariableBatchParams>()
+        .Required(TEXT("blueprint_name"), &FMCPBlueprintVariableBatchParams::BlueprintName)
+        .Required(TEXT("operations"), &FMCPBlueprintVariableBatchParams::Operations)
+        .WithStandardParams()
+        .Validate([](FMCPBlueprintVariableBatchParams& Parsed, FString& OutError)
+        {
+            if (Parsed.Operations.Num() > Parsed.Standard.MaxOperations)
+            {
+                OutError = FString::Printf(TEXT("Too many operations: %d (max: %d). Split into multiple batches"),
+                    Parsed.Operations.Num(), Parsed.Standard.MaxOperations);
+                return false;
+            }
+            // Like the handler: only "rollback" refuses the whole batch over one bad operation
+            if (Parsed.Standard.bDryRun || Parsed.Standard.OnError != TEXT("rollback"))
+            {
+                return true;
+            }
+            TArray<FString> Errors;
+            CheckVariableOperations(Parsed.Operations, Errors);
+            return FailValidation(Errors, OutError);
+        });
+    return Instance;
+}
+
+const TMCPParamSchema<FMCPBlueprintComponentBatchParams>& FMCPBlueprintComponentBatchParams::Schema()
+{
+    static const TMCPParamSchema<FMCPBlueprintComponentBatchParams> Instance = TMCPParamSchema<FMCPBlueprintComponentBatchParams>()
+        .Required(TEXT("blueprint_name"), &FMCPBlueprintComponentBatchParams::BlueprintName)
+        .WithStandardParams()
+        .Validate([](FMCPBlueprintComponentBatchParams& Parsed, FString& OutError)
+        {
+            if (Parsed.Standard.bDryRun)
+            {
+                return true;
+            }
+            TArray<FString> Errors;
+            CheckComponents(Parsed.Raw, Errors);
+            return FailValidation(Errors, OutError);
+        });
+    return Instance;
+}
+
+const TMCPParamSchema<FMCPBlueprintFunctionBatchParams>& FMCPBlueprintFunctionBatchParams::Schema()
+{
+    static const TMCPParamSchema<FMCPBlueprintFunctionBatchParams> Instance = TMCPParamSchema<FMCPBlueprintFunctionBatchParams>()
+        .Required(TEXT("blueprint_name"), &FMCPBlueprintFunctionBatchParams::BlueprintName)
+        .Required(TEXT("operations"), &FMCPBlueprintFunctionBatchParams::Operations)
+        .WithStandardParams()
+        .Validate([](FMCPBlueprintFunctionBatchParams& Parsed, FString& OutError)
+        {
+            if (Parsed.Operations.Num() == 0)
+            {
+                OutError = TEXT("Missing or empty 'operations' array");
+                return false;
+            }
+            return true;
+        });
+    return Instance;
+}
+
 // Helper to find a class by name (same as in BlueprintNodeCommands)
 static UClass* FindClassByNameHelper(const FString& ClassName)
 {
@@ -384,7 +542,10 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintCommands::HandleSetBlueprintPar
     Blueprint->ParentClass = NewParentClass;
     FBlueprintEditorUtils::RefreshAllNodes(Blueprint);
     FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
-    FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    if (!FUnrealCompanionCompileSession::Get().DeferCompile(Blueprint))
+    {
+        FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    }
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("blueprint_name"), BlueprintName);
@@ -896,8 +1057,11 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintCommands::HandleAddComponentToB
         // Add to root if no parent specified
         Blueprint->SimpleConstructionScript->AddNode(NewNode);
 
-        // Compile the blueprint
-        FKismetEditorUtilities::CompileBlueprint(Blueprint);
+        // Compile the blueprint (or leave it to the open compile session)
+        if (!FUnrealCompanionCompileSession::Get().DeferCompile(Blueprint))
+        {
+            FKismetEditorUtilities::CompileBlueprint(Blueprint);
+        }
 
         TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
         ResultObj->SetStringField(TEXT("component_name"), ComponentName);
@@ -1475,11 +1639,54 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintCommands::HandleSetPhysicsPrope
 
 TSharedPtr<FJsonObject> FUnrealCompanionBlueprintCommands::HandleCompileBlueprint(const TSharedPtr<FJsonObject>& Params)
 {
+    // Batch mode: one pass of the compilation manager for every listed Blueprint
+    const TArray<TSharedPtr<FJsonValue>>* NamesArray = nullptr;
+    if (Params->TryGetArrayField(TEXT("blueprint_names"), NamesArray))
+    {
+        TArray<UBlueprint*> Blueprints;
+        TArray<TSharedPtr<FJsonValue>> NotFound;
+        for (const TSharedPtr<FJsonValue>& NameValue : *NamesArray)
+        {
+            const FString Name = NameValue->AsString();
+            if (UBlueprint* Found = FUnrealCompanionCommonUtils::FindBlueprint(Name))
+            {
+                Blueprints.Add(Found);
+            }
+            else
+            {
+                NotFound.Add(MakeShared<FJsonValueString>(Name));
+            }
+        }
+        if (Blueprints.Num() == 0)
+        {
+            return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+                TEXT("ASSET_NOT_FOUND"),
+                TEXT("None of 'blueprint_names' was found"),
+                TEXT("Use asset_find to search for blueprints"));
+        }
+
+        const double CompileStart = FPlatformTime::Seconds();
+        int32 Failed = 0;
+        TArray<TSharedPtr<FJsonValue>> Results = FUnrealCompanionCompileSession::CompileBatch(Blueprints, Failed);
+
+        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+        ResultObj->SetBoolField(TEXT("success"), Failed == 0 && NotFound.Num() == 0);
+        ResultObj->SetNumberField(TEXT("compiled"), Results.Num());
+        ResultObj->SetNumberField(TEXT("failed"), Failed);
+        ResultObj->SetNumberField(TEXT("compile_ms"), (FPlatformTime::Seconds() - CompileStart) * 1000.0);
+        ResultObj->SetArrayField(TEXT("results"), Results);
+        if (NotFound.Num() > 0)
+        {
+            ResultObj->SetArrayField(TEXT("not_found"), NotFound);
+        }
+        return ResultObj;
+    }
+
     // Get required parameters
     FString BlueprintName;
     if (!Params->TryGetStringField(TEXT("blueprint_name"), BlueprintName))
     {
-        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing 'blueprint_name' parameter"));
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing 'blueprint_name' (or 'blueprint_names') parameter"));
     }
 
     // Find the blueprint
@@ -1489,8 +1696,12 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintCommands::HandleCompileBlueprin
         return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
     }
 
-    // Compile the blueprint
-    FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    // Compile the blueprint (explicit: never deferred, but satisfies any open session)
+    {
+        UNREALCOMPANION_SCOPE_CYCLE_COUNTER(STAT_UnrealCompanion_Compile);
+        FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    }
+    FUnrealCompanionCompileSession::Get().NotifyCompiled(Blueprint);
     
     // Check compilation status
     bool bHasErrors = false;
@@ -2174,6 +2385,20 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintCommands::HandleVariableBatch(c
     // =========================================================================
     FScopedTransaction Transaction(FText::FromString(TEXT("MCP Blueprint Variable Batch")));
     
+    // One skeleton regeneration for the whole batch instead of one per add/remove
+    FUnrealCompanionCommonUtils::FScopedBlueprintModification Modification(Blueprint);
+    
+    // Defaults for variables added here wait for the batch's single compile
+    struct FPendingDefault
+    {
+        FString VarName;
+        TSharedPtr<FJsonValue> Value;
+        TSharedPtr<FJsonObject> ResultObj;
+        const TCHAR* Field;
+    };
+    TArray<FPendingDefault> PendingDefaults;
+    TScratchSet<FString> AddedVariables;
+    
     TArray<TSharedPtr<FJsonObject>> Results;
     TArray<TSharedPtr<FJsonObject>> Errors;
     int32 Completed = 0;
@@ -2232,40 +2457,13 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintCommands::HandleVariableBatch(c
                         FBlueprintEditorUtils::SetBlueprintPropertyReadOnlyFlag(Blueprint, NewVarName, false);
                     }
                     
-                    // Set default value if provided - need to compile first to have CDO access
-                    if (OpObj->HasField(TEXT("default_value")))
+                    // The CDO only has the property after a compile: set the default after the loop
+                    TSharedPtr<FJsonValue> DefaultValueJson = OpObj->TryGetField(TEXT("default_value"));
+                    if (DefaultValueJson.IsValid())
                     {
-                        TSharedPtr<FJsonValue> DefaultValueJson = OpObj->TryGetField(TEXT("default_value"));
-                        if (DefaultValueJson.IsValid())
-                        {
-                            // Compile to create the property in CDO
-                            FKismetEditorUtilities::CompileBlueprint(Blueprint);
-                            
-                            UObject* CDO = Blueprint->GeneratedClass ? Blueprint->GeneratedClass->GetDefaultObject() : nullptr;
-                            if (CDO)
-                            {
-                                FString ErrorMessage;
-                                if (FUnrealCompanionCommonUtils::SetObjectProperty(CDO, VarName, DefaultValueJson, ErrorMessage))
-                                {
-                                    FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
-                                    
-                                    FString DefaultValueStr;
-                                    if (DefaultValueJson->Type == EJson::String)
-                                        DefaultValueStr = DefaultValueJson->AsString();
-                                    else if (DefaultValueJson->Type == EJson::Number)
-                                        DefaultValueStr = FString::SanitizeFloat(DefaultValueJson->AsNumber());
-                                    else if (DefaultValueJson->Type == EJson::Boolean)
-                                        DefaultValueStr = DefaultValueJson->AsBool() ? TEXT("true") : TEXT("false");
-                                    
-                                    ResultObj->SetStringField(TEXT("default_value"), DefaultValueStr);
-                                }
-                                else
-                                {
-                                    UE_LOG(LogTemp, Warning, TEXT("Failed to set default value for %s: %s"), *VarName, *ErrorMessage);
-                                }
-                            }
-                        }
+                        PendingDefaults.Add({VarName, DefaultValueJson, ResultObj, TEXT("default_value")});
                     }
+                    AddedVariables.Add(VarName);
                     
                     bOpSuccess = true;
                     ResultObj->SetStringField(TEXT("type"), VarType);
@@ -2288,7 +2486,13 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintCommands::HandleVariableBatch(c
         else if (Action == TEXT("set_default"))
         {
             TSharedPtr<FJsonValue> ValueJson = OpObj->TryGetField(TEXT("value"));
-            if (ValueJson.IsValid())
+            if (ValueJson.IsValid() && AddedVariables.Contains(VarName))
+            {
+                // Added earlier in this batch: not on the CDO until the batch compiles
+                PendingDefaults.Add({VarName, ValueJson, ResultObj, TEXT("new_value")});
+                bOpSuccess = true;
+            }
+            else if (ValueJson.IsValid())
             {
                 // Get the CDO to set the actual default value
                 UObject* CDO = Blueprint->GeneratedClass ? Blueprint->GeneratedClass->GetDefaultObject() : nullptr;
@@ -2297,7 +2501,6 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintCommands::HandleVariableBatch(c
                     FString ErrorMessage;
                     if (FUnrealCompanionCommonUtils::SetObjectProperty(CDO, VarName, ValueJson, ErrorMessage))
                     {
-                        FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
                         bOpSuccess = true;
                         
                         // Return the value that was set
@@ -2455,8 +2658,37 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintCommands::HandleVariableBatch(c
     }
     
     // =========================================================================
-    // 8. Mark blueprint as modified and compile if needed
+    // 8. Notify once, apply pending defaults, compile if needed
     // =========================================================================
+    Modification.Finish(Completed > 0);
+    
+    if (PendingDefaults.Num() > 0)
+    {
+        // One compile puts every new variable on the CDO
+        FKismetEditorUtilities::CompileBlueprint(Blueprint);
+        
+        UObject* CDO = Blueprint->GeneratedClass ? Blueprint->GeneratedClass->GetDefaultObject() : nullptr;
+        for (const FPendingDefault& Pending : PendingDefaults)
+        {
+            FString ErrorMessage;
+            if (!CDO || !FUnrealCompanionCommonUtils::SetObjectProperty(CDO, Pending.VarName, Pending.Value, ErrorMessage))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Failed to set default value for %s: %s"), *Pending.VarName, *ErrorMessage);
+                continue;
+            }
+            
+            FString ValueStr;
+            if (Pending.Value->Type == EJson::String)
+                ValueStr = Pending.Value->AsString();
+            else if (Pending.Value->Type == EJson::Number)
+                ValueStr = FString::SanitizeFloat(Pending.Value->AsNumber());
+            else if (Pending.Value->Type == EJson::Boolean)
+                ValueStr = Pending.Value->AsBool() ? TEXT("true") : TEXT("false");
+            
+            Pending.ResultObj->SetStringField(Pending.Field, ValueStr);
+        }
+    }
+    
     bool bCompiled = false;
     if (Completed > 0)
     {
@@ -2635,7 +2867,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintCommands::HandleComponentBatch(
     // =========================================================================
     FScopedTransaction Transaction(FText::FromString(TEXT("MCP Component Batch")));
     
-    TMap<FString, USCS_Node*> RefToNode;
+    TScratchMap<FString, USCS_Node*> RefToNode;
     TArray<TSharedPtr<FJsonObject>> Results;
     TArray<TSharedPtr<FJsonObject>> Errors;
     int32 Added = 0;
@@ -2773,6 +3005,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintCommands::HandleComponentBatch(
     // -------------------------------------------------------------------------
     if (PropertiesArray)
     {
+        FUnrealCompanionCommonUtils::FScopedPropertyCache PropertyCache;
         for (int32 i = 0; i < PropertiesArray->Num(); i++)
         {
             const TSharedPtr<FJsonObject>& PropObj = (*PropertiesArray)[i]->AsObject();
@@ -2977,6 +3210,9 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintCommands::HandleFunctionBatch(c
     
     FScopedTransaction Transaction(FText::FromString(TEXT("MCP Function Batch")));
     
+    // One skeleton regeneration for the whole batch instead of one per graph/local variable
+    FUnrealCompanionCommonUtils::FScopedBlueprintModification Modification(Blueprint);
+    
     int32 Added = 0;
     int32 Removed = 0;
     int32 LocalVarsAdded = 0;
@@ -3190,6 +3426,8 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintCommands::HandleFunctionBatch(c
         }
     }
     
+    Modification.Finish(Added > 0 || Removed > 0 || LocalVarsAdded > 0);
+    
     bool bCompiled = false;
     if (Added > 0 || Removed > 0 || LocalVarsAdded > 0)
     {
@@ -1,5 +1,8 @@
 #include "Commands/UnrealCompanionBlueprintNodeCommands.h"
 #include "Commands/UnrealCompanionCommonUtils.h"
+#include "Graph/GraphLayout.h"
+#include "Graph/NodeCatalog.h"
+#include "Graph/NodeOperations.h"
 #include "UObject/UObjectGlobals.h"
 #include "UObject/Package.h"
 #include "Misc/Paths.h"
@@ -95,143 +98,35 @@ FUnrealCompanionBlueprintNodeCommands::FUnrealCompanionBlueprintNodeCommands()
 {
 }
 
+TConstArrayView<TMCPCommandEntry<FUnrealCompanionBlueprintNodeCommands>> FUnrealCompanionBlueprintNodeCommands::GetCommandTable()
+{
+    // The node_* handlers predate graph_batch and are no longer exposed
+    static constexpr TMCPCommandEntry<FUnrealCompanionBlueprintNodeCommands> Table[] = {
+        { TEXT("graph_node_search_available"), &FUnrealCompanionBlueprintNodeCommands::HandleSearchBlueprintNodes },
+        // BLUEPRINT COMMANDS (blueprint_*) - Graph-related operations
+        { TEXT("blueprint_add_variable"), &FUnrealCompanionBlueprintNodeCommands::HandleAddBlueprintVariable },
+        { TEXT("blueprint_add_event_dispatcher"), &FUnrealCompanionBlueprintNodeCommands::HandleAddEventDispatcher },
+        { TEXT("blueprint_add_function"), &FUnrealCompanionBlueprintNodeCommands::HandleAddBlueprintFunction },
+        { TEXT("blueprint_implement_interface"), &FUnrealCompanionBlueprintNodeCommands::HandleImplementInterface },
+        { TEXT("blueprint_add_custom_event"), &FUnrealCompanionBlueprintNodeCommands::HandleAddCustomEvent },
+        { TEXT("blueprint_set_variable_default"), &FUnrealCompanionBlueprintNodeCommands::HandleSetVariableDefaultValue },
+        { TEXT("blueprint_add_local_variable"), &FUnrealCompanionBlueprintNodeCommands::HandleAddLocalVariable },
+        { TEXT("blueprint_get_info"), &FUnrealCompanionBlueprintNodeCommands::HandleGetBlueprintInfo },
+        { TEXT("blueprint_remove_variable"), &FUnrealCompanionBlueprintNodeCommands::HandleRemoveBlueprintVariable },
+        { TEXT("blueprint_remove_function"), &FUnrealCompanionBlueprintNodeCommands::HandleRemoveBlueprintFunction },
+        { TEXT("blueprint_remove_component"), &FUnrealCompanionBlueprintNodeCommands::HandleRemoveComponent },
+        { TEXT("blueprint_get_compilation_messages"), &FUnrealCompanionBlueprintNodeCommands::HandleGetCompilationMessages },
+    };
+    static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+    return Table;
+}
+
 TSharedPtr<FJsonObject> FUnrealCompanionBlueprintNodeCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-    // NODE COMMANDS (node_*)
-    if (CommandType == TEXT("node_connect"))
-    {
-        return HandleConnectBlueprintNodes(Params);
-    }
-    else if (CommandType == TEXT("node_add_get_component"))
-    {
-        return HandleAddBlueprintGetSelfComponentReference(Params);
-    }
-    else if (CommandType == TEXT("node_add_event"))
-    {
-        return HandleAddBlueprintEvent(Params);
-    }
-    else if (CommandType == TEXT("node_add_function_call"))
-    {
-        return HandleAddBlueprintFunctionCall(Params);
-    }
-    else if (CommandType == TEXT("node_add_input_action"))
-    {
-        return HandleAddBlueprintInputActionNode(Params);
-    }
-    else if (CommandType == TEXT("node_add_get_self"))
-    {
-        return HandleAddBlueprintSelfReference(Params);
-    }
-    else if (CommandType == TEXT("node_find"))
-    {
-        return HandleFindBlueprintNodes(Params);
-    }
-    else if (CommandType == TEXT("node_add_get_variable"))
-    {
-        return HandleAddBlueprintGetVariableNode(Params);
-    }
-    else if (CommandType == TEXT("node_add_set_variable"))
-    {
-        return HandleAddBlueprintSetVariableNode(Params);
-    }
-    else if (CommandType == TEXT("node_add_branch"))
-    {
-        return HandleAddBlueprintBranchNode(Params);
-    }
-    else if (CommandType == TEXT("node_add_for_each"))
-    {
-        return HandleAddBlueprintForEachNode(Params);
-    }
-    else if (CommandType == TEXT("node_add_return"))
-    {
-        return HandleAddBlueprintReturnNode(Params);
-    }
-    else if (CommandType == TEXT("node_get_info"))
-    {
-        return HandleGetNodeInfo(Params);
-    }
-    else if (CommandType == TEXT("node_get_graph_nodes"))
-    {
-        return HandleGetGraphNodes(Params);
-    }
-    else if (CommandType == TEXT("node_set_pin_value"))
-    {
-        return HandleSetPinDefaultValue(Params);
-    }
-    else if (CommandType == TEXT("node_auto_arrange"))
-    {
-        return HandleAutoArrangeNodes(Params);
-    }
-    else if (CommandType == TEXT("node_disconnect"))
-    {
-        return HandleDisconnectPin(Params);
-    }
-    else if (CommandType == TEXT("node_add_comment"))
-    {
-        return HandleAddComment(Params);
-    }
-    else if (CommandType == TEXT("graph_node_search_available"))
-    {
-        return HandleSearchBlueprintNodes(Params);
-    }
-    // BLUEPRINT COMMANDS (blueprint_*) - Graph-related operations
-    else if (CommandType == TEXT("blueprint_add_variable"))
+    if (TSharedPtr<FJsonObject> Result = UnrealCompanionCommandTable::Dispatch(*this, GetCommandTable(), CommandType, Params))
     {
-        return HandleAddBlueprintVariable(Params);
+        return Result;
     }
-    else if (CommandType == TEXT("blueprint_add_event_dispatcher"))
-    {
-        return HandleAddEventDispatcher(Params);
-    }
-    else if (CommandType == TEXT("blueprint_add_function"))
-    {
-        return HandleAddBlueprintFunction(Params);
-    }
-    else if (CommandType == TEXT("blueprint_implement_interface"))
-    {
-        return HandleImplementInterface(Params);
-    }
-    else if (CommandType == TEXT("blueprint_add_custom_event"))
-    {
-        return HandleAddCustomEvent(Params);
-    }
-    else if (CommandType == TEXT("blueprint_set_variable_default"))
-    {
-        return HandleSetVariableDefaultValue(Params);
-    }
-    else if (CommandType == TEXT("blueprint_add_local_variable"))
-    {
-        return HandleAddLocalVariable(Params);
-    }
-    else if (CommandType == TEXT("blueprint_get_info"))
-    {
-        return HandleGetBlueprintInfo(Params);
-    }
-    else if (CommandType == TEXT("blueprint_remove_variable"))
-    {
-        return HandleRemoveBlueprintVariable(Params);
-    }
-    else if (CommandType == TEXT("blueprint_remove_function"))
-    {
-        return HandleRemoveBlueprintFunction(Params);
-    }
-    else if (CommandType == TEXT("blueprint_remove_component"))
-    {
-        return HandleRemoveComponent(Params);
-    }
-    else if (CommandType == TEXT("blueprint_get_compilation_messages"))
-    {
-        return HandleGetCompilationMessages(Params);
-    }
-    // BATCH COMMANDS
-    // =========================================================================
-    // BATCH OPERATIONS
-    // =========================================================================
-    else if (CommandType == TEXT("graph_batch"))
-    {
-        return HandleNodeAddBatch(Params);
-    }
-    
     return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown node/blueprint command: %s"), *CommandType));
 }
 
@@ -3901,18 +3796,15 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintNodeCommands::HandleAutoArrange
     // Get arrange mode: "layered" (default), "straight", or "compact"
     FString ArrangeMode = TEXT("layered");
     Params->TryGetStringField(TEXT("arrange_mode"), ArrangeMode);
-    ArrangeMode = ArrangeMode.ToLower();
 
     // Get optional spacing parameters
-    float HorizontalSpacing = 400.0f;
-    float VerticalSpacing = 150.0f;
-    float FlowSpacing = 300.0f;  // Vertical space between separate exec flows
-    bool bAlignDataNodes = true;
-
-    Params->TryGetNumberField(TEXT("horizontal_spacing"), HorizontalSpacing);
-    Params->TryGetNumberField(TEXT("vertical_spacing"), VerticalSpacing);
-    Params->TryGetNumberField(TEXT("flow_spacing"), FlowSpacing);
-    Params->TryGetBoolField(TEXT("align_data_nodes"), bAlignDataNodes);
+    UnrealCompanionLayout::FLayoutSettings Settings;
+    Settings.Mode = UnrealCompanionLayout::ParseArrangeMode(ArrangeMode);
+    Params->TryGetNumberField(TEXT("horizontal_spacing"), Settings.HorizontalSpacing);
+    Params->TryGetNumberField(TEXT("vertical_spacing"), Settings.VerticalSpacing);
+    Params->TryGetNumberField(TEXT("flow_spacing"), Settings.FlowSpacing);
+    Params->TryGetBoolField(TEXT("align_data_nodes"), Settings.bAlignDataNodes);
+    Params->TryGetNumberField(TEXT("max_crossing_sweeps"), Settings.MaxCrossingSweeps);
 
     UBlueprint* Blueprint = FUnrealCompanionCommonUtils::FindBlueprint(BlueprintName);
     if (!Blueprint)
@@ -3926,575 +3818,35 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintNodeCommands::HandleAutoArrange
         return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Graph not found: %s"), GraphName.IsEmpty() ? TEXT("EventGraph") : *GraphName));
     }
 
-    // Skip comment nodes
-    TArray<UEdGraphNode*> NodesToArrange;
-    for (UEdGraphNode* Node : TargetGraph->Nodes)
-    {
-        if (Node && !Cast<UEdGraphNode_Comment>(Node))
-        {
-            NodesToArrange.Add(Node);
-        }
-    }
-
-    // =============================================================================
-    // PHASE 1: Identify entry nodes and separate exec flows
-    // =============================================================================
-    
-    TArray<UEdGraphNode*> EntryNodes;
-    TSet<UEdGraphNode*> ExecNodes;  // Nodes that have exec pins
-    TSet<UEdGraphNode*> DataNodes;  // Pure/data nodes (no exec pins)
-    
-    for (UEdGraphNode* Node : NodesToArrange)
+    // Optional node_ids: re-lay out only those nodes, around the rest of the graph
+    TArray<UEdGraphNode*> Subgraph;
+    const TArray<TSharedPtr<FJsonValue>>* NodeIdsArray = nullptr;
+    if (Params->TryGetArrayField(TEXT("node_ids"), NodeIdsArray) && NodeIdsArray)
     {
-        bool bHasExecPin = false;
-        for (UEdGraphPin* Pin : Node->Pins)
-        {
-            if (Pin && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
-            {
-                bHasExecPin = true;
-                break;
-            }
-        }
-
-        if (bHasExecPin)
-        {
-            ExecNodes.Add(Node);
-            
-            // Check if it's an entry node
-            bool bIsEntry = Cast<UK2Node_Event>(Node) || 
-                           Cast<UK2Node_FunctionEntry>(Node) || 
-                           Cast<UK2Node_CustomEvent>(Node);
-            
-            if (!bIsEntry)
-            {
-                // Check if it has no incoming exec connections
-                bool bHasExecInput = false;
-                for (UEdGraphPin* Pin : Node->Pins)
-                {
-                    if (Pin && Pin->Direction == EGPD_Input && 
-                        Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec &&
-                        Pin->LinkedTo.Num() > 0)
-                    {
-                        bHasExecInput = true;
-                        break;
-                    }
-                }
-                bIsEntry = !bHasExecInput;
-            }
-            
-            if (bIsEntry)
-            {
-                EntryNodes.Add(Node);
-            }
-        }
-        else
-        {
-            DataNodes.Add(Node);
-        }
-    }
-
-    // =============================================================================
-    // PHASE 2: Assign layers to exec nodes (following exec flow)
-    // =============================================================================
-    
-    // Each entry node starts a "flow" - nodes are assigned to (flow_index, layer)
-    TMap<UEdGraphNode*, int32> NodeLayers;        // Layer within flow
-    TMap<UEdGraphNode*, int32> NodeFlowIndex;     // Which flow the node belongs to
-    TMap<UEdGraphNode*, int32> NodeOrderInLayer;  // Order within layer for sorting
-    
-    int32 FlowIndex = 0;
-    for (UEdGraphNode* EntryNode : EntryNodes)
-    {
-        if (NodeLayers.Contains(EntryNode)) continue;  // Already processed in another flow
-        
-        // BFS through exec connections only
-        TArray<TPair<UEdGraphNode*, int32>> Queue;
-        Queue.Add(TPair<UEdGraphNode*, int32>(EntryNode, 0));
-        NodeLayers.Add(EntryNode, 0);
-        NodeFlowIndex.Add(EntryNode, FlowIndex);
-        NodeOrderInLayer.Add(EntryNode, 0);
-        
-        int32 OrderCounter = 0;
-        
-        while (Queue.Num() > 0)
-        {
-            UEdGraphNode* Current = Queue[0].Key;
-            int32 CurrentLayer = Queue[0].Value;
-            Queue.RemoveAt(0);
-            
-            // Follow exec output pins
-            for (UEdGraphPin* Pin : Current->Pins)
-            {
-                if (Pin && Pin->Direction == EGPD_Output && 
-                    Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
-                {
-                    for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
-                    {
-                        if (LinkedPin)
-                        {
-                            UEdGraphNode* LinkedNode = LinkedPin->GetOwningNode();
-                            if (LinkedNode && !NodeLayers.Contains(LinkedNode))
-                            {
-                                int32 NewLayer = CurrentLayer + 1;
-                                NodeLayers.Add(LinkedNode, NewLayer);
-                                NodeFlowIndex.Add(LinkedNode, FlowIndex);
-                                NodeOrderInLayer.Add(LinkedNode, ++OrderCounter);
-                                Queue.Add(TPair<UEdGraphNode*, int32>(LinkedNode, NewLayer));
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        
-        FlowIndex++;
-    }
-
-    // =============================================================================
-    // PHASE 3: Position exec nodes
-    // =============================================================================
-    
-    // Group exec nodes by (flow, layer)
-    TMap<int32, TMap<int32, TArray<UEdGraphNode*>>> NodesByFlowAndLayer;
-    int32 MaxLayer = 0;
-    
-    for (auto& Pair : NodeLayers)
-    {
-        UEdGraphNode* Node = Pair.Key;
-        int32 Layer = Pair.Value;
-        int32 Flow = NodeFlowIndex[Node];
-        
-        if (!NodesByFlowAndLayer.Contains(Flow))
-        {
-            NodesByFlowAndLayer.Add(Flow, TMap<int32, TArray<UEdGraphNode*>>());
-        }
-        if (!NodesByFlowAndLayer[Flow].Contains(Layer))
-        {
-            NodesByFlowAndLayer[Flow].Add(Layer, TArray<UEdGraphNode*>());
-        }
-        NodesByFlowAndLayer[Flow][Layer].Add(Node);
-        MaxLayer = FMath::Max(MaxLayer, Layer);
-    }
-
-    // Sort nodes within each layer by their order
-    for (auto& FlowPair : NodesByFlowAndLayer)
-    {
-        for (auto& LayerPair : FlowPair.Value)
-        {
-            TArray<UEdGraphNode*>& NodesToSort = LayerPair.Value;
-            // Simple bubble sort to avoid lambda issues with TArray::Sort
-            for (int32 i = 0; i < NodesToSort.Num() - 1; i++)
-            {
-                for (int32 j = 0; j < NodesToSort.Num() - i - 1; j++)
-                {
-                    int32 OrderA = NodeOrderInLayer.FindRef(NodesToSort[j]);
-                    int32 OrderB = NodeOrderInLayer.FindRef(NodesToSort[j + 1]);
-                    if (OrderA > OrderB)
-                    {
-                        NodesToSort.Swap(j, j + 1);
-                    }
-                }
-            }
-        }
-    }
-
-    // Calculate heights for each flow
-    TMap<int32, float> FlowHeights;
-    float TotalFlowHeight = 0.0f;
-    
-    for (auto& FlowPair : NodesByFlowAndLayer)
-    {
-        int32 Flow = FlowPair.Key;
-        int32 MaxNodesInLayer = 0;
-        
-        for (auto& LayerPair : FlowPair.Value)
-        {
-            MaxNodesInLayer = FMath::Max(MaxNodesInLayer, LayerPair.Value.Num());
-        }
-        
-        float FlowHeight = MaxNodesInLayer * VerticalSpacing;
-        FlowHeights.Add(Flow, FlowHeight);
-        TotalFlowHeight += FlowHeight + FlowSpacing;
-    }
-
-    // Position exec nodes based on arrange mode
-    float CurrentFlowY = 0.0f;
-    TMap<UEdGraphNode*, FVector2D> NodePositions;
-    
-    if (ArrangeMode == TEXT("straight"))
-    {
-        // ==========================================================================
-        // MODE: STRAIGHT - All exec nodes on the same Y line per flow
-        // Like a horizontal timeline: [Event] --> [Node1] --> [Node2] --> [Node3]
-        // Data nodes are positioned ABOVE their connected exec nodes
-        // ==========================================================================
-        
-        // Helper lambda to estimate node width based on number of pins
-        auto EstimateNodeWidth = [](UEdGraphNode* Node) -> float
-        {
-            const float BaseWidth = 200.0f;
-            const float PinWidthContribution = 15.0f;
-            int32 MaxPinsOnSide = 0;
-            int32 InputPins = 0;
-            int32 OutputPins = 0;
-            
-            for (UEdGraphPin* Pin : Node->Pins)
-            {
-                if (Pin)
-                {
-                    if (Pin->Direction == EGPD_Input) InputPins++;
-                    else OutputPins++;
-                }
-            }
-            
-            MaxPinsOnSide = FMath::Max(InputPins, OutputPins);
-            
-            // Also consider node title length
-            float TitleWidth = Node->GetNodeTitle(ENodeTitleType::ListView).ToString().Len() * 7.0f;
-            
-            return FMath::Max(BaseWidth + MaxPinsOnSide * PinWidthContribution, TitleWidth + 60.0f);
-        };
-        
-        // Node dimensions
-        const float DataNodeHeight = 50.0f;
-        const float DataNodeSpacingY = 15.0f;
-        const float ExecToDataSpacing = 40.0f;    // Gap between exec line and first data node row
-        const float MinHorizontalGap = 80.0f;     // Minimum gap between nodes
-        
-        for (int32 Flow = 0; Flow < FlowIndex; Flow++)
-        {
-            if (!NodesByFlowAndLayer.Contains(Flow)) continue;
-            
-            // ======================================================================
-            // STEP 1: Collect all exec nodes in order for this flow
-            // ======================================================================
-            TArray<UEdGraphNode*> FlowExecNodes;
-            TMap<UEdGraphNode*, int32> ExecNodeToIndex;
-            
-            for (int32 Layer = 0; Layer <= MaxLayer; Layer++)
-            {
-                if (NodesByFlowAndLayer[Flow].Contains(Layer))
-                {
-                    for (UEdGraphNode* Node : NodesByFlowAndLayer[Flow][Layer])
-                    {
-                        ExecNodeToIndex.Add(Node, FlowExecNodes.Num());
-                        FlowExecNodes.Add(Node);
-                    }
-                }
-            }
-            
-            // ======================================================================
-            // STEP 2: Find data nodes connected to each exec node (as INPUT to exec)
-            // A data node is connected to an exec node if it provides data to that exec node
-            // ======================================================================
-            TMap<UEdGraphNode*, TArray<UEdGraphNode*>> ExecToDataNodes;
-            TSet<UEdGraphNode*> ProcessedDataNodes;
-            
-            for (UEdGraphNode* ExecNode : FlowExecNodes)
-            {
-                ExecToDataNodes.Add(ExecNode, TArray<UEdGraphNode*>());
-                
-                // Check all input pins on this exec node
-                for (UEdGraphPin* Pin : ExecNode->Pins)
-                {
-                    if (Pin && Pin->Direction == EGPD_Input && 
-                        Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec)
-                    {
-                        for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
-                        {
-                            if (LinkedPin)
-                            {
-                                UEdGraphNode* DataNode = LinkedPin->GetOwningNode();
-                                if (DataNode && DataNodes.Contains(DataNode))
-                                {
-                                    ExecToDataNodes[ExecNode].AddUnique(DataNode);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            
-            // ======================================================================
-            // STEP 3: Calculate X positions for exec nodes based on their widths
-            // ======================================================================
-            TMap<UEdGraphNode*, float> ExecNodeWidths;
-            TMap<UEdGraphNode*, float> ExecNodeX;
-            float CurrentX = 0.0f;
-            
-            for (UEdGraphNode* ExecNode : FlowExecNodes)
-            {
-                float NodeWidth = EstimateNodeWidth(ExecNode);
-                ExecNodeWidths.Add(ExecNode, NodeWidth);
-                ExecNodeX.Add(ExecNode, CurrentX);
-                CurrentX += NodeWidth + MinHorizontalGap;
-            }
-            
-            // ======================================================================
-            // STEP 4: Calculate maximum data node rows needed for Y offset
-            // ======================================================================
-            int32 MaxDataRows = 0;
-            for (auto& Pair : ExecToDataNodes)
-            {
-                MaxDataRows = FMath::Max(MaxDataRows, Pair.Value.Num());
-            }
-            
-            // Reserve space ABOVE exec line for data nodes
-            float DataZoneHeight = MaxDataRows * (DataNodeHeight + DataNodeSpacingY);
-            float ExecLineY = CurrentFlowY + DataZoneHeight + ExecToDataSpacing;
-            
-            // ======================================================================
-            // STEP 5: Position exec nodes on the horizontal line
-            // ======================================================================
-            for (UEdGraphNode* ExecNode : FlowExecNodes)
-            {
-                NodePositions.Add(ExecNode, FVector2D(ExecNodeX[ExecNode], ExecLineY));
-            }
-            
-            // ======================================================================
-            // STEP 6: Position data nodes ABOVE their connected exec nodes
-            // Strategy: Place each data node directly above the leftmost exec node
-            // that uses it, stacking vertically if multiple data nodes connect
-            // ======================================================================
-            
-            // Track Y slots per exec node column for stacking
-            TMap<UEdGraphNode*, int32> ExecNodeDataSlot;
-            for (UEdGraphNode* ExecNode : FlowExecNodes)
-            {
-                ExecNodeDataSlot.Add(ExecNode, 0);
-            }
-            
-            // Sort data nodes by which exec node they connect to (leftmost first)
-            // This helps keep data nodes near their consumers
-            for (UEdGraphNode* ExecNode : FlowExecNodes)
-            {
-                TArray<UEdGraphNode*>& ConnectedDataNodes = ExecToDataNodes[ExecNode];
-                
-                for (UEdGraphNode* DataNode : ConnectedDataNodes)
-                {
-                    // Skip if already positioned
-                    if (ProcessedDataNodes.Contains(DataNode)) continue;
-                    ProcessedDataNodes.Add(DataNode);
-                    
-                    // Calculate position: above exec node, offset left, stacked by slot
-                    float DataNodeWidth = EstimateNodeWidth(DataNode);
-                    float ExecX = ExecNodeX[ExecNode];
-                    int32 Slot = ExecNodeDataSlot[ExecNode];
-                    
-                    // Position: slightly left of exec node, above by slot
-                    float DataX = ExecX - (DataNodeWidth * 0.3f);  // Offset left by 30% of data node width
-                    float DataY = ExecLineY - ExecToDataSpacing - (Slot + 1) * (DataNodeHeight + DataNodeSpacingY);
-                    
-                    NodePositions.Add(DataNode, FVector2D(DataX, DataY));
-                    
-                    // Increment slot for next data node on this exec
-                    ExecNodeDataSlot[ExecNode] = Slot + 1;
-                }
-            }
-            
-            // ======================================================================
-            // STEP 7: Update flow position for next flow
-            // ======================================================================
-            CurrentFlowY = ExecLineY + 120.0f + FlowSpacing;  // 120 = approx exec node height
-        }
-    }
-    else if (ArrangeMode == TEXT("compact"))
-    {
-        // ==========================================================================
-        // MODE: COMPACT - Minimize vertical space, stack branches tightly
-        // ==========================================================================
-        
-        for (int32 Flow = 0; Flow < FlowIndex; Flow++)
-        {
-            if (!NodesByFlowAndLayer.Contains(Flow)) continue;
-            
-            // Track the lowest Y used in each layer column
-            TMap<int32, float> LayerBottomY;
-            
-            for (int32 Layer = 0; Layer <= MaxLayer; Layer++)
-            {
-                if (!NodesByFlowAndLayer[Flow].Contains(Layer)) continue;
-                
-                TArray<UEdGraphNode*>& NodesInLayer = NodesByFlowAndLayer[Flow][Layer];
-                float X = Layer * HorizontalSpacing;
-                
-                // Find the highest Y from previous layers (for this branch)
-                float StartY = CurrentFlowY;
-                if (Layer > 0 && LayerBottomY.Contains(Layer - 1))
-                {
-                    // For compact mode, try to align with connected nodes
-                    StartY = FMath::Max(CurrentFlowY, LayerBottomY[Layer - 1] - (NodesInLayer.Num() - 1) * VerticalSpacing * 0.5f);
-                }
-                
-                float Y = StartY;
-                for (UEdGraphNode* Node : NodesInLayer)
-                {
-                    NodePositions.Add(Node, FVector2D(X, Y));
-                    Y += VerticalSpacing * 0.7f;  // Tighter spacing
-                }
-                
-                LayerBottomY.Add(Layer, Y);
-            }
-            
-            // Find the maximum bottom Y for this flow
-            float MaxBottomY = CurrentFlowY;
-            for (auto& Pair : LayerBottomY)
-            {
-                MaxBottomY = FMath::Max(MaxBottomY, Pair.Value);
-            }
-            
-            CurrentFlowY = MaxBottomY + FlowSpacing * 0.5f;
-        }
-    }
-    else
-    {
-        // ==========================================================================
-        // MODE: LAYERED (default) - Original behavior with vertical layers
-        // ==========================================================================
-        
-        for (int32 Flow = 0; Flow < FlowIndex; Flow++)
-        {
-            if (!NodesByFlowAndLayer.Contains(Flow)) continue;
-            
-            for (int32 Layer = 0; Layer <= MaxLayer; Layer++)
-            {
-                if (!NodesByFlowAndLayer[Flow].Contains(Layer)) continue;
-                
-                TArray<UEdGraphNode*>& NodesInLayer = NodesByFlowAndLayer[Flow][Layer];
-                float X = Layer * HorizontalSpacing;
-                float Y = CurrentFlowY;
-                
-                for (UEdGraphNode* Node : NodesInLayer)
-                {
-                    NodePositions.Add(Node, FVector2D(X, Y));
-                    Y += VerticalSpacing;
-                }
-            }
-            
-            CurrentFlowY += FlowHeights[Flow] + FlowSpacing;
-        }
-    }
-
-    // =============================================================================
-    // PHASE 4: Position data nodes (for modes other than straight, which does it inline)
-    // =============================================================================
-    
-    // Skip this phase for "straight" mode - data nodes are already positioned in phase 3
-    if (ArrangeMode != TEXT("straight"))
-    {
-        // Data node offset depends on mode
-        float DataNodeYOffset = VerticalSpacing * 0.7f;
-        float DataNodeXOffset = -100.0f;
-        
-        if (bAlignDataNodes)
-        {
-            // Track data nodes per X position to stack them if multiple connect to same exec node
-            TMap<int32, int32> DataNodeCountAtX;
-            
-            for (UEdGraphNode* DataNode : DataNodes)
-            {
-                // Skip if already positioned
-                if (NodePositions.Contains(DataNode)) continue;
-                
-                // Find the exec node(s) that use this data node
-                float AvgX = 0.0f;
-                float MaxY = -FLT_MAX;
-                int32 ConnectionCount = 0;
-                
-                for (UEdGraphPin* Pin : DataNode->Pins)
-                {
-                    if (Pin && Pin->Direction == EGPD_Output)
-                    {
-                        for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
-                        {
-                            if (LinkedPin)
-                            {
-                                UEdGraphNode* ConnectedNode = LinkedPin->GetOwningNode();
-                                if (ConnectedNode && NodePositions.Contains(ConnectedNode))
-                                {
-                                    FVector2D ConnectedPos = NodePositions[ConnectedNode];
-                                    AvgX += ConnectedPos.X;
-                                    MaxY = FMath::Max(MaxY, ConnectedPos.Y);
-                                    ConnectionCount++;
-                                }
-                            }
-                        }
-                    }
-                }
-                
-                if (ConnectionCount > 0)
-                {
-                    // Position below the average of connected nodes
-                    float DataX = (AvgX / ConnectionCount) + DataNodeXOffset;
-                    
-                    // Stack data nodes if multiple connect to same X position
-                    int32 XKey = static_cast<int32>(DataX / 50.0f);  // Group nearby X positions
-                    int32 StackIndex = DataNodeCountAtX.FindRef(XKey);
-                    DataNodeCountAtX.Add(XKey, StackIndex + 1);
-                    
-                    float DataY = MaxY + DataNodeYOffset + (StackIndex * VerticalSpacing * 0.6f);
-                    NodePositions.Add(DataNode, FVector2D(DataX, DataY));
-                }
-                else
-                {
-                    // Disconnected data node - place at end
-                    NodePositions.Add(DataNode, FVector2D(0.0f, CurrentFlowY));
-                    CurrentFlowY += VerticalSpacing * 0.5f;
-                }
-            }
-        }
-        else
-        {
-            // Simple positioning for data nodes
-            float DataY = CurrentFlowY;
-            for (UEdGraphNode* DataNode : DataNodes)
-            {
-                if (!NodePositions.Contains(DataNode))
-                {
-                    NodePositions.Add(DataNode, FVector2D(0.0f, DataY));
-                    DataY += VerticalSpacing * 0.5f;
-                }
-            }
-        }
-    }
-    else
-    {
-        // For straight mode: position any remaining unpositioned data nodes
-        float DataY = CurrentFlowY;
-        for (UEdGraphNode* DataNode : DataNodes)
+        for (const TSharedPtr<FJsonValue>& Value : *NodeIdsArray)
         {
-            if (!NodePositions.Contains(DataNode))
+            if (UEdGraphNode* Node = UnrealCompanionNode::FindByGuidString(TargetGraph, Value->AsString()))
             {
-                NodePositions.Add(DataNode, FVector2D(0.0f, DataY));
-                DataY += VerticalSpacing * 0.5f;
+                Subgraph.Add(Node);
             }
         }
     }
 
-    // =============================================================================
-    // PHASE 5: Apply positions
-    // =============================================================================
-    
-    for (auto& Pair : NodePositions)
-    {
-        UEdGraphNode* Node = Pair.Key;
-        FVector2D Pos = Pair.Value;
-        Node->NodePosX = Pos.X;
-        Node->NodePosY = Pos.Y;
-    }
+    const UnrealCompanionLayout::FLayoutResult Layout = NodeIdsArray
+        ? UnrealCompanionLayout::ArrangeSubgraph(TargetGraph, Subgraph, Settings)
+        : UnrealCompanionLayout::ArrangeGraph(TargetGraph, Settings);
 
     FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
 
-    UE_LOG(LogTemp, Display, TEXT("Auto-arranged %d nodes in graph %s using '%s' mode (%d flows, %d layers)"), 
-        NodesToArrange.Num(), *TargetGraph->GetFName().ToString(), *ArrangeMode, FlowIndex, MaxLayer + 1);
+    UE_LOG(LogTemp, Display, TEXT("Auto-arranged %d nodes in graph %s using '%s' mode (%d flows, %d layers, %d -> %d crossings)"), 
+        Layout.NodesArranged, *TargetGraph->GetFName().ToString(), UnrealCompanionLayout::GetArrangeModeName(Settings.Mode),
+        Layout.Flows, Layout.MaxLayer + 1, Layout.InitialCrossings, Layout.Crossings);
 
-    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    TSharedPtr<FJsonObject> ResultObj = Layout.ToJson();
     ResultObj->SetStringField(TEXT("graph_name"), TargetGraph->GetFName().ToString());
-    ResultObj->SetStringField(TEXT("arrange_mode"), ArrangeMode);
-    ResultObj->SetNumberField(TEXT("nodes_arranged"), NodesToArrange.Num());
-    ResultObj->SetNumberField(TEXT("exec_flows"), FlowIndex);
-    ResultObj->SetNumberField(TEXT("max_layer"), MaxLayer);
-    ResultObj->SetNumberField(TEXT("data_nodes"), DataNodes.Num());
+    ResultObj->SetStringField(TEXT("arrange_mode"), UnrealCompanionLayout::GetArrangeModeName(Settings.Mode));
+    ResultObj->SetNumberField(TEXT("exec_flows"), Layout.Flows);
+    ResultObj->SetBoolField(TEXT("incremental"), NodeIdsArray != nullptr);
     return ResultObj;
 }
 
@@ -4516,86 +3868,69 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintNodeCommands::HandleSearchBluep
     TArray<TSharedPtr<FJsonValue>> NodesArray;
     int32 ResultCount = 0;
 
-    // Search through all loaded classes
-    for (TObjectIterator<UClass> ClassIt; ClassIt && ResultCount < MaxResults; ++ClassIt)
+    // Ranked lookup in the prebuilt catalogue (no per-call class walk)
+    TArray<FNodeCatalogMatch> Matches;
+    FNodeCatalog::Get().Search(SearchTerm, ClassName, MaxResults, Matches);
+
+    for (const FNodeCatalogMatch& Match : Matches)
     {
-        UClass* Class = *ClassIt;
-        if (!Class) continue;
+        const FNodeCatalogEntry& Entry = *Match.Entry;
 
-        // Skip deprecated and abstract classes
-        if (Class->HasAnyClassFlags(CLASS_Deprecated | CLASS_Abstract))
-            continue;
+        TSharedPtr<FJsonObject> NodeObj = MakeShared<FJsonObject>();
+        NodeObj->SetStringField(TEXT("class_name"), Entry.ClassName);
+        NodeObj->SetNumberField(TEXT("score"), Match.Score);
 
-        // Filter by class name if provided
-        if (!ClassName.IsEmpty())
+        if (Entry.Kind == ENodeCatalogKind::Macro)
         {
-            if (!Class->GetName().Contains(ClassName))
-                continue;
+            NodeObj->SetStringField(TEXT("kind"), TEXT("macro"));
+            NodeObj->SetStringField(TEXT("macro_name"), Entry.Name.ToString());
+            NodesArray.Add(MakeShared<FJsonValueObject>(NodeObj));
+            ResultCount++;
+            continue;
         }
 
-        // Iterate through all functions in this class
-        for (TFieldIterator<UFunction> FuncIt(Class, EFieldIteratorFlags::ExcludeSuper); FuncIt && ResultCount < MaxResults; ++FuncIt)
-        {
-            UFunction* Func = *FuncIt;
-            if (!Func) continue;
+        UFunction* Func = Entry.Function.Get();
+        NodeObj->SetStringField(TEXT("kind"), Entry.Kind == ENodeCatalogKind::Event ? TEXT("event") : TEXT("function"));
+        NodeObj->SetStringField(TEXT("function_name"), Func->GetName());
+        NodeObj->SetStringField(TEXT("category"), Entry.Category);
+        NodeObj->SetBoolField(TEXT("is_pure"), (Func->FunctionFlags & FUNC_BlueprintPure) != 0);
+        NodeObj->SetBoolField(TEXT("is_const"), (Func->FunctionFlags & FUNC_Const) != 0);
+        NodeObj->SetBoolField(TEXT("is_static"), (Func->FunctionFlags & FUNC_Static) != 0);
 
-            // Only include BlueprintCallable functions
-            if (!(Func->FunctionFlags & FUNC_BlueprintCallable))
-                continue;
+        // Get input/output parameters
+        TArray<TSharedPtr<FJsonValue>> InputsArray;
+        TArray<TSharedPtr<FJsonValue>> OutputsArray;
 
-            FString FuncName = Func->GetName();
+        for (TFieldIterator<FProperty> PropIt(Func); PropIt; ++PropIt)
+        {
+            FProperty* Prop = *PropIt;
+            if (!Prop) continue;
 
-            // Filter by search term if provided
-            if (!SearchTerm.IsEmpty())
+            TSharedPtr<FJsonObject> ParamObj = MakeShared<FJsonObject>();
+            ParamObj->SetStringField(TEXT("name"), Prop->GetName());
+            ParamObj->SetStringField(TEXT("type"), Prop->GetCPPType());
+
+            if (Prop->HasAnyPropertyFlags(CPF_ReturnParm))
             {
-                if (!FuncName.Contains(SearchTerm, ESearchCase::IgnoreCase))
-                    continue;
+                OutputsArray.Add(MakeShared<FJsonValueObject>(ParamObj));
             }
-
-            // Create node info
-            TSharedPtr<FJsonObject> NodeObj = MakeShared<FJsonObject>();
-            NodeObj->SetStringField(TEXT("function_name"), FuncName);
-            NodeObj->SetStringField(TEXT("class_name"), Class->GetName());
-            NodeObj->SetStringField(TEXT("category"), Func->GetMetaData(TEXT("Category")));
-            NodeObj->SetBoolField(TEXT("is_pure"), (Func->FunctionFlags & FUNC_BlueprintPure) != 0);
-            NodeObj->SetBoolField(TEXT("is_const"), (Func->FunctionFlags & FUNC_Const) != 0);
-            NodeObj->SetBoolField(TEXT("is_static"), (Func->FunctionFlags & FUNC_Static) != 0);
-
-            // Get input/output parameters
-            TArray<TSharedPtr<FJsonValue>> InputsArray;
-            TArray<TSharedPtr<FJsonValue>> OutputsArray;
-
-            for (TFieldIterator<FProperty> PropIt(Func); PropIt; ++PropIt)
+            else if (Prop->HasAnyPropertyFlags(CPF_OutParm) && !Prop->HasAnyPropertyFlags(CPF_ConstParm))
             {
-                FProperty* Prop = *PropIt;
-                if (!Prop) continue;
-
-                TSharedPtr<FJsonObject> ParamObj = MakeShared<FJsonObject>();
-                ParamObj->SetStringField(TEXT("name"), Prop->GetName());
-                ParamObj->SetStringField(TEXT("type"), Prop->GetCPPType());
-
-                if (Prop->HasAnyPropertyFlags(CPF_ReturnParm))
-                {
-                    OutputsArray.Add(MakeShared<FJsonValueObject>(ParamObj));
-                }
-                else if (Prop->HasAnyPropertyFlags(CPF_OutParm) && !Prop->HasAnyPropertyFlags(CPF_ConstParm))
-                {
-                    OutputsArray.Add(MakeShared<FJsonValueObject>(ParamObj));
-                }
-                else if (Prop->HasAnyPropertyFlags(CPF_Parm))
-                {
-                    InputsArray.Add(MakeShared<FJsonValueObject>(ParamObj));
-                }
+                OutputsArray.Add(MakeShared<FJsonValueObject>(ParamObj));
+            }
+            else if (Prop->HasAnyPropertyFlags(CPF_Parm))
+            {
+                InputsArray.Add(MakeShared<FJsonValueObject>(ParamObj));
             }
+        }
 
-            NodeObj->SetArrayField(TEXT("inputs"), InputsArray);
-            NodeObj->SetArrayField(TEXT("outputs"), OutputsArray);
-            NodeObj->SetNumberField(TEXT("input_count"), InputsArray.Num());
-            NodeObj->SetNumberField(TEXT("output_count"), OutputsArray.Num());
+        NodeObj->SetArrayField(TEXT("inputs"), InputsArray);
+        NodeObj->SetArrayField(TEXT("outputs"), OutputsArray);
+        NodeObj->SetNumberField(TEXT("input_count"), InputsArray.Num());
+        NodeObj->SetNumberField(TEXT("output_count"), OutputsArray.Num());
 
-            NodesArray.Add(MakeShared<FJsonValueObject>(NodeObj));
-            ResultCount++;
-        }
+        NodesArray.Add(MakeShared<FJsonValueObject>(NodeObj));
+        ResultCount++;
     }
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -5857,8 +5192,8 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintNodeCommands::HandleNodeAddBatc
     // =========================================================================
     FScopedTransaction Transaction(FText::FromString(TEXT("MCP Node Batch")));
     
-    TMap<FString, UEdGraphNode*> RefToNode;
-    TMap<FString, FString> RefToId;
+    TScratchMap<FString, UEdGraphNode*> RefToNode;
+    TScratchMap<FString, FString> RefToId;
     TArray<TSharedPtr<FJsonObject>> NodeResults;
     TArray<TSharedPtr<FJsonObject>> Errors;
     int32 NodesRemoved = 0;
@@ -5888,8 +5223,8 @@ TSharedPtr<FJsonObject> FUnrealCompanionBlueprintNodeCommands::HandleNodeAddBatc
     if (bHasNodesToRemove && Graph && Blueprint)
     {
         // First pass: collect node GUIDs to remove
-        TSet<FGuid> GuidsToRemove;
-        TMap<FGuid, int32> GuidToIndex;
+        TScratchSet<FGuid> GuidsToRemove;
+        TScratchMap<FGuid, int32> GuidToIndex;
         
         for (int32 i = 0; i < RemoveArray->Num(); i++)
         {
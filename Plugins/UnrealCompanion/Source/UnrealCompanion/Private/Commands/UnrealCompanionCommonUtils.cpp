@@ -1,4 +1,5 @@
 #include "Commands/UnrealCompanionCommonUtils.h"
+#include "UnrealCompanionStats.h"
 #include "GameFramework/Actor.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
@@ -24,11 +25,18 @@
 #include "Engine/Selection.h"
 #include "EditorAssetLibrary.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/PackageName.h"
+#include "Commands/UnrealCompanionAssetIndex.h"
+#include "Commands/UnrealCompanionActorIndex.h"
+#include "Commands/UnrealCompanionCompileSession.h"
+#include "Commands/UnrealCompanionParams.h"
+#include "Commands/UnrealCompanionEditorFocus.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "BlueprintNodeSpawner.h"
 #include "BlueprintActionDatabase.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
+#include "JsonObjectConverter.h"
 
 // Editor navigation includes
 #include "Editor.h"
@@ -242,6 +250,12 @@ TSharedPtr<FJsonObject> FUnrealCompanionCommonUtils::CreateBatchErrorObject(
 
 FUnrealCompanionCommonUtils::FMCPStandardParams FUnrealCompanionCommonUtils::GetStandardParams(const TSharedPtr<FJsonObject>& Params)
 {
+    // Commands registered with a params schema had these parsed before they were queued
+    if (const FMCPStandardParams* PreParsed = FUnrealCompanionParams::FindStandard(Params))
+    {
+        return *PreParsed;
+    }
+
     FMCPStandardParams StandardParams;
     
     if (Params.IsValid())
@@ -292,6 +306,32 @@ FUnrealCompanionCommonUtils::FMCPStandardParams FUnrealCompanionCommonUtils::Get
     return StandardParams;
 }
 
+int32 FUnrealCompanionCommonUtils::GetSeedFromParams(const TSharedPtr<FJsonObject>& Params)
+{
+    int32 Seed = 0;
+    if (Params.IsValid() && Params->TryGetNumberField(TEXT("seed"), Seed))
+    {
+        return Seed;
+    }
+    return FMath::Rand();
+}
+
+FRandomStream FUnrealCompanionCommonUtils::MakeIndexedRandomStream(int32 Seed, int32 Index)
+{
+    // FRandomStream is an LCG: adjacent seeds give correlated sequences, so scramble
+    // (Seed, Index) through a 32-bit finaliser first
+    auto Mix = [](uint32 H)
+    {
+        H ^= H >> 16;
+        H *= 0x85EBCA6Bu;
+        H ^= H >> 13;
+        H *= 0xC2B2AE35u;
+        H ^= H >> 16;
+        return H;
+    };
+    return FRandomStream((int32)Mix(Mix((uint32)Seed) + (uint32)Index * 0x9E3779B9u));
+}
+
 // =============================================================================
 // JSON Utilities
 // =============================================================================
@@ -393,6 +433,59 @@ FRotator FUnrealCompanionCommonUtils::GetRotatorFromJson(const TSharedPtr<FJsonO
     return Result;
 }
 
+// Asset Registry Utilities
+bool FUnrealCompanionCommonUtils::DoesAssetExistInRegistry(const FString& AssetPath)
+{
+    // Accept both package paths (/Game/Dir/Asset) and object paths (/Game/Dir/Asset.Asset)
+    FString ObjectPath = AssetPath;
+    if (!ObjectPath.Contains(TEXT(".")))
+    {
+        ObjectPath = FString::Printf(TEXT("%s.%s"), *AssetPath, *FPackageName::GetShortName(AssetPath));
+    }
+
+    FAssetData AssetData = IAssetRegistry::GetChecked().GetAssetByObjectPath(FSoftObjectPath(ObjectPath));
+    return AssetData.IsValid();
+}
+
+FTopLevelAssetPath FUnrealCompanionCommonUtils::ResolveAssetClassPath(const FString& ClassName)
+{
+    if (ClassName.StartsWith(TEXT("/")))
+    {
+        return FTopLevelAssetPath(ClassName);
+    }
+
+    // Looked up by name, not FindObject: must stay valid off the game thread
+    static const TMap<FString, const TCHAR*> NonEngineClasses = {
+        { TEXT("WidgetBlueprint"), TEXT("/Script/UMGEditor") },
+        { TEXT("NiagaraSystem"), TEXT("/Script/Niagara") },
+        { TEXT("NiagaraEmitter"), TEXT("/Script/Niagara") },
+        { TEXT("NiagaraScript"), TEXT("/Script/Niagara") },
+        { TEXT("NiagaraParameterCollection"), TEXT("/Script/Niagara") },
+        { TEXT("BehaviorTree"), TEXT("/Script/AIModule") },
+        { TEXT("BlackboardData"), TEXT("/Script/AIModule") },
+        { TEXT("LevelSequence"), TEXT("/Script/LevelSequence") },
+        { TEXT("InputAction"), TEXT("/Script/EnhancedInput") },
+        { TEXT("InputMappingContext"), TEXT("/Script/EnhancedInput") },
+        { TEXT("GeometryCollection"), TEXT("/Script/GeometryCollectionEngine") },
+        { TEXT("LandscapeLayerInfoObject"), TEXT("/Script/Landscape") },
+        { TEXT("FoliageType_InstancedStaticMesh"), TEXT("/Script/Foliage") },
+        { TEXT("PhysicalMaterial"), TEXT("/Script/PhysicsCore") },
+    };
+
+    const TCHAR* const* Package = NonEngineClasses.Find(ClassName);
+    return FTopLevelAssetPath(Package ? *Package : TEXT("/Script/Engine"), *ClassName);
+}
+
+bool FUnrealCompanionCommonUtils::DoesFolderExistInRegistry(const FString& FolderPath)
+{
+    FString Path = FolderPath;
+    while (Path.Len() > 1 && Path.EndsWith(TEXT("/")))
+    {
+        Path.LeftChopInline(1);
+    }
+    return IAssetRegistry::GetChecked().PathExists(Path);
+}
+
 // Blueprint Utilities
 UBlueprint* FUnrealCompanionCommonUtils::FindBlueprint(const FString& BlueprintName)
 {
@@ -411,49 +504,20 @@ UBlueprint* FUnrealCompanionCommonUtils::FindBlueprintByName(const FString& Blue
         }
     }
     
-    // Use AssetRegistry to search for the Blueprint anywhere in the project
-    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
-    
-    // Search for Blueprint assets matching the name
-    FARFilter Filter;
-    Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
-    Filter.bRecursivePaths = true;
-    Filter.bRecursiveClasses = true;
-    
-    TArray<FAssetData> AssetDataList;
-    AssetRegistry.GetAssets(Filter, AssetDataList);
-    
-    // Find exact match first
-    for (const FAssetData& AssetData : AssetDataList)
+    // Indexed name lookup across the whole project (subclasses included: Anim/Widget Blueprints)
+    FSoftObjectPath ObjectPath;
+    if (FUnrealCompanionAssetIndex::Get().FindAsset(BlueprintName, UBlueprint::StaticClass(), true, false, ObjectPath))
     {
-        if (AssetData.AssetName.ToString() == BlueprintName)
+        if (UBlueprint* Blueprint = Cast<UBlueprint>(ObjectPath.TryLoad()))
         {
-            UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset());
-            if (Blueprint)
-            {
-                UE_LOG(LogTemp, Log, TEXT("Found Blueprint '%s' at path: %s"), *BlueprintName, *AssetData.GetSoftObjectPath().ToString());
-                return Blueprint;
-            }
-        }
-    }
-    
-    // Try partial match (case insensitive)
-    for (const FAssetData& AssetData : AssetDataList)
-    {
-        if (AssetData.AssetName.ToString().Equals(BlueprintName, ESearchCase::IgnoreCase))
-        {
-            UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset());
-            if (Blueprint)
-            {
-                UE_LOG(LogTemp, Log, TEXT("Found Blueprint '%s' (case-insensitive) at path: %s"), *BlueprintName, *AssetData.GetSoftObjectPath().ToString());
-                return Blueprint;
-            }
+            UE_LOG(LogTemp, Log, TEXT("Found Blueprint '%s' at path: %s"), *BlueprintName, *ObjectPath.ToString());
+            return Blueprint;
         }
     }
     
     // Fallback: try the old hardcoded path for backwards compatibility
     FString LegacyPath = TEXT("/Game/Blueprints/") + BlueprintName;
-    UBlueprint* LegacyBlueprint = LoadObject<UBlueprint>(nullptr, *LegacyPath);
+    UBlueprint* LegacyBlueprint = DoesAssetExistInRegistry(LegacyPath) ? LoadObject<UBlueprint>(nullptr, *LegacyPath) : nullptr;
     if (LegacyBlueprint)
     {
         UE_LOG(LogTemp, Log, TEXT("Found Blueprint '%s' at legacy path: %s"), *BlueprintName, *LegacyPath);
@@ -500,9 +564,19 @@ bool FUnrealCompanionCommonUtils::CompileBlueprintIfNeeded(UBlueprint* Blueprint
         return false;
     }
     
+    // Inside a core_session the compile happens once at commit
+    if (FUnrealCompanionCompileSession::Get().DeferCompile(Blueprint))
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("CompileBlueprintIfNeeded: deferred %s to compile session"), *Blueprint->GetName());
+        return false;
+    }
+    
     UE_LOG(LogTemp, Display, TEXT("Compiling Blueprint: %s"), *Blueprint->GetName());
     
-    FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    {
+        UNREALCOMPANION_SCOPE_CYCLE_COUNTER(STAT_UnrealCompanion_Compile);
+        FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    }
     
     // Check compilation status
     EBlueprintStatus Status = Blueprint->Status;
@@ -940,6 +1014,61 @@ UK2Node_Event* FUnrealCompanionCommonUtils::FindExistingEventNode(UEdGraph* Grap
     return nullptr;
 }
 
+namespace
+{
+    FUnrealCompanionCommonUtils::FScopedPropertyCache* GActivePropertyCache = nullptr;
+}
+
+FUnrealCompanionCommonUtils::FScopedPropertyCache::FScopedPropertyCache()
+    : Outer(GActivePropertyCache)
+{
+    check(IsInGameThread() && FUnrealCompanionScratch::IsActive());
+    GActivePropertyCache = this;
+}
+
+FUnrealCompanionCommonUtils::FScopedPropertyCache::~FScopedPropertyCache()
+{
+    check(GActivePropertyCache == this);
+    GActivePropertyCache = Outer;
+}
+
+FUnrealCompanionCommonUtils::FScopedBlueprintModification::FScopedBlueprintModification(UBlueprint* InBlueprint)
+    : Blueprint(InBlueprint)
+{
+    check(IsInGameThread());
+    if (InBlueprint && InBlueprint->Status != BS_BeingCreated)
+    {
+        SavedStatus = InBlueprint->Status;
+        InBlueprint->Status = BS_BeingCreated;
+        bActive = true;
+    }
+}
+
+FUnrealCompanionCommonUtils::FScopedBlueprintModification::~FScopedBlueprintModification()
+{
+    Finish();
+}
+
+void FUnrealCompanionCommonUtils::FScopedBlueprintModification::Finish(bool bModified)
+{
+    if (!bActive)
+    {
+        return;
+    }
+    bActive = false;
+
+    UBlueprint* Target = Blueprint.Get();
+    if (!Target)
+    {
+        return;
+    }
+    Target->Status = static_cast<EBlueprintStatus>(SavedStatus);
+    if (bModified)
+    {
+        FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Target);
+    }
+}
+
 bool FUnrealCompanionCommonUtils::SetObjectProperty(UObject* Object, const FString& PropertyName, 
                                      const TSharedPtr<FJsonValue>& Value, FString& OutErrorMessage)
 {
@@ -949,49 +1078,124 @@ bool FUnrealCompanionCommonUtils::SetObjectProperty(UObject* Object, const FStri
         return false;
     }
 
-    FProperty* Property = Object->GetClass()->FindPropertyByName(*PropertyName);
-    if (!Property)
+    FScopedPropertyCache* Cache = GActivePropertyCache;
+    if (!Cache)
     {
-        OutErrorMessage = FString::Printf(TEXT("Property not found: %s"), *PropertyName);
-        return false;
+        FPropertyAccessor Accessor;
+        return ResolvePropertyAccessor(Object->GetClass(), PropertyName, Accessor, OutErrorMessage)
+            && ApplyPropertyAccessor(Object, Accessor, PropertyName, Value, OutErrorMessage);
     }
 
-    void* PropertyAddr = Property->ContainerPtrToValuePtr<void>(Object);
-    
-    // Handle different property types
-    if (Property->IsA<FBoolProperty>())
+    const TPair<const UClass*, FString> Key(Object->GetClass(), PropertyName);
+    FScopedPropertyCache::FEntry* Entry = Cache->Entries.Find(Key);
+    if (!Entry)
     {
-        ((FBoolProperty*)Property)->SetPropertyValue(PropertyAddr, Value->AsBool());
-        return true;
+        Entry = &Cache->Entries.Add(Key);
+        ResolvePropertyAccessor(Object->GetClass(), PropertyName, Entry->Accessor, Entry->Error);
     }
-    else if (Property->IsA<FIntProperty>())
+    if (!Entry->Accessor.Leaf)
     {
-        int32 IntValue = static_cast<int32>(Value->AsNumber());
-        FIntProperty* IntProperty = CastField<FIntProperty>(Property);
-        if (IntProperty)
+        OutErrorMessage = Entry->Error;
+        return false;
+    }
+    return ApplyPropertyAccessor(Object, Entry->Accessor, PropertyName, Value, OutErrorMessage);
+}
+
+bool FUnrealCompanionCommonUtils::ResolvePropertyAccessor(const UClass* Class, const FString& PropertyPath,
+                                                          FPropertyAccessor& OutAccessor, FString& OutErrorMessage)
+{
+    using EKind = FPropertyAccessor::EKind;
+    OutAccessor = FPropertyAccessor();
+
+    // Plain names skip the split; only "Outer.Inner" paths walk into structs
+    const UStruct* Scope = Class;
+    FProperty* Property = nullptr;
+    int32 Start = 0;
+    while (Scope)
+    {
+        int32 Dot = PropertyPath.Find(TEXT("."), ESearchCase::CaseSensitive, ESearchDir::FromStart, Start);
+        const FString Segment = Dot == INDEX_NONE ? PropertyPath.Mid(Start) : PropertyPath.Mid(Start, Dot - Start);
+        Property = Scope->FindPropertyByName(*Segment);
+        if (!Property)
         {
-            IntProperty->SetPropertyValue_InContainer(Object, IntValue);
-            return true;
+            OutErrorMessage = FString::Printf(TEXT("Property not found: %s"), *PropertyPath);
+            return false;
+        }
+        if (Dot == INDEX_NONE)
+        {
+            break;
+        }
+
+        FStructProperty* StructProp = CastField<FStructProperty>(Property);
+        if (!StructProp)
+        {
+            OutErrorMessage = FString::Printf(TEXT("Property %s in %s is not a struct"), *Segment, *PropertyPath);
+            return false;
         }
+        OutAccessor.Path.Add(StructProp);
+        Scope = StructProp->Struct;
+        Start = Dot + 1;
     }
-    else if (Property->IsA<FFloatProperty>())
+    if (!Property)
     {
-        ((FFloatProperty*)Property)->SetPropertyValue(PropertyAddr, Value->AsNumber());
-        return true;
+        OutErrorMessage = FString::Printf(TEXT("Property not found: %s"), *PropertyPath);
+        return false;
     }
-    else if (Property->IsA<FDoubleProperty>())
+
+    OutAccessor.Leaf = Property;
+    if (Property->IsA<FBoolProperty>()) OutAccessor.Kind = EKind::Bool;
+    else if (Property->IsA<FIntProperty>()) OutAccessor.Kind = EKind::Int;
+    else if (Property->IsA<FFloatProperty>()) OutAccessor.Kind = EKind::Float;
+    else if (Property->IsA<FDoubleProperty>()) OutAccessor.Kind = EKind::Double;
+    else if (Property->IsA<FStrProperty>()) OutAccessor.Kind = EKind::Str;
+    else if (Property->IsA<FByteProperty>()) OutAccessor.Kind = EKind::Byte;
+    else if (Property->IsA<FEnumProperty>()) OutAccessor.Kind = EKind::Enum;
+    else if (Property->IsA<FObjectProperty>()) OutAccessor.Kind = EKind::Object;
+    else if (Property->IsA<FSoftObjectProperty>()) OutAccessor.Kind = EKind::SoftObject;
+    else if (Property->IsA<FStructProperty>()) OutAccessor.Kind = EKind::Struct;
+    return true;
+}
+
+bool FUnrealCompanionCommonUtils::ApplyPropertyAccessor(UObject* Object, const FPropertyAccessor& Accessor, const FString& PropertyName,
+                                                        const TSharedPtr<FJsonValue>& Value, FString& OutErrorMessage)
+{
+    using EKind = FPropertyAccessor::EKind;
+    FProperty* Property = Accessor.Leaf;
+    if (!Object || !Property || !Value.IsValid())
     {
-        ((FDoubleProperty*)Property)->SetPropertyValue(PropertyAddr, Value->AsNumber());
-        return true;
+        OutErrorMessage = TEXT("Invalid object");
+        return false;
     }
-    else if (Property->IsA<FStrProperty>())
+
+    // Structs are stored inline, so the walk is pointer arithmetic on the object
+    void* Container = Object;
+    for (FStructProperty* StructProp : Accessor.Path)
     {
-        ((FStrProperty*)Property)->SetPropertyValue(PropertyAddr, Value->AsString());
-        return true;
+        Container = StructProp->ContainerPtrToValuePtr<void>(Container);
     }
-    else if (Property->IsA<FByteProperty>())
+    void* PropertyAddr = Property->ContainerPtrToValuePtr<void>(Container);
+    
+    // Type was dispatched once at resolve time
+    switch (Accessor.Kind)
+    {
+    case EKind::Bool:
+        static_cast<FBoolProperty*>(Property)->SetPropertyValue(PropertyAddr, Value->AsBool());
+        return true;
+    case EKind::Int:
+        static_cast<FIntProperty*>(Property)->SetPropertyValue(PropertyAddr, static_cast<int32>(Value->AsNumber()));
+        return true;
+    case EKind::Float:
+        static_cast<FFloatProperty*>(Property)->SetPropertyValue(PropertyAddr, Value->AsNumber());
+        return true;
+    case EKind::Double:
+        static_cast<FDoubleProperty*>(Property)->SetPropertyValue(PropertyAddr, Value->AsNumber());
+        return true;
+    case EKind::Str:
+        static_cast<FStrProperty*>(Property)->SetPropertyValue(PropertyAddr, Value->AsString());
+        return true;
+    case EKind::Byte:
     {
-        FByteProperty* ByteProp = CastField<FByteProperty>(Property);
+        FByteProperty* ByteProp = static_cast<FByteProperty*>(Property);
         UEnum* EnumDef = ByteProp ? ByteProp->GetIntPropertyEnum() : nullptr;
         
         // If this is a TEnumAsByte property (has associated enum)
@@ -1066,10 +1270,11 @@ bool FUnrealCompanionCommonUtils::SetObjectProperty(UObject* Object, const FStri
             ByteProp->SetPropertyValue(PropertyAddr, ByteValue);
             return true;
         }
+        break;
     }
-    else if (Property->IsA<FEnumProperty>())
+    case EKind::Enum:
     {
-        FEnumProperty* EnumProp = CastField<FEnumProperty>(Property);
+        FEnumProperty* EnumProp = static_cast<FEnumProperty*>(Property);
         UEnum* EnumDef = EnumProp ? EnumProp->GetEnum() : nullptr;
         FNumericProperty* UnderlyingNumericProp = EnumProp ? EnumProp->GetUnderlyingProperty() : nullptr;
         
@@ -1137,10 +1342,12 @@ bool FUnrealCompanionCommonUtils::SetObjectProperty(UObject* Object, const FStri
                 }
             }
         }
+        break;
     }
     // Handle Object References (Actor references by name)
-    else if (FObjectProperty* ObjectProp = CastField<FObjectProperty>(Property))
+    case EKind::Object:
     {
+        FObjectProperty* ObjectProp = static_cast<FObjectProperty*>(Property);
         if (Value->Type == EJson::String)
         {
             FString ActorName = Value->AsString();
@@ -1156,26 +1363,16 @@ bool FUnrealCompanionCommonUtils::SetObjectProperty(UObject* Object, const FStri
             UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
             if (World)
             {
-                AActor* FoundActor = nullptr;
-                
-                // Search through all actors
-                for (TActorIterator<AActor> It(World); It; ++It)
+                // Only accept an actor compatible with the property's expected class
+                UClass* ExpectedClass = ObjectProp->PropertyClass;
+                FUnrealCompanionActorIndex& ActorIndex = FUnrealCompanionActorIndex::Get();
+                AActor* FoundActor = ActorIndex.FindByName(World, ActorName, ExpectedClass);
+                if (!FoundActor)
                 {
-                    AActor* Actor = *It;
-                    if (Actor && (Actor->GetActorLabel() == ActorName || Actor->GetName() == ActorName))
+                    if (AActor* WrongTypeActor = ActorIndex.FindByName(World, ActorName))
                     {
-                        // Verify the actor is compatible with the property's expected class
-                        UClass* ExpectedClass = ObjectProp->PropertyClass;
-                        if (Actor->IsA(ExpectedClass))
-                        {
-                            FoundActor = Actor;
-                            break;
-                        }
-                        else
-                        {
-                            UE_LOG(LogTemp, Warning, TEXT("Actor '%s' found but is of type %s, expected %s"), 
-                                *ActorName, *Actor->GetClass()->GetName(), *ExpectedClass->GetName());
-                        }
+                        UE_LOG(LogTemp, Warning, TEXT("Actor '%s' found but is of type %s, expected %s"), 
+                            *ActorName, *WrongTypeActor->GetClass()->GetName(), *ExpectedClass->GetName());
                     }
                 }
                 
@@ -1210,16 +1407,45 @@ bool FUnrealCompanionCommonUtils::SetObjectProperty(UObject* Object, const FStri
         }
     }
     // Handle Soft Object References
-    else if (FSoftObjectProperty* SoftObjectProp = CastField<FSoftObjectProperty>(Property))
+    case EKind::SoftObject:
     {
         if (Value->Type == EJson::String)
         {
             FString AssetPath = Value->AsString();
             FSoftObjectPath SoftPath(AssetPath);
             FSoftObjectPtr SoftPtr = FSoftObjectPtr(SoftPath);
-            SoftObjectProp->SetPropertyValue(PropertyAddr, SoftPtr);
+            static_cast<FSoftObjectProperty*>(Property)->SetPropertyValue(PropertyAddr, SoftPtr);
+            return true;
+        }
+        break;
+    }
+    // Whole structs: [x, y, z] for vectors and rotators, otherwise a JSON object of fields
+    case EKind::Struct:
+    {
+        FStructProperty* StructProp = static_cast<FStructProperty*>(Property);
+        const TArray<TSharedPtr<FJsonValue>>* Components = nullptr;
+        if (Value->TryGetArray(Components) && Components->Num() == 3)
+        {
+            const FVector Vec((*Components)[0]->AsNumber(), (*Components)[1]->AsNumber(), (*Components)[2]->AsNumber());
+            if (StructProp->Struct == TBaseStructure<FVector>::Get())
+            {
+                *static_cast<FVector*>(PropertyAddr) = Vec;
+                return true;
+            }
+            if (StructProp->Struct == TBaseStructure<FRotator>::Get())
+            {
+                *static_cast<FRotator*>(PropertyAddr) = FRotator(Vec.X, Vec.Y, Vec.Z);
+                return true;
+            }
+        }
+        if (Value->Type == EJson::Object && FJsonObjectConverter::JsonValueToUProperty(Value, StructProp, PropertyAddr, 0, 0))
+        {
             return true;
         }
+        break;
+    }
+    default:
+        break;
     }
     
     OutErrorMessage = FString::Printf(TEXT("Unsupported property type: %s for property %s"), 
@@ -1233,7 +1459,7 @@ bool FUnrealCompanionCommonUtils::SetObjectProperty(UObject* Object, const FStri
 
 bool FUnrealCompanionCommonUtils::OpenAssetInEditor(UObject* Asset)
 {
-    if (!Asset || !GEditor)
+    if (!Asset || !GEditor || FUnrealCompanionEditorFocus::Get().IsHeadless())
     {
         return false;
     }
@@ -1249,7 +1475,7 @@ bool FUnrealCompanionCommonUtils::OpenAssetInEditor(UObject* Asset)
 
 bool FUnrealCompanionCommonUtils::OpenBlueprintAtGraph(UBlueprint* Blueprint, const FString& GraphName)
 {
-    if (!Blueprint || !GEditor)
+    if (!Blueprint || !GEditor || FUnrealCompanionEditorFocus::Get().IsHeadless())
     {
         return false;
     }
@@ -1347,7 +1573,7 @@ bool FUnrealCompanionCommonUtils::OpenBlueprintAtGraph(UBlueprint* Blueprint, co
 
 bool FUnrealCompanionCommonUtils::SyncContentBrowserToPath(const FString& AssetPath)
 {
-    if (!GEditor)
+    if (!GEditor || FUnrealCompanionEditorFocus::Get().IsHeadless())
     {
         return false;
     }
@@ -1364,7 +1590,7 @@ bool FUnrealCompanionCommonUtils::SyncContentBrowserToPath(const FString& AssetP
 
 bool FUnrealCompanionCommonUtils::FocusOnNode(UBlueprint* Blueprint, UEdGraphNode* Node)
 {
-    if (!Blueprint || !Node || !GEditor)
+    if (!Blueprint || !Node || !GEditor || FUnrealCompanionEditorFocus::Get().IsHeadless())
     {
         return false;
     }
@@ -0,0 +1,369 @@
+#include "Commands/UnrealCompanionCompileSession.h"
+#include "UnrealCompanionStats.h"
+#include "Graph/GraphOperations.h"
+#include "Engine/Blueprint.h"
+#include "Materials/Material.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "BlueprintCompilationManager.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "Logging/TokenizedMessage.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+#include "Algo/StableSort.h"
+
+namespace
+{
+    /** Number of Blueprint ancestors: compiling low depths first lets children compile once */
+    int32 GetBlueprintDepth(const UBlueprint* Blueprint)
+    {
+        int32 Depth = 0;
+        for (const UClass* Class = Blueprint ? Blueprint->ParentClass.Get() : nullptr; Class; Class = Class->GetSuperClass())
+        {
+            if (UBlueprint::GetBlueprintFromClass(Class))
+            {
+                ++Depth;
+            }
+        }
+        return Depth;
+    }
+
+    /** Compiler messages left on the nodes of every graph of Blueprint */
+    void CollectNodeMessages(UBlueprint* Blueprint, TArray<TSharedPtr<FJsonValue>>& OutErrors, TArray<TSharedPtr<FJsonValue>>& OutWarnings)
+    {
+        TArray<UEdGraph*> Graphs;
+        Blueprint->GetAllGraphs(Graphs);
+        for (const UEdGraph* Graph : Graphs)
+        {
+            if (!Graph)
+            {
+                continue;
+            }
+            for (const UEdGraphNode* Node : Graph->Nodes)
+            {
+                if (!Node || !Node->bHasCompilerMessage)
+                {
+                    continue;
+                }
+                const FString Message = FString::Printf(TEXT("%s (%s): %s"),
+                    *Node->GetNodeTitle(ENodeTitleType::ListView).ToString(), *Graph->GetName(), *Node->ErrorMsg);
+                if (Node->ErrorType <= EMessageSeverity::Error)
+                {
+                    OutErrors.Add(MakeShared<FJsonValueString>(Message));
+                }
+                else if (Node->ErrorType <= EMessageSeverity::Warning)
+                {
+                    OutWarnings.Add(MakeShared<FJsonValueString>(Message));
+                }
+            }
+        }
+    }
+
+    FString StatusToString(EBlueprintStatus Status)
+    {
+        switch (Status)
+        {
+            case BS_Dirty: return TEXT("Dirty");
+            case BS_Error: return TEXT("Error");
+            case BS_UpToDate: return TEXT("UpToDate");
+            case BS_BeingCreated: return TEXT("BeingCreated");
+            case BS_UpToDateWithWarnings: return TEXT("UpToDateWithWarnings");
+            default: return TEXT("Unknown");
+        }
+    }
+}
+
+FUnrealCompanionCompileSession& FUnrealCompanionCompileSession::Get()
+{
+    static FUnrealCompanionCompileSession Instance;
+    return Instance;
+}
+
+bool FUnrealCompanionCompileSession::Begin(const FString& Label)
+{
+    check(IsInGameThread());
+    if (bActive)
+    {
+        return false;
+    }
+
+    bActive = true;
+    SessionLabel = Label;
+    StartTime = FPlatformTime::Seconds();
+    DeferredRequests = 0;
+    Pending.Reset();
+    PendingMaterials.Reset();
+
+    UE_LOG(LogTemp, Display, TEXT("UnrealCompanion: Compile session '%s' started"), *SessionLabel);
+    return true;
+}
+
+bool FUnrealCompanionCompileSession::DeferCompile(UBlueprint* Blueprint)
+{
+    check(IsInGameThread());
+    if (!bActive || !Blueprint)
+    {
+        return false;
+    }
+
+    // The edit already dirtied the Blueprint; make sure the editor shows it as needing a compile
+    if (Blueprint->Status != BS_Dirty)
+    {
+        Blueprint->Status = BS_Dirty;
+    }
+    Pending.AddUnique(Blueprint);
+    ++DeferredRequests;
+    return true;
+}
+
+bool FUnrealCompanionCompileSession::DeferCompile(UMaterial* Material)
+{
+    check(IsInGameThread());
+    if (!bActive || !Material)
+    {
+        return false;
+    }
+
+    PendingMaterials.AddUnique(Material);
+    ++DeferredRequests;
+    return true;
+}
+
+void FUnrealCompanionCompileSession::NotifyCompiled(UBlueprint* Blueprint)
+{
+    if (bActive)
+    {
+        Pending.Remove(Blueprint);
+    }
+}
+
+void FUnrealCompanionCompileSession::NotifyCompiled(UMaterial* Material)
+{
+    if (bActive)
+    {
+        PendingMaterials.Remove(Material);
+    }
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionCompileSession::CompileWithMessages(UBlueprint* Blueprint)
+{
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    if (!Blueprint)
+    {
+        return Result;
+    }
+
+    FCompilerResultsLog Results;
+    Results.bSilentMode = true;
+    {
+        UNREALCOMPANION_SCOPE_CYCLE_COUNTER(STAT_UnrealCompanion_Compile);
+        FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::None, &Results);
+    }
+
+    TArray<TSharedPtr<FJsonValue>> Errors;
+    TArray<TSharedPtr<FJsonValue>> Warnings;
+    for (const TSharedRef<FTokenizedMessage>& Message : Results.Messages)
+    {
+        const EMessageSeverity::Type Severity = Message->GetSeverity();
+        if (Severity == EMessageSeverity::Error)
+        {
+            Errors.Add(MakeShared<FJsonValueString>(Message->ToText().ToString()));
+        }
+        else if (Severity == EMessageSeverity::Warning || Severity == EMessageSeverity::PerformanceWarning)
+        {
+            Warnings.Add(MakeShared<FJsonValueString>(Message->ToText().ToString()));
+        }
+    }
+
+    Result->SetStringField(TEXT("blueprint"), Blueprint->GetPathName());
+    Result->SetStringField(TEXT("status"), StatusToString(Blueprint->Status));
+    Result->SetBoolField(TEXT("success"), Blueprint->Status != BS_Error);
+    Result->SetArrayField(TEXT("errors"), Errors);
+    Result->SetArrayField(TEXT("warnings"), Warnings);
+    return Result;
+}
+
+TArray<TSharedPtr<FJsonValue>> FUnrealCompanionCompileSession::CompileBatch(const TArray<UBlueprint*>& Blueprints, int32& OutFailed)
+{
+    check(IsInGameThread());
+    OutFailed = 0;
+
+    TArray<UBlueprint*> Unique;
+    for (UBlueprint* Blueprint : Blueprints)
+    {
+        if (Blueprint)
+        {
+            Unique.AddUnique(Blueprint);
+        }
+    }
+
+    // Queue everything, then one flush: the manager sorts by hierarchy and reinstances once
+    for (UBlueprint* Blueprint : Unique)
+    {
+        FBlueprintCompilationManager::QueueForCompilation(Blueprint);
+    }
+    {
+        UNREALCOMPANION_SCOPE_CYCLE_COUNTER(STAT_UnrealCompanion_Compile);
+        FBlueprintCompilationManager::FlushCompilationQueueAndReinstance();
+    }
+
+    TArray<TSharedPtr<FJsonValue>> Results;
+    for (UBlueprint* Blueprint : Unique)
+    {
+        Get().NotifyCompiled(Blueprint);
+
+        TArray<TSharedPtr<FJsonValue>> Errors;
+        TArray<TSharedPtr<FJsonValue>> Warnings;
+        CollectNodeMessages(Blueprint, Errors, Warnings);
+
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetStringField(TEXT("blueprint"), Blueprint->GetPathName());
+        Result->SetStringField(TEXT("status"), StatusToString(Blueprint->Status));
+        Result->SetBoolField(TEXT("success"), Blueprint->Status != BS_Error);
+        Result->SetArrayField(TEXT("errors"), Errors);
+        Result->SetArrayField(TEXT("warnings"), Warnings);
+        if (Blueprint->Status == BS_Error)
+        {
+            ++OutFailed;
+        }
+        Results.Add(MakeShared<FJsonValueObject>(Result));
+    }
+    return Results;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionCompileSession::Commit()
+{
+    check(IsInGameThread());
+    TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+    if (!bActive)
+    {
+        Response->SetBoolField(TEXT("success"), false);
+        Response->SetStringField(TEXT("error"), TEXT("No compile session is active"));
+        return Response;
+    }
+
+    TArray<UBlueprint*> ToCompile;
+    for (const TWeakObjectPtr<UBlueprint>& Weak : Pending)
+    {
+        if (UBlueprint* Blueprint = Weak.Get())
+        {
+            ToCompile.Add(Blueprint);
+        }
+    }
+    Algo::StableSortBy(ToCompile, &GetBlueprintDepth);
+
+    const double CompileStart = FPlatformTime::Seconds();
+    int32 Compiled = 0;
+    int32 Failed = 0;
+    TArray<TSharedPtr<FJsonValue>> Results;
+    for (UBlueprint* Blueprint : ToCompile)
+    {
+        // A parent's compile may already have brought dependent children up to date
+        TSharedPtr<FJsonObject> Result;
+        if (Blueprint->Status == BS_UpToDate || Blueprint->Status == BS_UpToDateWithWarnings)
+        {
+            Result = MakeShared<FJsonObject>();
+            Result->SetStringField(TEXT("blueprint"), Blueprint->GetPathName());
+            Result->SetStringField(TEXT("status"), StatusToString(Blueprint->Status));
+            Result->SetBoolField(TEXT("success"), true);
+            Result->SetBoolField(TEXT("compiled_with_parent"), true);
+        }
+        else
+        {
+            Result = CompileWithMessages(Blueprint);
+            ++Compiled;
+        }
+
+        if (!Result->GetBoolField(TEXT("success")))
+        {
+            ++Failed;
+        }
+        Results.Add(MakeShared<FJsonValueObject>(Result));
+    }
+
+    // Copied first: each compile removes its Material from PendingMaterials
+    const TArray<TWeakObjectPtr<UMaterial>> MaterialsToCompile = PendingMaterials;
+    for (const TWeakObjectPtr<UMaterial>& Weak : MaterialsToCompile)
+    {
+        UMaterial* Material = Weak.Get();
+        if (!Material)
+        {
+            continue;
+        }
+
+        UnrealCompanionGraph::CompileIfNeeded(Material, true);
+        ++Compiled;
+
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetStringField(TEXT("material"), Material->GetPathName());
+        Result->SetBoolField(TEXT("success"), true);
+        Results.Add(MakeShared<FJsonValueObject>(Result));
+    }
+
+    Response->SetBoolField(TEXT("success"), Failed == 0);
+    Response->SetStringField(TEXT("session"), SessionLabel);
+    Response->SetNumberField(TEXT("deferred_requests"), DeferredRequests);
+    Response->SetNumberField(TEXT("compiled"), Compiled);
+    Response->SetNumberField(TEXT("failed"), Failed);
+    Response->SetNumberField(TEXT("compile_ms"), (FPlatformTime::Seconds() - CompileStart) * 1000.0);
+    Response->SetArrayField(TEXT("results"), Results);
+
+    UE_LOG(LogTemp, Display, TEXT("UnrealCompanion: Compile session '%s' committed: %d requests -> %d compiles (%d failed)"),
+        *SessionLabel, DeferredRequests, Compiled, Failed);
+
+    bActive = false;
+    Pending.Reset();
+    PendingMaterials.Reset();
+    return Response;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionCompileSession::Abort()
+{
+    check(IsInGameThread());
+    TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+    Response->SetBoolField(TEXT("success"), bActive);
+    if (!bActive)
+    {
+        Response->SetStringField(TEXT("error"), TEXT("No compile session is active"));
+        return Response;
+    }
+
+    Response->SetStringField(TEXT("session"), SessionLabel);
+    Response->SetNumberField(TEXT("left_dirty"), Pending.Num() + PendingMaterials.Num());
+    bActive = false;
+    Pending.Reset();
+    PendingMaterials.Reset();
+    return Response;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionCompileSession::GetStatus() const
+{
+    TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+    Response->SetBoolField(TEXT("success"), true);
+    Response->SetBoolField(TEXT("active"), bActive);
+    if (bActive)
+    {
+        TArray<TSharedPtr<FJsonValue>> PendingArray;
+        for (const TWeakObjectPtr<UBlueprint>& Weak : Pending)
+        {
+            if (const UBlueprint* Blueprint = Weak.Get())
+            {
+                PendingArray.Add(MakeShared<FJsonValueString>(Blueprint->GetPathName()));
+            }
+        }
+        for (const TWeakObjectPtr<UMaterial>& Weak : PendingMaterials)
+        {
+            if (const UMaterial* Material = Weak.Get())
+            {
+                PendingArray.Add(MakeShared<FJsonValueString>(Material->GetPathName()));
+            }
+        }
+        Response->SetStringField(TEXT("session"), SessionLabel);
+        Response->SetNumberField(TEXT("elapsed_seconds"), FPlatformTime::Seconds() - StartTime);
+        Response->SetNumberField(TEXT("deferred_requests"), DeferredRequests);
+        Response->SetArrayField(TEXT("pending"), PendingArray);
+    }
+    return Response;
+}
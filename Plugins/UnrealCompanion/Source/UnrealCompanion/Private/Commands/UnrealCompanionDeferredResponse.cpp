@@ -0,0 +1,33 @@
+#include "Commands/UnrealCompanionDeferredResponse.h"
+
+thread_local FUnrealCompanionDeferredResponse::FScope* FUnrealCompanionDeferredResponse::CurrentScope = nullptr;
+
+FUnrealCompanionDeferredResponse::FScope::FScope(FCompletion InCompletion, FEventSink InEventSink)
+    : Completion(MoveTemp(InCompletion))
+    , EventSink(MoveTemp(InEventSink))
+    , Previous(CurrentScope)
+{
+    CurrentScope = this;
+}
+
+FUnrealCompanionDeferredResponse::FScope::~FScope()
+{
+    CurrentScope = Previous;
+}
+
+bool FUnrealCompanionDeferredResponse::CanDefer()
+{
+    return CurrentScope && !CurrentScope->bDeferred && CurrentScope->Completion;
+}
+
+FUnrealCompanionDeferredResponse::FCompletion FUnrealCompanionDeferredResponse::Defer()
+{
+    check(CanDefer());
+    CurrentScope->bDeferred = true;
+    return MoveTemp(CurrentScope->Completion);
+}
+
+FUnrealCompanionDeferredResponse::FEventSink FUnrealCompanionDeferredResponse::GetEventSink()
+{
+    return CurrentScope ? CurrentScope->EventSink : FEventSink();
+}
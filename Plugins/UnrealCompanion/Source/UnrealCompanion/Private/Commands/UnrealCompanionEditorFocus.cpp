@@ -1,6 +1,10 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Commands/UnrealCompanionEditorFocus.h"
+#include "Commands/UnrealCompanionPackageSaver.h"
+#include "UnrealCompanionSettings.h"
+#include "Misc/App.h"
+#include "Framework/Application/SlateApplication.h"
 
 #include "Editor.h"
 #include "Engine/Blueprint.h"
@@ -23,6 +27,41 @@ FUnrealCompanionEditorFocus& FUnrealCompanionEditorFocus::Get()
     return Instance;
 }
 
+FUnrealCompanionEditorFocus::FUnrealCompanionEditorFocus()
+{
+    switch (GetDefault<UUnrealCompanionSettings>()->FocusMode)
+    {
+        case EUnrealCompanionFocusMode::Interactive:
+            bHeadless = false;
+            break;
+        case EUnrealCompanionFocusMode::Headless:
+            bHeadless = true;
+            break;
+        default:
+            bHeadless = FApp::IsUnattended() || IsRunningCommandlet() || !FSlateApplication::IsInitialized();
+            break;
+    }
+    if (bHeadless)
+    {
+        UE_LOG(LogMCPEditorFocus, Display, TEXT("Headless editor focus: no editor UI, saves deferred to core_save"));
+    }
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionEditorFocus::FlushDeferredSaves()
+{
+    TArray<UPackage*> Packages;
+    for (const TWeakObjectPtr<UPackage>& Weak : DeferredSaves)
+    {
+        UPackage* Package = Weak.Get();
+        if (Package && Package->IsDirty())
+        {
+            Packages.Add(Package);
+        }
+    }
+    DeferredSaves.Reset();
+    return FUnrealCompanionPackageSaver::Get().Save(Packages);
+}
+
 bool FUnrealCompanionEditorFocus::BeginFocus(UObject* Asset, const FString& GraphName)
 {
     if (!bEnabled || !Asset || !GEditor)
@@ -35,7 +74,7 @@ bool FUnrealCompanionEditorFocus::BeginFocus(UObject* Asset, const FString& Grap
     {
         // Same asset, just navigate if needed
         UBlueprint* BP = Cast<UBlueprint>(Asset);
-        if (BP && !GraphName.IsEmpty())
+        if (BP && !GraphName.IsEmpty() && !bHeadless)
         {
             NavigateToGraph(BP, GraphName);
         }
@@ -52,8 +91,8 @@ bool FUnrealCompanionEditorFocus::BeginFocus(UObject* Asset, const FString& Grap
     bHasError = false;
     ErrorMessage.Empty();
 
-    // Open the new asset
-    bool bSuccess = OpenAssetEditor(Asset, GraphName);
+    // Open the new asset (headless: track it only)
+    bool bSuccess = bHeadless || OpenAssetEditor(Asset, GraphName);
     
     if (bSuccess)
     {
@@ -78,7 +117,7 @@ bool FUnrealCompanionEditorFocus::BeginFocusBlueprint(UBlueprint* Blueprint, UEd
     {
         CurrentGraph = Graph;
         
-        if (Node)
+        if (Node && !bHeadless)
         {
             NavigateToNode(Blueprint, Node);
             CurrentNode = Node;
@@ -117,16 +156,27 @@ void FUnrealCompanionEditorFocus::EndFocus(bool bForceKeepOpen)
         return;
     }
 
-    // Save if enabled
-    if (bAutoSave)
+    if (bHeadless)
     {
-        SaveCurrentAsset();
+        // Nothing was opened; the save waits for an explicit flush
+        if (bAutoSave)
+        {
+            DeferredSaves.AddUnique(CurrentAsset->GetOutermost());
+        }
     }
-
-    // Close if enabled
-    if (bAutoClose)
+    else
     {
-        CloseCurrentAsset();
+        // Save if enabled
+        if (bAutoSave)
+        {
+            SaveCurrentAsset();
+        }
+
+        // Close if enabled
+        if (bAutoClose)
+        {
+            CloseCurrentAsset();
+        }
     }
 
     // Clear state
@@ -149,6 +199,10 @@ void FUnrealCompanionEditorFocus::FocusLevelEditor()
     {
         EndFocus(false);
     }
+    if (bHeadless)
+    {
+        return;
+    }
 
     // Focus the level editor
     FLevelEditorModule& LevelEditorModule = FModuleManager::GetModuleChecked<FLevelEditorModule>("LevelEditor");
@@ -164,7 +218,7 @@ void FUnrealCompanionEditorFocus::FocusLevelEditor()
 
 void FUnrealCompanionEditorFocus::SyncContentBrowser(const FString& FolderPath)
 {
-    if (!GEditor)
+    if (!GEditor || bHeadless)
     {
         return;
     }
@@ -187,23 +241,54 @@ bool FUnrealCompanionEditorFocus::SaveCurrentAsset()
     }
 
     UPackage* Package = CurrentAsset->GetOutermost();
-    if (Package && Package->IsDirty())
+    if (Package && Package->IsDirty() && GEditor->IsTransactionActive())
     {
-        FString PackageFilename;
-        if (FPackageName::TryConvertLongPackageNameToFilename(Package->GetName(), PackageFilename, FPackageName::GetAssetPackageExtension()))
+        // Saves refuse to run inside a transaction: wait for the command's to close
+        PendingSaves.AddUnique(Package);
+        if (!PendingSaveTicker.IsValid())
         {
-            FSavePackageArgs SaveArgs;
-            SaveArgs.TopLevelFlags = RF_Standalone;
-            bool bSaved = UPackage::SavePackage(Package, nullptr, *PackageFilename, SaveArgs);
-            
-            if (bSaved)
-            {
-                UE_LOG(LogMCPEditorFocus, Display, TEXT("Saved asset: %s"), *CurrentAsset->GetName());
-                return true;
-            }
+            PendingSaveTicker = FTSTicker::GetCoreTicker().AddTicker(
+                FTickerDelegate::CreateRaw(this, &FUnrealCompanionEditorFocus::SavePendingPackages));
         }
+        return false;
     }
+    if (Package && Package->IsDirty() && !FUnrealCompanionPackageSaver::Get().IsSaving())
+    {
+        TSharedPtr<FJsonObject> Result = FUnrealCompanionPackageSaver::Get().SaveNow({ Package });
+        if (Result->GetBoolField(TEXT("success")) && Result->GetNumberField(TEXT("saved")) > 0)
+        {
+            UE_LOG(LogMCPEditorFocus, Display, TEXT("Saved asset: %s"), *CurrentAsset->GetName());
+            return true;
+        }
+    }
+
+    return false;
+}
 
+bool FUnrealCompanionEditorFocus::SavePendingPackages(float DeltaTime)
+{
+    if ((GEditor && GEditor->IsTransactionActive()) || FUnrealCompanionPackageSaver::Get().IsSaving())
+    {
+        return true;
+    }
+
+    TArray<UPackage*> Packages;
+    for (const TWeakObjectPtr<UPackage>& Weak : PendingSaves)
+    {
+        UPackage* Package = Weak.Get();
+        if (Package && Package->IsDirty())
+        {
+            Packages.Add(Package);
+        }
+    }
+    PendingSaves.Reset();
+    PendingSaveTicker.Reset();
+
+    if (Packages.Num() > 0)
+    {
+        FUnrealCompanionPackageSaver::Get().SaveNow(Packages);
+        UE_LOG(LogMCPEditorFocus, Display, TEXT("Saved %d asset(s) after the command's transaction"), Packages.Num());
+    }
     return false;
 }
 
@@ -10,18 +10,27 @@
 #include "Components/SkyAtmosphereComponent.h"
 #include "Components/SkyLightComponent.h"
 #include "Engine/SkyLight.h"
+#include "HAL/PlatformTime.h"
 
 FUnrealCompanionEnvironmentCommands::FUnrealCompanionEnvironmentCommands()
 {
 }
 
+TConstArrayView<TMCPCommandEntry<FUnrealCompanionEnvironmentCommands>> FUnrealCompanionEnvironmentCommands::GetCommandTable()
+{
+    static constexpr TMCPCommandEntry<FUnrealCompanionEnvironmentCommands> Table[] = {
+        { TEXT("environment_configure"), &FUnrealCompanionEnvironmentCommands::HandleConfigure },
+    };
+    static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+    return Table;
+}
+
 TSharedPtr<FJsonObject> FUnrealCompanionEnvironmentCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-    if (CommandType == TEXT("environment_configure"))
+    if (TSharedPtr<FJsonObject> Result = UnrealCompanionCommandTable::Dispatch(*this, GetCommandTable(), CommandType, Params))
     {
-        return HandleConfigure(Params);
+        return Result;
     }
-
     return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown environment command: %s"), *CommandType));
 }
 
@@ -35,7 +44,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionEnvironmentCommands::HandleConfigure(con
     if (!Params->TryGetStringField(TEXT("action"), Action))
     {
         return FUnrealCompanionCommonUtils::CreateErrorResponse(
-            TEXT("Missing 'action' parameter. Valid: set_time_of_day, set_fog, setup_atmosphere, get_info"));
+            TEXT("Missing 'action' parameter. Valid: set_time_of_day, set_fog, apply, setup_atmosphere, get_info"));
     }
     Action = Action.ToLower();
 
@@ -47,6 +56,10 @@ TSharedPtr<FJsonObject> FUnrealCompanionEnvironmentCommands::HandleConfigure(con
     {
         return HandleSetFog(Params);
     }
+    else if (Action == TEXT("apply"))
+    {
+        return HandleApply(Params);
+    }
     else if (Action == TEXT("setup_atmosphere"))
     {
         return HandleSetupAtmosphere(Params);
@@ -57,114 +70,257 @@ TSharedPtr<FJsonObject> FUnrealCompanionEnvironmentCommands::HandleConfigure(con
     }
 
     return FUnrealCompanionCommonUtils::CreateErrorResponse(
-        FString::Printf(TEXT("Unknown action: %s. Valid: set_time_of_day, set_fog, setup_atmosphere, get_info"), *Action));
+        FString::Printf(TEXT("Unknown action: %s. Valid: set_time_of_day, set_fog, apply, setup_atmosphere, get_info"), *Action));
 }
 
 // =============================================================================
-// SET TIME OF DAY (via directional light rotation)
+// ENVIRONMENT ACTORS
 // =============================================================================
 
-TSharedPtr<FJsonObject> FUnrealCompanionEnvironmentCommands::HandleSetTimeOfDay(const TSharedPtr<FJsonObject>& Params)
+FUnrealCompanionEnvironmentCommands::FEnvironmentActors FUnrealCompanionEnvironmentCommands::ResolveEnvironment(UWorld* World)
 {
-    UWorld* World = GEditor->GetEditorWorldContext().World();
-    if (!World)
+    auto IsCurrent = [World](const AActor* Actor)
     {
-        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
-    }
+        return IsValid(Actor) && Actor->GetWorld() == World;
+    };
 
-    // Parse time (0-24 hours)
-    float TimeOfDay = 12.0f;
-    if (Params->HasField(TEXT("time")))
+    FEnvironmentActors Actors;
+    if (CachedWorld.Get() == World)
     {
-        TimeOfDay = FMath::Clamp((float)Params->GetNumberField(TEXT("time")), 0.0f, 24.0f);
+        Actors.Sun = CachedSun.Get();
+        Actors.Fog = CachedFog.Get();
+        Actors.SkyLight = CachedSkyLight.Get();
+        Actors.Atmosphere = CachedAtmosphere.Get();
     }
 
-    // Optional sun intensity
-    float SunIntensity = -1.0f; // -1 means don't change
-    if (Params->HasField(TEXT("sun_intensity")))
+    const bool bAllCurrent = IsCurrent(Actors.Sun) && IsCurrent(Actors.Fog) && IsCurrent(Actors.SkyLight)
+        && IsValid(Actors.Atmosphere) && IsCurrent(Actors.Atmosphere->GetOwner());
+    if (bAllCurrent)
     {
-        SunIntensity = Params->GetNumberField(TEXT("sun_intensity"));
+        return Actors;
     }
 
-    // Optional sun color
-    bool bHasSunColor = false;
-    FLinearColor SunColor = FLinearColor::White;
-    if (Params->HasField(TEXT("sun_color")))
+    // One pass for all four; the first of each wins, as with one iterator per class
+    Actors = FEnvironmentActors();
+    for (TActorIterator<AActor> It(World); It; ++It)
     {
-        const TArray<TSharedPtr<FJsonValue>>* ColorArray;
-        if (Params->TryGetArrayField(TEXT("sun_color"), ColorArray) && ColorArray->Num() >= 3)
+        AActor* Actor = *It;
+        if (!Actors.Sun && Actor->IsA<ADirectionalLight>())
         {
-            SunColor.R = (*ColorArray)[0]->AsNumber();
-            SunColor.G = (*ColorArray)[1]->AsNumber();
-            SunColor.B = (*ColorArray)[2]->AsNumber();
-            SunColor.A = ColorArray->Num() >= 4 ? (*ColorArray)[3]->AsNumber() : 1.0f;
-            bHasSunColor = true;
+            Actors.Sun = CastChecked<ADirectionalLight>(Actor);
+        }
+        else if (!Actors.Fog && Actor->IsA<AExponentialHeightFog>())
+        {
+            Actors.Fog = CastChecked<AExponentialHeightFog>(Actor);
+        }
+        else if (!Actors.SkyLight && Actor->IsA<ASkyLight>())
+        {
+            Actors.SkyLight = CastChecked<ASkyLight>(Actor);
         }
-    }
 
-    // Find or create the directional light (sun)
-    ADirectionalLight* SunLight = nullptr;
-    for (TActorIterator<ADirectionalLight> It(World); It; ++It)
-    {
-        SunLight = *It;
-        break;
-    }
+        if (!Actors.Atmosphere)
+        {
+            Actors.Atmosphere = Actor->FindComponentByClass<USkyAtmosphereComponent>();
+        }
 
-    if (!SunLight)
-    {
-        // Spawn a new directional light
-        SunLight = World->SpawnActor<ADirectionalLight>(
-            ADirectionalLight::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
-        if (SunLight)
+        if (Actors.Sun && Actors.Fog && Actors.SkyLight && Actors.Atmosphere)
         {
-            SunLight->SetActorLabel(TEXT("Sun"));
+            break;
         }
     }
 
-    if (!SunLight)
+    CachedWorld = World;
+    RememberEnvironment(Actors);
+    return Actors;
+}
+
+void FUnrealCompanionEnvironmentCommands::RememberEnvironment(const FEnvironmentActors& Actors)
+{
+    CachedSun = Actors.Sun;
+    CachedFog = Actors.Fog;
+    CachedSkyLight = Actors.SkyLight;
+    CachedAtmosphere = Actors.Atmosphere;
+}
+
+bool FUnrealCompanionEnvironmentCommands::ApplySun(ADirectionalLight* Sun, const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonObject>& OutResult)
+{
+    const bool bHasTime = Params->HasField(TEXT("time"));
+    // A negative intensity means "leave it", as set_time_of_day always treated it
+    const bool bHasIntensity = Params->HasField(TEXT("sun_intensity")) && Params->GetNumberField(TEXT("sun_intensity")) >= 0.0;
+    bool bHasColor = false;
+    FLinearColor SunColor = FLinearColor::White;
+    const TArray<TSharedPtr<FJsonValue>>* ColorArray;
+    if (Params->TryGetArrayField(TEXT("sun_color"), ColorArray) && ColorArray->Num() >= 3)
     {
-        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to find or create directional light"));
+        SunColor.R = (*ColorArray)[0]->AsNumber();
+        SunColor.G = (*ColorArray)[1]->AsNumber();
+        SunColor.B = (*ColorArray)[2]->AsNumber();
+        SunColor.A = ColorArray->Num() >= 4 ? (*ColorArray)[3]->AsNumber() : 1.0f;
+        bHasColor = true;
+    }
+    if (!Sun || (!bHasTime && !bHasIntensity && !bHasColor))
+    {
+        return false;
     }
 
-    // Convert time of day to sun rotation
-    // 6:00 = sunrise (pitch = 0), 12:00 = noon (pitch = -90), 18:00 = sunset (pitch = -180)
-    // 0:00/24:00 = midnight (pitch = 90)
-    float NormalizedTime = (TimeOfDay - 6.0f) / 24.0f; // 0 at 6am
-    float SunPitch = NormalizedTime * -360.0f;
+    if (bHasTime)
+    {
+        const float TimeOfDay = FMath::Clamp((float)Params->GetNumberField(TEXT("time")), 0.0f, 24.0f);
+
+        // Convert time of day to sun rotation
+        // 6:00 = sunrise (pitch = 0), 12:00 = noon (pitch = -90), 18:00 = sunset (pitch = -180)
+        // 0:00/24:00 = midnight (pitch = 90)
+        const float NormalizedTime = (TimeOfDay - 6.0f) / 24.0f; // 0 at 6am
+        const float SunPitch = NormalizedTime * -360.0f;
 
-    FRotator SunRotation(SunPitch, -45.0f, 0.0f); // Yaw for direction
-    SunLight->SetActorRotation(SunRotation);
+        // A transform update only: the light is not re-registered
+        Sun->Modify();
+        Sun->SetActorRotation(FRotator(SunPitch, -45.0f, 0.0f)); // Yaw for direction
+        OutResult->SetNumberField(TEXT("time_of_day"), TimeOfDay);
+        OutResult->SetNumberField(TEXT("sun_pitch"), SunPitch);
+    }
 
-    // Apply intensity if specified
-    UDirectionalLightComponent* LightComp = SunLight->GetComponent();
-    if (LightComp)
+    UDirectionalLightComponent* LightComp = Sun->GetComponent();
+    if (LightComp && (bHasIntensity || bHasColor))
     {
-        if (SunIntensity >= 0.0f)
+        LightComp->Modify();
+        if (bHasIntensity)
         {
-            LightComp->SetIntensity(SunIntensity);
+            LightComp->Intensity = Params->GetNumberField(TEXT("sun_intensity"));
         }
-        if (bHasSunColor)
+        if (bHasColor)
         {
-            LightComp->SetLightColor(SunColor);
+            LightComp->LightColor = SunColor.ToFColor(true);
         }
+        LightComp->MarkRenderStateDirty();
+        OutResult->SetNumberField(TEXT("sun_intensity"), LightComp->Intensity);
     }
+    return true;
+}
 
-    SunLight->PostEditChange();
+bool FUnrealCompanionEnvironmentCommands::ApplyFog(AExponentialHeightFog* Fog, const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonObject>& OutResult)
+{
+    UExponentialHeightFogComponent* FogComp = Fog ? Fog->GetComponent() : nullptr;
+    if (!FogComp)
+    {
+        return false;
+    }
 
-    // Update sky light to match
-    for (TActorIterator<ASkyLight> It(World); It; ++It)
+    static const TCHAR* const FogFields[] = {
+        TEXT("density"), TEXT("height_falloff"), TEXT("start_distance"), TEXT("color"), TEXT("enabled"), TEXT("volumetric")
+    };
+    bool bAny = false;
+    for (const TCHAR* Field : FogFields)
+    {
+        bAny |= Params->HasField(Field);
+    }
+    if (!bAny)
+    {
+        return false;
+    }
+
+    FogComp->Modify();
+
+    // Apply settings; the component is marked dirty once below
+    if (Params->HasField(TEXT("density")))
+    {
+        FogComp->FogDensity = FMath::Clamp((float)Params->GetNumberField(TEXT("density")), 0.0f, 1.0f);
+    }
+
+    if (Params->HasField(TEXT("height_falloff")))
+    {
+        FogComp->FogHeightFalloff = FMath::Max(0.001f, (float)Params->GetNumberField(TEXT("height_falloff")));
+    }
+
+    if (Params->HasField(TEXT("start_distance")))
+    {
+        FogComp->StartDistance = FMath::Max(0.0f, (float)Params->GetNumberField(TEXT("start_distance")));
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* ColorArray;
+    if (Params->TryGetArrayField(TEXT("color"), ColorArray) && ColorArray->Num() >= 3)
+    {
+        FogComp->FogInscatteringLuminance = FLinearColor(
+            (*ColorArray)[0]->AsNumber(), (*ColorArray)[1]->AsNumber(), (*ColorArray)[2]->AsNumber(), 1.0f);
+    }
+
+    if (Params->HasField(TEXT("volumetric")))
+    {
+        FogComp->bEnableVolumetricFog = Params->GetBoolField(TEXT("volumetric"));
+    }
+
+    if (Params->HasField(TEXT("enabled")))
+    {
+        // Visibility has its own setter; it only marks the same render state dirty
+        FogComp->SetVisibility(Params->GetBoolField(TEXT("enabled")));
+    }
+
+    FogComp->MarkRenderStateDirty();
+
+    OutResult->SetNumberField(TEXT("density"), FogComp->FogDensity);
+    OutResult->SetNumberField(TEXT("height_falloff"), FogComp->FogHeightFalloff);
+    return true;
+}
+
+bool FUnrealCompanionEnvironmentCommands::RecaptureSkyLight(ASkyLight* SkyLight)
+{
+    USkyLightComponent* SkyComp = SkyLight ? SkyLight->GetLightComponent() : nullptr;
+    if (!SkyComp || SkyComp->bRealTimeCapture)
+    {
+        // Real-time capture follows the sun by itself
+        return false;
+    }
+    SkyComp->RecaptureSky();
+    return true;
+}
+
+// =============================================================================
+// SET TIME OF DAY (via directional light rotation)
+// =============================================================================
+
+TSharedPtr<FJsonObject> FUnrealCompanionEnvironmentCommands::HandleSetTimeOfDay(const TSharedPtr<FJsonObject>& Params)
+{
+    UWorld* World = GEditor->GetEditorWorldContext().World();
+    if (!World)
     {
-        ASkyLight* SkyLight = *It;
-        if (SkyLight && SkyLight->GetLightComponent())
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
+    }
+
+    // Find or create the directional light (sun)
+    FEnvironmentActors Actors = ResolveEnvironment(World);
+    if (!Actors.Sun)
+    {
+        // Spawn a new directional light
+        Actors.Sun = World->SpawnActor<ADirectionalLight>(
+            ADirectionalLight::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+        if (Actors.Sun)
         {
-            SkyLight->GetLightComponent()->RecaptureSky();
+            Actors.Sun->SetActorLabel(TEXT("Sun"));
+            RememberEnvironment(Actors);
         }
     }
 
+    if (!Actors.Sun)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to find or create directional light"));
+    }
+
+    // time defaults to noon, as it always has for this action
+    TSharedPtr<FJsonObject> SunParams = Params;
+    if (!Params->HasField(TEXT("time")))
+    {
+        SunParams = MakeShared<FJsonObject>(*Params);
+        SunParams->SetNumberField(TEXT("time"), 12.0);
+    }
+
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetBoolField(TEXT("success"), true);
-    ResultObj->SetNumberField(TEXT("time_of_day"), TimeOfDay);
-    ResultObj->SetNumberField(TEXT("sun_pitch"), SunPitch);
+    ApplySun(Actors.Sun, SunParams, ResultObj);
+
+    // Update sky light to match
+    RecaptureSkyLight(Actors.SkyLight);
+
+    ResultObj->RemoveField(TEXT("sun_intensity"));
     return ResultObj;
 }
 
@@ -181,83 +337,121 @@ TSharedPtr<FJsonObject> FUnrealCompanionEnvironmentCommands::HandleSetFog(const
     }
 
     // Find or create exponential height fog
-    AExponentialHeightFog* FogActor = nullptr;
-    for (TActorIterator<AExponentialHeightFog> It(World); It; ++It)
-    {
-        FogActor = *It;
-        break;
-    }
-
+    FEnvironmentActors Actors = ResolveEnvironment(World);
     bool bCreated = false;
-    if (!FogActor)
+    if (!Actors.Fog)
     {
-        FogActor = World->SpawnActor<AExponentialHeightFog>(
+        Actors.Fog = World->SpawnActor<AExponentialHeightFog>(
             AExponentialHeightFog::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
-        if (FogActor)
+        if (Actors.Fog)
         {
-            FogActor->SetActorLabel(TEXT("HeightFog"));
+            Actors.Fog->SetActorLabel(TEXT("HeightFog"));
+            RememberEnvironment(Actors);
             bCreated = true;
         }
     }
 
-    if (!FogActor)
+    if (!Actors.Fog)
     {
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to find or create ExponentialHeightFog"));
     }
 
-    UExponentialHeightFogComponent* FogComp = FogActor->GetComponent();
+    UExponentialHeightFogComponent* FogComp = Actors.Fog->GetComponent();
     if (!FogComp)
     {
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to get fog component"));
     }
 
-    // Apply settings
-    if (Params->HasField(TEXT("density")))
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetBoolField(TEXT("success"), true);
+    ResultObj->SetBoolField(TEXT("created"), bCreated);
+    ApplyFog(Actors.Fog, Params, ResultObj);
+    ResultObj->SetNumberField(TEXT("density"), FogComp->FogDensity);
+    ResultObj->SetNumberField(TEXT("height_falloff"), FogComp->FogHeightFalloff);
+    return ResultObj;
+}
+
+// =============================================================================
+// APPLY (sun, fog and sky light in one call)
+// =============================================================================
+
+TSharedPtr<FJsonObject> FUnrealCompanionEnvironmentCommands::HandleApply(const TSharedPtr<FJsonObject>& Params)
+{
+    UWorld* World = GEditor->GetEditorWorldContext().World();
+    if (!World)
     {
-        FogComp->FogDensity = FMath::Clamp((float)Params->GetNumberField(TEXT("density")), 0.0f, 1.0f);
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
     }
 
-    if (Params->HasField(TEXT("height_falloff")))
+    const double StartTime = FPlatformTime::Seconds();
+    const FEnvironmentActors Actors = ResolveEnvironment(World);
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetBoolField(TEXT("success"), true);
+
+    TArray<FString> Missing;
+    TSharedPtr<FJsonObject> SunObj = MakeShared<FJsonObject>();
+    const bool bSunChanged = ApplySun(Actors.Sun, Params, SunObj);
+    if (bSunChanged)
     {
-        FogComp->FogHeightFalloff = FMath::Max(0.001f, (float)Params->GetNumberField(TEXT("height_falloff")));
+        ResultObj->SetObjectField(TEXT("sun"), SunObj);
+    }
+    else if (!Actors.Sun && (Params->HasField(TEXT("time")) || Params->HasField(TEXT("sun_intensity")) || Params->HasField(TEXT("sun_color"))))
+    {
+        Missing.Add(TEXT("sun"));
     }
 
-    if (Params->HasField(TEXT("start_distance")))
+    TSharedPtr<FJsonObject> FogObj = MakeShared<FJsonObject>();
+    if (ApplyFog(Actors.Fog, Params, FogObj))
     {
-        FogComp->StartDistance = FMath::Max(0.0f, (float)Params->GetNumberField(TEXT("start_distance")));
+        ResultObj->SetObjectField(TEXT("fog"), FogObj);
+    }
+    else if (!Actors.Fog && (Params->HasField(TEXT("density")) || Params->HasField(TEXT("color")) || Params->HasField(TEXT("volumetric"))))
+    {
+        Missing.Add(TEXT("fog"));
     }
 
-    if (Params->HasField(TEXT("color")))
+    USkyLightComponent* SkyComp = Actors.SkyLight ? Actors.SkyLight->GetLightComponent() : nullptr;
+    bool bSkyIntensityChanged = false;
+    if (Params->HasField(TEXT("sky_light_intensity")))
     {
-        const TArray<TSharedPtr<FJsonValue>>* ColorArray;
-        if (Params->TryGetArrayField(TEXT("color"), ColorArray) && ColorArray->Num() >= 3)
+        if (SkyComp)
+        {
+            SkyComp->Modify();
+            SkyComp->Intensity = Params->GetNumberField(TEXT("sky_light_intensity"));
+            SkyComp->MarkRenderStateDirty();
+            bSkyIntensityChanged = true;
+        }
+        else
         {
-            FLinearColor FogColor;
-            FogColor.R = (*ColorArray)[0]->AsNumber();
-            FogColor.G = (*ColorArray)[1]->AsNumber();
-            FogColor.B = (*ColorArray)[2]->AsNumber();
-            FogColor.A = 1.0f;
-            FogComp->SetFogInscatteringColor(FogColor);
+            Missing.Add(TEXT("sky_light"));
         }
     }
 
-    if (Params->HasField(TEXT("enabled")))
+    // One recapture for everything that moved the sun
+    bool bRecapture = bSunChanged;
+    Params->TryGetBoolField(TEXT("recapture_sky"), bRecapture);
+    const bool bRecaptured = bRecapture && RecaptureSkyLight(Actors.SkyLight);
+    if (SkyComp && (bSkyIntensityChanged || bRecaptured))
     {
-        FogComp->SetVisibility(Params->GetBoolField(TEXT("enabled")));
+        TSharedPtr<FJsonObject> SkyObj = MakeShared<FJsonObject>();
+        SkyObj->SetNumberField(TEXT("intensity"), SkyComp->Intensity);
+        SkyObj->SetBoolField(TEXT("recaptured"), bRecaptured);
+        ResultObj->SetObjectField(TEXT("sky_light"), SkyObj);
     }
 
-    if (Params->HasField(TEXT("volumetric")))
+    if (Missing.Num() > 0)
     {
-        FogComp->SetVolumetricFog(Params->GetBoolField(TEXT("volumetric")));
+        // apply never spawns: setup_atmosphere creates missing actors
+        TArray<TSharedPtr<FJsonValue>> MissingArray;
+        for (const FString& Name : Missing)
+        {
+            MissingArray.Add(MakeShared<FJsonValueString>(Name));
+        }
+        ResultObj->SetArrayField(TEXT("missing"), MissingArray);
     }
 
-    FogActor->PostEditChange();
-
-    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-    ResultObj->SetBoolField(TEXT("success"), true);
-    ResultObj->SetBoolField(TEXT("created"), bCreated);
-    ResultObj->SetNumberField(TEXT("density"), FogComp->FogDensity);
-    ResultObj->SetNumberField(TEXT("height_falloff"), FogComp->FogHeightFalloff);
+    ResultObj->SetNumberField(TEXT("apply_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
     return ResultObj;
 }
 
@@ -279,13 +473,11 @@ TSharedPtr<FJsonObject> FUnrealCompanionEnvironmentCommands::HandleSetupAtmosphe
     // Create each component if missing
     bool bCreatedSun = false, bCreatedFog = false, bCreatedSkyLight = false, bCreatedAtmosphere = false;
 
+    // One scan finds whatever already exists
+    FEnvironmentActors Actors = ResolveEnvironment(World);
+
     // 1. Directional Light (sun)
-    ADirectionalLight* SunLight = nullptr;
-    for (TActorIterator<ADirectionalLight> It(World); It; ++It)
-    {
-        SunLight = *It;
-        break;
-    }
+    ADirectionalLight*& SunLight = Actors.Sun;
     if (!SunLight)
     {
         SunLight = World->SpawnActor<ADirectionalLight>(
@@ -300,17 +492,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionEnvironmentCommands::HandleSetupAtmosphe
     }
 
     // 2. Sky Atmosphere
-    // Check if one exists
-    bool bHasAtmosphere = false;
-    for (TActorIterator<AActor> It(World); It; ++It)
-    {
-        if (It->FindComponentByClass<USkyAtmosphereComponent>())
-        {
-            bHasAtmosphere = true;
-            break;
-        }
-    }
-    if (!bHasAtmosphere)
+    if (!Actors.Atmosphere)
     {
         // Spawn generic actor with SkyAtmosphere component
         AActor* AtmoActor = World->SpawnActor<AActor>(
@@ -325,17 +507,13 @@ TSharedPtr<FJsonObject> FUnrealCompanionEnvironmentCommands::HandleSetupAtmosphe
             USkyAtmosphereComponent* AtmoComp = NewObject<USkyAtmosphereComponent>(AtmoActor, TEXT("SkyAtmosphere"));
             AtmoComp->SetupAttachment(Root);
             AtmoComp->RegisterComponent();
+            Actors.Atmosphere = AtmoComp;
             bCreatedAtmosphere = true;
         }
     }
 
     // 3. Sky Light
-    ASkyLight* SkyLight = nullptr;
-    for (TActorIterator<ASkyLight> It(World); It; ++It)
-    {
-        SkyLight = *It;
-        break;
-    }
+    ASkyLight*& SkyLight = Actors.SkyLight;
     if (!SkyLight)
     {
         SkyLight = World->SpawnActor<ASkyLight>(
@@ -354,12 +532,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionEnvironmentCommands::HandleSetupAtmosphe
     }
 
     // 4. Exponential Height Fog
-    AExponentialHeightFog* FogActor = nullptr;
-    for (TActorIterator<AExponentialHeightFog> It(World); It; ++It)
-    {
-        FogActor = *It;
-        break;
-    }
+    AExponentialHeightFog*& FogActor = Actors.Fog;
     if (!FogActor)
     {
         FogActor = World->SpawnActor<AExponentialHeightFog>(
@@ -377,6 +550,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionEnvironmentCommands::HandleSetupAtmosphe
             bCreatedFog = true;
         }
     }
+    RememberEnvironment(Actors);
 
     ResultObj->SetBoolField(TEXT("created_sun"), bCreatedSun);
     ResultObj->SetBoolField(TEXT("created_atmosphere"), bCreatedAtmosphere);
@@ -401,10 +575,11 @@ TSharedPtr<FJsonObject> FUnrealCompanionEnvironmentCommands::HandleGetInfo(const
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetBoolField(TEXT("success"), true);
 
+    const FEnvironmentActors Actors = ResolveEnvironment(World);
+
     // Sun/Directional Light
-    for (TActorIterator<ADirectionalLight> It(World); It; ++It)
+    if (ADirectionalLight* Sun = Actors.Sun)
     {
-        ADirectionalLight* Sun = *It;
         TSharedPtr<FJsonObject> SunObj = MakeShared<FJsonObject>();
         SunObj->SetStringField(TEXT("name"), Sun->GetActorLabel());
         FRotator Rot = Sun->GetActorRotation();
@@ -416,46 +591,22 @@ TSharedPtr<FJsonObject> FUnrealCompanionEnvironmentCommands::HandleGetInfo(const
             SunObj->SetNumberField(TEXT("intensity"), LC->Intensity);
         }
         ResultObj->SetObjectField(TEXT("sun"), SunObj);
-        break;
     }
 
     // Fog
-    for (TActorIterator<AExponentialHeightFog> It(World); It; ++It)
-    {
-        AExponentialHeightFog* Fog = *It;
-        UExponentialHeightFogComponent* FC = Fog->GetComponent();
-        if (FC)
-        {
-            TSharedPtr<FJsonObject> FogObj = MakeShared<FJsonObject>();
-            FogObj->SetNumberField(TEXT("density"), FC->FogDensity);
-            FogObj->SetNumberField(TEXT("height_falloff"), FC->FogHeightFalloff);
-            FogObj->SetNumberField(TEXT("start_distance"), FC->StartDistance);
-            FogObj->SetBoolField(TEXT("volumetric"), FC->bEnableVolumetricFog);
-            ResultObj->SetObjectField(TEXT("fog"), FogObj);
-        }
-        break;
-    }
-
-    // Sky atmosphere
-    bool bHasAtmo = false;
-    for (TActorIterator<AActor> It(World); It; ++It)
+    UExponentialHeightFogComponent* FC = Actors.Fog ? Actors.Fog->GetComponent() : nullptr;
+    if (FC)
     {
-        if (It->FindComponentByClass<USkyAtmosphereComponent>())
-        {
-            bHasAtmo = true;
-            break;
-        }
+        TSharedPtr<FJsonObject> FogObj = MakeShared<FJsonObject>();
+        FogObj->SetNumberField(TEXT("density"), FC->FogDensity);
+        FogObj->SetNumberField(TEXT("height_falloff"), FC->FogHeightFalloff);
+        FogObj->SetNumberField(TEXT("start_distance"), FC->StartDistance);
+        FogObj->SetBoolField(TEXT("volumetric"), FC->bEnableVolumetricFog);
+        ResultObj->SetObjectField(TEXT("fog"), FogObj);
     }
-    ResultObj->SetBoolField(TEXT("has_atmosphere"), bHasAtmo);
 
-    // Sky light
-    bool bHasSkyLight = false;
-    for (TActorIterator<ASkyLight> It(World); It; ++It)
-    {
-        bHasSkyLight = true;
-        break;
-    }
-    ResultObj->SetBoolField(TEXT("has_sky_light"), bHasSkyLight);
+    ResultObj->SetBoolField(TEXT("has_atmosphere"), Actors.Atmosphere != nullptr);
+    ResultObj->SetBoolField(TEXT("has_sky_light"), Actors.SkyLight != nullptr);
 
     return ResultObj;
 }
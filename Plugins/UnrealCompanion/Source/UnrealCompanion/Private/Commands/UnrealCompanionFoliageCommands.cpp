@@ -1,5 +1,8 @@
 #include "Commands/UnrealCompanionFoliageCommands.h"
 #include "Commands/UnrealCompanionCommonUtils.h"
+#include "Commands/UnrealCompanionDeferredResponse.h"
+#include "MCPSharedMemory.h"
+#include "UnrealCompanionStats.h"
 #include "Editor.h"
 #include "InstancedFoliageActor.h"
 #include "FoliageType.h"
@@ -8,26 +11,411 @@
 #include "Kismet/GameplayStatics.h"
 #include "CollisionQueryParams.h"
 #include "EngineUtils.h"
+#include "Async/ParallelFor.h"
+#include "Misc/Base64.h"
 
-FUnrealCompanionFoliageCommands::FUnrealCompanionFoliageCommands()
+namespace
 {
-}
+    /**
+     * Uniform grid for min-distance rejection. With a cell size of MinDistance, any point
+     * closer than MinDistance lies in the surrounding 3x3x3 cells, so each test is O(1)
+     * instead of a scan over every placed instance.
+     */
+    class FMinDistanceGrid
+    {
+    public:
+        explicit FMinDistanceGrid(float InMinDistance)
+            : MinDistanceSq(InMinDistance * InMinDistance)
+            , InvCellSize(InMinDistance > 0.0f ? 1.0f / InMinDistance : 0.0f)
+        {
+        }
 
-TSharedPtr<FJsonObject> FUnrealCompanionFoliageCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
-{
-    if (CommandType == TEXT("foliage_add_type"))
+        bool IsFarEnough(const FVector& Location) const
+        {
+            if (InvCellSize <= 0.0f)
+            {
+                return true;
+            }
+
+            const FIntVector Cell = CellOf(Location);
+            for (int32 Z = -1; Z <= 1; Z++)
+            for (int32 Y = -1; Y <= 1; Y++)
+            for (int32 X = -1; X <= 1; X++)
+            {
+                if (const TArray<FVector, TInlineAllocator<2>>* Points = Cells.Find(Cell + FIntVector(X, Y, Z)))
+                {
+                    for (const FVector& Point : *Points)
+                    {
+                        if (FVector::DistSquared(Location, Point) < MinDistanceSq)
+                        {
+                            return false;
+                        }
+                    }
+                }
+            }
+            return true;
+        }
+
+        void Add(const FVector& Location)
+        {
+            if (InvCellSize > 0.0f)
+            {
+                Cells.FindOrAdd(CellOf(Location)).Add(Location);
+            }
+        }
+
+    private:
+        FIntVector CellOf(const FVector& Location) const
+        {
+            return FIntVector(
+                FMath::FloorToInt(Location.X * InvCellSize),
+                FMath::FloorToInt(Location.Y * InvCellSize),
+                FMath::FloorToInt(Location.Z * InvCellSize));
+        }
+
+        float MinDistanceSq;
+        float InvCellSize;
+        TMap<FIntVector, TArray<FVector, TInlineAllocator<2>>> Cells;
+    };
+
+    /**
+     * Bridson Poisson-disk sampling over a rectangle, optionally clipped to a circle.
+     * Every returned point is at least Spacing from every other, and the set is shuffled
+     * so taking a prefix still covers the whole area instead of growing from the seed.
+     */
+    void GeneratePoissonDisk(FRandomStream& Random, const FBox2D& Bounds, const FVector2D* CircleCenter, float CircleRadius, float Spacing, int32 MaxPoints, TArray<FVector2D>& OutPoints)
     {
-        return HandleAddType(Params);
+        constexpr int32 AttemptsPerPoint = 30;
+        const float CellSize = Spacing / UE_SQRT_2;
+        const FVector2D Size = Bounds.GetSize();
+        const int32 GridW = FMath::Max(FMath::CeilToInt(Size.X / CellSize), 1);
+        const int32 GridH = FMath::Max(FMath::CeilToInt(Size.Y / CellSize), 1);
+
+        TArray<int32> Grid;
+        Grid.Init(INDEX_NONE, GridW * GridH);
+        TArray<int32> Active;
+
+        auto CellIndex = [&](const FVector2D& P)
+        {
+            const int32 CX = FMath::Clamp(FMath::FloorToInt((P.X - Bounds.Min.X) / CellSize), 0, GridW - 1);
+            const int32 CY = FMath::Clamp(FMath::FloorToInt((P.Y - Bounds.Min.Y) / CellSize), 0, GridH - 1);
+            return FIntPoint(CX, CY);
+        };
+        auto IsInside = [&](const FVector2D& P)
+        {
+            return Bounds.IsInside(P) && (!CircleCenter || FVector2D::DistSquared(P, *CircleCenter) <= CircleRadius * CircleRadius);
+        };
+        auto IsFree = [&](const FVector2D& P)
+        {
+            const FIntPoint Cell = CellIndex(P);
+            for (int32 Y = FMath::Max(Cell.Y - 2, 0); Y <= FMath::Min(Cell.Y + 2, GridH - 1); Y++)
+            {
+                for (int32 X = FMath::Max(Cell.X - 2, 0); X <= FMath::Min(Cell.X + 2, GridW - 1); X++)
+                {
+                    const int32 Other = Grid[X + Y * GridW];
+                    if (Other != INDEX_NONE && FVector2D::DistSquared(P, OutPoints[Other]) < Spacing * Spacing)
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        };
+        auto AddPoint = [&](const FVector2D& P)
+        {
+            const FIntPoint Cell = CellIndex(P);
+            Grid[Cell.X + Cell.Y * GridW] = OutPoints.Add(P);
+            Active.Add(OutPoints.Num() - 1);
+        };
+
+        FVector2D Seed = CircleCenter ? *CircleCenter : Bounds.GetCenter();
+        AddPoint(Seed);
+
+        while (Active.Num() > 0 && OutPoints.Num() < MaxPoints)
+        {
+            const int32 ActiveSlot = Random.RandHelper(Active.Num());
+            const FVector2D Base = OutPoints[Active[ActiveSlot]];
+            bool bFound = false;
+
+            for (int32 Attempt = 0; Attempt < AttemptsPerPoint; Attempt++)
+            {
+                const float Angle = Random.FRandRange(0.0f, 2.0f * PI);
+                const float Dist = Spacing * (1.0f + Random.FRand());
+                const FVector2D Candidate = Base + FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * Dist;
+                if (IsInside(Candidate) && IsFree(Candidate))
+                {
+                    AddPoint(Candidate);
+                    bFound = true;
+                    break;
+                }
+            }
+
+            if (!bFound)
+            {
+                Active.RemoveAtSwap(ActiveSlot, 1, EAllowShrinking::No);
+            }
+        }
+
+        // Fisher-Yates
+        for (int32 Index = OutPoints.Num() - 1; Index > 0; Index--)
+        {
+            OutPoints.Swap(Index, Random.RandHelper(Index + 1));
+        }
     }
-    else if (CommandType == TEXT("foliage_scatter"))
+
+    /** Even-odd rule point-in-polygon test in XY */
+    bool IsPointInPolygon(const FVector2D& Point, const TArray<FVector2D>& Polygon)
     {
-        return HandleScatter(Params);
+        bool bInside = false;
+        for (int32 I = 0, J = Polygon.Num() - 1; I < Polygon.Num(); J = I++)
+        {
+            const FVector2D& A = Polygon[I];
+            const FVector2D& B = Polygon[J];
+            if ((A.Y > Point.Y) != (B.Y > Point.Y) &&
+                Point.X < (B.X - A.X) * (Point.Y - A.Y) / (B.Y - A.Y) + A.X)
+            {
+                bInside = !bInside;
+            }
+        }
+        return bInside;
     }
-    else if (CommandType == TEXT("foliage_remove"))
+
+    /**
+     * Area of foliage_remove and foliage_export: sphere (default, center + radius), box
+     * [minX, minY, maxX, maxY] (all heights) or [minX, minY, minZ, maxX, maxY, maxZ], or
+     * polygon [[x, y], ...] (all heights)
+     */
+    struct FFoliageRegion
     {
-        return HandleRemove(Params);
+        FString Type = TEXT("sphere");
+        FSphere Sphere = FSphere(FVector::ZeroVector, 5000.0f);
+        FBox Box = FBox(ForceInit);
+        TArray<FVector2D> Polygon;
+
+        /** With bAllowAll, a request without center, radius, box or polygon selects everything ("all") */
+        bool Parse(const TSharedPtr<FJsonObject>& Params, bool bAllowAll, FString& OutError)
+        {
+            if (bAllowAll && !Params->HasField(TEXT("center")) && !Params->HasField(TEXT("radius"))
+                && !Params->HasField(TEXT("box")) && !Params->HasField(TEXT("polygon")))
+            {
+                Type = TEXT("all");
+                return true;
+            }
+
+            if (Params->HasField(TEXT("center")))
+            {
+                Sphere.Center = FUnrealCompanionCommonUtils::GetVectorFromJson(Params, TEXT("center"));
+            }
+            if (Params->HasField(TEXT("radius")))
+            {
+                Sphere.W = Params->GetNumberField(TEXT("radius"));
+            }
+
+            const TArray<TSharedPtr<FJsonValue>>* BoxArray;
+            const TArray<TSharedPtr<FJsonValue>>* PolygonArray;
+            if (Params->TryGetArrayField(TEXT("polygon"), PolygonArray))
+            {
+                for (const TSharedPtr<FJsonValue>& PointValue : *PolygonArray)
+                {
+                    const TArray<TSharedPtr<FJsonValue>>* PointArray;
+                    if (PointValue->TryGetArray(PointArray) && PointArray->Num() >= 2)
+                    {
+                        Polygon.Emplace((*PointArray)[0]->AsNumber(), (*PointArray)[1]->AsNumber());
+                    }
+                }
+                if (Polygon.Num() < 3)
+                {
+                    OutError = TEXT("'polygon' needs at least 3 [x, y] points");
+                    return false;
+                }
+
+                Type = TEXT("polygon");
+                const FBox2D Bounds(Polygon);
+                Box = FBox(FVector(Bounds.Min, -UE_LARGE_WORLD_MAX), FVector(Bounds.Max, UE_LARGE_WORLD_MAX));
+            }
+            else if (Params->TryGetArrayField(TEXT("box"), BoxArray) && (BoxArray->Num() == 4 || BoxArray->Num() >= 6))
+            {
+                Type = TEXT("box");
+                if (BoxArray->Num() >= 6)
+                {
+                    Box = FBox(
+                        FVector((*BoxArray)[0]->AsNumber(), (*BoxArray)[1]->AsNumber(), (*BoxArray)[2]->AsNumber()),
+                        FVector((*BoxArray)[3]->AsNumber(), (*BoxArray)[4]->AsNumber(), (*BoxArray)[5]->AsNumber()));
+                }
+                else
+                {
+                    Box = FBox(
+                        FVector((*BoxArray)[0]->AsNumber(), (*BoxArray)[1]->AsNumber(), -UE_LARGE_WORLD_MAX),
+                        FVector((*BoxArray)[2]->AsNumber(), (*BoxArray)[3]->AsNumber(), UE_LARGE_WORLD_MAX));
+                }
+            }
+            return true;
+        }
+
+        /** Instances of Info inside the region. Candidates come from the foliage instance hash, not a scan. */
+        void Find(FFoliageInfo& Info, TArray<int32>& OutIndices) const
+        {
+            if (Type == TEXT("all"))
+            {
+                OutIndices.SetNumUninitialized(Info.Instances.Num());
+                for (int32 Index = 0; Index < OutIndices.Num(); Index++)
+                {
+                    OutIndices[Index] = Index;
+                }
+            }
+            else if (Type == TEXT("sphere"))
+            {
+                Info.GetInstancesInsideSphere(Sphere, OutIndices);
+            }
+            else
+            {
+                Info.GetInstancesOverlappingBox(Box, OutIndices);
+                if (Type == TEXT("polygon"))
+                {
+                    OutIndices.RemoveAllSwap([&](int32 Index)
+                    {
+                        const FVector Location(Info.Instances[Index].Location);
+                        return !IsPointInPolygon(FVector2D(Location), Polygon);
+                    });
+                }
+            }
+        }
+    };
+
+    /** The foliage type IFA already has for Mesh, if any */
+    UFoliageType_InstancedStaticMesh* FindMeshFoliageType(AInstancedFoliageActor* IFA, const UStaticMesh* Mesh)
+    {
+        for (const auto& Pair : IFA->GetFoliageInfos())
+        {
+            if (UFoliageType_InstancedStaticMesh* ISMType = Cast<UFoliageType_InstancedStaticMesh>(Pair.Key))
+            {
+                if (ISMType->GetStaticMesh() == Mesh)
+                {
+                    return ISMType;
+                }
+            }
+        }
+        return nullptr;
     }
 
+    /**
+     * One instance in foliage_export / foliage_import data, little-endian, no padding.
+     * Location stays double so large worlds round-trip exactly; rotation is (pitch, yaw, roll)
+     * in degrees.
+     */
+    struct FPackedFoliageInstance
+    {
+        double Location[3];
+        float Rotation[3];
+        float Scale[3];
+
+        static constexpr int32 NumValues = 9;
+
+        static FPackedFoliageInstance FromInstance(const FFoliageInstance& Instance)
+        {
+            FPackedFoliageInstance Packed;
+            Packed.Location[0] = Instance.Location.X;
+            Packed.Location[1] = Instance.Location.Y;
+            Packed.Location[2] = Instance.Location.Z;
+            Packed.Rotation[0] = (float)Instance.Rotation.Pitch;
+            Packed.Rotation[1] = (float)Instance.Rotation.Yaw;
+            Packed.Rotation[2] = (float)Instance.Rotation.Roll;
+            Packed.Scale[0] = Instance.DrawScale3D.X;
+            Packed.Scale[1] = Instance.DrawScale3D.Y;
+            Packed.Scale[2] = Instance.DrawScale3D.Z;
+            return Packed;
+        }
+
+        void ToInstance(const FVector& Offset, FFoliageInstance& OutInstance) const
+        {
+            OutInstance.Location = FVector(Location[0], Location[1], Location[2]) + Offset;
+            OutInstance.Rotation = FRotator(Rotation[0], Rotation[1], Rotation[2]);
+            OutInstance.DrawScale3D = FVector3f(Scale[0], Scale[1], Scale[2]);
+        }
+    };
+    static_assert(sizeof(FPackedFoliageInstance) == 48, "foliage_export layout is part of the wire format");
+
+    constexpr int32 DefaultExportChunkInstances = 65536;
+    constexpr int32 MaxExportChunkInstances = 1 << 20;
+
+    /**
+     * Packed instances of one foliage_import entry, from "data" (base64 of the packed
+     * layout) or "transforms" (flat numbers, 9 per instance, which CBOR clients send as
+     * a typed array)
+     */
+    bool DecodeImportedInstances(const TSharedPtr<FJsonObject>& Entry, TArray<FPackedFoliageInstance>& OutInstances, FString& OutError)
+    {
+        FString Encoded;
+        const TArray<TSharedPtr<FJsonValue>>* Values;
+        if (Entry->TryGetStringField(TEXT("data"), Encoded))
+        {
+            TArray<uint8> Bytes;
+            if (!FBase64::Decode(Encoded, Bytes))
+            {
+                OutError = TEXT("'data' is not valid base64");
+                return false;
+            }
+            if (Bytes.Num() % sizeof(FPackedFoliageInstance) != 0)
+            {
+                OutError = FString::Printf(TEXT("'data' is %d bytes, not a multiple of the %d-byte instance record"), Bytes.Num(), (int32)sizeof(FPackedFoliageInstance));
+                return false;
+            }
+            OutInstances.SetNumUninitialized(Bytes.Num() / sizeof(FPackedFoliageInstance));
+            FMemory::Memcpy(OutInstances.GetData(), Bytes.GetData(), Bytes.Num());
+            return true;
+        }
+        if (Entry->TryGetArrayField(TEXT("transforms"), Values))
+        {
+            if (Values->Num() % FPackedFoliageInstance::NumValues != 0)
+            {
+                OutError = FString::Printf(TEXT("'transforms' has %d numbers, not a multiple of 9 (x, y, z, pitch, yaw, roll, sx, sy, sz)"), Values->Num());
+                return false;
+            }
+            OutInstances.SetNumUninitialized(Values->Num() / FPackedFoliageInstance::NumValues);
+            for (int32 Index = 0; Index < OutInstances.Num(); Index++)
+            {
+                const TSharedPtr<FJsonValue>* V = Values->GetData() + Index * FPackedFoliageInstance::NumValues;
+                FPackedFoliageInstance& Packed = OutInstances[Index];
+                Packed.Location[0] = V[0]->AsNumber();
+                Packed.Location[1] = V[1]->AsNumber();
+                Packed.Location[2] = V[2]->AsNumber();
+                Packed.Rotation[0] = (float)V[3]->AsNumber();
+                Packed.Rotation[1] = (float)V[4]->AsNumber();
+                Packed.Rotation[2] = (float)V[5]->AsNumber();
+                Packed.Scale[0] = (float)V[6]->AsNumber();
+                Packed.Scale[1] = (float)V[7]->AsNumber();
+                Packed.Scale[2] = (float)V[8]->AsNumber();
+            }
+            return true;
+        }
+        OutError = TEXT("needs 'data' (base64) or 'transforms'");
+        return false;
+    }
+}
+
+FUnrealCompanionFoliageCommands::FUnrealCompanionFoliageCommands()
+{
+}
+
+TConstArrayView<TMCPCommandEntry<FUnrealCompanionFoliageCommands>> FUnrealCompanionFoliageCommands::GetCommandTable()
+{
+    static constexpr TMCPCommandEntry<FUnrealCompanionFoliageCommands> Table[] = {
+        { TEXT("foliage_add_type"), &FUnrealCompanionFoliageCommands::HandleAddType },
+        { TEXT("foliage_scatter"), &FUnrealCompanionFoliageCommands::HandleScatter },
+        { TEXT("foliage_remove"), &FUnrealCompanionFoliageCommands::HandleRemove },
+        { TEXT("foliage_export"), &FUnrealCompanionFoliageCommands::HandleExport },
+        { TEXT("foliage_import"), &FUnrealCompanionFoliageCommands::HandleImport },
+    };
+    static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+    return Table;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionFoliageCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    if (TSharedPtr<FJsonObject> Result = UnrealCompanionCommandTable::Dispatch(*this, GetCommandTable(), CommandType, Params))
+    {
+        return Result;
+    }
     return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown foliage command: %s"), *CommandType));
 }
 
@@ -138,6 +526,8 @@ TSharedPtr<FJsonObject> FUnrealCompanionFoliageCommands::HandleAddType(const TSh
 
 TSharedPtr<FJsonObject> FUnrealCompanionFoliageCommands::HandleScatter(const TSharedPtr<FJsonObject>& Params)
 {
+    UNREALCOMPANION_SCOPE_CYCLE_COUNTER(STAT_UnrealCompanion_FoliageScatter);
+
     FString MeshPath;
     if (!Params->TryGetStringField(TEXT("mesh"), MeshPath))
     {
@@ -180,7 +570,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionFoliageCommands::HandleScatter(const TSh
 
     int32 Count = 100;
     if (Params->HasField(TEXT("count")))
-        Count = FMath::Clamp((int32)Params->GetNumberField(TEXT("count")), 1, 10000);
+        Count = FMath::Clamp((int32)Params->GetNumberField(TEXT("count")), 1, 100000);
 
     float ScaleMin = 0.8f, ScaleMax = 1.2f;
     if (Params->HasField(TEXT("scale_range")))
@@ -205,6 +595,16 @@ TSharedPtr<FJsonObject> FUnrealCompanionFoliageCommands::HandleScatter(const TSh
     if (Params->HasField(TEXT("min_distance")))
         MinDistance = Params->GetNumberField(TEXT("min_distance"));
 
+    // "random" (default): uniform candidates + min-distance rejection
+    // "blue_noise": Poisson-disk candidates, evenly spread and never rejected for spacing
+    FString Distribution = TEXT("random");
+    Params->TryGetStringField(TEXT("distribution"), Distribution);
+    const bool bBlueNoise = Distribution.Equals(TEXT("blue_noise"), ESearchCase::IgnoreCase);
+
+    // Every candidate draws from its own (seed, index) stream, so the layout is identical
+    // for a given seed no matter how the work is split across threads
+    const int32 Seed = FUnrealCompanionCommonUtils::GetSeedFromParams(Params);
+
     // Get world
     UWorld* World = GEditor->GetEditorWorldContext().World();
     if (!World)
@@ -220,20 +620,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionFoliageCommands::HandleScatter(const TSh
     }
 
     // Create or find the foliage type for this mesh
-    UFoliageType_InstancedStaticMesh* FoliageType = nullptr;
-
-    // Check if foliage type already exists for this mesh
-    for (const auto& Pair : IFA->GetFoliageInfos())
-    {
-        if (UFoliageType_InstancedStaticMesh* ISMType = Cast<UFoliageType_InstancedStaticMesh>(Pair.Key))
-        {
-            if (ISMType->GetStaticMesh() == Mesh)
-            {
-                FoliageType = ISMType;
-                break;
-            }
-        }
-    }
+    UFoliageType_InstancedStaticMesh* FoliageType = FindMeshFoliageType(IFA, Mesh);
 
     if (!FoliageType)
     {
@@ -248,97 +635,160 @@ TSharedPtr<FJsonObject> FUnrealCompanionFoliageCommands::HandleScatter(const TSh
         IFA->AddMesh(FoliageType);
     }
 
-    // Generate transforms with raycasting
+    // Generate transforms with raycasting, in waves: candidates are generated and traced in
+    // parallel, then accepted in candidate order on the game thread so the result does not
+    // depend on how the work was scheduled
     TArray<FTransform> ValidTransforms;
     ValidTransforms.Reserve(Count);
-    TArray<FVector> PlacedLocations; // For min distance check
 
     int32 MaxAttempts = Count * 3; // Allow some failed attempts
     int32 Attempts = 0;
 
-    FCollisionQueryParams QueryParams;
-    QueryParams.bTraceComplex = false;
+    // Blue noise: precompute the whole candidate set. Spacing is min_distance, or wider when
+    // the area could hold far more than Count points, so the result covers the area evenly
+    // (Bridson fills ~0.63 points per spacing^2; 25% extra absorbs trace misses).
+    TArray<FVector2D> BlueNoisePoints;
+    float BlueNoiseSpacing = 0.0f;
+    if (bBlueNoise)
+    {
+        UNREALCOMPANION_TRACE_SCOPE("FoliageScatter.PoissonDisk");
+        const FBox2D Bounds = bUseRadius
+            ? FBox2D(FVector2D(Center) - FVector2D(Radius), FVector2D(Center) + FVector2D(Radius))
+            : FBox2D(FVector2D(ScatterBox.Min), FVector2D(ScatterBox.Max));
+        const double Area = bUseRadius ? PI * Radius * Radius : Bounds.GetArea();
+        BlueNoiseSpacing = FMath::Max(MinDistance, (float)FMath::Sqrt(0.63 * Area / (Count * 1.25)));
+        if (BlueNoiseSpacing > 0.0f)
+        {
+            const FVector2D CircleCenter(Center);
+            FRandomStream PoissonRandom(Seed);
+            GeneratePoissonDisk(PoissonRandom, Bounds, bUseRadius ? &CircleCenter : nullptr, Radius, BlueNoiseSpacing, MaxAttempts, BlueNoisePoints);
+            MaxAttempts = BlueNoisePoints.Num();
+        }
+    }
+
+    // Poisson spacing already holds in XY, so only the random mode needs the grid
+    FMinDistanceGrid PlacedGrid(bBlueNoise ? 0.0f : MinDistance);
+
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(UnrealCompanionFoliageScatter), false);
     QueryParams.AddIgnoredActor(IFA);
 
+    struct FScatterCandidate
+    {
+        FRandomStream Random;
+        FVector Position;
+        FVector Location;
+        FVector Normal;
+        bool bHit;
+    };
+    TArray<FScatterCandidate> Candidates;
+
     while (ValidTransforms.Num() < Count && Attempts < MaxAttempts)
     {
-        Attempts++;
+        UNREALCOMPANION_TRACE_SCOPE("FoliageScatter.Wave");
 
-        FVector RandomPos;
-        if (bUseRadius)
-        {
-            // Random point in circle (uniform distribution via sqrt)
-            float Angle = FMath::FRandRange(0.0f, 2.0f * PI);
-            float Dist = FMath::Sqrt(FMath::FRand()) * Radius;
-            RandomPos = Center + FVector(FMath::Cos(Angle) * Dist, FMath::Sin(Angle) * Dist, 0.0f);
-        }
-        else
-        {
-            // Random point in box
-            RandomPos.X = FMath::FRandRange(ScatterBox.Min.X, ScatterBox.Max.X);
-            RandomPos.Y = FMath::FRandRange(ScatterBox.Min.Y, ScatterBox.Max.Y);
-            RandomPos.Z = Center.Z;
-        }
+        // Over-provision a little for misses and rejections
+        const int32 Remaining = Count - ValidTransforms.Num();
+        const int32 WaveSize = FMath::Min(FMath::Max(Remaining + Remaining / 4, 64), MaxAttempts - Attempts);
+        Attempts += WaveSize;
 
-        // Raycast down to find ground
-        FVector TraceStart = RandomPos + FVector(0, 0, 50000.0f);
-        FVector TraceEnd = RandomPos - FVector(0, 0, 50000.0f);
-        FHitResult Hit;
+        Candidates.SetNum(WaveSize, EAllowShrinking::No);
+        const int32 WaveStart = Attempts - WaveSize;
 
-        if (!World->LineTraceSingleByChannel(Hit, TraceStart, TraceEnd, ECC_WorldStatic, QueryParams))
+        // Raycast down to find ground. Scene queries only take the physics read lock, so
+        // this is the same work AsyncLineTraceByChannel would spread over worker threads,
+        // without waiting a frame for the results.
+        ParallelFor(Candidates.Num(), [&](int32 Index)
         {
-            continue; // No ground found
-        }
-
-        FVector HitLocation = Hit.Location;
+            FScatterCandidate& Candidate = Candidates[Index];
+            Candidate.Random = FUnrealCompanionCommonUtils::MakeIndexedRandomStream(Seed, WaveStart + Index);
+            Candidate.bHit = false;
 
-        // Check min distance
-        if (MinDistance > 0.0f)
-        {
-            bool bTooClose = false;
-            for (const FVector& Placed : PlacedLocations)
+            FVector RandomPos;
+            if (bBlueNoise)
             {
-                if (FVector::Dist(HitLocation, Placed) < MinDistance)
-                {
-                    bTooClose = true;
-                    break;
-                }
+                const FVector2D& Point = BlueNoisePoints[WaveStart + Index];
+                RandomPos = FVector(Point.X, Point.Y, Center.Z);
             }
-            if (bTooClose) continue;
-        }
+            else if (bUseRadius)
+            {
+                // Random point in circle (uniform distribution via sqrt)
+                float Angle = Candidate.Random.FRandRange(0.0f, 2.0f * PI);
+                float Dist = FMath::Sqrt(Candidate.Random.FRand()) * Radius;
+                RandomPos = Center + FVector(FMath::Cos(Angle) * Dist, FMath::Sin(Angle) * Dist, 0.0f);
+            }
+            else
+            {
+                // Random point in box
+                RandomPos.X = Candidate.Random.FRandRange(ScatterBox.Min.X, ScatterBox.Max.X);
+                RandomPos.Y = Candidate.Random.FRandRange(ScatterBox.Min.Y, ScatterBox.Max.Y);
+                RandomPos.Z = Center.Z;
+            }
+            Candidate.Position = RandomPos;
 
-        // Build transform
-        float Scale = FMath::FRandRange(ScaleMin, ScaleMax);
-        FRotator Rotation = FRotator::ZeroRotator;
+            FVector TraceStart = RandomPos + FVector(0, 0, 50000.0f);
+            FVector TraceEnd = RandomPos - FVector(0, 0, 50000.0f);
+            FHitResult Hit;
+            if (World->LineTraceSingleByChannel(Hit, TraceStart, TraceEnd, ECC_WorldStatic, QueryParams))
+            {
+                Candidate.Location = Hit.Location;
+                Candidate.Normal = Hit.Normal;
+                Candidate.bHit = true;
+            }
+        }, Candidates.Num() < 256 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
 
-        if (bAlignToNormal)
+        for (FScatterCandidate& Candidate : Candidates)
         {
-            Rotation = FRotationMatrix::MakeFromZ(Hit.Normal).Rotator();
-        }
+            if (ValidTransforms.Num() >= Count) break;
+            if (!Candidate.bHit) continue; // No ground found
 
-        if (bRandomYaw)
-        {
-            Rotation.Yaw = FMath::FRandRange(0.0f, 360.0f);
-        }
+            const FVector& HitLocation = Candidate.Location;
+
+            // Check min distance
+            if (!PlacedGrid.IsFarEnough(HitLocation)) continue;
 
-        ValidTransforms.Add(FTransform(Rotation, HitLocation, FVector(Scale)));
-        PlacedLocations.Add(HitLocation);
+            // Build transform
+            float Scale = Candidate.Random.FRandRange(ScaleMin, ScaleMax);
+            FRotator Rotation = FRotator::ZeroRotator;
+
+            if (bAlignToNormal)
+            {
+                Rotation = FRotationMatrix::MakeFromZ(Candidate.Normal).Rotator();
+            }
+
+            if (bRandomYaw)
+            {
+                Rotation.Yaw = Candidate.Random.FRandRange(0.0f, 360.0f);
+            }
+
+            ValidTransforms.Add(FTransform(Rotation, HitLocation, FVector(Scale)));
+            PlacedGrid.Add(HitLocation);
+        }
     }
 
-    // Add all instances via FFoliageInfo
+    // Add all instances via FFoliageInfo in one merged call (one cluster/tree rebuild)
     if (ValidTransforms.Num() > 0)
     {
         FFoliageInfo* FoliageInfo = IFA->FindOrAddMesh(FoliageType);
         if (FoliageInfo)
         {
+            UNREALCOMPANION_TRACE_SCOPE("FoliageScatter.AddInstances");
+            TArray<FFoliageInstance> NewInstances;
+            NewInstances.Reserve(ValidTransforms.Num());
             for (const FTransform& T : ValidTransforms)
             {
-                FFoliageInstance Inst;
+                FFoliageInstance& Inst = NewInstances.AddDefaulted_GetRef();
                 Inst.Location = T.GetLocation();
                 Inst.Rotation = T.GetRotation().Rotator();
                 Inst.DrawScale3D = FVector3f(T.GetScale3D());
-                FoliageInfo->AddInstance(FoliageType, Inst);
             }
+
+            TArray<const FFoliageInstance*> InstancePtrs;
+            InstancePtrs.Reserve(NewInstances.Num());
+            for (const FFoliageInstance& Inst : NewInstances)
+            {
+                InstancePtrs.Add(&Inst);
+            }
+            FoliageInfo->AddInstances(FoliageType, InstancePtrs);
         }
     }
 
@@ -347,6 +797,12 @@ TSharedPtr<FJsonObject> FUnrealCompanionFoliageCommands::HandleScatter(const TSh
     ResultObj->SetNumberField(TEXT("instances_placed"), ValidTransforms.Num());
     ResultObj->SetNumberField(TEXT("instances_requested"), Count);
     ResultObj->SetNumberField(TEXT("attempts"), Attempts);
+    ResultObj->SetStringField(TEXT("distribution"), bBlueNoise ? TEXT("blue_noise") : TEXT("random"));
+    ResultObj->SetNumberField(TEXT("seed"), Seed);
+    if (bBlueNoise)
+    {
+        ResultObj->SetNumberField(TEXT("spacing"), BlueNoiseSpacing);
+    }
     ResultObj->SetStringField(TEXT("mesh"), MeshPath);
     return ResultObj;
 }
@@ -357,16 +813,11 @@ TSharedPtr<FJsonObject> FUnrealCompanionFoliageCommands::HandleScatter(const TSh
 
 TSharedPtr<FJsonObject> FUnrealCompanionFoliageCommands::HandleRemove(const TSharedPtr<FJsonObject>& Params)
 {
-    FVector Center(0.0f, 0.0f, 0.0f);
-    if (Params->HasField(TEXT("center")))
-    {
-        Center = FUnrealCompanionCommonUtils::GetVectorFromJson(Params, TEXT("center"));
-    }
-
-    float Radius = 5000.0f;
-    if (Params->HasField(TEXT("radius")))
+    FFoliageRegion Region;
+    FString RegionError;
+    if (!Region.Parse(Params, false, RegionError))
     {
-        Radius = Params->GetNumberField(TEXT("radius"));
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(RegionError);
     }
 
     FString MeshFilter;
@@ -406,23 +857,13 @@ TSharedPtr<FJsonObject> FUnrealCompanionFoliageCommands::HandleRemove(const TSha
             TypesToProcess.Add(Type);
         }
 
-        // Process each type with mutable access via FindOrAddMesh
         for (UFoliageType* Type : TypesToProcess)
         {
-            FFoliageInfo* Info = IFA->FindOrAddMesh(Type);
-            if (!Info) continue;
+            FFoliageInfo* Info = IFA->FindInfo(Type);
+            if (!Info || Info->Instances.Num() == 0) continue;
 
-            // Find instances within radius
             TArray<int32> InstancesToRemove;
-            for (int32 i = 0; i < Info->Instances.Num(); i++)
-            {
-                const FFoliageInstance& Instance = Info->Instances[i];
-                FVector InstanceLocation = FVector(Instance.Location);
-                if (FVector::Dist(InstanceLocation, Center) <= Radius)
-                {
-                    InstancesToRemove.Add(i);
-                }
-            }
+            Region.Find(*Info, InstancesToRemove);
 
             // Remove all matching instances at once
             if (InstancesToRemove.Num() > 0)
@@ -435,6 +876,364 @@ TSharedPtr<FJsonObject> FUnrealCompanionFoliageCommands::HandleRemove(const TSha
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetBoolField(TEXT("success"), true);
+    ResultObj->SetStringField(TEXT("region"), Region.Type);
     ResultObj->SetNumberField(TEXT("instances_removed"), TotalRemoved);
     return ResultObj;
 }
+
+// =============================================================================
+// FOLIAGE EXPORT
+// =============================================================================
+
+TSharedPtr<FJsonObject> FUnrealCompanionFoliageCommands::HandleExport(const TSharedPtr<FJsonObject>& Params)
+{
+    FFoliageRegion Region;
+    FString RegionError;
+    if (!Region.Parse(Params, true, RegionError))
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(RegionError);
+    }
+
+    int32 ChunkSize = DefaultExportChunkInstances;
+    if (Params->TryGetNumberField(TEXT("chunk_size"), ChunkSize))
+    {
+        ChunkSize = FMath::Clamp(ChunkSize, 1, MaxExportChunkInstances);
+    }
+
+    bool bSharedMemory = false;
+    Params->TryGetBoolField(TEXT("shared_memory"), bSharedMemory);
+
+    // Plain request/response clients have no sink: they get every chunk in the reply
+    bool bStream = false;
+    Params->TryGetBoolField(TEXT("stream"), bStream);
+    FUnrealCompanionDeferredResponse::FEventSink EventSink;
+    if (bStream)
+    {
+        EventSink = FUnrealCompanionDeferredResponse::GetEventSink();
+    }
+
+    UWorld* World = GEditor->GetEditorWorldContext().World();
+    if (!World)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
+    }
+
+    FString MeshFilter;
+    UStaticMesh* FilterMesh = nullptr;
+    if (Params->TryGetStringField(TEXT("mesh"), MeshFilter) && !MeshFilter.IsEmpty())
+    {
+        FilterMesh = LoadObject<UStaticMesh>(nullptr, *MeshFilter);
+        if (!FilterMesh)
+        {
+            return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("StaticMesh not found: %s"), *MeshFilter));
+        }
+    }
+
+    // A type can have instances in several foliage actors (one per level or partition cell);
+    // it is listed once and its chunks say which entry of "types" they belong to
+    struct FTypeExport
+    {
+        TSharedPtr<FJsonObject> Json;
+        TArray<TSharedPtr<FJsonValue>> Chunks;
+        int32 Count = 0;
+    };
+    TArray<FTypeExport> Types;
+    TMap<const UFoliageType*, int32> TypeIndices;
+
+    int32 ChunksSent = 0;
+    int32 TotalCount = 0;
+    TArray<FPackedFoliageInstance> Packed;
+    TArray<int32> Indices;
+
+    auto FlushChunk = [&](int32 TypeIndex)
+    {
+        if (Packed.Num() == 0)
+        {
+            return;
+        }
+
+        UNREALCOMPANION_TRACE_SCOPE("FoliageExport.Chunk");
+        const uint8* Bytes = reinterpret_cast<const uint8*>(Packed.GetData());
+        const int32 NumBytes = Packed.Num() * sizeof(FPackedFoliageInstance);
+
+        TSharedPtr<FJsonObject> Chunk = MakeShared<FJsonObject>();
+        Chunk->SetNumberField(TEXT("seq"), ChunksSent++);
+        Chunk->SetNumberField(TEXT("type"), TypeIndex);
+        Chunk->SetNumberField(TEXT("count"), Packed.Num());
+
+        bool bInline = !bSharedMemory;
+        if (bSharedMemory)
+        {
+            FString SharedError;
+            if (TSharedPtr<FJsonObject> Handle = FMCPSharedMemory::Get().Write(Bytes, NumBytes, SharedError))
+            {
+                Chunk->SetObjectField(TEXT("shared_memory"), Handle);
+            }
+            else
+            {
+                Chunk->SetStringField(TEXT("shared_memory_error"), SharedError);
+                bInline = true;
+            }
+        }
+        if (bInline)
+        {
+            Chunk->SetStringField(TEXT("data"), FBase64::Encode(Bytes, (uint32)NumBytes));
+        }
+
+        if (EventSink)
+        {
+            // Events arrive before the reply that lists the types: each one names its own
+            for (const TCHAR* Key : { TEXT("name"), TEXT("mesh"), TEXT("foliage_type") })
+            {
+                if (const TSharedPtr<FJsonValue>* Value = Types[TypeIndex].Json->Values.Find(Key))
+                {
+                    Chunk->SetField(Key, *Value);
+                }
+            }
+            EventSink(TEXT("foliage_chunk"), Chunk);
+        }
+        else
+        {
+            Types[TypeIndex].Chunks.Add(MakeShared<FJsonValueObject>(Chunk));
+        }
+        Packed.Reset();
+    };
+
+    for (TActorIterator<AInstancedFoliageActor> It(World); It; ++It)
+    {
+        AInstancedFoliageActor* IFA = *It;
+        if (!IFA) continue;
+
+        for (const auto& Pair : IFA->GetFoliageInfos())
+        {
+            const UFoliageType* Type = Pair.Key;
+            const UFoliageType_InstancedStaticMesh* ISMType = Cast<UFoliageType_InstancedStaticMesh>(Type);
+            if (FilterMesh && (!ISMType || ISMType->GetStaticMesh() != FilterMesh))
+            {
+                continue;
+            }
+            FFoliageInfo* Info = IFA->FindInfo(Type);
+            if (!Info || Info->Instances.Num() == 0)
+            {
+                continue;
+            }
+
+            Indices.Reset();
+            Region.Find(*Info, Indices);
+            if (Indices.Num() == 0)
+            {
+                continue;
+            }
+            Indices.Sort();
+
+            int32* ExistingIndex = TypeIndices.Find(Type);
+            const int32 TypeIndex = ExistingIndex ? *ExistingIndex : Types.AddDefaulted();
+            if (!ExistingIndex)
+            {
+                TypeIndices.Add(Type, TypeIndex);
+                TSharedPtr<FJsonObject> TypeJson = MakeShared<FJsonObject>();
+                TypeJson->SetStringField(TEXT("name"), Type->GetName());
+                if (ISMType && ISMType->GetStaticMesh())
+                {
+                    TypeJson->SetStringField(TEXT("mesh"), ISMType->GetStaticMesh()->GetPathName());
+                }
+                // Types created by foliage_add_type/scatter live inside the foliage actor; only
+                // asset types can be loaded back by path
+                if (Type->IsAsset())
+                {
+                    TypeJson->SetStringField(TEXT("foliage_type"), Type->GetPathName());
+                }
+                Types[TypeIndex].Json = TypeJson;
+            }
+
+            for (const int32 Index : Indices)
+            {
+                Packed.Add(FPackedFoliageInstance::FromInstance(Info->Instances[Index]));
+                if (Packed.Num() >= ChunkSize)
+                {
+                    FlushChunk(TypeIndex);
+                }
+            }
+            FlushChunk(TypeIndex);
+
+            Types[TypeIndex].Count += Indices.Num();
+            TotalCount += Indices.Num();
+        }
+    }
+
+    TArray<TSharedPtr<FJsonValue>> TypesArray;
+    for (FTypeExport& Type : Types)
+    {
+        Type.Json->SetNumberField(TEXT("count"), Type.Count);
+        if (!EventSink)
+        {
+            Type.Json->SetArrayField(TEXT("chunks"), Type.Chunks);
+        }
+        TypesArray.Add(MakeShared<FJsonValueObject>(Type.Json));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetBoolField(TEXT("success"), true);
+    ResultObj->SetStringField(TEXT("region"), Region.Type);
+    ResultObj->SetNumberField(TEXT("count"), TotalCount);
+    ResultObj->SetStringField(TEXT("layout"), TEXT("location_f64x3_rotation_f32x3_scale_f32x3_le"));
+    ResultObj->SetNumberField(TEXT("stride"), (int32)sizeof(FPackedFoliageInstance));
+    ResultObj->SetArrayField(TEXT("types"), TypesArray);
+    ResultObj->SetNumberField(TEXT("chunks"), ChunksSent);
+    if (EventSink)
+    {
+        ResultObj->SetBoolField(TEXT("streamed"), true);
+    }
+    return ResultObj;
+}
+
+// =============================================================================
+// FOLIAGE IMPORT
+// =============================================================================
+
+TSharedPtr<FJsonObject> FUnrealCompanionFoliageCommands::HandleImport(const TSharedPtr<FJsonObject>& Params)
+{
+    const TArray<TSharedPtr<FJsonValue>>* Entries;
+    if (!Params->TryGetArrayField(TEXT("types"), Entries) || Entries->Num() == 0)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing 'types' parameter ([{mesh or foliage_type, data or transforms}, ...])"));
+    }
+
+    FVector Offset = FVector::ZeroVector;
+    if (Params->HasField(TEXT("offset")))
+    {
+        Offset = FUnrealCompanionCommonUtils::GetVectorFromJson(Params, TEXT("offset"));
+    }
+
+    UWorld* World = GEditor->GetEditorWorldContext().World();
+    if (!World)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
+    }
+
+    // Decode and resolve every entry before touching the level, so a bad entry adds nothing
+    struct FTypeImport
+    {
+        FString MeshPath;
+        UStaticMesh* Mesh = nullptr;
+        UFoliageType* AssetType = nullptr;
+        TArray<FFoliageInstance> Instances;
+    };
+    TArray<FTypeImport> Imports;
+    TArray<FPackedFoliageInstance> Packed;
+    {
+        UNREALCOMPANION_TRACE_SCOPE("FoliageImport.Decode");
+        for (int32 EntryIndex = 0; EntryIndex < Entries->Num(); EntryIndex++)
+        {
+            const TSharedPtr<FJsonObject>* EntryObj;
+            if (!(*Entries)[EntryIndex]->TryGetObject(EntryObj))
+            {
+                return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("types[%d] is not an object"), EntryIndex));
+            }
+            const TSharedPtr<FJsonObject>& Entry = *EntryObj;
+
+            FString DecodeError;
+            if (!DecodeImportedInstances(Entry, Packed, DecodeError))
+            {
+                return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("types[%d]: %s"), EntryIndex, *DecodeError));
+            }
+
+            // An asset foliage type keeps its settings; otherwise the mesh's type in the level
+            // is used, or one with default settings is made for it
+            FTypeImport Import;
+            FString TypePath;
+            if (Entry->TryGetStringField(TEXT("foliage_type"), TypePath) && !TypePath.IsEmpty())
+            {
+                Import.AssetType = LoadObject<UFoliageType>(nullptr, *TypePath);
+            }
+            if (!Import.AssetType)
+            {
+                if (!Entry->TryGetStringField(TEXT("mesh"), Import.MeshPath) || Import.MeshPath.IsEmpty())
+                {
+                    return FUnrealCompanionCommonUtils::CreateErrorResponse(TypePath.IsEmpty()
+                        ? FString::Printf(TEXT("types[%d] needs 'mesh' or 'foliage_type'"), EntryIndex)
+                        : FString::Printf(TEXT("types[%d]: FoliageType not found: %s"), EntryIndex, *TypePath));
+                }
+                Import.Mesh = LoadObject<UStaticMesh>(nullptr, *Import.MeshPath);
+                if (!Import.Mesh)
+                {
+                    return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("types[%d]: StaticMesh not found: %s"), EntryIndex, *Import.MeshPath));
+                }
+            }
+
+            // Chunks of one type can come as separate entries; they still go in together
+            FTypeImport* Target = Imports.FindByPredicate([&](const FTypeImport& Other)
+            {
+                return Import.AssetType ? Other.AssetType == Import.AssetType : (!Other.AssetType && Other.Mesh == Import.Mesh);
+            });
+            if (!Target)
+            {
+                Target = &Imports.Add_GetRef(MoveTemp(Import));
+            }
+
+            const int32 First = Target->Instances.AddDefaulted(Packed.Num());
+            for (int32 Index = 0; Index < Packed.Num(); Index++)
+            {
+                Packed[Index].ToInstance(Offset, Target->Instances[First + Index]);
+            }
+        }
+    }
+
+    AInstancedFoliageActor* IFA = AInstancedFoliageActor::GetInstancedFoliageActorForCurrentLevel(World, true);
+    if (!IFA)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to get InstancedFoliageActor"));
+    }
+
+    TArray<TSharedPtr<FJsonValue>> TypesArray;
+    int32 TotalAdded = 0;
+    for (FTypeImport& Import : Imports)
+    {
+        UFoliageType* FoliageType = Import.AssetType;
+        if (!FoliageType)
+        {
+            UFoliageType_InstancedStaticMesh* MeshType = FindMeshFoliageType(IFA, Import.Mesh);
+            if (!MeshType)
+            {
+                MeshType = NewObject<UFoliageType_InstancedStaticMesh>(IFA);
+                MeshType->SetStaticMesh(Import.Mesh);
+                IFA->AddMesh(MeshType);
+            }
+            FoliageType = MeshType;
+        }
+
+        // One merged call per type: one hash and cluster tree rebuild however many chunks it came in
+        FFoliageInfo* FoliageInfo = IFA->FindOrAddMesh(FoliageType);
+        if (!FoliageInfo)
+        {
+            return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Failed to add foliage type %s"), *FoliageType->GetName()));
+        }
+        if (Import.Instances.Num() > 0)
+        {
+            UNREALCOMPANION_TRACE_SCOPE("FoliageImport.AddInstances");
+            TArray<const FFoliageInstance*> InstancePtrs;
+            InstancePtrs.Reserve(Import.Instances.Num());
+            for (const FFoliageInstance& Inst : Import.Instances)
+            {
+                InstancePtrs.Add(&Inst);
+            }
+            FoliageInfo->AddInstances(FoliageType, InstancePtrs);
+        }
+
+        TSharedPtr<FJsonObject> TypeJson = MakeShared<FJsonObject>();
+        TypeJson->SetStringField(TEXT("name"), FoliageType->GetName());
+        if (!Import.MeshPath.IsEmpty())
+        {
+            TypeJson->SetStringField(TEXT("mesh"), Import.MeshPath);
+        }
+        TypeJson->SetNumberField(TEXT("instances_added"), Import.Instances.Num());
+        TypesArray.Add(MakeShared<FJsonValueObject>(TypeJson));
+        TotalAdded += Import.Instances.Num();
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetBoolField(TEXT("success"), true);
+    ResultObj->SetNumberField(TEXT("instances_added"), TotalAdded);
+    ResultObj->SetArrayField(TEXT("types"), TypesArray);
+    return ResultObj;
+}
@@ -3,30 +3,147 @@
 #include "Editor.h"
 #include "EngineUtils.h"
 #include "Kismet/GameplayStatics.h"
+#include "EditorAssetLibrary.h"
+#include "Engine/StaticMesh.h"
+#include "HAL/PlatformTime.h"
 
 // Geometry Script includes
 #include "GeometryScript/GeometryScriptTypes.h"
 #include "GeometryScript/MeshPrimitiveFunctions.h"
 #include "GeometryScript/MeshBooleanFunctions.h"
+#include "GeometryScript/MeshTransformFunctions.h"
+#include "GeometryScript/MeshBasicEditFunctions.h"
+#include "GeometryScript/MeshAssetFunctions.h"
+#include "GeometryScript/CreateNewAssetUtilityFunctions.h"
 #include "UDynamicMesh.h"
 #include "DynamicMeshActor.h"
 #include "Components/DynamicMeshComponent.h"
 
+// Direct mesh processing for multi-tool booleans, off the game thread
+#include "Async/ParallelFor.h"
+#include "DynamicMesh/DynamicMesh3.h"
+#include "DynamicMesh/MeshTransforms.h"
+#include "DynamicMeshEditor.h"
+#include "Operations/MeshBoolean.h"
+
+using namespace UE::Geometry;
+
+namespace
+{
+    // location / rotation (Pitch, Yaw, Roll) / scale of an op, identity where absent
+    FTransform GetTransformFromJson(const TSharedPtr<FJsonObject>& Params)
+    {
+        FVector Location = FVector::ZeroVector;
+        FRotator Rotation = FRotator::ZeroRotator;
+        FVector Scale = FVector::OneVector;
+        if (Params->HasField(TEXT("location")))
+        {
+            Location = FUnrealCompanionCommonUtils::GetVectorFromJson(Params, TEXT("location"));
+        }
+        if (Params->HasField(TEXT("rotation")))
+        {
+            const FVector RotVec = FUnrealCompanionCommonUtils::GetVectorFromJson(Params, TEXT("rotation"));
+            Rotation = FRotator(RotVec.X, RotVec.Y, RotVec.Z);
+        }
+        if (Params->HasField(TEXT("scale")))
+        {
+            Scale = FUnrealCompanionCommonUtils::GetVectorFromJson(Params, TEXT("scale"));
+        }
+        return FTransform(Rotation, Location, Scale);
+    }
+
+    bool ParseBooleanOperation(const FString& Operation, EGeometryScriptBooleanOperation& OutOp)
+    {
+        if (Operation == TEXT("union"))
+        {
+            OutOp = EGeometryScriptBooleanOperation::Union;
+        }
+        else if (Operation == TEXT("subtract"))
+        {
+            OutOp = EGeometryScriptBooleanOperation::Subtract;
+        }
+        else if (Operation == TEXT("intersection") || Operation == TEXT("intersect"))
+        {
+            OutOp = EGeometryScriptBooleanOperation::Intersection;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    // Greedy grouping of tools whose bounds touch no other member of the group
+    TArray<TArray<int32>> GroupDisjointTools(const TArray<FAxisAlignedBox3d>& Bounds)
+    {
+        TArray<TArray<int32>> Groups;
+        for (int32 Index = 0; Index < Bounds.Num(); ++Index)
+        {
+            TArray<int32>* Home = nullptr;
+            for (TArray<int32>& Group : Groups)
+            {
+                const bool bOverlaps = Group.ContainsByPredicate([&Bounds, Index](int32 Member)
+                {
+                    return Bounds[Member].Intersects(Bounds[Index]);
+                });
+                if (!bOverlaps)
+                {
+                    Home = &Group;
+                    break;
+                }
+            }
+            if (Home)
+            {
+                Home->Add(Index);
+            }
+            else
+            {
+                Groups.Add({ Index });
+            }
+        }
+        return Groups;
+    }
+}
+
 FUnrealCompanionGeometryCommands::FUnrealCompanionGeometryCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealCompanionGeometryCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FUnrealCompanionGeometryCommands::Shutdown()
 {
-    if (CommandType == TEXT("geometry_create"))
+    if (MeshPool.IsValid())
     {
-        return HandleCreatePrimitive(Params);
+        MeshPool->FreeAllMeshes();
+        MeshPool.Reset();
     }
-    else if (CommandType == TEXT("geometry_boolean"))
+}
+
+UDynamicMeshPool* FUnrealCompanionGeometryCommands::GetMeshPool()
+{
+    if (!MeshPool.IsValid())
     {
-        return HandleBoolean(Params);
+        MeshPool.Reset(NewObject<UDynamicMeshPool>());
     }
+    return MeshPool.Get();
+}
+
+TConstArrayView<TMCPCommandEntry<FUnrealCompanionGeometryCommands>> FUnrealCompanionGeometryCommands::GetCommandTable()
+{
+    static constexpr TMCPCommandEntry<FUnrealCompanionGeometryCommands> Table[] = {
+        { TEXT("geometry_create"), &FUnrealCompanionGeometryCommands::HandleCreatePrimitive },
+        { TEXT("geometry_boolean"), &FUnrealCompanionGeometryCommands::HandleBoolean },
+        { TEXT("geometry_pipeline"), &FUnrealCompanionGeometryCommands::HandlePipeline },
+    };
+    static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+    return Table;
+}
 
+TSharedPtr<FJsonObject> FUnrealCompanionGeometryCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    if (TSharedPtr<FJsonObject> Result = UnrealCompanionCommandTable::Dispatch(*this, GetCommandTable(), CommandType, Params))
+    {
+        return Result;
+    }
     return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown geometry command: %s"), *CommandType));
 }
 
@@ -68,17 +185,6 @@ TSharedPtr<FJsonObject> FUnrealCompanionGeometryCommands::HandleCreatePrimitive(
         Scale = FUnrealCompanionCommonUtils::GetVectorFromJson(Params, TEXT("scale"));
     }
 
-    // Dimensions
-    float Width = 100.0f, Height = 100.0f, Depth = 100.0f;
-    float Radius = 50.0f;
-    int32 Segments = 16;
-
-    if (Params->HasField(TEXT("width"))) Width = Params->GetNumberField(TEXT("width"));
-    if (Params->HasField(TEXT("height"))) Height = Params->GetNumberField(TEXT("height"));
-    if (Params->HasField(TEXT("depth"))) Depth = Params->GetNumberField(TEXT("depth"));
-    if (Params->HasField(TEXT("radius"))) Radius = Params->GetNumberField(TEXT("radius"));
-    if (Params->HasField(TEXT("segments"))) Segments = FMath::Clamp((int32)Params->GetNumberField(TEXT("segments")), 3, 256);
-
     UWorld* World = GEditor->GetEditorWorldContext().World();
     if (!World)
     {
@@ -92,59 +198,10 @@ TSharedPtr<FJsonObject> FUnrealCompanionGeometryCommands::HandleCreatePrimitive(
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to create UDynamicMesh"));
     }
 
-    FGeometryScriptPrimitiveOptions Options;
-    Options.PolygroupMode = EGeometryScriptPrimitivePolygroupMode::PerFace;
-    FTransform MeshTransform = FTransform::Identity;
-
-    // Append geometry based on type
-    if (PrimitiveType == TEXT("box"))
+    FString AppendError;
+    if (!AppendPrimitive(DynMesh, PrimitiveType, Params, FTransform::Identity, AppendError))
     {
-        UGeometryScriptLibrary_MeshPrimitiveFunctions::AppendBox(
-            DynMesh, Options, MeshTransform,
-            Width, Height, Depth,
-            0, 0, 0, // StepsX, StepsY, StepsZ
-            EGeometryScriptPrimitiveOriginMode::Center);
-    }
-    else if (PrimitiveType == TEXT("sphere"))
-    {
-        UGeometryScriptLibrary_MeshPrimitiveFunctions::AppendSphereBox(
-            DynMesh, Options, MeshTransform,
-            Radius,
-            Segments, Segments, Segments); // StepsX, StepsY, StepsZ
-    }
-    else if (PrimitiveType == TEXT("cylinder"))
-    {
-        UGeometryScriptLibrary_MeshPrimitiveFunctions::AppendCylinder(
-            DynMesh, Options, MeshTransform,
-            Radius, Height,
-            Segments,  // RadialSteps
-            0,         // HeightSteps
-            true,      // bCapped
-            EGeometryScriptPrimitiveOriginMode::Center);
-    }
-    else if (PrimitiveType == TEXT("cone"))
-    {
-        UGeometryScriptLibrary_MeshPrimitiveFunctions::AppendCone(
-            DynMesh, Options, MeshTransform,
-            Radius,    // BaseRadius
-            0.0f,      // TopRadius = 0 for a proper cone
-            Height,
-            Segments,  // RadialSteps
-            4,         // HeightSteps
-            true,      // bCapped
-            EGeometryScriptPrimitiveOriginMode::Center);
-    }
-    else if (PrimitiveType == TEXT("plane"))
-    {
-        UGeometryScriptLibrary_MeshPrimitiveFunctions::AppendRectangleXY(
-            DynMesh, Options, MeshTransform,
-            Width, Height,
-            0, 0); // StepsWidth, StepsHeight
-    }
-    else
-    {
-        return FUnrealCompanionCommonUtils::CreateErrorResponse(
-            FString::Printf(TEXT("Unknown primitive type: %s. Valid types: box, sphere, cylinder, cone, plane"), *PrimitiveType));
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(AppendError);
     }
 
     // Spawn a DynamicMeshActor
@@ -191,94 +248,489 @@ TSharedPtr<FJsonObject> FUnrealCompanionGeometryCommands::HandleBoolean(const TS
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing 'target_actor' parameter"));
     }
 
+    // tool_actor and tool_actors may be combined; each tool is applied once
+    TArray<FString> ToolNames;
     FString ToolName;
-    if (!Params->TryGetStringField(TEXT("tool_actor"), ToolName))
+    if (Params->TryGetStringField(TEXT("tool_actor"), ToolName))
+    {
+        ToolNames.Add(ToolName);
+    }
+    const TArray<TSharedPtr<FJsonValue>>* ToolArray = nullptr;
+    if (Params->TryGetArrayField(TEXT("tool_actors"), ToolArray))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *ToolArray)
+        {
+            ToolNames.AddUnique(Value->AsString());
+        }
+    }
+    if (ToolNames.Num() == 0)
     {
-        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing 'tool_actor' parameter"));
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing 'tool_actor' or 'tool_actors' parameter"));
     }
 
     FString Operation = TEXT("subtract");
     Params->TryGetStringField(TEXT("operation"), Operation);
     Operation = Operation.ToLower();
 
+    EGeometryScriptBooleanOperation BoolOp;
+    if (!ParseBooleanOperation(Operation, BoolOp))
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(
+            FString::Printf(TEXT("Unknown boolean operation: %s. Valid: union, subtract, intersection"), *Operation));
+    }
+
     bool bDeleteTool = true;
     if (Params->HasField(TEXT("delete_tool")))
     {
         bDeleteTool = Params->GetBoolField(TEXT("delete_tool"));
     }
 
-    // Find both actors
+    // Find all actors before touching anything
     ADynamicMeshActor* TargetActor = FindDynamicMeshActorByName(TargetName);
     if (!TargetActor)
     {
         return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Target DynamicMeshActor not found: %s"), *TargetName));
     }
 
-    ADynamicMeshActor* ToolActor = FindDynamicMeshActorByName(ToolName);
-    if (!ToolActor)
+    UDynamicMeshComponent* TargetComp = TargetActor->GetDynamicMeshComponent();
+    UDynamicMesh* TargetMesh = TargetComp ? TargetComp->GetDynamicMesh() : nullptr;
+    if (!TargetMesh)
     {
-        return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Tool DynamicMeshActor not found: %s"), *ToolName));
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Target actor has no DynamicMesh"));
     }
 
-    UDynamicMeshComponent* TargetComp = TargetActor->GetDynamicMeshComponent();
-    UDynamicMeshComponent* ToolComp = ToolActor->GetDynamicMeshComponent();
-    if (!TargetComp || !ToolComp)
+    TArray<ADynamicMeshActor*> ToolActors;
+    TArray<FString> Missing;
+    for (const FString& Name : ToolNames)
     {
-        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("One or both actors have no DynamicMeshComponent"));
+        ADynamicMeshActor* ToolActor = FindDynamicMeshActorByName(Name);
+        UDynamicMeshComponent* ToolComp = ToolActor ? ToolActor->GetDynamicMeshComponent() : nullptr;
+        if (!ToolComp || !ToolComp->GetDynamicMesh())
+        {
+            Missing.Add(Name);
+        }
+        else if (ToolActor == TargetActor)
+        {
+            return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Tool %s is the target actor"), *Name));
+        }
+        else
+        {
+            ToolActors.AddUnique(ToolActor);
+        }
     }
-
-    UDynamicMesh* TargetMesh = TargetComp->GetDynamicMesh();
-    UDynamicMesh* ToolMesh = ToolComp->GetDynamicMesh();
-    if (!TargetMesh || !ToolMesh)
+    if (Missing.Num() > 0)
     {
-        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("One or both actors have no DynamicMesh"));
+        return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+            TEXT("TOOL_NOT_FOUND"),
+            FString::Printf(TEXT("Tool DynamicMeshActor not found: %s"), *FString::Join(Missing, TEXT(", "))));
     }
 
-    // Determine operation type
-    EGeometryScriptBooleanOperation BoolOp;
-    if (Operation == TEXT("union"))
+    const double StartTime = FPlatformTime::Seconds();
+    double PhaseStart = StartTime;
+    TSharedPtr<FJsonObject> Timings = MakeShared<FJsonObject>();
+    auto EndPhase = [&Timings, &PhaseStart](const TCHAR* Phase)
     {
-        BoolOp = EGeometryScriptBooleanOperation::Union;
-    }
-    else if (Operation == TEXT("subtract"))
+        const double Now = FPlatformTime::Seconds();
+        Timings->SetNumberField(Phase, (Now - PhaseStart) * 1000.0);
+        PhaseStart = Now;
+    };
+
+    // Gather: copy the tool meshes out of their UObjects on the game thread
+    const FTransformSRT3d TargetTransform(TargetActor->GetActorTransform());
+    TArray<FDynamicMesh3> Tools;
+    TArray<FTransformSRT3d> ToolTransforms;
+    Tools.SetNum(ToolActors.Num());
+    for (int32 Index = 0; Index < ToolActors.Num(); ++Index)
     {
-        BoolOp = EGeometryScriptBooleanOperation::Subtract;
+        ToolActors[Index]->GetDynamicMeshComponent()->GetDynamicMesh()->ProcessMesh(
+            [&Tools, Index](const FDynamicMesh3& Mesh) { Tools[Index] = Mesh; });
+        ToolTransforms.Add(FTransformSRT3d(ToolActors[Index]->GetActorTransform()));
     }
-    else if (Operation == TEXT("intersection") || Operation == TEXT("intersect"))
+    EndPhase(TEXT("gather_ms"));
+
+    // Prepare: bring every tool into the target's local space
+    TArray<FAxisAlignedBox3d> Bounds;
+    Bounds.SetNum(Tools.Num());
+    ParallelFor(Tools.Num(), [&Tools, &ToolTransforms, &Bounds, &TargetTransform](int32 Index)
+    {
+        MeshTransforms::ApplyTransform(Tools[Index], ToolTransforms[Index], true);
+        MeshTransforms::ApplyTransformInverse(Tools[Index], TargetTransform, true);
+        Bounds[Index] = Tools[Index].GetBounds(true);
+    });
+    EndPhase(TEXT("prepare_ms"));
+
+    // Group: tools that touch no other tool of their group share one pass. Not for
+    // intersection, where A n (B u C) is not A n B n C.
+    const bool bIntersection = BoolOp == EGeometryScriptBooleanOperation::Intersection;
+    TArray<TArray<int32>> Groups;
+    if (bIntersection)
     {
-        BoolOp = EGeometryScriptBooleanOperation::Intersection;
+        for (int32 Index = 0; Index < Tools.Num(); ++Index)
+        {
+            Groups.Add({ Index });
+        }
     }
     else
     {
-        return FUnrealCompanionCommonUtils::CreateErrorResponse(
-            FString::Printf(TEXT("Unknown boolean operation: %s. Valid: union, subtract, intersection"), *Operation));
+        Groups = GroupDisjointTools(Bounds);
+    }
+
+    TArray<FDynamicMesh3> Passes;
+    Passes.SetNum(Groups.Num());
+    ParallelFor(Groups.Num(), [&Groups, &Tools, &Passes](int32 GroupIndex)
+    {
+        const TArray<int32>& Members = Groups[GroupIndex];
+        Passes[GroupIndex] = MoveTemp(Tools[Members[0]]);
+        FDynamicMeshEditor Editor(&Passes[GroupIndex]);
+        for (int32 Member = 1; Member < Members.Num(); ++Member)
+        {
+            FMeshIndexMappings Mappings;
+            Editor.AppendMesh(&Tools[Members[Member]], Mappings);
+        }
+    });
+    Tools.Empty();
+    EndPhase(TEXT("group_ms"));
+
+    // Reduce: fold the passes pairwise into one tool (union, or intersection);
+    // the pairs of a level do not depend on each other
+    const FMeshBoolean::EBooleanOp ReduceOp = bIntersection ? FMeshBoolean::EBooleanOp::Intersect : FMeshBoolean::EBooleanOp::Union;
+    int32 ReduceBooleans = 0;
+    int32 ReduceWarnings = 0;
+    while (Passes.Num() > 1)
+    {
+        const int32 NumPairs = Passes.Num() / 2;
+        TArray<FDynamicMesh3> Next;
+        Next.SetNum(NumPairs + Passes.Num() % 2);
+        TArray<bool> PairOk;
+        PairOk.Init(true, NumPairs);
+
+        ParallelFor(NumPairs, [&Passes, &Next, &PairOk, ReduceOp](int32 Pair)
+        {
+            FMeshBoolean Boolean(
+                &Passes[Pair * 2], FTransformSRT3d::Identity(),
+                &Passes[Pair * 2 + 1], FTransformSRT3d::Identity(),
+                &Next[Pair], ReduceOp);
+            Boolean.bPutResultInInputSpace = true;
+            PairOk[Pair] = Boolean.Compute();
+        });
+
+        if (Passes.Num() % 2 == 1)
+        {
+            Next.Last() = MoveTemp(Passes.Last());
+        }
+        ReduceBooleans += NumPairs;
+        for (bool bOk : PairOk)
+        {
+            ReduceWarnings += bOk ? 0 : 1;
+        }
+        Passes = MoveTemp(Next);
     }
+    EndPhase(TEXT("reduce_ms"));
+
+    // Apply: a single boolean into the target, so it is rebuilt once
+    UDynamicMeshPool* Pool = GetMeshPool();
+    UDynamicMesh* CombinedTool = Pool->RequestMesh();
+    CombinedTool->SetMesh(MoveTemp(Passes[0]));
 
     FGeometryScriptMeshBooleanOptions BoolOptions;
     BoolOptions.bFillHoles = true;
     BoolOptions.bSimplifyOutput = false;
 
+    // Both meshes are in the target's local space now
     UGeometryScriptLibrary_MeshBooleanFunctions::ApplyMeshBoolean(
         TargetMesh,
-        TargetActor->GetActorTransform(),
-        ToolMesh,
-        ToolActor->GetActorTransform(),
+        FTransform::Identity,
+        CombinedTool,
+        FTransform::Identity,
         BoolOp,
         BoolOptions);
+    Pool->ReturnMesh(CombinedTool);
 
     TargetActor->PostEditChange();
+    EndPhase(TEXT("apply_ms"));
 
-    // Optionally delete the tool actor
+    // Optionally delete the tool actors
     if (bDeleteTool)
     {
-        ToolActor->Destroy();
+        for (ADynamicMeshActor* ToolActor : ToolActors)
+        {
+            ToolActor->Destroy();
+        }
     }
 
+    Timings->SetNumberField(TEXT("total_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetBoolField(TEXT("success"), true);
     ResultObj->SetStringField(TEXT("operation"), Operation);
     ResultObj->SetStringField(TEXT("target_actor"), TargetName);
     ResultObj->SetBoolField(TEXT("tool_deleted"), bDeleteTool);
+    ResultObj->SetNumberField(TEXT("tool_count"), ToolActors.Num());
+    ResultObj->SetNumberField(TEXT("passes"), Groups.Num());
+    ResultObj->SetNumberField(TEXT("reduce_booleans"), ReduceBooleans);
+    if (ReduceWarnings > 0)
+    {
+        ResultObj->SetNumberField(TEXT("reduce_warnings"), ReduceWarnings);
+    }
+    ResultObj->SetNumberField(TEXT("triangle_count"), TargetMesh->GetTriangleCount());
+    ResultObj->SetObjectField(TEXT("timings"), Timings);
+    return ResultObj;
+}
+
+// =============================================================================
+// GEOMETRY PIPELINE
+// =============================================================================
+
+TSharedPtr<FJsonObject> FUnrealCompanionGeometryCommands::HandlePipeline(const TSharedPtr<FJsonObject>& Params)
+{
+    const TArray<TSharedPtr<FJsonValue>>* Operations = nullptr;
+    if (!Params->TryGetArrayField(TEXT("operations"), Operations) || Operations->Num() == 0)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+            TEXT("MISSING_OPERATIONS"),
+            TEXT("Missing or empty 'operations' array"),
+            TEXT("Pass e.g. [{\"op\": \"box\", \"width\": 200}, {\"op\": \"sphere\", \"mesh\": \"cut\", \"radius\": 80}, {\"op\": \"boolean\", \"tool\": \"cut\"}]"));
+    }
+
+    FString TargetActorName;
+    Params->TryGetStringField(TEXT("actor"), TargetActorName);
+    FString StaticMeshPath;
+    Params->TryGetStringField(TEXT("static_mesh_path"), StaticMeshPath);
+    bool bSpawnActor = true;
+    Params->TryGetBoolField(TEXT("spawn_actor"), bSpawnActor);
+
+    if (TargetActorName.IsEmpty() && !bSpawnActor && StaticMeshPath.IsEmpty())
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+            TEXT("NOTHING_TO_COMMIT"),
+            TEXT("With spawn_actor=false the pipeline needs 'actor' or 'static_mesh_path'"));
+    }
+
+    UWorld* World = GEditor->GetEditorWorldContext().World();
+    if (!World)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
+    }
+
+    // Resolve the target before doing any work
+    ADynamicMeshActor* TargetActor = nullptr;
+    if (!TargetActorName.IsEmpty())
+    {
+        TargetActor = FindDynamicMeshActorByName(TargetActorName);
+        if (!TargetActor || !TargetActor->GetDynamicMeshComponent())
+        {
+            return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+                TEXT("ACTOR_NOT_FOUND"),
+                FString::Printf(TEXT("Target DynamicMeshActor not found: %s"), *TargetActorName));
+        }
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    UDynamicMeshPool* Pool = GetMeshPool();
+
+    // Named working meshes; none of them is bound to a component, so edits only touch mesh data
+    TMap<FString, UDynamicMesh*> Meshes;
+    auto FindMesh = [&Meshes](const FString& Slot) -> UDynamicMesh*
+    {
+        UDynamicMesh* const* Found = Meshes.Find(Slot);
+        return Found ? *Found : nullptr;
+    };
+    auto FindOrAddMesh = [&Meshes, Pool](const FString& Slot) -> UDynamicMesh*
+    {
+        if (UDynamicMesh* const* Found = Meshes.Find(Slot))
+        {
+            return *Found;
+        }
+        return Meshes.Add(Slot, Pool->RequestMesh());
+    };
+    auto Fail = [Pool](int32 OpIndex, const FString& Message)
+    {
+        Pool->ReturnAllMeshes();
+        TSharedPtr<FJsonObject> Error = FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+            TEXT("PIPELINE_OP_FAILED"),
+            FString::Printf(TEXT("Operation %d: %s"), OpIndex, *Message));
+        Error->SetNumberField(TEXT("failed_op"), OpIndex);
+        return Error;
+    };
+
+    FGeometryScriptMeshBooleanOptions BoolOptions;
+    BoolOptions.bFillHoles = true;
+    BoolOptions.bSimplifyOutput = false;
+
+    FString LastSlot = TEXT("main");
+    for (int32 OpIndex = 0; OpIndex < Operations->Num(); ++OpIndex)
+    {
+        const TSharedPtr<FJsonObject>* OpObjPtr = nullptr;
+        if (!(*Operations)[OpIndex]->TryGetObject(OpObjPtr))
+        {
+            return Fail(OpIndex, TEXT("not an object"));
+        }
+        const TSharedPtr<FJsonObject>& OpObj = *OpObjPtr;
+
+        FString Op;
+        if (!OpObj->TryGetStringField(TEXT("op"), Op))
+        {
+            return Fail(OpIndex, TEXT("missing 'op'"));
+        }
+        Op = Op.ToLower();
+
+        FString Slot = TEXT("main");
+        OpObj->TryGetStringField(TEXT("mesh"), Slot);
+
+        bool bKeep = false;
+        OpObj->TryGetBoolField(TEXT("keep"), bKeep);
+
+        if (Op == TEXT("boolean"))
+        {
+            FString ToolSlot;
+            OpObj->TryGetStringField(TEXT("tool"), ToolSlot);
+            UDynamicMesh* TargetMesh = FindMesh(Slot);
+            UDynamicMesh* ToolMesh = FindMesh(ToolSlot);
+            if (!TargetMesh || !ToolMesh || TargetMesh == ToolMesh)
+            {
+                return Fail(OpIndex, FString::Printf(TEXT("boolean needs two different existing meshes (mesh '%s', tool '%s')"), *Slot, *ToolSlot));
+            }
+
+            FString Operation = TEXT("subtract");
+            OpObj->TryGetStringField(TEXT("operation"), Operation);
+            EGeometryScriptBooleanOperation BoolOp;
+            if (!ParseBooleanOperation(Operation.ToLower(), BoolOp))
+            {
+                return Fail(OpIndex, FString::Printf(TEXT("unknown boolean operation '%s' (union, subtract, intersection)"), *Operation));
+            }
+
+            // The op's own transform places the tool relative to the target
+            UGeometryScriptLibrary_MeshBooleanFunctions::ApplyMeshBoolean(
+                TargetMesh, FTransform::Identity, ToolMesh, GetTransformFromJson(OpObj), BoolOp, BoolOptions);
+
+            if (!bKeep)
+            {
+                Pool->ReturnMesh(ToolMesh);
+                Meshes.Remove(ToolSlot);
+            }
+        }
+        else if (Op == TEXT("append"))
+        {
+            FString SourceSlot;
+            OpObj->TryGetStringField(TEXT("source"), SourceSlot);
+            UDynamicMesh* SourceMesh = FindMesh(SourceSlot);
+            if (!SourceMesh || SourceSlot == Slot)
+            {
+                return Fail(OpIndex, FString::Printf(TEXT("append needs an existing 'source' other than '%s'"), *Slot));
+            }
+
+            UGeometryScriptLibrary_MeshBasicEditFunctions::AppendMesh(
+                FindOrAddMesh(Slot), SourceMesh, GetTransformFromJson(OpObj));
+
+            if (!bKeep)
+            {
+                Pool->ReturnMesh(SourceMesh);
+                Meshes.Remove(SourceSlot);
+            }
+        }
+        else if (Op == TEXT("transform"))
+        {
+            UDynamicMesh* TargetMesh = FindMesh(Slot);
+            if (!TargetMesh)
+            {
+                return Fail(OpIndex, FString::Printf(TEXT("unknown mesh '%s'"), *Slot));
+            }
+            UGeometryScriptLibrary_MeshTransformFunctions::TransformMesh(TargetMesh, GetTransformFromJson(OpObj));
+        }
+        else
+        {
+            FString AppendError;
+            if (!AppendPrimitive(FindOrAddMesh(Slot), Op, OpObj, GetTransformFromJson(OpObj), AppendError))
+            {
+                return Fail(OpIndex, AppendError + TEXT(", boolean, append, transform"));
+            }
+        }
+
+        LastSlot = Slot;
+    }
+
+    FString OutputSlot = LastSlot;
+    Params->TryGetStringField(TEXT("output"), OutputSlot);
+    UDynamicMesh* OutputMesh = FindMesh(OutputSlot);
+    if (!OutputMesh)
+    {
+        return Fail(Operations->Num(), FString::Printf(TEXT("output mesh '%s' does not exist"), *OutputSlot));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetBoolField(TEXT("success"), true);
+    ResultObj->SetNumberField(TEXT("operations"), Operations->Num());
+    ResultObj->SetStringField(TEXT("output"), OutputSlot);
+    ResultObj->SetNumberField(TEXT("triangle_count"), OutputMesh->GetTriangleCount());
+    ResultObj->SetNumberField(TEXT("vertex_count"), OutputMesh->GetMeshRef().VertexCount());
+
+    // Asset first: if it fails, nothing has been spawned yet
+    if (!StaticMeshPath.IsEmpty())
+    {
+        EGeometryScriptOutcomePins Outcome = EGeometryScriptOutcomePins::Failure;
+        bool bCreated = false;
+        if (UStaticMesh* Existing = Cast<UStaticMesh>(UEditorAssetLibrary::LoadAsset(StaticMeshPath)))
+        {
+            UGeometryScriptLibrary_StaticMeshFunctions::CopyMeshToStaticMesh(
+                OutputMesh, Existing, FGeometryScriptCopyMeshToAssetOptions(), FGeometryScriptMeshWriteLOD(), Outcome);
+            Existing->MarkPackageDirty();
+        }
+        else
+        {
+            UGeometryScriptLibrary_CreateNewAssetFunctions::CreateNewStaticMeshAssetFromMesh(
+                OutputMesh, StaticMeshPath, FGeometryScriptCreateNewStaticMeshAssetOptions(), Outcome);
+            bCreated = true;
+        }
+
+        if (Outcome != EGeometryScriptOutcomePins::Success)
+        {
+            Pool->ReturnAllMeshes();
+            return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+                TEXT("STATIC_MESH_FAILED"),
+                FString::Printf(TEXT("Failed to write static mesh %s"), *StaticMeshPath));
+        }
+        ResultObj->SetStringField(TEXT("static_mesh"), StaticMeshPath);
+        ResultObj->SetBoolField(TEXT("static_mesh_created"), bCreated);
+    }
+
+    ADynamicMeshActor* Actor = TargetActor;
+    if (!Actor && bSpawnActor)
+    {
+        const FTransform ActorTransform = GetTransformFromJson(Params);
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        Actor = World->SpawnActor<ADynamicMeshActor>(
+            ADynamicMeshActor::StaticClass(), ActorTransform.GetLocation(), ActorTransform.Rotator(), SpawnParams);
+        if (!Actor)
+        {
+            Pool->ReturnAllMeshes();
+            return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to spawn DynamicMeshActor"));
+        }
+
+        FString Name = TEXT("GeometryActor");
+        Params->TryGetStringField(TEXT("name"), Name);
+        Actor->SetActorLabel(Name);
+        Actor->SetActorScale3D(ActorTransform.GetScale3D());
+    }
+
+    if (Actor)
+    {
+        // The only edit that reaches a component: one render/collision rebuild.
+        // Copying keeps the pooled mesh's buffers for the next pipeline.
+        UDynamicMeshComponent* DMComp = Actor->GetDynamicMeshComponent();
+        if (DMComp && DMComp->GetDynamicMesh())
+        {
+            DMComp->GetDynamicMesh()->SetMesh(OutputMesh->GetMeshRef());
+        }
+        Actor->PostEditChange();
+
+        ResultObj->SetStringField(TEXT("actor_name"), Actor->GetName());
+        ResultObj->SetStringField(TEXT("actor_label"), Actor->GetActorLabel());
+    }
+
+    Pool->ReturnAllMeshes();
+    ResultObj->SetNumberField(TEXT("pipeline_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
     return ResultObj;
 }
 
@@ -286,6 +738,74 @@ TSharedPtr<FJsonObject> FUnrealCompanionGeometryCommands::HandleBoolean(const TS
 // UTILITY
 // =============================================================================
 
+bool FUnrealCompanionGeometryCommands::AppendPrimitive(UDynamicMesh* Mesh, const FString& Type, const TSharedPtr<FJsonObject>& Params, const FTransform& Transform, FString& OutError)
+{
+    // Dimensions
+    float Width = 100.0f, Height = 100.0f, Depth = 100.0f;
+    float Radius = 50.0f;
+    int32 Segments = 16;
+
+    if (Params->HasField(TEXT("width"))) Width = Params->GetNumberField(TEXT("width"));
+    if (Params->HasField(TEXT("height"))) Height = Params->GetNumberField(TEXT("height"));
+    if (Params->HasField(TEXT("depth"))) Depth = Params->GetNumberField(TEXT("depth"));
+    if (Params->HasField(TEXT("radius"))) Radius = Params->GetNumberField(TEXT("radius"));
+    if (Params->HasField(TEXT("segments"))) Segments = FMath::Clamp((int32)Params->GetNumberField(TEXT("segments")), 3, 256);
+
+    FGeometryScriptPrimitiveOptions Options;
+    Options.PolygroupMode = EGeometryScriptPrimitivePolygroupMode::PerFace;
+
+    if (Type == TEXT("box"))
+    {
+        UGeometryScriptLibrary_MeshPrimitiveFunctions::AppendBox(
+            Mesh, Options, Transform,
+            Width, Height, Depth,
+            0, 0, 0, // StepsX, StepsY, StepsZ
+            EGeometryScriptPrimitiveOriginMode::Center);
+    }
+    else if (Type == TEXT("sphere"))
+    {
+        UGeometryScriptLibrary_MeshPrimitiveFunctions::AppendSphereBox(
+            Mesh, Options, Transform,
+            Radius,
+            Segments, Segments, Segments); // StepsX, StepsY, StepsZ
+    }
+    else if (Type == TEXT("cylinder"))
+    {
+        UGeometryScriptLibrary_MeshPrimitiveFunctions::AppendCylinder(
+            Mesh, Options, Transform,
+            Radius, Height,
+            Segments,  // RadialSteps
+            0,         // HeightSteps
+            true,      // bCapped
+            EGeometryScriptPrimitiveOriginMode::Center);
+    }
+    else if (Type == TEXT("cone"))
+    {
+        UGeometryScriptLibrary_MeshPrimitiveFunctions::AppendCone(
+            Mesh, Options, Transform,
+            Radius,    // BaseRadius
+            0.0f,      // TopRadius = 0 for a proper cone
+            Height,
+            Segments,  // RadialSteps
+            4,         // HeightSteps
+            true,      // bCapped
+            EGeometryScriptPrimitiveOriginMode::Center);
+    }
+    else if (Type == TEXT("plane"))
+    {
+        UGeometryScriptLibrary_MeshPrimitiveFunctions::AppendRectangleXY(
+            Mesh, Options, Transform,
+            Width, Height,
+            0, 0); // StepsWidth, StepsHeight
+    }
+    else
+    {
+        OutError = FString::Printf(TEXT("Unknown primitive type: %s. Valid types: box, sphere, cylinder, cone, plane"), *Type);
+        return false;
+    }
+    return true;
+}
+
 ADynamicMeshActor* FUnrealCompanionGeometryCommands::FindDynamicMeshActorByName(const FString& ActorName)
 {
     UWorld* World = GEditor->GetEditorWorldContext().World();
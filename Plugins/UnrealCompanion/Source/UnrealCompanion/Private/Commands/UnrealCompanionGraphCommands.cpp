@@ -2,7 +2,11 @@
 
 #include "Commands/UnrealCompanionGraphCommands.h"
 #include "Commands/UnrealCompanionCommonUtils.h"
+#include "MCPResponseWriter.h"
+#include "UnrealCompanionStats.h"
+#include "Graph/GraphLayout.h"
 #include "Graph/GraphOperations.h"
+#include "Graph/GraphRevision.h"
 #include "Graph/NodeOperations.h"
 #include "Graph/PinOperations.h"
 #include "Graph/NodeFactory/INodeFactory.h"
@@ -24,38 +28,85 @@
 #include "K2Node_CallFunction.h"
 #include "K2Node_VariableGet.h"
 #include "K2Node_VariableSet.h"
+#include "AnimGraphNode_StateMachine.h"
+#include "AnimStateNodeBase.h"
+#include "ScopedTransaction.h"
 #include "Commands/UnrealCompanionEditorFocus.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogUnrealCompanionGraphCommands, Log, All);
 
 // =========================================================================
-// CONSTRUCTOR
+// PARAM SCHEMAS
 // =========================================================================
 
-FUnrealCompanionGraphCommands::FUnrealCompanionGraphCommands()
+namespace
 {
+    /** asset_name (or blueprint_name), graph_name, graph_type */
+    template <typename ParamsType>
+    TMCPParamSchema<ParamsType> MakeGraphTargetSchema()
+    {
+        TMCPParamSchema<ParamsType> Schema;
+        Schema.Required(TEXT("asset_name"), &FMCPGraphTargetParams::AssetName).Alias(TEXT("blueprint_name"))
+            .Optional(TEXT("graph_name"), &FMCPGraphTargetParams::GraphName)
+            .Optional(TEXT("graph_type"), &FMCPGraphTargetParams::GraphType);
+        return Schema;
+    }
 }
 
-void FUnrealCompanionGraphCommands::InitializeFactories()
+const TMCPParamSchema<FMCPGraphNodeFindParams>& FMCPGraphNodeFindParams::Schema()
 {
-    if (bFactoriesInitialized) return;
+    static const TMCPParamSchema<FMCPGraphNodeFindParams> Instance = MakeGraphTargetSchema<FMCPGraphNodeFindParams>()
+        .Optional(TEXT("node_type"), &FMCPGraphNodeFindParams::NodeType)
+            .OneOf({ TEXT("event"), TEXT("custom_event"), TEXT("function_call"), TEXT("get_variable"), TEXT("set_variable") })
+        .Optional(TEXT("class_name"), &FMCPGraphNodeFindParams::ClassName)
+        .Optional(TEXT("variable_name"), &FMCPGraphNodeFindParams::VariableName)
+        .Optional(TEXT("event_name"), &FMCPGraphNodeFindParams::EventName)
+        .Optional(TEXT("function_name"), &FMCPGraphNodeFindParams::FunctionName)
+        .Optional(TEXT("only_unconnected"), &FMCPGraphNodeFindParams::bOnlyUnconnected)
+        .Optional(TEXT("only_pure"), &FMCPGraphNodeFindParams::bOnlyPure)
+        .Optional(TEXT("only_impure"), &FMCPGraphNodeFindParams::bOnlyImpure)
+        .Optional(TEXT("since_revision"), &FMCPGraphNodeFindParams::SinceRevision);
+    return Instance;
+}
 
-    // Register K2 (Blueprint) factory
-    Factories.Add(UnrealCompanionGraph::EGraphType::Blueprint, MakeShared<FK2NodeFactory>());
-    
-    // Widget blueprints use K2 nodes too
-    Factories.Add(UnrealCompanionGraph::EGraphType::Widget, MakeShared<FK2NodeFactory>());
+const TMCPParamSchema<FMCPGraphBatchParams>& FMCPGraphBatchParams::Schema()
+{
+    static const TMCPParamSchema<FMCPGraphBatchParams> Instance = MakeGraphTargetSchema<FMCPGraphBatchParams>()
+        .WithStandardParams()
+        .Validate([](FMCPGraphBatchParams& Parsed, FString& OutError)
+        {
+            TSharedRef<FGraphBatchValidation> Validation = MakeShared<FGraphBatchValidation>(
+                FGraphBatchValidation::Run(Parsed.Raw, Parsed.AssetName, Parsed.GraphType));
+            Parsed.Validation = Validation;
 
-    // Material factory
-    Factories.Add(UnrealCompanionGraph::EGraphType::Material, MakeShared<FMaterialNodeFactory>());
+            // A dry run reports the errors; "continue" still applies the operations that work
+            if (Validation->IsValid() || Parsed.Standard.bDryRun
+                || UnrealCompanionGraph::ParseErrorStrategy(Parsed.Standard.OnError) == UnrealCompanionGraph::EErrorStrategy::Continue)
+            {
+                return true;
+            }
+            OutError = FString::Printf(TEXT("graph_batch failed validation (%d errors): %s"), Validation->Errors.Num(), *Validation->Summarize());
+            return false;
+        });
+    return Instance;
+}
 
-    // Animation Blueprint factory
-    Factories.Add(UnrealCompanionGraph::EGraphType::Animation, MakeShared<FAnimationNodeFactory>());
+const TMCPParamSchema<FMCPGraphNodeInfoParams>& FMCPGraphNodeInfoParams::Schema()
+{
+    static const TMCPParamSchema<FMCPGraphNodeInfoParams> Instance = MakeGraphTargetSchema<FMCPGraphNodeInfoParams>()
+        .Required(TEXT("node_id"), &FMCPGraphNodeInfoParams::NodeId)
+        .Optional(TEXT("since_revision"), &FMCPGraphNodeInfoParams::SinceRevision);
+    return Instance;
+}
 
-    // Niagara factory
-    Factories.Add(UnrealCompanionGraph::EGraphType::Niagara, MakeShared<FNiagaraNodeFactory>());
+// =========================================================================
+// CONSTRUCTOR
+// =========================================================================
 
-    bFactoriesInitialized = true;
+FUnrealCompanionGraphCommands::FUnrealCompanionGraphCommands()
+{
+    // The bridge registers them at startup; this covers use without a running bridge
+    FNodeFactoryRegistry::Get().RegisterBuiltInFactories();
 }
 
 // =========================================================================
@@ -64,48 +115,38 @@ void FUnrealCompanionGraphCommands::InitializeFactories()
 
 bool FUnrealCompanionGraphCommands::SupportsCommand(const FString& CommandType) const
 {
-    static TSet<FString> SupportedCommands = {
-        TEXT("graph_batch"),
-        TEXT("graph_node_create"),
-        TEXT("graph_node_delete"),
-        TEXT("graph_node_find"),
-        TEXT("graph_node_info"),
-        TEXT("graph_pin_connect"),
-        TEXT("graph_pin_disconnect"),
-        TEXT("graph_pin_set_value")
-    };
+    for (const TMCPCommandEntry<FUnrealCompanionGraphCommands>& Entry : GetCommandTable())
+    {
+        if (CommandType == Entry.Name)
+        {
+            return true;
+        }
+    }
+    return false;
+}
 
-    return SupportedCommands.Contains(CommandType);
+TConstArrayView<TMCPCommandEntry<FUnrealCompanionGraphCommands>> FUnrealCompanionGraphCommands::GetCommandTable()
+{
+    static constexpr TMCPCommandEntry<FUnrealCompanionGraphCommands> Table[] = {
+        { TEXT("graph_batch"), &FUnrealCompanionGraphCommands::HandleGraphBatch },
+        { TEXT("graph_node_create"), &FUnrealCompanionGraphCommands::HandleNodeCreate },
+        { TEXT("graph_node_delete"), &FUnrealCompanionGraphCommands::HandleNodeDelete },
+        { TEXT("graph_node_find"), &FUnrealCompanionGraphCommands::HandleNodeFind },
+        { TEXT("graph_node_info"), &FUnrealCompanionGraphCommands::HandleNodeInfo },
+        { TEXT("graph_pin_connect"), &FUnrealCompanionGraphCommands::HandlePinConnect },
+        { TEXT("graph_pin_disconnect"), &FUnrealCompanionGraphCommands::HandlePinDisconnect },
+        { TEXT("graph_pin_set_value"), &FUnrealCompanionGraphCommands::HandlePinSetValue },
+    };
+    static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+    return Table;
 }
 
 TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-    InitializeFactories();
-
-    if (CommandType == TEXT("graph_batch"))
-        return HandleGraphBatch(Params);
-
-    if (CommandType == TEXT("graph_node_create"))
-        return HandleNodeCreate(Params);
-
-    if (CommandType == TEXT("graph_node_delete"))
-        return HandleNodeDelete(Params);
-
-    if (CommandType == TEXT("graph_node_find"))
-        return HandleNodeFind(Params);
-
-    if (CommandType == TEXT("graph_node_info"))
-        return HandleNodeInfo(Params);
-
-    if (CommandType == TEXT("graph_pin_connect"))
-        return HandlePinConnect(Params);
-
-    if (CommandType == TEXT("graph_pin_disconnect"))
-        return HandlePinDisconnect(Params);
-
-    if (CommandType == TEXT("graph_pin_set_value"))
-        return HandlePinSetValue(Params);
-
+    if (TSharedPtr<FJsonObject> Result = UnrealCompanionCommandTable::Dispatch(*this, GetCommandTable(), CommandType, Params))
+    {
+        return Result;
+    }
     return CreateErrorResponse(FString::Printf(TEXT("Unknown command: %s"), *CommandType));
 }
 
@@ -115,11 +156,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleCommand(const FStri
 
 TSharedPtr<INodeFactory> FUnrealCompanionGraphCommands::GetFactory(UnrealCompanionGraph::EGraphType GraphType)
 {
-    if (TSharedPtr<INodeFactory>* Factory = Factories.Find(GraphType))
-    {
-        return *Factory;
-    }
-    return nullptr;
+    return FNodeFactoryRegistry::Get().GetFactory(GraphType);
 }
 
 bool FUnrealCompanionGraphCommands::ResolveAssetAndGraph(
@@ -130,12 +167,25 @@ bool FUnrealCompanionGraphCommands::ResolveAssetAndGraph(
     FString& OutError)
 {
     // Get asset name (try multiple parameter names for flexibility)
-    FString AssetName;
-    if (!Params->TryGetStringField(TEXT("asset_name"), AssetName))
+    FMCPGraphTargetParams Target;
+    if (!Params->TryGetStringField(TEXT("asset_name"), Target.AssetName))
     {
-        Params->TryGetStringField(TEXT("blueprint_name"), AssetName);
+        Params->TryGetStringField(TEXT("blueprint_name"), Target.AssetName);
     }
+    Params->TryGetStringField(TEXT("graph_type"), Target.GraphType);
+    Params->TryGetStringField(TEXT("graph_name"), Target.GraphName);
+
+    return ResolveAssetAndGraph(Target, OutAsset, OutGraph, OutGraphType, OutError);
+}
 
+bool FUnrealCompanionGraphCommands::ResolveAssetAndGraph(
+    const FMCPGraphTargetParams& Target,
+    UObject*& OutAsset,
+    UEdGraph*& OutGraph,
+    UnrealCompanionGraph::EGraphType& OutGraphType,
+    FString& OutError)
+{
+    const FString& AssetName = Target.AssetName;
     if (AssetName.IsEmpty())
     {
         OutError = TEXT("Missing 'asset_name' or 'blueprint_name' parameter");
@@ -143,9 +193,7 @@ bool FUnrealCompanionGraphCommands::ResolveAssetAndGraph(
     }
 
     // Get graph type hint
-    FString GraphTypeHint;
-    Params->TryGetStringField(TEXT("graph_type"), GraphTypeHint);
-    UnrealCompanionGraph::EGraphType RequestedType = UnrealCompanionGraph::ParseGraphType(GraphTypeHint);
+    UnrealCompanionGraph::EGraphType RequestedType = UnrealCompanionGraph::ParseGraphType(Target.GraphType);
 
     // Find the asset
     OutAsset = UnrealCompanionGraph::FindGraphAsset(AssetName, OutGraphType);
@@ -161,11 +209,8 @@ bool FUnrealCompanionGraphCommands::ResolveAssetAndGraph(
         OutGraphType = RequestedType;
     }
 
-    // Get graph name
-    FString GraphName;
-    Params->TryGetStringField(TEXT("graph_name"), GraphName);
-
     // Find the graph
+    const FString& GraphName = Target.GraphName;
     OutGraph = UnrealCompanionGraph::FindGraph(OutAsset, GraphName);
     if (!OutGraph)
     {
@@ -212,13 +257,27 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::CreateErrorResponse(const
 
 TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TSharedPtr<FJsonObject>& Params)
 {
+    UNREALCOMPANION_SCOPE_CYCLE_COUNTER(STAT_UnrealCompanion_GraphBatch);
+
+    FString Error;
+    TSharedPtr<const FMCPGraphBatchParams> BatchParams = FUnrealCompanionParams::Get<FMCPGraphBatchParams>(Params, Error);
+    if (!BatchParams)
+    {
+        return CreateErrorResponse(Error);
+    }
+
+    // Validated against cached metadata only: may run on a worker thread, never touches the asset
+    if (BatchParams->Standard.bDryRun)
+    {
+        return BatchParams->Validation->ToDryRunResponse();
+    }
+
     // Resolve asset and graph
     UObject* Asset = nullptr;
     UEdGraph* Graph = nullptr;
     UnrealCompanionGraph::EGraphType GraphType;
-    FString Error;
 
-    if (!ResolveAssetAndGraph(Params, Asset, Graph, GraphType, Error))
+    if (!ResolveAssetAndGraph(*BatchParams, Asset, Graph, GraphType, Error))
     {
         return CreateErrorResponse(Error);
     }
@@ -232,6 +291,15 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
             *UnrealCompanionGraph::GetGraphTypeName(GraphType)));
     }
 
+    // Every node in the batch shares one memo of class/function lookups
+    FK2NodeFactory::FScopedResolutionBatch ResolutionBatch;
+
+    // ...and one memo of animation assets, so states sharing a sequence load it once
+    FAnimationNodeFactory::FScopedAssetBatch AnimAssetBatch;
+
+    // ...and one GUID/pin index of the graph, so node_id and pin lookups don't rescan it
+    UnrealCompanionNode::FScopedGraphIndex GraphIndex(Graph);
+
     // Get options
     FString OnErrorStr;
     Params->TryGetStringField(TEXT("on_error"), OnErrorStr);
@@ -241,18 +309,25 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
     Params->TryGetStringField(TEXT("verbosity"), VerbosityStr);
     UnrealCompanionGraph::EInfoVerbosity Verbosity = UnrealCompanionGraph::ParseVerbosity(VerbosityStr);
 
-    bool bDryRun = false;
-    Params->TryGetBoolField(TEXT("dry_run"), bDryRun);
-
     bool bAutoCompile = true;
     Params->TryGetBoolField(TEXT("auto_compile"), bAutoCompile);
 
     bool bFocusEditor = true;
     Params->TryGetBoolField(TEXT("focus_editor"), bFocusEditor);
 
+    bool bAutoArrange = false;
+    Params->TryGetBoolField(TEXT("auto_arrange"), bAutoArrange);
+
+    bool bDeferShaderCompile = false;
+    Params->TryGetBoolField(TEXT("defer_shader_compile"), bDeferShaderCompile);
+
+    // Material edits in the batch relink and recompile once, when it is reset below
+    TOptional<UnrealCompanionGraph::FScopedMaterialEditBatch> MaterialBatch;
+    MaterialBatch.Emplace(bDeferShaderCompile);
+
     // Counters
     UnrealCompanionGraph::FBatchCounters Counters;
-    TMap<FString, FString> RefToId;
+    TScratchMap<FString, FString> RefToId;
     TArray<TSharedPtr<FJsonValue>> Errors;
 
     // =========================================================================
@@ -261,6 +336,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
     const TArray<TSharedPtr<FJsonValue>>* RemoveArray = nullptr;
     if (Params->TryGetArrayField(TEXT("remove"), RemoveArray) && RemoveArray)
     {
+        UNREALCOMPANION_TRACE_SCOPE("GraphBatch.RemoveNodes");
         for (const TSharedPtr<FJsonValue>& Value : *RemoveArray)
         {
             FString NodeId = Value->AsString();
@@ -296,6 +372,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
     const TArray<TSharedPtr<FJsonValue>>* BreakLinksArray = nullptr;
     if (Params->TryGetArrayField(TEXT("break_links"), BreakLinksArray) && BreakLinksArray)
     {
+        UNREALCOMPANION_TRACE_SCOPE("GraphBatch.BreakLinks");
         for (const TSharedPtr<FJsonValue>& Value : *BreakLinksArray)
         {
             FString NodeId = Value->AsString();
@@ -314,6 +391,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
     const TArray<TSharedPtr<FJsonValue>>* EnableArray = nullptr;
     if (Params->TryGetArrayField(TEXT("enable_nodes"), EnableArray) && EnableArray)
     {
+        UNREALCOMPANION_TRACE_SCOPE("GraphBatch.EnableNodes");
         for (const TSharedPtr<FJsonValue>& Value : *EnableArray)
         {
             FString NodeId = Value->AsString();
@@ -328,6 +406,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
     const TArray<TSharedPtr<FJsonValue>>* DisableArray = nullptr;
     if (Params->TryGetArrayField(TEXT("disable_nodes"), DisableArray) && DisableArray)
     {
+        UNREALCOMPANION_TRACE_SCOPE("GraphBatch.DisableNodes");
         for (const TSharedPtr<FJsonValue>& Value : *DisableArray)
         {
             FString NodeId = Value->AsString();
@@ -342,6 +421,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
     const TArray<TSharedPtr<FJsonValue>>* ReconstructArray = nullptr;
     if (Params->TryGetArrayField(TEXT("reconstruct_nodes"), ReconstructArray) && ReconstructArray)
     {
+        UNREALCOMPANION_TRACE_SCOPE("GraphBatch.ReconstructNodes");
         for (const TSharedPtr<FJsonValue>& Value : *ReconstructArray)
         {
             FString NodeId = Value->AsString();
@@ -359,6 +439,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
     const TArray<TSharedPtr<FJsonValue>>* SplitPinsArray = nullptr;
     if (Params->TryGetArrayField(TEXT("split_pins"), SplitPinsArray) && SplitPinsArray)
     {
+        UNREALCOMPANION_TRACE_SCOPE("GraphBatch.SplitPins");
         for (const TSharedPtr<FJsonValue>& Value : *SplitPinsArray)
         {
             const TSharedPtr<FJsonObject>* PinOp = nullptr;
@@ -391,6 +472,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
     const TArray<TSharedPtr<FJsonValue>>* RecombinePinsArray = nullptr;
     if (Params->TryGetArrayField(TEXT("recombine_pins"), RecombinePinsArray) && RecombinePinsArray)
     {
+        UNREALCOMPANION_TRACE_SCOPE("GraphBatch.RecombinePins");
         for (const TSharedPtr<FJsonValue>& Value : *RecombinePinsArray)
         {
             const TSharedPtr<FJsonObject>* PinOp = nullptr;
@@ -426,6 +508,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
     const TArray<TSharedPtr<FJsonValue>>* BreakPinLinksArray = nullptr;
     if (Params->TryGetArrayField(TEXT("break_pin_links"), BreakPinLinksArray) && BreakPinLinksArray)
     {
+        UNREALCOMPANION_TRACE_SCOPE("GraphBatch.BreakPinLinks");
         for (const TSharedPtr<FJsonValue>& Value : *BreakPinLinksArray)
         {
             const TSharedPtr<FJsonObject>* PinOp = nullptr;
@@ -450,9 +533,11 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
     // =========================================================================
     // PHASE 5: CREATE NODES
     // =========================================================================
+    TArray<UEdGraphNode*> CreatedNodes;
     const TArray<TSharedPtr<FJsonValue>>* NodesArray = nullptr;
     if (Params->TryGetArrayField(TEXT("nodes"), NodesArray) && NodesArray)
     {
+        UNREALCOMPANION_TRACE_SCOPE("GraphBatch.CreateNodes");
         for (const TSharedPtr<FJsonValue>& Value : *NodesArray)
         {
             const TSharedPtr<FJsonObject>* NodeParams = nullptr;
@@ -480,6 +565,9 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
             if (CreatedNode)
             {
                 Counters.NodesCreated++;
+                CreatedNodes.Add(CreatedNode);
+                UnrealCompanionNode::FScopedGraphIndex::NotifyNodeAdded(CreatedNode);
+                FPinSignatureCache::Get().Record(GraphType, *NodeParams, CreatedNode);
                 if (!Ref.IsEmpty())
                 {
                     RefToId.Add(Ref, CreatedNode->NodeGuid.ToString());
@@ -494,12 +582,90 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
         }
     }
 
+    // =========================================================================
+    // PHASE 5b: STATE MACHINES (animation graphs; states, transitions and rules in one pass)
+    // =========================================================================
+    const TArray<TSharedPtr<FJsonValue>>* MachinesArray = nullptr;
+    TArray<TSharedPtr<FJsonValue>> MachineResults;
+    if (Params->TryGetArrayField(TEXT("state_machines"), MachinesArray) && MachinesArray && MachinesArray->Num() > 0)
+    {
+        UNREALCOMPANION_TRACE_SCOPE("GraphBatch.StateMachines");
+        if (GraphType != UnrealCompanionGraph::EGraphType::Animation)
+        {
+            Counters.NodesFailed += MachinesArray->Num();
+            Errors.Add(MakeShared<FJsonValueString>(TEXT("state_machines needs an Animation Blueprint graph")));
+        }
+        else
+        {
+            FScopedTransaction Transaction(FText::FromString(TEXT("MCP State Machine Batch")));
+            Graph->Modify();
+            FAnimationNodeFactory* AnimFactory = static_cast<FAnimationNodeFactory*>(Factory.Get());
+            for (const TSharedPtr<FJsonValue>& Value : *MachinesArray)
+            {
+                const TSharedPtr<FJsonObject>* MachineSpec = nullptr;
+                if (!Value->TryGetObject(MachineSpec) || !MachineSpec)
+                {
+                    continue;
+                }
+
+                FAnimationNodeFactory::FStateMachineBuild Build;
+                FString BuildError;
+                if (!AnimFactory->BuildStateMachine(Graph, *MachineSpec, Build, BuildError))
+                {
+                    Counters.NodesFailed++;
+                    Errors.Add(MakeShared<FJsonValueString>(BuildError));
+                    if (OnError == UnrealCompanionGraph::EErrorStrategy::Stop) break;
+                    continue;
+                }
+
+                if (Build.bCreatedMachine)
+                {
+                    Counters.NodesCreated++;
+                    CreatedNodes.Add(Build.MachineNode);
+                    UnrealCompanionNode::FScopedGraphIndex::NotifyNodeAdded(Build.MachineNode);
+                }
+                Counters.NodesCreated += Build.StatesCreated + Build.PoseNodesCreated + Build.Transitions.Num();
+                Counters.ConnectionsMade += Build.RulesBound;
+
+                const FString MachineGuid = Build.MachineNode->NodeGuid.ToString();
+                FString Ref;
+                if ((*MachineSpec)->TryGetStringField(TEXT("ref"), Ref) && !Ref.IsEmpty())
+                {
+                    RefToId.Add(Ref, MachineGuid);
+                }
+
+                TSharedPtr<FJsonObject> MachineObj = MakeShared<FJsonObject>();
+                MachineObj->SetStringField(TEXT("node_id"), MachineGuid);
+                MachineObj->SetBoolField(TEXT("created"), Build.bCreatedMachine);
+                TSharedPtr<FJsonObject> StatesObj = MakeShared<FJsonObject>();
+                for (const TPair<FString, UAnimStateNodeBase*>& State : Build.States)
+                {
+                    StatesObj->SetStringField(State.Key, State.Value->NodeGuid.ToString());
+                }
+                MachineObj->SetObjectField(TEXT("states"), StatesObj);
+                MachineObj->SetNumberField(TEXT("states_created"), Build.StatesCreated);
+                MachineObj->SetNumberField(TEXT("transitions_created"), Build.Transitions.Num());
+                MachineObj->SetNumberField(TEXT("rules_bound"), Build.RulesBound);
+                MachineResults.Add(MakeShared<FJsonValueObject>(MachineObj));
+
+                // Per-item problems count as failures but the machine is kept
+                Counters.NodesFailed += Build.Errors.Num();
+                for (const FString& ItemError : Build.Errors)
+                {
+                    Errors.Add(MakeShared<FJsonValueString>(ItemError));
+                }
+                if (Build.Errors.Num() > 0 && OnError == UnrealCompanionGraph::EErrorStrategy::Stop) break;
+            }
+        }
+    }
+
     // =========================================================================
     // PHASE 6: CONNECTIONS
     // =========================================================================
     const TArray<TSharedPtr<FJsonValue>>* ConnectionsArray = nullptr;
     if (Params->TryGetArrayField(TEXT("connections"), ConnectionsArray) && ConnectionsArray)
     {
+        UNREALCOMPANION_TRACE_SCOPE("GraphBatch.Connections");
         for (const TSharedPtr<FJsonValue>& Value : *ConnectionsArray)
         {
             const TSharedPtr<FJsonObject>* ConnParams = nullptr;
@@ -611,6 +777,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
     const TArray<TSharedPtr<FJsonValue>>* PinValuesArray = nullptr;
     if (Params->TryGetArrayField(TEXT("pin_values"), PinValuesArray) && PinValuesArray)
     {
+        UNREALCOMPANION_TRACE_SCOPE("GraphBatch.PinValues");
         for (const TSharedPtr<FJsonValue>& Value : *PinValuesArray)
         {
             const TSharedPtr<FJsonObject>* PinParams = nullptr;
@@ -668,7 +835,23 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
     }
 
     // =========================================================================
-    // PHASE 8: COMPILE IF NEEDED
+    // PHASE 8: AUTO-ARRANGE (only the nodes this batch created)
+    // =========================================================================
+    TSharedPtr<FJsonObject> LayoutJson;
+    if (bAutoArrange && CreatedNodes.Num() > 0)
+    {
+        UNREALCOMPANION_TRACE_SCOPE("GraphBatch.AutoArrange");
+        FString ArrangeMode;
+        Params->TryGetStringField(TEXT("auto_arrange_mode"), ArrangeMode);
+
+        UnrealCompanionLayout::FLayoutSettings LayoutSettings;
+        LayoutSettings.Mode = UnrealCompanionLayout::ParseArrangeMode(ArrangeMode);
+        LayoutJson = UnrealCompanionLayout::ArrangeSubgraph(Graph, CreatedNodes, LayoutSettings).ToJson();
+        LayoutJson->SetStringField(TEXT("mode"), UnrealCompanionLayout::GetArrangeModeName(LayoutSettings.Mode));
+    }
+
+    // =========================================================================
+    // PHASE 9: COMPILE IF NEEDED
     // =========================================================================
     bool bModified = Counters.GetTotalOperations() > 0;
     
@@ -677,11 +860,13 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
         UnrealCompanionGraph::MarkAsModified(Asset);
     }
 
-    if (bModified && bAutoCompile && !bDryRun)
+    // A Material held by an earlier defer_shader_compile compiles here even with no operations
+    if ((bModified || UnrealCompanionGraph::IsCompilePending(Asset)) && bAutoCompile)
     {
         FString CompileError;
         UnrealCompanionGraph::CompileIfNeeded(Asset, false, &CompileError);
     }
+    MaterialBatch.Reset();
 
     // =========================================================================
     // BUILD RESPONSE
@@ -693,6 +878,21 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
     // Counters
     Response->SetObjectField(TEXT("counters"), Counters.ToJson());
 
+    if (LayoutJson.IsValid())
+    {
+        Response->SetObjectField(TEXT("layout"), LayoutJson);
+    }
+
+    if (GraphType == UnrealCompanionGraph::EGraphType::Material)
+    {
+        Response->SetBoolField(TEXT("shader_compile_pending"), UnrealCompanionGraph::IsCompilePending(Asset));
+    }
+
+    if (MachineResults.Num() > 0)
+    {
+        Response->SetArrayField(TEXT("state_machines"), MachineResults);
+    }
+
     // Ref to ID mapping
     if (RefToId.Num() > 0)
     {
@@ -767,6 +967,25 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleGraphBatch(const TS
     return Response;
 }
 
+namespace
+{
+    /**
+     * Dirty the asset after a single-op edit. Materials are also recompiled, unless
+     * defer_shader_compile holds them for a later graph_batch or session commit.
+     */
+    void MarkSingleEdit(UObject* Asset, UnrealCompanionGraph::EGraphType GraphType, const TSharedPtr<FJsonObject>& Params)
+    {
+        UnrealCompanionGraph::MarkAsModified(Asset);
+
+        bool bDeferShaderCompile = false;
+        Params->TryGetBoolField(TEXT("defer_shader_compile"), bDeferShaderCompile);
+        if (GraphType == UnrealCompanionGraph::EGraphType::Material && !bDeferShaderCompile)
+        {
+            UnrealCompanionGraph::CompileIfNeeded(Asset);
+        }
+    }
+}
+
 // =========================================================================
 // SIMPLE NODE OPERATIONS
 // =========================================================================
@@ -811,7 +1030,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleNodeCreate(const TS
         return CreateErrorResponse(CreateError);
     }
 
-    UnrealCompanionGraph::MarkAsModified(Asset);
+    MarkSingleEdit(Asset, GraphType, Params);
 
     TSharedPtr<FJsonObject> Response = CreateSuccessResponse();
     Response->SetStringField(TEXT("node_id"), Node->NodeGuid.ToString());
@@ -854,7 +1073,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleNodeDelete(const TS
             return CreateErrorResponse(RemoveError);
         }
 
-        UnrealCompanionGraph::MarkAsModified(Asset);
+        MarkSingleEdit(Asset, GraphType, Params);
         return CreateSuccessResponse(TEXT("Node deleted"));
     }
 
@@ -886,7 +1105,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleNodeDelete(const TS
 
     if (Deleted > 0)
     {
-        UnrealCompanionGraph::MarkAsModified(Asset);
+        MarkSingleEdit(Asset, GraphType, Params);
     }
 
     TSharedPtr<FJsonObject> Response = CreateSuccessResponse();
@@ -906,32 +1125,30 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleNodeDelete(const TS
 
 TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleNodeFind(const TSharedPtr<FJsonObject>& Params)
 {
+    FString Error;
+    TSharedPtr<const FMCPGraphNodeFindParams> Find = FUnrealCompanionParams::Get<FMCPGraphNodeFindParams>(Params, Error);
+    if (!Find.IsValid())
+    {
+        return CreateErrorResponse(Error);
+    }
+
     UObject* Asset = nullptr;
     UEdGraph* Graph = nullptr;
     UnrealCompanionGraph::EGraphType GraphType;
-    FString Error;
-
-    if (!ResolveAssetAndGraph(Params, Asset, Graph, GraphType, Error))
+    if (!ResolveAssetAndGraph(*Find, Asset, Graph, GraphType, Error))
     {
         return CreateErrorResponse(Error);
     }
 
-    // Get filter parameters
-    FString NodeType, ClassName, VariableName, EventName, FunctionName;
-    Params->TryGetStringField(TEXT("node_type"), NodeType);
-    Params->TryGetStringField(TEXT("class_name"), ClassName);
-    Params->TryGetStringField(TEXT("variable_name"), VariableName);
-    Params->TryGetStringField(TEXT("event_name"), EventName);
-    Params->TryGetStringField(TEXT("function_name"), FunctionName);
-    
-    bool bOnlyUnconnected = false;
-    Params->TryGetBoolField(TEXT("only_unconnected"), bOnlyUnconnected);
-    
-    bool bOnlyPure = false;
-    Params->TryGetBoolField(TEXT("only_pure"), bOnlyPure);
-    
-    bool bOnlyImpure = false;
-    Params->TryGetBoolField(TEXT("only_impure"), bOnlyImpure);
+    // Filter parameters
+    const FString& NodeType = Find->NodeType;
+    const FString& ClassName = Find->ClassName;
+    const FString& VariableName = Find->VariableName;
+    const FString& EventName = Find->EventName;
+    const FString& FunctionName = Find->FunctionName;
+    const bool bOnlyUnconnected = Find->bOnlyUnconnected;
+    const bool bOnlyPure = Find->bOnlyPure;
+    const bool bOnlyImpure = Find->bOnlyImpure;
 
     TArray<UEdGraphNode*> AllNodes;
     if (!ClassName.IsEmpty())
@@ -943,7 +1160,31 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleNodeFind(const TSha
         AllNodes = UnrealCompanionNode::GetAllNodes(Graph);
     }
 
-    TArray<TSharedPtr<FJsonValue>> NodesArray;
+    // Every response carries the graph revision; with since_revision only the nodes
+    // changed after it are sent (plus the GUIDs removed), each with its outgoing links
+    const bool bDeltaRequest = Find->SinceRevision >= 0.0;
+    FGraphRevisionTracker::FDelta Delta;
+    if (bDeltaRequest)
+    {
+        Delta = FGraphRevisionTracker::Get().GetChangesSince(Graph, static_cast<int64>(Find->SinceRevision));
+    }
+    else
+    {
+        Delta.Revision = FGraphRevisionTracker::Get().Sync(Graph);
+    }
+    const bool bDelta = bDeltaRequest && !Delta.bFull;
+    if (bDelta)
+    {
+        const TSet<UEdGraphNode*> Changed(Delta.Changed);
+        AllNodes.RemoveAll([&Changed](UEdGraphNode* Node) { return !Changed.Contains(Node); });
+    }
+
+    // Matches are streamed to UTF-8 as they pass the filters, so a large graph
+    // never holds its whole result as a JSON tree
+    TArray<uint8> NodesJson;
+    FMCPResponseWriter NodesWriter(NodesJson);
+    NodesWriter.BeginArray();
+    int32 NodeCount = 0;
     for (UEdGraphNode* Node : AllNodes)
     {
         if (!Node) continue;
@@ -1028,13 +1269,33 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleNodeFind(const TSha
         }
         
         // Node passed all filters
-        NodesArray.Add(MakeShared<FJsonValueObject>(
-            UnrealCompanionNode::BuildNodeInfo(Node, UnrealCompanionGraph::EInfoVerbosity::Normal)));
+        TSharedPtr<FJsonObject> NodeInfo = UnrealCompanionNode::BuildNodeInfo(Node, UnrealCompanionGraph::EInfoVerbosity::Normal);
+        if (bDeltaRequest)
+        {
+            NodeInfo->SetArrayField(TEXT("links"), UnrealCompanionNode::BuildOutputLinks(Node));
+        }
+        NodesWriter.WriteObject(*NodeInfo);
+        ++NodeCount;
     }
+    NodesWriter.EndArray();
 
     TSharedPtr<FJsonObject> Response = CreateSuccessResponse();
-    Response->SetNumberField(TEXT("count"), NodesArray.Num());
-    Response->SetArrayField(TEXT("nodes"), NodesArray);
+    Response->SetNumberField(TEXT("count"), NodeCount);
+    Response->SetField(TEXT("nodes"), MakeShared<FMCPJsonValueRaw>(MoveTemp(NodesJson)));
+    Response->SetNumberField(TEXT("revision"), static_cast<double>(Delta.Revision));
+    if (bDeltaRequest)
+    {
+        // full: the revision was too old (or from another session) and every match was sent
+        Response->SetNumberField(TEXT("since_revision"), Find->SinceRevision);
+        Response->SetBoolField(TEXT("full"), !bDelta);
+
+        TArray<TSharedPtr<FJsonValue>> RemovedJson;
+        for (const FGuid& Removed : Delta.Removed)
+        {
+            RemovedJson.Add(MakeShared<FJsonValueString>(Removed.ToString()));
+        }
+        Response->SetArrayField(TEXT("removed"), RemovedJson);
+    }
     
     // Include filter info in response
     if (!NodeType.IsEmpty()) Response->SetStringField(TEXT("filter_node_type"), NodeType);
@@ -1050,17 +1311,22 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleNodeFind(const TSha
 
 TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleNodeInfo(const TSharedPtr<FJsonObject>& Params)
 {
+    FString Error;
+    TSharedPtr<const FMCPGraphNodeInfoParams> Info = FUnrealCompanionParams::Get<FMCPGraphNodeInfoParams>(Params, Error);
+    if (!Info.IsValid())
+    {
+        return CreateErrorResponse(Error);
+    }
+
     UObject* Asset = nullptr;
     UEdGraph* Graph = nullptr;
     UnrealCompanionGraph::EGraphType GraphType;
-    FString Error;
-
-    if (!ResolveAssetAndGraph(Params, Asset, Graph, GraphType, Error))
+    if (!ResolveAssetAndGraph(*Info, Asset, Graph, GraphType, Error))
     {
         return CreateErrorResponse(Error);
     }
 
-    FString NodeId = Params->GetStringField(TEXT("node_id"));
+    const FString& NodeId = Info->NodeId;
     if (NodeId.IsEmpty())
     {
         return CreateErrorResponse(TEXT("Missing 'node_id' parameter"));
@@ -1072,7 +1338,21 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandleNodeInfo(const TSha
         return CreateErrorResponse(FString::Printf(TEXT("Node not found: %s"), *NodeId));
     }
 
+    FGraphRevisionTracker& Revisions = FGraphRevisionTracker::Get();
+    const int64 Revision = Revisions.Sync(Graph);
+    const int64 NodeRevision = Revisions.GetNodeRevision(Graph, Node->NodeGuid);
+
     TSharedPtr<FJsonObject> Response = CreateSuccessResponse();
+    Response->SetNumberField(TEXT("revision"), static_cast<double>(Revision));
+    Response->SetNumberField(TEXT("node_revision"), static_cast<double>(NodeRevision));
+
+    const int64 SinceRevision = static_cast<int64>(Info->SinceRevision);
+    if (Info->SinceRevision >= 0.0 && Revisions.IsWithinHistory(Graph, SinceRevision) && NodeRevision <= SinceRevision)
+    {
+        Response->SetBoolField(TEXT("unchanged"), true);
+        return Response;
+    }
+
     Response->SetObjectField(TEXT("node"), 
         UnrealCompanionNode::BuildNodeInfo(Node, UnrealCompanionGraph::EInfoVerbosity::Full));
 
@@ -1122,7 +1402,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandlePinConnect(const TS
         return CreateErrorResponse(ConnError);
     }
 
-    UnrealCompanionGraph::MarkAsModified(Asset);
+    MarkSingleEdit(Asset, GraphType, Params);
     return CreateSuccessResponse(TEXT("Pins connected"));
 }
 
@@ -1178,7 +1458,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandlePinDisconnect(const
 
     if (BrokenCount > 0)
     {
-        UnrealCompanionGraph::MarkAsModified(Asset);
+        MarkSingleEdit(Asset, GraphType, Params);
     }
 
     TSharedPtr<FJsonObject> Response = CreateSuccessResponse();
@@ -1220,6 +1500,6 @@ TSharedPtr<FJsonObject> FUnrealCompanionGraphCommands::HandlePinSetValue(const T
         return CreateErrorResponse(SetError);
     }
 
-    UnrealCompanionGraph::MarkAsModified(Asset);
+    MarkSingleEdit(Asset, GraphType, Params);
     return CreateSuccessResponse(TEXT("Pin value set"));
 }
@@ -0,0 +1,285 @@
+#include "Commands/UnrealCompanionHeightfieldCache.h"
+#include "Async/ParallelFor.h"
+#include "LandscapeComponent.h"
+#include "LandscapeEdit.h"
+#include "LandscapeInfo.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+    /** Output rows produced per GetHeightData call on the fine levels */
+    constexpr int32 StripTexelRows = 256;
+
+    int32 LevelSize(int32 Vertices, int32 Level)
+    {
+        return (Vertices + (1 << Level) - 1) >> Level;
+    }
+
+    int32 ComputeBaseLevel(const FIntRect& Extent)
+    {
+        const int32 Width = Extent.Width() + 1;
+        const int32 Height = Extent.Height() + 1;
+        int32 Level = 0;
+        while ((int64)LevelSize(Width, Level) * LevelSize(Height, Level) > FUnrealCompanionHeightfieldCache::MaxCachedTexels)
+        {
+            ++Level;
+        }
+        return Level;
+    }
+}
+
+FUnrealCompanionHeightfieldCache& FUnrealCompanionHeightfieldCache::Get()
+{
+    static FUnrealCompanionHeightfieldCache Instance;
+    return Instance;
+}
+
+bool FUnrealCompanionHeightfieldCache::Read(ULandscapeInfo* Info, const FIntRect& Region, int32 Level, FLevel& OutLevel, FIntPoint& OutOrigin, bool& bOutFromCache)
+{
+    check(IsInGameThread());
+    bOutFromCache = false;
+    FIntRect Extent;
+    if (!Info || !Info->GetLandscapeExtent(Extent) || Level < 0)
+    {
+        return false;
+    }
+
+    if (Level < ComputeBaseLevel(Extent))
+    {
+        ReadDownsampled(Info, Region, Level, OutLevel);
+        OutOrigin = Region.Min;
+        return true;
+    }
+
+    EnsureSubscribed();
+    FEntry* Entry = FindOrBuild(Info, Extent, bOutFromCache);
+    Refresh(*Entry);
+
+    const int32 Index = FMath::Min(Level - Entry->BaseLevel, Entry->Levels.Num() - 1);
+    const int32 CachedLevel = Entry->BaseLevel + Index;
+    const FLevel& Source = Entry->Levels[Index];
+
+    const FIntPoint Min((Region.Min.X - Extent.Min.X) >> CachedLevel, (Region.Min.Y - Extent.Min.Y) >> CachedLevel);
+    const FIntPoint Max(
+        FMath::Min((Region.Max.X - Extent.Min.X) >> CachedLevel, Source.Width - 1),
+        FMath::Min((Region.Max.Y - Extent.Min.Y) >> CachedLevel, Source.Height - 1));
+
+    OutLevel.Width = Max.X - Min.X + 1;
+    OutLevel.Height = Max.Y - Min.Y + 1;
+    OutLevel.Heights.SetNumUninitialized(OutLevel.Width * OutLevel.Height);
+    for (int32 Y = 0; Y < OutLevel.Height; ++Y)
+    {
+        FMemory::Memcpy(&OutLevel.Heights[Y * OutLevel.Width], &Source.Heights[(Min.Y + Y) * Source.Width + Min.X], OutLevel.Width * sizeof(uint16));
+    }
+    OutOrigin = Extent.Min + FIntPoint(Min.X << CachedLevel, Min.Y << CachedLevel);
+    return true;
+}
+
+void FUnrealCompanionHeightfieldCache::ReadDownsampled(ULandscapeInfo* Info, const FIntRect& Region, int32 Level, FLevel& OutLevel)
+{
+    const int32 Step = 1 << Level;
+    const int32 SourceWidth = Region.Width() + 1;
+    const int32 SourceHeight = Region.Height() + 1;
+    OutLevel.Width = LevelSize(SourceWidth, Level);
+    OutLevel.Height = LevelSize(SourceHeight, Level);
+    OutLevel.Heights.SetNumUninitialized(OutLevel.Width * OutLevel.Height);
+
+    FLandscapeEditDataInterface LandscapeEdit(Info);
+    const int32 StripRows = FMath::Max(1, StripTexelRows >> Level) * Step;
+    TArray<uint16> Strip;
+    Strip.SetNumUninitialized(SourceWidth * FMath::Min(StripRows, SourceHeight));
+
+    for (int32 StripY = 0; StripY < SourceHeight; StripY += StripRows)
+    {
+        const int32 Rows = FMath::Min(StripRows, SourceHeight - StripY);
+        int32 X1 = Region.Min.X;
+        int32 Y1 = Region.Min.Y + StripY;
+        int32 X2 = Region.Max.X;
+        int32 Y2 = Y1 + Rows - 1;
+        LandscapeEdit.GetHeightData(X1, Y1, X2, Y2, Strip.GetData(), 0);
+
+        // Each output row owns Step source rows of the strip, so rows filter independently
+        const int32 FirstRow = StripY / Step;
+        const int32 RowCount = LevelSize(Rows, Level);
+        ParallelFor(RowCount, [&](int32 RowIndex)
+        {
+            TArray<uint64, TInlineAllocator<1024>> Sums;
+            Sums.SetNumZeroed(OutLevel.Width);
+            const int32 RowStart = RowIndex * Step;
+            const int32 RowEnd = FMath::Min(RowStart + Step, Rows);
+            for (int32 Y = RowStart; Y < RowEnd; ++Y)
+            {
+                const uint16* Source = &Strip[Y * SourceWidth];
+                for (int32 X = 0; X < SourceWidth; ++X)
+                {
+                    Sums[X >> Level] += Source[X];
+                }
+            }
+
+            uint16* Dest = &OutLevel.Heights[(FirstRow + RowIndex) * OutLevel.Width];
+            const int32 SpanY = RowEnd - RowStart;
+            for (int32 X = 0; X < OutLevel.Width; ++X)
+            {
+                const int32 SpanX = FMath::Min(Step, SourceWidth - X * Step);
+                const uint64 Count = (uint64)SpanX * SpanY;
+                Dest[X] = (uint16)((Sums[X] + Count / 2) / Count);
+            }
+        }, RowCount < 4 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+    }
+}
+
+void FUnrealCompanionHeightfieldCache::DownsampleRect(const FLevel& Src, FLevel& Dst, const FIntPoint& Min, const FIntPoint& Max)
+{
+    const int32 MaxX = FMath::Min(Max.X, Dst.Width - 1);
+    const int32 MaxY = FMath::Min(Max.Y, Dst.Height - 1);
+    for (int32 Y = Min.Y; Y <= MaxY; ++Y)
+    {
+        const int32 SrcY0 = Y * 2;
+        const int32 SrcY1 = FMath::Min(SrcY0 + 1, Src.Height - 1);
+        for (int32 X = Min.X; X <= MaxX; ++X)
+        {
+            const int32 SrcX0 = X * 2;
+            const int32 SrcX1 = FMath::Min(SrcX0 + 1, Src.Width - 1);
+            const uint32 Sum = (uint32)Src.Heights[SrcY0 * Src.Width + SrcX0] + Src.Heights[SrcY0 * Src.Width + SrcX1]
+                + Src.Heights[SrcY1 * Src.Width + SrcX0] + Src.Heights[SrcY1 * Src.Width + SrcX1];
+            Dst.Heights[Y * Dst.Width + X] = (uint16)((Sum + 2) / 4);
+        }
+    }
+}
+
+FUnrealCompanionHeightfieldCache::FEntry* FUnrealCompanionHeightfieldCache::FindOrBuild(ULandscapeInfo* Info, const FIntRect& Extent, bool& bOutFromCache)
+{
+    Entries.RemoveAllSwap([](const FEntry& Entry) { return !Entry.Info.IsValid(); });
+
+    FEntry* Entry = Entries.FindByPredicate([Info](const FEntry& Candidate) { return Candidate.Info.Get() == Info; });
+    if (Entry && Entry->Extent == Extent)
+    {
+        bOutFromCache = true;
+        return Entry;
+    }
+    if (!Entry)
+    {
+        Entry = &Entries.AddDefaulted_GetRef();
+        Entry->Info = Info;
+    }
+
+    // New or resized: read the base level once and filter the rest from it
+    Entry->Extent = Extent;
+    Entry->BaseLevel = ComputeBaseLevel(Extent);
+    Entry->bDirty = false;
+    Entry->Levels.Reset();
+    ReadDownsampled(Info, Extent, Entry->BaseLevel, Entry->Levels.AddDefaulted_GetRef());
+    while (Entry->Levels.Last().Width > 1 || Entry->Levels.Last().Height > 1)
+    {
+        const FLevel& Src = Entry->Levels.Last();
+        FLevel Dst;
+        Dst.Width = (Src.Width + 1) / 2;
+        Dst.Height = (Src.Height + 1) / 2;
+        Dst.Heights.SetNumUninitialized(Dst.Width * Dst.Height);
+        DownsampleRect(Src, Dst, FIntPoint(0, 0), FIntPoint(Dst.Width - 1, Dst.Height - 1));
+        Entry->Levels.Add(MoveTemp(Dst));
+    }
+    return Entry;
+}
+
+void FUnrealCompanionHeightfieldCache::Refresh(FEntry& Entry)
+{
+    if (!Entry.bDirty)
+    {
+        return;
+    }
+    Entry.bDirty = false;
+
+    const FIntRect& Extent = Entry.Extent;
+    const FIntRect Dirty(
+        FIntPoint(FMath::Max(Entry.Dirty.Min.X, Extent.Min.X), FMath::Max(Entry.Dirty.Min.Y, Extent.Min.Y)),
+        FIntPoint(FMath::Min(Entry.Dirty.Max.X, Extent.Max.X), FMath::Min(Entry.Dirty.Max.Y, Extent.Max.Y)));
+    if (Dirty.Min.X > Dirty.Max.X || Dirty.Min.Y > Dirty.Max.Y)
+    {
+        return;
+    }
+
+    // Re-read the base texels under the dirty vertices, whole texels only
+    const int32 Base = Entry.BaseLevel;
+    FIntPoint Min((Dirty.Min.X - Extent.Min.X) >> Base, (Dirty.Min.Y - Extent.Min.Y) >> Base);
+    FIntPoint Max((Dirty.Max.X - Extent.Min.X) >> Base, (Dirty.Max.Y - Extent.Min.Y) >> Base);
+    const FIntRect ReadRegion(
+        Extent.Min + FIntPoint(Min.X << Base, Min.Y << Base),
+        FIntPoint(FMath::Min(Extent.Min.X + ((Max.X + 1) << Base) - 1, Extent.Max.X),
+            FMath::Min(Extent.Min.Y + ((Max.Y + 1) << Base) - 1, Extent.Max.Y)));
+
+    FLevel Patch;
+    ReadDownsampled(Entry.Info.Get(), ReadRegion, Base, Patch);
+    FLevel& BaseLevel = Entry.Levels[0];
+    for (int32 Y = 0; Y < Patch.Height; ++Y)
+    {
+        FMemory::Memcpy(&BaseLevel.Heights[(Min.Y + Y) * BaseLevel.Width + Min.X], &Patch.Heights[Y * Patch.Width], Patch.Width * sizeof(uint16));
+    }
+
+    // Then only the texels above them, level by level
+    for (int32 Index = 1; Index < Entry.Levels.Num(); ++Index)
+    {
+        Min = FIntPoint(Min.X / 2, Min.Y / 2);
+        Max = FIntPoint(Max.X / 2, Max.Y / 2);
+        DownsampleRect(Entry.Levels[Index - 1], Entry.Levels[Index], Min, Max);
+    }
+}
+
+void FUnrealCompanionHeightfieldCache::Invalidate(ULandscapeInfo* Info, const FIntRect& Region)
+{
+    for (FEntry& Entry : Entries)
+    {
+        if (Entry.Info.Get() == Info)
+        {
+            if (Entry.bDirty)
+            {
+                Entry.Dirty.Include(Region.Min);
+                Entry.Dirty.Include(Region.Max);
+            }
+            else
+            {
+                Entry.Dirty = Region;
+                Entry.bDirty = true;
+            }
+            return;
+        }
+    }
+}
+
+void FUnrealCompanionHeightfieldCache::Invalidate(ULandscapeInfo* Info)
+{
+    Entries.RemoveAllSwap([Info](const FEntry& Entry) { return Entry.Info.Get() == Info; });
+}
+
+void FUnrealCompanionHeightfieldCache::EnsureSubscribed()
+{
+    if (!ObjectModifiedHandle.IsValid())
+    {
+        ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FUnrealCompanionHeightfieldCache::OnObjectModified);
+    }
+}
+
+void FUnrealCompanionHeightfieldCache::OnObjectModified(UObject* Object)
+{
+    // Runs on every Modify() in the editor; editor sculpt tools modify the components they touch
+    if (Entries.Num() == 0)
+    {
+        return;
+    }
+    if (const ULandscapeComponent* Component = Cast<ULandscapeComponent>(Object))
+    {
+        int32 MinX, MinY, MaxX, MaxY;
+        Component->GetComponentExtent(MinX, MinY, MaxX, MaxY);
+        Invalidate(Component->GetLandscapeInfo(), FIntRect(MinX, MinY, MaxX, MaxY));
+    }
+}
+
+void FUnrealCompanionHeightfieldCache::Shutdown()
+{
+    if (ObjectModifiedHandle.IsValid())
+    {
+        FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+        ObjectModifiedHandle.Reset();
+    }
+    Entries.Reset();
+}
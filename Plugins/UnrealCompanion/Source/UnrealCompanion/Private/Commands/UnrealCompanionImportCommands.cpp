@@ -9,26 +9,29 @@
 #include "Factories/FbxImportUI.h"
 #include "HAL/FileManager.h"
 #include "Misc/Paths.h"
+#include "UObject/StrongObjectPtr.h"
 
 FUnrealCompanionImportCommands::FUnrealCompanionImportCommands()
 {
 }
 
+TConstArrayView<TMCPCommandEntry<FUnrealCompanionImportCommands>> FUnrealCompanionImportCommands::GetCommandTable()
+{
+    static constexpr TMCPCommandEntry<FUnrealCompanionImportCommands> Table[] = {
+        { TEXT("asset_import"), &FUnrealCompanionImportCommands::HandleImport },
+        { TEXT("asset_import_batch"), &FUnrealCompanionImportCommands::HandleImportBatch },
+        { TEXT("asset_get_supported_formats"), &FUnrealCompanionImportCommands::HandleGetSupportedFormats },
+    };
+    static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+    return Table;
+}
+
 TSharedPtr<FJsonObject> FUnrealCompanionImportCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-    if (CommandType == TEXT("asset_import"))
-    {
-        return HandleImport(Params);
-    }
-    else if (CommandType == TEXT("asset_import_batch"))
-    {
-        return HandleImportBatch(Params);
-    }
-    else if (CommandType == TEXT("asset_get_supported_formats"))
+    if (TSharedPtr<FJsonObject> Result = UnrealCompanionCommandTable::Dispatch(*this, GetCommandTable(), CommandType, Params))
     {
-        return HandleGetSupportedFormats(Params);
+        return Result;
     }
-    
     return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown import command: %s"), *CommandType));
 }
 
@@ -59,15 +62,15 @@ static FString NormalizeContentPath(const FString& Path)
     return NormalizedPath;
 }
 
-bool FUnrealCompanionImportCommands::ImportFile(const FString& SourcePath, const FString& DestinationPath, 
-    const FString& AssetName, bool bReplaceExisting, bool bAutomated, bool bSave, 
+UAssetImportTask* FUnrealCompanionImportCommands::CreateImportTask(const FString& SourcePath, const FString& DestinationPath,
+    const FString& AssetName, bool bReplaceExisting, bool bAutomated, bool bSave, UFbxFactory* SharedFbxFactory,
     FString& OutAssetPath, FString& OutError)
 {
     // Validate source file exists
     if (!FPaths::FileExists(SourcePath))
     {
         OutError = FString::Printf(TEXT("Source file not found: %s"), *SourcePath);
-        return false;
+        return nullptr;
     }
     
     // Get file extension
@@ -98,7 +101,7 @@ bool FUnrealCompanionImportCommands::ImportFile(const FString& SourcePath, const
         if (!bReplaceExisting)
         {
             OutError = FString::Printf(TEXT("Asset already exists: %s"), *OutAssetPath);
-            return false;
+            return nullptr;
         }
         // Delete existing to replace
         UEditorAssetLibrary::DeleteAsset(OutAssetPath);
@@ -116,23 +119,42 @@ bool FUnrealCompanionImportCommands::ImportFile(const FString& SourcePath, const
     // Configure options based on file type
     if (Extension == TEXT("fbx") || Extension == TEXT("glb") || Extension == TEXT("gltf"))
     {
-        // FBX/GLTF import options
-        UFbxFactory* FbxFactory = NewObject<UFbxFactory>();
-        FbxFactory->SetAutomatedAssetImportData(nullptr);
-        
-        UFbxImportUI* ImportUI = NewObject<UFbxImportUI>();
-        ImportUI->bImportMesh = true;
-        ImportUI->bImportMaterials = true;
-        ImportUI->bImportTextures = true;
-        ImportUI->bImportAnimations = true;
-        ImportUI->bImportRigidMesh = true;
-        ImportUI->bImportAsSkeletal = false; // Auto-detect
-        ImportUI->bAutomatedImportShouldDetectType = true;
-        ImportUI->bOverrideFullName = true;
-        ImportUI->bCreatePhysicsAsset = true;
-        
-        FbxFactory->ImportUI = ImportUI;
-        ImportTask->Factory = FbxFactory;
+        ImportTask->Factory = SharedFbxFactory ? SharedFbxFactory : CreateFbxFactory();
+    }
+    
+    return ImportTask;
+}
+
+UFbxFactory* FUnrealCompanionImportCommands::CreateFbxFactory()
+{
+    // FBX/GLTF import options
+    UFbxFactory* FbxFactory = NewObject<UFbxFactory>();
+    FbxFactory->SetAutomatedAssetImportData(nullptr);
+    
+    UFbxImportUI* ImportUI = NewObject<UFbxImportUI>();
+    ImportUI->bImportMesh = true;
+    ImportUI->bImportMaterials = true;
+    ImportUI->bImportTextures = true;
+    ImportUI->bImportAnimations = true;
+    ImportUI->bImportRigidMesh = true;
+    ImportUI->bImportAsSkeletal = false; // Auto-detect
+    ImportUI->bAutomatedImportShouldDetectType = true;
+    ImportUI->bOverrideFullName = true;
+    ImportUI->bCreatePhysicsAsset = true;
+    
+    FbxFactory->ImportUI = ImportUI;
+    return FbxFactory;
+}
+
+bool FUnrealCompanionImportCommands::ImportFile(const FString& SourcePath, const FString& DestinationPath, 
+    const FString& AssetName, bool bReplaceExisting, bool bAutomated, bool bSave, 
+    FString& OutAssetPath, FString& OutError)
+{
+    UAssetImportTask* ImportTask = CreateImportTask(SourcePath, DestinationPath, AssetName,
+        bReplaceExisting, bAutomated, bSave, nullptr, OutAssetPath, OutError);
+    if (!ImportTask)
+    {
+        return false;
     }
     
     // Execute import
@@ -149,7 +171,7 @@ bool FUnrealCompanionImportCommands::ImportFile(const FString& SourcePath, const
         
         // Sync Content Browser
         FUnrealCompanionEditorFocus& Focus = FUnrealCompanionEditorFocus::Get();
-        Focus.SyncContentBrowser(FinalDestination);
+        Focus.SyncContentBrowser(ImportTask->DestinationPath);
         
         return true;
     }
@@ -226,6 +248,31 @@ TSharedPtr<FJsonObject> FUnrealCompanionImportCommands::HandleImportBatch(const
     TArray<TSharedPtr<FJsonObject>> Results;
     TArray<TSharedPtr<FJsonObject>> Errors;
     
+    // Strong refs: replacing an existing asset deletes it, which can run a garbage collection
+    // while earlier tasks are still waiting to be submitted
+    struct FPendingImport
+    {
+        TStrongObjectPtr<UAssetImportTask> Task;
+        FString SourcePath;
+        FString AssetPath;
+        bool bSave = true;
+    };
+    
+    // 1. Build every task up front. One FBX factory serves all FBX/GLTF items, and no task
+    //    saves on its own: the packages are written together once everything is imported.
+    TStrongObjectPtr<UFbxFactory> SharedFbxFactory;
+    TArray<FPendingImport> Pending;
+    Pending.Reserve(FilesArray->Num());
+    
+    auto AddError = [&Errors, &Failed](const FString& SourcePath, const FString& Error)
+    {
+        Failed++;
+        TSharedPtr<FJsonObject> ErrorObj = MakeShared<FJsonObject>();
+        ErrorObj->SetStringField(TEXT("source"), SourcePath);
+        ErrorObj->SetStringField(TEXT("error"), Error);
+        Errors.Add(ErrorObj);
+    };
+    
     for (int32 i = 0; i < FilesArray->Num(); i++)
     {
         const TSharedPtr<FJsonObject>& FileObj = (*FilesArray)[i]->AsObject();
@@ -248,30 +295,82 @@ TSharedPtr<FJsonObject> FUnrealCompanionImportCommands::HandleImportBatch(const
             (*OptionsObj)->TryGetBoolField(TEXT("save"), bSave);
         }
         
-        FString OutAssetPath;
-        FString OutError;
-        
-        if (ImportFile(SourcePath, DestinationPath, AssetName, bReplaceExisting, bAutomated, bSave, OutAssetPath, OutError))
+        const FString Extension = FPaths::GetExtension(SourcePath).ToLower();
+        if (!SharedFbxFactory && (Extension == TEXT("fbx") || Extension == TEXT("glb") || Extension == TEXT("gltf")))
         {
-            Imported++;
-            TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-            ResultObj->SetStringField(TEXT("source"), SourcePath);
-            ResultObj->SetStringField(TEXT("asset_path"), OutAssetPath);
-            Results.Add(ResultObj);
+            SharedFbxFactory.Reset(CreateFbxFactory());
         }
-        else
+        
+        FPendingImport Item;
+        Item.SourcePath = SourcePath;
+        Item.bSave = bSave;
+        
+        FString OutError;
+        Item.Task.Reset(CreateImportTask(SourcePath, DestinationPath, AssetName, bReplaceExisting, bAutomated,
+            false, SharedFbxFactory.Get(), Item.AssetPath, OutError));
+        if (!Item.Task)
         {
-            Failed++;
-            TSharedPtr<FJsonObject> ErrorObj = MakeShared<FJsonObject>();
-            ErrorObj->SetStringField(TEXT("source"), SourcePath);
-            ErrorObj->SetStringField(TEXT("error"), OutError);
-            Errors.Add(ErrorObj);
-            
+            AddError(SourcePath, OutError);
             if (OnError == TEXT("stop"))
             {
                 break;
             }
+            continue;
+        }
+        Pending.Add(MoveTemp(Item));
+    }
+    
+    // 2. One ImportAssetTasks call for the whole batch
+    if (Pending.Num() > 0)
+    {
+        TArray<UAssetImportTask*> Tasks;
+        Tasks.Reserve(Pending.Num());
+        for (const FPendingImport& Item : Pending)
+        {
+            Tasks.Add(Item.Task.Get());
         }
+        
+        IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools").Get();
+        AssetTools.ImportAssetTasks(Tasks);
+    }
+    
+    // 3. Collect results, then save every requested package in one pass
+    TArray<UObject*> AssetsToSave;
+    TSet<FString> Destinations;
+    for (const FPendingImport& Item : Pending)
+    {
+        const TArray<UObject*>& Objects = Item.Task->GetObjects();
+        if (Objects.Num() == 0)
+        {
+            AddError(Item.SourcePath, FString::Printf(TEXT("Import failed for: %s"), *Item.SourcePath));
+            continue;
+        }
+        
+        UE_LOG(LogTemp, Log, TEXT("Successfully imported: %s -> %s"), *Item.SourcePath, *Item.AssetPath);
+        Imported++;
+        Destinations.Add(Item.Task->DestinationPath);
+        if (Item.bSave)
+        {
+            AssetsToSave.Append(Objects);
+        }
+        
+        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+        ResultObj->SetStringField(TEXT("source"), Item.SourcePath);
+        ResultObj->SetStringField(TEXT("asset_path"), Item.AssetPath);
+        Results.Add(ResultObj);
+    }
+    
+    bool bSaved = true;
+    if (AssetsToSave.Num() > 0)
+    {
+        bSaved = UEditorAssetLibrary::SaveLoadedAssets(AssetsToSave, false);
+    }
+    
+    // Sync Content Browser once per destination folder
+    FUnrealCompanionEditorFocus& Focus = FUnrealCompanionEditorFocus::Get();
+    for (const FString& Destination : Destinations)
+    {
+        Focus.SyncContentBrowser(Destination);
     }
     
     TSharedPtr<FJsonObject> ResponseData = MakeShared<FJsonObject>();
@@ -279,6 +378,11 @@ TSharedPtr<FJsonObject> FUnrealCompanionImportCommands::HandleImportBatch(const
     ResponseData->SetNumberField(TEXT("imported"), Imported);
     ResponseData->SetNumberField(TEXT("failed"), Failed);
     ResponseData->SetNumberField(TEXT("total"), FilesArray->Num());
+    ResponseData->SetNumberField(TEXT("saved_assets"), bSaved ? AssetsToSave.Num() : 0);
+    if (!bSaved)
+    {
+        ResponseData->SetStringField(TEXT("save_warning"), TEXT("Some imported packages could not be saved"));
+    }
     
     if (Results.Num() > 0)
     {
@@ -0,0 +1,349 @@
+#include "Commands/UnrealCompanionJobManager.h"
+#include "Commands/UnrealCompanionCommonUtils.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+
+FUnrealCompanionJobManager& FUnrealCompanionJobManager::Get()
+{
+    static FUnrealCompanionJobManager Instance;
+    return Instance;
+}
+
+FString FUnrealCompanionJobManager::Start(const FString& Command, FHooks Hooks, bool bStreamProgress)
+{
+    check(IsInGameThread());
+
+    TSharedPtr<FJob> Job = MakeShared<FJob>();
+    Job->Id = FString::Printf(TEXT("job-%d"), NextJobNumber++);
+    Job->Command = Command;
+    Job->StartTime = FPlatformTime::Seconds();
+    Job->Hooks = MoveTemp(Hooks);
+    if (bStreamProgress)
+    {
+        Job->EventSink = FUnrealCompanionDeferredResponse::GetEventSink();
+    }
+    Running.Add(Job);
+    EnsureTicker();
+
+    UE_LOG(LogTemp, Display, TEXT("UnrealCompanion: Started %s for %s"), *Job->Id, *Command);
+    return Job->Id;
+}
+
+FUnrealCompanionJobManager::FJob* FUnrealCompanionJobManager::FindJob(const FString& JobId)
+{
+    for (const TSharedPtr<FJob>& Job : Running)
+    {
+        if (Job->Id == JobId)
+        {
+            return Job.Get();
+        }
+    }
+    for (const TSharedPtr<FJob>& Job : Finished)
+    {
+        if (Job->Id == JobId)
+        {
+            return Job.Get();
+        }
+    }
+    return nullptr;
+}
+
+const FUnrealCompanionJobManager::FJob* FUnrealCompanionJobManager::FindJob(const FString& JobId) const
+{
+    return const_cast<FUnrealCompanionJobManager*>(this)->FindJob(JobId);
+}
+
+void FUnrealCompanionJobManager::SetProgress(const FString& JobId, double Progress, const FString& Phase)
+{
+    check(IsInGameThread());
+    FJob* Job = FindJob(JobId);
+    if (!Job || Job->State != EState::Running)
+    {
+        return;
+    }
+
+    const bool bPhaseChanged = !Phase.IsEmpty() && Phase != Job->Phase;
+    Job->Progress = Progress < 0.0 ? -1.0 : FMath::Clamp(Progress, 0.0, 1.0);
+    if (!Phase.IsEmpty())
+    {
+        Job->Phase = Phase;
+    }
+
+    // A phase change is always worth an event; plain progress is throttled
+    const double Now = FPlatformTime::Seconds();
+    if (Job->EventSink && (bPhaseChanged || Now - Job->LastEventTime >= ProgressEventInterval))
+    {
+        Job->LastEventTime = Now;
+        SendEvent(*Job, TEXT("job_progress"));
+    }
+}
+
+void FUnrealCompanionJobManager::Finish(const FString& JobId, const TSharedPtr<FJsonObject>& Result)
+{
+    check(IsInGameThread());
+    const int32 Index = Running.IndexOfByPredicate([&JobId](const TSharedPtr<FJob>& Job) { return Job->Id == JobId; });
+    if (Index == INDEX_NONE)
+    {
+        return;
+    }
+
+    TSharedPtr<FJob> Job = Running[Index];
+    Running.RemoveAt(Index);
+
+    const bool bSuccess = Result.IsValid() && (!Result->HasField(TEXT("success")) || Result->GetBoolField(TEXT("success")));
+    Job->State = Job->bCancelRequested ? EState::Cancelled : (bSuccess ? EState::Succeeded : EState::Failed);
+    Job->EndTime = FPlatformTime::Seconds();
+    Job->Result = Result;
+    if (Job->State == EState::Succeeded)
+    {
+        Job->Progress = 1.0;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("UnrealCompanion: %s (%s) %s after %.1fs"),
+        *Job->Id, *Job->Command, GetStateName(*Job), Job->EndTime - Job->StartTime);
+
+    if (Job->EventSink)
+    {
+        SendEvent(*Job, TEXT("job_finished"));
+        Job->EventSink = nullptr;
+    }
+    Job->Hooks = FHooks();
+
+    Finished.Insert(Job, 0);
+    if (Finished.Num() > MaxFinishedJobs)
+    {
+        Finished.SetNum(MaxFinishedJobs);
+    }
+}
+
+bool FUnrealCompanionJobManager::IsCancelRequested(const FString& JobId) const
+{
+    const FJob* Job = FindJob(JobId);
+    return Job && Job->bCancelRequested;
+}
+
+const TCHAR* FUnrealCompanionJobManager::GetStateName(const FJob& Job)
+{
+    switch (Job.State)
+    {
+    case EState::Running:   return Job.bCancelRequested ? TEXT("cancelling") : TEXT("running");
+    case EState::Succeeded: return TEXT("succeeded");
+    case EState::Failed:    return TEXT("failed");
+    case EState::Cancelled: return TEXT("cancelled");
+    }
+    return TEXT("unknown");
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionJobManager::BuildJobJson(const FJob& Job, bool bIncludeResult) const
+{
+    const double EndTime = Job.State == EState::Running ? FPlatformTime::Seconds() : Job.EndTime;
+
+    TSharedPtr<FJsonObject> JobObj = MakeShared<FJsonObject>();
+    JobObj->SetStringField(TEXT("job_id"), Job.Id);
+    JobObj->SetStringField(TEXT("command"), Job.Command);
+    JobObj->SetStringField(TEXT("status"), GetStateName(Job));
+    JobObj->SetNumberField(TEXT("progress"), Job.Progress);
+    if (!Job.Phase.IsEmpty())
+    {
+        JobObj->SetStringField(TEXT("phase"), Job.Phase);
+    }
+    JobObj->SetBoolField(TEXT("cancellable"), Job.State == EState::Running && Job.Hooks.Cancel != nullptr);
+    JobObj->SetNumberField(TEXT("elapsed_ms"), (EndTime - Job.StartTime) * 1000.0);
+    if (bIncludeResult && Job.Result.IsValid())
+    {
+        JobObj->SetObjectField(TEXT("result"), Job.Result);
+    }
+    return JobObj;
+}
+
+void FUnrealCompanionJobManager::SendEvent(FJob& Job, const TCHAR* Event)
+{
+    // Frames are sent from background tasks and may overtake each other; seq restores their order
+    TSharedPtr<FJsonObject> Payload = BuildJobJson(Job, /*bIncludeResult=*/true);
+    Payload->SetNumberField(TEXT("seq"), ++Job.EventSeq);
+    Job.EventSink(Event, Payload);
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionJobManager::BuildStartedResponse(const FString& JobId) const
+{
+    const FJob* Job = FindJob(JobId);
+    if (!Job)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Job not found: %s"), *JobId));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = BuildJobJson(*Job, /*bIncludeResult=*/true);
+    ResultObj->SetBoolField(TEXT("success"), true);
+    ResultObj->SetBoolField(TEXT("streaming"), Job->EventSink != nullptr);
+    ResultObj->SetStringField(TEXT("suggestion"), TEXT("Poll job_status with this job_id (core_query type='job'), or job_cancel to stop it"));
+    return ResultObj;
+}
+
+TConstArrayView<TMCPCommandEntry<FUnrealCompanionJobManager>> FUnrealCompanionJobManager::GetCommandTable()
+{
+    static constexpr TMCPCommandEntry<FUnrealCompanionJobManager> Table[] = {
+        { TEXT("job_status"), &FUnrealCompanionJobManager::HandleStatus },
+        { TEXT("job_list"), &FUnrealCompanionJobManager::HandleList },
+        { TEXT("job_cancel"), &FUnrealCompanionJobManager::HandleCancel },
+    };
+    static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+    return Table;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionJobManager::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    if (TSharedPtr<FJsonObject> Result = UnrealCompanionCommandTable::Dispatch(*this, GetCommandTable(), CommandType, Params))
+    {
+        return Result;
+    }
+
+    return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown job command: %s"), *CommandType));
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionJobManager::HandleStatus(const TSharedPtr<FJsonObject>& Params)
+{
+    FString JobId;
+    if (!Params->TryGetStringField(TEXT("job_id"), JobId) || JobId.IsEmpty())
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing 'job_id' parameter"));
+    }
+
+    const FJob* Job = FindJob(JobId);
+    if (!Job)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+            TEXT("JOB_NOT_FOUND"),
+            FString::Printf(TEXT("Job not found: %s"), *JobId),
+            FString::Printf(TEXT("Only the last %d finished jobs are kept; job_list shows them"), MaxFinishedJobs));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = BuildJobJson(*Job, /*bIncludeResult=*/true);
+    ResultObj->SetBoolField(TEXT("success"), true);
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionJobManager::HandleList(const TSharedPtr<FJsonObject>& Params)
+{
+    bool bRunningOnly = false;
+    Params->TryGetBoolField(TEXT("running_only"), bRunningOnly);
+
+    TArray<TSharedPtr<FJsonValue>> JobsArray;
+    for (const TSharedPtr<FJob>& Job : Running)
+    {
+        JobsArray.Add(MakeShared<FJsonValueObject>(BuildJobJson(*Job, /*bIncludeResult=*/false)));
+    }
+    if (!bRunningOnly)
+    {
+        for (const TSharedPtr<FJob>& Job : Finished)
+        {
+            JobsArray.Add(MakeShared<FJsonValueObject>(BuildJobJson(*Job, /*bIncludeResult=*/false)));
+        }
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetBoolField(TEXT("success"), true);
+    ResultObj->SetNumberField(TEXT("running"), Running.Num());
+    ResultObj->SetArrayField(TEXT("jobs"), JobsArray);
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionJobManager::HandleCancel(const TSharedPtr<FJsonObject>& Params)
+{
+    FString JobId;
+    if (!Params->TryGetStringField(TEXT("job_id"), JobId) || JobId.IsEmpty())
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing 'job_id' parameter"));
+    }
+
+    FJob* Job = FindJob(JobId);
+    if (!Job)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+            TEXT("JOB_NOT_FOUND"), FString::Printf(TEXT("Job not found: %s"), *JobId), TEXT("job_list shows known jobs"));
+    }
+    if (Job->State != EState::Running)
+    {
+        TSharedPtr<FJsonObject> ResultObj = BuildJobJson(*Job, /*bIncludeResult=*/false);
+        ResultObj->SetBoolField(TEXT("success"), true);
+        ResultObj->SetStringField(TEXT("message"), TEXT("Job already finished"));
+        return ResultObj;
+    }
+    if (!Job->Hooks.Cancel)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+            TEXT("JOB_NOT_CANCELLABLE"),
+            FString::Printf(TEXT("%s cannot be cancelled from here"), *Job->Command),
+            TEXT("Wait for it to finish (job_status)"));
+    }
+
+    // The owner winds down and calls Finish, possibly right here; the job ends as cancelled either way
+    const FString Id = Job->Id;
+    if (!Job->bCancelRequested)
+    {
+        Job->bCancelRequested = true;
+        TFunction<void(const FString&)> Cancel = Job->Hooks.Cancel;
+        Cancel(Id);
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = BuildJobJson(*FindJob(Id), /*bIncludeResult=*/false);
+    ResultObj->SetBoolField(TEXT("success"), true);
+    return ResultObj;
+}
+
+void FUnrealCompanionJobManager::EnsureTicker()
+{
+    if (!TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateRaw(this, &FUnrealCompanionJobManager::Tick));
+    }
+}
+
+bool FUnrealCompanionJobManager::Tick(float DeltaTime)
+{
+    // Hooks may finish their job (or start another), so walk a snapshot
+    const TArray<TSharedPtr<FJob>> Snapshot = Running;
+    for (const TSharedPtr<FJob>& Job : Snapshot)
+    {
+        if (Job->State == EState::Running && Job->Hooks.Tick)
+        {
+            TFunction<void(const FString&)> JobTick = Job->Hooks.Tick;
+            JobTick(Job->Id);
+        }
+    }
+
+    if (Running.Num() > 0)
+    {
+        return true;
+    }
+    TickerHandle.Reset();
+    return false;
+}
+
+void FUnrealCompanionJobManager::Shutdown()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+
+    const TArray<TSharedPtr<FJob>> Snapshot = Running;
+    for (const TSharedPtr<FJob>& Job : Snapshot)
+    {
+        if (Job->State == EState::Running && Job->Hooks.Cancel && !Job->bCancelRequested)
+        {
+            Job->bCancelRequested = true;
+            TFunction<void(const FString&)> Cancel = Job->Hooks.Cancel;
+            Cancel(Job->Id);
+        }
+    }
+
+    // Nobody will be polling these after the bridge is gone
+    for (const TSharedPtr<FJob>& Job : Running)
+    {
+        Job->EventSink = nullptr;
+    }
+    Running.Reset();
+    Finished.Reset();
+}
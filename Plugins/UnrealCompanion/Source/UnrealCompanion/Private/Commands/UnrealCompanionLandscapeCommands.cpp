@@ -1,39 +1,49 @@
 #include "Commands/UnrealCompanionLandscapeCommands.h"
 #include "Commands/UnrealCompanionCommonUtils.h"
+#include "Commands/UnrealCompanionHeightfieldCache.h"
+#include "MCPSharedMemory.h"
+#include "UnrealCompanionStats.h"
 #include "Editor.h"
 #include "Landscape.h"
 #include "LandscapeProxy.h"
 #include "LandscapeInfo.h"
 #include "LandscapeComponent.h"
 #include "LandscapeEdit.h"
+#include "LandscapeDataAccess.h"
 #include "Kismet/GameplayStatics.h"
 #include "IImageWrapperModule.h"
 #include "IImageWrapper.h"
 #include "Misc/FileHelper.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Math/VectorRegister.h"
+#include "Async/ParallelFor.h"
+#include "Math/Float16.h"
+#include "Misc/Base64.h"
 
 FUnrealCompanionLandscapeCommands::FUnrealCompanionLandscapeCommands()
 {
 }
 
+TConstArrayView<TMCPCommandEntry<FUnrealCompanionLandscapeCommands>> FUnrealCompanionLandscapeCommands::GetCommandTable()
+{
+    static constexpr TMCPCommandEntry<FUnrealCompanionLandscapeCommands> Table[] = {
+        { TEXT("landscape_create"), &FUnrealCompanionLandscapeCommands::HandleCreateLandscape },
+        { TEXT("landscape_sculpt"), &FUnrealCompanionLandscapeCommands::HandleSculptLandscape },
+        { TEXT("landscape_import_heightmap"), &FUnrealCompanionLandscapeCommands::HandleImportHeightmap },
+        { TEXT("landscape_paint_layer"), &FUnrealCompanionLandscapeCommands::HandlePaintLayer },
+        { TEXT("landscape_read_heights"), &FUnrealCompanionLandscapeCommands::HandleReadHeights },
+    };
+    static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+    return Table;
+}
+
 TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-    if (CommandType == TEXT("landscape_create"))
+    if (TSharedPtr<FJsonObject> Result = UnrealCompanionCommandTable::Dispatch(*this, GetCommandTable(), CommandType, Params))
     {
-        return HandleCreateLandscape(Params);
+        return Result;
     }
-    else if (CommandType == TEXT("landscape_sculpt"))
-    {
-        return HandleSculptLandscape(Params);
-    }
-    else if (CommandType == TEXT("landscape_import_heightmap"))
-    {
-        return HandleImportHeightmap(Params);
-    }
-    else if (CommandType == TEXT("landscape_paint_layer"))
-    {
-        return HandlePaintLayer(Params);
-    }
-
     return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown landscape command: %s"), *CommandType));
 }
 
@@ -217,6 +227,8 @@ TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandleCreateLandscape
 
 TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandleSculptLandscape(const TSharedPtr<FJsonObject>& Params)
 {
+    UNREALCOMPANION_SCOPE_CYCLE_COUNTER(STAT_UnrealCompanion_LandscapeSculpt);
+
     FString ActorName;
     if (!Params->TryGetStringField(TEXT("actor_name"), ActorName))
     {
@@ -251,10 +263,24 @@ TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandleSculptLandscape
     const FVector LandscapeOrigin = Landscape->GetActorLocation();
     const FVector LandscapeScale = Landscape->GetActorScale3D();
 
+    // Pass 1: resolve every op to its grid window so the heightmap is read and written once
+    struct FSculptOp
+    {
+        TSharedPtr<FJsonObject> Params;
+        FString Type;
+        int32 CenterGridX;
+        int32 CenterGridY;
+        int32 RadiusInGrid;
+        float Intensity;
+        EMCPBrushFalloff Falloff;
+        FIntRect Region;
+    };
+
+    TArray<FSculptOp> Ops;
+    Ops.Reserve(OperationsArray->Num());
+    FIntRect DirtyRegion;
     int32 TotalVerticesModified = 0;
-    int32 OperationsCompleted = 0;
 
-    // Process each operation
     for (const TSharedPtr<FJsonValue>& OpValue : *OperationsArray)
     {
         const TSharedPtr<FJsonObject>& Op = OpValue->AsObject();
@@ -264,6 +290,13 @@ TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandleSculptLandscape
         if (!Op->TryGetStringField(TEXT("type"), OpType))
             continue;
 
+        OpType = OpType.ToLower();
+        if (OpType != TEXT("raise") && OpType != TEXT("lower") && OpType != TEXT("flatten") && OpType != TEXT("smooth") &&
+            OpType != TEXT("noise") && OpType != TEXT("crater") && OpType != TEXT("canyon"))
+        {
+            continue; // Skip unknown operations
+        }
+
         // Parse common parameters
         FVector2D Center(0.0f, 0.0f);
         if (Op->HasField(TEXT("center")))
@@ -293,44 +326,78 @@ TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandleSculptLandscape
         int32 CenterGridY = FMath::RoundToInt(LocalCenter.Y);
         int32 RadiusInGrid = FMath::CeilToInt(Radius / LandscapeScale.X);
 
+        // The crater rim reaches 1.3x the radius
+        const int32 Reach = OpType == TEXT("crater") ? FMath::CeilToInt(RadiusInGrid * 1.3f) : RadiusInGrid;
+
         // Clamp to landscape bounds
-        int32 MinX = FMath::Clamp(CenterGridX - RadiusInGrid, LandscapeExtent.Min.X, LandscapeExtent.Max.X);
-        int32 MinY = FMath::Clamp(CenterGridY - RadiusInGrid, LandscapeExtent.Min.Y, LandscapeExtent.Max.Y);
-        int32 MaxX = FMath::Clamp(CenterGridX + RadiusInGrid, LandscapeExtent.Min.X, LandscapeExtent.Max.X);
-        int32 MaxY = FMath::Clamp(CenterGridY + RadiusInGrid, LandscapeExtent.Min.Y, LandscapeExtent.Max.Y);
+        int32 MinX = FMath::Clamp(CenterGridX - Reach, LandscapeExtent.Min.X, LandscapeExtent.Max.X);
+        int32 MinY = FMath::Clamp(CenterGridY - Reach, LandscapeExtent.Min.Y, LandscapeExtent.Max.Y);
+        int32 MaxX = FMath::Clamp(CenterGridX + Reach, LandscapeExtent.Min.X, LandscapeExtent.Max.X);
+        int32 MaxY = FMath::Clamp(CenterGridY + Reach, LandscapeExtent.Min.Y, LandscapeExtent.Max.Y);
 
         int32 Width = MaxX - MinX + 1;
         int32 Height = MaxY - MinY + 1;
 
         if (Width <= 0 || Height <= 0) continue;
 
-        // Read current heightmap data via FLandscapeEditDataInterface
-        FLandscapeEditDataInterface LandscapeEdit(LandscapeInfo);
-        TArray<uint16> HeightmapData;
+        const FIntRect Region(MinX, MinY, MaxX, MaxY);
+        if (Ops.Num() == 0)
+        {
+            DirtyRegion = Region;
+        }
+        else
+        {
+            DirtyRegion.Union(Region);
+        }
+
+        Ops.Add({ Op, OpType, CenterGridX, CenterGridY, RadiusInGrid, Intensity, ParseFalloff(FalloffType), Region });
+        TotalVerticesModified += Width * Height;
+    }
+
+    // Pass 2: one read of the union of all op windows
+    const int32 Width = DirtyRegion.Max.X - DirtyRegion.Min.X + 1;
+    const int32 Height = DirtyRegion.Max.Y - DirtyRegion.Min.Y + 1;
+    TArray<uint16> HeightmapData;
+    TSet<ULandscapeComponent*> TouchedComponents;
+
+    FLandscapeEditDataInterface LandscapeEdit(LandscapeInfo);
+    if (Ops.Num() > 0)
+    {
+        UNREALCOMPANION_TRACE_SCOPE("LandscapeSculpt.ReadHeights");
         HeightmapData.SetNum(Width * Height);
-        LandscapeEdit.GetHeightData(MinX, MinY, MaxX, MaxY, HeightmapData.GetData(), 0);
+        LandscapeEdit.GetHeightData(DirtyRegion.Min.X, DirtyRegion.Min.Y, DirtyRegion.Max.X, DirtyRegion.Max.Y, HeightmapData.GetData(), 0);
+    }
+
+    // Pass 3: apply every op in memory, in request order
+    for (const FSculptOp& SculptOp : Ops)
+    {
+        UNREALCOMPANION_TRACE_SCOPE("LandscapeSculpt.ApplyOp");
+        const TSharedPtr<FJsonObject>& Op = SculptOp.Params;
+        const FString& OpType = SculptOp.Type;
+        const int32 RadiusInGrid = SculptOp.RadiusInGrid;
+        const float Intensity = SculptOp.Intensity;
+        const EMCPBrushFalloff Falloff = SculptOp.Falloff;
 
         // Adjust center to be relative to our data window
-        int32 LocalCX = CenterGridX - MinX;
-        int32 LocalCY = CenterGridY - MinY;
+        int32 LocalCX = SculptOp.CenterGridX - DirtyRegion.Min.X;
+        int32 LocalCY = SculptOp.CenterGridY - DirtyRegion.Min.Y;
 
         // Apply the operation
-        OpType = OpType.ToLower();
         if (OpType == TEXT("raise"))
         {
-            ApplyRaise(HeightmapData, Width, Height, LocalCX, LocalCY, RadiusInGrid, Intensity, FalloffType);
+            ApplyRaise(HeightmapData, Width, Height, LocalCX, LocalCY, RadiusInGrid, Intensity, Falloff);
         }
         else if (OpType == TEXT("lower"))
         {
-            ApplyLower(HeightmapData, Width, Height, LocalCX, LocalCY, RadiusInGrid, Intensity, FalloffType);
+            ApplyLower(HeightmapData, Width, Height, LocalCX, LocalCY, RadiusInGrid, Intensity, Falloff);
         }
         else if (OpType == TEXT("flatten"))
         {
-            ApplyFlatten(HeightmapData, Width, Height, LocalCX, LocalCY, RadiusInGrid, Intensity, FalloffType);
+            ApplyFlatten(HeightmapData, Width, Height, LocalCX, LocalCY, RadiusInGrid, Intensity, Falloff);
         }
         else if (OpType == TEXT("smooth"))
         {
-            ApplySmooth(HeightmapData, Width, Height, LocalCX, LocalCY, RadiusInGrid, Intensity, FalloffType);
+            ApplySmooth(HeightmapData, Width, Height, LocalCX, LocalCY, RadiusInGrid, Intensity, Falloff);
         }
         else if (OpType == TEXT("noise"))
         {
@@ -341,7 +408,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandleSculptLandscape
             if (Op->HasField(TEXT("octaves"))) Octaves = FMath::Clamp((int32)Op->GetNumberField(TEXT("octaves")), 1, 8);
             if (Op->HasField(TEXT("amplitude"))) Amplitude = FMath::Clamp((float)Op->GetNumberField(TEXT("amplitude")), 0.0f, 1.0f);
 
-            ApplyNoise(HeightmapData, Width, Height, LocalCX, LocalCY, RadiusInGrid, Intensity, FalloffType, Frequency, Octaves, Amplitude);
+            ApplyNoise(HeightmapData, Width, Height, LocalCX, LocalCY, RadiusInGrid, Intensity, Falloff, Frequency, Octaves, Amplitude);
         }
         else if (OpType == TEXT("crater"))
         {
@@ -350,7 +417,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandleSculptLandscape
             if (Op->HasField(TEXT("depth"))) Depth = FMath::Clamp((float)Op->GetNumberField(TEXT("depth")), 0.0f, 1.0f);
             if (Op->HasField(TEXT("rim_height"))) RimHeight = FMath::Clamp((float)Op->GetNumberField(TEXT("rim_height")), 0.0f, 1.0f);
 
-            ApplyCrater(HeightmapData, Width, Height, LocalCX, LocalCY, RadiusInGrid, Depth, RimHeight, FalloffType);
+            ApplyCrater(HeightmapData, Width, Height, LocalCX, LocalCY, RadiusInGrid, Depth, RimHeight, Falloff);
         }
         else if (OpType == TEXT("canyon"))
         {
@@ -374,23 +441,26 @@ TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandleSculptLandscape
 
             ApplyCanyon(HeightmapData, Width, Height, LocalCX, LocalCY, RadiusInGrid, Direction, Depth, CanyonWidth, Roughness);
         }
-        else
-        {
-            continue; // Skip unknown operations
-        }
 
-        // Write back modified data (bCalcNormals = true)
-        LandscapeEdit.SetHeightData(MinX, MinY, MaxX, MaxY, HeightmapData.GetData(), 0, true);
-        LandscapeEdit.Flush();
+        // Only the components under this op's window need a visual refresh
+        LandscapeInfo->GetComponentsInRegion(SculptOp.Region.Min.X, SculptOp.Region.Min.Y,
+            SculptOp.Region.Max.X, SculptOp.Region.Max.Y, TouchedComponents);
+    }
 
-        TotalVerticesModified += Width * Height;
-        OperationsCompleted++;
+    const int32 OperationsCompleted = Ops.Num();
+
+    // Pass 4: one write back (bCalcNormals = true)
+    if (Ops.Num() > 0)
+    {
+        UNREALCOMPANION_TRACE_SCOPE("LandscapeSculpt.WriteHeights");
+        LandscapeEdit.SetHeightData(DirtyRegion.Min.X, DirtyRegion.Min.Y, DirtyRegion.Max.X, DirtyRegion.Max.Y, HeightmapData.GetData(), 0, true);
+        LandscapeEdit.Flush();
+        FUnrealCompanionHeightfieldCache::Get().Invalidate(LandscapeInfo, DirtyRegion);
     }
 
-    // Step 1: Update visual heightmap for all components (this was proven to work)
-    for (const auto& Pair : LandscapeInfo->XYtoComponentMap)
+    // Step 1: Update visual heightmap for the touched components
+    for (ULandscapeComponent* Comp : TouchedComponents)
     {
-        ULandscapeComponent* Comp = Pair.Value;
         if (Comp)
         {
             Comp->RequestHeightmapUpdate();
@@ -399,11 +469,17 @@ TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandleSculptLandscape
     }
 
     // Step 2: Commit visual changes first
-    Landscape->PostEditChange();
+    {
+        UNREALCOMPANION_TRACE_SCOPE("LandscapeSculpt.PostEditChange");
+        Landscape->PostEditChange();
+    }
 
     // Step 3: Now rebuild collision from the committed heightmap data
     // This must happen AFTER PostEditChange so heightmap textures are finalized
-    Landscape->RecreateCollisionComponents();
+    {
+        UNREALCOMPANION_TRACE_SCOPE("LandscapeSculpt.RebuildCollision");
+        Landscape->RecreateCollisionComponents();
+    }
 
     // Step 4: Force viewport redraw
     if (GEditor)
@@ -416,6 +492,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandleSculptLandscape
     ResultObj->SetBoolField(TEXT("success"), true);
     ResultObj->SetNumberField(TEXT("operations_completed"), OperationsCompleted);
     ResultObj->SetNumberField(TEXT("vertices_modified"), TotalVerticesModified);
+    ResultObj->SetNumberField(TEXT("components_updated"), TouchedComponents.Num());
     return ResultObj;
 }
 
@@ -454,59 +531,90 @@ TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandleImportHeightmap
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to get LandscapeInfo"));
     }
 
-    // Load the image file
-    TArray<uint8> RawFileData;
-    if (!FFileHelper::LoadFileToArray(RawFileData, *HeightmapPath))
+    // Rows of landscape written per SetHeightData call; bounds peak memory for RAW sources
+    int32 ChunkRows = 256;
+    if (Params->HasField(TEXT("chunk_rows")))
+        ChunkRows = FMath::Clamp((int32)Params->GetNumberField(TEXT("chunk_rows")), 16, 8192);
+
+    // Get landscape extent
+    FIntRect LandscapeExtent;
+    if (!LandscapeInfo->GetLandscapeExtent(LandscapeExtent))
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to get landscape extent"));
+    }
+
+    int32 LandscapeWidth = LandscapeExtent.Max.X - LandscapeExtent.Min.X + 1;
+    int32 LandscapeHeight = LandscapeExtent.Max.Y - LandscapeExtent.Min.Y + 1;
+
+    // Sniff the header only: RAW files are streamed and never loaded whole
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenRead(*HeightmapPath));
+    if (!FileHandle)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Failed to load file: %s"), *HeightmapPath));
+    }
+    const int64 FileSize = FileHandle->Size();
+
+    TArray<uint8> Header;
+    Header.SetNumUninitialized((int32)FMath::Min<int64>(FileSize, 4096));
+    if (Header.Num() == 0 || !FileHandle->Read(Header.GetData(), Header.Num()))
     {
         return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Failed to load file: %s"), *HeightmapPath));
     }
 
     // Determine format and decode
     IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-    EImageFormat ImageFormat = ImageWrapperModule.DetectImageFormat(RawFileData.GetData(), RawFileData.Num());
+    EImageFormat ImageFormat = ImageWrapperModule.DetectImageFormat(Header.GetData(), Header.Num());
 
     int32 ImageWidth = 0;
     int32 ImageHeight = 0;
+    int32 BytesPerPixel = 2;
     TArray<uint8> DecodedData;
+    const bool bStreamed = ImageFormat == EImageFormat::Invalid;
 
-    if (ImageFormat != EImageFormat::Invalid)
+    if (!bStreamed)
     {
-        // It's an image file (PNG, etc.)
-        TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(ImageFormat);
-        if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(RawFileData.GetData(), RawFileData.Num()))
+        // It's an image file (PNG, etc.): compressed formats have to be decoded whole,
+        // but the compressed copy is released before conversion starts
+        FileHandle.Reset();
         {
-            return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to decode image"));
-        }
-
-        ImageWidth = ImageWrapper->GetWidth();
-        ImageHeight = ImageWrapper->GetHeight();
+            TArray<uint8> RawFileData;
+            if (!FFileHelper::LoadFileToArray(RawFileData, *HeightmapPath))
+            {
+                return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Failed to load file: %s"), *HeightmapPath));
+            }
 
-        if (!ImageWrapper->GetRaw(ERGBFormat::Gray, 16, DecodedData))
-        {
-            // Try 8-bit grayscale
-            if (!ImageWrapper->GetRaw(ERGBFormat::Gray, 8, DecodedData))
+            TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(ImageFormat);
+            if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(RawFileData.GetData(), RawFileData.Num()))
             {
-                return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to extract grayscale data from image"));
+                return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to decode image"));
             }
-            // Convert 8-bit to 16-bit
-            TArray<uint8> Data16;
-            Data16.SetNum(DecodedData.Num() * 2);
-            for (int32 i = 0; i < DecodedData.Num(); i++)
+            RawFileData.Empty();
+
+            ImageWidth = ImageWrapper->GetWidth();
+            ImageHeight = ImageWrapper->GetHeight();
+
+            if (!ImageWrapper->GetRaw(ERGBFormat::Gray, 16, DecodedData))
             {
-                uint16 Val = (uint16)DecodedData[i] * 257; // Map 0-255 to 0-65535
-                Data16[i * 2] = Val & 0xFF;
-                Data16[i * 2 + 1] = (Val >> 8) & 0xFF;
+                // Try 8-bit grayscale; widened to 16-bit per row during conversion
+                if (!ImageWrapper->GetRaw(ERGBFormat::Gray, 8, DecodedData))
+                {
+                    return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to extract grayscale data from image"));
+                }
+                BytesPerPixel = 1;
             }
-            DecodedData = MoveTemp(Data16);
         }
     }
     else
     {
         // Assume RAW uint16 file - try to figure out dimensions (square)
-        int32 NumPixels = RawFileData.Num() / 2;
-        ImageWidth = FMath::RoundToInt(FMath::Sqrt((float)NumPixels));
+        int64 NumPixels = FileSize / 2;
+        ImageWidth = FMath::RoundToInt(FMath::Sqrt((double)NumPixels));
         ImageHeight = ImageWidth;
-        DecodedData = MoveTemp(RawFileData);
+        if ((int64)ImageWidth * ImageHeight * 2 > FileSize)
+        {
+            return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("RAW heightmap is not a square uint16 image"));
+        }
     }
 
     if (ImageWidth <= 0 || ImageHeight <= 0)
@@ -514,49 +622,77 @@ TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandleImportHeightmap
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Invalid image dimensions"));
     }
 
-    // Get landscape extent
-    FIntRect LandscapeExtent;
-    if (!LandscapeInfo->GetLandscapeExtent(LandscapeExtent))
+    const int64 ImageRowBytes = (int64)ImageWidth * BytesPerPixel;
+    auto ImageRowForLandscapeRow = [&](int32 Y)
     {
-        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to get landscape extent"));
+        float V = (float)Y / (float)(LandscapeHeight - 1) * (ImageHeight - 1);
+        return FMath::Clamp(FMath::FloorToInt(V), 0, ImageHeight - 1);
+    };
+
+    // Image columns are the same for every row
+    TArray<int32> ImageColumns;
+    ImageColumns.SetNumUninitialized(LandscapeWidth);
+    for (int32 X = 0; X < LandscapeWidth; X++)
+    {
+        float U = (float)X / (float)(LandscapeWidth - 1) * (ImageWidth - 1);
+        ImageColumns[X] = FMath::Clamp(FMath::FloorToInt(U), 0, ImageWidth - 1);
     }
 
-    int32 LandscapeWidth = LandscapeExtent.Max.X - LandscapeExtent.Min.X + 1;
-    int32 LandscapeHeight = LandscapeExtent.Max.Y - LandscapeExtent.Min.Y + 1;
-
-    // Read current heightmap via FLandscapeEditDataInterface
     FLandscapeEditDataInterface LandscapeEdit(LandscapeInfo);
-    TArray<uint16> HeightmapData;
-    HeightmapData.SetNum(LandscapeWidth * LandscapeHeight);
-    LandscapeEdit.GetHeightData(LandscapeExtent.Min.X, LandscapeExtent.Min.Y,
-        LandscapeExtent.Max.X, LandscapeExtent.Max.Y, HeightmapData.GetData(), 0);
-
-    // Map image data onto landscape
-    const uint16* ImageData16 = reinterpret_cast<const uint16*>(DecodedData.GetData());
+    TArray<uint16> ChunkHeights;
+    TArray<uint8> ChunkSource;
+    int32 ChunksWritten = 0;
 
-    for (int32 Y = 0; Y < LandscapeHeight; Y++)
+    for (int32 ChunkY0 = 0; ChunkY0 < LandscapeHeight; ChunkY0 += ChunkRows)
     {
-        for (int32 X = 0; X < LandscapeWidth; X++)
+        // Rewrite the previous chunk's last row so normals along the seam see both sides
+        const int32 WriteY0 = FMath::Max(ChunkY0 - 1, 0);
+        const int32 WriteY1 = FMath::Min(ChunkY0 + ChunkRows - 1, LandscapeHeight - 1);
+        const int32 ImageY0 = ImageRowForLandscapeRow(WriteY0);
+        const int32 ImageY1 = ImageRowForLandscapeRow(WriteY1);
+
+        const uint8* SourceRows = nullptr;
+        if (bStreamed)
         {
-            // Sample from image with bilinear coordinates
-            float U = (float)X / (float)(LandscapeWidth - 1) * (ImageWidth - 1);
-            float V = (float)Y / (float)(LandscapeHeight - 1) * (ImageHeight - 1);
-            int32 IX = FMath::Clamp(FMath::FloorToInt(U), 0, ImageWidth - 1);
-            int32 IY = FMath::Clamp(FMath::FloorToInt(V), 0, ImageHeight - 1);
-
-            uint16 SampledValue = ImageData16[IX + IY * ImageWidth];
+            ChunkSource.SetNumUninitialized((ImageY1 - ImageY0 + 1) * ImageRowBytes);
+            if (!FileHandle->Seek(ImageY0 * ImageRowBytes) || !FileHandle->Read(ChunkSource.GetData(), ChunkSource.Num()))
+            {
+                return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(
+                    TEXT("Failed to read heightmap rows %d-%d (landscape partially imported up to row %d)"), ImageY0, ImageY1, WriteY0));
+            }
+            SourceRows = ChunkSource.GetData();
+        }
+        else
+        {
+            SourceRows = DecodedData.GetData() + ImageY0 * ImageRowBytes;
+        }
 
-            // Blend with scale factor around center height
-            float NormalizedHeight = ((float)SampledValue / 65535.0f) * 2.0f - 1.0f; // -1 to 1
-            int32 NewHeight = 32768 + (int32)(NormalizedHeight * ScaleZ * 16384.0f);
-            HeightmapData[X + Y * LandscapeWidth] = (uint16)FMath::Clamp(NewHeight, 0, 65534);
+        ChunkHeights.SetNumUninitialized(LandscapeWidth * (WriteY1 - WriteY0 + 1));
+        for (int32 Y = WriteY0; Y <= WriteY1; Y++)
+        {
+            const uint8* Source = SourceRows + (ImageRowForLandscapeRow(Y) - ImageY0) * ImageRowBytes;
+            uint16* Dest = ChunkHeights.GetData() + (Y - WriteY0) * LandscapeWidth;
+            for (int32 X = 0; X < LandscapeWidth; X++)
+            {
+                const int32 IX = ImageColumns[X];
+                uint16 SampledValue = BytesPerPixel == 2
+                    ? reinterpret_cast<const uint16*>(Source)[IX]
+                    : (uint16)Source[IX] * 257; // Map 0-255 to 0-65535
+
+                // Blend with scale factor around center height
+                float NormalizedHeight = ((float)SampledValue / 65535.0f) * 2.0f - 1.0f; // -1 to 1
+                int32 NewHeight = 32768 + (int32)(NormalizedHeight * ScaleZ * 16384.0f);
+                Dest[X] = (uint16)FMath::Clamp(NewHeight, 0, 65534);
+            }
         }
-    }
 
-    // Write back (bCalcNormals = true)
-    LandscapeEdit.SetHeightData(LandscapeExtent.Min.X, LandscapeExtent.Min.Y,
-        LandscapeExtent.Max.X, LandscapeExtent.Max.Y, HeightmapData.GetData(), 0, true);
-    LandscapeEdit.Flush();
+        // Write back (bCalcNormals = true)
+        LandscapeEdit.SetHeightData(LandscapeExtent.Min.X, LandscapeExtent.Min.Y + WriteY0,
+            LandscapeExtent.Max.X, LandscapeExtent.Min.Y + WriteY1, ChunkHeights.GetData(), 0, true);
+        LandscapeEdit.Flush();
+        ChunksWritten++;
+    }
+    FUnrealCompanionHeightfieldCache::Get().Invalidate(LandscapeInfo);
 
     // Step 1: Update visual heightmap
     for (const auto& Pair : LandscapeInfo->XYtoComponentMap)
@@ -588,6 +724,8 @@ TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandleImportHeightmap
     ResultObj->SetNumberField(TEXT("landscape_width"), LandscapeWidth);
     ResultObj->SetNumberField(TEXT("landscape_height"), LandscapeHeight);
     ResultObj->SetNumberField(TEXT("vertices_modified"), LandscapeWidth * LandscapeHeight);
+    ResultObj->SetBoolField(TEXT("streamed"), bStreamed);
+    ResultObj->SetNumberField(TEXT("chunks"), ChunksWritten);
     return ResultObj;
 }
 
@@ -595,158 +733,327 @@ TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandleImportHeightmap
 // SCULPT OPERATION HELPERS
 // =============================================================================
 
-float FUnrealCompanionLandscapeCommands::CalculateFalloff(float NormalizedDistance, const FString& FalloffType)
+namespace
 {
-    if (NormalizedDistance >= 1.0f) return 0.0f;
-    if (NormalizedDistance <= 0.0f) return 1.0f;
-
-    if (FalloffType == TEXT("hard"))
+    /**
+     * Per-op brush constants. Kernels only visit the rows and per-row texel spans
+     * that lie inside the brush circle, evaluate distance/falloff four texels at a
+     * time, and run tile by tile on worker threads.
+     */
+    struct FBrushKernel
     {
-        return NormalizedDistance < 0.95f ? 1.0f : 0.0f;
-    }
-    else if (FalloffType == TEXT("linear"))
+        /** 64x64 uint16 texels = 8 KB per tile, comfortably inside L1/L2 */
+        static constexpr int32 TileSize = 64;
+
+        /** Below this many texels the brush runs inline: task overhead would dominate */
+        static constexpr int64 MinParallelTexels = 16 * 1024;
+
+        int32 Width;
+        int32 Height;
+        float CenterX;
+        float CenterY;
+        float Radius;
+        float InvRadius;
+        EMCPBrushFalloff Falloff;
+
+        FBrushKernel(int32 InWidth, int32 InHeight, int32 InCenterX, int32 InCenterY, int32 RadiusInGrid, EMCPBrushFalloff InFalloff)
+            : Width(InWidth)
+            , Height(InHeight)
+            , CenterX((float)InCenterX)
+            , CenterY((float)InCenterY)
+            , Radius((float)FMath::Max(RadiusInGrid, 1))
+            , InvRadius(1.0f / (float)FMath::Max(RadiusInGrid, 1))
+            , Falloff(InFalloff)
+        {
+        }
+
+        /** Rows within Extent * Radius of the centre, clipped to the data window */
+        bool GetRowRange(float Extent, int32 Border, int32& OutY0, int32& OutY1) const
+        {
+            const float Reach = Radius * Extent;
+            OutY0 = FMath::Max(FMath::CeilToInt(CenterY - Reach), Border);
+            OutY1 = FMath::Min(FMath::FloorToInt(CenterY + Reach), Height - 1 - Border);
+            return OutY0 <= OutY1;
+        }
+
+        /** Texel span [X0, X1] of row Y inside Extent * Radius, clipped to the data window */
+        bool GetRowSpan(int32 Y, float Extent, int32 Border, int32& OutX0, int32& OutX1) const
+        {
+            const float Reach = Radius * Extent;
+            const float DY = (float)Y - CenterY;
+            const float HalfChordSq = Reach * Reach - DY * DY;
+            if (HalfChordSq < 0.0f)
+            {
+                return false;
+            }
+            const float HalfChord = FMath::Sqrt(HalfChordSq);
+            OutX0 = FMath::Max(FMath::CeilToInt(CenterX - HalfChord), Border);
+            OutX1 = FMath::Min(FMath::FloorToInt(CenterX + HalfChord), Width - 1 - Border);
+            return OutX0 <= OutX1;
+        }
+
+        /**
+         * Call RowFn(Y, X0, X1, Scratch) for every brush span, split into TileSize x TileSize
+         * tiles that run on ParallelFor. Scratch holds at least Align(TileSize, 4) floats and
+         * is private to the tile. RowFn may only write texels of its own span.
+         */
+        template <typename RowFuncType>
+        void ForEachSpan(float Extent, int32 Border, RowFuncType&& RowFn) const
+        {
+            const float Reach = Radius * Extent;
+            const int32 MinX = FMath::Max(FMath::CeilToInt(CenterX - Reach), Border);
+            const int32 MaxX = FMath::Min(FMath::FloorToInt(CenterX + Reach), Width - 1 - Border);
+            int32 MinY, MaxY;
+            if (MinX > MaxX || !GetRowRange(Extent, Border, MinY, MaxY))
+            {
+                return;
+            }
+
+            const int32 TilesX = (MaxX - MinX) / TileSize + 1;
+            const int32 TilesY = (MaxY - MinY) / TileSize + 1;
+            const int64 Area = (int64)(MaxX - MinX + 1) * (MaxY - MinY + 1);
+            const EParallelForFlags Flags = Area < MinParallelTexels ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+
+            ParallelFor(TilesX * TilesY, [&](int32 TileIndex)
+            {
+                const int32 TileX0 = MinX + (TileIndex % TilesX) * TileSize;
+                const int32 TileY0 = MinY + (TileIndex / TilesX) * TileSize;
+                const int32 TileX1 = FMath::Min(TileX0 + TileSize - 1, MaxX);
+                const int32 TileY1 = FMath::Min(TileY0 + TileSize - 1, MaxY);
+
+                TArray<float, TInlineAllocator<TileSize>> Scratch;
+                Scratch.SetNumUninitialized(TileSize);
+
+                for (int32 Y = TileY0; Y <= TileY1; Y++)
+                {
+                    int32 X0, X1;
+                    if (!GetRowSpan(Y, Extent, Border, X0, X1)) continue;
+                    X0 = FMath::Max(X0, TileX0);
+                    X1 = FMath::Min(X1, TileX1);
+                    if (X0 > X1) continue;
+                    RowFn(Y, X0, X1, Scratch.GetData());
+                }
+            }, Flags);
+        }
+
+        /** Distance / Radius for Count texels starting at (X0, Y) */
+        void ComputeNormDistRow(int32 Y, int32 X0, int32 Count, float* Out) const
+        {
+            const float DY = (float)Y - CenterY;
+            const VectorRegister4Float DYSq = VectorSetFloat1(DY * DY);
+            const VectorRegister4Float Scale = VectorSetFloat1(InvRadius);
+            const VectorRegister4Float LaneStep = VectorSetFloat1(4.0f);
+            const float StartX = (float)X0 - CenterX;
+            VectorRegister4Float DX = MakeVectorRegisterFloat(StartX, StartX + 1.0f, StartX + 2.0f, StartX + 3.0f);
+
+            for (int32 Lane = 0; Lane < Count; Lane += 4)
+            {
+                const VectorRegister4Float DistSq = VectorMultiplyAdd(DX, DX, DYSq);
+                VectorStore(VectorMultiply(VectorSqrt(DistSq), Scale), Out + Lane);
+                DX = VectorAdd(DX, LaneStep);
+            }
+        }
+
+        /** Falloff weight in [0, 1] for Count texels starting at (X0, Y) */
+        void ComputeFalloffRow(int32 Y, int32 X0, int32 Count, float* Out) const
+        {
+            ComputeNormDistRow(Y, X0, Count, Out);
+
+            const VectorRegister4Float One = GlobalVectorConstants::FloatOne;
+            const VectorRegister4Float Zero = GlobalVectorConstants::FloatZero;
+            switch (Falloff)
+            {
+                case EMCPBrushFalloff::Hard:
+                {
+                    const VectorRegister4Float Edge = VectorSetFloat1(0.95f);
+                    for (int32 Lane = 0; Lane < Count; Lane += 4)
+                    {
+                        const VectorRegister4Float D = VectorLoad(Out + Lane);
+                        VectorStore(VectorSelect(VectorCompareLT(D, Edge), One, Zero), Out + Lane);
+                    }
+                    break;
+                }
+                case EMCPBrushFalloff::Linear:
+                {
+                    for (int32 Lane = 0; Lane < Count; Lane += 4)
+                    {
+                        const VectorRegister4Float D = VectorLoad(Out + Lane);
+                        VectorStore(VectorMin(VectorMax(VectorSubtract(One, D), Zero), One), Out + Lane);
+                    }
+                    break;
+                }
+                default:
+                {
+                    // SmoothStep(0, 1, 1 - d) = t * t * (3 - 2t)
+                    const VectorRegister4Float Three = VectorSetFloat1(3.0f);
+                    const VectorRegister4Float Two = VectorSetFloat1(2.0f);
+                    for (int32 Lane = 0; Lane < Count; Lane += 4)
+                    {
+                        const VectorRegister4Float D = VectorLoad(Out + Lane);
+                        const VectorRegister4Float T = VectorMin(VectorMax(VectorSubtract(One, D), Zero), One);
+                        VectorStore(VectorMultiply(VectorMultiply(T, T), VectorNegateMultiplyAdd(Two, T, Three)), Out + Lane);
+                    }
+                    break;
+                }
+            }
+        }
+    };
+}
+
+EMCPBrushFalloff FUnrealCompanionLandscapeCommands::ParseFalloff(const FString& FalloffType)
+{
+    if (FalloffType.Equals(TEXT("hard"), ESearchCase::IgnoreCase))
     {
-        return 1.0f - NormalizedDistance;
+        return EMCPBrushFalloff::Hard;
     }
-    else // smooth (default)
+    else if (FalloffType.Equals(TEXT("linear"), ESearchCase::IgnoreCase))
     {
-        return FMath::SmoothStep(0.0f, 1.0f, 1.0f - NormalizedDistance);
+        return EMCPBrushFalloff::Linear;
     }
+    return EMCPBrushFalloff::Smooth;
 }
 
-void FUnrealCompanionLandscapeCommands::ApplyRaise(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, const FString& FalloffType)
+void FUnrealCompanionLandscapeCommands::ApplyRaise(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, EMCPBrushFalloff Falloff)
 {
-    int32 Delta = (int32)(Intensity * 8000.0f);
-    for (int32 Y = 0; Y < Height; Y++)
+    const FBrushKernel Kernel(Width, Height, CenterX, CenterY, RadiusInGrid, Falloff);
+    const float Delta = (float)(int32)(Intensity * 8000.0f);
+
+    Kernel.ForEachSpan(1.0f, 0, [&](int32 Y, int32 X0, int32 X1, float* Weights)
     {
-        for (int32 X = 0; X < Width; X++)
-        {
-            float Dist = FVector2D::Distance(FVector2D(X, Y), FVector2D(CenterX, CenterY));
-            float NormDist = Dist / (float)RadiusInGrid;
-            float Falloff = CalculateFalloff(NormDist, FalloffType);
-            if (Falloff <= 0.0f) continue;
+        Kernel.ComputeFalloffRow(Y, X0, X1 - X0 + 1, Weights);
 
-            int32 Idx = X + Y * Width;
-            int32 NewVal = (int32)HeightData[Idx] + (int32)(Delta * Falloff);
-            HeightData[Idx] = (uint16)FMath::Clamp(NewVal, 0, 65534);
+        uint16* Row = HeightData.GetData() + Y * Width;
+        for (int32 X = X0; X <= X1; X++)
+        {
+            const int32 NewVal = (int32)Row[X] + (int32)(Delta * Weights[X - X0]);
+            Row[X] = (uint16)FMath::Clamp(NewVal, 0, 65534);
         }
-    }
+    });
 }
 
-void FUnrealCompanionLandscapeCommands::ApplyLower(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, const FString& FalloffType)
+void FUnrealCompanionLandscapeCommands::ApplyLower(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, EMCPBrushFalloff Falloff)
 {
-    int32 Delta = (int32)(Intensity * 8000.0f);
-    for (int32 Y = 0; Y < Height; Y++)
+    const FBrushKernel Kernel(Width, Height, CenterX, CenterY, RadiusInGrid, Falloff);
+    const float Delta = (float)(int32)(Intensity * 8000.0f);
+
+    Kernel.ForEachSpan(1.0f, 0, [&](int32 Y, int32 X0, int32 X1, float* Weights)
     {
-        for (int32 X = 0; X < Width; X++)
-        {
-            float Dist = FVector2D::Distance(FVector2D(X, Y), FVector2D(CenterX, CenterY));
-            float NormDist = Dist / (float)RadiusInGrid;
-            float Falloff = CalculateFalloff(NormDist, FalloffType);
-            if (Falloff <= 0.0f) continue;
+        Kernel.ComputeFalloffRow(Y, X0, X1 - X0 + 1, Weights);
 
-            int32 Idx = X + Y * Width;
-            int32 NewVal = (int32)HeightData[Idx] - (int32)(Delta * Falloff);
-            HeightData[Idx] = (uint16)FMath::Clamp(NewVal, 0, 65534);
+        uint16* Row = HeightData.GetData() + Y * Width;
+        for (int32 X = X0; X <= X1; X++)
+        {
+            const int32 NewVal = (int32)Row[X] - (int32)(Delta * Weights[X - X0]);
+            Row[X] = (uint16)FMath::Clamp(NewVal, 0, 65534);
         }
-    }
+    });
 }
 
-void FUnrealCompanionLandscapeCommands::ApplyFlatten(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, const FString& FalloffType)
+void FUnrealCompanionLandscapeCommands::ApplyFlatten(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, EMCPBrushFalloff Falloff)
 {
     // Get target height from center
     int32 CenterIdx = FMath::Clamp(CenterX, 0, Width - 1) + FMath::Clamp(CenterY, 0, Height - 1) * Width;
-    uint16 TargetHeight = HeightData[CenterIdx];
+    const float TargetHeight = (float)HeightData[CenterIdx];
 
-    for (int32 Y = 0; Y < Height; Y++)
+    const FBrushKernel Kernel(Width, Height, CenterX, CenterY, RadiusInGrid, Falloff);
+
+    Kernel.ForEachSpan(1.0f, 0, [&](int32 Y, int32 X0, int32 X1, float* Weights)
     {
-        for (int32 X = 0; X < Width; X++)
-        {
-            float Dist = FVector2D::Distance(FVector2D(X, Y), FVector2D(CenterX, CenterY));
-            float NormDist = Dist / (float)RadiusInGrid;
-            float Falloff = CalculateFalloff(NormDist, FalloffType);
-            if (Falloff <= 0.0f) continue;
+        Kernel.ComputeFalloffRow(Y, X0, X1 - X0 + 1, Weights);
 
-            int32 Idx = X + Y * Width;
-            HeightData[Idx] = (uint16)FMath::Lerp((float)HeightData[Idx], (float)TargetHeight, Falloff * Intensity);
+        uint16* Row = HeightData.GetData() + Y * Width;
+        for (int32 X = X0; X <= X1; X++)
+        {
+            Row[X] = (uint16)FMath::Lerp((float)Row[X], TargetHeight, Weights[X - X0] * Intensity);
         }
-    }
+    });
 }
 
-void FUnrealCompanionLandscapeCommands::ApplySmooth(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, const FString& FalloffType)
+void FUnrealCompanionLandscapeCommands::ApplySmooth(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, EMCPBrushFalloff Falloff)
 {
-    TArray<uint16> TempData = HeightData;
+    // Double-buffered: tiles read the untouched copy and write HeightData, so a tile
+    // never sees a neighbour's output. The 3x3 kernel needs one texel of border.
+    const FBrushKernel Kernel(Width, Height, CenterX, CenterY, RadiusInGrid, Falloff);
+    const TArray<uint16> TempData = HeightData;
 
-    for (int32 Y = 1; Y < Height - 1; Y++)
+    Kernel.ForEachSpan(1.0f, 1, [&](int32 Y, int32 X0, int32 X1, float* Weights)
     {
-        for (int32 X = 1; X < Width - 1; X++)
+        Kernel.ComputeFalloffRow(Y, X0, X1 - X0 + 1, Weights);
+
+        const uint16* Above = TempData.GetData() + (Y - 1) * Width;
+        const uint16* Center = TempData.GetData() + Y * Width;
+        const uint16* Below = TempData.GetData() + (Y + 1) * Width;
+        uint16* Row = HeightData.GetData() + Y * Width;
+        for (int32 X = X0; X <= X1; X++)
         {
-            float Dist = FVector2D::Distance(FVector2D(X, Y), FVector2D(CenterX, CenterY));
-            float NormDist = Dist / (float)RadiusInGrid;
-            float Falloff = CalculateFalloff(NormDist, FalloffType);
+            const float Falloff = Weights[X - X0];
             if (Falloff <= 0.0f) continue;
 
             // 3x3 kernel average
-            float Sum = 0.0f;
-            for (int32 KY = -1; KY <= 1; KY++)
-            {
-                for (int32 KX = -1; KX <= 1; KX++)
-                {
-                    Sum += (float)TempData[(X + KX) + (Y + KY) * Width];
-                }
-            }
-            float Avg = Sum / 9.0f;
+            const float Sum =
+                (float)Above[X - 1] + (float)Above[X] + (float)Above[X + 1] +
+                (float)Center[X - 1] + (float)Center[X] + (float)Center[X + 1] +
+                (float)Below[X - 1] + (float)Below[X] + (float)Below[X + 1];
+            const float Avg = Sum / 9.0f;
 
-            int32 Idx = X + Y * Width;
-            HeightData[Idx] = (uint16)FMath::Lerp((float)TempData[Idx], Avg, Falloff * Intensity);
+            Row[X] = (uint16)FMath::Lerp((float)Center[X], Avg, Falloff * Intensity);
         }
-    }
+    });
 }
 
-void FUnrealCompanionLandscapeCommands::ApplyNoise(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, const FString& FalloffType, float Frequency, int32 Octaves, float Amplitude)
+void FUnrealCompanionLandscapeCommands::ApplyNoise(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, EMCPBrushFalloff Falloff, float Frequency, int32 Octaves, float Amplitude)
 {
-    for (int32 Y = 0; Y < Height; Y++)
+    const FBrushKernel Kernel(Width, Height, CenterX, CenterY, RadiusInGrid, Falloff);
+
+    // Octave weights are the same for every texel
+    float TotalAmp = 0.0f;
+    for (int32 Oct = 0; Oct < Octaves; Oct++)
+    {
+        TotalAmp += FMath::Pow(0.5f, (float)Oct);
+    }
+    const float Scale = Amplitude * Intensity * 8000.0f / TotalAmp;
+
+    Kernel.ForEachSpan(1.0f, 0, [&](int32 Y, int32 X0, int32 X1, float* Weights)
     {
-        for (int32 X = 0; X < Width; X++)
+        Kernel.ComputeFalloffRow(Y, X0, X1 - X0 + 1, Weights);
+
+        uint16* Row = HeightData.GetData() + Y * Width;
+        for (int32 X = X0; X <= X1; X++)
         {
-            float Dist = FVector2D::Distance(FVector2D(X, Y), FVector2D(CenterX, CenterY));
-            float NormDist = Dist / (float)RadiusInGrid;
-            float Falloff = CalculateFalloff(NormDist, FalloffType);
-            if (Falloff <= 0.0f) continue;
+            const float Weight = Weights[X - X0];
+            if (Weight <= 0.0f) continue;
 
             // Multi-octave Perlin noise
             float NoiseVal = 0.0f;
             float Freq = Frequency;
             float Amp = 1.0f;
-            float TotalAmp = 0.0f;
             for (int32 Oct = 0; Oct < Octaves; Oct++)
             {
                 NoiseVal += FMath::PerlinNoise2D(FVector2D(X * Freq, Y * Freq)) * Amp;
-                TotalAmp += Amp;
                 Freq *= 2.0f;
                 Amp *= 0.5f;
             }
-            NoiseVal /= TotalAmp; // Normalize to [-1, 1]
 
-            int32 Idx = X + Y * Width;
-            int32 Delta = (int32)(NoiseVal * Amplitude * Intensity * 8000.0f * Falloff);
-            int32 NewVal = (int32)HeightData[Idx] + Delta;
-            HeightData[Idx] = (uint16)FMath::Clamp(NewVal, 0, 65534);
+            const int32 Delta = (int32)(NoiseVal * Scale * Weight);
+            const int32 NewVal = (int32)Row[X] + Delta;
+            Row[X] = (uint16)FMath::Clamp(NewVal, 0, 65534);
         }
-    }
+    });
 }
 
-void FUnrealCompanionLandscapeCommands::ApplyCrater(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Depth, float RimHeight, const FString& FalloffType)
+void FUnrealCompanionLandscapeCommands::ApplyCrater(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Depth, float RimHeight, EMCPBrushFalloff Falloff)
 {
-    for (int32 Y = 0; Y < Height; Y++)
+    // The rim reaches 1.3x the radius
+    const FBrushKernel Kernel(Width, Height, CenterX, CenterY, RadiusInGrid, Falloff);
+
+    Kernel.ForEachSpan(1.3f, 0, [&](int32 Y, int32 X0, int32 X1, float* NormDists)
     {
-        for (int32 X = 0; X < Width; X++)
-        {
-            float Dist = FVector2D::Distance(FVector2D(X, Y), FVector2D(CenterX, CenterY));
-            float NormDist = Dist / (float)RadiusInGrid;
-            if (NormDist > 1.3f) continue; // Include rim area
+        Kernel.ComputeNormDistRow(Y, X0, X1 - X0 + 1, NormDists);
 
-            int32 Idx = X + Y * Width;
+        uint16* Row = HeightData.GetData() + Y * Width;
+        for (int32 X = X0; X <= X1; X++)
+        {
+            const float NormDist = NormDists[X - X0];
             float HeightDelta = 0.0f;
 
             if (NormDist < 0.7f)
@@ -769,10 +1076,10 @@ void FUnrealCompanionLandscapeCommands::ApplyCrater(TArray<uint16>& HeightData,
                 HeightDelta = RimHeight * 8000.0f * (1.0f - FMath::SmoothStep(0.0f, 1.0f, T));
             }
 
-            int32 NewVal = (int32)HeightData[Idx] + (int32)HeightDelta;
-            HeightData[Idx] = (uint16)FMath::Clamp(NewVal, 0, 65534);
+            int32 NewVal = (int32)Row[X] + (int32)HeightDelta;
+            Row[X] = (uint16)FMath::Clamp(NewVal, 0, 65534);
         }
-    }
+    });
 }
 
 void FUnrealCompanionLandscapeCommands::ApplyCanyon(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, const FVector2D& Direction, float Depth, float CanyonWidth, float Roughness)
@@ -780,13 +1087,14 @@ void FUnrealCompanionLandscapeCommands::ApplyCanyon(TArray<uint16>& HeightData,
     // Canyon: a directional trench with noise on the edges
     FVector2D Perpendicular(-Direction.Y, Direction.X);
 
-    for (int32 Y = 0; Y < Height; Y++)
+    // Only the brush span is used here; the canyon computes its own falloffs
+    const FBrushKernel Kernel(Width, Height, CenterX, CenterY, RadiusInGrid, EMCPBrushFalloff::Linear);
+
+    Kernel.ForEachSpan(1.0f, 0, [&](int32 Y, int32 X0, int32 X1, float*)
     {
-        for (int32 X = 0; X < Width; X++)
+        uint16* Row = HeightData.GetData() + Y * Width;
+        for (int32 X = X0; X <= X1; X++)
         {
-            float Dist = FVector2D::Distance(FVector2D(X, Y), FVector2D(CenterX, CenterY));
-            if (Dist > RadiusInGrid) continue;
-
             FVector2D Offset(X - CenterX, Y - CenterY);
 
             // Distance along the canyon direction (for length falloff)
@@ -820,7 +1128,6 @@ void FUnrealCompanionLandscapeCommands::ApplyCanyon(TArray<uint16>& HeightData,
 
             if (WidthFalloff <= 0.0f) continue;
 
-            int32 Idx = X + Y * Width;
             float HeightDelta = -Depth * 8000.0f * WidthFalloff * AlongFalloff;
 
             // Add wall roughness
@@ -830,10 +1137,10 @@ void FUnrealCompanionLandscapeCommands::ApplyCanyon(TArray<uint16>& HeightData,
                 HeightDelta += WallNoise * (1.0f - WidthFalloff);
             }
 
-            int32 NewVal = (int32)HeightData[Idx] + (int32)HeightDelta;
-            HeightData[Idx] = (uint16)FMath::Clamp(NewVal, 0, 65534);
+            int32 NewVal = (int32)Row[X] + (int32)HeightDelta;
+            Row[X] = (uint16)FMath::Clamp(NewVal, 0, 65534);
         }
-    }
+    });
 }
 
 // =============================================================================
@@ -848,31 +1155,38 @@ TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandlePaintLayer(cons
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing 'actor_name' parameter"));
     }
 
-    FString LayerName;
-    if (!Params->TryGetStringField(TEXT("layer_name"), LayerName))
-    {
-        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing 'layer_name' parameter"));
-    }
+    // Top-level layer_name / radius / strength / falloff are the defaults for every stroke
+    FString DefaultLayerName;
+    Params->TryGetStringField(TEXT("layer_name"), DefaultLayerName);
+
+    float DefaultRadius = 5000.0f;
+    if (Params->HasField(TEXT("radius")))
+        DefaultRadius = Params->GetNumberField(TEXT("radius"));
+
+    float DefaultStrength = 1.0f;
+    if (Params->HasField(TEXT("strength")))
+        DefaultStrength = FMath::Clamp((float)Params->GetNumberField(TEXT("strength")), 0.0f, 1.0f);
 
-    // Parse position [X, Y, Z] (world coordinates)
-    FVector2D Position(0.0f, 0.0f);
-    if (Params->HasField(TEXT("position")))
+    FString DefaultFalloff = TEXT("smooth");
+    Params->TryGetStringField(TEXT("falloff"), DefaultFalloff);
+
+    // No "strokes": the call itself is the only stroke
+    TArray<TSharedPtr<FJsonObject>> StrokeParams;
+    const TArray<TSharedPtr<FJsonValue>>* StrokesArray = nullptr;
+    if (Params->TryGetArrayField(TEXT("strokes"), StrokesArray))
     {
-        const TArray<TSharedPtr<FJsonValue>>* PosArray;
-        if (Params->TryGetArrayField(TEXT("position"), PosArray) && PosArray->Num() >= 2)
+        for (const TSharedPtr<FJsonValue>& StrokeValue : *StrokesArray)
         {
-            Position.X = (*PosArray)[0]->AsNumber();
-            Position.Y = (*PosArray)[1]->AsNumber();
+            if (StrokeValue.IsValid() && StrokeValue->AsObject().IsValid())
+            {
+                StrokeParams.Add(StrokeValue->AsObject());
+            }
         }
     }
-
-    float Radius = 5000.0f;
-    if (Params->HasField(TEXT("radius")))
-        Radius = Params->GetNumberField(TEXT("radius"));
-
-    float Strength = 1.0f;
-    if (Params->HasField(TEXT("strength")))
-        Strength = FMath::Clamp((float)Params->GetNumberField(TEXT("strength")), 0.0f, 1.0f);
+    else
+    {
+        StrokeParams.Add(Params);
+    }
 
     // Find the landscape
     ALandscape* Landscape = FindLandscapeByName(ActorName);
@@ -887,94 +1201,392 @@ TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandlePaintLayer(cons
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to get LandscapeInfo"));
     }
 
-    // Find the layer info object by name
-    ULandscapeLayerInfoObject* LayerInfo = nullptr;
+    FIntRect LandscapeExtent;
+    if (!LandscapeInfo->GetLandscapeExtent(LandscapeExtent))
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to get landscape extent"));
+    }
+
+    // Layer infos by name, looked up once per batch
+    TMap<FName, ULandscapeLayerInfoObject*> LayerInfos;
     for (const FLandscapeInfoLayerSettings& Layer : LandscapeInfo->Layers)
     {
-        if (Layer.LayerName == FName(*LayerName))
+        if (Layer.LayerInfoObj)
         {
-            LayerInfo = Layer.LayerInfoObj;
-            break;
+            LayerInfos.Add(Layer.LayerName, Layer.LayerInfoObj);
         }
     }
 
-    if (!LayerInfo)
+    const FVector LandscapeOrigin = Landscape->GetActorLocation();
+    const FVector LandscapeScale = Landscape->GetActorScale3D();
+
+    // Pass 1: resolve strokes to grid windows and group them by layer, keeping request order
+    struct FPaintStroke
+    {
+        int32 CenterGridX;
+        int32 CenterGridY;
+        int32 RadiusInGrid;
+        float Strength;
+        EMCPBrushFalloff Falloff;
+    };
+
+    struct FPaintLayer
+    {
+        FName LayerName;
+        ULandscapeLayerInfoObject* LayerInfo;
+        TArray<FPaintStroke> Strokes;
+        FIntRect Region;
+        int32 LastStroke;
+    };
+
+    TArray<FPaintLayer> Layers;
+    int32 StrokesApplied = 0;
+    for (int32 StrokeIndex = 0; StrokeIndex < StrokeParams.Num(); ++StrokeIndex)
     {
-        // List available layers for helpful error message
-        FString AvailableLayers;
-        for (const FLandscapeInfoLayerSettings& Layer : LandscapeInfo->Layers)
+        const TSharedPtr<FJsonObject>& Stroke = StrokeParams[StrokeIndex];
+
+        FString LayerName = DefaultLayerName;
+        Stroke->TryGetStringField(TEXT("layer_name"), LayerName);
+        if (LayerName.IsEmpty())
+        {
+            return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing 'layer_name' parameter"));
+        }
+
+        ULandscapeLayerInfoObject* const* LayerInfo = LayerInfos.Find(FName(*LayerName));
+        if (!LayerInfo)
+        {
+            // List available layers for helpful error message
+            FString AvailableLayers;
+            for (const FLandscapeInfoLayerSettings& Layer : LandscapeInfo->Layers)
+            {
+                if (!AvailableLayers.IsEmpty()) AvailableLayers += TEXT(", ");
+                AvailableLayers += Layer.LayerName.ToString();
+            }
+            return FUnrealCompanionCommonUtils::CreateErrorResponse(
+                FString::Printf(TEXT("Layer '%s' not found. Available layers: [%s]. Create layers in the Landscape editor first."), *LayerName, *AvailableLayers));
+        }
+
+        // Parse position [X, Y] (world coordinates)
+        FVector2D Position(0.0f, 0.0f);
+        const TArray<TSharedPtr<FJsonValue>>* PosArray;
+        if (Stroke->TryGetArrayField(TEXT("position"), PosArray) && PosArray->Num() >= 2)
+        {
+            Position.X = (*PosArray)[0]->AsNumber();
+            Position.Y = (*PosArray)[1]->AsNumber();
+        }
+
+        float Radius = DefaultRadius;
+        if (Stroke->HasField(TEXT("radius")))
+            Radius = Stroke->GetNumberField(TEXT("radius"));
+
+        float Strength = DefaultStrength;
+        if (Stroke->HasField(TEXT("strength")))
+            Strength = FMath::Clamp((float)Stroke->GetNumberField(TEXT("strength")), 0.0f, 1.0f);
+
+        FString FalloffType = DefaultFalloff;
+        Stroke->TryGetStringField(TEXT("falloff"), FalloffType);
+
+        // Convert world position to landscape grid coordinates
+        FVector LocalCenter = (FVector(Position.X, Position.Y, 0.0f) - LandscapeOrigin) / LandscapeScale;
+        const int32 CenterGridX = FMath::RoundToInt(LocalCenter.X);
+        const int32 CenterGridY = FMath::RoundToInt(LocalCenter.Y);
+        const int32 RadiusInGrid = FMath::Max(FMath::CeilToInt(Radius / LandscapeScale.X), 1);
+
+        if (CenterGridX + RadiusInGrid < LandscapeExtent.Min.X || CenterGridX - RadiusInGrid > LandscapeExtent.Max.X
+            || CenterGridY + RadiusInGrid < LandscapeExtent.Min.Y || CenterGridY - RadiusInGrid > LandscapeExtent.Max.Y)
+        {
+            continue; // Entirely outside the landscape
+        }
+        const FIntRect Region(
+            FMath::Max(CenterGridX - RadiusInGrid, LandscapeExtent.Min.X), FMath::Max(CenterGridY - RadiusInGrid, LandscapeExtent.Min.Y),
+            FMath::Min(CenterGridX + RadiusInGrid, LandscapeExtent.Max.X), FMath::Min(CenterGridY + RadiusInGrid, LandscapeExtent.Max.Y));
+
+        FPaintLayer* Layer = Layers.FindByPredicate([LayerInfo](const FPaintLayer& Candidate) { return Candidate.LayerInfo == *LayerInfo; });
+        if (!Layer)
         {
-            if (!AvailableLayers.IsEmpty()) AvailableLayers += TEXT(", ");
-            AvailableLayers += Layer.LayerName.ToString();
+            Layer = &Layers.Add_GetRef({ FName(*LayerName), *LayerInfo, {}, Region, StrokeIndex });
         }
-        return FUnrealCompanionCommonUtils::CreateErrorResponse(
-            FString::Printf(TEXT("Layer '%s' not found. Available layers: [%s]. Create layers in the Landscape editor first."), *LayerName, *AvailableLayers));
+        else
+        {
+            Layer->Region.Union(Region);
+        }
+        Layer->Strokes.Add({ CenterGridX, CenterGridY, RadiusInGrid, Strength, ParseFalloff(FalloffType) });
+        Layer->LastStroke = StrokeIndex;
+        StrokesApplied++;
     }
 
-    // Convert world position to landscape grid coordinates
-    const FVector LandscapeOrigin = Landscape->GetActorLocation();
-    const FVector LandscapeScale = Landscape->GetActorScale3D();
-    FVector LocalCenter = (FVector(Position.X, Position.Y, 0.0f) - LandscapeOrigin) / LandscapeScale;
-    int32 CenterGridX = FMath::RoundToInt(LocalCenter.X);
-    int32 CenterGridY = FMath::RoundToInt(LocalCenter.Y);
-    int32 RadiusInGrid = FMath::CeilToInt(Radius / LandscapeScale.X);
+    if (Layers.Num() == 0)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Paint region outside landscape bounds"));
+    }
+
+    // Where layers overlap, the one painted last wins: write it last
+    Layers.Sort([](const FPaintLayer& A, const FPaintLayer& B) { return A.LastStroke < B.LastStroke; });
+
+    FLandscapeEditDataInterface LandscapeEdit(LandscapeInfo);
+    TArray<TSharedPtr<FJsonValue>> LayerResults;
+    int32 VerticesPainted = 0;
+    for (const FPaintLayer& Layer : Layers)
+    {
+        const int32 Width = Layer.Region.Width() + 1;
+        const int32 Height = Layer.Region.Height() + 1;
 
-    // Get landscape extent and clamp
+        // Pass 2: one read of the layer's weights under all of its strokes
+        TArray<uint8> Weights;
+        Weights.SetNumZeroed(Width * Height);
+        {
+            UNREALCOMPANION_TRACE_SCOPE("LandscapePaint.ReadWeights");
+            int32 X1 = Layer.Region.Min.X, Y1 = Layer.Region.Min.Y, X2 = Layer.Region.Max.X, Y2 = Layer.Region.Max.Y;
+            LandscapeEdit.GetWeightData(Layer.LayerInfo, X1, Y1, X2, Y2, Weights.GetData(), 0);
+        }
+
+        // Pass 3: blend every stroke in float, so overlapping strokes do not quantise in between
+        TArray<float> Values;
+        Values.SetNumUninitialized(Width * Height);
+        for (int32 Index = 0; Index < Weights.Num(); ++Index)
+        {
+            Values[Index] = (float)Weights[Index];
+        }
+
+        for (const FPaintStroke& Stroke : Layer.Strokes)
+        {
+            UNREALCOMPANION_TRACE_SCOPE("LandscapePaint.ApplyStroke");
+            const FBrushKernel Kernel(Width, Height, Stroke.CenterGridX - Layer.Region.Min.X, Stroke.CenterGridY - Layer.Region.Min.Y,
+                Stroke.RadiusInGrid, Stroke.Falloff);
+            const float Strength = Stroke.Strength;
+
+            Kernel.ForEachSpan(1.0f, 0, [&Values, &Kernel, Width, Strength](int32 Y, int32 X0, int32 X1, float* Alpha)
+            {
+                const int32 Count = X1 - X0 + 1;
+                Kernel.ComputeFalloffRow(Y, X0, Count, Alpha);
+
+                // w += (255 - w) * strength * falloff, four texels at a time
+                float* Row = Values.GetData() + Y * Width + X0;
+                const VectorRegister4Float Full = VectorSetFloat1(255.0f);
+                const VectorRegister4Float StrengthV = VectorSetFloat1(Strength);
+                int32 Lane = 0;
+                for (; Lane + 4 <= Count; Lane += 4)
+                {
+                    const VectorRegister4Float W = VectorLoad(Row + Lane);
+                    const VectorRegister4Float A = VectorMultiply(VectorLoad(Alpha + Lane), StrengthV);
+                    VectorStore(VectorMultiplyAdd(VectorSubtract(Full, W), A, W), Row + Lane);
+                }
+                for (; Lane < Count; ++Lane)
+                {
+                    Row[Lane] += (255.0f - Row[Lane]) * Alpha[Lane] * Strength;
+                }
+            });
+        }
+
+        for (int32 Index = 0; Index < Weights.Num(); ++Index)
+        {
+            Weights[Index] = (uint8)FMath::Clamp(FMath::RoundToInt(Values[Index]), 0, 255);
+        }
+
+        // Pass 4: one write; bWeightAdjust renormalises the other layers in the same pass
+        {
+            UNREALCOMPANION_TRACE_SCOPE("LandscapePaint.WriteWeights");
+            LandscapeEdit.SetAlphaData(Layer.LayerInfo, Layer.Region.Min.X, Layer.Region.Min.Y, Layer.Region.Max.X, Layer.Region.Max.Y,
+                Weights.GetData(), 0, ELandscapeLayerPaintingRestriction::None, true, false);
+        }
+
+        TSharedPtr<FJsonObject> LayerObj = MakeShared<FJsonObject>();
+        LayerObj->SetStringField(TEXT("layer_name"), Layer.LayerName.ToString());
+        LayerObj->SetNumberField(TEXT("strokes"), Layer.Strokes.Num());
+        LayerObj->SetNumberField(TEXT("vertices_painted"), Width * Height);
+        LayerResults.Add(MakeShared<FJsonValueObject>(LayerObj));
+        VerticesPainted += Width * Height;
+    }
+
+    LandscapeEdit.Flush();
+    Landscape->PostEditChange();
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetBoolField(TEXT("success"), true);
+    ResultObj->SetStringField(TEXT("layer_name"), Layers.Last().LayerName.ToString());
+    ResultObj->SetNumberField(TEXT("strokes_applied"), StrokesApplied);
+    ResultObj->SetNumberField(TEXT("vertices_painted"), VerticesPainted);
+    ResultObj->SetArrayField(TEXT("layers"), LayerResults);
+    return ResultObj;
+}
+
+// =============================================================================
+// HEIGHT READBACK
+// =============================================================================
+
+TSharedPtr<FJsonObject> FUnrealCompanionLandscapeCommands::HandleReadHeights(const TSharedPtr<FJsonObject>& Params)
+{
+    FString ActorName;
+    Params->TryGetStringField(TEXT("actor_name"), ActorName);
+
+    ALandscape* Landscape = FindLandscapeByName(ActorName);
+    if (!Landscape)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Landscape not found: %s"), *ActorName));
+    }
+
+    ULandscapeInfo* LandscapeInfo = Landscape->GetLandscapeInfo();
     FIntRect LandscapeExtent;
-    if (!LandscapeInfo->GetLandscapeExtent(LandscapeExtent))
+    if (!LandscapeInfo || !LandscapeInfo->GetLandscapeExtent(LandscapeExtent))
     {
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to get landscape extent"));
     }
 
-    int32 MinX = FMath::Clamp(CenterGridX - RadiusInGrid, LandscapeExtent.Min.X, LandscapeExtent.Max.X);
-    int32 MinY = FMath::Clamp(CenterGridY - RadiusInGrid, LandscapeExtent.Min.Y, LandscapeExtent.Max.Y);
-    int32 MaxX = FMath::Clamp(CenterGridX + RadiusInGrid, LandscapeExtent.Min.X, LandscapeExtent.Max.X);
-    int32 MaxY = FMath::Clamp(CenterGridY + RadiusInGrid, LandscapeExtent.Min.Y, LandscapeExtent.Max.Y);
+    const FVector LandscapeOrigin = Landscape->GetActorLocation();
+    const FVector LandscapeScale = Landscape->GetActorScale3D();
 
-    int32 RegionWidth = MaxX - MinX + 1;
-    int32 RegionHeight = MaxY - MinY + 1;
+    // World bounds [min_x, min_y, max_x, max_y] -> vertex rectangle, whole landscape by default
+    FIntRect Region = LandscapeExtent;
+    const TArray<TSharedPtr<FJsonValue>>* BoundsArray = nullptr;
+    if (Params->TryGetArrayField(TEXT("bounds"), BoundsArray))
+    {
+        if (BoundsArray->Num() != 4)
+        {
+            return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("'bounds' must be [min_x, min_y, max_x, max_y] in world units"));
+        }
+        const double MinX = ((*BoundsArray)[0]->AsNumber() - LandscapeOrigin.X) / LandscapeScale.X;
+        const double MinY = ((*BoundsArray)[1]->AsNumber() - LandscapeOrigin.Y) / LandscapeScale.Y;
+        const double MaxX = ((*BoundsArray)[2]->AsNumber() - LandscapeOrigin.X) / LandscapeScale.X;
+        const double MaxY = ((*BoundsArray)[3]->AsNumber() - LandscapeOrigin.Y) / LandscapeScale.Y;
+        Region.Min.X = FMath::Max(FMath::FloorToInt(FMath::Min(MinX, MaxX)), LandscapeExtent.Min.X);
+        Region.Min.Y = FMath::Max(FMath::FloorToInt(FMath::Min(MinY, MaxY)), LandscapeExtent.Min.Y);
+        Region.Max.X = FMath::Min(FMath::CeilToInt(FMath::Max(MinX, MaxX)), LandscapeExtent.Max.X);
+        Region.Max.Y = FMath::Min(FMath::CeilToInt(FMath::Max(MinY, MaxY)), LandscapeExtent.Max.Y);
+        if (Region.Min.X > Region.Max.X || Region.Min.Y > Region.Max.Y)
+        {
+            return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("'bounds' do not overlap the landscape"));
+        }
+    }
 
-    if (RegionWidth <= 0 || RegionHeight <= 0)
+    int32 Resolution = 256;
+    if (Params->HasField(TEXT("resolution")))
     {
-        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Paint region outside landscape bounds"));
+        Resolution = FMath::Clamp((int32)Params->GetNumberField(TEXT("resolution")), 1, 4096);
     }
 
-    // Generate circular alpha data with falloff
-    const uint8 PaintValue = static_cast<uint8>(Strength * 255.0f);
-    TArray<uint8> AlphaData;
-    AlphaData.SetNum(RegionWidth * RegionHeight);
+    FString Format = TEXT("uint16");
+    Params->TryGetStringField(TEXT("format"), Format);
+    const bool bHalf = Format == TEXT("float16");
+    if (!bHalf && Format != TEXT("uint16"))
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown format '%s' (uint16, float16)"), *Format));
+    }
 
-    for (int32 Y = 0; Y < RegionHeight; Y++)
+    bool bSharedMemory = false;
+    Params->TryGetBoolField(TEXT("shared_memory"), bSharedMemory);
+
+    // Coarsest 2^L box filter that still has at least Resolution texels on the long side
+    const int32 LongSide = FMath::Max(Region.Width(), Region.Height()) + 1;
+    int32 Level = 0;
+    while (((LongSide + (2 << Level) - 1) >> (Level + 1)) >= Resolution)
     {
-        for (int32 X = 0; X < RegionWidth; X++)
+        ++Level;
+    }
+
+    FUnrealCompanionHeightfieldCache::FLevel Heights;
+    FIntPoint GridOrigin;
+    bool bFromCache = false;
+    {
+        UNREALCOMPANION_TRACE_SCOPE("LandscapeReadHeights.Read");
+        if (!FUnrealCompanionHeightfieldCache::Get().Read(LandscapeInfo, Region, Level, Heights, GridOrigin, bFromCache))
         {
-            float Dist = FVector2D::Distance(
-                FVector2D(MinX + X, MinY + Y),
-                FVector2D(CenterGridX, CenterGridY));
-            float NormDist = Dist / (float)RadiusInGrid;
+            return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to read landscape heights"));
+        }
+    }
 
-            if (NormDist >= 1.0f)
-            {
-                AlphaData[X + Y * RegionWidth] = 0;
-            }
-            else
+    // The level is at most 2x the target: a bilinear pass brings the long side to Resolution exactly
+    double TexelSizeX = (double)(1 << Level);
+    double TexelSizeY = TexelSizeX;
+    if (FMath::Max(Heights.Width, Heights.Height) > Resolution)
+    {
+        const double Ratio = (double)Resolution / FMath::Max(Heights.Width, Heights.Height);
+        FUnrealCompanionHeightfieldCache::FLevel Resampled;
+        Resampled.Width = FMath::Max(1, FMath::RoundToInt(Heights.Width * Ratio));
+        Resampled.Height = FMath::Max(1, FMath::RoundToInt(Heights.Height * Ratio));
+        Resampled.Heights.SetNumUninitialized(Resampled.Width * Resampled.Height);
+
+        const double ScaleX = (double)Heights.Width / Resampled.Width;
+        const double ScaleY = (double)Heights.Height / Resampled.Height;
+        ParallelFor(Resampled.Height, [&](int32 Y)
+        {
+            const double SrcY = FMath::Clamp((Y + 0.5) * ScaleY - 0.5, 0.0, (double)(Heights.Height - 1));
+            const int32 Y0 = (int32)SrcY;
+            const int32 Y1 = FMath::Min(Y0 + 1, Heights.Height - 1);
+            const double AlphaY = SrcY - Y0;
+            for (int32 X = 0; X < Resampled.Width; ++X)
             {
-                float Falloff = FMath::SmoothStep(0.0f, 1.0f, 1.0f - NormDist);
-                AlphaData[X + Y * RegionWidth] = static_cast<uint8>(PaintValue * Falloff);
+                const double SrcX = FMath::Clamp((X + 0.5) * ScaleX - 0.5, 0.0, (double)(Heights.Width - 1));
+                const int32 X0 = (int32)SrcX;
+                const int32 X1 = FMath::Min(X0 + 1, Heights.Width - 1);
+                const double AlphaX = SrcX - X0;
+                const double Top = FMath::Lerp((double)Heights.Heights[Y0 * Heights.Width + X0], (double)Heights.Heights[Y0 * Heights.Width + X1], AlphaX);
+                const double Bottom = FMath::Lerp((double)Heights.Heights[Y1 * Heights.Width + X0], (double)Heights.Heights[Y1 * Heights.Width + X1], AlphaX);
+                Resampled.Heights[Y * Resampled.Width + X] = (uint16)FMath::RoundToInt(FMath::Lerp(Top, Bottom, AlphaY));
             }
-        }
+        });
+
+        TexelSizeX *= ScaleX;
+        TexelSizeY *= ScaleY;
+        Heights = MoveTemp(Resampled);
     }
 
-    // Apply the alpha data
-    FLandscapeEditDataInterface LandscapeEdit(LandscapeInfo);
-    LandscapeEdit.SetAlphaData(LayerInfo, MinX, MinY, MaxX, MaxY, AlphaData.GetData(), RegionWidth);
-    LandscapeEdit.Flush();
-    Landscape->PostEditChange();
+    // uint16 is the raw heightmap (32768 = actor Z); float16 is already height above the actor
+    const double HeightScale = LANDSCAPE_ZSCALE * LandscapeScale.Z;
+    TArray<uint8> Bytes;
+    Bytes.SetNumUninitialized(Heights.Heights.Num() * sizeof(uint16));
+    if (bHalf)
+    {
+        uint16* Dest = reinterpret_cast<uint16*>(Bytes.GetData());
+        for (int32 Index = 0; Index < Heights.Heights.Num(); ++Index)
+        {
+            Dest[Index] = FFloat16((float)(((int32)Heights.Heights[Index] - 32768) * HeightScale)).Encoded;
+        }
+    }
+    else
+    {
+        FMemory::Memcpy(Bytes.GetData(), Heights.Heights.GetData(), Bytes.Num());
+    }
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    bool bInline = !bSharedMemory;
+    if (bSharedMemory)
+    {
+        FString SharedError;
+        if (TSharedPtr<FJsonObject> Handle = FMCPSharedMemory::Get().Write(Bytes.GetData(), Bytes.Num(), SharedError))
+        {
+            ResultObj->SetObjectField(TEXT("shared_memory"), Handle);
+        }
+        else
+        {
+            ResultObj->SetStringField(TEXT("shared_memory_error"), SharedError);
+            bInline = true;
+        }
+    }
+    if (bInline)
+    {
+        ResultObj->SetStringField(TEXT("data"), FBase64::Encode(Bytes.GetData(), (uint32)Bytes.Num()));
+    }
+
     ResultObj->SetBoolField(TEXT("success"), true);
-    ResultObj->SetStringField(TEXT("layer_name"), LayerName);
-    ResultObj->SetNumberField(TEXT("vertices_painted"), RegionWidth * RegionHeight);
+    ResultObj->SetNumberField(TEXT("width"), Heights.Width);
+    ResultObj->SetNumberField(TEXT("height"), Heights.Height);
+    ResultObj->SetStringField(TEXT("format"), Format);
+    ResultObj->SetStringField(TEXT("layout"), TEXT("row_major_le"));
+    ResultObj->SetNumberField(TEXT("level"), Level);
+    ResultObj->SetBoolField(TEXT("cached"), bFromCache);
+
+    // Texel (0, 0) starts at this vertex; z = height_offset + value (float16)
+    // or height_offset + (value - 32768) * height_scale (uint16)
+    TArray<TSharedPtr<FJsonValue>> OriginArray;
+    OriginArray.Add(MakeShared<FJsonValueNumber>(LandscapeOrigin.X + GridOrigin.X * LandscapeScale.X));
+    OriginArray.Add(MakeShared<FJsonValueNumber>(LandscapeOrigin.Y + GridOrigin.Y * LandscapeScale.Y));
+    ResultObj->SetArrayField(TEXT("origin"), OriginArray);
+    TArray<TSharedPtr<FJsonValue>> TexelArray;
+    TexelArray.Add(MakeShared<FJsonValueNumber>(TexelSizeX * LandscapeScale.X));
+    TexelArray.Add(MakeShared<FJsonValueNumber>(TexelSizeY * LandscapeScale.Y));
+    ResultObj->SetArrayField(TEXT("texel_size"), TexelArray);
+    ResultObj->SetNumberField(TEXT("height_offset"), LandscapeOrigin.Z);
+    ResultObj->SetNumberField(TEXT("height_scale"), HeightScale);
     return ResultObj;
 }
 
@@ -1,5 +1,6 @@
 #include "Commands/UnrealCompanionLevelCommands.h"
 #include "Commands/UnrealCompanionCommonUtils.h"
+#include "Commands/UnrealCompanionActorIndex.h"
 #include "Editor.h"
 #include "EditorAssetLibrary.h"
 #include "FileHelpers.h"
@@ -11,25 +12,24 @@ FUnrealCompanionLevelCommands::FUnrealCompanionLevelCommands()
 {
 }
 
+TConstArrayView<TMCPCommandEntry<FUnrealCompanionLevelCommands>> FUnrealCompanionLevelCommands::GetCommandTable()
+{
+    static constexpr TMCPCommandEntry<FUnrealCompanionLevelCommands> Table[] = {
+        { TEXT("level_get_info"), &FUnrealCompanionLevelCommands::HandleGetLevelInfo },
+        { TEXT("level_open"), &FUnrealCompanionLevelCommands::HandleOpenLevel },
+        { TEXT("level_save"), &FUnrealCompanionLevelCommands::HandleSaveLevel },
+        { TEXT("level_create"), &FUnrealCompanionLevelCommands::HandleNewLevel },
+    };
+    static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+    return Table;
+}
+
 TSharedPtr<FJsonObject> FUnrealCompanionLevelCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-    if (CommandType == TEXT("level_get_info"))
-    {
-        return HandleGetLevelInfo(Params);
-    }
-    else if (CommandType == TEXT("level_open"))
+    if (TSharedPtr<FJsonObject> Result = UnrealCompanionCommandTable::Dispatch(*this, GetCommandTable(), CommandType, Params))
     {
-        return HandleOpenLevel(Params);
+        return Result;
     }
-    else if (CommandType == TEXT("level_save"))
-    {
-        return HandleSaveLevel(Params);
-    }
-    else if (CommandType == TEXT("level_create"))
-    {
-        return HandleNewLevel(Params);
-    }
-    
     return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown level command: %s"), *CommandType));
 }
 
@@ -48,7 +48,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionLevelCommands::HandleGetLevelInfo(const
     
     // Count actors
     TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), AllActors);
+    FUnrealCompanionActorIndex::Get().GetAllActors(World, AllActors);
     ResultObj->SetNumberField(TEXT("total_actors"), AllActors.Num());
     
     // Count by type
@@ -1,6 +1,9 @@
 #include "Commands/UnrealCompanionLightCommands.h"
 #include "Commands/UnrealCompanionCommonUtils.h"
+#include "Commands/UnrealCompanionActorIndex.h"
+#include "Commands/UnrealCompanionJobManager.h"
 #include "Editor.h"
+#include "LightingBuildOptions.h"
 #include "Engine/DirectionalLight.h"
 #include "Engine/PointLight.h"
 #include "Engine/SpotLight.h"
@@ -17,21 +20,23 @@ FUnrealCompanionLightCommands::FUnrealCompanionLightCommands()
 {
 }
 
+TConstArrayView<TMCPCommandEntry<FUnrealCompanionLightCommands>> FUnrealCompanionLightCommands::GetCommandTable()
+{
+    static constexpr TMCPCommandEntry<FUnrealCompanionLightCommands> Table[] = {
+        { TEXT("light_spawn"), &FUnrealCompanionLightCommands::HandleSpawnLight },
+        { TEXT("light_set_property"), &FUnrealCompanionLightCommands::HandleSetLightProperty },
+        { TEXT("light_build"), &FUnrealCompanionLightCommands::HandleBuildLighting },
+    };
+    static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+    return Table;
+}
+
 TSharedPtr<FJsonObject> FUnrealCompanionLightCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-    if (CommandType == TEXT("light_spawn"))
+    if (TSharedPtr<FJsonObject> Result = UnrealCompanionCommandTable::Dispatch(*this, GetCommandTable(), CommandType, Params))
     {
-        return HandleSpawnLight(Params);
+        return Result;
     }
-    else if (CommandType == TEXT("light_set_property"))
-    {
-        return HandleSetLightProperty(Params);
-    }
-    else if (CommandType == TEXT("light_build"))
-    {
-        return HandleBuildLighting(Params);
-    }
-    
     return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown light command: %s"), *CommandType));
 }
 
@@ -149,18 +154,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionLightCommands::HandleSetLightProperty(co
     }
 
     // Find the light actor
-    AActor* LightActor = nullptr;
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
-    {
-        if (Actor && (Actor->GetName() == ActorName || Actor->GetActorLabel() == ActorName))
-        {
-            LightActor = Actor;
-            break;
-        }
-    }
+    AActor* LightActor = FUnrealCompanionActorIndex::Get().FindByName(GWorld, ActorName);
 
     if (!LightActor)
     {
@@ -220,17 +214,82 @@ TSharedPtr<FJsonObject> FUnrealCompanionLightCommands::HandleSetLightProperty(co
 
 TSharedPtr<FJsonObject> FUnrealCompanionLightCommands::HandleBuildLighting(const TSharedPtr<FJsonObject>& Params)
 {
-    // Note: Full lighting build is complex and may take time
-    // This is a placeholder that triggers a rebuild
-    
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (!World)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("No editor world available"));
+    }
+
     FString Quality = TEXT("medium");
     Params->TryGetStringField(TEXT("quality"), Quality);
-    
-    // Trigger lighting rebuild (async)
-    GEditor->Exec(GWorld, TEXT("BUILDLIGHTING"));
-    
-    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-    ResultObj->SetBoolField(TEXT("success"), true);
+
+    FLightingBuildOptions Options;
+    if (Quality == TEXT("preview"))
+    {
+        Options.QualityLevel = Quality_Preview;
+    }
+    else if (Quality == TEXT("medium"))
+    {
+        Options.QualityLevel = Quality_Medium;
+    }
+    else if (Quality == TEXT("high"))
+    {
+        Options.QualityLevel = Quality_High;
+    }
+    else if (Quality == TEXT("production"))
+    {
+        Options.QualityLevel = Quality_Production;
+    }
+    else
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(
+            TEXT("Unknown lighting quality: '%s'. Use preview, medium, high or production"), *Quality));
+    }
+
+    if (GEditor->IsLightingBuildCurrentlyRunning())
+    {
+        TSharedPtr<FJsonObject> Busy = FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+            TEXT("LIGHTING_BUILD_RUNNING"),
+            TEXT("A lighting build is already running"),
+            TEXT("Poll job_status with the returned job_id until it finishes"));
+        if (!LightingJobId.IsEmpty())
+        {
+            Busy->SetStringField(TEXT("job_id"), LightingJobId);
+        }
+        return Busy;
+    }
+
+    // The build runs asynchronously in the editor (Lightmass); the job only watches it
+    GEditor->BuildLighting(Options);
+
+    bool bStreamProgress = false;
+    Params->TryGetBoolField(TEXT("stream_progress"), bStreamProgress);
+
+    TWeakObjectPtr<UWorld> WeakWorld = World;
+    FUnrealCompanionJobManager::FHooks Hooks;
+    Hooks.Tick = [WeakWorld, Quality](const FString& JobId)
+    {
+        if (GEditor && GEditor->IsLightingBuildCurrentlyRunning())
+        {
+            // Lightmass does not expose a fraction, only whether the scene is still being exported
+            FUnrealCompanionJobManager::Get().SetProgress(JobId, -1.0,
+                GEditor->IsLightingBuildCurrentlyExporting() ? TEXT("exporting") : TEXT("building"));
+            return;
+        }
+
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetBoolField(TEXT("success"), true);
+        Result->SetStringField(TEXT("quality"), Quality);
+        if (UWorld* BuiltWorld = WeakWorld.Get())
+        {
+            Result->SetStringField(TEXT("level"), BuiltWorld->GetMapName());
+            Result->SetNumberField(TEXT("unbuilt_objects"), BuiltWorld->NumLightingUnbuiltObjects);
+        }
+        FUnrealCompanionJobManager::Get().Finish(JobId, Result);
+    };
+    LightingJobId = FUnrealCompanionJobManager::Get().Start(TEXT("light_build"), MoveTemp(Hooks), bStreamProgress);
+
+    TSharedPtr<FJsonObject> ResultObj = FUnrealCompanionJobManager::Get().BuildStartedResponse(LightingJobId);
     ResultObj->SetStringField(TEXT("quality"), Quality);
     ResultObj->SetStringField(TEXT("message"), TEXT("Lighting build started"));
     return ResultObj;
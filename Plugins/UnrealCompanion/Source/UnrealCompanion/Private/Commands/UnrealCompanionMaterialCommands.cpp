@@ -9,30 +9,33 @@
 #include "Materials/MaterialInstance.h"
 #include "Materials/MaterialInstanceConstant.h"
 #include "Materials/MaterialInstanceDynamic.h"
+#include "MaterialShared.h"
+#include "Engine/Texture.h"
+#include "ScopedTransaction.h"
 
 FUnrealCompanionMaterialCommands::FUnrealCompanionMaterialCommands()
 {
 }
 
+TConstArrayView<TMCPCommandEntry<FUnrealCompanionMaterialCommands>> FUnrealCompanionMaterialCommands::GetCommandTable()
+{
+    static constexpr TMCPCommandEntry<FUnrealCompanionMaterialCommands> Table[] = {
+        { TEXT("material_create"), &FUnrealCompanionMaterialCommands::HandleCreateMaterial },
+        { TEXT("material_create_instance"), &FUnrealCompanionMaterialCommands::HandleCreateMaterialInstance },
+        { TEXT("material_get_info"), &FUnrealCompanionMaterialCommands::HandleGetMaterialInfo },
+        { TEXT("material_set_parameter"), &FUnrealCompanionMaterialCommands::HandleSetMaterialParameter },
+        { TEXT("material_instance_batch"), &FUnrealCompanionMaterialCommands::HandleInstanceBatch },
+    };
+    static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+    return Table;
+}
+
 TSharedPtr<FJsonObject> FUnrealCompanionMaterialCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-    if (CommandType == TEXT("material_create"))
-    {
-        return HandleCreateMaterial(Params);
-    }
-    else if (CommandType == TEXT("material_create_instance"))
+    if (TSharedPtr<FJsonObject> Result = UnrealCompanionCommandTable::Dispatch(*this, GetCommandTable(), CommandType, Params))
     {
-        return HandleCreateMaterialInstance(Params);
+        return Result;
     }
-    else if (CommandType == TEXT("material_get_info"))
-    {
-        return HandleGetMaterialInfo(Params);
-    }
-    else if (CommandType == TEXT("material_set_parameter"))
-    {
-        return HandleSetMaterialParameter(Params);
-    }
-    
     return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown material command: %s"), *CommandType));
 }
 
@@ -308,3 +311,465 @@ TSharedPtr<FJsonObject> FUnrealCompanionMaterialCommands::HandleSetMaterialParam
 
     return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to set material parameter"));
 }
+
+namespace
+{
+    enum class EMaterialBatchParamType : uint8
+    {
+        Scalar,
+        Vector,
+        Texture,
+        StaticSwitch
+    };
+
+    const TCHAR* MaterialBatchParamTypeName(EMaterialBatchParamType Type)
+    {
+        switch (Type)
+        {
+        case EMaterialBatchParamType::Scalar:       return TEXT("scalar");
+        case EMaterialBatchParamType::Vector:       return TEXT("vector");
+        case EMaterialBatchParamType::Texture:      return TEXT("texture");
+        case EMaterialBatchParamType::StaticSwitch: return TEXT("static_switch");
+        }
+        return TEXT("unknown");
+    }
+
+    bool ParseMaterialBatchParamType(const FString& TypeName, EMaterialBatchParamType& OutType)
+    {
+        const FString Lower = TypeName.ToLower();
+        if (Lower == TEXT("scalar"))
+        {
+            OutType = EMaterialBatchParamType::Scalar;
+        }
+        else if (Lower == TEXT("vector"))
+        {
+            OutType = EMaterialBatchParamType::Vector;
+        }
+        else if (Lower == TEXT("texture"))
+        {
+            OutType = EMaterialBatchParamType::Texture;
+        }
+        else if (Lower == TEXT("static_switch") || Lower == TEXT("switch"))
+        {
+            OutType = EMaterialBatchParamType::StaticSwitch;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    /** A parent's parameters by name, collected once and shared by every instance of that parent */
+    struct FMaterialParentParameters
+    {
+        TMap<FName, TPair<EMaterialBatchParamType, FMaterialParameterInfo>> ByName;
+
+        explicit FMaterialParentParameters(const UMaterialInterface* Parent)
+        {
+            TArray<FMaterialParameterInfo> Infos;
+            TArray<FGuid> Guids;
+
+            Parent->GetAllScalarParameterInfo(Infos, Guids);
+            Add(Infos, EMaterialBatchParamType::Scalar);
+            Infos.Reset();
+            Guids.Reset();
+            Parent->GetAllVectorParameterInfo(Infos, Guids);
+            Add(Infos, EMaterialBatchParamType::Vector);
+            Infos.Reset();
+            Guids.Reset();
+            Parent->GetAllTextureParameterInfo(Infos, Guids);
+            Add(Infos, EMaterialBatchParamType::Texture);
+            Infos.Reset();
+            Guids.Reset();
+            Parent->GetAllStaticSwitchParameterInfo(Infos, Guids);
+            Add(Infos, EMaterialBatchParamType::StaticSwitch);
+        }
+
+    private:
+        void Add(const TArray<FMaterialParameterInfo>& Infos, EMaterialBatchParamType Type)
+        {
+            for (const FMaterialParameterInfo& Info : Infos)
+            {
+                // Layer parameters can repeat a name per layer; a bare name means the global one
+                if (Info.Association == EMaterialParameterAssociation::GlobalParameter || !ByName.Contains(Info.Name))
+                {
+                    ByName.Add(Info.Name, TPair<EMaterialBatchParamType, FMaterialParameterInfo>(Type, Info));
+                }
+            }
+        }
+    };
+
+    struct FMaterialBatchValue
+    {
+        EMaterialBatchParamType Type = EMaterialBatchParamType::Scalar;
+        FMaterialParameterInfo Info;
+        float Scalar = 0.0f;
+        FLinearColor Vector = FLinearColor::White;
+        UTexture* Texture = nullptr;
+        bool bSwitch = false;
+    };
+
+    struct FMaterialBatchInstance
+    {
+        FString Path;
+        UMaterialInstanceConstant* Instance = nullptr;
+        TArray<FMaterialBatchValue> Values;
+    };
+
+    /** Resolve one {name, type?, value} entry against the instance's parent */
+    bool ResolveMaterialBatchValue(
+        const TSharedPtr<FJsonObject>& ParamObj,
+        const FMaterialParentParameters& ParentParams,
+        TMap<FString, UTexture*>& TextureCache,
+        FMaterialBatchValue& OutValue,
+        FString& OutError)
+    {
+        FString Name;
+        if (!ParamObj->TryGetStringField(TEXT("name"), Name) || Name.IsEmpty())
+        {
+            OutError = TEXT("Missing 'name' field");
+            return false;
+        }
+
+        const TPair<EMaterialBatchParamType, FMaterialParameterInfo>* Found = ParentParams.ByName.Find(FName(*Name));
+        if (!Found)
+        {
+            OutError = FString::Printf(TEXT("Parameter '%s' not found on parent material"), *Name);
+            return false;
+        }
+
+        // The type is optional: the parent already knows it
+        FString TypeName;
+        if (ParamObj->TryGetStringField(TEXT("type"), TypeName))
+        {
+            EMaterialBatchParamType RequestedType;
+            if (!ParseMaterialBatchParamType(TypeName, RequestedType))
+            {
+                OutError = FString::Printf(TEXT("Unknown type '%s' (use: scalar, vector, texture, static_switch)"), *TypeName);
+                return false;
+            }
+            if (RequestedType != Found->Key)
+            {
+                OutError = FString::Printf(TEXT("'%s' is a %s parameter, not %s"),
+                    *Name, MaterialBatchParamTypeName(Found->Key), MaterialBatchParamTypeName(RequestedType));
+                return false;
+            }
+        }
+
+        OutValue.Type = Found->Key;
+        OutValue.Info = Found->Value;
+
+        switch (OutValue.Type)
+        {
+        case EMaterialBatchParamType::Scalar:
+        {
+            double Number;
+            if (!ParamObj->TryGetNumberField(TEXT("value"), Number))
+            {
+                OutError = FString::Printf(TEXT("'%s' needs a number value"), *Name);
+                return false;
+            }
+            OutValue.Scalar = (float)Number;
+            return true;
+        }
+        case EMaterialBatchParamType::Vector:
+        {
+            const TArray<TSharedPtr<FJsonValue>>* ColorArray;
+            if (!ParamObj->TryGetArrayField(TEXT("value"), ColorArray) || ColorArray->Num() < 3)
+            {
+                OutError = FString::Printf(TEXT("'%s' needs a [r, g, b] or [r, g, b, a] value"), *Name);
+                return false;
+            }
+            OutValue.Vector.R = (*ColorArray)[0]->AsNumber();
+            OutValue.Vector.G = (*ColorArray)[1]->AsNumber();
+            OutValue.Vector.B = (*ColorArray)[2]->AsNumber();
+            OutValue.Vector.A = ColorArray->Num() >= 4 ? (*ColorArray)[3]->AsNumber() : 1.0f;
+            return true;
+        }
+        case EMaterialBatchParamType::Texture:
+        {
+            FString TexturePath;
+            if (!ParamObj->TryGetStringField(TEXT("value"), TexturePath))
+            {
+                OutError = FString::Printf(TEXT("'%s' needs a texture path value"), *Name);
+                return false;
+            }
+            // Libraries tend to share a handful of textures: load each once per batch
+            UTexture** Cached = TextureCache.Find(TexturePath);
+            UTexture* Texture = Cached ? *Cached : TextureCache.Add(TexturePath, Cast<UTexture>(UEditorAssetLibrary::LoadAsset(TexturePath)));
+            if (!Texture)
+            {
+                OutError = FString::Printf(TEXT("Texture not found: %s"), *TexturePath);
+                return false;
+            }
+            OutValue.Texture = Texture;
+            return true;
+        }
+        case EMaterialBatchParamType::StaticSwitch:
+        {
+            if (!ParamObj->TryGetBoolField(TEXT("value"), OutValue.bSwitch))
+            {
+                OutError = FString::Printf(TEXT("'%s' needs a bool value"), *Name);
+                return false;
+            }
+            return true;
+        }
+        }
+        return false;
+    }
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionMaterialCommands::HandleInstanceBatch(const TSharedPtr<FJsonObject>& Params)
+{
+    FUnrealCompanionCommonUtils::FMCPStandardParams StdParams = FUnrealCompanionCommonUtils::GetStandardParams(Params);
+
+    // "instances": paths or {path, parameters}; "parameters" apply to every instance first
+    const TArray<TSharedPtr<FJsonValue>>* InstancesArray = nullptr;
+    if (!Params->TryGetArrayField(TEXT("instances"), InstancesArray) || InstancesArray->Num() == 0)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+            TEXT("INVALID_PARAMETER"),
+            TEXT("Missing or empty 'instances' array"),
+            TEXT("Provide material instance paths, or objects with path and parameters"));
+    }
+
+    if (InstancesArray->Num() > StdParams.MaxOperations)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+            TEXT("LIMIT_EXCEEDED"),
+            FString::Printf(TEXT("Too many instances: %d (max: %d)"), InstancesArray->Num(), StdParams.MaxOperations),
+            TEXT("Split into multiple batches"));
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* SharedParams = nullptr;
+    Params->TryGetArrayField(TEXT("parameters"), SharedParams);
+
+    bool bSave = true;
+    Params->TryGetBoolField(TEXT("save"), bSave);
+
+    // =========================================================================
+    // Validation: load every instance and resolve every value before touching any
+    // =========================================================================
+    TArray<FString> ValidationErrors;
+    TArray<FString> ValidationWarnings;
+
+    TArray<FMaterialBatchInstance> Batch;
+    TMap<FString, int32> PathToBatchIndex;
+    TMap<const UMaterialInterface*, TSharedPtr<FMaterialParentParameters>> ParentCache;
+    TMap<FString, UTexture*> TextureCache;
+
+    for (int32 i = 0; i < InstancesArray->Num(); i++)
+    {
+        const TSharedPtr<FJsonValue>& Item = (*InstancesArray)[i];
+
+        FString Path;
+        const TArray<TSharedPtr<FJsonValue>>* OwnParams = nullptr;
+        if (Item->Type == EJson::String)
+        {
+            Path = Item->AsString();
+        }
+        else if (Item->Type == EJson::Object)
+        {
+            const TSharedPtr<FJsonObject>& ItemObj = Item->AsObject();
+            ItemObj->TryGetStringField(TEXT("path"), Path);
+            ItemObj->TryGetArrayField(TEXT("parameters"), OwnParams);
+        }
+        if (Path.IsEmpty())
+        {
+            ValidationErrors.Add(FString::Printf(TEXT("Instance %d: Missing path"), i));
+            continue;
+        }
+        if (!SharedParams && !OwnParams)
+        {
+            ValidationWarnings.Add(FString::Printf(TEXT("Instance %d (%s): No parameters (will be skipped)"), i, *Path));
+            continue;
+        }
+
+        // An instance listed twice gets both lists of values, in order
+        int32* ExistingIndex = PathToBatchIndex.Find(Path);
+        FMaterialBatchInstance* Entry = ExistingIndex ? &Batch[*ExistingIndex] : nullptr;
+        if (!Entry)
+        {
+            UMaterialInstanceConstant* MatInstance = Cast<UMaterialInstanceConstant>(UEditorAssetLibrary::LoadAsset(Path));
+            if (!MatInstance)
+            {
+                ValidationErrors.Add(FString::Printf(TEXT("Instance %d: Material instance not found: %s"), i, *Path));
+                continue;
+            }
+            if (!MatInstance->Parent)
+            {
+                ValidationErrors.Add(FString::Printf(TEXT("Instance %d (%s): Has no parent material"), i, *Path));
+                continue;
+            }
+
+            PathToBatchIndex.Add(Path, Batch.Num());
+            Entry = &Batch.AddDefaulted_GetRef();
+            Entry->Path = Path;
+            Entry->Instance = MatInstance;
+        }
+
+        // Instances cannot add parameters, so a parent's table serves all of its children
+        TSharedPtr<FMaterialParentParameters>& ParentParams = ParentCache.FindOrAdd(Entry->Instance->Parent);
+        if (!ParentParams.IsValid())
+        {
+            ParentParams = MakeShared<FMaterialParentParameters>(Entry->Instance->Parent);
+        }
+
+        for (const TArray<TSharedPtr<FJsonValue>>* ParamList : { SharedParams, OwnParams })
+        {
+            if (!ParamList)
+            {
+                continue;
+            }
+            for (int32 j = 0; j < ParamList->Num(); j++)
+            {
+                const TSharedPtr<FJsonObject>* ParamObj = nullptr;
+                if (!(*ParamList)[j]->TryGetObject(ParamObj))
+                {
+                    ValidationErrors.Add(FString::Printf(TEXT("Instance %d (%s), parameter %d: Invalid JSON object"), i, *Path, j));
+                    continue;
+                }
+
+                FMaterialBatchValue Value;
+                FString Error;
+                if (ResolveMaterialBatchValue(*ParamObj, *ParentParams, TextureCache, Value, Error))
+                {
+                    Entry->Values.Add(Value);
+                }
+                else
+                {
+                    ValidationErrors.Add(FString::Printf(TEXT("Instance %d (%s), parameter %d: %s"), i, *Path, j, *Error));
+                }
+            }
+        }
+    }
+
+    int32 WouldSet = 0;
+    int32 WouldRecompile = 0;
+    for (const FMaterialBatchInstance& Entry : Batch)
+    {
+        WouldSet += Entry.Values.Num();
+        WouldRecompile += Entry.Values.ContainsByPredicate([](const FMaterialBatchValue& V) { return V.Type == EMaterialBatchParamType::StaticSwitch; }) ? 1 : 0;
+    }
+
+    if (StdParams.bDryRun)
+    {
+        TSharedPtr<FJsonObject> WouldDoData = MakeShared<FJsonObject>();
+        WouldDoData->SetNumberField(TEXT("would_modify"), Batch.Num());
+        WouldDoData->SetNumberField(TEXT("would_set"), WouldSet);
+        WouldDoData->SetNumberField(TEXT("would_recompile"), WouldRecompile);
+        WouldDoData->SetNumberField(TEXT("parents"), ParentCache.Num());
+
+        return FUnrealCompanionCommonUtils::CreateDryRunResponse(
+            ValidationErrors.Num() == 0,
+            ValidationErrors,
+            ValidationWarnings,
+            WouldDoData);
+    }
+
+    if (ValidationErrors.Num() > 0 && StdParams.OnError == TEXT("rollback"))
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+            TEXT("VALIDATION_ERROR"),
+            FString::Printf(TEXT("Validation failed with %d errors"), ValidationErrors.Num()),
+            ValidationErrors[0]);
+    }
+
+    // =========================================================================
+    // Apply: one PostEditChange per instance, one render-state refresh for the batch
+    // =========================================================================
+    TArray<TSharedPtr<FJsonObject>> Results;
+    TArray<UObject*> ModifiedAssets;
+    {
+        FScopedTransaction Transaction(FText::FromString(TEXT("MCP Material Instance Batch")));
+
+        // Components using any of these instances re-create their render state once, when this goes out of scope
+        FMaterialUpdateContext UpdateContext;
+
+        for (const FMaterialBatchInstance& Entry : Batch)
+        {
+            if (Entry.Values.Num() == 0)
+            {
+                continue;
+            }
+
+            UMaterialInstanceConstant* MatInstance = Entry.Instance;
+            MatInstance->PreEditChange(nullptr);
+
+            // Static switches change the shader permutation: gather them for a single recompile
+            FStaticParameterSet StaticParams;
+            bool bStaticChanged = false;
+
+            for (const FMaterialBatchValue& Value : Entry.Values)
+            {
+                switch (Value.Type)
+                {
+                case EMaterialBatchParamType::Scalar:
+                    MatInstance->SetScalarParameterValueEditorOnly(Value.Info, Value.Scalar);
+                    break;
+                case EMaterialBatchParamType::Vector:
+                    MatInstance->SetVectorParameterValueEditorOnly(Value.Info, Value.Vector);
+                    break;
+                case EMaterialBatchParamType::Texture:
+                    MatInstance->SetTextureParameterValueEditorOnly(Value.Info, Value.Texture);
+                    break;
+                case EMaterialBatchParamType::StaticSwitch:
+                {
+                    if (!bStaticChanged)
+                    {
+                        MatInstance->GetStaticParameterValues(StaticParams);
+                        bStaticChanged = true;
+                    }
+                    FStaticSwitchParameter* Existing = StaticParams.StaticSwitchParameters.FindByPredicate(
+                        [&Value](const FStaticSwitchParameter& P) { return P.ParameterInfo == Value.Info; });
+                    if (Existing)
+                    {
+                        Existing->Value = Value.bSwitch;
+                        Existing->bOverride = true;
+                    }
+                    else
+                    {
+                        StaticParams.StaticSwitchParameters.Add(FStaticSwitchParameter(Value.Info, Value.bSwitch, true, FGuid()));
+                    }
+                    break;
+                }
+                }
+            }
+
+            if (bStaticChanged)
+            {
+                MatInstance->UpdateStaticPermutation(StaticParams, &UpdateContext);
+            }
+            MatInstance->PostEditChange();
+            UpdateContext.AddMaterialInstance(MatInstance);
+            ModifiedAssets.Add(MatInstance);
+
+            TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+            ResultObj->SetStringField(TEXT("path"), Entry.Path);
+            ResultObj->SetNumberField(TEXT("parameters_set"), Entry.Values.Num());
+            ResultObj->SetBoolField(TEXT("recompiled"), bStaticChanged);
+            Results.Add(ResultObj);
+        }
+    }
+
+    bool bSaved = false;
+    if (bSave && ModifiedAssets.Num() > 0)
+    {
+        bSaved = UEditorAssetLibrary::SaveLoadedAssets(ModifiedAssets, true);
+    }
+
+    TArray<TSharedPtr<FJsonObject>> Errors;
+    Errors.Reserve(ValidationErrors.Num());
+    for (const FString& Error : ValidationErrors)
+    {
+        Errors.Add(FUnrealCompanionCommonUtils::CreateBatchErrorObject(TEXT(""), Error));
+    }
+
+    TSharedPtr<FJsonObject> ResponseObj = FUnrealCompanionCommonUtils::CreateBatchResponse(
+        Errors.Num() == 0, Results.Num(), Errors.Num(), Results, Errors);
+    ResponseObj->SetNumberField(TEXT("parameters_set"), WouldSet);
+    ResponseObj->SetNumberField(TEXT("parents"), ParentCache.Num());
+    ResponseObj->SetBoolField(TEXT("saved"), bSaved);
+    return ResponseObj;
+}
@@ -2,6 +2,7 @@
 
 #include "Commands/UnrealCompanionNiagaraCommands.h"
 #include "Commands/UnrealCompanionCommonUtils.h"
+#include "Commands/UnrealCompanionNiagaraCompileQueue.h"
 #include "EditorAssetLibrary.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Editor.h"
@@ -22,6 +23,36 @@
 #include "NiagaraTypes.h"
 #include "NiagaraParameterStore.h"
 
+namespace
+{
+    /**
+     * Queue System's compile (coalesced with other commands touching it) and, with
+     * wait_for_compile, reply only once its scripts are compiled.
+     * Returns nullptr when the reply was deferred.
+     */
+    TSharedPtr<FJsonObject> FinishCompile(UNiagaraSystem* System, bool bNeedsCompile, const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonObject>& ResultObj)
+    {
+        FUnrealCompanionNiagaraCompileQueue& CompileQueue = FUnrealCompanionNiagaraCompileQueue::Get();
+        if (bNeedsCompile)
+        {
+            CompileQueue.Request(System);
+        }
+        ResultObj->SetBoolField(TEXT("compile_queued"), CompileQueue.IsPending(System));
+
+        bool bWaitForCompile = false;
+        Params->TryGetBoolField(TEXT("wait_for_compile"), bWaitForCompile);
+        if (!bWaitForCompile)
+        {
+            return ResultObj;
+        }
+
+        double TimeoutSeconds = 60.0;
+        Params->TryGetNumberField(TEXT("compile_timeout"), TimeoutSeconds);
+        ResultObj->SetBoolField(TEXT("compile_queued"), false);
+        return CompileQueue.WaitForCompile(System, TimeoutSeconds, ResultObj);
+    }
+}
+
 FUnrealCompanionNiagaraCommands::FUnrealCompanionNiagaraCommands()
 {
 }
@@ -33,21 +64,23 @@ UNiagaraSystem* FUnrealCompanionNiagaraCommands::LoadNiagaraSystem(const FString
     return Cast<UNiagaraSystem>(Asset);
 }
 
+TConstArrayView<TMCPCommandEntry<FUnrealCompanionNiagaraCommands>> FUnrealCompanionNiagaraCommands::GetCommandTable()
+{
+    static constexpr TMCPCommandEntry<FUnrealCompanionNiagaraCommands> Table[] = {
+        { TEXT("niagara_emitter_batch"), &FUnrealCompanionNiagaraCommands::HandleEmitterBatch },
+        { TEXT("niagara_param_batch"), &FUnrealCompanionNiagaraCommands::HandleParamBatch },
+        { TEXT("niagara_spawn"), &FUnrealCompanionNiagaraCommands::HandleSpawn },
+    };
+    static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+    return Table;
+}
+
 TSharedPtr<FJsonObject> FUnrealCompanionNiagaraCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-    if (CommandType == TEXT("niagara_emitter_batch"))
-    {
-        return HandleEmitterBatch(Params);
-    }
-    else if (CommandType == TEXT("niagara_param_batch"))
-    {
-        return HandleParamBatch(Params);
-    }
-    else if (CommandType == TEXT("niagara_spawn"))
+    if (TSharedPtr<FJsonObject> Result = UnrealCompanionCommandTable::Dispatch(*this, GetCommandTable(), CommandType, Params))
     {
-        return HandleSpawn(Params);
+        return Result;
     }
-    
     return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Unknown niagara command: ") + CommandType);
 }
 
@@ -226,8 +259,6 @@ TSharedPtr<FJsonObject> FUnrealCompanionNiagaraCommands::HandleEmitterBatch(cons
         }
     }
     
-    // Request recompile after batch operations
-    NiagaraSystem->RequestCompile(false);
     NiagaraSystem->MarkPackageDirty();
     
     ResultObj->SetArrayField(TEXT("results"), ResultsArray);
@@ -235,7 +266,8 @@ TSharedPtr<FJsonObject> FUnrealCompanionNiagaraCommands::HandleEmitterBatch(cons
     ResultObj->SetNumberField(TEXT("error_count"), ErrorCount);
     ResultObj->SetBoolField(TEXT("success"), ErrorCount == 0);
     
-    return ResultObj;
+    // One compile per system for everything queued before the next tick
+    return FinishCompile(NiagaraSystem, SuccessCount > 0, Params, ResultObj);
 }
 
 // ============================================================================
@@ -273,6 +305,16 @@ TSharedPtr<FJsonObject> FUnrealCompanionNiagaraCommands::HandleParamBatch(const
     
     FNiagaraUserRedirectionParameterStore& ParamStore = NiagaraSystem->GetExposedParameters();
     
+    // Hashed once per batch and kept current, instead of rescanning the store for each op
+    TMap<FName, FNiagaraVariableBase> ExistingVars;
+    for (const FNiagaraVariableWithOffset& Existing : ParamStore.ReadParameterVariables())
+    {
+        ExistingVars.Add(Existing.GetName(), Existing);
+    }
+    
+    // Adding or removing user parameters changes what the scripts bind; setting values does not
+    bool bNeedsCompile = false;
+    
     for (const TSharedPtr<FJsonValue>& OpValue : *OperationsArray)
     {
         const TSharedPtr<FJsonObject>* OpObj;
@@ -347,18 +389,12 @@ TSharedPtr<FJsonObject> FUnrealCompanionNiagaraCommands::HandleParamBatch(const
                 // For "set" action, try to find existing param type
                 if (Action == TEXT("set"))
                 {
-                    auto ExistingVars = ParamStore.ReadParameterVariables();
-                    bool bFoundExisting = false;
-                    for (const auto& Var : ExistingVars)
+                    const FNiagaraVariableBase* Existing = ExistingVars.Find(FName(*ParamName));
+                    if (Existing)
                     {
-                        if (Var.GetName().ToString() == ParamName)
-                        {
-                            TypeDef = Var.GetType();
-                            bFoundExisting = true;
-                            break;
-                        }
+                        TypeDef = Existing->GetType();
                     }
-                    if (!bFoundExisting)
+                    else
                     {
                         OpResult->SetBoolField(TEXT("success"), false);
                         OpResult->SetStringField(TEXT("error"), FString::Printf(TEXT("Parameter not found and no type specified: %s"), *ParamName));
@@ -442,6 +478,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionNiagaraCommands::HandleParamBatch(const
             }
             
             // Add or update the parameter
+            const bool bIsNew = !ExistingVars.Contains(Var.GetName());
             if (Action == TEXT("add"))
             {
                 ParamStore.AddParameter(Var, true);
@@ -451,6 +488,11 @@ TSharedPtr<FJsonObject> FUnrealCompanionNiagaraCommands::HandleParamBatch(const
                 // For set, update the value in the parameter store
                 ParamStore.SetParameterData(Var.GetData(), Var, true);
             }
+            if (bIsNew)
+            {
+                ExistingVars.Add(Var.GetName(), Var);
+                bNeedsCompile = true;
+            }
             
             OpResult->SetBoolField(TEXT("success"), true);
             OpResult->SetStringField(TEXT("type"), TypeDef.GetName());
@@ -459,21 +501,11 @@ TSharedPtr<FJsonObject> FUnrealCompanionNiagaraCommands::HandleParamBatch(const
         else if (Action == TEXT("remove"))
         {
             // Find the parameter and remove it
-            auto ExistingVars = ParamStore.ReadParameterVariables();
-            bool bFound = false;
-            
-            for (const auto& Var : ExistingVars)
-            {
-                if (Var.GetName().ToString() == ParamName)
-                {
-                    ParamStore.RemoveParameter(Var);
-                    bFound = true;
-                    break;
-                }
-            }
-            
-            if (bFound)
+            FNiagaraVariableBase Existing;
+            if (ExistingVars.RemoveAndCopyValue(FName(*ParamName), Existing))
             {
+                ParamStore.RemoveParameter(Existing);
+                bNeedsCompile = true;
                 OpResult->SetBoolField(TEXT("success"), true);
                 SuccessCount++;
             }
@@ -507,7 +539,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionNiagaraCommands::HandleParamBatch(const
     ResultObj->SetNumberField(TEXT("error_count"), ErrorCount);
     ResultObj->SetBoolField(TEXT("success"), ErrorCount == 0);
     
-    return ResultObj;
+    return FinishCompile(NiagaraSystem, bNeedsCompile, Params, ResultObj);
 }
 
 // ============================================================================
@@ -528,6 +560,9 @@ TSharedPtr<FJsonObject> FUnrealCompanionNiagaraCommands::HandleSpawn(const TShar
         return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("NiagaraSystem not found: %s"), *SystemPath));
     }
     
+    // Don't let the spawned component start from scripts older than the last batch
+    FUnrealCompanionNiagaraCompileQueue::Get().Flush(NiagaraSystem);
+    
     // Location
     FVector Location = FVector::ZeroVector;
     if (Params->HasField(TEXT("location")))
@@ -0,0 +1,196 @@
+#include "Commands/UnrealCompanionNiagaraCompileQueue.h"
+#include "Commands/UnrealCompanionCompileSession.h"
+#include "UnrealCompanionStats.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+#include "NiagaraSystem.h"
+#include "NiagaraEmitter.h"
+#include "NiagaraEmitterHandle.h"
+#include "NiagaraScript.h"
+
+FUnrealCompanionNiagaraCompileQueue& FUnrealCompanionNiagaraCompileQueue::Get()
+{
+    static FUnrealCompanionNiagaraCompileQueue Instance;
+    return Instance;
+}
+
+void FUnrealCompanionNiagaraCompileQueue::Request(UNiagaraSystem* System)
+{
+    check(IsInGameThread());
+    if (!System)
+    {
+        return;
+    }
+
+    Pending.AddUnique(System);
+    EnsureTicker();
+}
+
+bool FUnrealCompanionNiagaraCompileQueue::IsPending(const UNiagaraSystem* System) const
+{
+    return Pending.Contains(System);
+}
+
+void FUnrealCompanionNiagaraCompileQueue::Flush(UNiagaraSystem* System)
+{
+    check(IsInGameThread());
+    if (System && Pending.Remove(System) > 0)
+    {
+        UNREALCOMPANION_SCOPE_CYCLE_COUNTER(STAT_UnrealCompanion_Compile);
+        System->RequestCompile(false);
+    }
+}
+
+void FUnrealCompanionNiagaraCompileQueue::IssuePending()
+{
+    if (Pending.Num() == 0)
+    {
+        return;
+    }
+
+    UNREALCOMPANION_SCOPE_CYCLE_COUNTER(STAT_UnrealCompanion_Compile);
+    for (const TWeakObjectPtr<UNiagaraSystem>& Weak : Pending)
+    {
+        if (UNiagaraSystem* System = Weak.Get())
+        {
+            System->RequestCompile(false);
+        }
+    }
+    UE_LOG(LogTemp, Verbose, TEXT("UnrealCompanion: Requested compile of %d Niagara systems"), Pending.Num());
+    Pending.Reset();
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionNiagaraCompileQueue::WaitForCompile(UNiagaraSystem* System, double TimeoutSeconds, const TSharedPtr<FJsonObject>& Response)
+{
+    check(IsInGameThread());
+    Flush(System);
+
+    if (!FUnrealCompanionDeferredResponse::CanDefer())
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        System->WaitForCompilationComplete(true, false);
+
+        TSharedPtr<FJsonObject> Status = BuildCompileStatus(System);
+        Status->SetNumberField(TEXT("wait_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+        Response->SetObjectField(TEXT("compile"), Status);
+        return Response;
+    }
+
+    FWaiter& Waiter = Waiters.AddDefaulted_GetRef();
+    Waiter.System = System;
+    Waiter.Response = Response;
+    Waiter.Completion = FUnrealCompanionDeferredResponse::Defer();
+    Waiter.StartTime = FPlatformTime::Seconds();
+    Waiter.Deadline = Waiter.StartTime + FMath::Max(TimeoutSeconds, 0.0);
+    EnsureTicker();
+    return nullptr;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionNiagaraCompileQueue::BuildCompileStatus(UNiagaraSystem* System)
+{
+    TSharedPtr<FJsonObject> Status = MakeShared<FJsonObject>();
+    if (!System)
+    {
+        Status->SetBoolField(TEXT("ready"), false);
+        Status->SetStringField(TEXT("error"), TEXT("Niagara system was unloaded"));
+        return Status;
+    }
+
+    const bool bCompiling = System->HasOutstandingCompilationRequests(true);
+    Status->SetBoolField(TEXT("compiling"), bCompiling);
+    Status->SetBoolField(TEXT("ready"), !bCompiling && System->IsReadyToRun());
+
+    TArray<TSharedPtr<FJsonValue>> Emitters;
+    for (const FNiagaraEmitterHandle& Handle : System->GetEmitterHandles())
+    {
+        FVersionedNiagaraEmitterData* EmitterData = Handle.GetEmitterData();
+        if (!EmitterData)
+        {
+            continue;
+        }
+
+        // GPU emitters run their compute script; CPU ones are ready when the spawn script is
+        const bool bGPU = EmitterData->SimTarget == ENiagaraSimTarget::GPUComputeSim;
+        const UNiagaraScript* Script = bGPU ? EmitterData->GetGPUComputeScript() : EmitterData->SpawnScriptProps.Script;
+
+        TSharedPtr<FJsonObject> EmitterObj = MakeShared<FJsonObject>();
+        EmitterObj->SetStringField(TEXT("name"), Handle.GetName().ToString());
+        EmitterObj->SetBoolField(TEXT("enabled"), Handle.GetIsEnabled());
+        EmitterObj->SetStringField(TEXT("sim_target"), bGPU ? TEXT("gpu") : TEXT("cpu"));
+        EmitterObj->SetBoolField(TEXT("ready"), Script && Script->IsReadyToRun(EmitterData->SimTarget));
+        Emitters.Add(MakeShared<FJsonValueObject>(EmitterObj));
+    }
+    Status->SetArrayField(TEXT("emitters"), Emitters);
+    return Status;
+}
+
+void FUnrealCompanionNiagaraCompileQueue::CompleteWaiter(FWaiter& Waiter, bool bTimedOut)
+{
+    TSharedPtr<FJsonObject> Status = BuildCompileStatus(Waiter.System.Get());
+    Status->SetBoolField(TEXT("timed_out"), bTimedOut);
+    Status->SetNumberField(TEXT("wait_ms"), (FPlatformTime::Seconds() - Waiter.StartTime) * 1000.0);
+    Waiter.Response->SetObjectField(TEXT("compile"), Status);
+
+    FUnrealCompanionDeferredResponse::FCompletion Done = MoveTemp(Waiter.Completion);
+    Done(Waiter.Response);
+}
+
+void FUnrealCompanionNiagaraCompileQueue::EnsureTicker()
+{
+    if (!TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateRaw(this, &FUnrealCompanionNiagaraCompileQueue::Tick));
+    }
+}
+
+bool FUnrealCompanionNiagaraCompileQueue::Tick(float DeltaTime)
+{
+    // Every command handled since the last tick has had its say; a session holds them until commit
+    if (!FUnrealCompanionCompileSession::Get().IsActive())
+    {
+        IssuePending();
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    for (int32 Index = Waiters.Num() - 1; Index >= 0; --Index)
+    {
+        FWaiter& Waiter = Waiters[Index];
+        UNiagaraSystem* System = Waiter.System.Get();
+        bool bDone = true;
+        if (System)
+        {
+            System->PollForCompilationComplete();
+            bDone = !System->HasOutstandingCompilationRequests(true);
+        }
+
+        if (bDone || Now >= Waiter.Deadline)
+        {
+            CompleteWaiter(Waiter, !bDone);
+            Waiters.RemoveAt(Index);
+        }
+    }
+
+    if (Pending.Num() > 0 || Waiters.Num() > 0)
+    {
+        return true;
+    }
+    TickerHandle.Reset();
+    return false;
+}
+
+void FUnrealCompanionNiagaraCompileQueue::Shutdown()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+
+    IssuePending();
+    for (FWaiter& Waiter : Waiters)
+    {
+        CompleteWaiter(Waiter, true);
+    }
+    Waiters.Reset();
+}
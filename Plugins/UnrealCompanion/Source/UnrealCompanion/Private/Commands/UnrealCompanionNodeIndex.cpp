@@ -0,0 +1,451 @@
+#include "Commands/UnrealCompanionNodeIndex.h"
+#include "Commands/UnrealCompanionJobManager.h"
+#include "UnrealCompanionSettings.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonValue.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Event.h"
+#include "K2Node_MacroInstance.h"
+#include "K2Node_Variable.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "String/Find.h"
+#include "UObject/Package.h"
+
+namespace
+{
+    // Bump CacheVersion whenever FNodeRecord or its meaning changes
+    constexpr uint32 CacheMagic = 0x4E494458; // "NIDX"
+    constexpr int32 CacheVersion = 1;
+
+    bool ContainsText(FName Name, const FString& Text)
+    {
+        if (Text.IsEmpty())
+        {
+            return true;
+        }
+        if (Name.IsNone())
+        {
+            return false;
+        }
+        // Builds the name on the stack: this runs per node on the search workers
+        FNameBuilder Builder(Name);
+        return UE::String::FindFirst(Builder.ToView(), Text, ESearchCase::IgnoreCase) != INDEX_NONE;
+    }
+
+    bool MatchesPattern(FStringView Value, const FString& Pattern, bool bWildcard)
+    {
+        if (bWildcard)
+        {
+            return FString(Value).MatchesWildcard(Pattern);
+        }
+        return UE::String::FindFirst(Value, Pattern, ESearchCase::IgnoreCase) != INDEX_NONE;
+    }
+
+    FIoHash GetSavedHash(const IAssetRegistry& AssetRegistry, FName PackageName)
+    {
+        const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+        return PackageData.IsSet() ? PackageData->GetPackageSavedHash() : FIoHash();
+    }
+}
+
+FArchive& operator<<(FArchive& Ar, FUnrealCompanionNodeIndex::FNodeRecord& Node)
+{
+    uint8 Kind = static_cast<uint8>(Node.Kind);
+    Ar << Node.Graph << Node.NodeGuid << Node.NodeClass << Node.Title << Kind << Node.Member << Node.MemberParent;
+    Node.Kind = static_cast<FUnrealCompanionNodeIndex::ENodeKind>(Kind);
+    return Ar;
+}
+
+FUnrealCompanionNodeIndex& FUnrealCompanionNodeIndex::Get()
+{
+    static FUnrealCompanionNodeIndex Instance;
+    return Instance;
+}
+
+const TCHAR* FUnrealCompanionNodeIndex::GetKindName(ENodeKind Kind)
+{
+    switch (Kind)
+    {
+    case ENodeKind::FunctionCall: return TEXT("function_call");
+    case ENodeKind::Event:        return TEXT("event");
+    case ENodeKind::VariableGet:  return TEXT("variable_get");
+    case ENodeKind::VariableSet:  return TEXT("variable_set");
+    case ENodeKind::Macro:        return TEXT("macro");
+    default:                      return TEXT("other");
+    }
+}
+
+// =========================================================================
+// CACHE
+// =========================================================================
+
+FString FUnrealCompanionNodeIndex::GetCachePath()
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealCompanion"), TEXT("NodeIndex.bin"));
+}
+
+void FUnrealCompanionNodeIndex::EnsureLoaded()
+{
+    if (bLoaded)
+    {
+        return;
+    }
+    bLoaded = true;
+
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *GetCachePath(), FILEREAD_Silent))
+    {
+        return;
+    }
+
+    FMemoryReader Reader(Bytes);
+    uint32 Magic = 0;
+    int32 Version = 0;
+    int32 NumRecords = 0;
+    Reader << Magic << Version << NumRecords;
+    if (Magic != CacheMagic || Version != CacheVersion || NumRecords < 0)
+    {
+        UE_LOG(LogTemp, Display, TEXT("UnrealCompanion: Ignoring node index cache from another version"));
+        return;
+    }
+
+    for (int32 Index = 0; Index < NumRecords && !Reader.IsError(); ++Index)
+    {
+        TSharedPtr<FBlueprintRecord> Record = MakeShared<FBlueprintRecord>();
+        Reader << Record->ObjectPath << Record->SavedHash << Record->Nodes;
+        if (!Reader.IsError())
+        {
+            Records.Add(Record->ObjectPath, Record);
+        }
+    }
+
+    if (Reader.IsError())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UnrealCompanion: Node index cache is corrupt, rebuilding"));
+        Records.Reset();
+        return;
+    }
+    UE_LOG(LogTemp, Display, TEXT("UnrealCompanion: Loaded node index for %d Blueprints"), Records.Num());
+}
+
+void FUnrealCompanionNodeIndex::SaveCache()
+{
+    if (!bCacheDirty)
+    {
+        return;
+    }
+
+    // Deleted and renamed Blueprints would otherwise stay in the file forever
+    const IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+    for (auto It = Records.CreateIterator(); It; ++It)
+    {
+        if (!AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(It->Key)).IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    uint32 Magic = CacheMagic;
+    int32 Version = CacheVersion;
+    int32 NumRecords = Records.Num();
+    Writer << Magic << Version << NumRecords;
+    for (const TPair<FString, TSharedPtr<const FBlueprintRecord>>& Pair : Records)
+    {
+        // The records are immutable to everyone else; serialization just needs a non-const archive operand
+        FBlueprintRecord& Record = const_cast<FBlueprintRecord&>(*Pair.Value);
+        Writer << Record.ObjectPath << Record.SavedHash << Record.Nodes;
+    }
+
+    if (FFileHelper::SaveArrayToFile(Bytes, *GetCachePath()))
+    {
+        bCacheDirty = false;
+        UE_LOG(LogTemp, Display, TEXT("UnrealCompanion: Saved node index for %d Blueprints (%d KB)"), Records.Num(), Bytes.Num() / 1024);
+    }
+}
+
+// =========================================================================
+// BUILD
+// =========================================================================
+
+TSharedPtr<const FUnrealCompanionNodeIndex::FBlueprintRecord> FUnrealCompanionNodeIndex::BuildRecord(UBlueprint* Blueprint, const FIoHash& SavedHash)
+{
+    TSharedPtr<FBlueprintRecord> Record = MakeShared<FBlueprintRecord>();
+    Record->ObjectPath = Blueprint->GetPathName();
+    Record->SavedHash = SavedHash;
+
+    TArray<UEdGraph*> Graphs;
+    Blueprint->GetAllGraphs(Graphs);
+    for (const UEdGraph* Graph : Graphs)
+    {
+        if (!Graph)
+        {
+            continue;
+        }
+
+        for (UEdGraphNode* Node : Graph->Nodes)
+        {
+            if (!Node)
+            {
+                continue;
+            }
+
+            FNodeRecord& NodeRecord = Record->Nodes.AddDefaulted_GetRef();
+            NodeRecord.Graph = Graph->GetFName();
+            NodeRecord.NodeGuid = Node->NodeGuid;
+            NodeRecord.NodeClass = Node->GetClass()->GetFName();
+            NodeRecord.Title = Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
+
+            if (UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
+            {
+                NodeRecord.Kind = ENodeKind::FunctionCall;
+                NodeRecord.Member = CallNode->FunctionReference.GetMemberName();
+                if (const UFunction* Function = CallNode->GetTargetFunction())
+                {
+                    NodeRecord.MemberParent = Function->GetOwnerClass()->GetFName();
+                }
+            }
+            else if (UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+            {
+                NodeRecord.Kind = ENodeKind::Event;
+                NodeRecord.Member = EventNode->GetFunctionName();
+                if (const UFunction* Signature = EventNode->FindEventSignatureFunction())
+                {
+                    NodeRecord.MemberParent = Signature->GetOwnerClass()->GetFName();
+                }
+            }
+            else if (UK2Node_Variable* VariableNode = Cast<UK2Node_Variable>(Node))
+            {
+                NodeRecord.Kind = Cast<UK2Node_VariableSet>(Node) ? ENodeKind::VariableSet
+                    : Cast<UK2Node_VariableGet>(Node) ? ENodeKind::VariableGet : ENodeKind::Other;
+                NodeRecord.Member = VariableNode->VariableReference.GetMemberName();
+                if (const FProperty* Property = VariableNode->GetPropertyForVariable())
+                {
+                    if (const UClass* Owner = Property->GetOwnerClass())
+                    {
+                        NodeRecord.MemberParent = Owner->GetFName();
+                    }
+                }
+            }
+            else if (UK2Node_MacroInstance* MacroNode = Cast<UK2Node_MacroInstance>(Node))
+            {
+                NodeRecord.Kind = ENodeKind::Macro;
+                if (const UEdGraph* MacroGraph = MacroNode->GetMacroGraph())
+                {
+                    NodeRecord.Member = MacroGraph->GetFName();
+                    if (const UBlueprint* Library = MacroGraph->GetTypedOuter<UBlueprint>())
+                    {
+                        NodeRecord.MemberParent = Library->GetFName();
+                    }
+                }
+            }
+        }
+    }
+    return Record;
+}
+
+FString FUnrealCompanionNodeIndex::IndexBlueprints(const TArray<FString>& ObjectPaths, bool bStreamProgress)
+{
+    check(IsInGameThread());
+    for (const FString& ObjectPath : ObjectPaths)
+    {
+        IndexQueue.AddUnique(ObjectPath);
+    }
+
+    // A running job just picks up the new paths
+    if (!IndexJobId.IsEmpty())
+    {
+        return IndexJobId;
+    }
+
+    FUnrealCompanionJobManager::FHooks Hooks;
+    Hooks.Tick = [this](const FString& JobId)
+    {
+        FUnrealCompanionJobManager& Jobs = FUnrealCompanionJobManager::Get();
+        const IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+        // Loading is the expensive part; same budget as the scheduler, at least one Blueprint per tick
+        const double BudgetSeconds = GetDefault<UUnrealCompanionSettings>()->GameThreadBudgetMs / 1000.0;
+        const double TickStart = FPlatformTime::Seconds();
+        while (IndexQueueNext < IndexQueue.Num() && !Jobs.IsCancelRequested(JobId))
+        {
+            const FString& ObjectPath = IndexQueue[IndexQueueNext++];
+            if (UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *ObjectPath, nullptr, LOAD_NoWarn))
+            {
+                const FIoHash SavedHash = GetSavedHash(AssetRegistry, Blueprint->GetOutermost()->GetFName());
+                Records.Add(ObjectPath, BuildRecord(Blueprint, SavedHash));
+                bCacheDirty = true;
+            }
+            if (FPlatformTime::Seconds() - TickStart >= BudgetSeconds)
+            {
+                break;
+            }
+        }
+
+        if (IndexQueueNext < IndexQueue.Num() && !Jobs.IsCancelRequested(JobId))
+        {
+            Jobs.SetProgress(JobId, (double)IndexQueueNext / IndexQueue.Num(), TEXT("indexing"));
+            return;
+        }
+
+        SaveCache();
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetBoolField(TEXT("success"), true);
+        Result->SetNumberField(TEXT("indexed"), IndexQueueNext);
+        Result->SetNumberField(TEXT("remaining"), IndexQueue.Num() - IndexQueueNext);
+        Result->SetNumberField(TEXT("index_size"), Records.Num());
+
+        IndexQueue.Reset();
+        IndexQueueNext = 0;
+        IndexJobId.Reset();
+        Jobs.Finish(JobId, Result);
+    };
+    // The tick sees the request and stops at its next Blueprint
+    Hooks.Cancel = [](const FString&) {};
+
+    IndexJobId = FUnrealCompanionJobManager::Get().Start(TEXT("node_index"), MoveTemp(Hooks), bStreamProgress);
+    return IndexJobId;
+}
+
+// =========================================================================
+// SEARCH
+// =========================================================================
+
+bool FUnrealCompanionNodeIndex::MatchesRecord(const FNodeRecord& Node, const FQuery& Query)
+{
+    if (!Query.Event.IsEmpty() && (Node.Kind != ENodeKind::Event || !ContainsText(Node.Member, Query.Event)))
+    {
+        return false;
+    }
+    if (!ContainsText(Node.NodeClass, Query.NodeClass) || !ContainsText(Node.MemberParent, Query.MemberParent))
+    {
+        return false;
+    }
+    if (!Query.Pattern.IsEmpty())
+    {
+        const bool bWildcard = Query.Pattern.Contains(TEXT("*")) || Query.Pattern.Contains(TEXT("?"));
+        bool bMatched = false;
+        if (!Node.Member.IsNone())
+        {
+            FNameBuilder Member(Node.Member);
+            bMatched = MatchesPattern(Member.ToView(), Query.Pattern, bWildcard);
+        }
+        if (!bMatched && !MatchesPattern(Node.Title, Query.Pattern, bWildcard))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+FUnrealCompanionNodeIndex::FSearchResult FUnrealCompanionNodeIndex::Search(const FQuery& Query)
+{
+    check(IsInGameThread());
+    const double StartTime = FPlatformTime::Seconds();
+    EnsureLoaded();
+
+    FSearchResult Result;
+    const IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+    FARFilter Filter;
+    Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+    Filter.bRecursiveClasses = true;
+    Filter.PackagePaths.Add(FName(*Query.Path));
+    Filter.bRecursivePaths = true;
+
+    TArray<FAssetData> Assets;
+    AssetRegistry.GetAssets(Filter, Assets);
+    Assets.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+
+    // Game thread part: pick each Blueprint's summary, rebuilding the ones memory knows better
+    TArray<TSharedPtr<const FBlueprintRecord>> Snapshot;
+    Snapshot.Reserve(Assets.Num());
+    for (const FAssetData& Asset : Assets)
+    {
+        const FString ObjectPath = Asset.GetObjectPathString();
+        const FIoHash SavedHash = GetSavedHash(AssetRegistry, Asset.PackageName);
+        UBlueprint* Loaded = Asset.IsAssetLoaded() ? Cast<UBlueprint>(Asset.FastGetAsset(false)) : nullptr;
+        const bool bDirty = Loaded && Loaded->GetOutermost()->IsDirty();
+
+        const TSharedPtr<const FBlueprintRecord>* Existing = Records.Find(ObjectPath);
+        if (Existing && !bDirty && (*Existing)->SavedHash == SavedHash)
+        {
+            Snapshot.Add(*Existing);
+            ++Result.FromCache;
+        }
+        else if (Loaded)
+        {
+            // Unsaved edits are summarised per query and never cached: the hash cannot vouch for them
+            TSharedPtr<const FBlueprintRecord> Record = BuildRecord(Loaded, bDirty ? FIoHash() : SavedHash);
+            if (!bDirty)
+            {
+                Records.Add(ObjectPath, Record);
+                bCacheDirty = true;
+            }
+            Snapshot.Add(MoveTemp(Record));
+            ++Result.IndexedFromMemory;
+        }
+        else
+        {
+            Result.Unindexed.Add(ObjectPath);
+        }
+    }
+    Result.SearchedBlueprints = Snapshot.Num();
+
+    // Worker part: every summary is immutable, so each Blueprint is scanned independently
+    const FName GraphName = Query.Graph.IsEmpty() ? NAME_None : FName(*Query.Graph);
+    TArray<TArray<int32>> PerBlueprint;
+    PerBlueprint.SetNum(Snapshot.Num());
+    ParallelFor(Snapshot.Num(), [&Snapshot, &PerBlueprint, &Query, GraphName](int32 Index)
+    {
+        const TArray<FNodeRecord>& Nodes = Snapshot[Index]->Nodes;
+        for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+        {
+            if ((GraphName.IsNone() || Nodes[NodeIndex].Graph == GraphName) && MatchesRecord(Nodes[NodeIndex], Query))
+            {
+                PerBlueprint[Index].Add(NodeIndex);
+            }
+        }
+    });
+
+    for (int32 Index = 0; Index < Snapshot.Num(); ++Index)
+    {
+        for (int32 NodeIndex : PerBlueprint[Index])
+        {
+            if (Result.Matches.Num() < Query.MaxResults)
+            {
+                Result.Matches.Add({ Snapshot[Index], NodeIndex });
+            }
+        }
+        Result.TotalMatches += PerBlueprint[Index].Num();
+    }
+
+    Result.SearchMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    return Result;
+}
+
+void FUnrealCompanionNodeIndex::Shutdown()
+{
+    if (bLoaded)
+    {
+        SaveCache();
+    }
+    Records.Empty();
+    IndexQueue.Empty();
+    IndexQueueNext = 0;
+    IndexJobId.Reset();
+    bLoaded = false;
+}
@@ -0,0 +1,302 @@
+#include "Commands/UnrealCompanionPackageSaver.h"
+#include "Commands/UnrealCompanionJobManager.h"
+#include "UnrealCompanionSettings.h"
+#include "Dom/JsonValue.h"
+#include "FileHelpers.h"
+#include "EditorLoadingAndSavingUtils.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "HAL/PlatformTime.h"
+
+FUnrealCompanionPackageSaver& FUnrealCompanionPackageSaver::Get()
+{
+    static FUnrealCompanionPackageSaver Instance;
+    return Instance;
+}
+
+void FUnrealCompanionPackageSaver::GatherDirtyPackages(bool bIncludeMaps, bool bIncludeContent, TArray<UPackage*>& OutPackages)
+{
+    TArray<UPackage*> Dirty;
+    if (bIncludeMaps)
+    {
+        FEditorFileUtils::GetDirtyWorldPackages(Dirty);
+    }
+    if (bIncludeContent)
+    {
+        FEditorFileUtils::GetDirtyContentPackages(Dirty);
+    }
+
+    for (UPackage* Package : Dirty)
+    {
+        if (!Package || Package->HasAnyFlags(RF_Transient) || Package->HasAnyPackageFlags(PKG_CompiledIn))
+        {
+            continue;
+        }
+        const FString PackageName = Package->GetName();
+        if (PackageName.StartsWith(TEXT("/Temp/")) || !FPackageName::IsValidLongPackageName(PackageName))
+        {
+            continue;
+        }
+        OutPackages.AddUnique(Package);
+    }
+}
+
+void FUnrealCompanionPackageSaver::Reset(const TArray<UPackage*>& Packages)
+{
+    Queue.Reset(Packages.Num());
+    for (UPackage* Package : Packages)
+    {
+        Queue.Add(Package);
+    }
+    NextIndex = 0;
+    SavedPackages.Reset();
+    FailedPackages.Reset();
+    MapsSaved = 0;
+    StartTime = FPlatformTime::Seconds();
+    JobId.Reset();
+    bCancelRequested = false;
+}
+
+bool FUnrealCompanionPackageSaver::SaveNextPackage()
+{
+    if (NextIndex >= Queue.Num() || bCancelRequested)
+    {
+        return false;
+    }
+
+    UPackage* Package = Queue[NextIndex++].Get();
+    if (!Package || !Package->IsDirty())
+    {
+        // Collected, or already saved by someone else since the batch started
+        return true;
+    }
+
+    const FString PackageName = Package->GetName();
+    bool bSaved = false;
+    if (Package->ContainsMap())
+    {
+        // Maps need the editor's world save (external actors, map build data...)
+        bSaved = UEditorLoadingAndSavingUtils::SavePackages({ Package }, true);
+        MapsSaved += bSaved ? 1 : 0;
+    }
+    else
+    {
+        FString PackageFilename;
+        if (FPackageName::TryConvertLongPackageNameToFilename(PackageName, PackageFilename, FPackageName::GetAssetPackageExtension()))
+        {
+            // SAVE_Async: serialize here, let the file write finish in the background
+            FSavePackageArgs SaveArgs;
+            SaveArgs.TopLevelFlags = RF_Standalone;
+            SaveArgs.SaveFlags = SAVE_NoError | SAVE_Async;
+            SaveArgs.Error = GWarn;
+            bSaved = UPackage::SavePackage(Package, nullptr, *PackageFilename, SaveArgs);
+        }
+    }
+
+    if (bSaved)
+    {
+        SavedPackages.Add(PackageName);
+    }
+    else
+    {
+        FailedPackages.Add(PackageName);
+        UE_LOG(LogTemp, Warning, TEXT("UnrealCompanion: Failed to save %s"), *PackageName);
+    }
+    return true;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionPackageSaver::BuildResult()
+{
+    // Everything after this point is on disk
+    UPackage::WaitForAsyncFileWrites();
+
+    TArray<TSharedPtr<FJsonValue>> FailedArray;
+    for (const FString& PackageName : FailedPackages)
+    {
+        FailedArray.Add(MakeShared<FJsonValueString>(PackageName));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetBoolField(TEXT("success"), FailedPackages.Num() == 0);
+    ResultObj->SetNumberField(TEXT("saved"), SavedPackages.Num());
+    ResultObj->SetNumberField(TEXT("maps_saved"), MapsSaved);
+    ResultObj->SetNumberField(TEXT("failed"), FailedPackages.Num());
+    ResultObj->SetNumberField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    if (NextIndex < Queue.Num())
+    {
+        // Cancelled: these stay dirty
+        ResultObj->SetNumberField(TEXT("skipped"), Queue.Num() - NextIndex);
+    }
+    if (FailedArray.Num() > 0)
+    {
+        ResultObj->SetArrayField(TEXT("failed_packages"), FailedArray);
+        ResultObj->SetStringField(TEXT("error"), FString::Printf(TEXT("%d of %d packages failed to save"), FailedPackages.Num(), Queue.Num()));
+    }
+    else
+    {
+        ResultObj->SetStringField(TEXT("message"), FString::Printf(TEXT("Saved %d packages"), SavedPackages.Num()));
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("UnrealCompanion: Saved %d packages (%d failed) in %.1fms"),
+        SavedPackages.Num(), FailedPackages.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+    Queue.Reset();
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionPackageSaver::SaveNow(const TArray<UPackage*>& Packages)
+{
+    check(IsInGameThread());
+    check(!bSaving);
+
+    Reset(Packages);
+    while (SaveNextPackage())
+    {
+    }
+    return BuildResult();
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionPackageSaver::Save(const TArray<UPackage*>& Packages, bool bAllowTimeSlicing)
+{
+    check(IsInGameThread());
+    if (bSaving)
+    {
+        return BuildBusyResponse();
+    }
+
+    if (!bAllowTimeSlicing || Packages.Num() <= TimeSliceThreshold || !FUnrealCompanionDeferredResponse::CanDefer())
+    {
+        return SaveNow(Packages);
+    }
+
+    Reset(Packages);
+    Completion = FUnrealCompanionDeferredResponse::Defer();
+    StartTicking();
+
+    UE_LOG(LogTemp, Display, TEXT("UnrealCompanion: Saving %d packages (time-sliced)"), Packages.Num());
+    return nullptr;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionPackageSaver::StartJob(const TArray<UPackage*>& Packages, bool bStreamProgress)
+{
+    check(IsInGameThread());
+    if (bSaving)
+    {
+        return BuildBusyResponse();
+    }
+
+    Reset(Packages);
+
+    FUnrealCompanionJobManager::FHooks Hooks;
+    Hooks.Cancel = [this](const FString&) { bCancelRequested = true; };
+    JobId = FUnrealCompanionJobManager::Get().Start(TEXT("core_save"), MoveTemp(Hooks), bStreamProgress);
+
+    const FString StartedJobId = JobId;
+    Completion = [StartedJobId](const TSharedPtr<FJsonObject>& Result)
+    {
+        FUnrealCompanionJobManager::Get().Finish(StartedJobId, Result);
+    };
+    StartTicking();
+
+    UE_LOG(LogTemp, Display, TEXT("UnrealCompanion: Saving %d packages as %s"), Packages.Num(), *JobId);
+    TSharedPtr<FJsonObject> Started = FUnrealCompanionJobManager::Get().BuildStartedResponse(JobId);
+    Started->SetNumberField(TEXT("total"), Queue.Num());
+    return Started;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionPackageSaver::BuildBusyResponse() const
+{
+    TSharedPtr<FJsonObject> Busy = MakeShared<FJsonObject>();
+    Busy->SetBoolField(TEXT("success"), false);
+    Busy->SetStringField(TEXT("error_code"), TEXT("SAVE_IN_PROGRESS"));
+    Busy->SetStringField(TEXT("error"), FString::Printf(TEXT("A save of %d packages is already running"), Queue.Num()));
+    Busy->SetStringField(TEXT("suggestion"), TEXT("Poll core_save scope='status' until it finishes"));
+    if (!JobId.IsEmpty())
+    {
+        Busy->SetStringField(TEXT("job_id"), JobId);
+    }
+    return Busy;
+}
+
+void FUnrealCompanionPackageSaver::StartTicking()
+{
+    bSaving = true;
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateRaw(this, &FUnrealCompanionPackageSaver::Tick));
+}
+
+bool FUnrealCompanionPackageSaver::Tick(float DeltaTime)
+{
+    // Same budget the command scheduler uses; at least one package per frame
+    const double BudgetSeconds = GetDefault<UUnrealCompanionSettings>()->GameThreadBudgetMs / 1000.0;
+    const double TickStart = FPlatformTime::Seconds();
+    bool bMore = true;
+    do
+    {
+        bMore = SaveNextPackage();
+    }
+    while (bMore && FPlatformTime::Seconds() - TickStart < BudgetSeconds);
+
+    if (bMore)
+    {
+        if (!JobId.IsEmpty())
+        {
+            FUnrealCompanionJobManager::Get().SetProgress(JobId, Queue.Num() > 0 ? (double)NextIndex / Queue.Num() : 1.0, TEXT("saving"));
+        }
+        return true;
+    }
+
+    bSaving = false;
+    TickerHandle.Reset();
+    TSharedPtr<FJsonObject> Result = BuildResult();
+    if (Completion)
+    {
+        FUnrealCompanionDeferredResponse::FCompletion Done = MoveTemp(Completion);
+        Done(Result);
+    }
+    return false;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionPackageSaver::GetStatus() const
+{
+    TSharedPtr<FJsonObject> Status = MakeShared<FJsonObject>();
+    Status->SetBoolField(TEXT("success"), true);
+    Status->SetBoolField(TEXT("active"), bSaving);
+    if (bSaving)
+    {
+        Status->SetNumberField(TEXT("total"), Queue.Num());
+        Status->SetNumberField(TEXT("processed"), NextIndex);
+        Status->SetNumberField(TEXT("saved"), SavedPackages.Num());
+        Status->SetNumberField(TEXT("failed"), FailedPackages.Num());
+        Status->SetNumberField(TEXT("progress"), Queue.Num() > 0 ? (double)NextIndex / Queue.Num() : 1.0);
+        Status->SetNumberField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+        if (!JobId.IsEmpty())
+        {
+            Status->SetStringField(TEXT("job_id"), JobId);
+        }
+    }
+    return Status;
+}
+
+void FUnrealCompanionPackageSaver::Shutdown()
+{
+    if (!bSaving)
+    {
+        return;
+    }
+
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    TickerHandle.Reset();
+    while (SaveNextPackage())
+    {
+    }
+    bSaving = false;
+
+    TSharedPtr<FJsonObject> Result = BuildResult();
+    if (Completion)
+    {
+        FUnrealCompanionDeferredResponse::FCompletion Done = MoveTemp(Completion);
+        Done(Result);
+    }
+}
@@ -0,0 +1,220 @@
+#include "Commands/UnrealCompanionParams.h"
+#include "Dom/JsonValue.h"
+
+thread_local FUnrealCompanionParams::FScope* FUnrealCompanionParams::CurrentScope = nullptr;
+
+// =========================================================================
+// VALUE READERS
+// =========================================================================
+
+namespace UnrealCompanionParams
+{
+    namespace
+    {
+        /** Three numbers from an [a, b, c] array */
+        bool ReadTriple(const FJsonValue& Value, double& OutA, double& OutB, double& OutC)
+        {
+            const TArray<TSharedPtr<FJsonValue>>* Array = nullptr;
+            if (!Value.TryGetArray(Array) || !Array || Array->Num() < 3)
+            {
+                return false;
+            }
+            return (*Array)[0].IsValid() && (*Array)[0]->TryGetNumber(OutA)
+                && (*Array)[1].IsValid() && (*Array)[1]->TryGetNumber(OutB)
+                && (*Array)[2].IsValid() && (*Array)[2]->TryGetNumber(OutC);
+        }
+    }
+
+    // Scalars accept the same conversions as TryGet*Field (numbers as strings and so on),
+    // so typed handlers keep accepting everything the untyped ones did
+
+    bool ReadValue(const FJsonValue& Value, FString& Out)
+    {
+        return Value.TryGetString(Out);
+    }
+
+    bool ReadValue(const FJsonValue& Value, bool& Out)
+    {
+        return Value.TryGetBool(Out);
+    }
+
+    bool ReadValue(const FJsonValue& Value, int32& Out)
+    {
+        return Value.TryGetNumber(Out);
+    }
+
+    bool ReadValue(const FJsonValue& Value, float& Out)
+    {
+        double Number = 0.0;
+        if (!Value.TryGetNumber(Number))
+        {
+            return false;
+        }
+        Out = (float)Number;
+        return true;
+    }
+
+    bool ReadValue(const FJsonValue& Value, double& Out)
+    {
+        return Value.TryGetNumber(Out);
+    }
+
+    bool ReadValue(const FJsonValue& Value, FVector& Out)
+    {
+        double X, Y, Z;
+        if (!ReadTriple(Value, X, Y, Z))
+        {
+            return false;
+        }
+        Out = FVector(X, Y, Z);
+        return true;
+    }
+
+    bool ReadValue(const FJsonValue& Value, FRotator& Out)
+    {
+        double Pitch, Yaw, Roll;
+        if (!ReadTriple(Value, Pitch, Yaw, Roll))
+        {
+            return false;
+        }
+        Out = FRotator(Pitch, Yaw, Roll);
+        return true;
+    }
+
+    bool ReadValue(const FJsonValue& Value, TArray<FString>& Out)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Array = nullptr;
+        if (!Value.TryGetArray(Array) || !Array)
+        {
+            return false;
+        }
+        Out.Reset(Array->Num());
+        for (const TSharedPtr<FJsonValue>& Element : *Array)
+        {
+            FString& Text = Out.AddDefaulted_GetRef();
+            if (!Element.IsValid() || !Element->TryGetString(Text))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool ReadValue(const FJsonValue& Value, TSharedPtr<FJsonObject>& Out)
+    {
+        const TSharedPtr<FJsonObject>* Object = nullptr;
+        if (!Value.TryGetObject(Object) || !Object)
+        {
+            return false;
+        }
+        Out = *Object;
+        return true;
+    }
+
+    bool ReadValue(const FJsonValue& Value, TArray<TSharedPtr<FJsonValue>>& Out)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Array = nullptr;
+        if (!Value.TryGetArray(Array) || !Array)
+        {
+            return false;
+        }
+        Out = *Array;
+        return true;
+    }
+
+    bool ParseStandard(const TSharedPtr<FJsonObject>& Params,
+        FUnrealCompanionCommonUtils::FMCPStandardParams& Out, FString& OutError)
+    {
+        Out = FUnrealCompanionCommonUtils::GetStandardParams(Params);
+
+        if (!Out.Verbosity.Equals(TEXT("minimal"), ESearchCase::IgnoreCase)
+            && !Out.Verbosity.Equals(TEXT("normal"), ESearchCase::IgnoreCase)
+            && !Out.Verbosity.Equals(TEXT("full"), ESearchCase::IgnoreCase))
+        {
+            OutError = FString::Printf(TEXT("Parameter 'verbosity' must be one of: minimal, normal, full (got '%s')"), *Out.Verbosity);
+            return false;
+        }
+        if (!Out.OnError.Equals(TEXT("rollback"), ESearchCase::IgnoreCase)
+            && !Out.OnError.Equals(TEXT("continue"), ESearchCase::IgnoreCase)
+            && !Out.OnError.Equals(TEXT("stop"), ESearchCase::IgnoreCase))
+        {
+            OutError = FString::Printf(TEXT("Parameter 'on_error' must be one of: rollback, continue, stop (got '%s')"), *Out.OnError);
+            return false;
+        }
+        return true;
+    }
+
+    TArray<TSharedPtr<FJsonValue>> DescribeStandard()
+    {
+        // Only the enums: GetStandardParams falls back to defaults for values of the wrong type
+        auto MakeField = [](const TCHAR* Name, std::initializer_list<const TCHAR*> Values)
+        {
+            TArray<TSharedPtr<FJsonValue>> OneOf;
+            for (const TCHAR* Value : Values)
+            {
+                OneOf.Add(MakeShared<FJsonValueString>(Value));
+            }
+            TSharedPtr<FJsonObject> FieldObj = MakeShared<FJsonObject>();
+            FieldObj->SetStringField(TEXT("name"), Name);
+            FieldObj->SetArrayField(TEXT("one_of"), OneOf);
+            return MakeShared<FJsonValueObject>(FieldObj);
+        };
+        return {
+            MakeField(TEXT("verbosity"), { TEXT("minimal"), TEXT("normal"), TEXT("full") }),
+            MakeField(TEXT("on_error"), { TEXT("rollback"), TEXT("continue"), TEXT("stop") }),
+        };
+    }
+}
+
+// =========================================================================
+// PER-COMMAND SCOPE
+// =========================================================================
+
+FUnrealCompanionParams::FScope::FScope(TSharedPtr<const FMCPTypedParams> InParsed, const void* InSchemaKey)
+    : Parsed(MoveTemp(InParsed))
+    , SchemaKey(InSchemaKey)
+    , Previous(CurrentScope)
+{
+    CurrentScope = this;
+}
+
+FUnrealCompanionParams::FScope::~FScope()
+{
+    CurrentScope = Previous;
+}
+
+TSharedPtr<const FMCPTypedParams> FUnrealCompanionParams::FindCurrent(const TSharedPtr<FJsonObject>& Params, const void* SchemaKey)
+{
+    // Only the innermost scope counts, and only for the very object it was parsed from:
+    // a handler looking at a sub-object or running a nested command parses again
+    if (!CurrentScope || !CurrentScope->Parsed.IsValid() || !Params.IsValid())
+    {
+        return nullptr;
+    }
+    if (CurrentScope->Parsed->Raw != Params)
+    {
+        return nullptr;
+    }
+    if (SchemaKey && CurrentScope->SchemaKey != SchemaKey)
+    {
+        return nullptr;
+    }
+    return CurrentScope->Parsed;
+}
+
+const FUnrealCompanionCommonUtils::FMCPStandardParams* FUnrealCompanionParams::FindStandard(const TSharedPtr<FJsonObject>& Params)
+{
+    const TSharedPtr<const FMCPTypedParams> Current = FindCurrent(Params, nullptr);
+    return Current.IsValid() && Current->bHasStandard ? &Current->Standard : nullptr;
+}
+
+// =========================================================================
+// SHARED SCHEMAS
+// =========================================================================
+
+const TMCPParamSchema<FMCPStandardOnlyParams>& FMCPStandardOnlyParams::Schema()
+{
+    static const TMCPParamSchema<FMCPStandardOnlyParams> Instance = TMCPParamSchema<FMCPStandardOnlyParams>()
+        .WithStandardParams();
+    return Instance;
+}
@@ -12,23 +12,26 @@ FUnrealCompanionProjectCommands::FUnrealCompanionProjectCommands()
 {
 }
 
+TConstArrayView<TMCPCommandEntry<FUnrealCompanionProjectCommands>> FUnrealCompanionProjectCommands::GetCommandTable()
+{
+    static constexpr TMCPCommandEntry<FUnrealCompanionProjectCommands> Table[] = {
+        { TEXT("project_create_input_mapping"), &FUnrealCompanionProjectCommands::HandleCreateInputMapping },
+        { TEXT("project_create_input_action"), &FUnrealCompanionProjectCommands::HandleCreateInputAction },
+        { TEXT("project_add_to_mapping_context"), &FUnrealCompanionProjectCommands::HandleAddToMappingContext },
+    };
+    static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+    return Table;
+}
+
 TSharedPtr<FJsonObject> FUnrealCompanionProjectCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-    // Legacy input system
-    if (CommandType == TEXT("project_create_input_mapping"))
-    {
-        return HandleCreateInputMapping(Params);
-    }
-    // Enhanced Input System
-    else if (CommandType == TEXT("project_create_input_action"))
+    if (TSharedPtr<FJsonObject> Result = UnrealCompanionCommandTable::Dispatch(*this, GetCommandTable(), CommandType, Params))
     {
-        return HandleCreateInputAction(Params);
+        return Result;
     }
-    else if (CommandType == TEXT("project_add_to_mapping_context"))
-    {
-        return HandleAddToMappingContext(Params);
-    }
-    else if (CommandType == TEXT("project_list_input_actions"))
+
+    // Not registered by the bridge (core_query covers them); kept for direct callers
+    if (CommandType == TEXT("project_list_input_actions"))
     {
         return HandleListInputActions(Params);
     }
@@ -36,7 +39,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionProjectCommands::HandleCommand(const FSt
     {
         return HandleListMappingContexts(Params);
     }
-    
+
     return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown project command: %s"), *CommandType));
 }
 
@@ -1,28 +1,274 @@
 #include "Commands/UnrealCompanionPythonCommands.h"
 #include "Commands/UnrealCompanionCommonUtils.h"
 #include "IPythonScriptPlugin.h"
+#include "PythonScriptTypes.h"
+#include "HAL/PlatformTime.h"
+#include "IO/IoHash.h"
+#include "Misc/Base64.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    /**
+     * Installed once as sys.modules["_unrealcompanion"]. Every argument and the
+     * return value are base64 so nothing has to be quoted for Python or parsed
+     * back out of a repr; a source of "-" means "use the cached code for key".
+     */
+    const TCHAR* const PythonRuntimeSource = TEXT(R"PY(
+import base64, collections, contextlib, io, json, sys, traceback, types
+
+_MAX_CODE = 256
+_contexts = {}
+_code = collections.OrderedDict()
+
+def _text(value):
+    return base64.b64decode(value).decode("utf-8") if value else ""
+
+def _context(name):
+    ctx = _contexts.get(name)
+    if ctx is None:
+        import unreal
+        ctx = {"__name__": "__unrealcompanion_" + name, "__builtins__": __builtins__, "unreal": unreal}
+        _contexts[name] = ctx
+    return ctx
+
+def _compiled(key, source, filename):
+    code = _code.get(key)
+    if code is not None:
+        _code.move_to_end(key)
+        return code, True
+    if source is None:
+        return None, False
+    code = compile(source, filename, "exec")
+    _code[key] = code
+    while len(_code) > _MAX_CODE:
+        _code.popitem(last=False)
+    return code, False
+
+def _marshal(value, depth=0):
+    if value is None or isinstance(value, (bool, int, float, str)):
+        return value
+    if depth > 16:
+        return repr(value)
+    if isinstance(value, dict):
+        return {str(k): _marshal(v, depth + 1) for k, v in value.items()}
+    if isinstance(value, (list, tuple, set, frozenset)):
+        return [_marshal(v, depth + 1) for v in value]
+    if hasattr(value, "get_path_name"):
+        return value.get_path_name()
+    if hasattr(value, "to_tuple"):
+        return _marshal(value.to_tuple(), depth + 1)
+    return repr(value)
+
+def _reply(out):
+    return base64.b64encode(json.dumps(out).encode("utf-8")).decode("ascii")
+
+def run(context, key, source, filename, expression, reset):
+    out = {"success": False}
+    buffer = io.StringIO()
+    try:
+        name = _text(context) or "default"
+        if reset:
+            _contexts.pop(name, None)
+        ctx = _context(name)
+        code, cached = _compiled(key, None if source == "-" else _text(source), _text(filename))
+        if code is None:
+            return _reply({"missing_code": True})
+        out["cached"] = cached
+        with contextlib.redirect_stdout(buffer):
+            exec(code, ctx)
+            expression = _text(expression)
+            if expression:
+                out["result"] = _marshal(eval(expression, ctx))
+        out["success"] = True
+    except BaseException:
+        out["error"] = traceback.format_exc(limit=8)
+    out["output"] = buffer.getvalue()
+    out["context"] = _text(context) or "default"
+    return _reply(out)
+
+def contexts():
+    return _reply({"success": True, "contexts": sorted(_contexts), "compiled_scripts": len(_code)})
+
+_module = types.ModuleType("_unrealcompanion")
+_module.run = run
+_module.contexts = contexts
+sys.modules["_unrealcompanion"] = _module
+)PY");
+
+    FString EncodeArg(const FString& Value)
+    {
+        const FTCHARToUTF8 Utf8(*Value);
+        return FBase64::Encode(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    }
+
+    FString HashCode(const FString& Code, const FString& Filename)
+    {
+        const FTCHARToUTF8 Utf8(*(Filename + TEXT("\n") + Code));
+        return LexToString(FIoHash::HashBuffer(Utf8.Get(), Utf8.Length()));
+    }
+
+    /** Evaluate one runtime call and decode its base64 JSON reply */
+    TSharedPtr<FJsonObject> EvaluateRuntime(IPythonScriptPlugin* PythonPlugin, const FString& Statement, FString& OutError)
+    {
+        FPythonCommandEx Command;
+        Command.Command = Statement;
+        Command.ExecutionMode = EPythonCommandExecutionMode::EvaluateStatement;
+        Command.Flags = EPythonCommandFlags::Unattended;
+        if (!PythonPlugin->ExecPythonCommandEx(Command))
+        {
+            OutError = Command.CommandResult;
+            return nullptr;
+        }
+
+        // The result is the repr of a base64 str: strip the quotes
+        FString Encoded = Command.CommandResult.TrimStartAndEnd();
+        Encoded.TrimCharInline(TEXT('\''), nullptr);
+        Encoded.TrimCharInline(TEXT('"'), nullptr);
+
+        TSharedPtr<FJsonObject> Reply;
+        TArray<uint8> Bytes;
+        if (FBase64::Decode(Encoded, Bytes))
+        {
+            const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+            TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(Converted.Length(), Converted.Get()));
+            FJsonSerializer::Deserialize(Reader, Reply);
+        }
+        if (!Reply.IsValid())
+        {
+            OutError = TEXT("Unreadable reply from the Python runtime");
+        }
+        return Reply;
+    }
+}
 
 FUnrealCompanionPythonCommands::FUnrealCompanionPythonCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealCompanionPythonCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+bool FUnrealCompanionPythonCommands::WantsRuntime(const TSharedPtr<FJsonObject>& Params)
+{
+    return Params->HasField(TEXT("context")) || Params->HasField(TEXT("result")) || Params->HasField(TEXT("reset_context"));
+}
+
+bool FUnrealCompanionPythonCommands::EnsureRuntime(FString& OutError)
 {
-    if (CommandType == TEXT("python_execute"))
+    if (bRuntimeReady)
     {
-        return HandleExecute(Params);
+        return true;
     }
-    else if (CommandType == TEXT("python_execute_file"))
+
+    IPythonScriptPlugin* PythonPlugin = IPythonScriptPlugin::Get();
+    if (!PythonPlugin || !PythonPlugin->IsPythonAvailable())
     {
-        return HandleExecuteFile(Params);
+        OutError = TEXT("Python scripting plugin is not available. Enable 'Python Editor Script Plugin' in plugins.");
+        return false;
     }
-    else if (CommandType == TEXT("python_list_modules"))
+
+    FPythonCommandEx Command;
+    Command.Command = PythonRuntimeSource;
+    Command.ExecutionMode = EPythonCommandExecutionMode::ExecuteFile;
+    Command.FileExecutionScope = EPythonFileExecutionScope::Private;
+    Command.Flags = EPythonCommandFlags::Unattended;
+    if (!PythonPlugin->ExecPythonCommandEx(Command))
     {
-        return HandleListModules(Params);
+        OutError = FString::Printf(TEXT("Failed to install the Python runtime: %s"), *Command.CommandResult);
+        return false;
+    }
+
+    bRuntimeReady = true;
+    CompiledHashes.Reset();
+    return true;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionPythonCommands::RunInContext(const FString& Code, const FString& Filename, const TSharedPtr<FJsonObject>& Params)
+{
+    FString Error;
+    if (!EnsureRuntime(Error))
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(Error);
+    }
+
+    FString Context;
+    Params->TryGetStringField(TEXT("context"), Context);
+    FString Expression;
+    Params->TryGetStringField(TEXT("result"), Expression);
+    bool bReset = false;
+    Params->TryGetBoolField(TEXT("reset_context"), bReset);
+
+    const double StartTime = FPlatformTime::Seconds();
+    const FString Key = HashCode(Code, Filename);
+    IPythonScriptPlugin* PythonPlugin = IPythonScriptPlugin::Get();
+
+    auto MakeStatement = [&](bool bSendSource)
+    {
+        return FString::Printf(TEXT("__import__('_unrealcompanion').run('%s', '%s', '%s', '%s', '%s', %s)"),
+            *EncodeArg(Context), *Key, bSendSource ? *EncodeArg(Code) : TEXT("-"),
+            *EncodeArg(Filename), *EncodeArg(Expression), bReset ? TEXT("True") : TEXT("False"));
+    };
+
+    // Code the runtime already compiled goes by hash only
+    bool bSentSource = !CompiledHashes.Contains(Key);
+    TSharedPtr<FJsonObject> Reply = EvaluateRuntime(PythonPlugin, MakeStatement(bSentSource), Error);
+    if (Reply.IsValid() && Reply->HasField(TEXT("missing_code")))
+    {
+        CompiledHashes.Remove(Key);
+        bSentSource = true;
+        Reply = EvaluateRuntime(PythonPlugin, MakeStatement(true), Error);
+    }
+    if (!Reply.IsValid())
+    {
+        // The interpreter may have been reset under us: install again next time
+        bRuntimeReady = false;
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Python runtime call failed: %s"), *Error));
+    }
+
+    bool bRunOk = false;
+    Reply->TryGetBoolField(TEXT("success"), bRunOk);
+    if (bSentSource && Reply->HasField(TEXT("cached")))
+    {
+        // Compiled (even if it then raised): later calls can skip the source
+        CompiledHashes.Add(Key);
+    }
+
+    if (!bRunOk)
+    {
+        FString Traceback;
+        Reply->TryGetStringField(TEXT("error"), Traceback);
+        TSharedPtr<FJsonObject> ErrorObj = FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+            TEXT("PYTHON_ERROR"), FUnrealCompanionCommonUtils::SafeErrorMessage(Traceback, TEXT("Python execution failed")));
+        FString Output;
+        if (Reply->TryGetStringField(TEXT("output"), Output) && !Output.IsEmpty())
+        {
+            ErrorObj->SetStringField(TEXT("output"), Output);
+        }
+        return ErrorObj;
+    }
+
+    Reply->SetNumberField(TEXT("exec_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    return Reply;
+}
+
+TConstArrayView<TMCPCommandEntry<FUnrealCompanionPythonCommands>> FUnrealCompanionPythonCommands::GetCommandTable()
+{
+    static constexpr TMCPCommandEntry<FUnrealCompanionPythonCommands> Table[] = {
+        { TEXT("python_execute"), &FUnrealCompanionPythonCommands::HandleExecute },
+        { TEXT("python_execute_file"), &FUnrealCompanionPythonCommands::HandleExecuteFile },
+        { TEXT("python_list_modules"), &FUnrealCompanionPythonCommands::HandleListModules },
+    };
+    static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+    return Table;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionPythonCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    if (TSharedPtr<FJsonObject> Result = UnrealCompanionCommandTable::Dispatch(*this, GetCommandTable(), CommandType, Params))
+    {
+        return Result;
     }
-    
     return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown python command: %s"), *CommandType));
 }
 
@@ -33,6 +279,11 @@ TSharedPtr<FJsonObject> FUnrealCompanionPythonCommands::HandleExecute(const TSha
     {
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing 'code' parameter"));
     }
+
+    if (WantsRuntime(Params))
+    {
+        return RunInContext(Code, TEXT("<python_execute>"), Params);
+    }
     
     // Check if Python plugin is available
     IPythonScriptPlugin* PythonPlugin = IPythonScriptPlugin::Get();
@@ -80,6 +331,14 @@ TSharedPtr<FJsonObject> FUnrealCompanionPythonCommands::HandleExecuteFile(const
     {
         return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Failed to read file: %s"), *FilePath));
     }
+
+    if (WantsRuntime(Params))
+    {
+        // Keyed by content: an unchanged file is not compiled again
+        TSharedPtr<FJsonObject> ResultObj = RunInContext(FileContent, FilePath, Params);
+        ResultObj->SetStringField(TEXT("file"), FilePath);
+        return ResultObj;
+    }
     
     // Check if Python plugin is available
     IPythonScriptPlugin* PythonPlugin = IPythonScriptPlugin::Get();
@@ -134,6 +393,21 @@ TSharedPtr<FJsonObject> FUnrealCompanionPythonCommands::HandleListModules(const
     
     ResultObj->SetArrayField(TEXT("modules"), ModulesArray);
     ResultObj->SetNumberField(TEXT("count"), ModulesArray.Num());
+
+    // Persistent contexts opened by python_execute(context=...)
+    if (bRuntimeReady)
+    {
+        FString Error;
+        if (TSharedPtr<FJsonObject> Runtime = EvaluateRuntime(PythonPlugin, TEXT("__import__('_unrealcompanion').contexts()"), Error))
+        {
+            const TArray<TSharedPtr<FJsonValue>>* Contexts = nullptr;
+            if (Runtime->TryGetArrayField(TEXT("contexts"), Contexts))
+            {
+                ResultObj->SetArrayField(TEXT("contexts"), *Contexts);
+            }
+            ResultObj->SetNumberField(TEXT("compiled_scripts"), Runtime->GetNumberField(TEXT("compiled_scripts")));
+        }
+    }
     ResultObj->SetStringField(TEXT("note"), TEXT("For full module list, use python_execute with 'import pkgutil; print([m.name for m in pkgutil.iter_modules()])'"));
     
     return ResultObj;
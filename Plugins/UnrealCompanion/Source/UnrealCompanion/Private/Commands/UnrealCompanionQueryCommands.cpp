@@ -2,12 +2,27 @@
 
 #include "Commands/UnrealCompanionQueryCommands.h"
 #include "Commands/UnrealCompanionCommonUtils.h"
+#include "Commands/UnrealCompanionPackageSaver.h"
+#include "Commands/UnrealCompanionEditorFocus.h"
+#include "Commands/UnrealCompanionActorIndex.h"
+#include "Commands/UnrealCompanionCompileSession.h"
+#include "Commands/UnrealCompanionUndoPolicy.h"
+#include "Commands/UnrealCompanionNodeIndex.h"
+#include "Commands/UnrealCompanionBehaviorTreeCache.h"
+#include "Commands/UnrealCompanionQueryPager.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "EditorAssetLibrary.h"
+#include "Misc/PackageName.h"
 #include "Engine/World.h"
 #include "Engine/StaticMesh.h"
+#include "Engine/SkeletalMesh.h"
+#include "Rendering/SkeletalMeshRenderData.h"
+#include "Rendering/SkeletalMeshLODRenderData.h"
 #include "EngineUtils.h"
 #include "GameFramework/Actor.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionActorDescInstance.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
 #include "Kismet/GameplayStatics.h"
 #include "Editor.h"
 #include "K2Node.h"
@@ -47,6 +62,403 @@
 #include "BehaviorTree/BehaviorTreeTypes.h"
 #include "BehaviorTree/BlackboardData.h"
 
+namespace
+{
+    /**
+     * core_get_info "fields" projection, e.g. ["variables.name", "functions"].
+     * No fields selects everything. A bare name selects the whole field; "a.b"
+     * selects only b within a.
+     */
+    struct FFieldSelection
+    {
+        explicit FFieldSelection(const TSharedPtr<FJsonObject>& Params)
+        {
+            const TArray<TSharedPtr<FJsonValue>>* FieldsArray;
+            if (!Params->TryGetArrayField(TEXT("fields"), FieldsArray))
+            {
+                return;
+            }
+
+            bAll = false;
+            for (const TSharedPtr<FJsonValue>& Value : *FieldsArray)
+            {
+                FString Field = Value->AsString().TrimStartAndEnd();
+                FString Top, Sub;
+                if (Field.Split(TEXT("."), &Top, &Sub))
+                {
+                    SubFields.FindOrAdd(Top).Add(Sub);
+                }
+                else if (!Field.IsEmpty())
+                {
+                    Whole.Add(Field);
+                }
+            }
+        }
+
+        /** Select Field as a whole (info_type compatibility) */
+        void Add(const FString& Field)
+        {
+            bAll = false;
+            Whole.Add(Field);
+        }
+
+        bool Wants(const TCHAR* Field) const
+        {
+            return bAll || Whole.Contains(Field) || SubFields.Contains(Field);
+        }
+
+        /** Whether only some sub-fields of Field were asked for */
+        bool IsPartial(const TCHAR* Field) const
+        {
+            return !bAll && !Whole.Contains(Field) && SubFields.Contains(Field);
+        }
+
+        bool WantsSub(const TCHAR* Field, const TCHAR* Sub) const
+        {
+            if (!IsPartial(Field))
+            {
+                return Wants(Field);
+            }
+            return SubFields.FindChecked(Field).Contains(Sub);
+        }
+
+        /** Whether something was selected and all of it is among Fields */
+        bool IsWithin(std::initializer_list<const TCHAR*> Fields) const
+        {
+            if (bAll)
+            {
+                return false;
+            }
+            auto Listed = [&Fields](const FString& Field)
+            {
+                for (const TCHAR* Candidate : Fields)
+                {
+                    if (Field == Candidate) return true;
+                }
+                return false;
+            };
+            for (const FString& Field : Whole)
+            {
+                if (!Listed(Field)) return false;
+            }
+            for (const TPair<FString, TSet<FString>>& Pair : SubFields)
+            {
+                if (!Listed(Pair.Key)) return false;
+            }
+            return Whole.Num() + SubFields.Num() > 0;
+        }
+
+        bool bAll = true;
+        TSet<FString> Whole;
+        TMap<FString, TSet<FString>> SubFields;
+    };
+
+    FString ToObjectPath(const FString& Path)
+    {
+        // Accept both package paths (/Game/Dir/Asset) and object paths (/Game/Dir/Asset.Asset)
+        if (Path.Contains(TEXT(".")))
+        {
+            return Path;
+        }
+        return FString::Printf(TEXT("%s.%s"), *Path, *FPackageName::GetShortName(Path));
+    }
+
+    /** "/Script/CoreUObject.Class'/Script/Engine.Actor'" -> "Actor", matching UClass::GetName */
+    FString ObjectNameFromTag(const FString& TagValue)
+    {
+        FString ObjectPath = FPackageName::ExportTextPathToObjectPath(TagValue);
+        int32 DotIndex;
+        if (ObjectPath.FindLastChar(TEXT('.'), DotIndex))
+        {
+            ObjectPath.RightChopInline(DotIndex + 1);
+        }
+        return ObjectPath;
+    }
+
+    /**
+     * Registry data for an asset that isn't in memory, or an invalid FAssetData if
+     * it is (a loaded asset may have unsaved edits the tags don't show yet).
+     */
+    FAssetData FindUnloadedAssetData(const FString& Path)
+    {
+        const FSoftObjectPath ObjectPath(ToObjectPath(Path));
+        if (ObjectPath.ResolveObject())
+        {
+            return FAssetData();
+        }
+        return IAssetRegistry::GetChecked().GetAssetByObjectPath(ObjectPath);
+    }
+
+    TArray<TSharedPtr<FJsonValue>> InterfacesFromTag(const FAssetData& AssetData)
+    {
+        TArray<TSharedPtr<FJsonValue>> IntArray;
+        FString TagValue;
+        if (!AssetData.GetTagValue(FBlueprintTags::ImplementedInterfaces, TagValue))
+        {
+            return IntArray;
+        }
+
+        TArray<FString> Entries;
+        TagValue.ParseIntoArray(Entries, TEXT(","));
+        for (FString& Entry : Entries)
+        {
+            Entry.ReplaceInline(TEXT("(Interface="), TEXT(""));
+            Entry.ReplaceInline(TEXT(")"), TEXT(""));
+            Entry.TrimQuotesInline();
+            Entry.TrimStartAndEndInline();
+            if (!Entry.IsEmpty())
+            {
+                IntArray.Add(MakeShareable(new FJsonValueString(ObjectNameFromTag(Entry))));
+            }
+        }
+        return IntArray;
+    }
+
+    FString NativeParentName(UClass* ParentClass)
+    {
+        UClass* Class = ParentClass;
+        while (Class && !Class->HasAnyClassFlags(CLASS_Native))
+        {
+            Class = Class->GetSuperClass();
+        }
+        return Class ? Class->GetName() : TEXT("None");
+    }
+
+    /** Name and type by default; "variables.<key>" picks any of the keys below */
+    TSharedPtr<FJsonObject> VariableToJson(const FBPVariableDescription& Var, const FFieldSelection& Fields)
+    {
+        const bool bPartial = Fields.IsPartial(TEXT("variables"));
+        auto Wants = [&Fields, bPartial](const TCHAR* Key, bool bByDefault)
+        {
+            return bPartial ? Fields.WantsSub(TEXT("variables"), Key) : bByDefault;
+        };
+
+        TSharedPtr<FJsonObject> VarObj = MakeShareable(new FJsonObject());
+        if (Wants(TEXT("name"), true))
+        {
+            VarObj->SetStringField(TEXT("name"), Var.VarName.ToString());
+        }
+        if (Wants(TEXT("type"), true))
+        {
+            VarObj->SetStringField(TEXT("type"), Var.VarType.PinCategory.ToString());
+        }
+        if (Wants(TEXT("sub_type"), false))
+        {
+            const UObject* SubObject = Var.VarType.PinSubCategoryObject.Get();
+            VarObj->SetStringField(TEXT("sub_type"), SubObject ? SubObject->GetName() : Var.VarType.PinSubCategory.ToString());
+        }
+        if (Wants(TEXT("container"), false))
+        {
+            const TCHAR* Container = Var.VarType.IsArray() ? TEXT("array") : Var.VarType.IsSet() ? TEXT("set") : Var.VarType.IsMap() ? TEXT("map") : TEXT("none");
+            VarObj->SetStringField(TEXT("container"), Container);
+        }
+        if (Wants(TEXT("category"), false))
+        {
+            VarObj->SetStringField(TEXT("category"), Var.Category.ToString());
+        }
+        if (Wants(TEXT("default_value"), false))
+        {
+            VarObj->SetStringField(TEXT("default_value"), Var.DefaultValue);
+        }
+        if (Wants(TEXT("replicated"), false))
+        {
+            VarObj->SetBoolField(TEXT("replicated"), (Var.PropertyFlags & CPF_Net) != 0);
+        }
+        return VarObj;
+    }
+
+    /** Actor filters of core_query, shared by loaded actors and World Partition descriptors */
+    struct FActorQueryFilter
+    {
+        explicit FActorQueryFilter(const TSharedPtr<FJsonObject>& Params)
+        {
+            Params->TryGetStringField(TEXT("pattern"), Pattern);
+            Params->TryGetStringField(TEXT("tag"), Tag);
+            Params->TryGetStringField(TEXT("class_filter"), ClassFilter);
+            bPatternIsWildcard = Pattern.Contains(TEXT("*")) || Pattern.Contains(TEXT("?"));
+
+            const TArray<TSharedPtr<FJsonValue>>* CenterJson = nullptr;
+            const bool bHasCenter = Params->TryGetArrayField(TEXT("center"), CenterJson) && CenterJson->Num() >= 3;
+            if (bHasCenter)
+            {
+                Center = FVector((*CenterJson)[0]->AsNumber(), (*CenterJson)[1]->AsNumber(), (*CenterJson)[2]->AsNumber());
+            }
+            Params->TryGetNumberField(TEXT("radius"), Radius);
+            bRadiusSearch = bHasCenter && Radius > 0;
+
+            const TArray<TSharedPtr<FJsonValue>>* BoxMinJson = nullptr;
+            const TArray<TSharedPtr<FJsonValue>>* BoxMaxJson = nullptr;
+            if (Params->TryGetArrayField(TEXT("box_min"), BoxMinJson) && BoxMinJson->Num() >= 3 &&
+                Params->TryGetArrayField(TEXT("box_max"), BoxMaxJson) && BoxMaxJson->Num() >= 3)
+            {
+                Box = FBox(
+                    FVector((*BoxMinJson)[0]->AsNumber(), (*BoxMinJson)[1]->AsNumber(), (*BoxMinJson)[2]->AsNumber()),
+                    FVector((*BoxMaxJson)[0]->AsNumber(), (*BoxMaxJson)[1]->AsNumber(), (*BoxMaxJson)[2]->AsNumber()));
+            }
+        }
+
+        bool IsEmpty() const
+        {
+            return Pattern.IsEmpty() && Tag.IsEmpty() && ClassFilter.IsEmpty() && !bRadiusSearch && !Box.IsValid;
+        }
+
+        bool MatchesLocation(const FVector& Location) const
+        {
+            if (bRadiusSearch && FVector::Dist(Location, Center) > Radius)
+            {
+                return false;
+            }
+            return !Box.IsValid || Box.IsInsideOrOn(Location);
+        }
+
+        FString Pattern;
+        FString Tag;
+        FString ClassFilter;
+        bool bPatternIsWildcard = false;
+        bool bRadiusSearch = false;
+        FVector Center = FVector::ZeroVector;
+        double Radius = 0.0;
+        FBox Box = FBox(ForceInit);
+    };
+
+    /** Class of a described actor as a loaded one would report it (Blueprint class if any) */
+    FString GetDescClassName(const FWorldPartitionActorDescInstance* Desc)
+    {
+        const FTopLevelAssetPath BaseClass = Desc->GetBaseClass();
+        if (BaseClass.IsValid())
+        {
+            return BaseClass.GetAssetName().ToString();
+        }
+        const UClass* NativeClass = Desc->GetActorNativeClass();
+        return NativeClass ? NativeClass->GetName() : FString();
+    }
+
+    FString GetDescLabel(const FWorldPartitionActorDescInstance* Desc)
+    {
+        const FName Label = Desc->GetActorLabel();
+        return (Label.IsNone() ? Desc->GetActorName() : Label).ToString();
+    }
+
+    /** Descriptors have no transform; their editor bounds stand in for the location */
+    FVector GetDescLocation(const FWorldPartitionActorDescInstance* Desc)
+    {
+        const FBox Bounds = Desc->GetEditorBounds();
+        return Bounds.IsValid ? Bounds.GetCenter() : FVector::ZeroVector;
+    }
+
+    TArray<TSharedPtr<FJsonValue>> VectorToJson(const FVector& Vector)
+    {
+        return {
+            MakeShared<FJsonValueNumber>(Vector.X),
+            MakeShared<FJsonValueNumber>(Vector.Y),
+            MakeShared<FJsonValueNumber>(Vector.Z)
+        };
+    }
+
+    bool GetIntTag(const FAssetData& AssetData, const TCHAR* Tag, int32& OutValue)
+    {
+        FString Value;
+        if (!AssetData.GetTagValue(FName(Tag), Value) || !Value.IsNumeric())
+        {
+            return false;
+        }
+        OutValue = FCString::Atoi(*Value);
+        return true;
+    }
+
+    /**
+     * Mesh stats (and the approximate size) from the tags meshes save into the registry,
+     * without loading the mesh or its materials. False if a tag the request needs is
+     * missing: mesh types that don't write it, or assets saved before it existed.
+     */
+    bool MeshInfoFromTags(const FAssetData& AssetData, bool bIncludeBounds, const TSharedPtr<FJsonObject>& ResultObj)
+    {
+        int32 Vertices = 0;
+        int32 Triangles = 0;
+        if (!GetIntTag(AssetData, TEXT("Vertices"), Vertices) || !GetIntTag(AssetData, TEXT("Triangles"), Triangles))
+        {
+            return false;
+        }
+
+        // Bounding box size rounded to whole units, e.g. "120x80x200"
+        FVector ApproxSize = FVector::ZeroVector;
+        if (bIncludeBounds)
+        {
+            FString SizeTag;
+            TArray<FString> Parts;
+            if (!AssetData.GetTagValue(FName(TEXT("ApproxSize")), SizeTag) || SizeTag.ParseIntoArray(Parts, TEXT("x")) != 3)
+            {
+                return false;
+            }
+            ApproxSize = FVector(FCString::Atod(*Parts[0]), FCString::Atod(*Parts[1]), FCString::Atod(*Parts[2]));
+        }
+
+        TSharedPtr<FJsonObject> MeshObj = MakeShared<FJsonObject>();
+        MeshObj->SetNumberField(TEXT("vertices"), Vertices);
+        MeshObj->SetNumberField(TEXT("triangles"), Triangles);
+        int32 Value = 0;
+        if (GetIntTag(AssetData, TEXT("LODs"), Value))
+        {
+            MeshObj->SetNumberField(TEXT("lods"), Value);
+        }
+        if (GetIntTag(AssetData, TEXT("Materials"), Value))
+        {
+            MeshObj->SetNumberField(TEXT("materials"), Value);
+        }
+        ResultObj->SetObjectField(TEXT("mesh"), MeshObj);
+
+        if (bIncludeBounds)
+        {
+            TSharedPtr<FJsonObject> BoundsObj = MakeShared<FJsonObject>();
+            BoundsObj->SetArrayField(TEXT("size"), VectorToJson(ApproxSize));
+            BoundsObj->SetBoolField(TEXT("approximate"), true);
+            ResultObj->SetObjectField(TEXT("bounds"), BoundsObj);
+        }
+        return true;
+    }
+
+    /** The same fields from a loaded mesh: LOD 0 counts and the exact bounding box */
+    void MeshInfoFromAsset(UObject* Asset, bool bIncludeBounds, const TSharedPtr<FJsonObject>& ResultObj)
+    {
+        TSharedPtr<FJsonObject> MeshObj = MakeShared<FJsonObject>();
+        FBox Bounds(ForceInit);
+        if (UStaticMesh* StaticMesh = Cast<UStaticMesh>(Asset))
+        {
+            MeshObj->SetNumberField(TEXT("vertices"), StaticMesh->GetNumVertices(0));
+            MeshObj->SetNumberField(TEXT("triangles"), StaticMesh->GetNumTriangles(0));
+            MeshObj->SetNumberField(TEXT("lods"), StaticMesh->GetNumLODs());
+            MeshObj->SetNumberField(TEXT("materials"), StaticMesh->GetStaticMaterials().Num());
+            Bounds = StaticMesh->GetBoundingBox();
+        }
+        else if (USkeletalMesh* SkeletalMesh = Cast<USkeletalMesh>(Asset))
+        {
+            const FSkeletalMeshRenderData* RenderData = SkeletalMesh->GetResourceForRendering();
+            if (RenderData && RenderData->LODRenderData.Num() > 0)
+            {
+                MeshObj->SetNumberField(TEXT("vertices"), RenderData->LODRenderData[0].GetNumVertices());
+                MeshObj->SetNumberField(TEXT("triangles"), RenderData->LODRenderData[0].GetTotalFaces());
+            }
+            MeshObj->SetNumberField(TEXT("lods"), SkeletalMesh->GetLODNum());
+            MeshObj->SetNumberField(TEXT("materials"), SkeletalMesh->GetMaterials().Num());
+            Bounds = SkeletalMesh->GetBounds().GetBox();
+        }
+        else
+        {
+            return;
+        }
+        ResultObj->SetObjectField(TEXT("mesh"), MeshObj);
+
+        if (bIncludeBounds)
+        {
+            TSharedPtr<FJsonObject> BoundsObj = MakeShared<FJsonObject>();
+            BoundsObj->SetArrayField(TEXT("min"), VectorToJson(Bounds.Min));
+            BoundsObj->SetArrayField(TEXT("max"), VectorToJson(Bounds.Max));
+            BoundsObj->SetArrayField(TEXT("size"), VectorToJson(Bounds.GetSize()));
+            ResultObj->SetObjectField(TEXT("bounds"), BoundsObj);
+        }
+    }
+}
+
 TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
     if (CommandType == TEXT("core_query"))
@@ -57,10 +469,24 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::HandleCommand(const FStri
     {
         return HandleGetInfo(Params);
     }
+    else if (CommandType == TEXT("asset_get_info") || CommandType == TEXT("asset_get_bounds"))
+    {
+        // Older names for core_get_info(type="asset"[, include_bounds=true])
+        TSharedPtr<FJsonObject> AssetParams = MakeShared<FJsonObject>(*Params);
+        if (CommandType == TEXT("asset_get_bounds"))
+        {
+            AssetParams->SetBoolField(TEXT("include_bounds"), true);
+        }
+        return GetInfoAsset(AssetParams);
+    }
     else if (CommandType == TEXT("core_save"))
     {
         return HandleSave(Params);
     }
+    else if (CommandType == TEXT("core_session"))
+    {
+        return HandleSession(Params);
+    }
     
     return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Unknown core command: ") + CommandType);
 }
@@ -112,7 +538,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::QueryAsset(const TSharedP
             return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing path for exists check"));
         }
         
-        bool bExists = UEditorAssetLibrary::DoesAssetExist(Path);
+        bool bExists = FUnrealCompanionCommonUtils::DoesAssetExistInRegistry(Path);
         ResultObj->SetBoolField(TEXT("success"), true);
         ResultObj->SetStringField(TEXT("path"), Path);
         ResultObj->SetBoolField(TEXT("exists"), bExists);
@@ -123,93 +549,138 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::QueryAsset(const TSharedP
     FString Path = Params->GetStringField(TEXT("path"));
     FString Pattern = Params->GetStringField(TEXT("pattern"));
     FString ClassFilter = Params->GetStringField(TEXT("class_filter"));
-    int32 MaxResults = Params->HasField(TEXT("max_results")) ? (int32)Params->GetNumberField(TEXT("max_results")) : 100;
     bool bRecursive = !Params->HasField(TEXT("recursive")) || Params->GetBoolField(TEXT("recursive"));
+
+    FUnrealCompanionQueryPager Pager(Params, TEXT("path"), { TEXT("path"), TEXT("name"), TEXT("class") });
+    if (!Pager.IsValid())
+    {
+        return Pager.CreateErrorResponse();
+    }
     
-    if (Path.IsEmpty() && Action == TEXT("list"))
+    if (Path.IsEmpty())
     {
-        Path = TEXT("/Game/");
+        Path = TEXT("/Game");
     }
+    while (Path.Len() > 1 && Path.EndsWith(TEXT("/")))
+    {
+        Path.LeftChopInline(1);
+    }
+
+    // Everything below comes from FAssetData; only "load" touches the packages
+    bool bIncludeTags = false;
+    bool bIncludeSize = false;
+    const TArray<TSharedPtr<FJsonValue>>* IncludeArray;
+    if (Params->TryGetArrayField(TEXT("include"), IncludeArray))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *IncludeArray)
+        {
+            bIncludeTags |= Value->AsString() == TEXT("tags");
+            bIncludeSize |= Value->AsString() == TEXT("size");
+        }
+    }
+    bool bLoad = false;
+    Params->TryGetBoolField(TEXT("load"), bLoad);
+    check(!bLoad || IsInGameThread());
     
-    TArray<TSharedPtr<FJsonValue>> Results;
-    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    // Asset queries may run on a worker thread: only use the thread-safe registry interface
+    IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
     
+    // Path and class are narrowed by the registry itself; only the name pattern needs a pass
+    FARFilter Filter;
+    Filter.PackagePaths.Add(FName(*Path));
+    Filter.bRecursivePaths = bRecursive;
+    if (!ClassFilter.IsEmpty())
+    {
+        const FTopLevelAssetPath ClassPath = FUnrealCompanionCommonUtils::ResolveAssetClassPath(ClassFilter);
+        Filter.ClassPaths.Add(ClassPath);
+        Filter.bRecursiveClasses = true;
+        ResultObj->SetStringField(TEXT("class_path"), ClassPath.ToString());
+    }
+
+    // Copied out first: ToJson may load packages, which must not happen inside a registry callback
     TArray<FAssetData> AssetDataList;
-    
-    if (Action == TEXT("find") && !Pattern.IsEmpty())
+    AssetRegistry.GetAssets(Filter, AssetDataList);
+
+    const bool bMatchPattern = Action == TEXT("find") && !Pattern.IsEmpty();
+
+    // The page holds pointers into AssetDataList, not copies
+    auto ForEachMatch = [&](auto&& Visit)
     {
-        // Search by pattern
-        FARFilter Filter;
-        Filter.bRecursivePaths = true;
-        Filter.PackagePaths.Add(FName(TEXT("/Game")));
-        
-        if (!ClassFilter.IsEmpty())
-        {
-            Filter.ClassPaths.Add(FTopLevelAssetPath(FName(TEXT("/Script/Engine")), FName(*ClassFilter)));
-        }
-        
-        AssetRegistry.GetAssets(Filter, AssetDataList);
-        
-        // Filter by pattern
-        TArray<FAssetData> FilteredList;
         for (const FAssetData& Asset : AssetDataList)
         {
-            FString AssetName = Asset.AssetName.ToString();
-            if (AssetName.MatchesWildcard(Pattern))
+            if (!bMatchPattern || Asset.AssetName.ToString().MatchesWildcard(Pattern))
             {
-                FilteredList.Add(Asset);
+                Visit(&Asset);
             }
         }
-        AssetDataList = FilteredList;
-    }
-    else
+    };
+
+    const FString& Sort = Pager.GetSort();
+    auto MakeKey = [&Sort](const FAssetData* Asset)
     {
-        // List in path
-        FARFilter Filter;
-        Filter.bRecursivePaths = bRecursive;
-        Filter.PackagePaths.Add(FName(*Path));
+        FUnrealCompanionQueryKey Key;
+        Key.Id = Asset->GetObjectPathString();
+        if (Sort == TEXT("name"))
+        {
+            Key.Text = Asset->AssetName.ToString();
+        }
+        else if (Sort == TEXT("class"))
+        {
+            Key.Text = Asset->AssetClassPath.GetAssetName().ToString();
+        }
+        return Key;
+    };
+
+    auto ToJson = [&](const FAssetData* AssetPtr)
+    {
+        const FAssetData& Asset = *AssetPtr;
+        TSharedPtr<FJsonObject> AssetObj = MakeShareable(new FJsonObject());
+        AssetObj->SetStringField(TEXT("name"), Asset.AssetName.ToString());
+        AssetObj->SetStringField(TEXT("path"), Asset.GetObjectPathString());
+        AssetObj->SetStringField(TEXT("class"), Asset.AssetClassPath.GetAssetName().ToString());
+
+        // Blueprint-derived assets carry their parent class as a tag
+        FString TagValue;
+        if (Asset.GetTagValue(FBlueprintTags::ParentClassPath, TagValue))
+        {
+            AssetObj->SetStringField(TEXT("parent_class"), ObjectNameFromTag(TagValue));
+        }
         
-        if (!ClassFilter.IsEmpty())
+        if (bIncludeTags)
         {
-            // Try common class paths
-            if (ClassFilter == TEXT("Blueprint"))
-            {
-                Filter.ClassPaths.Add(FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("Blueprint")));
-            }
-            else if (ClassFilter == TEXT("StaticMesh"))
+            TSharedPtr<FJsonObject> TagsObj = MakeShareable(new FJsonObject());
+            Asset.EnumerateTags([&TagsObj](const TPair<FName, FAssetTagValueRef>& Tag)
             {
-                Filter.ClassPaths.Add(FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("StaticMesh")));
-            }
-            else if (ClassFilter == TEXT("Material"))
+                TagsObj->SetStringField(Tag.Key.ToString(), Tag.Value.AsString());
+            });
+            AssetObj->SetObjectField(TEXT("tags"), TagsObj);
+        }
+
+        if (bIncludeSize)
+        {
+            const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(Asset.PackageName);
+            if (PackageData.IsSet() && PackageData->DiskSize >= 0)
             {
-                Filter.ClassPaths.Add(FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("Material")));
+                AssetObj->SetNumberField(TEXT("disk_size"), static_cast<double>(PackageData->DiskSize));
             }
-            else if (ClassFilter == TEXT("Texture2D"))
+        }
+
+        if (bLoad)
+        {
+            if (UObject* Loaded = Asset.GetAsset())
             {
-                Filter.ClassPaths.Add(FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("Texture2D")));
+                AssetObj->SetNumberField(TEXT("memory_size"), static_cast<double>(Loaded->GetResourceSizeBytes(EResourceSizeMode::Exclusive)));
             }
         }
-        
-        AssetRegistry.GetAssets(Filter, AssetDataList);
-    }
-    
-    // Build results
-    int32 Count = 0;
-    for (const FAssetData& Asset : AssetDataList)
-    {
-        if (Count >= MaxResults) break;
-        
-        TSharedPtr<FJsonObject> AssetObj = MakeShareable(new FJsonObject());
-        AssetObj->SetStringField(TEXT("name"), Asset.AssetName.ToString());
-        AssetObj->SetStringField(TEXT("path"), Asset.GetObjectPathString());
-        AssetObj->SetStringField(TEXT("class"), Asset.AssetClassPath.GetAssetName().ToString());
-        Results.Add(MakeShareable(new FJsonValueObject(AssetObj)));
-        Count++;
-    }
+        AssetObj->SetBoolField(TEXT("loaded"), Asset.IsAssetLoaded());
+        return AssetObj;
+    };
+
+    const int32 Matched = Pager.Page<const FAssetData*>(ForEachMatch, MakeKey, ToJson);
     
     ResultObj->SetBoolField(TEXT("success"), true);
-    ResultObj->SetNumberField(TEXT("count"), Results.Num());
-    ResultObj->SetArrayField(TEXT("results"), Results);
+    ResultObj->SetNumberField(TEXT("total_found"), Matched);
+    Pager.Finish(ResultObj);
     
     return ResultObj;
 }
@@ -225,81 +696,139 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::QueryActor(const TSharedP
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("No world available"));
     }
     
+    // Descriptors cover the actors of unloaded World Partition cells too
+    const TArray<TSharedPtr<FJsonValue>>* IncludeArray = nullptr;
+    bool bUnloaded = Action == TEXT("load") || Action == TEXT("unload");
+    if (Params->TryGetArrayField(TEXT("include"), IncludeArray))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *IncludeArray)
+        {
+            bUnloaded |= Value->AsString() == TEXT("unloaded");
+        }
+    }
+    if (bUnloaded)
+    {
+        return QueryActorDescriptors(Params, World, Action);
+    }
+    
     TSharedPtr<FJsonObject> ResultObj = MakeShareable(new FJsonObject());
     ResultObj->SetStringField(TEXT("type"), TEXT("actor"));
     ResultObj->SetStringField(TEXT("action"), Action);
     
-    TArray<TSharedPtr<FJsonValue>> Results;
+    const FActorQueryFilter Filter(Params);
+    const FString& Pattern = Filter.Pattern;
+    const FString& Tag = Filter.Tag;
+    const FString& ClassFilter = Filter.ClassFilter;
+    const bool bRadiusSearch = Filter.bRadiusSearch;
+    const FVector& Center = Filter.Center;
+    const double Radius = Filter.Radius;
+    const FBox& Box = Filter.Box;
     
-    FString Pattern = Params->GetStringField(TEXT("pattern"));
-    FString Tag = Params->GetStringField(TEXT("tag"));
-    FString ClassFilter = Params->GetStringField(TEXT("class_filter"));
-    int32 MaxResults = Params->HasField(TEXT("max_results")) ? (int32)Params->GetNumberField(TEXT("max_results")) : 100;
+    // Radius searches come nearest first; "distance" elsewhere measures from center (or the origin)
+    FUnrealCompanionQueryPager Pager(Params, bRadiusSearch ? TEXT("distance") : TEXT("name"),
+        { TEXT("name"), TEXT("class"), TEXT("distance") });
+    if (!Pager.IsValid())
+    {
+        return Pager.CreateErrorResponse();
+    }
     
-    // Radius search params
-    TArray<double> CenterArray;
-    bool bHasCenter = false;
-    if (Params->HasField(TEXT("center")))
+    // Narrow the candidate set with the most selective index available;
+    // the remaining filters below are applied to the candidates only
+    FUnrealCompanionActorIndex& ActorIndex = FUnrealCompanionActorIndex::Get();
+    TArray<AActor*> Candidates;
+    if (!Pattern.IsEmpty() && !Filter.bPatternIsWildcard)
     {
-        const TArray<TSharedPtr<FJsonValue>>* CenterArrayJson;
-        if (Params->TryGetArrayField(TEXT("center"), CenterArrayJson) && CenterArrayJson->Num() >= 3)
-        {
-            bHasCenter = true;
-            CenterArray.Add((*CenterArrayJson)[0]->AsNumber());
-            CenterArray.Add((*CenterArrayJson)[1]->AsNumber());
-            CenterArray.Add((*CenterArrayJson)[2]->AsNumber());
-        }
+        ActorIndex.FindAllByName(World, Pattern, Candidates);
+    }
+    else if (!Tag.IsEmpty())
+    {
+        ActorIndex.FindByTag(World, FName(*Tag), Candidates);
+    }
+    else if (bRadiusSearch)
+    {
+        ActorIndex.FindInRadius(World, Center, Radius, Candidates);
+    }
+    else if (Box.IsValid)
+    {
+        ActorIndex.FindInBox(World, Box, Candidates);
+    }
+    else if (!ClassFilter.IsEmpty())
+    {
+        ActorIndex.FindByClassName(World, ClassFilter, Candidates);
+    }
+    else
+    {
+        ActorIndex.GetAllActors(World, Candidates);
     }
-    double Radius = Params->HasField(TEXT("radius")) ? Params->GetNumberField(TEXT("radius")) : 0.0;
     
-    int32 Count = 0;
-    for (TActorIterator<AActor> It(World); It; ++It)
+    auto ForEachMatch = [&](auto&& Visit)
     {
-        if (Count >= MaxResults) break;
-        
-        AActor* Actor = *It;
-        if (!Actor) continue;
-        
-        // Filter by pattern
-        if (!Pattern.IsEmpty())
+        for (AActor* Actor : Candidates)
         {
-            if (!Actor->GetActorLabel().MatchesWildcard(Pattern) && 
-                !Actor->GetName().MatchesWildcard(Pattern))
+            if (!Actor) continue;
+            
+            // Filter by pattern
+            if (!Pattern.IsEmpty())
             {
-                continue;
+                if (!Actor->GetActorLabel().MatchesWildcard(Pattern) && 
+                    !Actor->GetName().MatchesWildcard(Pattern))
+                {
+                    continue;
+                }
             }
-        }
-        
-        // Filter by tag
-        if (!Tag.IsEmpty())
-        {
-            if (!Actor->Tags.Contains(FName(*Tag)))
+            
+            // Filter by tag
+            if (!Tag.IsEmpty())
             {
-                continue;
+                if (!Actor->Tags.Contains(FName(*Tag)))
+                {
+                    continue;
+                }
             }
-        }
-        
-        // Filter by class
-        if (!ClassFilter.IsEmpty())
-        {
-            FString ClassName = Actor->GetClass()->GetName();
-            if (!ClassName.Contains(ClassFilter))
+            
+            // Filter by class
+            if (!ClassFilter.IsEmpty())
             {
-                continue;
+                FString ClassName = Actor->GetClass()->GetName();
+                if (!ClassName.Contains(ClassFilter))
+                {
+                    continue;
+                }
             }
-        }
-        
-        // Filter by radius
-        if (bHasCenter && Radius > 0)
-        {
-            FVector Center(CenterArray[0], CenterArray[1], CenterArray[2]);
-            float Distance = FVector::Dist(Actor->GetActorLocation(), Center);
-            if (Distance > Radius)
+            
+            // Filter by radius and box
+            if (!Filter.MatchesLocation(Actor->GetActorLocation()))
             {
                 continue;
             }
+            
+            Visit(Actor);
         }
-        
+    };
+    
+    const FString& Sort = Pager.GetSort();
+    auto MakeKey = [&Sort, &Center](AActor* Actor)
+    {
+        // Path names are unique across the world's levels, so the order is total
+        FUnrealCompanionQueryKey Key;
+        Key.Id = Actor->GetPathName();
+        if (Sort == TEXT("name"))
+        {
+            Key.Text = Actor->GetActorLabel();
+        }
+        else if (Sort == TEXT("class"))
+        {
+            Key.Text = Actor->GetClass()->GetName();
+        }
+        else if (Sort == TEXT("distance"))
+        {
+            Key.Number = FVector::Dist(Actor->GetActorLocation(), Center);
+        }
+        return Key;
+    };
+    
+    auto ToJson = [&](AActor* Actor)
+    {
         TSharedPtr<FJsonObject> ActorObj = MakeShareable(new FJsonObject());
         ActorObj->SetStringField(TEXT("name"), Actor->GetActorLabel());
         ActorObj->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
@@ -312,23 +841,273 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::QueryActor(const TSharedP
         ActorObj->SetArrayField(TEXT("location"), LocationArray);
         
         // Add distance if radius search
-        if (bHasCenter && Radius > 0)
+        if (bRadiusSearch)
         {
-            FVector Center(CenterArray[0], CenterArray[1], CenterArray[2]);
-            ActorObj->SetNumberField(TEXT("distance"), FVector::Dist(Actor->GetActorLocation(), Center));
+            ActorObj->SetNumberField(TEXT("distance"), FVector::Dist(Location, Center));
         }
-        
-        Results.Add(MakeShareable(new FJsonValueObject(ActorObj)));
-        Count++;
+        return ActorObj;
+    };
+    
+    const int32 Matched = Pager.Page<AActor*>(ForEachMatch, MakeKey, ToJson);
+    
+    ResultObj->SetBoolField(TEXT("success"), true);
+    ResultObj->SetNumberField(TEXT("total_found"), Matched);
+    Pager.Finish(ResultObj);
+    
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::QueryActorDescriptors(const TSharedPtr<FJsonObject>& Params, UWorld* World, const FString& Action)
+{
+    UWorldPartition* WorldPartition = World->GetWorldPartition();
+    if (!WorldPartition)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(TEXT("NOT_WORLD_PARTITION"),
+            FString::Printf(TEXT("%s is not a World Partition map: all of its actors are loaded"), *World->GetName()),
+            TEXT("Query without include=[\"unloaded\"]"));
+    }
+    
+    const FActorQueryFilter Filter(Params);
+    const FName TagName = Filter.Tag.IsEmpty() ? NAME_None : FName(*Filter.Tag);
+    
+    // Descriptors stay in memory for the whole map: this reads no cell and loads no actor
+    auto ForEachMatch = [&](auto&& Visit)
+    {
+        FWorldPartitionHelpers::ForEachActorDescInstance(WorldPartition, AActor::StaticClass(), [&](const FWorldPartitionActorDescInstance* Desc)
+        {
+            if (!Filter.Pattern.IsEmpty()
+                && !GetDescLabel(Desc).MatchesWildcard(Filter.Pattern)
+                && !Desc->GetActorName().ToString().MatchesWildcard(Filter.Pattern))
+            {
+                return true;
+            }
+            if (!TagName.IsNone() && !Desc->GetTags().Contains(TagName))
+            {
+                return true;
+            }
+            if (!Filter.ClassFilter.IsEmpty() && !GetDescClassName(Desc).Contains(Filter.ClassFilter))
+            {
+                return true;
+            }
+            if (!Filter.MatchesLocation(GetDescLocation(Desc)))
+            {
+                return true;
+            }
+            Visit(Desc);
+            return true;
+        });
+    };
+    
+    if (Action == TEXT("load") || Action == TEXT("unload"))
+    {
+        return LoadActorDescriptors(Params, WorldPartition, Action == TEXT("load"), [&](TArray<FGuid>& OutGuids, int32 Limit)
+        {
+            int32 Matched = 0;
+            ForEachMatch([&](const FWorldPartitionActorDescInstance* Desc)
+            {
+                if (Matched++ < Limit)
+                {
+                    OutGuids.Add(Desc->GetGuid());
+                }
+            });
+            return Matched;
+        }, !Filter.IsEmpty());
+    }
+    
+    FUnrealCompanionQueryPager Pager(Params, Filter.bRadiusSearch ? TEXT("distance") : TEXT("name"),
+        { TEXT("name"), TEXT("class"), TEXT("distance") });
+    if (!Pager.IsValid())
+    {
+        return Pager.CreateErrorResponse();
     }
     
+    const FString& Sort = Pager.GetSort();
+    auto MakeKey = [&Sort, &Filter](const FWorldPartitionActorDescInstance* Desc)
+    {
+        FUnrealCompanionQueryKey Key;
+        Key.Id = Desc->GetGuid().ToString();
+        if (Sort == TEXT("name"))
+        {
+            Key.Text = GetDescLabel(Desc);
+        }
+        else if (Sort == TEXT("class"))
+        {
+            Key.Text = GetDescClassName(Desc);
+        }
+        else if (Sort == TEXT("distance"))
+        {
+            Key.Number = FVector::Dist(GetDescLocation(Desc), Filter.Center);
+        }
+        return Key;
+    };
+    
+    int32 LoadedCount = 0;
+    auto ToJson = [&](const FWorldPartitionActorDescInstance* Desc)
+    {
+        TSharedPtr<FJsonObject> ActorObj = MakeShared<FJsonObject>();
+        ActorObj->SetStringField(TEXT("name"), GetDescLabel(Desc));
+        ActorObj->SetStringField(TEXT("class"), GetDescClassName(Desc));
+        ActorObj->SetStringField(TEXT("guid"), Desc->GetGuid().ToString());
+        ActorObj->SetStringField(TEXT("package"), Desc->GetActorPackage().ToString());
+        
+        const bool bLoaded = Desc->IsLoaded();
+        LoadedCount += bLoaded ? 1 : 0;
+        ActorObj->SetBoolField(TEXT("loaded"), bLoaded);
+        
+        const FVector Location = GetDescLocation(Desc);
+        ActorObj->SetArrayField(TEXT("location"), VectorToJson(Location));
+        const FBox Bounds = Desc->GetEditorBounds();
+        if (Bounds.IsValid)
+        {
+            TSharedPtr<FJsonObject> BoundsObj = MakeShared<FJsonObject>();
+            BoundsObj->SetArrayField(TEXT("min"), VectorToJson(Bounds.Min));
+            BoundsObj->SetArrayField(TEXT("max"), VectorToJson(Bounds.Max));
+            ActorObj->SetObjectField(TEXT("bounds"), BoundsObj);
+        }
+        
+        if (Desc->GetTags().Num() > 0)
+        {
+            TArray<TSharedPtr<FJsonValue>> TagArray;
+            for (const FName& DescTag : Desc->GetTags())
+            {
+                TagArray.Add(MakeShared<FJsonValueString>(DescTag.ToString()));
+            }
+            ActorObj->SetArrayField(TEXT("tags"), TagArray);
+        }
+        
+        if (Filter.bRadiusSearch)
+        {
+            ActorObj->SetNumberField(TEXT("distance"), FVector::Dist(Location, Filter.Center));
+        }
+        return ActorObj;
+    };
+    
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetStringField(TEXT("type"), TEXT("actor"));
+    ResultObj->SetStringField(TEXT("action"), Action);
+    ResultObj->SetStringField(TEXT("source"), TEXT("world_partition"));
+    
+    const int32 Matched = Pager.Page<const FWorldPartitionActorDescInstance*>(ForEachMatch, MakeKey, ToJson);
+    
     ResultObj->SetBoolField(TEXT("success"), true);
-    ResultObj->SetNumberField(TEXT("count"), Results.Num());
-    ResultObj->SetArrayField(TEXT("results"), Results);
+    ResultObj->SetNumberField(TEXT("total_found"), Matched);
+    ResultObj->SetNumberField(TEXT("loaded_on_page"), LoadedCount);
+    Pager.Finish(ResultObj);
     
     return ResultObj;
 }
 
+TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::LoadActorDescriptors(const TSharedPtr<FJsonObject>& Params, UWorldPartition* WorldPartition,
+    bool bLoad, TFunctionRef<int32(TArray<FGuid>&, int32)> CollectMatches, bool bHasFilter)
+{
+    TArray<FGuid> Guids;
+    TArray<FString> Invalid;
+    int32 Matched = 0;
+    
+    const TArray<TSharedPtr<FJsonValue>>* GuidArray = nullptr;
+    if (Params->TryGetArrayField(TEXT("guids"), GuidArray))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *GuidArray)
+        {
+            FGuid Guid;
+            if (FGuid::Parse(Value->AsString(), Guid) && WorldPartition->GetActorDescInstance(Guid))
+            {
+                Guids.AddUnique(Guid);
+            }
+            else
+            {
+                Invalid.Add(Value->AsString());
+            }
+        }
+        Matched = Guids.Num();
+    }
+    else if (bHasFilter)
+    {
+        // The same filters as the query that found them, a page at most
+        int32 MaxResults = FUnrealCompanionQueryPager::DefaultPageSize;
+        Params->TryGetNumberField(TEXT("max_results"), MaxResults);
+        Matched = CollectMatches(Guids, FMath::Max(MaxResults, 0));
+    }
+    else
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(TEXT("MISSING_TARGET"),
+            FString::Printf(TEXT("%s needs guids or at least one filter"), bLoad ? TEXT("load") : TEXT("unload")),
+            TEXT("Pass the guid of each actor from core_query(type=\"actor\", include=[\"unloaded\"])"));
+    }
+    
+    // Unloading an actor with unsaved edits would lose them
+    TArray<FGuid> Skipped;
+    if (!bLoad)
+    {
+        for (int32 Index = Guids.Num() - 1; Index >= 0; --Index)
+        {
+            const FWorldPartitionActorDescInstance* Desc = WorldPartition->GetActorDescInstance(Guids[Index]);
+            const AActor* Actor = Desc ? Desc->GetActor() : nullptr;
+            if (Actor && Actor->GetPackage()->IsDirty())
+            {
+                Skipped.Add(Guids[Index]);
+                Guids.RemoveAtSwap(Index);
+            }
+        }
+    }
+    
+    // Pinned actors stay loaded regardless of the loaded regions, as with "Pin" in the World Partition editor
+    if (Guids.Num() > 0)
+    {
+        if (bLoad)
+        {
+            WorldPartition->PinActors(Guids);
+        }
+        else
+        {
+            WorldPartition->UnpinActors(Guids);
+        }
+        FUnrealCompanionActorIndex::Get().Invalidate();
+    }
+    
+    TArray<TSharedPtr<FJsonValue>> ActorArray;
+    for (const FGuid& Guid : Guids)
+    {
+        const FWorldPartitionActorDescInstance* Desc = WorldPartition->GetActorDescInstance(Guid);
+        if (!Desc)
+        {
+            continue;
+        }
+        TSharedPtr<FJsonObject> ActorObj = MakeShared<FJsonObject>();
+        ActorObj->SetStringField(TEXT("guid"), Guid.ToString());
+        ActorObj->SetStringField(TEXT("name"), GetDescLabel(Desc));
+        ActorObj->SetBoolField(TEXT("loaded"), Desc->IsLoaded());
+        ActorArray.Add(MakeShared<FJsonValueObject>(ActorObj));
+    }
+    
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetBoolField(TEXT("success"), true);
+    ResultObj->SetStringField(TEXT("type"), TEXT("actor"));
+    ResultObj->SetStringField(TEXT("action"), bLoad ? TEXT("load") : TEXT("unload"));
+    ResultObj->SetArrayField(TEXT("actors"), ActorArray);
+    ResultObj->SetNumberField(TEXT("count"), ActorArray.Num());
+    ResultObj->SetBoolField(TEXT("has_more"), Matched > Guids.Num() + Skipped.Num() + Invalid.Num());
+    if (Invalid.Num() > 0)
+    {
+        TArray<TSharedPtr<FJsonValue>> InvalidArray;
+        for (const FString& Value : Invalid)
+        {
+            InvalidArray.Add(MakeShared<FJsonValueString>(Value));
+        }
+        ResultObj->SetArrayField(TEXT("not_found"), InvalidArray);
+    }
+    if (Skipped.Num() > 0)
+    {
+        TArray<TSharedPtr<FJsonValue>> SkippedArray;
+        for (const FGuid& Guid : Skipped)
+        {
+            SkippedArray.Add(MakeShared<FJsonValueString>(Guid.ToString()));
+        }
+        ResultObj->SetArrayField(TEXT("skipped_unsaved"), SkippedArray);
+    }
+    return ResultObj;
+}
+
 TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::QueryNode(const TSharedPtr<FJsonObject>& Params)
 {
     FString Action = Params->GetStringField(TEXT("action"));
@@ -337,105 +1116,233 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::QueryNode(const TSharedPt
     FString BlueprintName = Params->GetStringField(TEXT("blueprint_name"));
     if (BlueprintName.IsEmpty())
     {
-        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing blueprint_name for node query"));
+        // No Blueprint named: search every Blueprint through the node index
+        return QueryNodeProjectWide(Params);
     }
     
     // Load blueprint
-    UBlueprint* Blueprint = nullptr;
-    if (BlueprintName.StartsWith(TEXT("/")))
+    // Indexed name lookup: loads only the Blueprint that matches
+    UBlueprint* Blueprint = FUnrealCompanionCommonUtils::FindBlueprintByName(BlueprintName);
+    
+    if (!Blueprint)
     {
-        Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintName);
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
     }
-    else
+    
+    TSharedPtr<FJsonObject> ResultObj = MakeShareable(new FJsonObject());
+    ResultObj->SetStringField(TEXT("type"), TEXT("node"));
+    ResultObj->SetStringField(TEXT("action"), Action);
+    ResultObj->SetStringField(TEXT("blueprint"), BlueprintName);
+    
+    FString GraphName = Params->GetStringField(TEXT("graph_name"));
+    FString NodeTypeFilter = Params->GetStringField(TEXT("node_type"));
+    FString EventTypeFilter = Params->GetStringField(TEXT("event_type"));
+    
+    FUnrealCompanionQueryPager Pager(Params, TEXT("graph"), { TEXT("graph"), TEXT("title"), TEXT("class") });
+    if (!Pager.IsValid())
     {
-        TArray<FAssetData> Assets;
-        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
-        AssetRegistry.GetAssetsByClass(FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("Blueprint")), Assets);
-        
-        for (const FAssetData& Asset : Assets)
+        return Pager.CreateErrorResponse();
+    }
+    
+    auto ForEachMatch = [&](auto&& Visit)
+    {
+        for (UEdGraph* Graph : Blueprint->UbergraphPages)
+        {
+            if (!Graph) continue;
+            
+            // Filter by graph name
+            if (!GraphName.IsEmpty() && Graph->GetName() != GraphName)
+            {
+                continue;
+            }
+            
+            for (UEdGraphNode* Node : Graph->Nodes)
+            {
+                if (!Node) continue;
+                
+                // Filter by node type
+                if (!NodeTypeFilter.IsEmpty())
+                {
+                    FString NodeClass = Node->GetClass()->GetName();
+                    if (!NodeClass.Contains(NodeTypeFilter))
+                    {
+                        continue;
+                    }
+                }
+                
+                // Filter by event type
+                if (!EventTypeFilter.IsEmpty())
+                {
+                    UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
+                    if (!EventNode)
+                    {
+                        continue;
+                    }
+                    FString EventName = EventNode->GetFunctionName().ToString();
+                    if (!EventName.Contains(EventTypeFilter))
+                    {
+                        continue;
+                    }
+                }
+                
+                Visit(Node);
+            }
+        }
+    };
+    
+    const FString& Sort = Pager.GetSort();
+    auto MakeKey = [&Sort](UEdGraphNode* Node)
+    {
+        // Node GUIDs are unique within a Blueprint; the graph name keeps a graph's nodes together
+        FUnrealCompanionQueryKey Key;
+        Key.Id = Node->GetGraph()->GetName() + TEXT("/") + Node->NodeGuid.ToString();
+        if (Sort == TEXT("title"))
+        {
+            Key.Text = Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString();
+        }
+        else if (Sort == TEXT("class"))
+        {
+            Key.Text = Node->GetClass()->GetName();
+        }
+        return Key;
+    };
+    
+    auto ToJson = [](UEdGraphNode* Node)
+    {
+        TSharedPtr<FJsonObject> NodeObj = MakeShareable(new FJsonObject());
+        NodeObj->SetStringField(TEXT("id"), Node->NodeGuid.ToString());
+        NodeObj->SetStringField(TEXT("title"), Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
+        NodeObj->SetStringField(TEXT("class"), Node->GetClass()->GetName());
+        NodeObj->SetStringField(TEXT("graph"), Node->GetGraph()->GetName());
+        NodeObj->SetNumberField(TEXT("x"), Node->NodePosX);
+        NodeObj->SetNumberField(TEXT("y"), Node->NodePosY);
+        return NodeObj;
+    };
+    
+    const int32 Matched = Pager.Page<UEdGraphNode*>(ForEachMatch, MakeKey, ToJson);
+    
+    ResultObj->SetBoolField(TEXT("success"), true);
+    ResultObj->SetNumberField(TEXT("total_found"), Matched);
+    Pager.Finish(ResultObj);
+    
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::QueryNodeProjectWide(const TSharedPtr<FJsonObject>& Params)
+{
+    FUnrealCompanionNodeIndex::FQuery Query;
+    Params->TryGetStringField(TEXT("pattern"), Query.Pattern);
+    Params->TryGetStringField(TEXT("node_type"), Query.NodeClass);
+    Params->TryGetStringField(TEXT("class_filter"), Query.MemberParent);
+    Params->TryGetStringField(TEXT("event_type"), Query.Event);
+    Params->TryGetStringField(TEXT("graph_name"), Query.Graph);
+    Params->TryGetStringField(TEXT("path"), Query.Path);
+    if (Query.Path.IsEmpty())
+    {
+        Query.Path = TEXT("/Game");
+    }
+    Query.Path.RemoveFromEnd(TEXT("/"));
+    
+    FUnrealCompanionQueryPager Pager(Params, TEXT("blueprint"), { TEXT("blueprint"), TEXT("title"), TEXT("class") });
+    if (!Pager.IsValid())
+    {
+        return Pager.CreateErrorResponse();
+    }
+    // Matches are (record, index) pairs: keep them all and let the pager pick the page.
+    // Unsorted, the index's own cap still ends the search early (one past the page tells if more follow).
+    Query.MaxResults = Pager.IsSorted() ? MAX_int32 : Pager.GetPageSize() + 1;
+
+    if (Query.Pattern.IsEmpty() && Query.NodeClass.IsEmpty() && Query.MemberParent.IsEmpty() && Query.Event.IsEmpty())
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+            TEXT("MISSING_FILTER"),
+            TEXT("A project-wide node query needs pattern, node_type, class_filter or event_type"),
+            TEXT("Pass blueprint_name to list the nodes of one Blueprint"));
+    }
+
+    FUnrealCompanionNodeIndex& Index = FUnrealCompanionNodeIndex::Get();
+    const FUnrealCompanionNodeIndex::FSearchResult Search = Index.Search(Query);
+
+    using FMatch = FUnrealCompanionNodeIndex::FMatch;
+    using FNodeRecord = FUnrealCompanionNodeIndex::FNodeRecord;
+
+    auto ForEachMatch = [&Search](auto&& Visit)
+    {
+        for (const FMatch& Match : Search.Matches)
+        {
+            Visit(&Match);
+        }
+    };
+
+    const FString& Sort = Pager.GetSort();
+    auto MakeKey = [&Sort](const FMatch* Match)
+    {
+        const FNodeRecord& Node = Match->Blueprint->Nodes[Match->NodeIndex];
+        FUnrealCompanionQueryKey Key;
+        Key.Id = Match->Blueprint->ObjectPath + TEXT(":") + Node.NodeGuid.ToString();
+        if (Sort == TEXT("title"))
+        {
+            Key.Text = Node.Title;
+        }
+        else if (Sort == TEXT("class"))
+        {
+            Key.Text = Node.NodeClass.ToString();
+        }
+        return Key;
+    };
+
+    auto ToJson = [](const FMatch* Match)
+    {
+        const FNodeRecord& Node = Match->Blueprint->Nodes[Match->NodeIndex];
+        TSharedPtr<FJsonObject> NodeObj = MakeShareable(new FJsonObject());
+        NodeObj->SetStringField(TEXT("blueprint"), Match->Blueprint->ObjectPath);
+        NodeObj->SetStringField(TEXT("graph"), Node.Graph.ToString());
+        NodeObj->SetStringField(TEXT("id"), Node.NodeGuid.ToString());
+        NodeObj->SetStringField(TEXT("title"), Node.Title);
+        NodeObj->SetStringField(TEXT("class"), Node.NodeClass.ToString());
+        NodeObj->SetStringField(TEXT("kind"), FUnrealCompanionNodeIndex::GetKindName(Node.Kind));
+        if (!Node.Member.IsNone())
         {
-            if (Asset.AssetName.ToString() == BlueprintName)
-            {
-                Blueprint = Cast<UBlueprint>(Asset.GetAsset());
-                break;
-            }
+            NodeObj->SetStringField(TEXT("member"), Node.Member.ToString());
         }
-    }
-    
-    if (!Blueprint)
-    {
-        return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
-    }
-    
+        if (!Node.MemberParent.IsNone())
+        {
+            NodeObj->SetStringField(TEXT("member_parent"), Node.MemberParent.ToString());
+        }
+        return NodeObj;
+    };
+
     TSharedPtr<FJsonObject> ResultObj = MakeShareable(new FJsonObject());
+    Pager.Page<const FMatch*>(ForEachMatch, MakeKey, ToJson);
+
+    ResultObj->SetBoolField(TEXT("success"), true);
     ResultObj->SetStringField(TEXT("type"), TEXT("node"));
-    ResultObj->SetStringField(TEXT("action"), Action);
-    ResultObj->SetStringField(TEXT("blueprint"), BlueprintName);
-    
-    FString GraphName = Params->GetStringField(TEXT("graph_name"));
-    FString NodeTypeFilter = Params->GetStringField(TEXT("node_type"));
-    FString EventTypeFilter = Params->GetStringField(TEXT("event_type"));
-    int32 MaxResults = Params->HasField(TEXT("max_results")) ? (int32)Params->GetNumberField(TEXT("max_results")) : 100;
-    
-    TArray<TSharedPtr<FJsonValue>> Results;
-    int32 Count = 0;
-    
-    for (UEdGraph* Graph : Blueprint->UbergraphPages)
+    ResultObj->SetStringField(TEXT("path"), Query.Path);
+    ResultObj->SetNumberField(TEXT("total_found"), Search.TotalMatches);
+    Pager.Finish(ResultObj);
+    ResultObj->SetNumberField(TEXT("searched_blueprints"), Search.SearchedBlueprints);
+    ResultObj->SetNumberField(TEXT("from_cache"), Search.FromCache);
+    ResultObj->SetNumberField(TEXT("indexed_from_memory"), Search.IndexedFromMemory);
+    ResultObj->SetNumberField(TEXT("search_ms"), Search.SearchMs);
+
+    // Blueprints never summarised are not searched; load=true indexes them in the background
+    ResultObj->SetNumberField(TEXT("unindexed"), Search.Unindexed.Num());
+    if (Search.Unindexed.Num() > 0)
     {
-        if (!Graph) continue;
-        
-        // Filter by graph name
-        if (!GraphName.IsEmpty() && Graph->GetName() != GraphName)
+        bool bLoad = false;
+        Params->TryGetBoolField(TEXT("load"), bLoad);
+        if (bLoad)
         {
-            continue;
+            bool bStreamProgress = false;
+            Params->TryGetBoolField(TEXT("stream_progress"), bStreamProgress);
+            ResultObj->SetStringField(TEXT("index_job_id"), Index.IndexBlueprints(Search.Unindexed, bStreamProgress));
         }
-        
-        for (UEdGraphNode* Node : Graph->Nodes)
+        else
         {
-            if (!Node || Count >= MaxResults) continue;
-            
-            // Filter by node type
-            if (!NodeTypeFilter.IsEmpty())
-            {
-                FString NodeClass = Node->GetClass()->GetName();
-                if (!NodeClass.Contains(NodeTypeFilter))
-                {
-                    continue;
-                }
-            }
-            
-            // Filter by event type
-            if (!EventTypeFilter.IsEmpty())
-            {
-                UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
-                if (!EventNode)
-                {
-                    continue;
-                }
-                FString EventName = EventNode->GetFunctionName().ToString();
-                if (!EventName.Contains(EventTypeFilter))
-                {
-                    continue;
-                }
-            }
-            
-            TSharedPtr<FJsonObject> NodeObj = MakeShareable(new FJsonObject());
-            NodeObj->SetStringField(TEXT("id"), Node->NodeGuid.ToString());
-            NodeObj->SetStringField(TEXT("title"), Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
-            NodeObj->SetStringField(TEXT("class"), Node->GetClass()->GetName());
-            NodeObj->SetStringField(TEXT("graph"), Graph->GetName());
-            NodeObj->SetNumberField(TEXT("x"), Node->NodePosX);
-            NodeObj->SetNumberField(TEXT("y"), Node->NodePosY);
-            
-            Results.Add(MakeShareable(new FJsonValueObject(NodeObj)));
-            Count++;
+            ResultObj->SetStringField(TEXT("suggestion"), FString::Printf(
+                TEXT("%d Blueprints have no node index yet; repeat with load=true to index them (once) as a job"), Search.Unindexed.Num()));
         }
     }
-    
-    ResultObj->SetBoolField(TEXT("success"), true);
-    ResultObj->SetNumberField(TEXT("count"), Results.Num());
-    ResultObj->SetArrayField(TEXT("results"), Results);
-    
     return ResultObj;
 }
 
@@ -457,7 +1364,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::QueryFolder(const TShared
     
     if (Action == TEXT("exists"))
     {
-        bool bExists = UEditorAssetLibrary::DoesDirectoryExist(Path);
+        bool bExists = FUnrealCompanionCommonUtils::DoesFolderExistInRegistry(Path);
         ResultObj->SetBoolField(TEXT("success"), true);
         ResultObj->SetBoolField(TEXT("exists"), bExists);
     }
@@ -527,6 +1434,30 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::GetInfoAsset(const TShare
     }
     
     bool bIncludeBounds = Params->HasField(TEXT("include_bounds")) && Params->GetBoolField(TEXT("include_bounds"));
+
+    // detail=true always loads: exact bounds and counts, even where the tags have them
+    bool bDetail = false;
+    Params->TryGetBoolField(TEXT("detail"), bDetail);
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShareable(new FJsonObject());
+    ResultObj->SetBoolField(TEXT("success"), true);
+    ResultObj->SetStringField(TEXT("type"), TEXT("asset"));
+    ResultObj->SetStringField(TEXT("path"), Path);
+
+    // Unloaded asset: name, class and mesh stats are registry tags
+    if (!bDetail)
+    {
+        const FAssetData AssetData = FindUnloadedAssetData(Path);
+        const bool bMesh = AssetData.IsValid()
+            && (AssetData.IsInstanceOf(UStaticMesh::StaticClass()) || AssetData.IsInstanceOf(USkeletalMesh::StaticClass()));
+        if (AssetData.IsValid() && (!bMesh || MeshInfoFromTags(AssetData, bIncludeBounds, ResultObj)))
+        {
+            ResultObj->SetStringField(TEXT("name"), AssetData.AssetName.ToString());
+            ResultObj->SetStringField(TEXT("class"), AssetData.AssetClassPath.GetAssetName().ToString());
+            ResultObj->SetStringField(TEXT("source"), TEXT("asset_registry"));
+            return ResultObj;
+        }
+    }
     
     UObject* Asset = UEditorAssetLibrary::LoadAsset(Path);
     if (!Asset)
@@ -534,44 +1465,9 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::GetInfoAsset(const TShare
         return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Asset not found: %s"), *Path));
     }
     
-    TSharedPtr<FJsonObject> ResultObj = MakeShareable(new FJsonObject());
-    ResultObj->SetBoolField(TEXT("success"), true);
-    ResultObj->SetStringField(TEXT("type"), TEXT("asset"));
-    ResultObj->SetStringField(TEXT("path"), Path);
     ResultObj->SetStringField(TEXT("name"), Asset->GetName());
     ResultObj->SetStringField(TEXT("class"), Asset->GetClass()->GetName());
-    
-    // Include bounds for static meshes
-    if (bIncludeBounds)
-    {
-        UStaticMesh* StaticMesh = Cast<UStaticMesh>(Asset);
-        if (StaticMesh)
-        {
-            FBox Bounds = StaticMesh->GetBoundingBox();
-            TSharedPtr<FJsonObject> BoundsObj = MakeShareable(new FJsonObject());
-            
-            TArray<TSharedPtr<FJsonValue>> MinArray;
-            MinArray.Add(MakeShareable(new FJsonValueNumber(Bounds.Min.X)));
-            MinArray.Add(MakeShareable(new FJsonValueNumber(Bounds.Min.Y)));
-            MinArray.Add(MakeShareable(new FJsonValueNumber(Bounds.Min.Z)));
-            BoundsObj->SetArrayField(TEXT("min"), MinArray);
-            
-            TArray<TSharedPtr<FJsonValue>> MaxArray;
-            MaxArray.Add(MakeShareable(new FJsonValueNumber(Bounds.Max.X)));
-            MaxArray.Add(MakeShareable(new FJsonValueNumber(Bounds.Max.Y)));
-            MaxArray.Add(MakeShareable(new FJsonValueNumber(Bounds.Max.Z)));
-            BoundsObj->SetArrayField(TEXT("max"), MaxArray);
-            
-            FVector Size = Bounds.GetSize();
-            TArray<TSharedPtr<FJsonValue>> SizeArray;
-            SizeArray.Add(MakeShareable(new FJsonValueNumber(Size.X)));
-            SizeArray.Add(MakeShareable(new FJsonValueNumber(Size.Y)));
-            SizeArray.Add(MakeShareable(new FJsonValueNumber(Size.Z)));
-            BoundsObj->SetArrayField(TEXT("size"), SizeArray);
-            
-            ResultObj->SetObjectField(TEXT("bounds"), BoundsObj);
-        }
-    }
+    MeshInfoFromAsset(Asset, bIncludeBounds, ResultObj);
     
     return ResultObj;
 }
@@ -586,6 +1482,45 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::GetInfoBlueprint(const TS
     
     FString InfoType = Params->GetStringField(TEXT("info_type"));
     if (InfoType.IsEmpty()) InfoType = TEXT("all");
+
+    // fields takes precedence; info_type keeps its old meaning (parent_class always included)
+    FFieldSelection Fields(Params);
+    if (Fields.bAll && InfoType != TEXT("all"))
+    {
+        Fields.Add(InfoType);
+        Fields.Add(TEXT("parent_class"));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShareable(new FJsonObject());
+
+    // Class-level fields are registry tags: answer without loading the package
+    if (Fields.IsWithin({TEXT("parent_class"), TEXT("native_parent_class"), TEXT("interfaces")}))
+    {
+        const FAssetData AssetData = FindUnloadedAssetData(Path);
+        if (AssetData.IsValid() && AssetData.IsInstanceOf(UBlueprint::StaticClass()))
+        {
+            ResultObj->SetBoolField(TEXT("success"), true);
+            ResultObj->SetStringField(TEXT("type"), TEXT("blueprint"));
+            ResultObj->SetStringField(TEXT("path"), Path);
+            ResultObj->SetStringField(TEXT("name"), AssetData.AssetName.ToString());
+            ResultObj->SetStringField(TEXT("source"), TEXT("asset_registry"));
+
+            FString TagValue;
+            if (Fields.Wants(TEXT("parent_class")))
+            {
+                ResultObj->SetStringField(TEXT("parent_class"), AssetData.GetTagValue(FBlueprintTags::ParentClassPath, TagValue) ? ObjectNameFromTag(TagValue) : TEXT("None"));
+            }
+            if (Fields.Wants(TEXT("native_parent_class")))
+            {
+                ResultObj->SetStringField(TEXT("native_parent_class"), AssetData.GetTagValue(FBlueprintTags::NativeParentClassPath, TagValue) ? ObjectNameFromTag(TagValue) : TEXT("None"));
+            }
+            if (Fields.Wants(TEXT("interfaces")))
+            {
+                ResultObj->SetArrayField(TEXT("interfaces"), InterfacesFromTag(AssetData));
+            }
+            return ResultObj;
+        }
+    }
     
     UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *Path);
     if (!Blueprint)
@@ -593,26 +1528,40 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::GetInfoBlueprint(const TS
         return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *Path));
     }
     
-    TSharedPtr<FJsonObject> ResultObj = MakeShareable(new FJsonObject());
     ResultObj->SetBoolField(TEXT("success"), true);
     ResultObj->SetStringField(TEXT("type"), TEXT("blueprint"));
     ResultObj->SetStringField(TEXT("path"), Path);
     ResultObj->SetStringField(TEXT("name"), Blueprint->GetName());
-    ResultObj->SetStringField(TEXT("parent_class"), Blueprint->ParentClass ? Blueprint->ParentClass->GetName() : TEXT("None"));
+    if (Fields.Wants(TEXT("parent_class")))
+    {
+        ResultObj->SetStringField(TEXT("parent_class"), Blueprint->ParentClass ? Blueprint->ParentClass->GetName() : TEXT("None"));
+    }
+    if (!Fields.bAll && Fields.Wants(TEXT("native_parent_class")))
+    {
+        ResultObj->SetStringField(TEXT("native_parent_class"), NativeParentName(Blueprint->ParentClass));
+    }
     
-    // Variables
-    if (InfoType == TEXT("all") || InfoType == TEXT("variables"))
+    // Variables: names only, unless particular keys were asked for
+    if (Fields.Wants(TEXT("variables")))
     {
+        const bool bPartial = Fields.IsPartial(TEXT("variables"));
         TArray<TSharedPtr<FJsonValue>> VarArray;
         for (const FBPVariableDescription& Var : Blueprint->NewVariables)
         {
-            VarArray.Add(MakeShareable(new FJsonValueString(Var.VarName.ToString())));
+            if (bPartial)
+            {
+                VarArray.Add(MakeShareable(new FJsonValueObject(VariableToJson(Var, Fields))));
+            }
+            else
+            {
+                VarArray.Add(MakeShareable(new FJsonValueString(Var.VarName.ToString())));
+            }
         }
         ResultObj->SetArrayField(TEXT("variables"), VarArray);
     }
     
     // Functions
-    if (InfoType == TEXT("all") || InfoType == TEXT("functions"))
+    if (Fields.Wants(TEXT("functions")))
     {
         TArray<TSharedPtr<FJsonValue>> FuncArray;
         for (UEdGraph* Graph : Blueprint->FunctionGraphs)
@@ -626,7 +1575,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::GetInfoBlueprint(const TS
     }
     
     // Components
-    if (InfoType == TEXT("all") || InfoType == TEXT("components"))
+    if (Fields.Wants(TEXT("components")))
     {
         TArray<TSharedPtr<FJsonValue>> CompArray;
         if (Blueprint->SimpleConstructionScript)
@@ -643,7 +1592,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::GetInfoBlueprint(const TS
     }
     
     // Interfaces
-    if (InfoType == TEXT("all") || InfoType == TEXT("interfaces"))
+    if (Fields.Wants(TEXT("interfaces")))
     {
         TArray<TSharedPtr<FJsonValue>> IntArray;
         for (const FBPInterfaceDescription& Interface : Blueprint->ImplementedInterfaces)
@@ -657,7 +1606,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::GetInfoBlueprint(const TS
     }
     
     // Event Dispatchers - Debug info to compare manual vs programmatic creation
-    if (InfoType == TEXT("all") || InfoType == TEXT("dispatchers"))
+    if (Fields.Wants(TEXT("dispatchers")))
     {
         // List delegate signature graphs
         TArray<TSharedPtr<FJsonValue>> GraphsArray;
@@ -737,26 +1686,8 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::GetInfoNode(const TShared
     }
     
     // Load blueprint
-    UBlueprint* Blueprint = nullptr;
-    if (BlueprintName.StartsWith(TEXT("/")))
-    {
-        Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintName);
-    }
-    else
-    {
-        TArray<FAssetData> Assets;
-        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
-        AssetRegistry.GetAssetsByClass(FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("Blueprint")), Assets);
-        
-        for (const FAssetData& Asset : Assets)
-        {
-            if (Asset.AssetName.ToString() == BlueprintName)
-            {
-                Blueprint = Cast<UBlueprint>(Asset.GetAsset());
-                break;
-            }
-        }
-    }
+    // Indexed name lookup: loads only the Blueprint that matches
+    UBlueprint* Blueprint = FUnrealCompanionCommonUtils::FindBlueprintByName(BlueprintName);
     
     if (!Blueprint)
     {
@@ -833,16 +1764,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::GetInfoActor(const TShare
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("No world available"));
     }
     
-    AActor* FoundActor = nullptr;
-    for (TActorIterator<AActor> It(World); It; ++It)
-    {
-        AActor* Actor = *It;
-        if (Actor && (Actor->GetActorLabel() == ActorName || Actor->GetName() == ActorName))
-        {
-            FoundActor = Actor;
-            break;
-        }
-    }
+    AActor* FoundActor = FUnrealCompanionActorIndex::Get().FindByName(World, ActorName);
     
     if (!FoundActor)
     {
@@ -1060,6 +1982,34 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::GetInfoAnimBlueprint(cons
     {
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing path for anim_blueprint get_info"));
     }
+
+    const FFieldSelection Fields(Params);
+
+    // Parent class and skeleton are registry tags: answer without loading the package
+    if (Fields.IsWithin({TEXT("parent_class"), TEXT("skeleton")}))
+    {
+        const FAssetData AssetData = FindUnloadedAssetData(Path);
+        if (AssetData.IsValid() && AssetData.IsInstanceOf(UAnimBlueprint::StaticClass()))
+        {
+            TSharedPtr<FJsonObject> ResultObj = MakeShareable(new FJsonObject());
+            ResultObj->SetBoolField(TEXT("success"), true);
+            ResultObj->SetStringField(TEXT("type"), TEXT("anim_blueprint"));
+            ResultObj->SetStringField(TEXT("path"), Path);
+            ResultObj->SetStringField(TEXT("name"), AssetData.AssetName.ToString());
+            ResultObj->SetStringField(TEXT("source"), TEXT("asset_registry"));
+
+            FString TagValue;
+            if (Fields.Wants(TEXT("parent_class")))
+            {
+                ResultObj->SetStringField(TEXT("parent_class"), AssetData.GetTagValue(FBlueprintTags::ParentClassPath, TagValue) ? ObjectNameFromTag(TagValue) : TEXT("None"));
+            }
+            if (Fields.Wants(TEXT("skeleton")) && AssetData.GetTagValue(TEXT("TargetSkeleton"), TagValue) && !TagValue.IsEmpty() && TagValue != TEXT("None"))
+            {
+                ResultObj->SetStringField(TEXT("skeleton"), FPackageName::ExportTextPathToObjectPath(TagValue));
+            }
+            return ResultObj;
+        }
+    }
     
     UObject* Asset = UEditorAssetLibrary::LoadAsset(Path);
     if (!Asset)
@@ -1078,116 +2028,139 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::GetInfoAnimBlueprint(cons
     ResultObj->SetStringField(TEXT("type"), TEXT("anim_blueprint"));
     ResultObj->SetStringField(TEXT("path"), Path);
     ResultObj->SetStringField(TEXT("name"), AnimBP->GetName());
-    ResultObj->SetStringField(TEXT("parent_class"), AnimBP->ParentClass ? AnimBP->ParentClass->GetName() : TEXT("None"));
+    if (Fields.Wants(TEXT("parent_class")))
+    {
+        ResultObj->SetStringField(TEXT("parent_class"), AnimBP->ParentClass ? AnimBP->ParentClass->GetName() : TEXT("None"));
+    }
     
     // Skeleton
-    if (AnimBP->TargetSkeleton)
+    if (Fields.Wants(TEXT("skeleton")) && AnimBP->TargetSkeleton)
     {
         ResultObj->SetStringField(TEXT("skeleton"), AnimBP->TargetSkeleton->GetPathName());
     }
     
     // Variables
-    TArray<TSharedPtr<FJsonValue>> VarArray;
-    for (const FBPVariableDescription& Var : AnimBP->NewVariables)
+    if (Fields.Wants(TEXT("variables")))
     {
-        TSharedPtr<FJsonObject> VarObj = MakeShareable(new FJsonObject());
-        VarObj->SetStringField(TEXT("name"), Var.VarName.ToString());
-        VarObj->SetStringField(TEXT("type"), Var.VarType.PinCategory.ToString());
-        VarArray.Add(MakeShareable(new FJsonValueObject(VarObj)));
+        TArray<TSharedPtr<FJsonValue>> VarArray;
+        for (const FBPVariableDescription& Var : AnimBP->NewVariables)
+        {
+            VarArray.Add(MakeShareable(new FJsonValueObject(VariableToJson(Var, Fields))));
+        }
+        ResultObj->SetArrayField(TEXT("variables"), VarArray);
     }
-    ResultObj->SetArrayField(TEXT("variables"), VarArray);
     
     // Anim graphs - find state machines
-    TArray<TSharedPtr<FJsonValue>> StateMachinesArray;
-    
-    for (UEdGraph* Graph : AnimBP->FunctionGraphs)
+    if (Fields.Wants(TEXT("state_machines")))
     {
-        if (!Graph) continue;
-        
-        // Look for state machine nodes
-        for (UEdGraphNode* Node : Graph->Nodes)
+        // "state_machines.states" / ".transitions" skip building the other list (counts stay)
+        const bool bWantStates = Fields.WantsSub(TEXT("state_machines"), TEXT("states"));
+        const bool bWantTransitions = Fields.WantsSub(TEXT("state_machines"), TEXT("transitions"));
+        TArray<TSharedPtr<FJsonValue>> StateMachinesArray;
+
+        for (UEdGraph* Graph : AnimBP->FunctionGraphs)
         {
-            UAnimGraphNode_StateMachineBase* SMNode = Cast<UAnimGraphNode_StateMachineBase>(Node);
-            if (!SMNode) continue;
+            if (!Graph) continue;
+        
+            // Look for state machine nodes
+            for (UEdGraphNode* Node : Graph->Nodes)
+            {
+                UAnimGraphNode_StateMachineBase* SMNode = Cast<UAnimGraphNode_StateMachineBase>(Node);
+                if (!SMNode) continue;
             
-            TSharedPtr<FJsonObject> SMObj = MakeShareable(new FJsonObject());
-            SMObj->SetStringField(TEXT("name"), SMNode->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
-            SMObj->SetStringField(TEXT("graph"), Graph->GetName());
+                TSharedPtr<FJsonObject> SMObj = MakeShareable(new FJsonObject());
+                SMObj->SetStringField(TEXT("name"), SMNode->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
+                SMObj->SetStringField(TEXT("graph"), Graph->GetName());
             
-            // Get the state machine graph
-            UAnimationStateMachineGraph* SMGraph = SMNode->EditorStateMachineGraph;
-            if (SMGraph)
-            {
-                // States
-                TArray<TSharedPtr<FJsonValue>> StatesArray;
-                TArray<TSharedPtr<FJsonValue>> TransitionsArray;
-                
-                for (UEdGraphNode* SMSubNode : SMGraph->Nodes)
+                // Get the state machine graph
+                UAnimationStateMachineGraph* SMGraph = SMNode->EditorStateMachineGraph;
+                if (SMGraph)
                 {
-                    if (!SMSubNode) continue;
-                    
-                    // State nodes
-                    UAnimStateNode* StateNode = Cast<UAnimStateNode>(SMSubNode);
-                    if (StateNode)
+                    // States
+                    TArray<TSharedPtr<FJsonValue>> StatesArray;
+                    TArray<TSharedPtr<FJsonValue>> TransitionsArray;
+                    int32 StateCount = 0;
+                    int32 TransitionCount = 0;
+                
+                    for (UEdGraphNode* SMSubNode : SMGraph->Nodes)
                     {
-                        TSharedPtr<FJsonObject> StateObj = MakeShareable(new FJsonObject());
-                        StateObj->SetStringField(TEXT("name"), StateNode->GetStateName());
-                        StateObj->SetStringField(TEXT("node_id"), SMSubNode->NodeGuid.ToString());
-                        StatesArray.Add(MakeShareable(new FJsonValueObject(StateObj)));
-                        continue;
-                    }
+                        if (!SMSubNode) continue;
                     
-                    // Transition nodes
-                    UAnimStateTransitionNode* TransNode = Cast<UAnimStateTransitionNode>(SMSubNode);
-                    if (TransNode)
-                    {
-                        TSharedPtr<FJsonObject> TransObj = MakeShareable(new FJsonObject());
-                        if (TransNode->GetPreviousState())
+                        // State nodes
+                        UAnimStateNode* StateNode = Cast<UAnimStateNode>(SMSubNode);
+                        if (StateNode)
                         {
-                            TransObj->SetStringField(TEXT("from"), TransNode->GetPreviousState()->GetStateName());
+                            ++StateCount;
+                            if (!bWantStates) continue;
+                            TSharedPtr<FJsonObject> StateObj = MakeShareable(new FJsonObject());
+                            StateObj->SetStringField(TEXT("name"), StateNode->GetStateName());
+                            StateObj->SetStringField(TEXT("node_id"), SMSubNode->NodeGuid.ToString());
+                            StatesArray.Add(MakeShareable(new FJsonValueObject(StateObj)));
+                            continue;
                         }
-                        if (TransNode->GetNextState())
+                    
+                        // Transition nodes
+                        UAnimStateTransitionNode* TransNode = Cast<UAnimStateTransitionNode>(SMSubNode);
+                        if (TransNode)
                         {
-                            TransObj->SetStringField(TEXT("to"), TransNode->GetNextState()->GetStateName());
+                            ++TransitionCount;
+                            if (!bWantTransitions) continue;
+                            TSharedPtr<FJsonObject> TransObj = MakeShareable(new FJsonObject());
+                            if (TransNode->GetPreviousState())
+                            {
+                                TransObj->SetStringField(TEXT("from"), TransNode->GetPreviousState()->GetStateName());
+                            }
+                            if (TransNode->GetNextState())
+                            {
+                                TransObj->SetStringField(TEXT("to"), TransNode->GetNextState()->GetStateName());
+                            }
+                            TransObj->SetStringField(TEXT("node_id"), SMSubNode->NodeGuid.ToString());
+                            TransitionsArray.Add(MakeShareable(new FJsonValueObject(TransObj)));
+                            continue;
                         }
-                        TransObj->SetStringField(TEXT("node_id"), SMSubNode->NodeGuid.ToString());
-                        TransitionsArray.Add(MakeShareable(new FJsonValueObject(TransObj)));
-                        continue;
                     }
-                }
                 
-                SMObj->SetArrayField(TEXT("states"), StatesArray);
-                SMObj->SetArrayField(TEXT("transitions"), TransitionsArray);
-                SMObj->SetNumberField(TEXT("state_count"), StatesArray.Num());
-                SMObj->SetNumberField(TEXT("transition_count"), TransitionsArray.Num());
-            }
+                    if (bWantStates)
+                    {
+                        SMObj->SetArrayField(TEXT("states"), StatesArray);
+                    }
+                    if (bWantTransitions)
+                    {
+                        SMObj->SetArrayField(TEXT("transitions"), TransitionsArray);
+                    }
+                    SMObj->SetNumberField(TEXT("state_count"), StateCount);
+                    SMObj->SetNumberField(TEXT("transition_count"), TransitionCount);
+                }
             
-            StateMachinesArray.Add(MakeShareable(new FJsonValueObject(SMObj)));
+                StateMachinesArray.Add(MakeShareable(new FJsonValueObject(SMObj)));
+            }
         }
+        ResultObj->SetArrayField(TEXT("state_machines"), StateMachinesArray);
     }
     
-    ResultObj->SetArrayField(TEXT("state_machines"), StateMachinesArray);
-    
     // All graphs summary
-    TArray<TSharedPtr<FJsonValue>> GraphsArray;
-    for (UEdGraph* Graph : AnimBP->FunctionGraphs)
-    {
-        if (!Graph) continue;
-        TSharedPtr<FJsonObject> GraphObj = MakeShareable(new FJsonObject());
-        GraphObj->SetStringField(TEXT("name"), Graph->GetName());
-        GraphObj->SetNumberField(TEXT("node_count"), Graph->Nodes.Num());
-        GraphsArray.Add(MakeShareable(new FJsonValueObject(GraphObj)));
-    }
-    for (UEdGraph* Graph : AnimBP->UbergraphPages)
+    if (Fields.Wants(TEXT("graphs")))
     {
-        if (!Graph) continue;
-        TSharedPtr<FJsonObject> GraphObj = MakeShareable(new FJsonObject());
-        GraphObj->SetStringField(TEXT("name"), Graph->GetName());
-        GraphObj->SetStringField(TEXT("type"), TEXT("EventGraph"));
-        GraphObj->SetNumberField(TEXT("node_count"), Graph->Nodes.Num());
-        GraphsArray.Add(MakeShareable(new FJsonValueObject(GraphObj)));
+        TArray<TSharedPtr<FJsonValue>> GraphsArray;
+        for (UEdGraph* Graph : AnimBP->FunctionGraphs)
+        {
+            if (!Graph) continue;
+            TSharedPtr<FJsonObject> GraphObj = MakeShareable(new FJsonObject());
+            GraphObj->SetStringField(TEXT("name"), Graph->GetName());
+            GraphObj->SetNumberField(TEXT("node_count"), Graph->Nodes.Num());
+            GraphsArray.Add(MakeShareable(new FJsonValueObject(GraphObj)));
+        }
+        for (UEdGraph* Graph : AnimBP->UbergraphPages)
+        {
+            if (!Graph) continue;
+            TSharedPtr<FJsonObject> GraphObj = MakeShareable(new FJsonObject());
+            GraphObj->SetStringField(TEXT("name"), Graph->GetName());
+            GraphObj->SetStringField(TEXT("type"), TEXT("EventGraph"));
+            GraphObj->SetNumberField(TEXT("node_count"), Graph->Nodes.Num());
+            GraphsArray.Add(MakeShareable(new FJsonValueObject(GraphObj)));
+        }
+        ResultObj->SetArrayField(TEXT("graphs"), GraphsArray);
     }
-    ResultObj->SetArrayField(TEXT("graphs"), GraphsArray);
     
     return ResultObj;
 }
@@ -1229,96 +2202,55 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::GetInfoBehaviorTree(const
         ResultObj->SetStringField(TEXT("blackboard_name"), BT->BlackboardAsset->GetName());
     }
     
-    // Traverse the tree recursively
+    // Flattened once per saved/edited version of the tree; repeated polls reuse the built nodes
+    bool bFromCache = false;
+    TSharedPtr<const FUnrealCompanionBehaviorTreeCache::FTree> Summary = FUnrealCompanionBehaviorTreeCache::Get().Find(BT, bFromCache);
+    const TArray<FUnrealCompanionBehaviorTreeCache::FNode>& Nodes = Summary->Nodes;
+
+    // node_id: subtree root; max_depth: levels below it (0 = the root alone)
+    int32 First = 0;
+    int32 End = Nodes.Num();
+    FString RootId;
+    if (Params->TryGetStringField(TEXT("node_id"), RootId) && !RootId.IsEmpty())
+    {
+        const int32 RootIndex = FUnrealCompanionBehaviorTreeCache::ParseNodeId(RootId);
+        if (!Nodes.IsValidIndex(RootIndex))
+        {
+            return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+                TEXT("NODE_NOT_FOUND"),
+                FString::Printf(TEXT("Behavior tree node not found: %s"), *RootId),
+                FString::Printf(TEXT("Node ids run from node_0 to node_%d"), Nodes.Num() - 1));
+        }
+        First = RootIndex;
+        End = Nodes[RootIndex].SubtreeEnd;
+        ResultObj->SetStringField(TEXT("root_id"), FString::Printf(TEXT("node_%d"), RootIndex));
+    }
+
+    int32 MaxDepth = MAX_int32;
+    if (Params->HasField(TEXT("max_depth")))
+    {
+        MaxDepth = FMath::Max(0, (int32)Params->GetNumberField(TEXT("max_depth")));
+    }
+    const int32 DepthLimit = Nodes.IsValidIndex(First) && MaxDepth != MAX_int32 ? Nodes[First].Depth + MaxDepth : MAX_int32;
+
     TArray<TSharedPtr<FJsonValue>> NodesArray;
-    int32 NodeCount = 0;
-    int32 MaxDepth = 0;
-    
-    // Helper lambda to recursively build node info
-    TFunction<void(UBTCompositeNode*, int32, const FString&)> TraverseTree;
-    TraverseTree = [&](UBTCompositeNode* CompositeNode, int32 Depth, const FString& ParentId)
+    NodesArray.Reserve(End - First);
+    for (int32 Index = First; Index < End; ++Index)
     {
-        if (!CompositeNode) return;
-        if (Depth > MaxDepth) MaxDepth = Depth;
-        
-        // Add the composite node itself
-        FString NodeId = FString::Printf(TEXT("node_%d"), NodeCount++);
-        {
-            TSharedPtr<FJsonObject> NodeObj = MakeShareable(new FJsonObject());
-            NodeObj->SetStringField(TEXT("id"), NodeId);
-            NodeObj->SetStringField(TEXT("class"), CompositeNode->GetClass()->GetName());
-            NodeObj->SetStringField(TEXT("node_name"), CompositeNode->GetNodeName());
-            NodeObj->SetStringField(TEXT("category"), TEXT("composite"));
-            NodeObj->SetNumberField(TEXT("depth"), Depth);
-            if (!ParentId.IsEmpty())
-            {
-                NodeObj->SetStringField(TEXT("parent_id"), ParentId);
-            }
-            
-            // Children IDs will be filled as we traverse
-            TArray<TSharedPtr<FJsonValue>> ChildIds;
-            for (int32 i = 0; i < CompositeNode->Children.Num(); i++)
-            {
-                ChildIds.Add(MakeShareable(new FJsonValueString(FString::Printf(TEXT("node_%d_child_%d"), NodeCount - 1, i))));
-            }
-            
-            // Children count
-            NodeObj->SetNumberField(TEXT("children_count"), CompositeNode->Children.Num());
-            
-            NodesArray.Add(MakeShareable(new FJsonValueObject(NodeObj)));
-        }
-        
-        // Traverse children
-        for (const FBTCompositeChild& Child : CompositeNode->Children)
+        if (Nodes[Index].Depth > DepthLimit)
         {
-            if (Child.ChildTask)
-            {
-                // Task node (leaf)
-                FString TaskId = FString::Printf(TEXT("node_%d"), NodeCount++);
-                TSharedPtr<FJsonObject> TaskObj = MakeShareable(new FJsonObject());
-                TaskObj->SetStringField(TEXT("id"), TaskId);
-                TaskObj->SetStringField(TEXT("class"), Child.ChildTask->GetClass()->GetName());
-                TaskObj->SetStringField(TEXT("node_name"), Child.ChildTask->GetNodeName());
-                TaskObj->SetStringField(TEXT("category"), TEXT("task"));
-                TaskObj->SetNumberField(TEXT("depth"), Depth + 1);
-                TaskObj->SetStringField(TEXT("parent_id"), NodeId);
-                
-                // Decorators on task
-                TArray<TSharedPtr<FJsonValue>> TaskDecoratorsArray;
-                for (UBTDecorator* Decorator : Child.Decorators)
-                {
-                    if (!Decorator) continue;
-                    TSharedPtr<FJsonObject> DecObj = MakeShareable(new FJsonObject());
-                    DecObj->SetStringField(TEXT("class"), Decorator->GetClass()->GetName());
-                    DecObj->SetStringField(TEXT("node_name"), Decorator->GetNodeName());
-                    TaskDecoratorsArray.Add(MakeShareable(new FJsonValueObject(DecObj)));
-                }
-                if (TaskDecoratorsArray.Num() > 0)
-                {
-                    TaskObj->SetArrayField(TEXT("decorators"), TaskDecoratorsArray);
-                }
-                
-                NodesArray.Add(MakeShareable(new FJsonValueObject(TaskObj)));
-                
-                if (Depth + 1 > MaxDepth) MaxDepth = Depth + 1;
-            }
-            
-            if (Child.ChildComposite)
-            {
-                TraverseTree(Child.ChildComposite, Depth + 1, NodeId);
-            }
+            // The rest of this subtree is deeper still
+            Index = Nodes[Index].SubtreeEnd - 1;
+            continue;
         }
-    };
-    
-    // Start traversal from root
-    if (BT->RootNode)
-    {
-        TraverseTree(BT->RootNode, 0, TEXT(""));
+        NodesArray.Add(Nodes[Index].Json);
     }
-    
+
     ResultObj->SetArrayField(TEXT("nodes"), NodesArray);
-    ResultObj->SetNumberField(TEXT("node_count"), NodeCount);
-    ResultObj->SetNumberField(TEXT("tree_depth"), MaxDepth);
+    ResultObj->SetNumberField(TEXT("node_count"), NodesArray.Num());
+    ResultObj->SetNumberField(TEXT("total_node_count"), Nodes.Num());
+    ResultObj->SetNumberField(TEXT("tree_depth"), Summary->TreeDepth);
+    ResultObj->SetBoolField(TEXT("cached"), bFromCache);
     
     return ResultObj;
 }
@@ -1337,10 +2269,45 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::HandleSave(const TSharedP
     
     if (Scope == TEXT("all") || Scope == TEXT("dirty"))
     {
-        // Save all dirty packages
-        bool bSuccess = UEditorAssetLibrary::SaveLoadedAssets(TArray<UObject*>(), false);
-        ResultObj->SetBoolField(TEXT("success"), true);
-        ResultObj->SetStringField(TEXT("message"), TEXT("Saved all dirty assets"));
+        // Save all dirty packages in one batch; large batches reply when the last file is written
+        TArray<UPackage*> Packages;
+        FUnrealCompanionPackageSaver::GatherDirtyPackages(/*bIncludeMaps=*/true, /*bIncludeContent=*/true, Packages);
+
+        // async: reply with a job id straight away (job_status / job_cancel)
+        bool bAsync = false;
+        Params->TryGetBoolField(TEXT("async"), bAsync);
+        bool bStreamProgress = false;
+        Params->TryGetBoolField(TEXT("stream_progress"), bStreamProgress);
+
+        TSharedPtr<FJsonObject> SaveResult = bAsync
+            ? FUnrealCompanionPackageSaver::Get().StartJob(Packages, bStreamProgress)
+            : FUnrealCompanionPackageSaver::Get().Save(Packages);
+        // Every dirty package is in this save, including headless deferred ones
+        FUnrealCompanionEditorFocus::Get().ClearDeferredSaves();
+        if (SaveResult.IsValid())
+        {
+            SaveResult->SetStringField(TEXT("scope"), Scope);
+        }
+        return SaveResult;
+    }
+    else if (Scope == TEXT("deferred"))
+    {
+        // Headless: the assets commands would have saved on EndFocus, and nothing else
+        TSharedPtr<FJsonObject> SaveResult = FUnrealCompanionEditorFocus::Get().FlushDeferredSaves();
+        if (SaveResult.IsValid())
+        {
+            SaveResult->SetStringField(TEXT("scope"), Scope);
+        }
+        return SaveResult;
+    }
+    else if (Scope == TEXT("status"))
+    {
+        // Progress of a time-sliced save started by an earlier core_save / asset_save_all
+        TSharedPtr<FJsonObject> Status = FUnrealCompanionPackageSaver::Get().GetStatus();
+        Status->SetStringField(TEXT("scope"), Scope);
+        Status->SetBoolField(TEXT("headless"), FUnrealCompanionEditorFocus::Get().IsHeadless());
+        Status->SetNumberField(TEXT("deferred_saves"), FUnrealCompanionEditorFocus::Get().GetDeferredSaveCount());
+        return Status;
     }
     else if (Scope == TEXT("level"))
     {
@@ -1377,3 +2344,62 @@ TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::HandleSave(const TSharedP
     
     return ResultObj;
 }
+
+TSharedPtr<FJsonObject> FUnrealCompanionQueryCommands::HandleSession(const TSharedPtr<FJsonObject>& Params)
+{
+    FString Action = Params->GetStringField(TEXT("action"));
+    FUnrealCompanionCompileSession& Session = FUnrealCompanionCompileSession::Get();
+    FUnrealCompanionUndoPolicy& UndoPolicy = FUnrealCompanionUndoPolicy::Get();
+
+    if (Action == TEXT("begin"))
+    {
+        FString Label;
+        Params->TryGetStringField(TEXT("label"), Label);
+        if (Session.IsActive())
+        {
+            return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+                TEXT("SESSION_ACTIVE"),
+                TEXT("A compile session is already open"),
+                TEXT("Commit or abort the current session first (core_session action='status' shows it)"));
+        }
+
+        FString UndoError;
+        if (!UndoPolicy.BeginSession(Params, Label, UndoError))
+        {
+            return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(TEXT("INVALID_PARAMS"), UndoError);
+        }
+        Session.Begin(Label);
+
+        TSharedPtr<FJsonObject> ResultObj = MakeShareable(new FJsonObject());
+        ResultObj->SetBoolField(TEXT("success"), true);
+        ResultObj->SetStringField(TEXT("session"), Label);
+        UndoPolicy.AddStatus(ResultObj);
+        return ResultObj;
+    }
+    else if (Action == TEXT("commit"))
+    {
+        TSharedPtr<FJsonObject> UndoSummary = MakeShared<FJsonObject>();
+        UndoPolicy.EndSession(UndoSummary);
+        TSharedPtr<FJsonObject> ResultObj = Session.Commit();
+        ResultObj->Values.Append(UndoSummary->Values);
+        return ResultObj;
+    }
+    else if (Action == TEXT("abort"))
+    {
+        // Roll the session's edits back first; the Blueprints they touched stay dirty
+        TSharedPtr<FJsonObject> UndoSummary = MakeShared<FJsonObject>();
+        UndoPolicy.AbortSession(UndoSummary);
+        TSharedPtr<FJsonObject> ResultObj = Session.Abort();
+        ResultObj->Values.Append(UndoSummary->Values);
+        return ResultObj;
+    }
+    else if (Action == TEXT("status"))
+    {
+        TSharedPtr<FJsonObject> ResultObj = Session.GetStatus();
+        UndoPolicy.AddStatus(ResultObj);
+        return ResultObj;
+    }
+
+    return FUnrealCompanionCommonUtils::CreateErrorResponse(
+        FString::Printf(TEXT("Unknown session action: '%s'. Use begin, commit, abort or status"), *Action));
+}
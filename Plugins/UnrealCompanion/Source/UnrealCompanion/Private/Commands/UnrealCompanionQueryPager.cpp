@@ -0,0 +1,238 @@
+#include "Commands/UnrealCompanionQueryPager.h"
+#include "Commands/UnrealCompanionCommonUtils.h"
+#include "Misc/Base64.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+namespace
+{
+    /** Params that only shape the page, not what matches */
+    bool IsPagingParam(const FString& Key)
+    {
+        return Key == TEXT("cursor") || Key == TEXT("max_results") || Key == TEXT("stream") || Key == TEXT("chunk_size")
+            || Key == TEXT("sort") || Key == TEXT("stream_progress") || Key == TEXT("verbosity") || Key == TEXT("request_id");
+    }
+
+    FString ToCondensedJson(const TSharedPtr<FJsonObject>& Object)
+    {
+        FString Out;
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out);
+        FJsonSerializer::Serialize(Object.ToSharedRef(), Writer);
+        return Out;
+    }
+
+    FString ToCondensedJson(const TSharedPtr<FJsonValue>& Value)
+    {
+        FString Out;
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out);
+        FJsonSerializer::Serialize(Value, FString(), Writer);
+        return Out;
+    }
+
+    /** Independent of the order the client wrote its fields in */
+    uint32 HashQueryParams(const TSharedPtr<FJsonObject>& Params)
+    {
+        TArray<FString> Keys;
+        Params->Values.GetKeys(Keys);
+        Keys.Sort();
+
+        uint32 Hash = 0;
+        for (const FString& Key : Keys)
+        {
+            if (IsPagingParam(Key))
+            {
+                continue;
+            }
+            Hash = HashCombine(Hash, FCrc::StrCrc32(*Key));
+            Hash = HashCombine(Hash, FCrc::StrCrc32(*ToCondensedJson(Params->Values[Key])));
+        }
+        return Hash;
+    }
+}
+
+bool FUnrealCompanionQueryKey::operator<(const FUnrealCompanionQueryKey& Other) const
+{
+    if (Number != Other.Number)
+    {
+        return Number < Other.Number;
+    }
+    if (const int32 TextOrder = Text.Compare(Other.Text, ESearchCase::IgnoreCase))
+    {
+        return TextOrder < 0;
+    }
+    return Id.Compare(Other.Id, ESearchCase::CaseSensitive) < 0;
+}
+
+FUnrealCompanionQueryPager::FUnrealCompanionQueryPager(const TSharedPtr<FJsonObject>& Params, const FString& DefaultSort, std::initializer_list<const TCHAR*> Sorts)
+    : Sort(DefaultSort)
+{
+    Params->TryGetStringField(TEXT("sort"), Sort);
+    Sort.ToLowerInline();
+
+    bool bKnownSort = Sort == TEXT("none");
+    FString SortNames;
+    for (const TCHAR* Candidate : Sorts)
+    {
+        bKnownSort |= Sort == Candidate;
+        SortNames += FString(Candidate) + TEXT(", ");
+    }
+    if (!bKnownSort)
+    {
+        Error = FString::Printf(TEXT("Unknown sort '%s'"), *Sort);
+        ParamsErrorHint = FString::Printf(TEXT("Valid sort values: %snone"), *SortNames);
+        return;
+    }
+
+    int32 MaxResults = DefaultPageSize;
+    if (Params->TryGetNumberField(TEXT("max_results"), MaxResults))
+    {
+        PageSize = FMath::Max(MaxResults, 0);
+    }
+
+    QueryHash = HashQueryParams(Params);
+
+    FString EncodedCursor;
+    if (Params->TryGetStringField(TEXT("cursor"), EncodedCursor) && !EncodedCursor.IsEmpty())
+    {
+        if (!IsSorted())
+        {
+            Error = TEXT("A cursor needs a sorted query (sort=\"none\" has no stable order)");
+            return;
+        }
+        if (!DecodeCursor(EncodedCursor))
+        {
+            return;
+        }
+    }
+
+    bool bStream = false;
+    Params->TryGetBoolField(TEXT("stream"), bStream);
+    if (bStream)
+    {
+        // Plain request/response clients have no sink: they get the page in the reply as usual
+        EventSink = FUnrealCompanionDeferredResponse::GetEventSink();
+        int32 RequestedChunk = DefaultChunkSize;
+        if (Params->TryGetNumberField(TEXT("chunk_size"), RequestedChunk))
+        {
+            ChunkSize = FMath::Max(RequestedChunk, 1);
+        }
+    }
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionQueryPager::CreateErrorResponse() const
+{
+    if (!ParamsErrorHint.IsEmpty())
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(TEXT("INVALID_PARAMS"), Error, ParamsErrorHint);
+    }
+    return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+        TEXT("INVALID_CURSOR"), Error,
+        TEXT("Repeat the query without cursor to start from the first page"));
+}
+
+bool FUnrealCompanionQueryPager::IsAfterCursor(const FUnrealCompanionQueryKey& Key) const
+{
+    return !Cursor.IsSet() || Cursor.GetValue() < Key;
+}
+
+void FUnrealCompanionQueryPager::Emit(const TSharedPtr<FJsonObject>& Result)
+{
+    Results.Add(MakeShared<FJsonValueObject>(Result));
+    ++Emitted;
+    if (EventSink && Results.Num() >= ChunkSize)
+    {
+        FlushChunk();
+    }
+}
+
+void FUnrealCompanionQueryPager::SetNextCursor(const FUnrealCompanionQueryKey& LastKey)
+{
+    NextCursor = EncodeCursor(LastKey);
+    bHasMore = true;
+}
+
+void FUnrealCompanionQueryPager::Finish(const TSharedPtr<FJsonObject>& ResultObj)
+{
+    if (EventSink)
+    {
+        FlushChunk();
+        ResultObj->SetBoolField(TEXT("streamed"), true);
+        ResultObj->SetNumberField(TEXT("chunks"), ChunksSent);
+    }
+    else
+    {
+        ResultObj->SetArrayField(TEXT("results"), Results);
+    }
+
+    ResultObj->SetNumberField(TEXT("count"), Emitted);
+    ResultObj->SetStringField(TEXT("sort"), Sort);
+    ResultObj->SetBoolField(TEXT("has_more"), bHasMore);
+    if (!NextCursor.IsEmpty())
+    {
+        ResultObj->SetStringField(TEXT("next_cursor"), NextCursor);
+    }
+}
+
+void FUnrealCompanionQueryPager::FlushChunk()
+{
+    if (Results.Num() == 0)
+    {
+        return;
+    }
+
+    TSharedPtr<FJsonObject> Payload = MakeShared<FJsonObject>();
+    Payload->SetNumberField(TEXT("seq"), ChunksSent++);
+    Payload->SetNumberField(TEXT("count"), Results.Num());
+    Payload->SetArrayField(TEXT("results"), Results);
+    EventSink(TEXT("query_results"), Payload);
+
+    // The payload owns the chunk now; start the next one empty
+    Results = TArray<TSharedPtr<FJsonValue>>();
+}
+
+FString FUnrealCompanionQueryPager::EncodeCursor(const FUnrealCompanionQueryKey& Key) const
+{
+    TSharedPtr<FJsonObject> CursorObj = MakeShared<FJsonObject>();
+    CursorObj->SetNumberField(TEXT("q"), QueryHash);
+    CursorObj->SetStringField(TEXT("s"), Sort);
+    CursorObj->SetNumberField(TEXT("n"), Key.Number);
+    CursorObj->SetStringField(TEXT("t"), Key.Text);
+    CursorObj->SetStringField(TEXT("i"), Key.Id);
+
+    const FTCHARToUTF8 Utf8(*ToCondensedJson(CursorObj));
+    return FBase64::Encode(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+}
+
+bool FUnrealCompanionQueryPager::DecodeCursor(const FString& Encoded)
+{
+    TArray<uint8> Bytes;
+    TSharedPtr<FJsonObject> CursorObj;
+    if (FBase64::Decode(Encoded, Bytes))
+    {
+        const FUTF8ToTCHAR Json(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+        FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(FString(Json.Length(), Json.Get())), CursorObj);
+    }
+
+    double Hash = 0.0;
+    FString CursorSort;
+    FUnrealCompanionQueryKey Key;
+    if (!CursorObj.IsValid()
+        || !CursorObj->TryGetNumberField(TEXT("q"), Hash)
+        || !CursorObj->TryGetStringField(TEXT("s"), CursorSort)
+        || !CursorObj->TryGetNumberField(TEXT("n"), Key.Number)
+        || !CursorObj->TryGetStringField(TEXT("t"), Key.Text)
+        || !CursorObj->TryGetStringField(TEXT("i"), Key.Id))
+    {
+        Error = TEXT("Malformed cursor");
+        return false;
+    }
+    if ((uint32)Hash != QueryHash || CursorSort != Sort)
+    {
+        Error = TEXT("Cursor belongs to a query with different filters or sort");
+        return false;
+    }
+
+    Cursor = MoveTemp(Key);
+    return true;
+}
@@ -0,0 +1,363 @@
+#include "Commands/UnrealCompanionResponseCache.h"
+#include "Commands/UnrealCompanionCommonUtils.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "Materials/MaterialInstance.h"
+#include "Misc/PackageName.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+FUnrealCompanionResponseCache& FUnrealCompanionResponseCache::Get()
+{
+    static FUnrealCompanionResponseCache Instance;
+    return Instance;
+}
+
+void FUnrealCompanionResponseCache::Initialize()
+{
+    check(IsInGameThread());
+    if (ObjectModifiedHandle.IsValid())
+    {
+        return;
+    }
+
+    ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FUnrealCompanionResponseCache::OnObjectChanged);
+    PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FUnrealCompanionResponseCache::OnObjectPropertyChanged);
+    PackageDirtiedHandle = UPackage::PackageMarkedDirtyEvent.AddRaw(this, &FUnrealCompanionResponseCache::OnPackageDirtied);
+    PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FUnrealCompanionResponseCache::OnPackageSaved);
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FUnrealCompanionResponseCache::OnAssetAdded);
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FUnrealCompanionResponseCache::OnAssetRemoved);
+    AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FUnrealCompanionResponseCache::OnAssetRenamed);
+
+    if (GEditor)
+    {
+        BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FUnrealCompanionResponseCache::OnBlueprintCompiled);
+    }
+}
+
+void FUnrealCompanionResponseCache::Shutdown()
+{
+    if (ObjectModifiedHandle.IsValid())
+    {
+        FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+        FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+        UPackage::PackageMarkedDirtyEvent.Remove(PackageDirtiedHandle);
+        UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+
+        // The registry module may already be gone during engine shutdown
+        if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+        {
+            AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+            AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+            AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+        }
+        if (GEditor)
+        {
+            GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+        }
+
+        ObjectModifiedHandle.Reset();
+        PropertyChangedHandle.Reset();
+        PackageDirtiedHandle.Reset();
+        PackageSavedHandle.Reset();
+        AssetAddedHandle.Reset();
+        AssetRemovedHandle.Reset();
+        AssetRenamedHandle.Reset();
+        BlueprintCompiledHandle.Reset();
+    }
+
+    FScopeLock ScopeLock(&Lock);
+    Entries.Empty();
+    Revisions.Empty();
+}
+
+bool FUnrealCompanionResponseCache::IsCacheable(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    if (!Params.IsValid())
+    {
+        return false;
+    }
+    if (CommandType == TEXT("material_get_info") || CommandType == TEXT("blueprint_get_info"))
+    {
+        return true;
+    }
+    if (CommandType == TEXT("core_get_info"))
+    {
+        // Actor info reads the level, which no asset revision describes
+        FString Type;
+        return Params->TryGetStringField(TEXT("type"), Type) && !Type.IsEmpty() && Type != TEXT("actor");
+    }
+    return false;
+}
+
+FString FUnrealCompanionResponseCache::MakeKey(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    // Independent of the order the client wrote its fields in
+    TArray<FString> Keys;
+    Params->Values.GetKeys(Keys);
+    Keys.Sort();
+
+    FString Key = CommandType;
+    for (const FString& Field : Keys)
+    {
+        if (Field == TEXT("request_id"))
+        {
+            continue;
+        }
+        Key += TEXT('\n');
+        Key += Field;
+        Key += TEXT('=');
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Key);
+        FJsonSerializer::Serialize(Params->Values[Field], FString(), Writer);
+    }
+    return Key;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionResponseCache::Find(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    const FString Key = MakeKey(CommandType, Params);
+
+    FScopeLock ScopeLock(&Lock);
+    FEntry* Entry = Entries.Find(Key);
+    bool bValid = Entry && Entry->Epoch == Epoch;
+    if (bValid)
+    {
+        for (const TPair<FName, uint64>& Package : Entry->Packages)
+        {
+            if (Revisions.FindRef(Package.Key) != Package.Value)
+            {
+                bValid = false;
+                break;
+            }
+        }
+    }
+    if (!bValid)
+    {
+        ++Misses;
+        return nullptr;
+    }
+
+    ++Hits;
+    Entry->LastUsed = FPlatformTime::Seconds();
+    return Entry->Result;
+}
+
+uint64 FUnrealCompanionResponseCache::GetGeneration() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Generation;
+}
+
+bool FUnrealCompanionResponseCache::ResolvePackages(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, TArray<FName, TInlineAllocator<4>>& OutPackages)
+{
+    FString Target;
+    if (!Params->TryGetStringField(TEXT("material_path"), Target)
+        && !Params->TryGetStringField(TEXT("path"), Target)
+        && !Params->TryGetStringField(TEXT("blueprint_name"), Target))
+    {
+        return false;
+    }
+
+    // The handler has just loaded it, so a lookup is enough
+    UObject* Object = nullptr;
+    if (Target.StartsWith(TEXT("/")))
+    {
+        FString ObjectPath = Target;
+        if (!ObjectPath.Contains(TEXT(".")))
+        {
+            ObjectPath += TEXT(".") + FPackageName::GetShortName(Target);
+        }
+        Object = FindObject<UObject>(nullptr, *ObjectPath);
+    }
+    else if (!Target.IsEmpty())
+    {
+        Object = FUnrealCompanionCommonUtils::FindBlueprint(Target);
+    }
+    if (!Object)
+    {
+        return false;
+    }
+
+    OutPackages.Add(Object->GetOutermost()->GetFName());
+
+    // An instance reports what it inherits, a Blueprint what its parents declare
+    if (const UMaterialInstance* Instance = Cast<UMaterialInstance>(Object))
+    {
+        for (const UMaterialInterface* Parent = Instance->Parent; Parent; )
+        {
+            const FName ParentPackage = Parent->GetOutermost()->GetFName();
+            if (OutPackages.Contains(ParentPackage))
+            {
+                break;
+            }
+            OutPackages.Add(ParentPackage);
+            const UMaterialInstance* ParentInstance = Cast<UMaterialInstance>(Parent);
+            Parent = ParentInstance ? ParentInstance->Parent.Get() : nullptr;
+        }
+    }
+    else if (const UBlueprint* Blueprint = Cast<UBlueprint>(Object))
+    {
+        for (const UBlueprint* Parent = UBlueprint::GetBlueprintFromClass(Blueprint->ParentClass); Parent;
+            Parent = UBlueprint::GetBlueprintFromClass(Parent->ParentClass))
+        {
+            const FName ParentPackage = Parent->GetOutermost()->GetFName();
+            if (OutPackages.Contains(ParentPackage))
+            {
+                break;
+            }
+            OutPackages.Add(ParentPackage);
+        }
+    }
+    return true;
+}
+
+void FUnrealCompanionResponseCache::Store(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonObject>& Result, uint64 ReadGeneration)
+{
+    check(IsInGameThread());
+    TArray<FName, TInlineAllocator<4>> PackageNames;
+    if (!Result.IsValid() || !ResolvePackages(CommandType, Params, PackageNames))
+    {
+        return;
+    }
+
+    FEntry Entry;
+    Entry.Result = Result;
+    Entry.LastUsed = FPlatformTime::Seconds();
+    FString Key = MakeKey(CommandType, Params);
+
+    FScopeLock ScopeLock(&Lock);
+    // Something changed mid-read (loading can dirty packages): the reply may already be stale
+    if (Generation != ReadGeneration)
+    {
+        return;
+    }
+
+    Entry.Epoch = Epoch;
+    for (const FName PackageName : PackageNames)
+    {
+        Entry.Packages.Emplace(PackageName, Revisions.FindOrAdd(PackageName, 0));
+    }
+
+    if (Entries.Num() >= MaxEntries && !Entries.Contains(Key))
+    {
+        const FString* Oldest = nullptr;
+        double OldestUse = TNumericLimits<double>::Max();
+        for (const TPair<FString, FEntry>& Existing : Entries)
+        {
+            if (Existing.Value.LastUsed < OldestUse)
+            {
+                OldestUse = Existing.Value.LastUsed;
+                Oldest = &Existing.Key;
+            }
+        }
+        if (Oldest)
+        {
+            Entries.Remove(FString(*Oldest));
+        }
+    }
+
+    Entries.Add(MoveTemp(Key), MoveTemp(Entry));
+    ++Stores;
+}
+
+void FUnrealCompanionResponseCache::Invalidate()
+{
+    BumpEpoch();
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionResponseCache::BuildReport() const
+{
+    FScopeLock ScopeLock(&Lock);
+    TSharedPtr<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetNumberField(TEXT("entries"), Entries.Num());
+    Report->SetNumberField(TEXT("hits"), (double)Hits);
+    Report->SetNumberField(TEXT("misses"), (double)Misses);
+    Report->SetNumberField(TEXT("stores"), (double)Stores);
+    const uint64 Lookups = Hits + Misses;
+    Report->SetNumberField(TEXT("hit_rate"), Lookups > 0 ? (double)Hits / (double)Lookups : 0.0);
+    return Report;
+}
+
+void FUnrealCompanionResponseCache::ResetStats()
+{
+    FScopeLock ScopeLock(&Lock);
+    Hits = 0;
+    Misses = 0;
+    Stores = 0;
+}
+
+void FUnrealCompanionResponseCache::BumpPackage(const UPackage* Package)
+{
+    if (Package)
+    {
+        BumpPackage(Package->GetFName());
+    }
+}
+
+void FUnrealCompanionResponseCache::BumpPackage(FName PackageName)
+{
+    FScopeLock ScopeLock(&Lock);
+    ++Generation;
+    if (uint64* Revision = Revisions.Find(PackageName))
+    {
+        ++*Revision;
+    }
+}
+
+void FUnrealCompanionResponseCache::BumpEpoch()
+{
+    FScopeLock ScopeLock(&Lock);
+    ++Generation;
+    ++Epoch;
+}
+
+void FUnrealCompanionResponseCache::OnObjectChanged(UObject* Object)
+{
+    if (Object)
+    {
+        BumpPackage(Object->GetOutermost());
+    }
+}
+
+void FUnrealCompanionResponseCache::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+    OnObjectChanged(Object);
+}
+
+void FUnrealCompanionResponseCache::OnPackageDirtied(UPackage* Package, bool bWasDirty)
+{
+    BumpPackage(Package);
+}
+
+void FUnrealCompanionResponseCache::OnPackageSaved(const FString& Filename, UPackage* Package, FObjectPostSaveContext Context)
+{
+    // A save can rewrite the asset (resave fixups, cooked metadata), so treat it as an edit
+    BumpPackage(Package);
+}
+
+void FUnrealCompanionResponseCache::OnAssetAdded(const FAssetData& AssetData)
+{
+    BumpEpoch();
+}
+
+void FUnrealCompanionResponseCache::OnAssetRemoved(const FAssetData& AssetData)
+{
+    BumpEpoch();
+}
+
+void FUnrealCompanionResponseCache::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    BumpEpoch();
+}
+
+void FUnrealCompanionResponseCache::OnBlueprintCompiled()
+{
+    BumpEpoch();
+}
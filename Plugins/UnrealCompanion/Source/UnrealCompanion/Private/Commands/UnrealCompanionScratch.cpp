@@ -0,0 +1,25 @@
+#include "Commands/UnrealCompanionScratch.h"
+
+thread_local int32 FUnrealCompanionScratch::Depth = 0;
+
+bool FUnrealCompanionScratch::IsActive()
+{
+    return Depth > 0;
+}
+
+FUnrealCompanionScratch::FScope::FScope()
+{
+    // A nested command's scratch stays until the outer command returns: the outer
+    // handler may grow its own containers after the nested call, and a second mark
+    // popped in between would free their new storage under them
+    if (Depth++ == 0)
+    {
+        Mark.Emplace(FMemStack::Get());
+    }
+}
+
+FUnrealCompanionScratch::FScope::~FScope()
+{
+    --Depth;
+    Mark.Reset();
+}
@@ -1,5 +1,8 @@
 #include "Commands/UnrealCompanionSplineCommands.h"
 #include "Commands/UnrealCompanionCommonUtils.h"
+#include "UnrealCompanionStats.h"
+#include "Commands/UnrealCompanionActorIndex.h"
+#include "Commands/UnrealCompanionSplineSampler.h"
 #include "Editor.h"
 #include "EngineUtils.h"
 #include "Kismet/GameplayStatics.h"
@@ -7,22 +10,30 @@
 #include "Components/SplineMeshComponent.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/StaticMeshActor.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "HAL/PlatformTime.h"
 
 FUnrealCompanionSplineCommands::FUnrealCompanionSplineCommands()
 {
 }
 
+TConstArrayView<TMCPCommandEntry<FUnrealCompanionSplineCommands>> FUnrealCompanionSplineCommands::GetCommandTable()
+{
+    static constexpr TMCPCommandEntry<FUnrealCompanionSplineCommands> Table[] = {
+        { TEXT("spline_create"), &FUnrealCompanionSplineCommands::HandleCreateSpline },
+        { TEXT("spline_scatter_meshes"), &FUnrealCompanionSplineCommands::HandleScatterMeshes },
+        { TEXT("spline_sample"), &FUnrealCompanionSplineCommands::HandleSample },
+    };
+    static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+    return Table;
+}
+
 TSharedPtr<FJsonObject> FUnrealCompanionSplineCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-    if (CommandType == TEXT("spline_create"))
+    if (TSharedPtr<FJsonObject> Result = UnrealCompanionCommandTable::Dispatch(*this, GetCommandTable(), CommandType, Params))
     {
-        return HandleCreateSpline(Params);
+        return Result;
     }
-    else if (CommandType == TEXT("spline_scatter_meshes"))
-    {
-        return HandleScatterMeshes(Params);
-    }
-
     return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown spline command: %s"), *CommandType));
 }
 
@@ -139,13 +150,6 @@ TSharedPtr<FJsonObject> FUnrealCompanionSplineCommands::HandleCreateSpline(const
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Need at least 2 valid points"));
     }
 
-    // Set spline points (clear existing if new actor)
-    SplineComp->ClearSplinePoints(false);
-    for (int32 i = 0; i < ParsedPoints.Num(); i++)
-    {
-        SplineComp->AddSplinePoint(ParsedPoints[i], ESplineCoordinateSpace::World, true);
-    }
-
     // Set spline type
     ESplinePointType::Type PointType = ESplinePointType::Curve;
     if (SplineType == TEXT("linear"))
@@ -158,12 +162,19 @@ TSharedPtr<FJsonObject> FUnrealCompanionSplineCommands::HandleCreateSpline(const
     }
     // else default "curve"
 
-    for (int32 i = 0; i < SplineComp->GetNumberOfSplinePoints(); i++)
+    // Replace the points in one go: nothing below rebuilds the spline until
+    // the single UpdateSpline at the end (points are stored in local space)
+    const FTransform& ComponentTransform = SplineComp->GetComponentTransform();
+    TArray<FSplinePoint> SplinePoints;
+    SplinePoints.Reserve(ParsedPoints.Num());
+    for (int32 i = 0; i < ParsedPoints.Num(); i++)
     {
-        SplineComp->SetSplinePointType(i, PointType, true);
+        SplinePoints.Emplace((float)i, ComponentTransform.InverseTransformPosition(ParsedPoints[i]), PointType);
     }
 
-    SplineComp->SetClosedLoop(bClosedLoop, true);
+    SplineComp->ClearSplinePoints(false);
+    SplineComp->AddPoints(SplinePoints, false);
+    SplineComp->SetClosedLoop(bClosedLoop, false);
     SplineComp->UpdateSpline();
 
     ExistingActor->PostEditChange();
@@ -184,6 +195,8 @@ TSharedPtr<FJsonObject> FUnrealCompanionSplineCommands::HandleCreateSpline(const
 
 TSharedPtr<FJsonObject> FUnrealCompanionSplineCommands::HandleScatterMeshes(const TSharedPtr<FJsonObject>& Params)
 {
+    UNREALCOMPANION_SCOPE_CYCLE_COUNTER(STAT_UnrealCompanion_SplineScatter);
+
     FString SplineName;
     if (!Params->TryGetStringField(TEXT("spline_actor"), SplineName))
     {
@@ -223,6 +236,12 @@ TSharedPtr<FJsonObject> FUnrealCompanionSplineCommands::HandleScatterMeshes(cons
     if (Params->HasField(TEXT("random_yaw")))
         bRandomYaw = Params->GetBoolField(TEXT("random_yaw"));
 
+    // "actors" (default): one StaticMeshActor per placement
+    // "instanced": one actor with a single HISM component holding every placement
+    FString Output = TEXT("actors");
+    Params->TryGetStringField(TEXT("output"), Output);
+    const bool bInstanced = Output.Equals(TEXT("instanced"), ESearchCase::IgnoreCase);
+
     // Find the spline actor
     AActor* SplineActor = FindSplineActorByName(SplineName);
     if (!SplineActor)
@@ -249,22 +268,31 @@ TSharedPtr<FJsonObject> FUnrealCompanionSplineCommands::HandleScatterMeshes(cons
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
     }
 
-    // Scatter meshes along the spline
-    float SplineLength = SplineComp->GetSplineLength();
-    int32 InstanceCount = 0;
+    // Each point draws from its own (seed, index) stream so a seed reproduces the layout
+    const int32 Seed = FUnrealCompanionCommonUtils::GetSeedFromParams(Params);
+
+    // Pass 1: sample the spline once for every placement, then place
+    const FUnrealCompanionSplineSampler Sampler(SplineComp);
+    const float SplineLength = Sampler.GetLength();
+    TArray<FUnrealCompanionSplineSampler::FSample> Samples;
+    Sampler.Sample(Sampler.MakeDistancesBySpacing(Spacing), ESplineCoordinateSpace::World, Samples);
 
-    for (float Distance = 0.0f; Distance <= SplineLength; Distance += Spacing)
+    TArray<FTransform> Placements;
+    Placements.Reserve(Samples.Num());
+    for (int32 PointIndex = 0; PointIndex < Samples.Num(); PointIndex++)
     {
-        FVector Location = SplineComp->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
-        FRotator SplineRotation = SplineComp->GetRotationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
+        FRandomStream Random = FUnrealCompanionCommonUtils::MakeIndexedRandomStream(Seed, PointIndex);
+
+        FVector Location = Samples[PointIndex].Location;
+        FRotator SplineRotation = Samples[PointIndex].Rotation.Rotator();
 
         // Apply random offset perpendicular to spline
         if (RandomOffset > 0.0f)
         {
             FVector Right = SplineRotation.RotateVector(FVector::RightVector);
             FVector Up = FVector::UpVector;
-            float OffsetR = FMath::FRandRange(-RandomOffset, RandomOffset);
-            float OffsetU = FMath::FRandRange(-RandomOffset * 0.2f, RandomOffset * 0.2f);
+            float OffsetR = Random.FRandRange(-RandomOffset, RandomOffset);
+            float OffsetU = Random.FRandRange(-RandomOffset * 0.2f, RandomOffset * 0.2f);
             Location += Right * OffsetR + Up * OffsetU;
         }
 
@@ -272,26 +300,62 @@ TSharedPtr<FJsonObject> FUnrealCompanionSplineCommands::HandleScatterMeshes(cons
         FRotator FinalRotation = bAlignToSpline ? SplineRotation : FRotator::ZeroRotator;
         if (bRandomYaw)
         {
-            FinalRotation.Yaw += FMath::FRandRange(0.0f, 360.0f);
+            FinalRotation.Yaw += Random.FRandRange(0.0f, 360.0f);
         }
 
         // Scale
-        float RandomScale = FMath::FRandRange(ScaleMin, ScaleMax);
-        FVector FinalScale(RandomScale);
+        float RandomScale = Random.FRandRange(ScaleMin, ScaleMax);
+        Placements.Emplace(FinalRotation, Location, FVector(RandomScale));
+    }
 
-        // Spawn a static mesh actor
+    // Pass 2: write the placements out
+    const FName FolderPath(*FString::Printf(TEXT("SplineScatter_%s"), *SplineName));
+    int32 InstanceCount = 0;
+    FString OutputActorName;
+
+    if (bInstanced)
+    {
+        // One actor, one HISM component holding every placement
         FActorSpawnParameters SpawnParams;
         SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        AActor* ScatterActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+        if (!ScatterActor)
+        {
+            return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to spawn scatter actor"));
+        }
 
-        AStaticMeshActor* MeshActor = World->SpawnActor<AStaticMeshActor>(
-            AStaticMeshActor::StaticClass(), Location, FinalRotation, SpawnParams);
-
-        if (MeshActor)
+        UHierarchicalInstancedStaticMeshComponent* HISM = NewObject<UHierarchicalInstancedStaticMeshComponent>(
+            ScatterActor, TEXT("ScatterInstances"), RF_Transactional);
+        HISM->SetStaticMesh(Mesh);
+        HISM->SetMobility(EComponentMobility::Static);
+        ScatterActor->SetRootComponent(HISM);
+        ScatterActor->AddInstanceComponent(HISM);
+        HISM->RegisterComponent();
+        HISM->AddInstances(Placements, false, true);
+
+        ScatterActor->SetActorLabel(FString::Printf(TEXT("SplineScatter_%s"), *SplineName));
+        ScatterActor->SetFolderPath(FolderPath);
+        OutputActorName = ScatterActor->GetActorLabel();
+        InstanceCount = HISM->GetInstanceCount();
+    }
+    else
+    {
+        for (const FTransform& Placement : Placements)
         {
-            MeshActor->GetStaticMeshComponent()->SetStaticMesh(Mesh);
-            MeshActor->SetActorScale3D(FinalScale);
-            MeshActor->SetFolderPath(FName(*FString::Printf(TEXT("SplineScatter_%s"), *SplineName)));
-            InstanceCount++;
+            // Spawn a static mesh actor
+            FActorSpawnParameters SpawnParams;
+            SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+            AStaticMeshActor* MeshActor = World->SpawnActor<AStaticMeshActor>(
+                AStaticMeshActor::StaticClass(), Placement.GetLocation(), Placement.Rotator(), SpawnParams);
+
+            if (MeshActor)
+            {
+                MeshActor->GetStaticMeshComponent()->SetStaticMesh(Mesh);
+                MeshActor->SetActorScale3D(Placement.GetScale3D());
+                MeshActor->SetFolderPath(FolderPath);
+                InstanceCount++;
+            }
         }
     }
 
@@ -299,10 +363,134 @@ TSharedPtr<FJsonObject> FUnrealCompanionSplineCommands::HandleScatterMeshes(cons
     ResultObj->SetBoolField(TEXT("success"), true);
     ResultObj->SetNumberField(TEXT("instances_placed"), InstanceCount);
     ResultObj->SetNumberField(TEXT("spline_length"), SplineLength);
+    ResultObj->SetNumberField(TEXT("seed"), Seed);
+    ResultObj->SetStringField(TEXT("output"), bInstanced ? TEXT("instanced") : TEXT("actors"));
+    if (bInstanced)
+    {
+        ResultObj->SetStringField(TEXT("actor_name"), OutputActorName);
+    }
     ResultObj->SetStringField(TEXT("mesh"), MeshPath);
     return ResultObj;
 }
 
+// =============================================================================
+// SPLINE SAMPLE
+// =============================================================================
+
+TSharedPtr<FJsonObject> FUnrealCompanionSplineCommands::HandleSample(const TSharedPtr<FJsonObject>& Params)
+{
+    UNREALCOMPANION_SCOPE_CYCLE_COUNTER(STAT_UnrealCompanion_SplineScatter);
+
+    FString SplineName;
+    if (!Params->TryGetStringField(TEXT("spline_actor"), SplineName))
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing 'spline_actor' parameter"));
+    }
+
+    AActor* SplineActor = FindSplineActorByName(SplineName);
+    USplineComponent* SplineComp = GetSplineComponent(SplineActor);
+    if (!SplineComp)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Spline actor not found: %s"), *SplineName));
+    }
+
+    FString Space = TEXT("world");
+    Params->TryGetStringField(TEXT("space"), Space);
+    const ESplineCoordinateSpace::Type CoordinateSpace = Space.Equals(TEXT("local"), ESearchCase::IgnoreCase)
+        ? ESplineCoordinateSpace::Local : ESplineCoordinateSpace::World;
+
+    bool bIncludeTangent = false;
+    bool bIncludeScale = false;
+    const TArray<TSharedPtr<FJsonValue>>* IncludeArray = nullptr;
+    if (Params->TryGetArrayField(TEXT("include"), IncludeArray))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *IncludeArray)
+        {
+            bIncludeTangent |= Value->AsString().Equals(TEXT("tangent"), ESearchCase::IgnoreCase);
+            bIncludeScale |= Value->AsString().Equals(TEXT("scale"), ESearchCase::IgnoreCase);
+        }
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    const FUnrealCompanionSplineSampler Sampler(SplineComp);
+
+    // Sample positions: explicit distances, else count, else spacing
+    TArray<double> Distances;
+    const TArray<TSharedPtr<FJsonValue>>* DistanceArray = nullptr;
+    int32 Count = 0;
+    if (Params->TryGetArrayField(TEXT("distances"), DistanceArray))
+    {
+        Distances.Reserve(DistanceArray->Num());
+        for (const TSharedPtr<FJsonValue>& Value : *DistanceArray)
+        {
+            Distances.Add(Value->AsNumber());
+        }
+    }
+    else if (Params->TryGetNumberField(TEXT("count"), Count))
+    {
+        Distances = Sampler.MakeDistancesByCount(FMath::Min(Count, MaxSamples));
+    }
+    else
+    {
+        double Spacing = 100.0;
+        Params->TryGetNumberField(TEXT("spacing"), Spacing);
+        // Keep the sample count bounded however small the spacing
+        Spacing = FMath::Max3(Spacing, 1.0, Sampler.GetLength() / (MaxSamples - 1));
+        Distances = Sampler.MakeDistancesBySpacing(Spacing);
+    }
+
+    if (Distances.Num() > MaxSamples)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+            TEXT("TOO_MANY_SAMPLES"),
+            FString::Printf(TEXT("%d samples requested, at most %d per call"), Distances.Num(), MaxSamples));
+    }
+
+    TArray<FUnrealCompanionSplineSampler::FSample> Samples;
+    Sampler.Sample(Distances, CoordinateSpace, Samples);
+    const double SampleMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    auto VectorToJson = [](const FVector& Vector)
+    {
+        TArray<TSharedPtr<FJsonValue>> Array;
+        Array.Add(MakeShared<FJsonValueNumber>(Vector.X));
+        Array.Add(MakeShared<FJsonValueNumber>(Vector.Y));
+        Array.Add(MakeShared<FJsonValueNumber>(Vector.Z));
+        return Array;
+    };
+
+    TArray<TSharedPtr<FJsonValue>> SampleArray;
+    SampleArray.Reserve(Samples.Num());
+    for (const FUnrealCompanionSplineSampler::FSample& Sample : Samples)
+    {
+        const FRotator Rotation = Sample.Rotation.Rotator();
+        TSharedPtr<FJsonObject> SampleObj = MakeShared<FJsonObject>();
+        SampleObj->SetNumberField(TEXT("distance"), Sample.Distance);
+        SampleObj->SetNumberField(TEXT("key"), Sample.InputKey);
+        SampleObj->SetArrayField(TEXT("location"), VectorToJson(Sample.Location));
+        SampleObj->SetArrayField(TEXT("rotation"), VectorToJson(FVector(Rotation.Pitch, Rotation.Yaw, Rotation.Roll)));
+        if (bIncludeTangent)
+        {
+            SampleObj->SetArrayField(TEXT("tangent"), VectorToJson(Sample.Tangent));
+        }
+        if (bIncludeScale)
+        {
+            SampleObj->SetArrayField(TEXT("scale"), VectorToJson(Sample.Scale));
+        }
+        SampleArray.Add(MakeShared<FJsonValueObject>(SampleObj));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetBoolField(TEXT("success"), true);
+    ResultObj->SetStringField(TEXT("spline_actor"), SplineName);
+    ResultObj->SetNumberField(TEXT("spline_length"), Sampler.GetLength());
+    ResultObj->SetStringField(TEXT("space"), CoordinateSpace == ESplineCoordinateSpace::Local ? TEXT("local") : TEXT("world"));
+    ResultObj->SetNumberField(TEXT("sample_count"), Samples.Num());
+    ResultObj->SetNumberField(TEXT("sample_ms"), SampleMs);
+    ResultObj->SetArrayField(TEXT("samples"), SampleArray);
+    return ResultObj;
+}
+
 // =============================================================================
 // UTILITY
 // =============================================================================
@@ -312,12 +500,13 @@ AActor* FUnrealCompanionSplineCommands::FindSplineActorByName(const FString& Act
     UWorld* World = GEditor->GetEditorWorldContext().World();
     if (!World) return nullptr;
 
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), AllActors);
+    // Only the actors sharing this name or label, not the whole world
+    TArray<AActor*> Candidates;
+    FUnrealCompanionActorIndex::Get().FindAllByName(World, ActorName, Candidates);
 
-    for (AActor* Actor : AllActors)
+    for (AActor* Actor : Candidates)
     {
-        if (Actor && (Actor->GetName() == ActorName || Actor->GetActorLabel() == ActorName))
+        if (Actor->GetName() == ActorName || Actor->GetActorLabel() == ActorName)
         {
             if (GetSplineComponent(Actor))
             {
@@ -0,0 +1,129 @@
+#include "Commands/UnrealCompanionSplineSampler.h"
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+
+FUnrealCompanionSplineSampler::FUnrealCompanionSplineSampler(const USplineComponent* Spline)
+{
+    check(IsInGameThread());
+    if (Spline)
+    {
+        Curves = Spline->SplineCurves;
+        ComponentTransform = Spline->GetComponentTransform();
+        DefaultUpVector = Spline->DefaultUpVector;
+        Length = Spline->GetSplineLength();
+    }
+}
+
+TArray<double> FUnrealCompanionSplineSampler::MakeDistancesBySpacing(double Spacing) const
+{
+    TArray<double> Distances;
+    if (Spacing <= 0.0)
+    {
+        return Distances;
+    }
+
+    const int32 Count = FMath::FloorToInt(Length / Spacing) + 1;
+    Distances.Reserve(Count);
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        Distances.Add(Index * Spacing);
+    }
+    return Distances;
+}
+
+TArray<double> FUnrealCompanionSplineSampler::MakeDistancesByCount(int32 Count) const
+{
+    TArray<double> Distances;
+    if (Count <= 0)
+    {
+        return Distances;
+    }
+
+    Distances.Reserve(Count);
+    if (Count == 1)
+    {
+        Distances.Add(0.0);
+        return Distances;
+    }
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        Distances.Add(Length * Index / (Count - 1));
+    }
+    return Distances;
+}
+
+float FUnrealCompanionSplineSampler::GetKeyAtDistance(double Distance, int32& InOutSegment) const
+{
+    // ReparamTable is linear: InVal is the distance, OutVal the input key
+    const TArray<FInterpCurvePoint<float>>& Points = Curves.ReparamTable.Points;
+    if (Points.Num() == 0)
+    {
+        return 0.0f;
+    }
+    if (Points.Num() == 1)
+    {
+        return Points[0].OutVal;
+    }
+
+    const int32 LastSegment = Points.Num() - 2;
+    if (InOutSegment < 0 || InOutSegment > LastSegment || Distance < Points[InOutSegment].InVal)
+    {
+        // Out of order: find the segment again
+        InOutSegment = FMath::Clamp(
+            Algo::UpperBoundBy(Points, (float)Distance, &FInterpCurvePoint<float>::InVal) - 1, 0, LastSegment);
+    }
+    while (InOutSegment < LastSegment && Points[InOutSegment + 1].InVal < Distance)
+    {
+        ++InOutSegment;
+    }
+
+    const FInterpCurvePoint<float>& Start = Points[InOutSegment];
+    const FInterpCurvePoint<float>& End = Points[InOutSegment + 1];
+    const float Span = End.InVal - Start.InVal;
+    const float Alpha = Span > UE_SMALL_NUMBER ? FMath::Clamp((float)(Distance - Start.InVal) / Span, 0.0f, 1.0f) : 0.0f;
+    return FMath::Lerp(Start.OutVal, End.OutVal, Alpha);
+}
+
+void FUnrealCompanionSplineSampler::Sample(TConstArrayView<double> Distances, ESplineCoordinateSpace::Type Space, TArray<FSample>& OutSamples) const
+{
+    OutSamples.SetNum(Distances.Num());
+
+    // Pass 1: distance -> key, one sweep over the table
+    int32 Segment = 0;
+    for (int32 Index = 0; Index < Distances.Num(); ++Index)
+    {
+        FSample& Sample = OutSamples[Index];
+        Sample.Distance = FMath::Clamp(Distances[Index], 0.0, Length);
+        Sample.InputKey = GetKeyAtDistance(Sample.Distance, Segment);
+    }
+
+    // Pass 2: evaluate the curves the way USplineComponent does, each sample on its own
+    const bool bWorld = Space == ESplineCoordinateSpace::World;
+    const EParallelForFlags Flags = Distances.Num() < MinParallelSamples ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+    ParallelFor(OutSamples.Num(), [this, &OutSamples, bWorld](int32 Index)
+    {
+        FSample& Sample = OutSamples[Index];
+        const float Key = Sample.InputKey;
+
+        FQuat KeyRotation = Curves.Rotation.Eval(Key, FQuat::Identity);
+        KeyRotation.Normalize();
+        const FVector Location = Curves.Position.Eval(Key, FVector::ZeroVector);
+        const FVector Tangent = Curves.Position.EvalDerivative(Key, FVector::ZeroVector);
+        const FVector Up = KeyRotation.RotateVector(DefaultUpVector);
+        const FQuat Rotation = FRotationMatrix::MakeFromXZ(Tangent.GetSafeNormal(), Up).ToQuat();
+
+        Sample.Scale = Curves.Scale.Eval(Key, FVector::OneVector);
+        if (bWorld)
+        {
+            Sample.Location = ComponentTransform.TransformPosition(Location);
+            Sample.Tangent = ComponentTransform.TransformVector(Tangent);
+            Sample.Rotation = ComponentTransform.GetRotation() * Rotation;
+        }
+        else
+        {
+            Sample.Location = Location;
+            Sample.Tangent = Tangent;
+            Sample.Rotation = Rotation;
+        }
+    }, Flags);
+}
@@ -2,6 +2,8 @@
 
 #include "Commands/UnrealCompanionUMGCommands.h"
 #include "Commands/UnrealCompanionCommonUtils.h"
+#include "Commands/UnrealCompanionCompileSession.h"
+#include "UnrealCompanionStats.h"
 #include "Editor.h"
 #include "EditorAssetLibrary.h"
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -51,47 +53,111 @@ FUnrealCompanionUMGCommands::FUnrealCompanionUMGCommands()
 {
 }
 
-// ============================================================================
-// COMMAND DISPATCH
-// ============================================================================
-
-TSharedPtr<FJsonObject> FUnrealCompanionUMGCommands::HandleCommand(const FString& CommandName, const TSharedPtr<FJsonObject>& Params)
+FUnrealCompanionUMGCommands::~FUnrealCompanionUMGCommands()
 {
-    // New unified commands
-    if (CommandName == TEXT("widget_create"))
+    if (CompileTickerHandle.IsValid())
     {
-        return HandleWidgetCreate(Params);
+        FTSTicker::GetCoreTicker().RemoveTicker(CompileTickerHandle);
     }
-    else if (CommandName == TEXT("widget_batch"))
+}
+
+void FUnrealCompanionUMGCommands::Shutdown()
+{
+    if (CompileTickerHandle.IsValid())
     {
-        return HandleWidgetBatch(Params);
+        FTSTicker::GetCoreTicker().RemoveTicker(CompileTickerHandle);
+        CompileTickerHandle.Reset();
     }
-    else if (CommandName == TEXT("widget_get_info"))
+    TickCompileQueue(0.0f);
+}
+
+// ============================================================================
+// COMPILE QUEUE
+// ============================================================================
+
+void FUnrealCompanionUMGCommands::CompileWidgetBlueprint(UWidgetBlueprint* WidgetBP)
+{
+    PendingCompile.Remove(WidgetBP);
+    if (!FUnrealCompanionCompileSession::Get().DeferCompile(WidgetBP))
     {
-        return HandleWidgetGetInfo(Params);
+        UNREALCOMPANION_SCOPE_CYCLE_COUNTER(STAT_UnrealCompanion_Compile);
+        FKismetEditorUtilities::CompileBlueprint(WidgetBP);
     }
-    else if (CommandName == TEXT("widget_add_to_viewport"))
+}
+
+void FUnrealCompanionUMGCommands::QueueCompile(UWidgetBlueprint* WidgetBP)
+{
+    check(IsInGameThread());
+
+    // An open session already holds every compile until commit
+    if (FUnrealCompanionCompileSession::Get().DeferCompile(WidgetBP))
     {
-        return HandleAddWidgetToViewport(Params);
+        return;
     }
-    // Legacy commands (backwards compatibility)
-    else if (CommandName == TEXT("widget_add_text_block"))
+
+    PendingCompile.AddUnique(WidgetBP);
+    if (!CompileTickerHandle.IsValid())
     {
-        return HandleAddTextBlockToWidget(Params);
+        CompileTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateRaw(this, &FUnrealCompanionUMGCommands::TickCompileQueue));
     }
-    else if (CommandName == TEXT("widget_add_button"))
+}
+
+void FUnrealCompanionUMGCommands::FlushCompile(UWidgetBlueprint* WidgetBP)
+{
+    if (PendingCompile.Contains(WidgetBP))
     {
-        return HandleAddButtonToWidget(Params);
+        CompileWidgetBlueprint(WidgetBP);
     }
-    else if (CommandName == TEXT("widget_bind_event"))
+}
+
+bool FUnrealCompanionUMGCommands::TickCompileQueue(float DeltaTime)
+{
+    // Every command handled since the last tick has queued its edits by now
+    TArray<TWeakObjectPtr<UWidgetBlueprint>> ToCompile = MoveTemp(PendingCompile);
+    PendingCompile.Reset();
+    for (const TWeakObjectPtr<UWidgetBlueprint>& Weak : ToCompile)
     {
-        return HandleBindWidgetEvent(Params);
+        if (UWidgetBlueprint* WidgetBP = Weak.Get())
+        {
+            CompileWidgetBlueprint(WidgetBP);
+        }
     }
-    else if (CommandName == TEXT("widget_set_text_binding"))
+    if (ToCompile.Num() > 0)
     {
-        return HandleSetTextBlockBinding(Params);
+        UE_LOG(LogUnrealCompanionUMG, Verbose, TEXT("Compiled %d queued Widget Blueprints"), ToCompile.Num());
     }
 
+    CompileTickerHandle.Reset();
+    return false;
+}
+
+// ============================================================================
+// COMMAND DISPATCH
+// ============================================================================
+
+TConstArrayView<TMCPCommandEntry<FUnrealCompanionUMGCommands>> FUnrealCompanionUMGCommands::GetCommandTable()
+{
+    static constexpr TMCPCommandEntry<FUnrealCompanionUMGCommands> Table[] = {
+        { TEXT("widget_create"), &FUnrealCompanionUMGCommands::HandleWidgetCreate },
+        { TEXT("widget_batch"), &FUnrealCompanionUMGCommands::HandleWidgetBatch },
+        { TEXT("widget_get_info"), &FUnrealCompanionUMGCommands::HandleWidgetGetInfo },
+        { TEXT("widget_add_to_viewport"), &FUnrealCompanionUMGCommands::HandleAddWidgetToViewport },
+        { TEXT("widget_add_text_block"), &FUnrealCompanionUMGCommands::HandleAddTextBlockToWidget },
+        { TEXT("widget_add_button"), &FUnrealCompanionUMGCommands::HandleAddButtonToWidget },
+        { TEXT("widget_bind_event"), &FUnrealCompanionUMGCommands::HandleBindWidgetEvent },
+        { TEXT("widget_set_text_binding"), &FUnrealCompanionUMGCommands::HandleSetTextBlockBinding },
+    };
+    static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+    return Table;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionUMGCommands::HandleCommand(const FString& CommandName, const TSharedPtr<FJsonObject>& Params)
+{
+    if (TSharedPtr<FJsonObject> Result = UnrealCompanionCommandTable::Dispatch(*this, GetCommandTable(), CommandName, Params))
+    {
+        return Result;
+    }
     return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown widget command: %s"), *CommandName));
 }
 
@@ -1160,10 +1226,12 @@ TSharedPtr<FJsonObject> FUnrealCompanionUMGCommands::HandleWidgetBatch(const TSh
     bool bDryRun = false;
     Params->TryGetBoolField(TEXT("dry_run"), bDryRun);
 
+    bool bDeferCompile = false;
+    Params->TryGetBoolField(TEXT("defer_compile"), bDeferCompile);
+
     // Results tracking
     TArray<TSharedPtr<FJsonValue>> ResultsArray;
     TArray<TSharedPtr<FJsonValue>> ErrorsArray;
-    TMap<FString, UWidget*> RefToWidget;
     int32 AddedCount = 0;
     int32 ModifiedCount = 0;
     int32 RemovedCount = 0;
@@ -1219,11 +1287,46 @@ TSharedPtr<FJsonObject> FUnrealCompanionUMGCommands::HandleWidgetBatch(const TSh
     // =========================================================================
     // PHASE 2: Add widgets
     // =========================================================================
+    // Widgets are constructed first and parented second, so a parent_ref may
+    // point at a widget that appears later in the array. Names are indexed once
+    // instead of walking the tree for every lookup.
+    TMap<FName, UWidget*> WidgetsByName;
+    WidgetBP->WidgetTree->ForEachWidget([&WidgetsByName](UWidget* Widget)
+    {
+        WidgetsByName.Add(Widget->GetFName(), Widget);
+    });
+
     if (Params->HasField(TEXT("widgets")))
     {
         const TArray<TSharedPtr<FJsonValue>>* WidgetsArray;
         if (Params->TryGetArrayField(TEXT("widgets"), WidgetsArray))
         {
+            enum class EAddState : uint8 { Created, Attaching, Attached, Failed };
+
+            struct FPendingWidget
+            {
+                TSharedPtr<FJsonObject> Def;
+                FString Ref;
+                FString Name;
+                FString Type;
+                UWidget* Widget = nullptr;
+                EAddState State = EAddState::Created;
+            };
+
+            TArray<FPendingWidget> PendingWidgets;
+            TMap<FString, int32> RefToPending;
+            TMap<FName, int32> NameToPending;
+
+            auto AddError = [&ErrorsArray](const FString& Ref, const FString& Error)
+            {
+                TSharedPtr<FJsonObject> ErrorObj = MakeShared<FJsonObject>();
+                ErrorObj->SetStringField(TEXT("operation"), TEXT("add"));
+                ErrorObj->SetStringField(TEXT("ref"), Ref);
+                ErrorObj->SetStringField(TEXT("error"), Error);
+                ErrorsArray.Add(MakeShared<FJsonValueObject>(ErrorObj));
+            };
+
+            // Pass 1: construct every widget
             for (const TSharedPtr<FJsonValue>& WidgetVal : *WidgetsArray)
             {
                 const TSharedPtr<FJsonObject>* WidgetObj;
@@ -1232,132 +1335,180 @@ TSharedPtr<FJsonObject> FUnrealCompanionUMGCommands::HandleWidgetBatch(const TSh
                     continue;
                 }
 
-                FString Ref;
-                (*WidgetObj)->TryGetStringField(TEXT("ref"), Ref);
-                
-                FString Type;
-                if (!(*WidgetObj)->TryGetStringField(TEXT("type"), Type))
+                FPendingWidget Entry;
+                Entry.Def = *WidgetObj;
+                Entry.Def->TryGetStringField(TEXT("ref"), Entry.Ref);
+
+                if (!Entry.Def->TryGetStringField(TEXT("type"), Entry.Type))
                 {
-                    TSharedPtr<FJsonObject> ErrorObj = MakeShared<FJsonObject>();
-                    ErrorObj->SetStringField(TEXT("operation"), TEXT("add"));
-                    ErrorObj->SetStringField(TEXT("ref"), Ref);
-                    ErrorObj->SetStringField(TEXT("error"), TEXT("Missing 'type'"));
-                    ErrorsArray.Add(MakeShared<FJsonValueObject>(ErrorObj));
+                    AddError(Entry.Ref, TEXT("Missing 'type'"));
                     if (OnError == TEXT("stop")) break;
                     continue;
                 }
 
-                FString ChildName = Ref;
-                (*WidgetObj)->TryGetStringField(TEXT("name"), ChildName);
-                if (ChildName.IsEmpty()) ChildName = Ref;
+                Entry.Name = Entry.Ref;
+                Entry.Def->TryGetStringField(TEXT("name"), Entry.Name);
+                if (Entry.Name.IsEmpty()) Entry.Name = Entry.Ref;
 
-                // Create widget
-                UWidget* NewWidget = nullptr;
                 if (!bDryRun)
                 {
-                    NewWidget = CreateWidget(WidgetBP, Type, ChildName);
-                    if (!NewWidget)
+                    Entry.Widget = CreateWidget(WidgetBP, Entry.Type, Entry.Name);
+                    if (!Entry.Widget)
                     {
-                        TSharedPtr<FJsonObject> ErrorObj = MakeShared<FJsonObject>();
-                        ErrorObj->SetStringField(TEXT("operation"), TEXT("add"));
-                        ErrorObj->SetStringField(TEXT("ref"), Ref);
-                        ErrorObj->SetStringField(TEXT("error"), FString::Printf(TEXT("Failed to create widget of type '%s'"), *Type));
-                        ErrorsArray.Add(MakeShared<FJsonValueObject>(ErrorObj));
+                        AddError(Entry.Ref, FString::Printf(TEXT("Failed to create widget of type '%s'"), *Entry.Type));
                         if (OnError == TEXT("stop")) break;
                         continue;
                     }
-                    
-                    if (!Ref.IsEmpty())
+
+                    // Widget properties don't depend on the parent
+                    const TSharedPtr<FJsonObject>* PropsObj;
+                    if (Entry.Def->TryGetObjectField(TEXT("properties"), PropsObj))
+                    {
+                        FString PropsError;
+                        ApplyWidgetProperties(Entry.Widget, *PropsObj, PropsError);
+                    }
+
+                    if (Entry.Def->HasField(TEXT("is_variable")))
                     {
-                        RefToWidget.Add(Ref, NewWidget);
+                        Entry.Widget->bIsVariable = Entry.Def->GetBoolField(TEXT("is_variable"));
                     }
                 }
 
-                // Find parent
+                const int32 Index = PendingWidgets.Add(MoveTemp(Entry));
+                const FPendingWidget& Added = PendingWidgets[Index];
+                if (!Added.Ref.IsEmpty())
+                {
+                    RefToPending.Add(Added.Ref, Index);
+                }
+                NameToPending.Add(Added.Widget ? Added.Widget->GetFName() : FName(*Added.Name), Index);
+            }
+
+            // Pass 2: parent them, parents before children
+            TFunction<bool(int32)> Attach = [&](int32 Index) -> bool
+            {
+                FPendingWidget& Entry = PendingWidgets[Index];
+                if (Entry.State != EAddState::Created)
+                {
+                    return Entry.State == EAddState::Attached;
+                }
+                Entry.State = EAddState::Attaching;
+
                 FString ParentName;
-                (*WidgetObj)->TryGetStringField(TEXT("parent"), ParentName);
-                
+                Entry.Def->TryGetStringField(TEXT("parent"), ParentName);
                 FString ParentRef;
-                (*WidgetObj)->TryGetStringField(TEXT("parent_ref"), ParentRef);
+                Entry.Def->TryGetStringField(TEXT("parent_ref"), ParentRef);
 
-                UPanelWidget* ParentWidget = nullptr;
-                if (!bDryRun)
+                // Parent from this batch, or an existing widget
+                int32 ParentIndex = INDEX_NONE;
+                UWidget* ParentCandidate = nullptr;
+                FString Error;
+                if (!ParentRef.IsEmpty())
                 {
-                    if (!ParentRef.IsEmpty())
+                    if (const int32* Found = RefToPending.Find(ParentRef))
                     {
-                        if (UWidget** FoundWidget = RefToWidget.Find(ParentRef))
-                        {
-                            ParentWidget = Cast<UPanelWidget>(*FoundWidget);
-                        }
+                        ParentIndex = *Found;
+                    }
+                    else
+                    {
+                        Error = FString::Printf(TEXT("parent_ref '%s' is not a widget of this batch"), *ParentRef);
+                    }
+                }
+                else if (!ParentName.IsEmpty())
+                {
+                    if (const int32* Found = NameToPending.Find(FName(*ParentName)))
+                    {
+                        ParentIndex = *Found;
                     }
-                    else if (!ParentName.IsEmpty())
+                    else if (UWidget** Existing = WidgetsByName.Find(FName(*ParentName)))
                     {
-                        UWidget* FoundWidget = WidgetBP->WidgetTree->FindWidget(FName(*ParentName));
-                        ParentWidget = Cast<UPanelWidget>(FoundWidget);
+                        ParentCandidate = *Existing;
                     }
                     else
                     {
-                        // Default to root
-                        ParentWidget = Cast<UPanelWidget>(WidgetBP->WidgetTree->RootWidget);
+                        Error = FString::Printf(TEXT("Parent widget '%s' not found"), *ParentName);
                     }
+                }
+                else
+                {
+                    // Default to root
+                    ParentCandidate = WidgetBP->WidgetTree->RootWidget;
+                }
 
-                    if (!ParentWidget)
+                if (ParentIndex != INDEX_NONE && PendingWidgets[ParentIndex].State == EAddState::Attaching)
+                {
+                    Error = TEXT("Parent cycle in batch");
+                }
+                else if (ParentIndex != INDEX_NONE)
+                {
+                    if (!Attach(ParentIndex))
                     {
-                        TSharedPtr<FJsonObject> ErrorObj = MakeShared<FJsonObject>();
-                        ErrorObj->SetStringField(TEXT("operation"), TEXT("add"));
-                        ErrorObj->SetStringField(TEXT("ref"), Ref);
-                        ErrorObj->SetStringField(TEXT("error"), TEXT("Parent widget not found or not a panel"));
-                        ErrorsArray.Add(MakeShared<FJsonValueObject>(ErrorObj));
-                        
-                        // Cleanup
-                        WidgetBP->WidgetTree->RemoveWidget(NewWidget);
-                        
-                        if (OnError == TEXT("stop")) break;
-                        continue;
+                        Error = FString::Printf(TEXT("Parent '%s' could not be added"), *PendingWidgets[ParentIndex].Name);
                     }
+                    ParentCandidate = PendingWidgets[ParentIndex].Widget;
+                }
 
-                    // Add to parent
-                    ParentWidget->AddChild(NewWidget);
+                UPanelWidget* ParentWidget = Cast<UPanelWidget>(ParentCandidate);
+                if (Error.IsEmpty() && !bDryRun && !ParentWidget)
+                {
+                    Error = TEXT("Parent widget not found or not a panel");
                 }
 
-                // Apply slot properties
-                if (!bDryRun && (*WidgetObj)->HasField(TEXT("slot")))
+                if (!Error.IsEmpty())
                 {
-                    const TSharedPtr<FJsonObject>* SlotObj;
-                    if ((*WidgetObj)->TryGetObjectField(TEXT("slot"), SlotObj))
+                    AddError(Entry.Ref, Error);
+                    if (Entry.Widget)
                     {
-                        FString SlotError;
-                        ApplySlotProperties(NewWidget, ParentWidget, *SlotObj, SlotError);
+                        WidgetBP->WidgetTree->RemoveWidget(Entry.Widget);
                     }
+                    Entry.State = EAddState::Failed;
+                    return false;
                 }
 
-                // Apply widget properties
-                if (!bDryRun && (*WidgetObj)->HasField(TEXT("properties")))
+                if (!bDryRun)
                 {
-                    const TSharedPtr<FJsonObject>* PropsObj;
-                    if ((*WidgetObj)->TryGetObjectField(TEXT("properties"), PropsObj))
+                    ParentWidget->AddChild(Entry.Widget);
+
+                    const TSharedPtr<FJsonObject>* SlotObj;
+                    if (Entry.Def->TryGetObjectField(TEXT("slot"), SlotObj))
                     {
-                        FString PropsError;
-                        ApplyWidgetProperties(NewWidget, *PropsObj, PropsError);
+                        FString SlotError;
+                        ApplySlotProperties(Entry.Widget, ParentWidget, *SlotObj, SlotError);
                     }
+                    WidgetsByName.Add(Entry.Widget->GetFName(), Entry.Widget);
                 }
+                Entry.State = EAddState::Attached;
+                return true;
+            };
 
-                // Mark as variable if requested
-                if (!bDryRun && (*WidgetObj)->HasField(TEXT("is_variable")))
+            for (int32 Index = 0; Index < PendingWidgets.Num(); ++Index)
+            {
+                if (!Attach(Index) && OnError == TEXT("stop"))
                 {
-                    NewWidget->bIsVariable = (*WidgetObj)->GetBoolField(TEXT("is_variable"));
+                    break;
                 }
+            }
 
-                AddedCount++;
-                
-                TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-                ResultObj->SetStringField(TEXT("operation"), TEXT("add"));
-                ResultObj->SetStringField(TEXT("ref"), Ref);
-                ResultObj->SetStringField(TEXT("name"), ChildName);
-                ResultObj->SetStringField(TEXT("type"), Type);
-                ResultObj->SetBoolField(TEXT("success"), true);
-                ResultsArray.Add(MakeShared<FJsonValueObject>(ResultObj));
+            for (FPendingWidget& Entry : PendingWidgets)
+            {
+                if (Entry.State == EAddState::Attached)
+                {
+                    AddedCount++;
+
+                    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+                    ResultObj->SetStringField(TEXT("operation"), TEXT("add"));
+                    ResultObj->SetStringField(TEXT("ref"), Entry.Ref);
+                    ResultObj->SetStringField(TEXT("name"), Entry.Widget ? Entry.Widget->GetName() : Entry.Name);
+                    ResultObj->SetStringField(TEXT("type"), Entry.Type);
+                    ResultObj->SetBoolField(TEXT("success"), true);
+                    ResultsArray.Add(MakeShared<FJsonValueObject>(ResultObj));
+                }
+                else if (Entry.State == EAddState::Created && Entry.Widget)
+                {
+                    // Never parented because the batch stopped; don't leave it dangling
+                    WidgetBP->WidgetTree->RemoveWidget(Entry.Widget);
+                }
             }
+
         }
     }
 
@@ -1383,7 +1534,8 @@ TSharedPtr<FJsonObject> FUnrealCompanionUMGCommands::HandleWidgetBatch(const TSh
                     continue;
                 }
 
-                UWidget* TargetWidget = WidgetBP->WidgetTree->FindWidget(FName(*ModifyName));
+                UWidget** FoundWidget = WidgetsByName.Find(FName(*ModifyName));
+                UWidget* TargetWidget = FoundWidget ? *FoundWidget : nullptr;
                 if (!TargetWidget)
                 {
                     TSharedPtr<FJsonObject> ErrorObj = MakeShared<FJsonObject>();
@@ -1443,7 +1595,14 @@ TSharedPtr<FJsonObject> FUnrealCompanionUMGCommands::HandleWidgetBatch(const TSh
     if (!bDryRun)
     {
         WidgetBP->MarkPackageDirty();
-        FKismetEditorUtilities::CompileBlueprint(WidgetBP);
+        if (bDeferCompile)
+        {
+            QueueCompile(WidgetBP);
+        }
+        else
+        {
+            CompileWidgetBlueprint(WidgetBP);
+        }
     }
 
     // Build response
@@ -1454,6 +1613,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionUMGCommands::HandleWidgetBatch(const TSh
     Response->SetNumberField(TEXT("added"), AddedCount);
     Response->SetNumberField(TEXT("modified"), ModifiedCount);
     Response->SetNumberField(TEXT("removed"), RemovedCount);
+    Response->SetBoolField(TEXT("compile_queued"), !bDryRun && bDeferCompile);
     Response->SetArrayField(TEXT("results"), ResultsArray);
     
     if (ErrorsArray.Num() > 0)
@@ -1561,6 +1721,9 @@ TSharedPtr<FJsonObject> FUnrealCompanionUMGCommands::HandleAddWidgetToViewport(c
     int32 ZOrder = 0;
     Params->TryGetNumberField(TEXT("z_order"), ZOrder);
 
+    // The generated class must reflect edits still waiting in the compile queue
+    FlushCompile(WidgetBP);
+
     UClass* WidgetClass = WidgetBP->GeneratedClass;
     if (!WidgetClass)
     {
@@ -1621,6 +1784,9 @@ TSharedPtr<FJsonObject> FUnrealCompanionUMGCommands::HandleAddTextBlockToWidget(
     WidgetsArray.Add(MakeShared<FJsonValueObject>(WidgetDef));
     BatchParams->SetArrayField(TEXT("widgets"), WidgetsArray);
 
+    // Consecutive legacy calls building up one Blueprint share a single compile
+    BatchParams->SetBoolField(TEXT("defer_compile"), true);
+
     return HandleWidgetBatch(BatchParams);
 }
 
@@ -1658,6 +1824,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionUMGCommands::HandleAddButtonToWidget(con
     TArray<TSharedPtr<FJsonValue>> WidgetsArray;
     WidgetsArray.Add(MakeShared<FJsonValueObject>(WidgetDef));
     BatchParams->SetArrayField(TEXT("widgets"), WidgetsArray);
+    BatchParams->SetBoolField(TEXT("defer_compile"), true);
 
     // Note: Text on button requires adding a TextBlock child - simplified here
     return HandleWidgetBatch(BatchParams);
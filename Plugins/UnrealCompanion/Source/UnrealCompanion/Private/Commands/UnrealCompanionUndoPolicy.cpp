@@ -0,0 +1,316 @@
+#include "Commands/UnrealCompanionUndoPolicy.h"
+#include "Commands/UnrealCompanionCommonUtils.h"
+#include "Editor.h"
+#include "Editor/Transactor.h"
+
+namespace
+{
+    /**
+     * Commands that must not run inside a bridge transaction: undo and redo need none
+     * open, asset deletes and level loads reset the undo buffer, PIE and saves refuse
+     * to start during one. This includes commands that save what they create or edit.
+     * The console and Python scripts can do any of those. Python/tests/test_undo_policy.py
+     * checks that every command reaching such a call is listed.
+     */
+    bool IsOutsideTransactions(const FString& CommandType)
+    {
+        static const TSet<FString> Commands = {
+            TEXT("editor_undo"),
+            TEXT("editor_redo"),
+            TEXT("editor_play"),
+            TEXT("play"),
+            TEXT("editor_console"),
+            TEXT("console"),
+            TEXT("python_execute"),
+            TEXT("python_execute_file"),
+            TEXT("python_list_modules"),
+            TEXT("level_open"),
+            TEXT("level_create"),
+            TEXT("level_save"),
+            TEXT("core_save"),
+            TEXT("asset_save"),
+            TEXT("asset_save_all"),
+            TEXT("asset_delete"),
+            TEXT("asset_delete_batch"),
+            TEXT("asset_import"),
+            TEXT("asset_import_batch"),
+            TEXT("material_create"),
+            TEXT("material_create_instance"),
+            TEXT("material_set_parameter"),
+            TEXT("material_instance_batch"),
+            TEXT("project_create_input_action"),
+            TEXT("light_build"),
+        };
+        return Commands.Contains(CommandType);
+    }
+
+    void AnnotateUndo(const TSharedPtr<FJsonObject>& ResultJson, const TCHAR* Action, int64 SizeBytes)
+    {
+        if (!ResultJson.IsValid())
+        {
+            return;
+        }
+        TSharedPtr<FJsonObject> UndoObj = MakeShared<FJsonObject>();
+        UndoObj->SetStringField(TEXT("action"), Action);
+        UndoObj->SetNumberField(TEXT("snapshot_mb"), FMath::RoundToDouble(SizeBytes / 10485.76) / 100.0);
+        UndoObj->SetNumberField(TEXT("budget_mb"), GetDefault<UUnrealCompanionSettings>()->UndoBudgetMB);
+        ResultJson->SetObjectField(TEXT("undo"), UndoObj);
+    }
+}
+
+FUnrealCompanionUndoPolicy& FUnrealCompanionUndoPolicy::Get()
+{
+    static FUnrealCompanionUndoPolicy Instance;
+    return Instance;
+}
+
+bool FUnrealCompanionUndoPolicy::ParseMode(const FString& Text, EUnrealCompanionUndoMode& OutMode)
+{
+    if (Text == TEXT("command"))
+    {
+        OutMode = EUnrealCompanionUndoMode::Command;
+    }
+    else if (Text == TEXT("session"))
+    {
+        OutMode = EUnrealCompanionUndoMode::Session;
+    }
+    else if (Text == TEXT("none"))
+    {
+        OutMode = EUnrealCompanionUndoMode::None;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+const TCHAR* FUnrealCompanionUndoPolicy::ModeToString(EUnrealCompanionUndoMode Mode)
+{
+    switch (Mode)
+    {
+    case EUnrealCompanionUndoMode::Session: return TEXT("session");
+    case EUnrealCompanionUndoMode::None: return TEXT("none");
+    default: return TEXT("command");
+    }
+}
+
+int64 FUnrealCompanionUndoPolicy::GetBudgetBytes()
+{
+    return (int64)GetDefault<UUnrealCompanionSettings>()->UndoBudgetMB * 1024 * 1024;
+}
+
+int64 FUnrealCompanionUndoPolicy::GetOpenTransactionSize(bool& bOutHasRecords)
+{
+    // Begin discards the redo entries, so the open transaction is the last in the queue
+    const UTransactor* Trans = GEditor ? GEditor->Trans : nullptr;
+    const FTransaction* Transaction = Trans ? Trans->GetTransaction(Trans->GetQueueLength() - 1) : nullptr;
+    bOutHasRecords = Transaction && Transaction->GetRecordCount() > 0;
+    return Transaction ? (int64)Transaction->DataSize() : 0;
+}
+
+bool FUnrealCompanionUndoPolicy::BeginSession(const TSharedPtr<FJsonObject>& Params, const FString& Label, FString& OutError)
+{
+    EUnrealCompanionUndoMode NewMode = GetDefault<UUnrealCompanionSettings>()->UndoMode;
+    FString ModeText;
+    if (Params->TryGetStringField(TEXT("undo"), ModeText) && !ParseMode(ModeText, NewMode))
+    {
+        OutError = FString::Printf(TEXT("Unknown undo mode '%s' (command, session, none)"), *ModeText);
+        return false;
+    }
+
+    bSessionActive = true;
+    SessionMode = NewMode;
+    SessionLabel = Label;
+    SessionStepIds.Reset();
+    SessionWithoutUndo = 0;
+    return true;
+}
+
+void FUnrealCompanionUndoPolicy::EndSession(const TSharedPtr<FJsonObject>& Result)
+{
+    if (!bSessionActive)
+    {
+        return;
+    }
+    bSessionActive = false;
+    AddSummary(Result);
+}
+
+void FUnrealCompanionUndoPolicy::AbortSession(const TSharedPtr<FJsonObject>& Result)
+{
+    if (!bSessionActive)
+    {
+        return;
+    }
+    bSessionActive = false;
+
+    // Newest first, and only while the top of the undo history is the session's own
+    // step: undoing past an edit made since would revert that edit too
+    int32 RolledBack = 0;
+    UTransactor* Trans = GEditor ? GEditor->Trans : nullptr;
+    for (int32 Index = SessionStepIds.Num() - 1; Trans && Index >= 0; --Index)
+    {
+        if (Trans->GetUndoContext(false).TransactionId != SessionStepIds[Index] || !GEditor->UndoTransaction(false))
+        {
+            break;
+        }
+        ++RolledBack;
+    }
+
+    AddSummary(Result);
+    if (Result.IsValid())
+    {
+        const TSharedPtr<FJsonObject>& UndoObj = Result->GetObjectField(TEXT("undo"));
+        UndoObj->SetNumberField(TEXT("rolled_back"), RolledBack);
+        UndoObj->SetNumberField(TEXT("kept"), SessionStepIds.Num() - RolledBack);
+    }
+}
+
+void FUnrealCompanionUndoPolicy::AddStatus(const TSharedPtr<FJsonObject>& Result) const
+{
+    if (bSessionActive)
+    {
+        AddSummary(Result);
+    }
+}
+
+void FUnrealCompanionUndoPolicy::AddSummary(const TSharedPtr<FJsonObject>& Result) const
+{
+    if (!Result.IsValid())
+    {
+        return;
+    }
+
+    TSharedPtr<FJsonObject> UndoObj = MakeShared<FJsonObject>();
+    UndoObj->SetStringField(TEXT("mode"), ModeToString(SessionMode));
+    UndoObj->SetNumberField(TEXT("steps"), SessionStepIds.Num());
+    UndoObj->SetNumberField(TEXT("without_undo"), SessionWithoutUndo);
+    Result->SetObjectField(TEXT("undo"), UndoObj);
+}
+
+FUnrealCompanionUndoPolicy::FScope::FScope(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    if (!IsInGameThread() || !GEditor || !GEditor->Trans)
+    {
+        return;
+    }
+
+    FUnrealCompanionUndoPolicy& Policy = Get();
+    const UUnrealCompanionSettings* Settings = GetDefault<UUnrealCompanionSettings>();
+
+    Mode = Policy.bSessionActive ? Policy.SessionMode : Settings->UndoMode;
+    FString ModeText;
+    if (Params.IsValid() && Params->TryGetStringField(TEXT("undo"), ModeText) && !ParseMode(ModeText, Mode))
+    {
+        Error = FString::Printf(TEXT("Unknown undo mode '%s' (command, session, none)"), *ModeText);
+        return;
+    }
+
+    OverBudget = Settings->UndoOverBudget;
+    FString OverBudgetText;
+    if (Params.IsValid() && Params->TryGetStringField(TEXT("undo_over_budget"), OverBudgetText))
+    {
+        if (OverBudgetText == TEXT("reject"))
+        {
+            OverBudget = EUnrealCompanionUndoOverBudget::Reject;
+        }
+        else if (OverBudgetText == TEXT("drop"))
+        {
+            OverBudget = EUnrealCompanionUndoOverBudget::DropUndo;
+        }
+        else
+        {
+            Error = FString::Printf(TEXT("Unknown undo_over_budget '%s' (drop, reject)"), *OverBudgetText);
+            return;
+        }
+    }
+
+    // core_session only opens and closes the grouping
+    if (CommandType == TEXT("core_session") || IsOutsideTransactions(CommandType))
+    {
+        return;
+    }
+
+    // Someone else's transaction (an editor drag, a tool): the command joins it as-is
+    if (GEditor->IsTransactionActive())
+    {
+        return;
+    }
+
+    // The step never outlives the command: only the session's name carries over
+    const bool bInSession = Mode == EUnrealCompanionUndoMode::Session && Policy.bSessionActive;
+    FString Description = FString::Printf(TEXT("MCP %s"), *CommandType);
+    if (bInSession)
+    {
+        Description = Policy.SessionLabel.IsEmpty()
+            ? FString::Printf(TEXT("MCP Session: %s"), *CommandType)
+            : FString::Printf(TEXT("MCP Session %s: %s"), *Policy.SessionLabel, *CommandType);
+    }
+    TransactionIndex = GEditor->BeginTransaction(TEXT("UnrealCompanion"), FText::FromString(Description), nullptr);
+    bOwnsTransaction = true;
+}
+
+FUnrealCompanionUndoPolicy::FScope::~FScope()
+{
+    // Finish did not run (the handler threw): keep what was recorded
+    if (bOwnsTransaction)
+    {
+        GEditor->EndTransaction();
+    }
+}
+
+void FUnrealCompanionUndoPolicy::FScope::Finish(TSharedPtr<FJsonObject>& ResultJson)
+{
+    if (!bOwnsTransaction)
+    {
+        return;
+    }
+    bOwnsTransaction = false;
+
+    FUnrealCompanionUndoPolicy& Policy = Get();
+    bool bHasRecords = false;
+    const int64 Size = GetOpenTransactionSize(bHasRecords);
+    const int64 BudgetBytes = GetBudgetBytes();
+
+    // Queries and commands that changed nothing leave no empty undo entry behind; "none" discards what was recorded
+    if (!bHasRecords || Mode == EUnrealCompanionUndoMode::None)
+    {
+        GEditor->CancelTransaction(TransactionIndex);
+        if (bHasRecords && Policy.bSessionActive)
+        {
+            ++Policy.SessionWithoutUndo;
+        }
+        return;
+    }
+
+    if (BudgetBytes <= 0 || Size <= BudgetBytes)
+    {
+        GEditor->EndTransaction();
+        if (Policy.bSessionActive)
+        {
+            // Just ended, so it is the one undo would revert next
+            Policy.SessionStepIds.Add(GEditor->Trans->GetUndoContext(false).TransactionId);
+        }
+        return;
+    }
+
+    if (OverBudget == EUnrealCompanionUndoOverBudget::Reject)
+    {
+        GEditor->EndTransaction();
+        GEditor->UndoTransaction(false);
+        ResultJson = FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(
+            TEXT("UNDO_BUDGET_EXCEEDED"),
+            FString::Printf(TEXT("The command's undo snapshot (%.1f MB) exceeds the %d MB budget; its changes were rolled back"),
+                Size / (1024.0 * 1024.0), GetDefault<UUnrealCompanionSettings>()->UndoBudgetMB),
+            TEXT("Split the work into smaller commands, or pass undo_over_budget=\"drop\" to keep the changes without an undo step"));
+        return;
+    }
+
+    GEditor->CancelTransaction(TransactionIndex);
+    if (Policy.bSessionActive)
+    {
+        ++Policy.SessionWithoutUndo;
+    }
+    AnnotateUndo(ResultJson, TEXT("dropped"), Size);
+}
@@ -1,65 +1,459 @@
 #include "Commands/UnrealCompanionViewportCommands.h"
 #include "Commands/UnrealCompanionCommonUtils.h"
+#include "Commands/UnrealCompanionActorIndex.h"
 #include "Commands/UnrealCompanionEditorFocus.h"
+#include "Commands/UnrealCompanionEnvironmentCommands.h"
 #include "Editor.h"
 #include "EditorViewportClient.h"
 #include "LevelEditorViewport.h"
+#include "Commands/UnrealCompanionDeferredResponse.h"
+#include "MCPSharedMemory.h"
 #include "ImageUtils.h"
 #include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Base64.h"
+#include "Misc/Optional.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "RenderingThread.h"
+#include "RHICommandList.h"
+#include "RHIGPUReadback.h"
+#include "UnrealClient.h"
+#include <atomic>
 #include "GameFramework/Actor.h"
 #include "Kismet/GameplayStatics.h"
 
-FUnrealCompanionViewportCommands::FUnrealCompanionViewportCommands()
+namespace
 {
-}
+    /** One in-flight async viewport capture, shared by the game, render and worker threads */
+    struct FScreenshotCapture
+    {
+        FIntPoint Size = FIntPoint::ZeroValue;
+        FString FilePath;
+        bool bInline = false;
+        bool bSharedMemory = false;
+        double StartTime = 0.0;
+        FUnrealCompanionDeferredResponse::FCompletion Completion;
 
-TSharedPtr<FJsonObject> FUnrealCompanionViewportCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
-{
-    if (CommandType == TEXT("viewport_focus"))
+        // Render thread only
+        TUniquePtr<FRHIGPUTextureReadback> Readback;
+
+        // Set once the pixels left the GPU (or the capture failed); stops the poll ticker
+        std::atomic<bool> bFinished{false};
+        std::atomic<bool> bPollQueued{false};
+    };
+
+    /** Maximum wait for the GPU copy before the capture is reported as failed */
+    constexpr double ScreenshotReadbackTimeoutSeconds = 5.0;
+
+    /** PNG-encode pixels and write, inline and/or publish them in shared memory. Safe on any thread. */
+    TSharedPtr<FJsonObject> EncodeScreenshot(const FIntPoint& Size, TArray<FColor>& Bitmap, const FString& FilePath, bool bInline, bool bSharedMemory, bool bAsync)
     {
-        return HandleFocusViewport(Params);
+        // Viewport alpha is undefined; an opaque PNG is what callers expect
+        for (FColor& Pixel : Bitmap)
+        {
+            Pixel.A = 255;
+        }
+
+        TArray64<uint8> CompressedBitmap;
+        FImageUtils::PNGCompressImageArray(Size.X, Size.Y, Bitmap, CompressedBitmap);
+        if (CompressedBitmap.Num() == 0)
+        {
+            return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to encode screenshot"));
+        }
+
+        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+        if (!FilePath.IsEmpty())
+        {
+            if (!FFileHelper::SaveArrayToFile(CompressedBitmap, *FilePath))
+            {
+                return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Failed to write screenshot: %s"), *FilePath));
+            }
+            ResultObj->SetStringField(TEXT("filepath"), FilePath);
+        }
+        if (bSharedMemory)
+        {
+            // A local client reads the PNG in place; if the ring cannot take it, inline it instead
+            FString SharedError;
+            if (TSharedPtr<FJsonObject> Handle = FMCPSharedMemory::Get().Write(CompressedBitmap.GetData(), CompressedBitmap.Num(), SharedError))
+            {
+                ResultObj->SetObjectField(TEXT("shared_memory"), Handle);
+            }
+            else
+            {
+                ResultObj->SetStringField(TEXT("shared_memory_error"), SharedError);
+                bInline = true;
+            }
+        }
+        if (bInline)
+        {
+            ResultObj->SetStringField(TEXT("mime_type"), TEXT("image/png"));
+            ResultObj->SetStringField(TEXT("image_base64"), FBase64::Encode(CompressedBitmap.GetData(), (uint32)CompressedBitmap.Num()));
+        }
+
+        ResultObj->SetBoolField(TEXT("success"), true);
+        ResultObj->SetNumberField(TEXT("width"), Size.X);
+        ResultObj->SetNumberField(TEXT("height"), Size.Y);
+        ResultObj->SetNumberField(TEXT("bytes"), (double)CompressedBitmap.Num());
+        ResultObj->SetBoolField(TEXT("async"), bAsync);
+        return ResultObj;
     }
-    else if (CommandType == TEXT("viewport_screenshot"))
+
+    void FinishCapture(const TSharedRef<FScreenshotCapture, ESPMode::ThreadSafe>& Capture, const TSharedPtr<FJsonObject>& Result)
     {
-        return HandleTakeScreenshot(Params);
+        if (Capture->Completion)
+        {
+            FUnrealCompanionDeferredResponse::FCompletion Completion = MoveTemp(Capture->Completion);
+            Completion(Result);
+        }
     }
-    else if (CommandType == TEXT("viewport_get_camera"))
+
+    /** Render thread: copy out a finished readback row by row, then encode on a worker */
+    void ResolveReadback(const TSharedRef<FScreenshotCapture, ESPMode::ThreadSafe>& Capture)
     {
-        return HandleGetViewportCamera(Params);
+        check(IsInRenderingThread());
+
+        int32 RowPitchInPixels = 0;
+        const FColor* Source = static_cast<const FColor*>(Capture->Readback->Lock(RowPitchInPixels));
+        TArray<FColor> Bitmap;
+        if (Source)
+        {
+            const int32 Width = Capture->Size.X;
+            Bitmap.SetNumUninitialized(Width * Capture->Size.Y);
+            for (int32 Y = 0; Y < Capture->Size.Y; ++Y)
+            {
+                FMemory::Memcpy(&Bitmap[Y * Width], Source + (int64)Y * RowPitchInPixels, Width * sizeof(FColor));
+            }
+        }
+        Capture->Readback->Unlock();
+        Capture->Readback.Reset();
+        Capture->bFinished = true;
+
+        if (Bitmap.Num() == 0)
+        {
+            FinishCapture(Capture, FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to map screenshot readback")));
+            return;
+        }
+
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Capture, Bitmap = MoveTemp(Bitmap)]() mutable
+        {
+            TSharedPtr<FJsonObject> Result = EncodeScreenshot(Capture->Size, Bitmap, Capture->FilePath, Capture->bInline, Capture->bSharedMemory, true);
+            if (Result->GetBoolField(TEXT("success")))
+            {
+                Result->SetNumberField(TEXT("capture_ms"), (FPlatformTime::Seconds() - Capture->StartTime) * 1000.0);
+            }
+            FinishCapture(Capture, Result);
+        });
     }
-    else if (CommandType == TEXT("viewport_set_camera"))
+
+    /** Game thread: queue the GPU copy, then poll its fence once per frame without ever blocking */
+    void BeginAsyncCapture(FViewport* Viewport, const TSharedRef<FScreenshotCapture, ESPMode::ThreadSafe>& Capture)
     {
-        return HandleSetViewportCamera(Params);
+        ENQUEUE_RENDER_COMMAND(UnrealCompanionScreenshotCopy)([Viewport, Capture](FRHICommandListImmediate& RHICmdList)
+        {
+            FRHITexture* Texture = Viewport->GetRenderTargetTexture();
+            if (!Texture && Viewport->GetViewportRHI())
+            {
+                Texture = RHIGetViewportBackBuffer(Viewport->GetViewportRHI());
+            }
+
+            // Only 8-bit BGRA maps straight onto FColor; anything else (HDR output) takes the blocking path
+            if (!Texture || Texture->GetFormat() != PF_B8G8R8A8)
+            {
+                Capture->bFinished = true;
+                AsyncTask(ENamedThreads::GameThread, [Viewport, Capture]()
+                {
+                    TArray<FColor> Bitmap;
+                    if (GEditor && GEditor->GetActiveViewport() == Viewport &&
+                        Viewport->ReadPixels(Bitmap, FReadSurfaceDataFlags(), FIntRect(0, 0, Capture->Size.X, Capture->Size.Y)))
+                    {
+                        FinishCapture(Capture, EncodeScreenshot(Capture->Size, Bitmap, Capture->FilePath, Capture->bInline, Capture->bSharedMemory, false));
+                    }
+                    else
+                    {
+                        FinishCapture(Capture, FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to take screenshot")));
+                    }
+                });
+                return;
+            }
+
+            const FIntVector TextureSize = Texture->GetSizeXYZ();
+            Capture->Size.X = FMath::Min(Capture->Size.X, TextureSize.X);
+            Capture->Size.Y = FMath::Min(Capture->Size.Y, TextureSize.Y);
+
+            Capture->Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("UnrealCompanionScreenshot"));
+            RHICmdList.Transition(FRHITransitionInfo(Texture, ERHIAccess::Unknown, ERHIAccess::CopySrc));
+            Capture->Readback->EnqueueCopy(RHICmdList, Texture, FIntVector::ZeroValue, 0, FIntVector(Capture->Size.X, Capture->Size.Y, 1));
+            RHICmdList.Transition(FRHITransitionInfo(Texture, ERHIAccess::CopySrc, ERHIAccess::SRVMask));
+        });
+
+        FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Capture](float)
+        {
+            if (Capture->bFinished)
+            {
+                return false;
+            }
+
+            // One poll in flight at a time; the fence is only queried on the render thread
+            if (!Capture->bPollQueued.exchange(true))
+            {
+                ENQUEUE_RENDER_COMMAND(UnrealCompanionScreenshotPoll)([Capture](FRHICommandListImmediate&)
+                {
+                    Capture->bPollQueued = false;
+                    if (Capture->bFinished || !Capture->Readback)
+                    {
+                        return;
+                    }
+                    if (Capture->Readback->IsReady())
+                    {
+                        ResolveReadback(Capture);
+                    }
+                    else if (FPlatformTime::Seconds() - Capture->StartTime > ScreenshotReadbackTimeoutSeconds)
+                    {
+                        Capture->Readback.Reset();
+                        Capture->bFinished = true;
+                        FinishCapture(Capture, FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Screenshot readback timed out")));
+                    }
+                });
+            }
+            return true;
+        }));
     }
-    // Play In Editor control
-    else if (CommandType == TEXT("editor_play") || CommandType == TEXT("play"))
+}
+
+
+namespace
+{
+    /** One step of viewport_capture_sequence */
+    struct FCaptureKeyframe
     {
-        return HandlePlay(Params);
+        TOptional<FVector> Location;
+        TOptional<FRotator> Rotation;
+        // environment_configure "apply" params, null when the keyframe leaves the environment alone
+        TSharedPtr<FJsonObject> Environment;
+        FString FilePath;
+    };
+
+    /** A running capture sequence; keyframes advance on the game thread, frames finish on workers */
+    struct FCaptureSequence
+    {
+        TArray<FCaptureKeyframe> Keyframes;
+        bool bInline = false;
+        bool bSharedMemory = false;
+        bool bRestoreCamera = true;
+        FVector StartLocation = FVector::ZeroVector;
+        FRotator StartRotation = FRotator::ZeroRotator;
+        double StartTime = 0.0;
+        FUnrealCompanionDeferredResponse::FCompletion Completion;
+        FUnrealCompanionDeferredResponse::FEventSink EventSink;
+
+        // Game thread only
+        int32 NextKeyframe = 0;
+
+        // Written by the frame completions
+        FCriticalSection FramesLock;
+        TArray<TSharedPtr<FJsonObject>> Frames;
+        std::atomic<int32> InFlight{0};
+        std::atomic<int32> Completed{0};
+        std::atomic<int32> Failed{0};
+    };
+
+    /** Readbacks allowed in flight before the sequence waits a frame; bounds staging memory */
+    constexpr int32 MaxCaptureSequenceInFlight = 4;
+    constexpr int32 MaxCaptureSequenceKeyframes = 1000;
+
+    FString MakeSequenceFramePath(const FString& Prefix, int32 Index)
+    {
+        return FPaths::Combine(FPaths::ScreenShotDir(), TEXT("UnrealCompanion"), FString::Printf(TEXT("%s_%04d.png"), *Prefix, Index));
     }
-    // Console commands
-    else if (CommandType == TEXT("editor_console") || CommandType == TEXT("console"))
+
+    /** Parse and validate every keyframe before the first one is applied */
+    bool ParseCaptureKeyframes(const TArray<TSharedPtr<FJsonValue>>& Values, const FString& Prefix, bool bInMemory, TArray<FCaptureKeyframe>& OutKeyframes, FString& OutError)
     {
-        return HandleConsole(Params);
+        OutKeyframes.Reserve(Values.Num());
+        for (int32 Index = 0; Index < Values.Num(); ++Index)
+        {
+            const TSharedPtr<FJsonObject>* KeyObj = nullptr;
+            if (!Values[Index].IsValid() || !Values[Index]->TryGetObject(KeyObj))
+            {
+                OutError = FString::Printf(TEXT("Keyframe %d is not an object"), Index);
+                return false;
+            }
+
+            FCaptureKeyframe& Keyframe = OutKeyframes.AddDefaulted_GetRef();
+            if ((*KeyObj)->HasField(TEXT("location")))
+            {
+                Keyframe.Location = FUnrealCompanionCommonUtils::GetVectorFromJson(*KeyObj, TEXT("location"));
+            }
+            if ((*KeyObj)->HasField(TEXT("rotation")))
+            {
+                Keyframe.Rotation = FUnrealCompanionCommonUtils::GetRotatorFromJson(*KeyObj, TEXT("rotation"));
+            }
+
+            // "time" is shorthand for the most common sweep
+            const TSharedPtr<FJsonObject>* EnvObj = nullptr;
+            if ((*KeyObj)->TryGetObjectField(TEXT("environment"), EnvObj))
+            {
+                Keyframe.Environment = MakeShared<FJsonObject>(**EnvObj);
+            }
+            double Time = 0.0;
+            if ((*KeyObj)->TryGetNumberField(TEXT("time"), Time))
+            {
+                if (!Keyframe.Environment.IsValid())
+                {
+                    Keyframe.Environment = MakeShared<FJsonObject>();
+                }
+                Keyframe.Environment->SetNumberField(TEXT("time"), Time);
+            }
+            if (Keyframe.Environment.IsValid())
+            {
+                Keyframe.Environment->SetStringField(TEXT("action"), TEXT("apply"));
+            }
+
+            FString FileName;
+            if ((*KeyObj)->TryGetStringField(TEXT("filename"), FileName) && !FileName.IsEmpty())
+            {
+                Keyframe.FilePath = FPaths::Combine(FPaths::ScreenShotDir(), TEXT("UnrealCompanion"), FileName);
+                if (!Keyframe.FilePath.EndsWith(TEXT(".png")))
+                {
+                    Keyframe.FilePath += TEXT(".png");
+                }
+            }
+            else if (!Prefix.IsEmpty() || !bInMemory)
+            {
+                Keyframe.FilePath = MakeSequenceFramePath(Prefix.IsEmpty() ? TEXT("Sequence") : Prefix, Index);
+            }
+        }
+        return true;
     }
-    // Undo/Redo
-    else if (CommandType == TEXT("editor_undo"))
+
+    /** Game thread: move the camera and environment to a keyframe; false with OutError if the environment rejected it */
+    bool ApplyCaptureKeyframe(FLevelEditorViewportClient* ViewportClient, const FCaptureKeyframe& Keyframe,
+        const TSharedPtr<FUnrealCompanionEnvironmentCommands>& Environment, FString& OutError)
     {
-        return HandleUndo(Params);
+        if (Keyframe.Location.IsSet())
+        {
+            ViewportClient->SetViewLocation(Keyframe.Location.GetValue());
+        }
+        if (Keyframe.Rotation.IsSet())
+        {
+            ViewportClient->SetViewRotation(Keyframe.Rotation.GetValue());
+        }
+
+        if (Keyframe.Environment.IsValid())
+        {
+            if (!Environment.IsValid())
+            {
+                OutError = TEXT("Environment commands are not available");
+                return false;
+            }
+
+            // Inline call: the environment handler must not take over this request's reply
+            FUnrealCompanionDeferredResponse::FScope NoDefer(nullptr);
+            TSharedPtr<FJsonObject> Result = Environment->HandleCommand(TEXT("environment_configure"), Keyframe.Environment);
+            if (!Result.IsValid() || !Result->GetBoolField(TEXT("success")))
+            {
+                OutError = Result.IsValid() ? Result->GetStringField(TEXT("error")) : TEXT("Environment update failed");
+                return false;
+            }
+        }
+        return true;
     }
-    else if (CommandType == TEXT("editor_redo"))
+
+    void RecordSequenceFrame(const TSharedRef<FCaptureSequence, ESPMode::ThreadSafe>& Sequence, int32 Index, const TSharedPtr<FJsonObject>& Result)
     {
-        return HandleRedo(Params);
+        TSharedPtr<FJsonObject> Frame = Result.IsValid() ? Result : FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Capture failed"));
+        Frame->SetNumberField(TEXT("index"), Index);
+        if (!Frame->GetBoolField(TEXT("success")))
+        {
+            ++Sequence->Failed;
+        }
+
+        // A streamed frame has delivered its image; the final reply keeps the summary
+        if (Sequence->EventSink)
+        {
+            Sequence->EventSink(TEXT("capture_frame"), Frame);
+            if (Frame->HasField(TEXT("image_base64")))
+            {
+                Frame = MakeShared<FJsonObject>(*Frame);
+                Frame->RemoveField(TEXT("image_base64"));
+                Frame->SetBoolField(TEXT("streamed"), true);
+            }
+        }
+
+        {
+            FScopeLock Lock(&Sequence->FramesLock);
+            Sequence->Frames[Index] = Frame;
+        }
+        --Sequence->InFlight;
+        ++Sequence->Completed;
     }
-    // Focus management
-    else if (CommandType == TEXT("editor_focus_close"))
+
+    TSharedPtr<FJsonObject> BuildSequenceResult(FCaptureSequence& Sequence, bool bAsync)
     {
-        return HandleFocusClose(Params);
+        TArray<TSharedPtr<FJsonValue>> FrameArray;
+        {
+            FScopeLock Lock(&Sequence.FramesLock);
+            for (const TSharedPtr<FJsonObject>& Frame : Sequence.Frames)
+            {
+                FrameArray.Add(MakeShared<FJsonValueObject>(Frame.IsValid() ? Frame : FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Not captured"))));
+            }
+        }
+
+        const double TotalMs = (FPlatformTime::Seconds() - Sequence.StartTime) * 1000.0;
+        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+        ResultObj->SetBoolField(TEXT("success"), Sequence.Failed == 0);
+        if (Sequence.Failed > 0)
+        {
+            ResultObj->SetStringField(TEXT("error"), FString::Printf(TEXT("%d of %d frames failed"), Sequence.Failed.load(), Sequence.Keyframes.Num()));
+        }
+        ResultObj->SetArrayField(TEXT("frames"), FrameArray);
+        ResultObj->SetNumberField(TEXT("frame_count"), Sequence.Keyframes.Num());
+        ResultObj->SetNumberField(TEXT("failed"), Sequence.Failed.load());
+        ResultObj->SetNumberField(TEXT("total_ms"), TotalMs);
+        ResultObj->SetNumberField(TEXT("frames_per_second"), TotalMs > 0.0 ? Sequence.Keyframes.Num() * 1000.0 / TotalMs : 0.0);
+        ResultObj->SetBoolField(TEXT("streamed"), (bool)Sequence.EventSink);
+        ResultObj->SetBoolField(TEXT("async"), bAsync);
+        return ResultObj;
     }
-    else if (CommandType == TEXT("editor_focus_level"))
+}
+
+FUnrealCompanionViewportCommands::FUnrealCompanionViewportCommands()
+{
+}
+
+void FUnrealCompanionViewportCommands::SetEnvironmentCommands(const TSharedPtr<FUnrealCompanionEnvironmentCommands>& InEnvironmentCommands)
+{
+    EnvironmentCommands = InEnvironmentCommands;
+}
+
+TConstArrayView<TMCPCommandEntry<FUnrealCompanionViewportCommands>> FUnrealCompanionViewportCommands::GetCommandTable()
+{
+    static constexpr TMCPCommandEntry<FUnrealCompanionViewportCommands> Table[] = {
+        { TEXT("viewport_focus"), &FUnrealCompanionViewportCommands::HandleFocusViewport },
+        { TEXT("viewport_screenshot"), &FUnrealCompanionViewportCommands::HandleTakeScreenshot },
+        { TEXT("viewport_get_camera"), &FUnrealCompanionViewportCommands::HandleGetViewportCamera },
+        { TEXT("viewport_set_camera"), &FUnrealCompanionViewportCommands::HandleSetViewportCamera },
+        { TEXT("viewport_capture_sequence"), &FUnrealCompanionViewportCommands::HandleCaptureSequence },
+        { TEXT("editor_play"), &FUnrealCompanionViewportCommands::HandlePlay },
+        { TEXT("play"), &FUnrealCompanionViewportCommands::HandlePlay },
+        { TEXT("editor_console"), &FUnrealCompanionViewportCommands::HandleConsole },
+        { TEXT("console"), &FUnrealCompanionViewportCommands::HandleConsole },
+        { TEXT("editor_undo"), &FUnrealCompanionViewportCommands::HandleUndo },
+        { TEXT("editor_redo"), &FUnrealCompanionViewportCommands::HandleRedo },
+        { TEXT("editor_focus_close"), &FUnrealCompanionViewportCommands::HandleFocusClose },
+        { TEXT("editor_focus_level"), &FUnrealCompanionViewportCommands::HandleFocusLevel },
+    };
+    static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+    return Table;
+}
+
+TSharedPtr<FJsonObject> FUnrealCompanionViewportCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    if (TSharedPtr<FJsonObject> Result = UnrealCompanionCommandTable::Dispatch(*this, GetCommandTable(), CommandType, Params))
     {
-        return HandleFocusLevel(Params);
+        return Result;
     }
-    
     return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown viewport command: %s"), *CommandType));
 }
 
@@ -98,18 +492,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionViewportCommands::HandleFocusViewport(co
 
     if (HasTargetActor)
     {
-        AActor* TargetActor = nullptr;
-        TArray<AActor*> AllActors;
-        UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-        
-        for (AActor* Actor : AllActors)
-        {
-            if (Actor && (Actor->GetName() == TargetActorName || Actor->GetActorLabel() == TargetActorName))
-            {
-                TargetActor = Actor;
-                break;
-            }
-        }
+        AActor* TargetActor = FUnrealCompanionActorIndex::Get().FindByName(GWorld, TargetActorName);
 
         if (!TargetActor)
         {
@@ -141,41 +524,67 @@ TSharedPtr<FJsonObject> FUnrealCompanionViewportCommands::HandleFocusViewport(co
 
 TSharedPtr<FJsonObject> FUnrealCompanionViewportCommands::HandleTakeScreenshot(const TSharedPtr<FJsonObject>& Params)
 {
+    bool bInline = false;
+    Params->TryGetBoolField(TEXT("inline"), bInline);
+    bool bSharedMemory = false;
+    Params->TryGetBoolField(TEXT("shared_memory"), bSharedMemory);
+
+    bool bAsync = true;
+    Params->TryGetBoolField(TEXT("async"), bAsync);
+
+    // An explicit path wins; otherwise a filename goes to Saved/Screenshots. Inline and shared-memory shots skip the disk.
     FString FilePath;
     if (!Params->TryGetStringField(TEXT("filepath"), FilePath))
     {
-        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing 'filepath' parameter"));
+        FString FileName;
+        if (Params->TryGetStringField(TEXT("filename"), FileName) || !(bInline || bSharedMemory))
+        {
+            if (FileName.IsEmpty())
+            {
+                FileName = FString::Printf(TEXT("Screenshot_%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+            }
+            FilePath = FPaths::Combine(FPaths::ScreenShotDir(), TEXT("UnrealCompanion"), FileName);
+        }
     }
-    
-    if (!FilePath.EndsWith(TEXT(".png")))
+
+    if (!FilePath.IsEmpty() && !FilePath.EndsWith(TEXT(".png")))
     {
         FilePath += TEXT(".png");
     }
 
-    if (GEditor && GEditor->GetActiveViewport())
+    if (!GEditor || !GEditor->GetActiveViewport())
     {
-        FViewport* Viewport = GEditor->GetActiveViewport();
-        TArray<FColor> Bitmap;
-        FIntRect ViewportRect(0, 0, Viewport->GetSizeXY().X, Viewport->GetSizeXY().Y);
-        
-        if (Viewport->ReadPixels(Bitmap, FReadSurfaceDataFlags(), ViewportRect))
-        {
-            TArray64<uint8> CompressedBitmap;
-            FImageUtils::PNGCompressImageArray(Viewport->GetSizeXY().X, Viewport->GetSizeXY().Y, Bitmap, CompressedBitmap);
-            
-            if (FFileHelper::SaveArrayToFile(CompressedBitmap, *FilePath))
-            {
-                TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-                ResultObj->SetBoolField(TEXT("success"), true);
-                ResultObj->SetStringField(TEXT("filepath"), FilePath);
-                ResultObj->SetNumberField(TEXT("width"), Viewport->GetSizeXY().X);
-                ResultObj->SetNumberField(TEXT("height"), Viewport->GetSizeXY().Y);
-                return ResultObj;
-            }
-        }
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to take screenshot: no active viewport"));
     }
-    
-    return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to take screenshot"));
+
+    FViewport* Viewport = GEditor->GetActiveViewport();
+    const FIntPoint Size = Viewport->GetSizeXY();
+    if (Size.X <= 0 || Size.Y <= 0)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to take screenshot: viewport has no size"));
+    }
+
+    // Async: GPU copy + fence on the render thread, PNG and file I/O on a worker, reply deferred.
+    // Without a deferrable dispatch (direct game-thread call) fall back to the blocking path.
+    if (bAsync && FUnrealCompanionDeferredResponse::CanDefer())
+    {
+        TSharedRef<FScreenshotCapture, ESPMode::ThreadSafe> Capture = MakeShared<FScreenshotCapture, ESPMode::ThreadSafe>();
+        Capture->Size = Size;
+        Capture->FilePath = FilePath;
+        Capture->bInline = bInline;
+        Capture->bSharedMemory = bSharedMemory;
+        Capture->StartTime = FPlatformTime::Seconds();
+        Capture->Completion = FUnrealCompanionDeferredResponse::Defer();
+        BeginAsyncCapture(Viewport, Capture);
+        return nullptr;
+    }
+
+    TArray<FColor> Bitmap;
+    if (!Viewport->ReadPixels(Bitmap, FReadSurfaceDataFlags(), FIntRect(0, 0, Size.X, Size.Y)))
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to take screenshot"));
+    }
+    return EncodeScreenshot(Size, Bitmap, FilePath, bInline, bSharedMemory, false);
 }
 
 TSharedPtr<FJsonObject> FUnrealCompanionViewportCommands::HandleGetViewportCamera(const TSharedPtr<FJsonObject>& Params)
@@ -234,6 +643,175 @@ TSharedPtr<FJsonObject> FUnrealCompanionViewportCommands::HandleSetViewportCamer
     return ResultObj;
 }
 
+// =============================================================================
+// CAPTURE SEQUENCE
+// =============================================================================
+
+TSharedPtr<FJsonObject> FUnrealCompanionViewportCommands::HandleCaptureSequence(const TSharedPtr<FJsonObject>& Params)
+{
+    const TArray<TSharedPtr<FJsonValue>>* KeyframeValues = nullptr;
+    if (!Params->TryGetArrayField(TEXT("keyframes"), KeyframeValues) || KeyframeValues->Num() == 0)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(TEXT("MISSING_KEYFRAMES"),
+            TEXT("Missing 'keyframes' array"),
+            TEXT("Pass keyframes=[{\"location\": [...], \"rotation\": [...], \"time\": 6.0}, ...]"));
+    }
+    if (KeyframeValues->Num() > MaxCaptureSequenceKeyframes)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(TEXT("TOO_MANY_KEYFRAMES"),
+            FString::Printf(TEXT("%d keyframes requested, at most %d per sequence"), KeyframeValues->Num(), MaxCaptureSequenceKeyframes),
+            TEXT("Split the sweep into several sequences"));
+    }
+
+    if (!GEditor || !GEditor->GetActiveViewport())
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to capture sequence: no active viewport"));
+    }
+    FViewport* Viewport = GEditor->GetActiveViewport();
+    FLevelEditorViewportClient* ViewportClient = (FLevelEditorViewportClient*)Viewport->GetClient();
+    if (!ViewportClient)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to get active viewport"));
+    }
+    const FIntPoint Size = Viewport->GetSizeXY();
+    if (Size.X <= 0 || Size.Y <= 0)
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to capture sequence: viewport has no size"));
+    }
+
+    bool bInline = false;
+    Params->TryGetBoolField(TEXT("inline"), bInline);
+    bool bSharedMemory = false;
+    Params->TryGetBoolField(TEXT("shared_memory"), bSharedMemory);
+    FString Prefix;
+    Params->TryGetStringField(TEXT("filename"), Prefix);
+
+    TSharedRef<FCaptureSequence, ESPMode::ThreadSafe> Sequence = MakeShared<FCaptureSequence, ESPMode::ThreadSafe>();
+    FString ParseError;
+    if (!ParseCaptureKeyframes(*KeyframeValues, Prefix, bInline || bSharedMemory, Sequence->Keyframes, ParseError))
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(ParseError);
+    }
+    Sequence->bInline = bInline;
+    Sequence->bSharedMemory = bSharedMemory;
+    Params->TryGetBoolField(TEXT("restore_camera"), Sequence->bRestoreCamera);
+    Sequence->StartLocation = ViewportClient->GetViewLocation();
+    Sequence->StartRotation = ViewportClient->GetViewRotation();
+    Sequence->StartTime = FPlatformTime::Seconds();
+    Sequence->Frames.SetNum(Sequence->Keyframes.Num());
+
+    bool bAsync = true;
+    Params->TryGetBoolField(TEXT("async"), bAsync);
+
+    // Blocking path: draw and read back each keyframe in turn
+    if (!bAsync || !FUnrealCompanionDeferredResponse::CanDefer())
+    {
+        const TSharedPtr<FUnrealCompanionEnvironmentCommands> Environment = EnvironmentCommands.Pin();
+        for (int32 Index = 0; Index < Sequence->Keyframes.Num(); ++Index)
+        {
+            const FCaptureKeyframe& Keyframe = Sequence->Keyframes[Index];
+            FString Error;
+            TArray<FColor> Bitmap;
+            TSharedPtr<FJsonObject> Frame;
+            if (!ApplyCaptureKeyframe(ViewportClient, Keyframe, Environment, Error))
+            {
+                Frame = FUnrealCompanionCommonUtils::CreateErrorResponse(Error);
+            }
+            else
+            {
+                Viewport->Draw();
+                Frame = Viewport->ReadPixels(Bitmap, FReadSurfaceDataFlags(), FIntRect(0, 0, Size.X, Size.Y))
+                    ? EncodeScreenshot(Size, Bitmap, Keyframe.FilePath, bInline, bSharedMemory, false)
+                    : FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to take screenshot"));
+            }
+            ++Sequence->InFlight;
+            RecordSequenceFrame(Sequence, Index, Frame);
+        }
+        if (Sequence->bRestoreCamera)
+        {
+            ViewportClient->SetViewLocation(Sequence->StartLocation);
+            ViewportClient->SetViewRotation(Sequence->StartRotation);
+            ViewportClient->Invalidate();
+        }
+        return BuildSequenceResult(*Sequence, false);
+    }
+
+    Sequence->EventSink = FUnrealCompanionDeferredResponse::GetEventSink();
+    Sequence->Completion = FUnrealCompanionDeferredResponse::Defer();
+
+    // One keyframe per tick: apply it, draw it now, and queue the readback behind that draw on the
+    // render thread. The next keyframe's draw is queued after the copy, so frames never overwrite
+    // each other. GPU copies, PNG encoding and file writes overlap with the following keyframes.
+    TWeakPtr<FUnrealCompanionEnvironmentCommands> WeakEnvironment = EnvironmentCommands;
+    FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Sequence, Viewport, ViewportClient, Size, WeakEnvironment](float)
+    {
+        const bool bViewportAlive = GEditor && GEditor->GetActiveViewport() == Viewport;
+        const int32 Total = Sequence->Keyframes.Num();
+
+        if (Sequence->NextKeyframe < Total)
+        {
+            if (!bViewportAlive)
+            {
+                // The viewport went away: the remaining keyframes can never be drawn
+                for (; Sequence->NextKeyframe < Total; ++Sequence->NextKeyframe)
+                {
+                    ++Sequence->InFlight;
+                    RecordSequenceFrame(Sequence, Sequence->NextKeyframe,
+                        FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Viewport closed during capture")));
+                }
+            }
+            else if (Sequence->InFlight < MaxCaptureSequenceInFlight)
+            {
+                const int32 Index = Sequence->NextKeyframe++;
+                const FCaptureKeyframe& Keyframe = Sequence->Keyframes[Index];
+                ++Sequence->InFlight;
+
+                FString Error;
+                if (!ApplyCaptureKeyframe(ViewportClient, Keyframe, WeakEnvironment.Pin(), Error))
+                {
+                    RecordSequenceFrame(Sequence, Index, FUnrealCompanionCommonUtils::CreateErrorResponse(Error));
+                }
+                else
+                {
+                    Viewport->Draw();
+
+                    TSharedRef<FScreenshotCapture, ESPMode::ThreadSafe> Capture = MakeShared<FScreenshotCapture, ESPMode::ThreadSafe>();
+                    Capture->Size = Size;
+                    Capture->FilePath = Keyframe.FilePath;
+                    Capture->bInline = Sequence->bInline;
+                    Capture->bSharedMemory = Sequence->bSharedMemory;
+                    Capture->StartTime = FPlatformTime::Seconds();
+                    Capture->Completion = [Sequence, Index](const TSharedPtr<FJsonObject>& Result)
+                    {
+                        RecordSequenceFrame(Sequence, Index, Result);
+                    };
+                    BeginAsyncCapture(Viewport, Capture);
+                }
+            }
+            return true;
+        }
+
+        if (Sequence->Completed < Total)
+        {
+            return true;
+        }
+
+        if (Sequence->bRestoreCamera && bViewportAlive)
+        {
+            ViewportClient->SetViewLocation(Sequence->StartLocation);
+            ViewportClient->SetViewRotation(Sequence->StartRotation);
+            ViewportClient->Invalidate();
+        }
+        if (Sequence->Completion)
+        {
+            FUnrealCompanionDeferredResponse::FCompletion Completion = MoveTemp(Sequence->Completion);
+            Completion(BuildSequenceResult(*Sequence, true));
+        }
+        return false;
+    }));
+    return nullptr;
+}
+
 // =============================================================================
 // PLAY IN EDITOR CONTROL
 // =============================================================================
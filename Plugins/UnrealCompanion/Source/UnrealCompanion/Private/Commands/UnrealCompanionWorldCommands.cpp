@@ -1,6 +1,7 @@
 #include "Commands/UnrealCompanionWorldCommands.h"
 #include "Commands/UnrealCompanionCommonUtils.h"
 #include "Commands/UnrealCompanionEditorFocus.h"
+#include "Commands/UnrealCompanionActorIndex.h"
 #include "Editor.h"
 #include "GameFramework/Actor.h"
 #include "Engine/Selection.h"
@@ -112,25 +113,17 @@ TSharedPtr<FJsonObject> FUnrealCompanionWorldCommands::HandleCommand(const FStri
 
 AActor* FUnrealCompanionWorldCommands::FindActorByName(const FString& ActorName)
 {
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
-    {
-        if (Actor && (Actor->GetName() == ActorName || Actor->GetActorLabel() == ActorName))
-        {
-            return Actor;
-        }
-    }
-    return nullptr;
+    // Indexed lookup: batch handlers call this once per item
+    return FUnrealCompanionActorIndex::Get().FindByName(GWorld, ActorName);
 }
 
 TSharedPtr<FJsonObject> FUnrealCompanionWorldCommands::HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params)
 {
     TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
+    FUnrealCompanionActorIndex::Get().GetAllActors(GWorld, AllActors);
     
     TArray<TSharedPtr<FJsonValue>> ActorArray;
+    ActorArray.Reserve(AllActors.Num());
     for (AActor* Actor : AllActors)
     {
         if (Actor)
@@ -154,16 +147,15 @@ TSharedPtr<FJsonObject> FUnrealCompanionWorldCommands::HandleFindActorsByName(co
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Missing 'pattern' parameter"));
     }
     
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
+    // Substring match over the index's name/label keys instead of copying every actor in the world
+    TArray<AActor*> Found;
+    FUnrealCompanionActorIndex::Get().FindByNameSubstring(GWorld, Pattern, Found);
     
     TArray<TSharedPtr<FJsonValue>> MatchingActors;
-    for (AActor* Actor : AllActors)
+    MatchingActors.Reserve(Found.Num());
+    for (AActor* Actor : Found)
     {
-        if (Actor && (Actor->GetName().Contains(Pattern) || Actor->GetActorLabel().Contains(Pattern)))
-        {
-            MatchingActors.Add(FUnrealCompanionCommonUtils::ActorToJson(Actor));
-        }
+        MatchingActors.Add(FUnrealCompanionCommonUtils::ActorToJson(Actor));
     }
     
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -303,6 +295,12 @@ TSharedPtr<FJsonObject> FUnrealCompanionWorldCommands::HandleSpawnBlueprintActor
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
     }
 
+    // Spawning under a name already taken in the level is fatal, so reject it up front
+    if (FUnrealCompanionActorIndex::Get().FindByName(World, ActorName))
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor with name '%s' already exists"), *ActorName));
+    }
+
     FTransform SpawnTransform;
     SpawnTransform.SetLocation(Location);
     SpawnTransform.SetRotation(FQuat(Rotation));
@@ -374,6 +372,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionWorldCommands::HandleSetActorTransform(c
     }
 
     TargetActor->SetActorTransform(NewTransform);
+    FUnrealCompanionActorIndex::Get().NotifyActorChanged(TargetActor);
 
     return FUnrealCompanionCommonUtils::ActorToJsonObject(TargetActor, true);
 }
@@ -463,7 +462,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionWorldCommands::HandleSpawnBatch(const TS
     
     FScopedTransaction Transaction(FText::FromString(TEXT("MCP World Spawn Batch")));
     
-    TMap<FString, AActor*> RefToActor;
+    TScratchMap<FString, AActor*> RefToActor;
     TArray<TSharedPtr<FJsonObject>> Results;
     TArray<TSharedPtr<FJsonObject>> Errors;
     int32 Spawned = 0;
@@ -475,86 +474,141 @@ TSharedPtr<FJsonObject> FUnrealCompanionWorldCommands::HandleSpawnBatch(const TS
         return FUnrealCompanionCommonUtils::CreateErrorResponse(TEXT("No active world"));
     }
     
+    FUnrealCompanionActorIndex& ActorIndex = FUnrealCompanionActorIndex::Get();
+    
+    struct FPendingSpawn
+    {
+        FString Ref;
+        FString Name;
+        UClass* Class = nullptr;
+        ESpawnActorCollisionHandlingMethod Collision = ESpawnActorCollisionHandlingMethod::Undefined;
+        FTransform Transform;
+        AActor* Actor = nullptr;
+    };
+    
+    // Phase 1: resolve every entry. Each distinct blueprint is looked up once, not once per actor
+    TScratchMap<FString, UClass*> BlueprintClasses;
+    TScratchSet<FString> ClaimedNames;
+    TArray<FPendingSpawn> Pending;
+    Pending.Reserve(ActorsArray->Num());
+    
     for (int32 i = 0; i < ActorsArray->Num(); i++)
     {
         const TSharedPtr<FJsonObject>& ActorObj = (*ActorsArray)[i]->AsObject();
         if (!ActorObj.IsValid()) continue;
         
-        FString Ref = ActorObj->GetStringField(TEXT("ref"));
-        FString ActorName = ActorObj->GetStringField(TEXT("name"));
+        FPendingSpawn Spawn;
+        Spawn.Ref = ActorObj->GetStringField(TEXT("ref"));
+        Spawn.Name = ActorObj->GetStringField(TEXT("name"));
         FString BlueprintName = ActorObj->GetStringField(TEXT("blueprint"));
         FString ActorType = ActorObj->GetStringField(TEXT("type"));
         
         FVector Location = FUnrealCompanionCommonUtils::GetVectorFromJson(ActorObj, TEXT("location"));
         FRotator Rotation = FUnrealCompanionCommonUtils::GetRotatorFromJson(ActorObj, TEXT("rotation"));
+        Spawn.Transform = FTransform(Rotation, Location);
         
-        AActor* SpawnedActor = nullptr;
+        FString SpawnError = TEXT("Failed to spawn actor");
         
+        // Name collision check against the actor index and the names claimed earlier in this batch,
+        // not a full-world scan per item
+        if (!Spawn.Name.IsEmpty() && (ClaimedNames.Contains(Spawn.Name) || ActorIndex.FindByName(World, Spawn.Name)))
+        {
+            SpawnError = FString::Printf(TEXT("Actor with name '%s' already exists"), *Spawn.Name);
+        }
         // Spawn from Blueprint
-        if (!BlueprintName.IsEmpty())
+        else if (!BlueprintName.IsEmpty())
         {
-            UBlueprint* Blueprint = FUnrealCompanionCommonUtils::FindBlueprint(BlueprintName);
-            if (Blueprint && Blueprint->GeneratedClass)
+            if (UClass** Cached = BlueprintClasses.Find(BlueprintName))
             {
-                FActorSpawnParameters SpawnParams;
-                SpawnParams.Name = ActorName.IsEmpty() ? NAME_None : FName(*ActorName);
-                SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-                
-                SpawnedActor = World->SpawnActor<AActor>(Blueprint->GeneratedClass, Location, Rotation, SpawnParams);
-                if (SpawnedActor && !ActorName.IsEmpty())
-                {
-                    SpawnedActor->SetActorLabel(*ActorName);
-                }
+                Spawn.Class = *Cached;
             }
+            else
+            {
+                UBlueprint* Blueprint = FUnrealCompanionCommonUtils::FindBlueprint(BlueprintName);
+                Spawn.Class = Blueprint ? Blueprint->GeneratedClass.Get() : nullptr;
+                BlueprintClasses.Add(BlueprintName, Spawn.Class);
+            }
+            Spawn.Collision = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
         }
         // Spawn by type
         else if (!ActorType.IsEmpty())
         {
-            UClass* ActorClass = nullptr;
-            if (ActorType == TEXT("PointLight")) ActorClass = APointLight::StaticClass();
-            else if (ActorType == TEXT("SpotLight")) ActorClass = ASpotLight::StaticClass();
-            else if (ActorType == TEXT("DirectionalLight")) ActorClass = ADirectionalLight::StaticClass();
-            else if (ActorType == TEXT("StaticMeshActor")) ActorClass = AStaticMeshActor::StaticClass();
-            else if (ActorType == TEXT("CameraActor")) ActorClass = ACameraActor::StaticClass();
-            
-            if (ActorClass)
-            {
-                FActorSpawnParameters SpawnParams;
-                SpawnParams.Name = ActorName.IsEmpty() ? NAME_None : FName(*ActorName);
-                
-                SpawnedActor = World->SpawnActor<AActor>(ActorClass, Location, Rotation, SpawnParams);
-                if (SpawnedActor && !ActorName.IsEmpty())
-                {
-                    SpawnedActor->SetActorLabel(*ActorName);
-                }
-            }
+            if (ActorType == TEXT("PointLight")) Spawn.Class = APointLight::StaticClass();
+            else if (ActorType == TEXT("SpotLight")) Spawn.Class = ASpotLight::StaticClass();
+            else if (ActorType == TEXT("DirectionalLight")) Spawn.Class = ADirectionalLight::StaticClass();
+            else if (ActorType == TEXT("StaticMeshActor")) Spawn.Class = AStaticMeshActor::StaticClass();
+            else if (ActorType == TEXT("CameraActor")) Spawn.Class = ACameraActor::StaticClass();
         }
         
-        if (SpawnedActor)
+        if (Spawn.Class)
         {
-            if (!Ref.IsEmpty()) RefToActor.Add(Ref, SpawnedActor);
-            Spawned++;
-            
-            TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-            ResultObj->SetStringField(TEXT("ref"), Ref);
-            ResultObj->SetStringField(TEXT("name"), SpawnedActor->GetActorLabel());
-            ResultObj->SetStringField(TEXT("class"), SpawnedActor->GetClass()->GetName());
-            Results.Add(ResultObj);
+            if (!Spawn.Name.IsEmpty()) ClaimedNames.Add(Spawn.Name);
+            Pending.Add(MoveTemp(Spawn));
+            continue;
         }
-        else
+        
+        Failed++;
+        TSharedPtr<FJsonObject> ErrorObj = MakeShared<FJsonObject>();
+        ErrorObj->SetStringField(TEXT("ref"), Spawn.Ref);
+        ErrorObj->SetStringField(TEXT("error"), SpawnError);
+        Errors.Add(ErrorObj);
+        
+        // Nothing has been spawned yet, so rollback has nothing to undo
+        if (StdParams.OnError == TEXT("rollback"))
         {
-            Failed++;
-            TSharedPtr<FJsonObject> ErrorObj = MakeShared<FJsonObject>();
-            ErrorObj->SetStringField(TEXT("ref"), Ref);
-            ErrorObj->SetStringField(TEXT("error"), TEXT("Failed to spawn actor"));
-            Errors.Add(ErrorObj);
-            
-            if (StdParams.OnError == TEXT("rollback"))
+            Transaction.Cancel();
+            return FUnrealCompanionCommonUtils::CreateBatchResponse(false, 0, Failed, TArray<TSharedPtr<FJsonObject>>(), Errors);
+        }
+    }
+    
+    // Phase 2: spawn with deferred construction; construction scripts wait for phase 3
+    for (FPendingSpawn& Spawn : Pending)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.Name = Spawn.Name.IsEmpty() ? NAME_None : FName(*Spawn.Name);
+        SpawnParams.SpawnCollisionHandlingOverride = Spawn.Collision;
+        SpawnParams.bDeferConstruction = true;
+        
+        Spawn.Actor = World->SpawnActor<AActor>(Spawn.Class, Spawn.Transform, SpawnParams);
+        if (Spawn.Actor) continue;
+        
+        Failed++;
+        TSharedPtr<FJsonObject> ErrorObj = MakeShared<FJsonObject>();
+        ErrorObj->SetStringField(TEXT("ref"), Spawn.Ref);
+        ErrorObj->SetStringField(TEXT("error"), TEXT("Failed to spawn actor"));
+        Errors.Add(ErrorObj);
+        
+        if (StdParams.OnError == TEXT("rollback"))
+        {
+            // The deferred actors never ran construction: destroy them rather than finish them
+            for (const FPendingSpawn& Other : Pending)
             {
-                Transaction.Cancel();
-                return FUnrealCompanionCommonUtils::CreateBatchResponse(false, 0, Failed, TArray<TSharedPtr<FJsonObject>>(), Errors);
+                if (Other.Actor) World->DestroyActor(Other.Actor);
             }
+            Transaction.Cancel();
+            return FUnrealCompanionCommonUtils::CreateBatchResponse(false, 0, Failed, TArray<TSharedPtr<FJsonObject>>(), Errors);
+        }
+    }
+    
+    // Phase 3: run construction and component registration for the whole batch back to back
+    for (const FPendingSpawn& Spawn : Pending)
+    {
+        if (!Spawn.Actor) continue;
+        
+        Spawn.Actor->FinishSpawning(Spawn.Transform);
+        if (!Spawn.Name.IsEmpty())
+        {
+            Spawn.Actor->SetActorLabel(*Spawn.Name);
         }
+        
+        if (!Spawn.Ref.IsEmpty()) RefToActor.Add(Spawn.Ref, Spawn.Actor);
+        Spawned++;
+        
+        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+        ResultObj->SetStringField(TEXT("ref"), Spawn.Ref);
+        ResultObj->SetStringField(TEXT("name"), Spawn.Actor->GetActorLabel());
+        ResultObj->SetStringField(TEXT("class"), Spawn.Actor->GetClass()->GetName());
+        Results.Add(ResultObj);
     }
     
     TSharedPtr<FJsonObject> ResponseData = MakeShared<FJsonObject>();
@@ -595,6 +649,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionWorldCommands::HandleSetBatch(const TSha
     }
     
     FScopedTransaction Transaction(FText::FromString(TEXT("MCP World Set Batch")));
+    FUnrealCompanionCommonUtils::FScopedPropertyCache PropertyCache;
     
     int32 Modified = 0;
     int32 Failed = 0;
@@ -683,6 +738,9 @@ TSharedPtr<FJsonObject> FUnrealCompanionWorldCommands::HandleSetBatch(const TSha
         
         if (bModified)
         {
+            // Transforms/tags set from code don't raise editor notifications
+            FUnrealCompanionActorIndex::Get().NotifyActorChanged(TargetActor);
+            
             Modified++;
             TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
             ResultObj->SetStringField(TEXT("actor"), ActorName);
@@ -907,6 +965,7 @@ TSharedPtr<FJsonObject> FUnrealCompanionWorldCommands::HandleDuplicateActor(cons
     {
         DuplicatedActor->SetActorLabel(NewName);
     }
+    FUnrealCompanionActorIndex::Get().NotifyActorChanged(DuplicatedActor);
     
     TSharedPtr<FJsonObject> ResponseData = MakeShared<FJsonObject>();
     ResponseData->SetBoolField(TEXT("success"), true);
@@ -0,0 +1,745 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Graph/GraphBatchValidation.h"
+#include "Graph/GraphOperations.h"
+#include "Graph/NodeFactory/INodeFactory.h"
+#include "Commands/UnrealCompanionAssetIndex.h"
+#include "Commands/UnrealCompanionCommonUtils.h"
+#include "Commands/UnrealCompanionScratch.h"
+
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "EdGraphSchema_K2.h"
+#include "Editor.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Event.h"
+#include "K2Node_MacroInstance.h"
+#include "K2Node_Variable.h"
+#include "Misc/PackageName.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+
+using namespace UnrealCompanionGraph;
+
+// =========================================================================
+// PIN SIGNATURE CACHE
+// =========================================================================
+
+FPinSignatureCache& FPinSignatureCache::Get()
+{
+    static FPinSignatureCache Instance;
+    return Instance;
+}
+
+void FPinSignatureCache::Initialize()
+{
+    check(IsInGameThread());
+    if (ReloadCompleteHandle.IsValid())
+    {
+        return;
+    }
+
+    ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([this](EReloadCompleteReason) { Empty(); });
+    if (GEditor)
+    {
+        BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FPinSignatureCache::OnBlueprintCompiled);
+    }
+}
+
+void FPinSignatureCache::Shutdown()
+{
+    if (ReloadCompleteHandle.IsValid())
+    {
+        FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+        if (GEditor)
+        {
+            GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+        }
+        ReloadCompleteHandle.Reset();
+    }
+    Empty();
+}
+
+FString FPinSignatureCache::MakeKey(EGraphType GraphType, const TSharedPtr<FJsonObject>& NodeSpec)
+{
+    FString Type;
+    NodeSpec->TryGetStringField(TEXT("type"), Type);
+
+    // Independent of field order; ref and position don't change the pins
+    TArray<FString> Fields;
+    NodeSpec->Values.GetKeys(Fields);
+    Fields.Sort();
+
+    FString Key = GetGraphTypeName(GraphType) + TEXT('|') + Type.ToLower();
+    for (const FString& Field : Fields)
+    {
+        if (Field == TEXT("type") || Field == TEXT("ref") || Field == TEXT("position"))
+        {
+            continue;
+        }
+        Key += TEXT('\n');
+        Key += Field;
+        Key += TEXT('=');
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Key);
+        FJsonSerializer::Serialize(NodeSpec->Values[Field], FString(), Writer);
+    }
+    return Key;
+}
+
+void FPinSignatureCache::Record(EGraphType GraphType, const TSharedPtr<FJsonObject>& NodeSpec, const UEdGraphNode* Node)
+{
+    check(IsInGameThread());
+    if (!Node || !NodeSpec.IsValid() || GraphType == EGraphType::Niagara)
+    {
+        return;
+    }
+
+    FEntry Entry;
+    Entry.bBlueprintDependent = DependsOnBlueprintMembers(Node);
+    Entry.Pins.Reserve(Node->Pins.Num());
+    for (const UEdGraphPin* Pin : Node->Pins)
+    {
+        if (!Pin)
+        {
+            continue;
+        }
+        FCachedPinSignature& Signature = Entry.Pins.AddDefaulted_GetRef();
+        Signature.Name = Pin->PinName.ToString();
+        Signature.FriendlyName = Pin->PinFriendlyName.ToString();
+        Signature.bOutput = Pin->Direction == EGPD_Output;
+        Signature.bExec = Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec;
+        Signature.PinCategory = Pin->PinType.PinCategory;
+        Signature.PinSubCategory = Pin->PinType.PinSubCategory;
+        if (const UObject* TypeObject = Pin->PinType.PinSubCategoryObject.Get())
+        {
+            Signature.SubCategoryObjectPath = TypeObject->GetPathName();
+        }
+        Signature.ContainerType = Pin->PinType.ContainerType;
+    }
+
+    const FString Key = MakeKey(GraphType, NodeSpec);
+    FWriteScopeLock WriteLock(Lock);
+    if (Entries.Num() >= MaxEntries && !Entries.Contains(Key))
+    {
+        Entries.Reset();
+    }
+    Entries.Add(Key, MoveTemp(Entry));
+}
+
+bool FPinSignatureCache::Find(const FString& Key, TArray<FCachedPinSignature>& OutPins) const
+{
+    FReadScopeLock ReadLock(Lock);
+    if (const FEntry* Entry = Entries.Find(Key))
+    {
+        OutPins = Entry->Pins;
+        return true;
+    }
+    return false;
+}
+
+int32 FPinSignatureCache::Num() const
+{
+    FReadScopeLock ReadLock(Lock);
+    return Entries.Num();
+}
+
+namespace
+{
+    /** Native types and functions live in /Script/ packages and only change with a hot reload */
+    bool IsScriptObject(const UObject* Object)
+    {
+        return Object && Object->GetPackage()->GetName().StartsWith(TEXT("/Script/"));
+    }
+}
+
+bool FPinSignatureCache::DependsOnBlueprintMembers(const UEdGraphNode* Node)
+{
+    if (Node->IsA<UK2Node_Variable>() || Node->IsA<UK2Node_MacroInstance>())
+    {
+        return true;
+    }
+    if (const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
+    {
+        if (!IsScriptObject(CallNode->GetTargetFunction()))
+        {
+            return true;
+        }
+    }
+    else if (const UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+    {
+        // Custom events have no native signature
+        if (!IsScriptObject(EventNode->FindEventSignatureFunction()))
+        {
+            return true;
+        }
+    }
+
+    // Casts, struct make/break and the like take their pins from the type they name
+    for (const UEdGraphPin* Pin : Node->Pins)
+    {
+        const UObject* TypeObject = Pin ? Pin->PinType.PinSubCategoryObject.Get() : nullptr;
+        if (TypeObject && !IsScriptObject(TypeObject))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FPinSignatureCache::OnBlueprintCompiled()
+{
+    FWriteScopeLock WriteLock(Lock);
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        if (It.Value().bBlueprintDependent)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FPinSignatureCache::Empty()
+{
+    FWriteScopeLock WriteLock(Lock);
+    Entries.Empty();
+}
+
+// =========================================================================
+// BATCH VALIDATION
+// =========================================================================
+
+namespace
+{
+    /** The graph type HandleGraphBatch would pick: the graph_type hint, else the asset's class */
+    EGraphType ResolveGraphType(const FString& AssetName, const FString& GraphTypeHint, bool& bOutAssetFound)
+    {
+        FUnrealCompanionAssetIndex& AssetIndex = FUnrealCompanionAssetIndex::Get();
+        FSoftObjectPath ObjectPath;
+        bOutAssetFound = AssetIndex.FindAsset(AssetName, nullptr, false, false, ObjectPath);
+
+        const EGraphType Requested = ParseGraphType(GraphTypeHint);
+        if (Requested != EGraphType::Unknown || !bOutAssetFound)
+        {
+            return Requested;
+        }
+
+        const FString ClassName = AssetIndex.GetAssetClass(ObjectPath).GetAssetName().ToString();
+        if (ClassName.EndsWith(TEXT("AnimBlueprint")))
+        {
+            return EGraphType::Animation;
+        }
+        if (ClassName.EndsWith(TEXT("WidgetBlueprint")))
+        {
+            return EGraphType::Widget;
+        }
+        if (ClassName.EndsWith(TEXT("Blueprint")))
+        {
+            return EGraphType::Blueprint;
+        }
+        if (ClassName == TEXT("Material") || ClassName == TEXT("MaterialFunction"))
+        {
+            return EGraphType::Material;
+        }
+        return EGraphType::Unknown;
+    }
+
+    /** UnrealCompanionPin::FindPin's rules: name or friendly name, case-insensitive, preferred direction first */
+    const FCachedPinSignature* FindCachedPin(const TArray<FCachedPinSignature>& Pins, const FString& PinName, bool bPreferOutput)
+    {
+        const FCachedPinSignature* OtherDirection = nullptr;
+        for (const FCachedPinSignature& Pin : Pins)
+        {
+            if (!Pin.Name.Equals(PinName, ESearchCase::IgnoreCase)
+                && (Pin.FriendlyName.IsEmpty() || !Pin.FriendlyName.Equals(PinName, ESearchCase::IgnoreCase)))
+            {
+                continue;
+            }
+            if (Pin.bOutput == bPreferOutput)
+            {
+                return &Pin;
+            }
+            if (!OtherDirection)
+            {
+                OtherDirection = &Pin;
+            }
+        }
+        return OtherDirection;
+    }
+
+    enum class EPinTypeMatch : uint8
+    {
+        Compatible,
+        Unchecked,      // Hangs on an autocast or a class/struct relationship: left to the schema
+        Incompatible
+    };
+
+    bool IsNumericCategory(const FName Category)
+    {
+        return Category == UEdGraphSchema_K2::PC_Boolean || Category == UEdGraphSchema_K2::PC_Byte
+            || Category == UEdGraphSchema_K2::PC_Int || Category == UEdGraphSchema_K2::PC_Int64
+            || Category == UEdGraphSchema_K2::PC_Real;
+    }
+
+    bool IsTextCategory(const FName Category)
+    {
+        return Category == UEdGraphSchema_K2::PC_String || Category == UEdGraphSchema_K2::PC_Name || Category == UEdGraphSchema_K2::PC_Text;
+    }
+
+    bool IsObjectCategory(const FName Category)
+    {
+        return Category == UEdGraphSchema_K2::PC_Object || Category == UEdGraphSchema_K2::PC_Class
+            || Category == UEdGraphSchema_K2::PC_SoftObject || Category == UEdGraphSchema_K2::PC_SoftClass
+            || Category == UEdGraphSchema_K2::PC_Interface;
+    }
+
+    /**
+     * Can a K2 data output of type Source feed an input of type Target?
+     *
+     * Only decides from the cached categories: class hierarchies and the
+     * autocast functions (UKismet*Library BlueprintAutocast) need the game
+     * thread, so any pair one of them could join is Unchecked. The families
+     * they join: numbers among themselves, numbers into structs (float to
+     * Vector), strings/names/texts to and from almost anything, objects,
+     * classes and interfaces among themselves, and structs into structs.
+     */
+    EPinTypeMatch MatchPinTypes(const FCachedPinSignature& Source, const FCachedPinSignature& Target)
+    {
+        if (Source.PinCategory == UEdGraphSchema_K2::PC_Wildcard || Target.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+        {
+            return EPinTypeMatch::Compatible;
+        }
+        if (Source.ContainerType != Target.ContainerType)
+        {
+            return EPinTypeMatch::Incompatible;
+        }
+        if (Source.ContainerType == EPinContainerType::Map)
+        {
+            // The value type is not cached
+            return EPinTypeMatch::Unchecked;
+        }
+
+        if (Source.PinCategory == Target.PinCategory)
+        {
+            // Float and double reals convert implicitly; a plain byte takes any enum and vice versa
+            if (Source.SubCategoryObjectPath == Target.SubCategoryObjectPath
+                || (Source.PinCategory == UEdGraphSchema_K2::PC_Byte && (Source.SubCategoryObjectPath.IsEmpty() || Target.SubCategoryObjectPath.IsEmpty())))
+            {
+                return EPinTypeMatch::Compatible;
+            }
+            // Subclass, interface or struct conversion
+            return EPinTypeMatch::Unchecked;
+        }
+
+        // Autocasts only exist for single values
+        if (Source.ContainerType != EPinContainerType::None)
+        {
+            return EPinTypeMatch::Incompatible;
+        }
+
+        const FName From = Source.PinCategory;
+        const FName To = Target.PinCategory;
+        const bool bAutocastFamily = (IsNumericCategory(From) && (IsNumericCategory(To) || To == UEdGraphSchema_K2::PC_Struct))
+            || IsTextCategory(From) || IsTextCategory(To)
+            || (IsObjectCategory(From) && IsObjectCategory(To))
+            || (From == UEdGraphSchema_K2::PC_Struct && To == UEdGraphSchema_K2::PC_Struct);
+        return bAutocastFamily ? EPinTypeMatch::Unchecked : EPinTypeMatch::Incompatible;
+    }
+
+    bool HasTypedPins(EGraphType GraphType)
+    {
+        // Material and other schemas use pin categories for roles, not value types
+        return GraphType == EGraphType::Blueprint || GraphType == EGraphType::Animation || GraphType == EGraphType::Widget;
+    }
+
+    FString DescribePinType(const FCachedPinSignature& Pin)
+    {
+        FString Type = Pin.SubCategoryObjectPath.IsEmpty()
+            ? Pin.PinCategory.ToString()
+            : FPackageName::ObjectPathToObjectName(Pin.SubCategoryObjectPath);
+        if (Pin.ContainerType == EPinContainerType::Array)
+        {
+            Type = FString::Printf(TEXT("array of %s"), *Type);
+        }
+        else if (Pin.ContainerType == EPinContainerType::Set)
+        {
+            Type = FString::Printf(TEXT("set of %s"), *Type);
+        }
+        else if (Pin.ContainerType == EPinContainerType::Map)
+        {
+            Type = FString::Printf(TEXT("map of %s"), *Type);
+        }
+        return Type;
+    }
+
+    bool IsGuid(const FString& Text)
+    {
+        FGuid Guid;
+        return FGuid::Parse(Text, Guid);
+    }
+
+    FString GetString(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field)
+    {
+        FString Value;
+        Object->TryGetStringField(Field, Value);
+        return Value;
+    }
+}
+
+void FGraphBatchValidation::AddError(const TCHAR* Section, int32 Index, const FString& Ref, const FString& Message)
+{
+    Errors.Add(Ref.IsEmpty()
+        ? FString::Printf(TEXT("%s[%d]: %s"), Section, Index, *Message)
+        : FString::Printf(TEXT("%s[%d] '%s': %s"), Section, Index, *Ref, *Message));
+}
+
+FGraphBatchValidation FGraphBatchValidation::Run(const TSharedPtr<FJsonObject>& Params, const FString& AssetName, const FString& GraphTypeHint)
+{
+    // Runs while the request is parsed, outside any handler call: the refs below live in our own scratch scope
+    FUnrealCompanionScratch::FScope ScratchScope;
+
+    FGraphBatchValidation Result;
+    Result.GraphType = ResolveGraphType(AssetName, GraphTypeHint, Result.bAssetFound);
+    if (!Result.bAssetFound)
+    {
+        Result.Warnings.Add(FString::Printf(TEXT("Asset '%s' is not in the asset registry yet; it is looked up again when the batch runs"), *AssetName));
+    }
+
+    const FNodeFactoryRegistry& Registry = FNodeFactoryRegistry::Get();
+    TSharedPtr<INodeFactory> Factory = Registry.GetFactory(Result.GraphType);
+    if (Result.GraphType != EGraphType::Unknown && !Factory)
+    {
+        Result.Errors.Add(FString::Printf(TEXT("No factory available for graph type: %s"), *GetGraphTypeName(Result.GraphType)));
+    }
+
+    // =========================================================================
+    // EXISTING NODES (remove, enable, split pins, ...)
+    // =========================================================================
+    for (const TCHAR* Section : { TEXT("remove"), TEXT("break_links"), TEXT("enable_nodes"), TEXT("disable_nodes"), TEXT("reconstruct_nodes") })
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Ids = nullptr;
+        if (!Params->TryGetArrayField(Section, Ids))
+        {
+            continue;
+        }
+        for (int32 Index = 0; Index < Ids->Num(); ++Index)
+        {
+            FString NodeId;
+            if (!(*Ids)[Index]->TryGetString(NodeId) || !IsGuid(NodeId))
+            {
+                Result.AddError(Section, Index, FString(), TEXT("Expected a node GUID"));
+                continue;
+            }
+            Result.ExistingNodeOps++;
+        }
+    }
+
+    for (const TCHAR* Section : { TEXT("split_pins"), TEXT("recombine_pins"), TEXT("break_pin_links") })
+    {
+        const TArray<TSharedPtr<FJsonValue>>* PinOps = nullptr;
+        if (!Params->TryGetArrayField(Section, PinOps))
+        {
+            continue;
+        }
+        for (int32 Index = 0; Index < PinOps->Num(); ++Index)
+        {
+            const TSharedPtr<FJsonObject>* PinOp = nullptr;
+            if (!(*PinOps)[Index]->TryGetObject(PinOp))
+            {
+                Result.AddError(Section, Index, FString(), TEXT("Expected {node_id, pin}"));
+                continue;
+            }
+            if (!IsGuid(GetString(*PinOp, TEXT("node_id"))))
+            {
+                Result.AddError(Section, Index, FString(), TEXT("'node_id' must be a node GUID"));
+            }
+            else if (GetString(*PinOp, TEXT("pin")).IsEmpty())
+            {
+                Result.AddError(Section, Index, FString(), TEXT("Missing 'pin'"));
+            }
+            else
+            {
+                Result.ExistingNodeOps++;
+            }
+        }
+    }
+
+    // =========================================================================
+    // NEW NODES AND STATE MACHINES (the refs later sections may use)
+    // =========================================================================
+    TScratchSet<FString> Refs;
+    TScratchMap<FString, TArray<FCachedPinSignature>> RefPins;
+
+    const TArray<TSharedPtr<FJsonValue>>* Nodes = nullptr;
+    if (Params->TryGetArrayField(TEXT("nodes"), Nodes))
+    {
+        FPinSignatureCache& SignatureCache = FPinSignatureCache::Get();
+        for (int32 Index = 0; Index < Nodes->Num(); ++Index)
+        {
+            const TSharedPtr<FJsonObject>* NodeSpec = nullptr;
+            if (!(*Nodes)[Index]->TryGetObject(NodeSpec))
+            {
+                Result.AddError(TEXT("nodes"), Index, FString(), TEXT("Expected an object"));
+                continue;
+            }
+
+            const FString Ref = GetString(*NodeSpec, TEXT("ref"));
+            const FString NodeType = GetString(*NodeSpec, TEXT("type"));
+            if (NodeType.IsEmpty())
+            {
+                Result.AddError(TEXT("nodes"), Index, Ref, TEXT("Missing 'type'"));
+            }
+            else if (Factory ? !Factory->SupportsNodeType(NodeType) : !Registry.IsNodeTypeSupported(NodeType))
+            {
+                Result.AddError(TEXT("nodes"), Index, Ref, Factory
+                    ? FString::Printf(TEXT("Unknown node type '%s' for %s graphs"), *NodeType, *GetGraphTypeName(Result.GraphType))
+                    : FString::Printf(TEXT("Unknown node type '%s'"), *NodeType));
+            }
+
+            if (!Ref.IsEmpty())
+            {
+                bool bDuplicate = false;
+                Refs.Add(Ref, &bDuplicate);
+                if (bDuplicate)
+                {
+                    Result.AddError(TEXT("nodes"), Index, Ref, TEXT("Duplicate ref"));
+                }
+                else if (Result.GraphType != EGraphType::Unknown)
+                {
+                    TArray<FCachedPinSignature> Pins;
+                    if (SignatureCache.Find(FPinSignatureCache::MakeKey(Result.GraphType, *NodeSpec), Pins))
+                    {
+                        RefPins.Add(Ref, MoveTemp(Pins));
+                    }
+                }
+            }
+            Result.NodesPlanned++;
+        }
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* Machines = nullptr;
+    if (Params->TryGetArrayField(TEXT("state_machines"), Machines) && Machines->Num() > 0)
+    {
+        if (Result.GraphType != EGraphType::Unknown && Result.GraphType != EGraphType::Animation)
+        {
+            Result.Errors.Add(TEXT("state_machines needs an Animation Blueprint graph"));
+        }
+        for (int32 Index = 0; Index < Machines->Num(); ++Index)
+        {
+            const TSharedPtr<FJsonObject>* MachineSpec = nullptr;
+            if (!(*Machines)[Index]->TryGetObject(MachineSpec))
+            {
+                Result.AddError(TEXT("state_machines"), Index, FString(), TEXT("Expected an object"));
+                continue;
+            }
+            const FString Ref = GetString(*MachineSpec, TEXT("ref"));
+            bool bDuplicate = false;
+            if (!Ref.IsEmpty())
+            {
+                Refs.Add(Ref, &bDuplicate);
+            }
+            if (bDuplicate)
+            {
+                Result.AddError(TEXT("state_machines"), Index, Ref, TEXT("Duplicate ref"));
+            }
+        }
+    }
+
+    // =========================================================================
+    // CONNECTIONS
+    // =========================================================================
+    // An endpoint is a ref from this batch or the GUID of an existing node; the id wins when both are given
+    auto CheckEndpoint = [&Result, &Refs](const TCHAR* Section, int32 Index, const FString& Ref, const FString& Id, const TCHAR* Side) -> bool
+    {
+        if (!Id.IsEmpty())
+        {
+            if (!IsGuid(Id))
+            {
+                Result.AddError(Section, Index, Ref, FString::Printf(TEXT("%s id '%s' is not a node GUID"), Side, *Id));
+                return false;
+            }
+            return true;
+        }
+        if (Ref.IsEmpty())
+        {
+            Result.AddError(Section, Index, FString(), FString::Printf(TEXT("Missing %s ref or id"), Side));
+            return false;
+        }
+        if (!Refs.Contains(Ref))
+        {
+            Result.AddError(Section, Index, Ref, FString::Printf(TEXT("%s ref is not created by this batch"), Side));
+            return false;
+        }
+        return true;
+    };
+
+    int32 ConnectionsUnchecked = 0;
+    const TArray<TSharedPtr<FJsonValue>>* Connections = nullptr;
+    if (Params->TryGetArrayField(TEXT("connections"), Connections))
+    {
+        for (int32 Index = 0; Index < Connections->Num(); ++Index)
+        {
+            const TSharedPtr<FJsonObject>* Connection = nullptr;
+            if (!(*Connections)[Index]->TryGetObject(Connection))
+            {
+                Result.AddError(TEXT("connections"), Index, FString(), TEXT("Expected an object"));
+                continue;
+            }
+            Result.ConnectionsPlanned++;
+
+            const FString SourceRef = GetString(*Connection, TEXT("source_ref"));
+            const FString SourceId = GetString(*Connection, TEXT("source_id"));
+            const FString SourcePin = GetString(*Connection, TEXT("source_pin"));
+            const FString TargetRef = GetString(*Connection, TEXT("target_ref"));
+            const FString TargetId = GetString(*Connection, TEXT("target_id"));
+            const FString TargetPin = GetString(*Connection, TEXT("target_pin"));
+
+            const bool bSourceOk = CheckEndpoint(TEXT("connections"), Index, SourceRef, SourceId, TEXT("source"));
+            const bool bTargetOk = CheckEndpoint(TEXT("connections"), Index, TargetRef, TargetId, TEXT("target"));
+            if (SourcePin.IsEmpty() || TargetPin.IsEmpty())
+            {
+                Result.AddError(TEXT("connections"), Index, FString(), TEXT("Missing 'source_pin' or 'target_pin'"));
+                continue;
+            }
+            if (!bSourceOk || !bTargetOk)
+            {
+                continue;
+            }
+
+            const TArray<FCachedPinSignature>* SourcePins = SourceId.IsEmpty() ? RefPins.Find(SourceRef) : nullptr;
+            const TArray<FCachedPinSignature>* TargetPins = TargetId.IsEmpty() ? RefPins.Find(TargetRef) : nullptr;
+
+            const FCachedPinSignature* Source = SourcePins ? FindCachedPin(*SourcePins, SourcePin, true) : nullptr;
+            const FCachedPinSignature* Target = TargetPins ? FindCachedPin(*TargetPins, TargetPin, false) : nullptr;
+            if (SourcePins && !Source)
+            {
+                Result.AddError(TEXT("connections"), Index, SourceRef, FString::Printf(TEXT("Source pin '%s' not found"), *SourcePin));
+            }
+            if (TargetPins && !Target)
+            {
+                Result.AddError(TEXT("connections"), Index, TargetRef, FString::Printf(TEXT("Target pin '%s' not found"), *TargetPin));
+            }
+            if (!Source || !Target)
+            {
+                ConnectionsUnchecked += (SourcePins && TargetPins) ? 0 : 1;
+                continue;
+            }
+
+            Result.ConnectionsChecked++;
+            if (Source->bExec != Target->bExec)
+            {
+                Result.AddError(TEXT("connections"), Index, SourceRef, FString::Printf(TEXT("Cannot link %s pin '%s' to %s pin '%s'"),
+                    Source->bExec ? TEXT("exec") : TEXT("data"), *SourcePin, Target->bExec ? TEXT("exec") : TEXT("data"), *TargetPin));
+            }
+            else if (Source->bOutput == Target->bOutput)
+            {
+                Result.AddError(TEXT("connections"), Index, SourceRef, FString::Printf(TEXT("'%s' and '%s' are both %s"),
+                    *SourcePin, *TargetPin, Source->bOutput ? TEXT("outputs") : TEXT("inputs")));
+            }
+            else if (!Source->bExec && HasTypedPins(Result.GraphType))
+            {
+                // Written output-to-input, whichever end the request named as the source
+                const FCachedPinSignature& Output = Source->bOutput ? *Source : *Target;
+                const FCachedPinSignature& Input = Source->bOutput ? *Target : *Source;
+                const EPinTypeMatch Match = MatchPinTypes(Output, Input);
+                if (Match == EPinTypeMatch::Incompatible)
+                {
+                    Result.AddError(TEXT("connections"), Index, SourceRef, FString::Printf(TEXT("Cannot link %s pin '%s' to %s pin '%s'"),
+                        *DescribePinType(*Source), *SourcePin, *DescribePinType(*Target), *TargetPin));
+                }
+                else if (Match == EPinTypeMatch::Unchecked)
+                {
+                    Result.ConnectionsTypeUnchecked++;
+                }
+            }
+        }
+    }
+
+    if (ConnectionsUnchecked > 0)
+    {
+        Result.Warnings.Add(FString::Printf(TEXT("%d connection(s) involve existing nodes or node layouts not seen yet; their pins are checked when the batch runs"), ConnectionsUnchecked));
+    }
+    if (Result.ConnectionsTypeUnchecked > 0)
+    {
+        Result.Warnings.Add(FString::Printf(TEXT("%d connection(s) need an autocast or a class/struct relationship; their types are checked when the batch runs"), Result.ConnectionsTypeUnchecked));
+    }
+
+    // =========================================================================
+    // PIN VALUES
+    // =========================================================================
+    const TArray<TSharedPtr<FJsonValue>>* PinValues = nullptr;
+    if (Params->TryGetArrayField(TEXT("pin_values"), PinValues))
+    {
+        for (int32 Index = 0; Index < PinValues->Num(); ++Index)
+        {
+            const TSharedPtr<FJsonObject>* PinValue = nullptr;
+            if (!(*PinValues)[Index]->TryGetObject(PinValue))
+            {
+                Result.AddError(TEXT("pin_values"), Index, FString(), TEXT("Expected an object"));
+                continue;
+            }
+            Result.PinValuesPlanned++;
+
+            const FString Ref = GetString(*PinValue, TEXT("ref"));
+            const FString NodeId = GetString(*PinValue, TEXT("node_id"));
+            const FString PinName = GetString(*PinValue, TEXT("pin"));
+            if (!CheckEndpoint(TEXT("pin_values"), Index, Ref, NodeId, TEXT("node")))
+            {
+                continue;
+            }
+            if (PinName.IsEmpty())
+            {
+                Result.AddError(TEXT("pin_values"), Index, Ref, TEXT("Missing 'pin'"));
+                continue;
+            }
+
+            const TArray<FCachedPinSignature>* Pins = NodeId.IsEmpty() ? RefPins.Find(Ref) : nullptr;
+            if (!Pins)
+            {
+                continue;
+            }
+            const FCachedPinSignature* Pin = FindCachedPin(*Pins, PinName, false);
+            if (!Pin)
+            {
+                Result.AddError(TEXT("pin_values"), Index, Ref, FString::Printf(TEXT("Pin '%s' not found"), *PinName));
+            }
+            else if (Pin->bExec)
+            {
+                Result.AddError(TEXT("pin_values"), Index, Ref, FString::Printf(TEXT("Exec pin '%s' has no value"), *PinName));
+            }
+        }
+    }
+
+    return Result;
+}
+
+FString FGraphBatchValidation::Summarize() const
+{
+    // Same shape as HandleGraphBatch's error summary
+    FString Summary;
+    for (int32 i = 0; i < FMath::Min(Errors.Num(), 5); i++)
+    {
+        if (i > 0) Summary += TEXT("; ");
+        Summary += Errors[i];
+    }
+    if (Errors.Num() > 5)
+    {
+        Summary += FString::Printf(TEXT(" ... and %d more errors"), Errors.Num() - 5);
+    }
+    return Summary;
+}
+
+TSharedPtr<FJsonObject> FGraphBatchValidation::ToDryRunResponse() const
+{
+    TSharedPtr<FJsonObject> WouldDo = MakeShared<FJsonObject>();
+    WouldDo->SetStringField(TEXT("graph_type"), GetGraphTypeName(GraphType));
+    WouldDo->SetBoolField(TEXT("asset_found"), bAssetFound);
+    WouldDo->SetNumberField(TEXT("would_create_nodes"), NodesPlanned);
+    WouldDo->SetNumberField(TEXT("would_connect"), ConnectionsPlanned);
+    WouldDo->SetNumberField(TEXT("would_set_pin_values"), PinValuesPlanned);
+    WouldDo->SetNumberField(TEXT("would_modify_existing"), ExistingNodeOps);
+    WouldDo->SetNumberField(TEXT("connections_checked"), ConnectionsChecked);
+    WouldDo->SetNumberField(TEXT("connections_type_unchecked"), ConnectionsTypeUnchecked);
+    return FUnrealCompanionCommonUtils::CreateDryRunResponse(IsValid(), Errors, Warnings, WouldDo);
+}
@@ -0,0 +1,775 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Graph/GraphLayout.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "EdGraphNode_Comment.h"
+#include "EdGraphSchema_K2.h"
+#include "MaterialGraph/MaterialGraphNode.h"
+#include "MaterialGraph/MaterialGraphNode_Root.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialExpression.h"
+#include "Dom/JsonObject.h"
+
+namespace UnrealCompanionLayout
+{
+
+namespace
+{
+    // Straight-mode geometry (estimates; node sizes aren't known outside the editor widgets)
+    const float DataNodeHeight = 50.0f;
+    const float DataNodeSpacingY = 15.0f;
+    const float ExecToDataSpacing = 40.0f;
+    const float MinHorizontalGap = 80.0f;
+    const float ExecNodeHeight = 120.0f;
+
+    // Data nodes sit this far left of the average X of their consumers
+    const float DataNodeXOffset = -100.0f;
+
+    bool IsExecPin(const UEdGraphPin* Pin)
+    {
+        return Pin && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec;
+    }
+
+    float EstimateNodeWidth(UEdGraphNode* Node)
+    {
+        const float BaseWidth = 200.0f;
+        const float PinWidthContribution = 15.0f;
+        int32 InputPins = 0;
+        int32 OutputPins = 0;
+
+        for (UEdGraphPin* Pin : Node->Pins)
+        {
+            if (Pin)
+            {
+                if (Pin->Direction == EGPD_Input) InputPins++;
+                else OutputPins++;
+            }
+        }
+
+        const float TitleWidth = Node->GetNodeTitle(ENodeTitleType::ListView).ToString().Len() * 7.0f;
+        return FMath::Max(BaseWidth + FMath::Max(InputPins, OutputPins) * PinWidthContribution, TitleWidth + 60.0f);
+    }
+
+    /** Dense-index view of the nodes being laid out; all arrays are indexed by node */
+    struct FLayoutGraph
+    {
+        TArray<UEdGraphNode*> Nodes;
+        TMap<UEdGraphNode*, int32> Index;
+        TArray<bool> bFlowNode;
+
+        // Flow links with back edges dropped, so they form a DAG
+        TArray<TArray<int32>> Succ;
+        TArray<TArray<int32>> Pred;
+
+        // Data links: who consumes a data node's outputs, and which data nodes feed a node
+        TArray<TArray<int32>> DataConsumers;
+        TArray<TArray<int32>> DataProducers;
+
+        // Flow nodes with no incoming flow link first, then the rest, each in graph order
+        TArray<int32> RootOrder;
+    };
+
+    void BuildLayoutGraph(const TArray<UEdGraphNode*>& InNodes, FLayoutGraph& G)
+    {
+        for (UEdGraphNode* Node : InNodes)
+        {
+            if (Node && !Cast<UEdGraphNode_Comment>(Node) && !G.Index.Contains(Node))
+            {
+                G.Index.Add(Node, G.Nodes.Add(Node));
+            }
+        }
+
+        const int32 NumNodes = G.Nodes.Num();
+        G.bFlowNode.Init(false, NumNodes);
+        G.Succ.SetNum(NumNodes);
+        G.Pred.SetNum(NumNodes);
+        G.DataConsumers.SetNum(NumNodes);
+        G.DataProducers.SetNum(NumNodes);
+
+        bool bAnyExec = false;
+        for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+        {
+            for (UEdGraphPin* Pin : G.Nodes[NodeIndex]->Pins)
+            {
+                if (IsExecPin(Pin))
+                {
+                    G.bFlowNode[NodeIndex] = true;
+                    bAnyExec = true;
+                    break;
+                }
+            }
+        }
+        if (!bAnyExec)
+        {
+            // Material / Animation graphs: the data links are the flow
+            G.bFlowNode.Init(true, NumNodes);
+        }
+
+        TArray<TArray<int32>> FlowOut;
+        FlowOut.SetNum(NumNodes);
+        TArray<int32> InDegree;
+        InDegree.Init(0, NumNodes);
+
+        for (int32 From = 0; From < NumNodes; ++From)
+        {
+            for (UEdGraphPin* Pin : G.Nodes[From]->Pins)
+            {
+                if (!Pin || Pin->Direction != EGPD_Output)
+                {
+                    continue;
+                }
+                const bool bFlowLink = !bAnyExec || IsExecPin(Pin);
+                for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+                {
+                    const int32* To = LinkedPin ? G.Index.Find(LinkedPin->GetOwningNode()) : nullptr;
+                    if (!To || *To == From)
+                    {
+                        continue;
+                    }
+                    if (bFlowLink)
+                    {
+                        FlowOut[From].Add(*To);
+                        ++InDegree[*To];
+                    }
+                    else if (!G.bFlowNode[From])
+                    {
+                        G.DataConsumers[From].AddUnique(*To);
+                        G.DataProducers[*To].AddUnique(From);
+                    }
+                }
+            }
+        }
+
+        for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+        {
+            if (G.bFlowNode[NodeIndex] && InDegree[NodeIndex] == 0)
+            {
+                G.RootOrder.Add(NodeIndex);
+            }
+        }
+        for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+        {
+            if (G.bFlowNode[NodeIndex] && InDegree[NodeIndex] != 0)
+            {
+                G.RootOrder.Add(NodeIndex);
+            }
+        }
+
+        // Iterative DFS from the roots; a link back onto the DFS stack closes a cycle and is dropped
+        TArray<uint8> State;  // 0 = unvisited, 1 = on the stack, 2 = done
+        State.Init(0, NumNodes);
+        TArray<TPair<int32, int32>> Stack;
+        for (int32 Root : G.RootOrder)
+        {
+            if (State[Root] != 0)
+            {
+                continue;
+            }
+            State[Root] = 1;
+            Stack.Add(TPair<int32, int32>(Root, 0));
+            while (Stack.Num() > 0)
+            {
+                const int32 Node = Stack.Last().Key;
+                const int32 NextLink = Stack.Last().Value++;
+                if (NextLink >= FlowOut[Node].Num())
+                {
+                    State[Node] = 2;
+                    Stack.Pop();
+                    continue;
+                }
+
+                const int32 To = FlowOut[Node][NextLink];
+                if (State[To] == 1)
+                {
+                    continue;
+                }
+                G.Succ[Node].Add(To);
+                G.Pred[To].Add(Node);
+                if (State[To] == 0)
+                {
+                    State[To] = 1;
+                    Stack.Add(TPair<int32, int32>(To, 0));
+                }
+            }
+        }
+    }
+
+    /** Crossings between adjacent layers, counted as inversions with a Fenwick tree: O(E log V) */
+    int32 CountCrossings(const TArray<TArray<int32>>& Layers, const TArray<int32>& Position, const TArray<int32>& LayerOf, const FLayoutGraph& G)
+    {
+        int32 Total = 0;
+        TArray<TPair<int32, int32>> Links;
+        TArray<int32> Tree;
+
+        for (int32 Layer = 0; Layer + 1 < Layers.Num(); ++Layer)
+        {
+            Links.Reset();
+            for (int32 Upper : Layers[Layer])
+            {
+                for (int32 Lower : G.Succ[Upper])
+                {
+                    if (LayerOf[Lower] == Layer + 1)
+                    {
+                        Links.Add(TPair<int32, int32>(Position[Upper], Position[Lower]));
+                    }
+                }
+            }
+            Links.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B)
+            {
+                return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value;
+            });
+
+            const int32 Size = Layers[Layer + 1].Num();
+            Tree.Init(0, Size + 1);
+            for (int32 LinkIndex = 0; LinkIndex < Links.Num(); ++LinkIndex)
+            {
+                // Every earlier link ending further along the lower layer crosses this one
+                int32 NotAfter = 0;
+                for (int32 i = Links[LinkIndex].Value + 1; i > 0; i -= i & -i)
+                {
+                    NotAfter += Tree[i];
+                }
+                Total += LinkIndex - NotAfter;
+                for (int32 i = Links[LinkIndex].Value + 1; i <= Size; i += i & -i)
+                {
+                    ++Tree[i];
+                }
+            }
+        }
+        return Total;
+    }
+
+    /** Barycentre sweeps (down, then up), keeping the best ordering seen; stops when one doesn't help */
+    void MinimiseCrossings(TArray<TArray<int32>>& Layers, TArray<int32>& Position, const TArray<int32>& LayerOf,
+        const FLayoutGraph& G, int32 MaxSweeps, FLayoutResult& Result)
+    {
+        TArray<double> Key;
+        Key.SetNumZeroed(G.Nodes.Num());
+
+        auto SortByBarycentre = [&](TArray<int32>& LayerNodes, bool bDown)
+        {
+            for (int32 Node : LayerNodes)
+            {
+                const TArray<int32>& Neighbours = bDown ? G.Pred[Node] : G.Succ[Node];
+                double Sum = 0.0;
+                for (int32 Neighbour : Neighbours)
+                {
+                    Sum += Position[Neighbour];
+                }
+                Key[Node] = Neighbours.Num() > 0 ? Sum / Neighbours.Num() : (double)Position[Node];
+            }
+            LayerNodes.StableSort([&Key](int32 A, int32 B) { return Key[A] < Key[B]; });
+            for (int32 Slot = 0; Slot < LayerNodes.Num(); ++Slot)
+            {
+                Position[LayerNodes[Slot]] = Slot;
+            }
+        };
+
+        int32 Best = CountCrossings(Layers, Position, LayerOf, G);
+        Result.InitialCrossings += Best;
+        TArray<TArray<int32>> BestLayers = Layers;
+
+        for (int32 Sweep = 0; Sweep < MaxSweeps && Best > 0; ++Sweep)
+        {
+            for (int32 Layer = 1; Layer < Layers.Num(); ++Layer)
+            {
+                SortByBarycentre(Layers[Layer], true);
+            }
+            for (int32 Layer = Layers.Num() - 2; Layer >= 0; --Layer)
+            {
+                SortByBarycentre(Layers[Layer], false);
+            }
+            ++Result.CrossingSweeps;
+
+            const int32 Crossings = CountCrossings(Layers, Position, LayerOf, G);
+            if (Crossings >= Best)
+            {
+                break;
+            }
+            Best = Crossings;
+            BestLayers = Layers;
+        }
+
+        Layers = MoveTemp(BestLayers);
+        for (const TArray<int32>& LayerNodes : Layers)
+        {
+            for (int32 Slot = 0; Slot < LayerNodes.Num(); ++Slot)
+            {
+                Position[LayerNodes[Slot]] = Slot;
+            }
+        }
+        Result.Crossings += Best;
+    }
+}
+
+EArrangeMode ParseArrangeMode(const FString& ModeString)
+{
+    if (ModeString.Equals(TEXT("straight"), ESearchCase::IgnoreCase))
+    {
+        return EArrangeMode::Straight;
+    }
+    if (ModeString.Equals(TEXT("compact"), ESearchCase::IgnoreCase))
+    {
+        return EArrangeMode::Compact;
+    }
+    return EArrangeMode::Layered;
+}
+
+const TCHAR* GetArrangeModeName(EArrangeMode Mode)
+{
+    switch (Mode)
+    {
+    case EArrangeMode::Straight: return TEXT("straight");
+    case EArrangeMode::Compact:  return TEXT("compact");
+    default:                     return TEXT("layered");
+    }
+}
+
+TSharedPtr<FJsonObject> FLayoutResult::ToJson() const
+{
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetNumberField(TEXT("nodes_arranged"), NodesArranged);
+    Json->SetNumberField(TEXT("flows"), Flows);
+    Json->SetNumberField(TEXT("max_layer"), MaxLayer);
+    Json->SetNumberField(TEXT("data_nodes"), DataNodes);
+    Json->SetNumberField(TEXT("initial_crossings"), InitialCrossings);
+    Json->SetNumberField(TEXT("crossings"), Crossings);
+    Json->SetNumberField(TEXT("crossing_sweeps"), CrossingSweeps);
+    return Json;
+}
+
+FLayoutResult ComputeLayout(const TArray<UEdGraphNode*>& Nodes, const FLayoutSettings& Settings)
+{
+    FLayoutResult Result;
+    FLayoutGraph G;
+    BuildLayoutGraph(Nodes, G);
+
+    const int32 NumNodes = G.Nodes.Num();
+    if (NumNodes == 0)
+    {
+        return Result;
+    }
+
+    // =========================================================================
+    // FLOWS: connected components of the flow links, numbered in root order
+    // =========================================================================
+    TArray<int32> FlowOf;
+    FlowOf.Init(INDEX_NONE, NumNodes);
+    TArray<int32> Work;
+    for (int32 Root : G.RootOrder)
+    {
+        if (FlowOf[Root] != INDEX_NONE)
+        {
+            continue;
+        }
+        FlowOf[Root] = Result.Flows;
+        Work.Reset();
+        Work.Add(Root);
+        while (Work.Num() > 0)
+        {
+            const int32 Node = Work.Pop();
+            auto Visit = [&](const TArray<int32>& Links)
+            {
+                for (int32 Other : Links)
+                {
+                    if (FlowOf[Other] == INDEX_NONE)
+                    {
+                        FlowOf[Other] = Result.Flows;
+                        Work.Add(Other);
+                    }
+                }
+            };
+            Visit(G.Succ[Node]);
+            Visit(G.Pred[Node]);
+        }
+        ++Result.Flows;
+    }
+
+    // =========================================================================
+    // LAYERS: longest path over a topological order (Kahn), linear time
+    // =========================================================================
+    TArray<int32> LayerOf;
+    LayerOf.Init(0, NumNodes);
+    TArray<int32> Remaining;
+    Remaining.SetNumUninitialized(NumNodes);
+    TArray<int32> TopoOrder;
+    TopoOrder.Reserve(NumNodes);
+    for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+    {
+        Remaining[NodeIndex] = G.Pred[NodeIndex].Num();
+        if (G.bFlowNode[NodeIndex] && Remaining[NodeIndex] == 0)
+        {
+            TopoOrder.Add(NodeIndex);
+        }
+    }
+    for (int32 Head = 0; Head < TopoOrder.Num(); ++Head)
+    {
+        const int32 Node = TopoOrder[Head];
+        for (int32 Next : G.Succ[Node])
+        {
+            LayerOf[Next] = FMath::Max(LayerOf[Next], LayerOf[Node] + 1);
+            if (--Remaining[Next] == 0)
+            {
+                TopoOrder.Add(Next);
+            }
+        }
+    }
+
+    // Initial order within a layer is topological order
+    TArray<TArray<TArray<int32>>> FlowLayers;
+    FlowLayers.SetNum(Result.Flows);
+    TArray<int32> Position;
+    Position.Init(0, NumNodes);
+    for (int32 Node : TopoOrder)
+    {
+        TArray<TArray<int32>>& Layers = FlowLayers[FlowOf[Node]];
+        if (Layers.Num() <= LayerOf[Node])
+        {
+            Layers.SetNum(LayerOf[Node] + 1);
+        }
+        Position[Node] = Layers[LayerOf[Node]].Add(Node);
+        Result.MaxLayer = FMath::Max(Result.MaxLayer, LayerOf[Node]);
+    }
+
+    for (TArray<TArray<int32>>& Layers : FlowLayers)
+    {
+        MinimiseCrossings(Layers, Position, LayerOf, G, Settings.MaxCrossingSweeps, Result);
+    }
+
+    // =========================================================================
+    // COORDINATES: flow nodes
+    // =========================================================================
+    const float H = Settings.HorizontalSpacing;
+    const float V = Settings.VerticalSpacing;
+    TArray<FVector2D> Pos;
+    Pos.SetNumZeroed(NumNodes);
+    TArray<bool> bPlaced;
+    bPlaced.Init(false, NumNodes);
+    auto Place = [&](int32 Node, float X, float Y)
+    {
+        Pos[Node] = FVector2D(X, Y);
+        bPlaced[Node] = true;
+    };
+
+    float FlowTop = 0.0f;
+    for (const TArray<TArray<int32>>& Layers : FlowLayers)
+    {
+        if (Settings.Mode == EArrangeMode::Straight)
+        {
+            // One horizontal line per flow, data nodes stacked above the node they feed
+            int32 MaxDataRows = 0;
+            for (const TArray<int32>& LayerNodes : Layers)
+            {
+                for (int32 Node : LayerNodes)
+                {
+                    MaxDataRows = FMath::Max(MaxDataRows, G.DataProducers[Node].Num());
+                }
+            }
+            const float ExecLineY = FlowTop + MaxDataRows * (DataNodeHeight + DataNodeSpacingY) + ExecToDataSpacing;
+
+            float CurrentX = 0.0f;
+            for (const TArray<int32>& LayerNodes : Layers)
+            {
+                for (int32 Node : LayerNodes)
+                {
+                    Place(Node, CurrentX, ExecLineY);
+                    CurrentX += EstimateNodeWidth(G.Nodes[Node]) + MinHorizontalGap;
+
+                    int32 Slot = 0;
+                    for (int32 DataNode : G.DataProducers[Node])
+                    {
+                        if (bPlaced[DataNode] || G.bFlowNode[DataNode])
+                        {
+                            continue;
+                        }
+                        const float DataX = Pos[Node].X - EstimateNodeWidth(G.Nodes[DataNode]) * 0.3f;
+                        const float DataY = ExecLineY - ExecToDataSpacing - (++Slot) * (DataNodeHeight + DataNodeSpacingY);
+                        Place(DataNode, DataX, DataY);
+                    }
+                }
+            }
+            FlowTop = ExecLineY + ExecNodeHeight + Settings.FlowSpacing;
+        }
+        else if (Settings.Mode == EArrangeMode::Compact)
+        {
+            // Layers stacked tightly, each starting level with the middle of the previous one
+            float FlowBottom = FlowTop;
+            float PreviousLayerBottom = FlowTop;
+            for (int32 Layer = 0; Layer < Layers.Num(); ++Layer)
+            {
+                const TArray<int32>& LayerNodes = Layers[Layer];
+                float Y = Layer > 0
+                    ? FMath::Max(FlowTop, PreviousLayerBottom - (LayerNodes.Num() - 1) * V * 0.5f)
+                    : FlowTop;
+                for (int32 Node : LayerNodes)
+                {
+                    Place(Node, Layer * H, Y);
+                    Y += V * 0.7f;
+                }
+                PreviousLayerBottom = Y;
+                FlowBottom = FMath::Max(FlowBottom, Y);
+            }
+            FlowTop = FlowBottom + Settings.FlowSpacing * 0.5f;
+        }
+        else
+        {
+            // Each node as close to the median of its predecessors as the nodes above it allow,
+            // so chains come out straight
+            float FlowBottom = FlowTop;
+            TArray<float> PredYs;
+            for (int32 Layer = 0; Layer < Layers.Num(); ++Layer)
+            {
+                float NextFreeY = FlowTop;
+                for (int32 Node : Layers[Layer])
+                {
+                    float Y = NextFreeY;
+                    if (Layer > 0 && G.Pred[Node].Num() > 0)
+                    {
+                        PredYs.Reset();
+                        for (int32 PredNode : G.Pred[Node])
+                        {
+                            PredYs.Add(Pos[PredNode].Y);
+                        }
+                        PredYs.Sort();
+                        Y = FMath::Max(Y, PredYs[PredYs.Num() / 2]);
+                    }
+                    Place(Node, Layer * H, Y);
+                    NextFreeY = Y + V;
+                    FlowBottom = FMath::Max(FlowBottom, Y);
+                }
+            }
+            FlowTop = FlowBottom + V + Settings.FlowSpacing;
+        }
+    }
+
+    // =========================================================================
+    // COORDINATES: data nodes
+    // =========================================================================
+    if (Settings.Mode != EArrangeMode::Straight && Settings.bAlignDataNodes)
+    {
+        // Consumers before producers: breadth-first from the flow nodes, back along data links
+        TArray<int32> DataOrder;
+        TArray<bool> bQueued;
+        bQueued.Init(false, NumNodes);
+        auto QueueProducers = [&](int32 Node)
+        {
+            for (int32 Producer : G.DataProducers[Node])
+            {
+                if (!bQueued[Producer] && !G.bFlowNode[Producer])
+                {
+                    bQueued[Producer] = true;
+                    DataOrder.Add(Producer);
+                }
+            }
+        };
+        for (int32 Node : TopoOrder)
+        {
+            QueueProducers(Node);
+        }
+        for (int32 Head = 0; Head < DataOrder.Num(); ++Head)
+        {
+            QueueProducers(DataOrder[Head]);
+        }
+
+        // Data nodes landing on the same X column stack downwards
+        TMap<int32, int32> DataNodeCountAtX;
+        for (int32 DataNode : DataOrder)
+        {
+            float SumX = 0.0f;
+            float MaxY = -FLT_MAX;
+            int32 ConnectionCount = 0;
+            for (int32 Consumer : G.DataConsumers[DataNode])
+            {
+                if (bPlaced[Consumer])
+                {
+                    SumX += Pos[Consumer].X;
+                    MaxY = FMath::Max(MaxY, Pos[Consumer].Y);
+                    ++ConnectionCount;
+                }
+            }
+            if (ConnectionCount == 0)
+            {
+                continue;
+            }
+
+            const float DataX = SumX / ConnectionCount + DataNodeXOffset;
+            const int32 XKey = static_cast<int32>(DataX / 50.0f);
+            const int32 StackIndex = DataNodeCountAtX.FindRef(XKey);
+            DataNodeCountAtX.Add(XKey, StackIndex + 1);
+            Place(DataNode, DataX, MaxY + V * 0.7f + StackIndex * V * 0.6f);
+        }
+    }
+
+    // Whatever is left (disconnected data nodes, or alignment off) goes in a column at the end
+    for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+    {
+        if (!bPlaced[NodeIndex])
+        {
+            Place(NodeIndex, 0.0f, FlowTop);
+            FlowTop += V * 0.5f;
+        }
+    }
+
+    // =========================================================================
+    // RESULT
+    // =========================================================================
+    Result.NodesArranged = NumNodes;
+    Result.Positions.Reserve(NumNodes);
+    for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+    {
+        Result.Positions.Add(G.Nodes[NodeIndex], Pos[NodeIndex]);
+        if (!G.bFlowNode[NodeIndex])
+        {
+            ++Result.DataNodes;
+        }
+    }
+    return Result;
+}
+
+FLayoutResult ArrangeGraph(UEdGraph* Graph, const FLayoutSettings& Settings)
+{
+    if (!Graph)
+    {
+        return FLayoutResult();
+    }
+
+    TArray<UEdGraphNode*> Nodes;
+    Nodes.Reserve(Graph->Nodes.Num());
+    for (UEdGraphNode* Node : Graph->Nodes)
+    {
+        Nodes.Add(Node);
+    }
+
+    FLayoutResult Result = ComputeLayout(Nodes, Settings);
+    ApplyLayout(Result);
+    return Result;
+}
+
+FLayoutResult ArrangeSubgraph(UEdGraph* Graph, const TArray<UEdGraphNode*>& Nodes, const FLayoutSettings& Settings)
+{
+    FLayoutResult Result = ComputeLayout(Nodes, Settings);
+    if (!Graph || Result.Positions.Num() == 0)
+    {
+        return Result;
+    }
+
+    FBox2D Block(ForceInit);
+    for (const TPair<UEdGraphNode*, FVector2D>& Pair : Result.Positions)
+    {
+        Block += Pair.Value;
+    }
+
+    // Untouched nodes linked to the block, on either side
+    float UpstreamMaxX = -FLT_MAX;
+    float UpstreamSumY = 0.0f;
+    int32 UpstreamCount = 0;
+    float DownstreamMinX = FLT_MAX;
+    float DownstreamSumY = 0.0f;
+    int32 DownstreamCount = 0;
+    for (const TPair<UEdGraphNode*, FVector2D>& Pair : Result.Positions)
+    {
+        for (UEdGraphPin* Pin : Pair.Key->Pins)
+        {
+            if (!Pin)
+            {
+                continue;
+            }
+            for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+            {
+                UEdGraphNode* Other = LinkedPin ? LinkedPin->GetOwningNode() : nullptr;
+                if (!Other || Result.Positions.Contains(Other))
+                {
+                    continue;
+                }
+                if (Pin->Direction == EGPD_Input)
+                {
+                    UpstreamMaxX = FMath::Max(UpstreamMaxX, (float)Other->NodePosX);
+                    UpstreamSumY += Other->NodePosY;
+                    ++UpstreamCount;
+                }
+                else
+                {
+                    DownstreamMinX = FMath::Min(DownstreamMinX, (float)Other->NodePosX);
+                    DownstreamSumY += Other->NodePosY;
+                    ++DownstreamCount;
+                }
+            }
+        }
+    }
+
+    FVector2D Offset(0.0f, 0.0f);
+    if (UpstreamCount > 0)
+    {
+        Offset = FVector2D(UpstreamMaxX + Settings.HorizontalSpacing - Block.Min.X, UpstreamSumY / UpstreamCount - Block.Min.Y);
+    }
+    else if (DownstreamCount > 0)
+    {
+        Offset = FVector2D(DownstreamMinX - Settings.HorizontalSpacing - Block.Max.X, DownstreamSumY / DownstreamCount - Block.Min.Y);
+    }
+    else
+    {
+        // Not wired to anything untouched: below the rest of the graph
+        FBox2D Rest(ForceInit);
+        for (UEdGraphNode* Node : Graph->Nodes)
+        {
+            if (Node && !Cast<UEdGraphNode_Comment>(Node) && !Result.Positions.Contains(Node))
+            {
+                Rest += FVector2D(Node->NodePosX, Node->NodePosY);
+            }
+        }
+        if (Rest.bIsValid)
+        {
+            Offset = FVector2D(Rest.Min.X - Block.Min.X, Rest.Max.Y + Settings.FlowSpacing - Block.Min.Y);
+        }
+    }
+
+    for (TPair<UEdGraphNode*, FVector2D>& Pair : Result.Positions)
+    {
+        Pair.Value += Offset;
+    }
+    ApplyLayout(Result);
+    return Result;
+}
+
+int32 ApplyLayout(const FLayoutResult& Result)
+{
+    int32 Moved = 0;
+    for (const TPair<UEdGraphNode*, FVector2D>& Pair : Result.Positions)
+    {
+        UEdGraphNode* Node = Pair.Key;
+        const int32 X = FMath::RoundToInt(Pair.Value.X);
+        const int32 Y = FMath::RoundToInt(Pair.Value.Y);
+        if (!Node || (Node->NodePosX == X && Node->NodePosY == Y))
+        {
+            continue;
+        }
+
+        Node->Modify();
+        Node->NodePosX = X;
+        Node->NodePosY = Y;
+
+        // Material graphs are rebuilt from the expressions, so they carry the position too
+        if (UMaterialGraphNode* MaterialNode = Cast<UMaterialGraphNode>(Node))
+        {
+            if (MaterialNode->MaterialExpression)
+            {
+                MaterialNode->MaterialExpression->MaterialExpressionEditorX = X;
+                MaterialNode->MaterialExpression->MaterialExpressionEditorY = Y;
+            }
+        }
+        else if (UMaterialGraphNode_Root* RootNode = Cast<UMaterialGraphNode_Root>(Node))
+        {
+            if (RootNode->Material)
+            {
+                RootNode->Material->EditorX = X;
+                RootNode->Material->EditorY = Y;
+            }
+        }
+        ++Moved;
+    }
+    return Moved;
+}
+
+} // namespace UnrealCompanionLayout
@@ -1,24 +1,71 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Graph/GraphOperations.h"
+#include "UnrealCompanionStats.h"
 #include "EdGraph/EdGraph.h"
 #include "Engine/Blueprint.h"
 #include "Materials/Material.h"
 #include "Materials/MaterialFunction.h"
 #include "MaterialGraph/MaterialGraph.h"  // UE5.7: Required for full UMaterialGraph type
+#include "MaterialEditorUtilities.h"
 #include "Animation/AnimBlueprint.h"
 #include "WidgetBlueprint.h"
-#include "AssetRegistry/AssetRegistryModule.h"
+#include "Commands/UnrealCompanionAssetIndex.h"
+#include "Commands/UnrealCompanionCompileSession.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
+#include "UObject/ObjectKey.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogUnrealCompanionGraph, Log, All);
 
 namespace UnrealCompanionGraph
 {
 
+namespace
+{
+    /** Innermost live FScopedMaterialEditBatch (game thread only) */
+    FScopedMaterialEditBatch* GActiveMaterialBatch = nullptr;
+
+    /** Materials whose graph edits no PostEditChange has compiled yet */
+    TSet<TObjectKey<UMaterial>> GMaterialsPendingCompile;
+
+    /**
+     * Copy the graph's links into the Material's expressions (what the Material
+     * Editor does after each edit); CPU only, no shader work. bGraphChanged also
+     * gives an open Material Editor the refresh a batch held back.
+     */
+    void SyncMaterialFromGraph(UMaterial* Material, bool bGraphChanged)
+    {
+        UMaterialGraph* MatGraph = Material->MaterialGraph;
+        if (!MatGraph)
+        {
+            return;
+        }
+
+        MatGraph->LinkMaterialExpressionsFromGraph();
+        if (bGraphChanged)
+        {
+            FMaterialEditorUtilities::UpdateMaterialAfterGraphChange(MatGraph);
+        }
+    }
+
+    void RecompileMaterial(UMaterial* Material, bool bGraphChanged = false)
+    {
+        SyncMaterialFromGraph(Material, bGraphChanged);
+        {
+            UNREALCOMPANION_SCOPE_CYCLE_COUNTER(STAT_UnrealCompanion_Compile);
+            Material->PreEditChange(nullptr);
+            Material->PostEditChange();
+        }
+        GMaterialsPendingCompile.Remove(Material);
+        FUnrealCompanionCompileSession::Get().NotifyCompiled(Material);
+
+        UE_LOG(LogUnrealCompanionGraph, Display, TEXT("Compiled Material %s"), *Material->GetName());
+    }
+}
+
 // =========================================================================
 // HELPER: Generic asset finder
 // =========================================================================
@@ -31,35 +78,20 @@ T* FindAssetByNameOrPath(const FString& NameOrPath)
         return nullptr;
     }
 
-    // Try direct path first
-    if (NameOrPath.StartsWith(TEXT("/")) || NameOrPath.Contains(TEXT(".")))
+    // Indexed lookup: exact (case-insensitive) name or path, then partial name
+    FSoftObjectPath ObjectPath;
+    if (FUnrealCompanionAssetIndex::Get().FindAsset(NameOrPath, T::StaticClass(), false, true, ObjectPath))
     {
-        T* Asset = LoadObject<T>(nullptr, *NameOrPath);
-        if (Asset) return Asset;
-    }
-
-    // Search by name in asset registry
-    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-    IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-    TArray<FAssetData> AssetDataList;
-    AssetRegistry.GetAssetsByClass(T::StaticClass()->GetClassPathName(), AssetDataList);
-
-    for (const FAssetData& AssetData : AssetDataList)
-    {
-        if (AssetData.AssetName.ToString().Equals(NameOrPath, ESearchCase::IgnoreCase))
+        if (T* Asset = Cast<T>(ObjectPath.TryLoad()))
         {
-            return Cast<T>(AssetData.GetAsset());
+            return Asset;
         }
     }
 
-    // Try partial match
-    for (const FAssetData& AssetData : AssetDataList)
+    // Paths the registry doesn't know about (e.g. unsaved in-memory assets)
+    if (NameOrPath.StartsWith(TEXT("/")) || NameOrPath.Contains(TEXT(".")))
     {
-        if (AssetData.AssetName.ToString().Contains(NameOrPath))
-        {
-            return Cast<T>(AssetData.GetAsset());
-        }
+        return LoadObject<T>(nullptr, *NameOrPath);
     }
 
     return nullptr;
@@ -472,9 +504,18 @@ bool CompileIfNeeded(UObject* Asset, bool bForce, FString* OutError)
     // Blueprint compilation
     if (UBlueprint* Blueprint = Cast<UBlueprint>(Asset))
     {
+        if (!bForce && FUnrealCompanionCompileSession::Get().DeferCompile(Blueprint))
+        {
+            return true;
+        }
+
         if (bForce || Blueprint->Status == BS_Dirty || Blueprint->Status == BS_Unknown)
         {
-            FKismetEditorUtilities::CompileBlueprint(Blueprint);
+            {
+                UNREALCOMPANION_SCOPE_CYCLE_COUNTER(STAT_UnrealCompanion_Compile);
+                FKismetEditorUtilities::CompileBlueprint(Blueprint);
+            }
+            FUnrealCompanionCompileSession::Get().NotifyCompiled(Blueprint);
             
             if (Blueprint->Status == BS_Error)
             {
@@ -493,15 +534,27 @@ bool CompileIfNeeded(UObject* Asset, bool bForce, FString* OutError)
         return true;
     }
 
-    // Material compilation happens automatically
     if (UMaterial* Material = Cast<UMaterial>(Asset))
     {
-        // Materials compile on property change automatically
-        // Just mark as modified if forced
-        if (bForce)
+        FUnrealCompanionCompileSession& Session = FUnrealCompanionCompileSession::Get();
+        if (FScopedMaterialEditBatch* Batch = FScopedMaterialEditBatch::Find())
         {
-            Material->PreEditChange(nullptr);
-            Material->PostEditChange();
+            FScopedMaterialEditBatch::FEntry& Entry = Batch->FindOrAdd(Material);
+            if (bForce || (!Session.DeferCompile(Material) && !Batch->bDeferShaderCompile))
+            {
+                Entry.bCompileRequested = true;
+            }
+            return true;
+        }
+
+        if (!bForce && Session.DeferCompile(Material))
+        {
+            return true;
+        }
+
+        if (bForce || IsCompilePending(Material))
+        {
+            RecompileMaterial(Material);
         }
         return true;
     }
@@ -525,6 +578,102 @@ void MarkAsModified(UObject* Asset)
         Asset->Modify();
         Asset->MarkPackageDirty();
     }
+
+    if (UMaterial* Material = Cast<UMaterial>(Asset))
+    {
+        GMaterialsPendingCompile.Add(Material);
+        if (FScopedMaterialEditBatch* Batch = FScopedMaterialEditBatch::Find())
+        {
+            Batch->FindOrAdd(Material);
+        }
+        else
+        {
+            SyncMaterialFromGraph(Material, false);
+        }
+    }
+}
+
+bool IsCompilePending(UObject* Asset)
+{
+    UMaterial* Material = Cast<UMaterial>(Asset);
+    return Material && GMaterialsPendingCompile.Contains(Material);
+}
+
+// =========================================================================
+// MATERIAL EDIT BATCH
+// =========================================================================
+
+FScopedMaterialEditBatch::FScopedMaterialEditBatch(bool bInDeferShaderCompile)
+    : bDeferShaderCompile(bInDeferShaderCompile)
+    , Outer(GActiveMaterialBatch)
+{
+    check(IsInGameThread());
+    GActiveMaterialBatch = this;
+}
+
+FScopedMaterialEditBatch::~FScopedMaterialEditBatch()
+{
+    check(GActiveMaterialBatch == this);
+    GActiveMaterialBatch = Outer;
+
+    for (const FEntry& Entry : Touched)
+    {
+        UMaterial* Material = Entry.Material.Get();
+        if (!Material)
+        {
+            continue;
+        }
+
+        if (Outer)
+        {
+            FEntry& OuterEntry = Outer->FindOrAdd(Material);
+            OuterEntry.bCompileRequested |= Entry.bCompileRequested;
+            OuterEntry.bGraphChanged |= Entry.bGraphChanged;
+            continue;
+        }
+
+        if (Entry.bCompileRequested)
+        {
+            RecompileMaterial(Material, Entry.bGraphChanged);
+        }
+        else
+        {
+            SyncMaterialFromGraph(Material, Entry.bGraphChanged);
+        }
+    }
+}
+
+FScopedMaterialEditBatch* FScopedMaterialEditBatch::Find()
+{
+    return GActiveMaterialBatch;
+}
+
+bool FScopedMaterialEditBatch::DeferGraphChanged(const UEdGraph* Graph)
+{
+    UMaterialGraph* MatGraph = Cast<UMaterialGraph>(const_cast<UEdGraph*>(Graph));
+    if (!GActiveMaterialBatch || !MatGraph || !MatGraph->Material)
+    {
+        return false;
+    }
+
+    GActiveMaterialBatch->FindOrAdd(MatGraph->Material).bGraphChanged = true;
+    GMaterialsPendingCompile.Add(MatGraph->Material);
+    return true;
+}
+
+FScopedMaterialEditBatch::FEntry& FScopedMaterialEditBatch::FindOrAdd(UMaterial* Material)
+{
+    for (FEntry& Entry : Touched)
+    {
+        if (Entry.Material.Get() == Material)
+        {
+            return Entry;
+        }
+    }
+
+    FEntry& Added = Touched.AddDefaulted_GetRef();
+    Added.Material = Material;
+    return Added;
 }
 
 void MarkAsStructurallyModified(UObject* Asset)
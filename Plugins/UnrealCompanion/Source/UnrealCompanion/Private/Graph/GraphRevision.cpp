@@ -0,0 +1,233 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Graph/GraphRevision.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "Misc/DateTime.h"
+
+namespace
+{
+    uint32 HashString(const FString& Value)
+    {
+        // Case-sensitive, unlike GetTypeHash(FString): "true" -> "True" is a change
+        return Value.IsEmpty() ? 0 : FCrc::StrCrc32(*Value);
+    }
+
+    uint32 HashNode(const UEdGraphNode* Node)
+    {
+        uint32 Hash = PointerHash(Node->GetClass());
+        Hash = HashCombine(Hash, GetTypeHash(Node->NodePosX));
+        Hash = HashCombine(Hash, GetTypeHash(Node->NodePosY));
+        Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(Node->GetDesiredEnabledState())));
+        Hash = HashCombine(Hash, HashString(Node->NodeComment));
+        Hash = HashCombine(Hash, GetTypeHash(Node->bHasCompilerMessage));
+        Hash = HashCombine(Hash, GetTypeHash(Node->ErrorType));
+
+        for (const UEdGraphPin* Pin : Node->Pins)
+        {
+            if (!Pin)
+            {
+                continue;
+            }
+            Hash = HashCombine(Hash, GetTypeHash(Pin->PinName));
+            Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(Pin->Direction)));
+            Hash = HashCombine(Hash, GetTypeHash(Pin->bHidden));
+            Hash = HashCombine(Hash, GetTypeHash(Pin->PinType.PinCategory));
+            Hash = HashCombine(Hash, GetTypeHash(Pin->PinType.PinSubCategory));
+            Hash = HashCombine(Hash, PointerHash(Pin->PinType.PinSubCategoryObject.Get()));
+            Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(Pin->PinType.ContainerType)));
+            Hash = HashCombine(Hash, HashString(Pin->DefaultValue));
+            Hash = HashCombine(Hash, PointerHash(Pin->DefaultObject.Get()));
+            if (!Pin->DefaultTextValue.IsEmpty())
+            {
+                Hash = HashCombine(Hash, HashString(Pin->DefaultTextValue.ToString()));
+            }
+
+            for (const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+            {
+                const UEdGraphNode* LinkedNode = LinkedPin ? LinkedPin->GetOwningNodeUnchecked() : nullptr;
+                if (LinkedNode)
+                {
+                    Hash = HashCombine(Hash, GetTypeHash(LinkedNode->NodeGuid));
+                    Hash = HashCombine(Hash, GetTypeHash(LinkedPin->PinName));
+                }
+            }
+        }
+        return Hash;
+    }
+}
+
+FGraphRevisionTracker& FGraphRevisionTracker::Get()
+{
+    static FGraphRevisionTracker Instance;
+    return Instance;
+}
+
+int64 FGraphRevisionTracker::NextRevision()
+{
+    if (LastRevision == 0)
+    {
+        // Milliseconds since the epoch: later sessions always start above earlier ones,
+        // and the values stay exact as JSON numbers
+        LastRevision = static_cast<int64>((FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTotalMilliseconds());
+    }
+    return ++LastRevision;
+}
+
+FGraphRevisionTracker::FGraphState& FGraphRevisionTracker::FindOrAddState(UEdGraph* Graph)
+{
+    if (FGraphState* Existing = States.Find(Graph))
+    {
+        if (Existing->Graph.IsValid())
+        {
+            return *Existing;
+        }
+    }
+
+    // Drop graphs that have been destroyed before adding another
+    for (auto It = States.CreateIterator(); It; ++It)
+    {
+        if (!It->Value.Graph.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    FGraphState& State = States.Add(Graph);
+    State.Graph = Graph;
+    State.Revision = NextRevision();
+    State.Horizon = State.Revision;
+    return State;
+}
+
+int64 FGraphRevisionTracker::Sync(UEdGraph* Graph)
+{
+    check(IsInGameThread());
+    if (!Graph)
+    {
+        return 0;
+    }
+
+    FGraphState& State = FindOrAddState(Graph);
+    const uint32 Pass = ++State.SyncPass;
+
+    // Only allocated once something is found to differ
+    int64 NewRevision = 0;
+    auto Stamp = [this, &NewRevision]()
+    {
+        if (NewRevision == 0)
+        {
+            NewRevision = NextRevision();
+        }
+        return NewRevision;
+    };
+
+    for (UEdGraphNode* Node : Graph->Nodes)
+    {
+        if (!Node)
+        {
+            continue;
+        }
+
+        const uint32 Hash = HashNode(Node);
+        FNodeStamp* Existing = State.Nodes.Find(Node->NodeGuid);
+        if (!Existing)
+        {
+            FNodeStamp& Added = State.Nodes.Add(Node->NodeGuid);
+            Added.Node = Node;
+            Added.Hash = Hash;
+            Added.SyncPass = Pass;
+            Added.ChangedAt = Stamp();
+            continue;
+        }
+
+        // A duplicate GUID later in the graph must not make the first one look changed every sync
+        if (Existing->SyncPass == Pass)
+        {
+            continue;
+        }
+        Existing->SyncPass = Pass;
+        if (Existing->Hash != Hash || Existing->Node.Get() != Node)
+        {
+            Existing->Node = Node;
+            Existing->Hash = Hash;
+            Existing->ChangedAt = Stamp();
+        }
+    }
+
+    for (auto It = State.Nodes.CreateIterator(); It; ++It)
+    {
+        if (It->Value.SyncPass != Pass)
+        {
+            FTombstone& Tombstone = State.Tombstones.AddDefaulted_GetRef();
+            Tombstone.NodeGuid = It->Key;
+            Tombstone.RemovedAt = Stamp();
+            It.RemoveCurrent();
+        }
+    }
+
+    if (State.Tombstones.Num() > MaxTombstones)
+    {
+        const int32 Dropped = State.Tombstones.Num() - MaxTombstones;
+        State.Horizon = FMath::Max(State.Horizon, State.Tombstones[Dropped - 1].RemovedAt);
+        State.Tombstones.RemoveAt(0, Dropped);
+    }
+
+    if (NewRevision != 0)
+    {
+        State.Revision = NewRevision;
+    }
+    return State.Revision;
+}
+
+FGraphRevisionTracker::FDelta FGraphRevisionTracker::GetChangesSince(UEdGraph* Graph, int64 SinceRevision)
+{
+    FDelta Delta;
+    Delta.Revision = Sync(Graph);
+    if (!Graph)
+    {
+        return Delta;
+    }
+
+    const FGraphState& State = States.FindChecked(Graph);
+    Delta.bFull = !IsWithinHistory(Graph, SinceRevision);
+
+    for (UEdGraphNode* Node : Graph->Nodes)
+    {
+        if (!Node)
+        {
+            continue;
+        }
+        const FNodeStamp* NodeStamp = State.Nodes.Find(Node->NodeGuid);
+        if (Delta.bFull || (NodeStamp && NodeStamp->Node.Get() == Node && NodeStamp->ChangedAt > SinceRevision))
+        {
+            Delta.Changed.Add(Node);
+        }
+    }
+
+    if (!Delta.bFull)
+    {
+        for (const FTombstone& Tombstone : State.Tombstones)
+        {
+            if (Tombstone.RemovedAt > SinceRevision)
+            {
+                Delta.Removed.Add(Tombstone.NodeGuid);
+            }
+        }
+    }
+    return Delta;
+}
+
+int64 FGraphRevisionTracker::GetNodeRevision(const UEdGraph* Graph, const FGuid& NodeGuid) const
+{
+    const FGraphState* State = States.Find(Graph);
+    const FNodeStamp* NodeStamp = State ? State->Nodes.Find(NodeGuid) : nullptr;
+    return NodeStamp ? NodeStamp->ChangedAt : 0;
+}
+
+bool FGraphRevisionTracker::IsWithinHistory(const UEdGraph* Graph, int64 SinceRevision) const
+{
+    const FGraphState* State = States.Find(Graph);
+    return State && SinceRevision >= State->Horizon && SinceRevision <= State->Revision;
+}
@@ -0,0 +1,463 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Graph/NodeCatalog.h"
+#include "EdGraph/EdGraph.h"
+#include "Engine/Blueprint.h"
+#include "Editor.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/UObjectIterator.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/Package.h"
+#include "HAL/PlatformTime.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogNodeCatalog, Log, All);
+
+FNodeCatalog& FNodeCatalog::Get()
+{
+    static FNodeCatalog Instance;
+    return Instance;
+}
+
+void FNodeCatalog::Initialize()
+{
+    check(IsInGameThread());
+    if (ModulesChangedHandle.IsValid())
+    {
+        return;
+    }
+
+    ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddRaw(this, &FNodeCatalog::OnModulesChanged);
+    ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([this](EReloadCompleteReason) { MarkStale(); });
+    if (GEditor)
+    {
+        BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddRaw(this, &FNodeCatalog::OnBlueprintPreCompile);
+        BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FNodeCatalog::OnBlueprintCompiled);
+    }
+
+    Rebuild();
+}
+
+void FNodeCatalog::Shutdown()
+{
+    if (ModulesChangedHandle.IsValid())
+    {
+        FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+        FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+        if (GEditor)
+        {
+            GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+            GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+        }
+        ModulesChangedHandle.Reset();
+    }
+
+    Entries.Empty();
+    CataloguedClasses.Empty();
+    ByName.Empty();
+    Trigrams.Empty();
+    PendingCompiled.Empty();
+    NumRemoved = 0;
+    bStale = true;
+}
+
+// =========================================================================
+// BUILD
+// =========================================================================
+
+void FNodeCatalog::EnsureBuilt()
+{
+    check(IsInGameThread());
+    if (bStale)
+    {
+        Rebuild();
+    }
+}
+
+void FNodeCatalog::Rebuild()
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    Entries.Reset();
+    CataloguedClasses.Reset();
+    ByName.Reset();
+    Trigrams.Reset();
+    PendingCompiled.Reset();
+    NumRemoved = 0;
+
+    for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
+    {
+        AddClass(*ClassIt);
+    }
+    AddMacroLibraries();
+
+    bStale = false;
+    UE_LOG(LogNodeCatalog, Log, TEXT("Node catalogue built: %d actions from %d classes in %.1f ms"),
+        Entries.Num(), CataloguedClasses.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+bool FNodeCatalog::ShouldCatalogueClass(const UClass* Class)
+{
+    if (!Class || Class->HasAnyClassFlags(CLASS_Deprecated | CLASS_Abstract | CLASS_NewerVersionExists))
+    {
+        return false;
+    }
+
+    // Compiler intermediates would duplicate every Blueprint function
+    const FString ClassName = Class->GetName();
+    return !ClassName.StartsWith(TEXT("SKEL_")) && !ClassName.StartsWith(TEXT("REINST_")) && !ClassName.StartsWith(TEXT("TRASHCLASS_"));
+}
+
+void FNodeCatalog::AddClass(UClass* Class)
+{
+    if (!ShouldCatalogueClass(Class) || CataloguedClasses.Contains(Class))
+    {
+        return;
+    }
+    CataloguedClasses.Add(Class);
+
+    const FString ClassName = Class->GetName();
+    for (TFieldIterator<UFunction> FuncIt(Class, EFieldIteratorFlags::ExcludeSuper); FuncIt; ++FuncIt)
+    {
+        UFunction* Func = *FuncIt;
+        if (!Func)
+        {
+            continue;
+        }
+
+        const bool bCallable = (Func->FunctionFlags & FUNC_BlueprintCallable) != 0;
+        const bool bEvent = (Func->FunctionFlags & FUNC_BlueprintEvent) != 0;
+        if (!bCallable && !bEvent)
+        {
+            continue;
+        }
+
+        FNodeCatalogEntry Entry;
+        Entry.Name = Func->GetFName();
+        Entry.NameLower = Func->GetName().ToLower();
+        Entry.ClassName = ClassName;
+        Entry.Category = Func->GetMetaData(TEXT("Category"));
+        Entry.Function = Func;
+
+        // A BlueprintNativeEvent can be both called and overridden: two distinct node actions
+        if (bCallable && bEvent)
+        {
+            FNodeCatalogEntry EventEntry = Entry;
+            EventEntry.Kind = ENodeCatalogKind::Event;
+            AddEntry(MoveTemp(EventEntry));
+        }
+        Entry.Kind = bCallable ? ENodeCatalogKind::Function : ENodeCatalogKind::Event;
+        AddEntry(MoveTemp(Entry));
+    }
+}
+
+void FNodeCatalog::AddMacroLibraries()
+{
+    for (TObjectIterator<UBlueprint> BlueprintIt; BlueprintIt; ++BlueprintIt)
+    {
+        AddMacroLibrary(*BlueprintIt);
+    }
+}
+
+void FNodeCatalog::AddMacroLibrary(UBlueprint* Blueprint)
+{
+    if (!Blueprint || Blueprint->BlueprintType != BPTYPE_MacroLibrary)
+    {
+        return;
+    }
+
+    for (UEdGraph* MacroGraph : Blueprint->MacroGraphs)
+    {
+        if (!MacroGraph)
+        {
+            continue;
+        }
+
+        FNodeCatalogEntry Entry;
+        Entry.Kind = ENodeCatalogKind::Macro;
+        Entry.Name = MacroGraph->GetFName();
+        Entry.NameLower = MacroGraph->GetName().ToLower();
+        Entry.ClassName = Blueprint->GetName();
+        Entry.MacroGraph = MacroGraph;
+        AddEntry(MoveTemp(Entry));
+    }
+}
+
+void FNodeCatalog::AddEntry(FNodeCatalogEntry&& Entry)
+{
+    const int32 Index = Entries.Num();
+    ByName.FindOrAdd(Entry.Name).Add(Index);
+
+    // Names repeat trigrams ("getactorlocation" has two "ion"s): index each once
+    TArray<uint32, TInlineAllocator<64>> Seen;
+    ForEachTrigram(Entry.NameLower, [this, Index, &Seen](uint32 Trigram)
+    {
+        if (!Seen.Contains(Trigram))
+        {
+            Seen.Add(Trigram);
+            Trigrams.FindOrAdd(Trigram).Add(Index);
+        }
+    });
+
+    Entries.Add(MoveTemp(Entry));
+}
+
+int32 FNodeCatalog::RemoveEntriesOf(const FString& OwnerName)
+{
+    int32 Removed = 0;
+    for (FNodeCatalogEntry& Entry : Entries)
+    {
+        if ((Entry.Function.IsValid() || Entry.MacroGraph.IsValid()) && Entry.ClassName == OwnerName)
+        {
+            Entry.Function.Reset();
+            Entry.MacroGraph.Reset();
+            ++Removed;
+        }
+    }
+    NumRemoved += Removed;
+    return Removed;
+}
+
+void FNodeCatalog::ForEachTrigram(const FString& Lower, TFunctionRef<void(uint32)> Visitor)
+{
+    // 10 bits per character: exact for ASCII, collisions elsewhere are filtered by the substring check
+    for (int32 Index = 0; Index + 2 < Lower.Len(); ++Index)
+    {
+        const uint32 Trigram = ((uint32)(Lower[Index] & 0x3FF) << 20)
+            | ((uint32)(Lower[Index + 1] & 0x3FF) << 10)
+            | (uint32)(Lower[Index + 2] & 0x3FF);
+        Visitor(Trigram);
+    }
+}
+
+void FNodeCatalog::OnModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+    if (Reason != EModuleChangeReason::ModuleLoaded || bStale)
+    {
+        return;
+    }
+
+    // Only the new module's classes need to be added
+    const FString PackageName = FString::Printf(TEXT("/Script/%s"), *ModuleName.ToString());
+    if (UPackage* Package = FindPackage(nullptr, *PackageName))
+    {
+        const int32 Before = Entries.Num();
+        ForEachObjectWithPackage(Package, [this](UObject* Object)
+        {
+            if (UClass* Class = Cast<UClass>(Object))
+            {
+                AddClass(Class);
+            }
+            return true;
+        }, false);
+
+        if (Entries.Num() > Before)
+        {
+            UE_LOG(LogNodeCatalog, Verbose, TEXT("Node catalogue: +%d actions from module %s"), Entries.Num() - Before, *ModuleName.ToString());
+        }
+    }
+}
+
+void FNodeCatalog::OnBlueprintPreCompile(UBlueprint* Blueprint)
+{
+    if (!bStale && Blueprint)
+    {
+        PendingCompiled.AddUnique(Blueprint);
+    }
+}
+
+void FNodeCatalog::OnBlueprintCompiled()
+{
+    if (bStale)
+    {
+        return;
+    }
+    if (PendingCompiled.Num() == 0)
+    {
+        // Compiled without a pre-compile notice: no way to tell which classes changed
+        MarkStale();
+        return;
+    }
+
+    // The compile may have recreated every function on the class: drop its old entries and add it again
+    int32 Removed = 0;
+    const int32 Before = Entries.Num();
+    for (const TWeakObjectPtr<UBlueprint>& WeakBlueprint : PendingCompiled)
+    {
+        UBlueprint* Blueprint = WeakBlueprint.Get();
+        if (!Blueprint)
+        {
+            continue;
+        }
+
+        if (Blueprint->BlueprintType == BPTYPE_MacroLibrary)
+        {
+            Removed += RemoveEntriesOf(Blueprint->GetName());
+            AddMacroLibrary(Blueprint);
+        }
+        else if (UClass* GeneratedClass = Blueprint->GeneratedClass)
+        {
+            Removed += RemoveEntriesOf(GeneratedClass->GetName());
+            CataloguedClasses.Remove(GeneratedClass);
+            AddClass(GeneratedClass);
+        }
+    }
+    PendingCompiled.Reset();
+
+    UE_LOG(LogNodeCatalog, Verbose, TEXT("Node catalogue: -%d/+%d actions after Blueprint compile"), Removed, Entries.Num() - Before);
+
+    // Dropped entries still cost postings walks: compact once they are a quarter of the catalogue
+    if (NumRemoved * 4 > Entries.Num())
+    {
+        MarkStale();
+    }
+}
+
+// =========================================================================
+// QUERIES
+// =========================================================================
+
+int32 FNodeCatalog::ScoreMatch(const FNodeCatalogEntry& Entry, const FString& TermLower)
+{
+    // Shorter names rank higher within a tier
+    const int32 LengthPenalty = FMath::Min(Entry.NameLower.Len() - TermLower.Len(), 99);
+
+    if (TermLower.IsEmpty())
+    {
+        return 100 - LengthPenalty;
+    }
+
+    const int32 Position = Entry.NameLower.Find(TermLower, ESearchCase::CaseSensitive);
+    if (Position == INDEX_NONE)
+    {
+        return INDEX_NONE;
+    }
+    if (Position == 0)
+    {
+        return (Entry.NameLower.Len() == TermLower.Len() ? 1000 : 800) - LengthPenalty;
+    }
+
+    // Word start: after an underscore or at a CamelCase boundary ("GetActor|Location")
+    const FString Name = Entry.Name.ToString();
+    const bool bWordStart = Name.IsValidIndex(Position)
+        && (Name[Position - 1] == TEXT('_') || (FChar::IsUpper(Name[Position]) && !FChar::IsUpper(Name[Position - 1])));
+    return (bWordStart ? 500 : 200) - LengthPenalty;
+}
+
+void FNodeCatalog::Search(const FString& SearchTerm, const FString& ClassFilter, int32 MaxResults, TArray<FNodeCatalogMatch>& OutMatches)
+{
+    EnsureBuilt();
+    OutMatches.Reset();
+
+    const FString TermLower = SearchTerm.ToLower();
+    auto Consider = [this, &TermLower, &ClassFilter, &OutMatches](int32 Index)
+    {
+        const FNodeCatalogEntry& Entry = Entries[Index];
+        if (!ClassFilter.IsEmpty() && !Entry.ClassName.Contains(ClassFilter))
+        {
+            return;
+        }
+        if (!Entry.Function.IsValid() && !Entry.MacroGraph.IsValid())
+        {
+            return;
+        }
+        const int32 Score = ScoreMatch(Entry, TermLower);
+        if (Score != INDEX_NONE)
+        {
+            OutMatches.Add({ &Entry, Score });
+        }
+    };
+
+    if (TermLower.Len() >= 3)
+    {
+        // Walk the rarest trigram's postings; every hit is confirmed by ScoreMatch
+        const TArray<int32>* Rarest = nullptr;
+        bool bAllPresent = true;
+        ForEachTrigram(TermLower, [this, &Rarest, &bAllPresent](uint32 Trigram)
+        {
+            const TArray<int32>* Postings = Trigrams.Find(Trigram);
+            if (!Postings)
+            {
+                bAllPresent = false;
+            }
+            else if (!Rarest || Postings->Num() < Rarest->Num())
+            {
+                Rarest = Postings;
+            }
+        });
+
+        if (bAllPresent && Rarest)
+        {
+            for (int32 Index : *Rarest)
+            {
+                Consider(Index);
+            }
+        }
+    }
+    else
+    {
+        for (int32 Index = 0; Index < Entries.Num(); ++Index)
+        {
+            Consider(Index);
+        }
+    }
+
+    OutMatches.Sort([](const FNodeCatalogMatch& A, const FNodeCatalogMatch& B)
+    {
+        if (A.Score != B.Score)
+        {
+            return A.Score > B.Score;
+        }
+        if (A.Entry->NameLower != B.Entry->NameLower)
+        {
+            return A.Entry->NameLower < B.Entry->NameLower;
+        }
+        return A.Entry->ClassName < B.Entry->ClassName;
+    });
+
+    if (MaxResults >= 0 && OutMatches.Num() > MaxResults)
+    {
+        OutMatches.SetNum(MaxResults);
+    }
+}
+
+UFunction* FNodeCatalog::FindFunction(FName FunctionName)
+{
+    EnsureBuilt();
+
+    if (const TArray<int32>* Indices = ByName.Find(FunctionName))
+    {
+        for (int32 Index : *Indices)
+        {
+            const FNodeCatalogEntry& Entry = Entries[Index];
+            if (Entry.Kind == ENodeCatalogKind::Function)
+            {
+                if (UFunction* Function = Entry.Function.Get())
+                {
+                    return Function;
+                }
+            }
+        }
+    }
+    return nullptr;
+}
+
+UEdGraph* FNodeCatalog::FindMacro(FName MacroName)
+{
+    EnsureBuilt();
+
+    if (const TArray<int32>* Indices = ByName.Find(MacroName))
+    {
+        for (int32 Index : *Indices)
+        {
+            const FNodeCatalogEntry& Entry = Entries[Index];
+            if (Entry.Kind == ENodeCatalogKind::Macro)
+            {
+                if (UEdGraph* MacroGraph = Entry.MacroGraph.Get())
+                {
+                    return MacroGraph;
+                }
+            }
+        }
+    }
+    return nullptr;
+}
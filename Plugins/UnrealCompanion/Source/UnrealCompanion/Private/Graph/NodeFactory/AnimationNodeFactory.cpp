@@ -26,10 +26,53 @@
 #include "AnimStateNode.h"
 #include "AnimStateConduitNode.h"
 #include "AnimStateTransitionNode.h"
+#include "AnimStateEntryNode.h"
+#include "AnimationStateGraph.h"
+#include "AnimationTransitionGraph.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/BlendSpace.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_CallFunction.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Commands/UnrealCompanionAssetIndex.h"
 #include "EdGraph/EdGraph.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogAnimationNodeFactory, Log, All);
 
+namespace
+{
+    /** Innermost live FScopedAssetBatch (game thread only) */
+    FAnimationNodeFactory::FScopedAssetBatch* GActiveAssetBatch = nullptr;
+
+    FVector2D GetSpecPosition(const TSharedPtr<FJsonObject>& Spec, const FVector2D& Default)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* PosArray = nullptr;
+        if (Spec->TryGetArrayField(TEXT("position"), PosArray) && PosArray && PosArray->Num() >= 2)
+        {
+            return FVector2D((*PosArray)[0]->AsNumber(), (*PosArray)[1]->AsNumber());
+        }
+        return Default;
+    }
+
+    bool ConnectPins(UEdGraphPin* From, UEdGraphPin* To)
+    {
+        return From && To && From->GetOwningNode()->GetGraph()->GetSchema()->TryCreateConnection(From, To);
+    }
+}
+
+FAnimationNodeFactory::FScopedAssetBatch::FScopedAssetBatch()
+    : Outer(GActiveAssetBatch)
+{
+    check(IsInGameThread() && FUnrealCompanionScratch::IsActive());
+    GActiveAssetBatch = this;
+}
+
+FAnimationNodeFactory::FScopedAssetBatch::~FScopedAssetBatch()
+{
+    check(GActiveAssetBatch == this);
+    GActiveAssetBatch = Outer;
+}
+
 // =========================================================================
 // HELPERS
 // =========================================================================
@@ -51,6 +94,43 @@ UAnimBlueprint* FAnimationNodeFactory::GetAnimBlueprintFromGraph(UEdGraph* Graph
     return nullptr;
 }
 
+UObject* FAnimationNodeFactory::FindAnimAsset(const FString& NameOrPath, UClass* Class) const
+{
+    const FString Key = Class->GetName() + TEXT(":") + NameOrPath;
+    if (GActiveAssetBatch)
+    {
+        if (UObject** Cached = GActiveAssetBatch->Assets.Find(Key))
+        {
+            return *Cached;
+        }
+    }
+
+    // Paths load directly; bare names go through the asset index instead of a registry scan
+    UObject* Found = nullptr;
+    if (NameOrPath.StartsWith(TEXT("/")))
+    {
+        Found = StaticLoadObject(Class, nullptr, *NameOrPath);
+    }
+    else
+    {
+        FSoftObjectPath ObjectPath;
+        if (FUnrealCompanionAssetIndex::Get().FindAsset(NameOrPath, Class, true, false, ObjectPath))
+        {
+            Found = ObjectPath.TryLoad();
+        }
+    }
+    if (Found && !Found->IsA(Class))
+    {
+        Found = nullptr;
+    }
+
+    if (GActiveAssetBatch)
+    {
+        GActiveAssetBatch->Assets.Add(Key, Found);
+    }
+    return Found;
+}
+
 // =========================================================================
 // MAIN INTERFACE
 // =========================================================================
@@ -296,7 +376,7 @@ UEdGraphNode* FAnimationNodeFactory::CreateBlendSpacePlayerNode(UEdGraph* Graph,
     FString BlendSpacePath;
     if (Params->TryGetStringField(TEXT("blend_space"), BlendSpacePath) && !BlendSpacePath.IsEmpty())
     {
-        UBlendSpace* BlendSpace = LoadObject<UBlendSpace>(nullptr, *BlendSpacePath);
+        UBlendSpace* BlendSpace = Cast<UBlendSpace>(FindAnimAsset(BlendSpacePath, UBlendSpace::StaticClass()));
         if (BlendSpace)
         {
             Node->Node.SetBlendSpace(BlendSpace);
@@ -339,7 +419,7 @@ UEdGraphNode* FAnimationNodeFactory::CreateSequencePlayerNode(UEdGraph* Graph, c
     FString SequencePath;
     if (Params->TryGetStringField(TEXT("sequence"), SequencePath) && !SequencePath.IsEmpty())
     {
-        UAnimSequence* Sequence = LoadObject<UAnimSequence>(nullptr, *SequencePath);
+        UAnimSequence* Sequence = Cast<UAnimSequence>(FindAnimAsset(SequencePath, UAnimSequence::StaticClass()));
         if (Sequence)
         {
             Node->Node.SetSequence(Sequence);
@@ -357,7 +437,7 @@ UEdGraphNode* FAnimationNodeFactory::CreateSequenceEvaluatorNode(UEdGraph* Graph
     FString SequencePath;
     if (Params->TryGetStringField(TEXT("sequence"), SequencePath) && !SequencePath.IsEmpty())
     {
-        UAnimSequence* Sequence = LoadObject<UAnimSequence>(nullptr, *SequencePath);
+        UAnimSequence* Sequence = Cast<UAnimSequence>(FindAnimAsset(SequencePath, UAnimSequence::StaticClass()));
         if (Sequence)
         {
             Node->Node.SetSequence(Sequence);
@@ -461,3 +541,304 @@ UEdGraphNode* FAnimationNodeFactory::CreateSlotNode(UEdGraph* Graph, const TShar
 
     return Node;
 }
+
+// =========================================================================
+// STATE MACHINE BATCH
+// =========================================================================
+
+bool FAnimationNodeFactory::BuildStateMachine(UEdGraph* Graph, const TSharedPtr<FJsonObject>& Spec, FStateMachineBuild& OutBuild, FString& OutError)
+{
+    if (!Graph || !Spec.IsValid())
+    {
+        OutError = TEXT("State machine spec needs a graph and an object");
+        return false;
+    }
+
+    // Target machine: an existing one by GUID, or a new node in this graph
+    FString MachineId;
+    if (Spec->TryGetStringField(TEXT("machine_id"), MachineId) && !MachineId.IsEmpty())
+    {
+        FGuid Guid;
+        if (FGuid::Parse(MachineId, Guid))
+        {
+            for (UEdGraphNode* Node : Graph->Nodes)
+            {
+                if (Node && Node->NodeGuid == Guid)
+                {
+                    OutBuild.MachineNode = Cast<UAnimGraphNode_StateMachine>(Node);
+                    break;
+                }
+            }
+        }
+        if (!OutBuild.MachineNode)
+        {
+            OutError = FString::Printf(TEXT("State machine node not found: %s"), *MachineId);
+            return false;
+        }
+    }
+    else
+    {
+        UEdGraphNode* Node = CreateStateMachineNode(Graph, Spec, GetSpecPosition(Spec, FVector2D::ZeroVector), OutError);
+        OutBuild.MachineNode = Cast<UAnimGraphNode_StateMachine>(Node);
+        if (!OutBuild.MachineNode)
+        {
+            return false;
+        }
+        OutBuild.bCreatedMachine = true;
+
+        FString MachineName;
+        if (Spec->TryGetStringField(TEXT("name"), MachineName) && !MachineName.IsEmpty())
+        {
+            OutBuild.MachineNode->OnRenameNode(MachineName);
+        }
+    }
+
+    UAnimationStateMachineGraph* MachineGraph = OutBuild.MachineNode->EditorStateMachineGraph;
+    if (!MachineGraph)
+    {
+        OutError = TEXT("State machine node has no state machine graph");
+        return false;
+    }
+    MachineGraph->Modify();
+
+    // States already in the machine can be used as transition ends
+    for (UEdGraphNode* Node : MachineGraph->Nodes)
+    {
+        if (UAnimStateNodeBase* Existing = Cast<UAnimStateNodeBase>(Node))
+        {
+            if (!Existing->IsA<UAnimStateTransitionNode>())
+            {
+                OutBuild.States.Add(Existing->GetStateName(), Existing);
+            }
+        }
+    }
+
+    // States, laid out on a row unless positioned
+    const TArray<TSharedPtr<FJsonValue>>* StatesArray = nullptr;
+    if (Spec->TryGetArrayField(TEXT("states"), StatesArray) && StatesArray)
+    {
+        for (int32 Index = 0; Index < StatesArray->Num(); ++Index)
+        {
+            const TSharedPtr<FJsonObject>* StateSpec = nullptr;
+            FString StateName;
+            if (!(*StatesArray)[Index]->TryGetObject(StateSpec) || !(*StateSpec)->TryGetStringField(TEXT("name"), StateName) || StateName.IsEmpty())
+            {
+                OutBuild.Errors.Add(FString::Printf(TEXT("State %d: missing 'name'"), Index));
+                continue;
+            }
+            if (OutBuild.States.Contains(StateName))
+            {
+                OutBuild.Errors.Add(FString::Printf(TEXT("State '%s' already exists"), *StateName));
+                continue;
+            }
+
+            bool bConduit = false;
+            (*StateSpec)->TryGetBoolField(TEXT("conduit"), bConduit);
+
+            const FVector2D Position = GetSpecPosition(*StateSpec, FVector2D(300.0 * (Index + 1), 0.0));
+            UAnimStateNodeBase* State = nullptr;
+            if (bConduit)
+            {
+                State = NewObject<UAnimStateConduitNode>(MachineGraph);
+            }
+            else
+            {
+                State = NewObject<UAnimStateNode>(MachineGraph);
+            }
+            SetupNode(State, MachineGraph, Position);
+
+            // The state's name is its bound graph's name
+            State->OnRenameNode(StateName);
+            OutBuild.States.Add(StateName, State);
+            ++OutBuild.StatesCreated;
+
+            if (!bConduit)
+            {
+                BuildStatePose(State, *StateSpec, OutBuild);
+            }
+        }
+    }
+
+    // Transitions with their rule graphs
+    const TArray<TSharedPtr<FJsonValue>>* TransitionsArray = nullptr;
+    if (Spec->TryGetArrayField(TEXT("transitions"), TransitionsArray) && TransitionsArray)
+    {
+        for (int32 Index = 0; Index < TransitionsArray->Num(); ++Index)
+        {
+            const TSharedPtr<FJsonObject>* TransitionSpec = nullptr;
+            FString FromName, ToName;
+            if (!(*TransitionsArray)[Index]->TryGetObject(TransitionSpec) ||
+                !(*TransitionSpec)->TryGetStringField(TEXT("from"), FromName) ||
+                !(*TransitionSpec)->TryGetStringField(TEXT("to"), ToName))
+            {
+                OutBuild.Errors.Add(FString::Printf(TEXT("Transition %d: needs 'from' and 'to'"), Index));
+                continue;
+            }
+
+            UAnimStateNodeBase** From = OutBuild.States.Find(FromName);
+            UAnimStateNodeBase** To = OutBuild.States.Find(ToName);
+            if (!From || !To)
+            {
+                OutBuild.Errors.Add(FString::Printf(TEXT("Transition %s -> %s: unknown state '%s'"),
+                    *FromName, *ToName, From ? *ToName : *FromName));
+                continue;
+            }
+
+            const FVector2D Midpoint(((*From)->NodePosX + (*To)->NodePosX) * 0.5, ((*From)->NodePosY + (*To)->NodePosY) * 0.5);
+            UAnimStateTransitionNode* Transition = NewObject<UAnimStateTransitionNode>(MachineGraph);
+            SetupNode(Transition, MachineGraph, Midpoint);
+            Transition->CreateConnections(*From, *To);
+
+            double Crossfade = 0.0;
+            if ((*TransitionSpec)->TryGetNumberField(TEXT("crossfade"), Crossfade))
+            {
+                Transition->CrossfadeDuration = (float)Crossfade;
+            }
+            (*TransitionSpec)->TryGetBoolField(TEXT("bidirectional"), Transition->Bidirectional);
+
+            OutBuild.Transitions.Add(Transition);
+            BuildTransitionRule(Transition, *TransitionSpec, OutBuild);
+        }
+    }
+
+    // Entry state
+    FString EntryName;
+    if (Spec->TryGetStringField(TEXT("entry"), EntryName) && !EntryName.IsEmpty())
+    {
+        UAnimStateNodeBase** Entry = OutBuild.States.Find(EntryName);
+        UEdGraphPin* EntryPin = MachineGraph->EntryNode ? MachineGraph->EntryNode->GetOutputPin() : nullptr;
+        if (!Entry || !EntryPin)
+        {
+            OutBuild.Errors.Add(FString::Printf(TEXT("Entry state not found: %s"), *EntryName));
+        }
+        else
+        {
+            EntryPin->BreakAllPinLinks();
+            if (!ConnectPins(EntryPin, (*Entry)->GetInputPin()))
+            {
+                OutBuild.Errors.Add(FString::Printf(TEXT("Could not link entry to '%s'"), *EntryName));
+            }
+        }
+    }
+
+    return true;
+}
+
+bool FAnimationNodeFactory::BuildStatePose(UAnimStateNodeBase* State, const TSharedPtr<FJsonObject>& StateSpec, FStateMachineBuild& OutBuild)
+{
+    const bool bHasSequence = StateSpec->HasField(TEXT("sequence"));
+    const bool bHasBlendSpace = StateSpec->HasField(TEXT("blend_space"));
+    if (!bHasSequence && !bHasBlendSpace)
+    {
+        return true;
+    }
+
+    UAnimationStateGraph* StateGraph = Cast<UAnimationStateGraph>(State->GetBoundGraph());
+    UAnimGraphNode_StateResult* ResultNode = StateGraph ? StateGraph->GetResultNode() : nullptr;
+    if (!ResultNode)
+    {
+        OutBuild.Errors.Add(FString::Printf(TEXT("State '%s' has no result node"), *State->GetStateName()));
+        return false;
+    }
+
+    // The player sits left of the result; it resolves its asset through the batch memo
+    const FVector2D Position(ResultNode->NodePosX - 300.0, ResultNode->NodePosY);
+    FString Error;
+    UEdGraphNode* Player = bHasSequence
+        ? CreateSequencePlayerNode(StateGraph, StateSpec, Position, Error)
+        : CreateBlendSpacePlayerNode(StateGraph, StateSpec, Position, Error);
+    if (!Player)
+    {
+        OutBuild.Errors.Add(FString::Printf(TEXT("State '%s': %s"), *State->GetStateName(), *Error));
+        return false;
+    }
+    ++OutBuild.PoseNodesCreated;
+
+    const FString AssetName = StateSpec->GetStringField(bHasSequence ? TEXT("sequence") : TEXT("blend_space"));
+    if (!FindAnimAsset(AssetName, bHasSequence ? UAnimSequence::StaticClass() : UBlendSpace::StaticClass()))
+    {
+        OutBuild.Errors.Add(FString::Printf(TEXT("State '%s': asset not found: %s"), *State->GetStateName(), *AssetName));
+    }
+
+    if (!ConnectPins(Player->FindPin(TEXT("Pose"), EGPD_Output), ResultNode->FindPin(TEXT("Result"), EGPD_Input)))
+    {
+        OutBuild.Errors.Add(FString::Printf(TEXT("State '%s': could not connect the player to the state result"), *State->GetStateName()));
+        return false;
+    }
+    return true;
+}
+
+bool FAnimationNodeFactory::BuildTransitionRule(UAnimStateTransitionNode* Transition, const TSharedPtr<FJsonObject>& TransitionSpec, FStateMachineBuild& OutBuild)
+{
+    bool bAutomatic = false;
+    if (TransitionSpec->TryGetBoolField(TEXT("automatic"), bAutomatic) && bAutomatic)
+    {
+        // Fires when the source state's player is about to finish; the rule graph is ignored
+        Transition->bAutomaticRuleBasedOnSequencePlayerInState = true;
+        ++OutBuild.RulesBound;
+        return true;
+    }
+
+    UAnimationTransitionGraph* RuleGraph = Cast<UAnimationTransitionGraph>(Transition->BoundGraph);
+    UAnimGraphNode_TransitionResult* ResultNode = RuleGraph ? RuleGraph->GetResultNode() : nullptr;
+    UEdGraphPin* CanEnterPin = ResultNode ? ResultNode->FindPin(TEXT("bCanEnterTransition"), EGPD_Input) : nullptr;
+    const FString TransitionName = FString::Printf(TEXT("%s -> %s"),
+        Transition->GetPreviousState() ? *Transition->GetPreviousState()->GetStateName() : TEXT("?"),
+        Transition->GetNextState() ? *Transition->GetNextState()->GetStateName() : TEXT("?"));
+    if (!CanEnterPin)
+    {
+        OutBuild.Errors.Add(FString::Printf(TEXT("Transition %s has no rule result"), *TransitionName));
+        return false;
+    }
+
+    bool bValue = false;
+    if (TransitionSpec->TryGetBoolField(TEXT("value"), bValue))
+    {
+        CanEnterPin->DefaultValue = bValue ? TEXT("true") : TEXT("false");
+        ++OutBuild.RulesBound;
+        return true;
+    }
+
+    FString RuleVariable;
+    if (!TransitionSpec->TryGetStringField(TEXT("rule"), RuleVariable) || RuleVariable.IsEmpty())
+    {
+        // No rule: the transition exists and can be wired later
+        return true;
+    }
+
+    UAnimBlueprint* AnimBP = GetAnimBlueprintFromGraph(RuleGraph);
+    UClass* SearchClass = AnimBP ? (AnimBP->SkeletonGeneratedClass ? AnimBP->SkeletonGeneratedClass : AnimBP->GeneratedClass) : nullptr;
+    if (!SearchClass || !FindFProperty<FBoolProperty>(SearchClass, FName(*RuleVariable)))
+    {
+        OutBuild.Errors.Add(FString::Printf(TEXT("Transition %s: bool variable not found: %s"), *TransitionName, *RuleVariable));
+        return false;
+    }
+
+    UK2Node_VariableGet* GetNode = NewObject<UK2Node_VariableGet>(RuleGraph);
+    GetNode->VariableReference.SetSelfMember(FName(*RuleVariable));
+    SetupNode(GetNode, RuleGraph, FVector2D(ResultNode->NodePosX - 400.0, ResultNode->NodePosY));
+    UEdGraphPin* ValuePin = GetNode->GetValuePin();
+
+    bool bNegate = false;
+    TransitionSpec->TryGetBoolField(TEXT("negate"), bNegate);
+    if (bNegate)
+    {
+        UK2Node_CallFunction* NotNode = NewObject<UK2Node_CallFunction>(RuleGraph);
+        NotNode->SetFromFunction(UKismetMathLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Not_PreBool)));
+        SetupNode(NotNode, RuleGraph, FVector2D(ResultNode->NodePosX - 200.0, ResultNode->NodePosY));
+        if (!ConnectPins(ValuePin, NotNode->FindPin(TEXT("A"), EGPD_Input)))
+        {
+            OutBuild.Errors.Add(FString::Printf(TEXT("Transition %s: could not negate %s"), *TransitionName, *RuleVariable));
+            return false;
+        }
+        ValuePin = NotNode->GetReturnValuePin();
+    }
+
+    if (!ConnectPins(ValuePin, CanEnterPin))
+    {
+        OutBuild.Errors.Add(FString::Printf(TEXT("Transition %s: could not bind rule %s"), *TransitionName, *RuleVariable));
+        return false;
+    }
+    ++OutBuild.RulesBound;
+    return true;
+}
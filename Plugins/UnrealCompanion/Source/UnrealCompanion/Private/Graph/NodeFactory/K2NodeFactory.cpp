@@ -2,6 +2,7 @@
 
 #include "Graph/NodeFactory/K2NodeFactory.h"
 #include "Graph/GraphOperations.h"
+#include "Graph/NodeCatalog.h"
 #include "Commands/UnrealCompanionCommonUtils.h"
 
 #include "EdGraph/EdGraph.h"
@@ -48,9 +49,136 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/KismetArrayLibrary.h"
 #include "Kismet/GameplayStatics.h"
+#include "Modules/ModuleManager.h"
+#include "Editor.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogK2NodeFactory, Log, All);
 
+// =========================================================================
+// RESOLUTION CACHE
+// =========================================================================
+
+namespace
+{
+    /**
+     * Process-wide memo of class/function resolutions shared by every FK2NodeFactory.
+     * Hits are held weakly (a GC'd class simply misses again); misses are remembered
+     * until something that could make them resolvable happens.
+     */
+    struct FK2ResolutionCache
+    {
+        TMap<FString, TWeakObjectPtr<UClass>> Classes;
+        TSet<FString> MissingClasses;
+        TMap<FString, TWeakObjectPtr<UFunction>> Functions;
+        TSet<FString> MissingFunctions;
+
+        FDelegateHandle BlueprintCompiledHandle;
+        FDelegateHandle AssetAddedHandle;
+        FDelegateHandle ModulesChangedHandle;
+        FDelegateHandle ReloadCompleteHandle;
+
+        static FK2ResolutionCache& Get()
+        {
+            static FK2ResolutionCache Instance;
+            Instance.HookInvalidation();
+            return Instance;
+        }
+
+        void HookInvalidation()
+        {
+            if (ModulesChangedHandle.IsValid())
+            {
+                return;
+            }
+            ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddLambda([](FName, EModuleChangeReason)
+            {
+                FK2NodeFactory::InvalidateResolutionCache();
+            });
+            ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+            {
+                FK2NodeFactory::InvalidateResolutionCache();
+            });
+            if (GEditor)
+            {
+                BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddStatic(&FK2NodeFactory::InvalidateResolutionCache);
+            }
+            if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+            {
+                // A new Blueprint can turn a remembered miss into a hit
+                AssetAddedHandle = AssetRegistry->OnAssetAdded().AddLambda([](const FAssetData&)
+                {
+                    FK2ResolutionCache::Get().ClearMisses();
+                });
+            }
+        }
+
+        ~FK2ResolutionCache()
+        {
+            if (!ModulesChangedHandle.IsValid())
+            {
+                return;
+            }
+            if (FModuleManager* ModuleManager = FModuleManager::TryGet())
+            {
+                ModuleManager->OnModulesChanged().Remove(ModulesChangedHandle);
+            }
+            FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+            if (GEditor)
+            {
+                GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+            }
+            if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+            {
+                AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+            }
+        }
+
+        void ClearMisses()
+        {
+            MissingClasses.Reset();
+            MissingFunctions.Reset();
+        }
+
+        void Clear()
+        {
+            Classes.Reset();
+            Functions.Reset();
+            ClearMisses();
+        }
+    };
+
+    /** Innermost live FScopedResolutionBatch (game thread only) */
+    FK2NodeFactory::FScopedResolutionBatch* GActiveResolutionBatch = nullptr;
+
+    FString MakeFunctionKey(const FString& FunctionName, const UClass* TargetClass)
+    {
+        return TargetClass ? TargetClass->GetPathName() + TEXT(":") + FunctionName : FunctionName;
+    }
+}
+
+FK2NodeFactory::FScopedResolutionBatch::FScopedResolutionBatch()
+    : Outer(GActiveResolutionBatch)
+{
+    check(IsInGameThread() && FUnrealCompanionScratch::IsActive());
+    GActiveResolutionBatch = this;
+}
+
+FK2NodeFactory::FScopedResolutionBatch::~FScopedResolutionBatch()
+{
+    check(GActiveResolutionBatch == this);
+    GActiveResolutionBatch = Outer;
+}
+
+void FK2NodeFactory::InvalidateResolutionCache()
+{
+    FK2ResolutionCache::Get().Clear();
+    for (FScopedResolutionBatch* Batch = GActiveResolutionBatch; Batch; Batch = Batch->Outer)
+    {
+        Batch->Classes.Reset();
+        Batch->Functions.Reset();
+    }
+}
+
 // =========================================================================
 // MAIN INTERFACE
 // =========================================================================
@@ -259,6 +387,50 @@ UBlueprint* FK2NodeFactory::GetBlueprintFromGraph(UEdGraph* Graph) const
 }
 
 UClass* FK2NodeFactory::FindClassByName(const FString& ClassName) const
+{
+    if (GActiveResolutionBatch)
+    {
+        if (UClass** Cached = GActiveResolutionBatch->Classes.Find(ClassName))
+        {
+            return *Cached;
+        }
+    }
+
+    FK2ResolutionCache& Cache = FK2ResolutionCache::Get();
+    UClass* Found = nullptr;
+    bool bFromGlobal = false;
+    if (const TWeakObjectPtr<UClass>* Cached = Cache.Classes.Find(ClassName))
+    {
+        Found = Cached->Get();
+        bFromGlobal = Found != nullptr;
+    }
+    else if (Cache.MissingClasses.Contains(ClassName))
+    {
+        bFromGlobal = true;
+    }
+
+    if (!bFromGlobal)
+    {
+        Found = ResolveClassByName(ClassName);
+        if (Found)
+        {
+            Cache.Classes.Add(ClassName, Found);
+        }
+        else
+        {
+            Cache.Classes.Remove(ClassName);
+            Cache.MissingClasses.Add(ClassName);
+        }
+    }
+
+    if (GActiveResolutionBatch)
+    {
+        GActiveResolutionBatch->Classes.Add(ClassName, Found);
+    }
+    return Found;
+}
+
+UClass* FK2NodeFactory::ResolveClassByName(const FString& ClassName) const
 {
     // 1. Try direct lookup for native classes
     UClass* Found = FindFirstObject<UClass>(*ClassName, EFindFirstObjectOptions::None);
@@ -319,6 +491,9 @@ UClass* FK2NodeFactory::FindClassByName(const FString& ClassName) const
     }
     
     // 4. Last resort: iterate through all Blueprint classes
+    // (candidate names are built once, not per iteration)
+    const FString ClassNameWithSuffix = ClassName + TEXT("_C");
+    const FString PathNameWithSuffix = BlueprintPath + TEXT("_C");
     for (TObjectIterator<UBlueprintGeneratedClass> It; It; ++It)
     {
         UBlueprintGeneratedClass* BGC = *It;
@@ -327,8 +502,8 @@ UClass* FK2NodeFactory::FindClassByName(const FString& ClassName) const
             FString BGCName = BGC->GetName();
             // Match with or without _C suffix
             if (BGCName == ClassName || 
-                BGCName == ClassName + TEXT("_C") ||
-                BGCName == BlueprintPath + TEXT("_C"))
+                BGCName == ClassNameWithSuffix ||
+                BGCName == PathNameWithSuffix)
             {
                 return BGC;
             }
@@ -355,6 +530,51 @@ UEnum* FK2NodeFactory::FindEnumByName(const FString& EnumName) const
 }
 
 UFunction* FK2NodeFactory::FindFunctionByName(const FString& FunctionName, UClass* TargetClass) const
+{
+    const FString Key = MakeFunctionKey(FunctionName, TargetClass);
+    if (GActiveResolutionBatch)
+    {
+        if (UFunction** Cached = GActiveResolutionBatch->Functions.Find(Key))
+        {
+            return *Cached;
+        }
+    }
+
+    FK2ResolutionCache& Cache = FK2ResolutionCache::Get();
+    UFunction* Function = nullptr;
+    bool bFromGlobal = false;
+    if (const TWeakObjectPtr<UFunction>* Cached = Cache.Functions.Find(Key))
+    {
+        Function = Cached->Get();
+        bFromGlobal = Function != nullptr;
+    }
+    else if (Cache.MissingFunctions.Contains(Key))
+    {
+        bFromGlobal = true;
+    }
+
+    if (!bFromGlobal)
+    {
+        Function = ResolveFunctionByName(FunctionName, TargetClass);
+        if (Function)
+        {
+            Cache.Functions.Add(Key, Function);
+        }
+        else
+        {
+            Cache.Functions.Remove(Key);
+            Cache.MissingFunctions.Add(Key);
+        }
+    }
+
+    if (GActiveResolutionBatch)
+    {
+        GActiveResolutionBatch->Functions.Add(Key, Function);
+    }
+    return Function;
+}
+
+UFunction* FK2NodeFactory::ResolveFunctionByName(const FString& FunctionName, UClass* TargetClass) const
 {
     UFunction* Function = nullptr;
     
@@ -388,7 +608,8 @@ UFunction* FK2NodeFactory::FindFunctionByName(const FString& FunctionName, UClas
         if (Function) return Function;
     }
     
-    return nullptr;
+    // Any other callable function known to the node catalogue (plugin libraries, etc.)
+    return FNodeCatalog::Get().FindFunction(FName(*FunctionName));
 }
 
 // =========================================================================
@@ -1077,7 +1298,11 @@ UEdGraphNode* FK2NodeFactory::CreateMacroNode(UEdGraph* Graph, const TSharedPtr<
         }
     }
     
-    // TODO: Search in other blueprints/libraries if needed
+    // Then macro libraries (StandardMacros: ForLoop, DoOnce, ...)
+    if (!MacroGraph)
+    {
+        MacroGraph = FNodeCatalog::Get().FindMacro(FName(*MacroName));
+    }
     
     if (!MacroGraph)
     {
@@ -32,6 +32,7 @@
 #include "EdGraph/EdGraph.h"
 #include "MaterialGraph/MaterialGraph.h"
 #include "MaterialGraph/MaterialGraphNode.h"
+#include "MaterialGraph/MaterialGraphNode_Comment.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogMaterialNodeFactory, Log, All);
 
@@ -67,12 +68,33 @@ T* FMaterialNodeFactory::CreateMaterialExpression(UMaterial* Material, FVector2D
     {
         Expression->MaterialExpressionEditorX = static_cast<int32>(Position.X);
         Expression->MaterialExpressionEditorY = static_cast<int32>(Position.Y);
-        Material->GetExpressionCollection().AddExpression(Expression);
-        Material->AddExpressionParameter(Expression, Material->EditorParameters);
+        if constexpr (std::is_same_v<T, UMaterialExpressionComment>)
+        {
+            Material->GetExpressionCollection().AddComment(Expression);
+        }
+        else
+        {
+            Material->GetExpressionCollection().AddExpression(Expression);
+            Material->AddExpressionParameter(Expression, Material->EditorParameters);
+        }
     }
     return Expression;
 }
 
+UEdGraphNode* FMaterialNodeFactory::AddGraphNode(UEdGraph* Graph, UMaterialExpression* Expression) const
+{
+    UMaterialGraph* MatGraph = Cast<UMaterialGraph>(Graph);
+    if (!MatGraph || !Expression) return nullptr;
+
+    // Only this expression's node: RebuildGraph would recreate every node, dropping links
+    // not yet copied to the expressions and invalidating node pointers held by the caller
+    if (UMaterialExpressionComment* Comment = Cast<UMaterialExpressionComment>(Expression))
+    {
+        return MatGraph->AddComment(Comment, false);
+    }
+    return MatGraph->AddExpression(Expression, false);
+}
+
 // =========================================================================
 // MAIN INTERFACE
 // =========================================================================
@@ -247,23 +269,7 @@ UEdGraphNode* FMaterialNodeFactory::CreateTextureSampleNode(UEdGraph* Graph, con
         }
     }
 
-    // Find the graph node for this expression
-    if (UMaterialGraph* MatGraph = Cast<UMaterialGraph>(Graph))
-    {
-        MatGraph->RebuildGraph();
-        for (UEdGraphNode* Node : MatGraph->Nodes)
-        {
-            if (UMaterialGraphNode* MatNode = Cast<UMaterialGraphNode>(Node))
-            {
-                if (MatNode->MaterialExpression == Expression)
-                {
-                    return MatNode;
-                }
-            }
-        }
-    }
-
-    return nullptr;
+    return AddGraphNode(Graph, Expression);
 }
 
 UEdGraphNode* FMaterialNodeFactory::CreateTextureObjectNode(UEdGraph* Graph, const TSharedPtr<FJsonObject>& Params, FVector2D Position, FString& OutError)
@@ -292,22 +298,7 @@ UEdGraphNode* FMaterialNodeFactory::CreateTextureObjectNode(UEdGraph* Graph, con
         }
     }
 
-    if (UMaterialGraph* MatGraph = Cast<UMaterialGraph>(Graph))
-    {
-        MatGraph->RebuildGraph();
-        for (UEdGraphNode* Node : MatGraph->Nodes)
-        {
-            if (UMaterialGraphNode* MatNode = Cast<UMaterialGraphNode>(Node))
-            {
-                if (MatNode->MaterialExpression == Expression)
-                {
-                    return MatNode;
-                }
-            }
-        }
-    }
-
-    return nullptr;
+    return AddGraphNode(Graph, Expression);
 }
 
 // =========================================================================
@@ -329,22 +320,7 @@ UEdGraphNode* FMaterialNodeFactory::CreateConstantNode(UEdGraph* Graph, const TS
         }
     }
 
-    if (UMaterialGraph* MatGraph = Cast<UMaterialGraph>(Graph))
-    {
-        MatGraph->RebuildGraph();
-        for (UEdGraphNode* Node : MatGraph->Nodes)
-        {
-            if (UMaterialGraphNode* MatNode = Cast<UMaterialGraphNode>(Node))
-            {
-                if (MatNode->MaterialExpression == Expression)
-                {
-                    return MatNode;
-                }
-            }
-        }
-    }
-
-    return nullptr;
+    return AddGraphNode(Graph, Expression);
 }
 
 UEdGraphNode* FMaterialNodeFactory::CreateConstant2VectorNode(UEdGraph* Graph, const TSharedPtr<FJsonObject>& Params, FVector2D Position)
@@ -363,19 +339,7 @@ UEdGraphNode* FMaterialNodeFactory::CreateConstant2VectorNode(UEdGraph* Graph, c
         }
     }
 
-    if (UMaterialGraph* MatGraph = Cast<UMaterialGraph>(Graph))
-    {
-        MatGraph->RebuildGraph();
-        for (UEdGraphNode* Node : MatGraph->Nodes)
-        {
-            if (UMaterialGraphNode* MatNode = Cast<UMaterialGraphNode>(Node))
-            {
-                if (MatNode->MaterialExpression == Expression) return MatNode;
-            }
-        }
-    }
-
-    return nullptr;
+    return AddGraphNode(Graph, Expression);
 }
 
 UEdGraphNode* FMaterialNodeFactory::CreateConstant3VectorNode(UEdGraph* Graph, const TSharedPtr<FJsonObject>& Params, FVector2D Position)
@@ -397,19 +361,7 @@ UEdGraphNode* FMaterialNodeFactory::CreateConstant3VectorNode(UEdGraph* Graph, c
         }
     }
 
-    if (UMaterialGraph* MatGraph = Cast<UMaterialGraph>(Graph))
-    {
-        MatGraph->RebuildGraph();
-        for (UEdGraphNode* Node : MatGraph->Nodes)
-        {
-            if (UMaterialGraphNode* MatNode = Cast<UMaterialGraphNode>(Node))
-            {
-                if (MatNode->MaterialExpression == Expression) return MatNode;
-            }
-        }
-    }
-
-    return nullptr;
+    return AddGraphNode(Graph, Expression);
 }
 
 UEdGraphNode* FMaterialNodeFactory::CreateConstant4VectorNode(UEdGraph* Graph, const TSharedPtr<FJsonObject>& Params, FVector2D Position)
@@ -432,19 +384,7 @@ UEdGraphNode* FMaterialNodeFactory::CreateConstant4VectorNode(UEdGraph* Graph, c
         }
     }
 
-    if (UMaterialGraph* MatGraph = Cast<UMaterialGraph>(Graph))
-    {
-        MatGraph->RebuildGraph();
-        for (UEdGraphNode* Node : MatGraph->Nodes)
-        {
-            if (UMaterialGraphNode* MatNode = Cast<UMaterialGraphNode>(Node))
-            {
-                if (MatNode->MaterialExpression == Expression) return MatNode;
-            }
-        }
-    }
-
-    return nullptr;
+    return AddGraphNode(Graph, Expression);
 }
 
 // =========================================================================
@@ -479,19 +419,7 @@ UEdGraphNode* FMaterialNodeFactory::CreateScalarParameterNode(UEdGraph* Graph, c
         }
     }
 
-    if (UMaterialGraph* MatGraph = Cast<UMaterialGraph>(Graph))
-    {
-        MatGraph->RebuildGraph();
-        for (UEdGraphNode* Node : MatGraph->Nodes)
-        {
-            if (UMaterialGraphNode* MatNode = Cast<UMaterialGraphNode>(Node))
-            {
-                if (MatNode->MaterialExpression == Expression) return MatNode;
-            }
-        }
-    }
-
-    return nullptr;
+    return AddGraphNode(Graph, Expression);
 }
 
 UEdGraphNode* FMaterialNodeFactory::CreateVectorParameterNode(UEdGraph* Graph, const TSharedPtr<FJsonObject>& Params, FVector2D Position, FString& OutError)
@@ -527,19 +455,7 @@ UEdGraphNode* FMaterialNodeFactory::CreateVectorParameterNode(UEdGraph* Graph, c
         }
     }
 
-    if (UMaterialGraph* MatGraph = Cast<UMaterialGraph>(Graph))
-    {
-        MatGraph->RebuildGraph();
-        for (UEdGraphNode* Node : MatGraph->Nodes)
-        {
-            if (UMaterialGraphNode* MatNode = Cast<UMaterialGraphNode>(Node))
-            {
-                if (MatNode->MaterialExpression == Expression) return MatNode;
-            }
-        }
-    }
-
-    return nullptr;
+    return AddGraphNode(Graph, Expression);
 }
 
 UEdGraphNode* FMaterialNodeFactory::CreateTextureParameterNode(UEdGraph* Graph, const TSharedPtr<FJsonObject>& Params, FVector2D Position, FString& OutError)
@@ -574,19 +490,7 @@ UEdGraphNode* FMaterialNodeFactory::CreateTextureParameterNode(UEdGraph* Graph,
         }
     }
 
-    if (UMaterialGraph* MatGraph = Cast<UMaterialGraph>(Graph))
-    {
-        MatGraph->RebuildGraph();
-        for (UEdGraphNode* Node : MatGraph->Nodes)
-        {
-            if (UMaterialGraphNode* MatNode = Cast<UMaterialGraphNode>(Node))
-            {
-                if (MatNode->MaterialExpression == Expression) return MatNode;
-            }
-        }
-    }
-
-    return nullptr;
+    return AddGraphNode(Graph, Expression);
 }
 
 // =========================================================================
@@ -599,18 +503,7 @@ UEdGraphNode* FMaterialNodeFactory::FuncName(UEdGraph* Graph, FVector2D Position
     UMaterial* Material = GetMaterialFromGraph(Graph); \
     if (!Material) return nullptr; \
     UMaterialExpression* Expression = CreateMaterialExpression<ExpressionClass>(Material, Position); \
-    if (UMaterialGraph* MatGraph = Cast<UMaterialGraph>(Graph)) \
-    { \
-        MatGraph->RebuildGraph(); \
-        for (UEdGraphNode* Node : MatGraph->Nodes) \
-        { \
-            if (UMaterialGraphNode* MatNode = Cast<UMaterialGraphNode>(Node)) \
-            { \
-                if (MatNode->MaterialExpression == Expression) return MatNode; \
-            } \
-        } \
-    } \
-    return nullptr; \
+    return AddGraphNode(Graph, Expression); \
 }
 
 IMPLEMENT_SIMPLE_MATERIAL_NODE(CreateAddNode, UMaterialExpressionAdd)
@@ -639,19 +532,7 @@ UEdGraphNode* FMaterialNodeFactory::CreateTexCoordNode(UEdGraph* Graph, const TS
         Expression->CoordinateIndex = CoordIndex;
     }
 
-    if (UMaterialGraph* MatGraph = Cast<UMaterialGraph>(Graph))
-    {
-        MatGraph->RebuildGraph();
-        for (UEdGraphNode* Node : MatGraph->Nodes)
-        {
-            if (UMaterialGraphNode* MatNode = Cast<UMaterialGraphNode>(Node))
-            {
-                if (MatNode->MaterialExpression == Expression) return MatNode;
-            }
-        }
-    }
-
-    return nullptr;
+    return AddGraphNode(Graph, Expression);
 }
 
 IMPLEMENT_SIMPLE_MATERIAL_NODE(CreateWorldPositionNode, UMaterialExpressionWorldPosition)
@@ -680,19 +561,7 @@ UEdGraphNode* FMaterialNodeFactory::CreateCommentNode(UEdGraph* Graph, const TSh
         }
     }
 
-    if (UMaterialGraph* MatGraph = Cast<UMaterialGraph>(Graph))
-    {
-        MatGraph->RebuildGraph();
-        for (UEdGraphNode* Node : MatGraph->Nodes)
-        {
-            if (UMaterialGraphNode* MatNode = Cast<UMaterialGraphNode>(Node))
-            {
-                if (MatNode->MaterialExpression == Expression) return MatNode;
-            }
-        }
-    }
-
-    return nullptr;
+    return AddGraphNode(Graph, Expression);
 }
 
 #undef IMPLEMENT_SIMPLE_MATERIAL_NODE
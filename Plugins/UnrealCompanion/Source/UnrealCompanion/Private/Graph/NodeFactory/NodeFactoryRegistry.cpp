@@ -1,9 +1,30 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Graph/NodeFactory/INodeFactory.h"
+#include "Graph/NodeFactory/K2NodeFactory.h"
+#include "Graph/NodeFactory/MaterialNodeFactory.h"
+#include "Graph/NodeFactory/AnimationNodeFactory.h"
+#include "Graph/NodeFactory/NiagaraNodeFactory.h"
 #include "Graph/GraphOperations.h"
 #include "EdGraph/EdGraph.h"
 
+void FNodeFactoryRegistry::RegisterBuiltInFactories()
+{
+    if (Factories.Num() > 0)
+    {
+        return;
+    }
+
+    check(IsInGameThread());
+
+    RegisterFactory(UnrealCompanionGraph::EGraphType::Blueprint, MakeShared<FK2NodeFactory>());
+    // Widget blueprints use K2 nodes too
+    RegisterFactory(UnrealCompanionGraph::EGraphType::Widget, MakeShared<FK2NodeFactory>());
+    RegisterFactory(UnrealCompanionGraph::EGraphType::Material, MakeShared<FMaterialNodeFactory>());
+    RegisterFactory(UnrealCompanionGraph::EGraphType::Animation, MakeShared<FAnimationNodeFactory>());
+    RegisterFactory(UnrealCompanionGraph::EGraphType::Niagara, MakeShared<FNiagaraNodeFactory>());
+}
+
 TSharedPtr<INodeFactory> FNodeFactoryRegistry::GetFactoryForGraph(UEdGraph* Graph) const
 {
     if (!Graph)
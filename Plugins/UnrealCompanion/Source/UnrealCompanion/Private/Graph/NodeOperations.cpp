@@ -22,6 +22,12 @@ DEFINE_LOG_CATEGORY_STATIC(LogUnrealCompanionNode, Log, All);
 namespace UnrealCompanionNode
 {
 
+namespace
+{
+    /** Innermost live FScopedGraphIndex (game thread only) */
+    FScopedGraphIndex* GActiveGraphIndex = nullptr;
+}
+
 // =========================================================================
 // FIND OPERATIONS
 // =========================================================================
@@ -33,6 +39,11 @@ UEdGraphNode* FindByGuid(UEdGraph* Graph, const FGuid& Guid)
         return nullptr;
     }
 
+    if (FScopedGraphIndex* Index = FScopedGraphIndex::Find(Graph))
+    {
+        return Index->FindNode(Guid);
+    }
+
     for (UEdGraphNode* Node : Graph->Nodes)
     {
         if (Node && Node->NodeGuid == Guid)
@@ -162,6 +173,7 @@ bool Remove(UEdGraphNode* Node, FString& OutError)
     Node->Modify();
 
     // Remove from graph
+    FScopedGraphIndex::NotifyNodeRemoved(Node);
     Graph->RemoveNode(Node);
 
     UE_LOG(LogUnrealCompanionNode, Display, TEXT("Removed node %s"), *NodeGuidStr);
@@ -238,6 +250,7 @@ bool Reconstruct(UEdGraphNode* Node)
 
     Node->Modify();
     Node->ReconstructNode();
+    FScopedGraphIndex::NotifyPinsChanged(Node);
 
     UE_LOG(LogUnrealCompanionNode, Verbose, TEXT("Reconstructed node %s"), *Node->NodeGuid.ToString());
 
@@ -554,4 +567,204 @@ TSharedPtr<FJsonObject> BuildNodeInfo(UEdGraphNode* Node, UnrealCompanionGraph::
     return NodeJson;
 }
 
+TArray<TSharedPtr<FJsonValue>> BuildOutputLinks(UEdGraphNode* Node)
+{
+    TArray<TSharedPtr<FJsonValue>> Links;
+    if (!Node)
+    {
+        return Links;
+    }
+
+    for (UEdGraphPin* Pin : Node->Pins)
+    {
+        if (!Pin || Pin->Direction != EGPD_Output)
+        {
+            continue;
+        }
+        for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+        {
+            if (LinkedPin && LinkedPin->GetOwningNode())
+            {
+                TSharedPtr<FJsonObject> LinkJson = MakeShared<FJsonObject>();
+                LinkJson->SetStringField(TEXT("source_pin"), Pin->PinName.ToString());
+                LinkJson->SetStringField(TEXT("target_id"), LinkedPin->GetOwningNode()->NodeGuid.ToString());
+                LinkJson->SetStringField(TEXT("target_pin"), LinkedPin->PinName.ToString());
+                Links.Add(MakeShared<FJsonValueObject>(LinkJson));
+            }
+        }
+    }
+    return Links;
+}
+
+// =========================================================================
+// BATCH INDEX
+// =========================================================================
+
+FScopedGraphIndex::FScopedGraphIndex(UEdGraph* InGraph)
+    : Graph(InGraph)
+    , Outer(GActiveGraphIndex)
+{
+    check(IsInGameThread() && FUnrealCompanionScratch::IsActive());
+    GActiveGraphIndex = this;
+
+    if (Graph)
+    {
+        Nodes.Reserve(Graph->Nodes.Num());
+        for (UEdGraphNode* Node : Graph->Nodes)
+        {
+            // First node wins on a duplicate GUID, as with the linear scan
+            if (Node && Node->NodeGuid.IsValid() && !Nodes.Contains(Node->NodeGuid))
+            {
+                Nodes.Add(Node->NodeGuid, Node);
+            }
+        }
+    }
+}
+
+FScopedGraphIndex::~FScopedGraphIndex()
+{
+    check(GActiveGraphIndex == this);
+    GActiveGraphIndex = Outer;
+}
+
+FScopedGraphIndex* FScopedGraphIndex::Find(const UEdGraph* InGraph)
+{
+    for (FScopedGraphIndex* Index = GActiveGraphIndex; Index && InGraph; Index = Index->Outer)
+    {
+        if (Index->Graph == InGraph)
+        {
+            return Index;
+        }
+    }
+    return nullptr;
+}
+
+void FScopedGraphIndex::NotifyNodeAdded(UEdGraphNode* Node)
+{
+    if (!GActiveGraphIndex || !Node || !Node->NodeGuid.IsValid())
+    {
+        return;
+    }
+
+    const UEdGraph* NodeGraph = Node->GetGraph();
+    for (FScopedGraphIndex* Index = GActiveGraphIndex; Index; Index = Index->Outer)
+    {
+        if (Index->Graph == NodeGraph && !Index->Nodes.Contains(Node->NodeGuid))
+        {
+            Index->Nodes.Add(Node->NodeGuid, Node);
+        }
+    }
+}
+
+void FScopedGraphIndex::NotifyNodeRemoved(UEdGraphNode* Node)
+{
+    if (!GActiveGraphIndex || !Node)
+    {
+        return;
+    }
+
+    for (FScopedGraphIndex* Index = GActiveGraphIndex; Index; Index = Index->Outer)
+    {
+        UEdGraphNode** Indexed = Index->Nodes.Find(Node->NodeGuid);
+        if (Indexed && *Indexed == Node)
+        {
+            Index->Nodes.Remove(Node->NodeGuid);
+        }
+        Index->PinTables.Remove(Node);
+    }
+}
+
+void FScopedGraphIndex::NotifyPinsChanged(UEdGraphNode* Node)
+{
+    for (FScopedGraphIndex* Index = GActiveGraphIndex; Index; Index = Index->Outer)
+    {
+        Index->PinTables.Remove(Node);
+    }
+}
+
+UEdGraphNode* FScopedGraphIndex::FindNode(const FGuid& Guid)
+{
+    if (UEdGraphNode** Found = Nodes.Find(Guid))
+    {
+        if (IsValid(*Found))
+        {
+            return *Found;
+        }
+        Nodes.Remove(Guid);
+    }
+
+    // Nodes added by paths that don't notify (e.g. a factory spawning helper nodes)
+    // are picked up here once, then answered from the map
+    for (UEdGraphNode* Node : Graph->Nodes)
+    {
+        if (Node && Node->NodeGuid == Guid)
+        {
+            Nodes.Add(Guid, Node);
+            return Node;
+        }
+    }
+    return nullptr;
+}
+
+UEdGraphPin* FScopedGraphIndex::FindPin(UEdGraphNode* Node, const FString& PinName, EEdGraphPinDirection Direction)
+{
+    if (const auto* Candidates = GetPinTable(Node).ByName.Find(PinName))
+    {
+        for (UEdGraphPin* Pin : *Candidates)
+        {
+            if (Direction == EGPD_MAX || Pin->Direction == Direction)
+            {
+                return Pin;
+            }
+        }
+    }
+    return nullptr;
+}
+
+const FScopedGraphIndex::FPinTable& FScopedGraphIndex::GetPinTable(UEdGraphNode* Node)
+{
+    FPinTable* Existing = PinTables.Find(Node);
+    if (Existing && Existing->PinCount == Node->Pins.Num())
+    {
+        return *Existing;
+    }
+
+    FPinTable& Table = PinTables.Add(Node);
+    Table.PinCount = Node->Pins.Num();
+
+    // Appending pass by pass keeps each candidate list in FindPin's priority order
+    for (UEdGraphPin* Pin : Node->Pins)
+    {
+        if (Pin && !Pin->bHidden)
+        {
+            Table.ByName.FindOrAdd(Pin->PinName.ToString()).Add(Pin);
+        }
+    }
+    for (UEdGraphPin* Pin : Node->Pins)
+    {
+        if (Pin && !Pin->bHidden && !Pin->PinFriendlyName.IsEmpty())
+        {
+            Table.ByName.FindOrAdd(Pin->PinFriendlyName.ToString()).Add(Pin);
+        }
+    }
+    for (UEdGraphPin* Pin : Node->Pins)
+    {
+        if (!Pin || !Pin->bHidden)
+        {
+            continue;
+        }
+        const FString Name = Pin->PinName.ToString();
+        Table.ByName.FindOrAdd(Name).Add(Pin);
+        if (!Pin->PinFriendlyName.IsEmpty())
+        {
+            const FString FriendlyName = Pin->PinFriendlyName.ToString();
+            if (!FriendlyName.Equals(Name, ESearchCase::IgnoreCase))
+            {
+                Table.ByName.FindOrAdd(FriendlyName).Add(Pin);
+            }
+        }
+    }
+    return Table;
+}
+
 } // namespace UnrealCompanionNode
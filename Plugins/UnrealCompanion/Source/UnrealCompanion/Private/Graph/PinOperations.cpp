@@ -1,6 +1,8 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Graph/PinOperations.h"
+#include "Graph/GraphOperations.h"
+#include "Graph/NodeOperations.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
 #include "EdGraph/EdGraphPin.h"
@@ -24,6 +26,11 @@ UEdGraphPin* FindPin(UEdGraphNode* Node, const FString& PinName, EEdGraphPinDire
         return nullptr;
     }
 
+    if (UnrealCompanionNode::FScopedGraphIndex* Index = UnrealCompanionNode::FScopedGraphIndex::Find(Node->GetGraph()))
+    {
+        return Index->FindPin(Node, PinName, Direction);
+    }
+
     // PASS 1: Exact PinName match (highest priority)
     // This ensures we find the actual "Target" pin before a "self" pin with FriendlyName="Target"
     for (UEdGraphPin* Pin : Node->Pins)
@@ -166,8 +173,11 @@ bool Connect(UEdGraphPin* SourcePin, UEdGraphPin* TargetPin, FString& OutError)
         return false;
     }
 
-    // Make the connection
-    bool bSuccess = Schema->TryCreateConnection(SourcePin, TargetPin);
+    // Make the connection. Inside a material edit batch, skip the Material schema's
+    // per-link editor refresh (and preview recompile); the batch does it once on close
+    bool bSuccess = UnrealCompanionGraph::FScopedMaterialEditBatch::DeferGraphChanged(Graph)
+        ? Schema->UEdGraphSchema::TryCreateConnection(SourcePin, TargetPin)
+        : Schema->TryCreateConnection(SourcePin, TargetPin);
     if (!bSuccess)
     {
         OutError = TEXT("Failed to create connection");
@@ -301,7 +311,9 @@ bool SplitStructPin(UEdGraphPin* Pin, FString& OutError)
         return false;
     }
 
+    UEdGraphNode* OwningNode = Pin->GetOwningNode();
     K2Schema->SplitPin(Pin, true);
+    UnrealCompanionNode::FScopedGraphIndex::NotifyPinsChanged(OwningNode);
     
     UE_LOG(LogUnrealCompanionPin, Display, TEXT("Split struct pin '%s'"), *Pin->PinName.ToString());
     return true;
@@ -341,7 +353,9 @@ bool RecombineStructPin(UEdGraphPin* Pin, FString& OutError)
         return false;
     }
 
+    UEdGraphNode* OwningNode = Pin->GetOwningNode();
     K2Schema->RecombinePin(Pin);
+    UnrealCompanionNode::FScopedGraphIndex::NotifyPinsChanged(OwningNode);
     
     UE_LOG(LogUnrealCompanionPin, Display, TEXT("Recombined struct pin '%s'"), *Pin->PinName.ToString());
     return true;
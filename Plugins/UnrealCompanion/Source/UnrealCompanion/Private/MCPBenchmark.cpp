@@ -0,0 +1,305 @@
+#include "MCPBenchmark.h"
+#include "UnrealCompanionBridge.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    static const int32 DefaultIterations = 10;
+
+    bool ParseRequest(const TSharedPtr<FJsonObject>& Entry, FString& OutType, TSharedPtr<FJsonObject>& OutParams, FString& OutError)
+    {
+        if (!Entry.IsValid() || !Entry->TryGetStringField(TEXT("type"), OutType) || OutType.IsEmpty())
+        {
+            OutError = TEXT("Every mix and setup entry needs a 'type'");
+            return false;
+        }
+        if (OutType == TEXT("bridge_benchmark"))
+        {
+            OutError = TEXT("bridge_benchmark cannot benchmark itself");
+            return false;
+        }
+
+        const TSharedPtr<FJsonObject>* ParamsObject = nullptr;
+        OutParams = Entry->TryGetObjectField(TEXT("params"), ParamsObject) && ParamsObject ? *ParamsObject : MakeShared<FJsonObject>();
+        return true;
+    }
+}
+
+TSharedPtr<FMCPBenchmark> FMCPBenchmark::Create(UUnrealCompanionBridge* InBridge, const TSharedPtr<FJsonObject>& Params, FString& OutError)
+{
+    TSharedPtr<FMCPBenchmark> Run = MakeShareable(new FMCPBenchmark(InBridge));
+
+    const TArray<TSharedPtr<FJsonValue>>* MixArray = nullptr;
+    if (!Params.IsValid() || !Params->TryGetArrayField(TEXT("mix"), MixArray) || !MixArray || MixArray->Num() == 0)
+    {
+        OutError = TEXT("Missing 'mix': a list of {family, type, params, iterations}");
+        return nullptr;
+    }
+
+    int32 RequestsPerLevel = 0;
+    for (const TSharedPtr<FJsonValue>& Value : *MixArray)
+    {
+        const TSharedPtr<FJsonObject> Entry = Value.IsValid() ? Value->AsObject() : nullptr;
+        FFamily& Family = Run->Families.AddDefaulted_GetRef();
+        if (!ParseRequest(Entry, Family.Request.Type, Family.Request.Params, OutError))
+        {
+            return nullptr;
+        }
+        if (!Entry->TryGetStringField(TEXT("family"), Family.Name) || Family.Name.IsEmpty())
+        {
+            Family.Name = Family.Request.Type;
+        }
+
+        Family.Iterations = DefaultIterations;
+        Entry->TryGetNumberField(TEXT("iterations"), Family.Iterations);
+        if (Family.Iterations < 1)
+        {
+            OutError = FString::Printf(TEXT("Family '%s': iterations must be at least 1"), *Family.Name);
+            return nullptr;
+        }
+        RequestsPerLevel += Family.Iterations;
+        if (RequestsPerLevel > MaxRequestsPerLevel)
+        {
+            OutError = FString::Printf(TEXT("Mix exceeds %d requests per concurrency level"), MaxRequestsPerLevel);
+            return nullptr;
+        }
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* SetupArray = nullptr;
+    if (Params->TryGetArrayField(TEXT("setup"), SetupArray) && SetupArray)
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *SetupArray)
+        {
+            FRequest& Request = Run->Setup.AddDefaulted_GetRef();
+            if (!ParseRequest(Value.IsValid() ? Value->AsObject() : nullptr, Request.Type, Request.Params, OutError))
+            {
+                return nullptr;
+            }
+        }
+    }
+
+    // "concurrency" is a number or a list of numbers
+    const TArray<TSharedPtr<FJsonValue>>* ConcurrencyArray = nullptr;
+    int32 SingleConcurrency = 1;
+    if (Params->TryGetArrayField(TEXT("concurrency"), ConcurrencyArray) && ConcurrencyArray)
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *ConcurrencyArray)
+        {
+            Run->ConcurrencyLevels.Add((int32)Value->AsNumber());
+        }
+    }
+    else
+    {
+        Params->TryGetNumberField(TEXT("concurrency"), SingleConcurrency);
+        Run->ConcurrencyLevels.Add(SingleConcurrency);
+    }
+    for (int32 Concurrency : Run->ConcurrencyLevels)
+    {
+        if (Concurrency < 1 || Concurrency > MaxConcurrency)
+        {
+            OutError = FString::Printf(TEXT("Concurrency must be between 1 and %d (got %d)"), MaxConcurrency, Concurrency);
+            return nullptr;
+        }
+    }
+    if (Run->ConcurrencyLevels.Num() == 0)
+    {
+        OutError = TEXT("'concurrency' must not be empty");
+        return nullptr;
+    }
+
+    // Interleave families so every level sees the same mix, not one family at a time
+    TArray<int32> Remaining;
+    for (const FFamily& Family : Run->Families)
+    {
+        Remaining.Add(Family.Iterations);
+    }
+    Run->Schedule.Reserve(RequestsPerLevel);
+    while (Run->Schedule.Num() < RequestsPerLevel)
+    {
+        for (int32 FamilyIndex = 0; FamilyIndex < Remaining.Num(); ++FamilyIndex)
+        {
+            if (Remaining[FamilyIndex] > 0)
+            {
+                --Remaining[FamilyIndex];
+                Run->Schedule.Add(FamilyIndex);
+            }
+        }
+    }
+    return Run;
+}
+
+void FMCPBenchmark::Start(FOnFinished InOnFinished)
+{
+    OnFinished = MoveTemp(InOnFinished);
+    StartLevel();
+}
+
+void FMCPBenchmark::StartLevel()
+{
+    bool bDone = false;
+    {
+        FScopeLock ScopeLock(&Lock);
+        ++LevelIndex;
+        bDone = LevelIndex >= ConcurrencyLevels.Num();
+    }
+
+    if (bDone)
+    {
+        Finish();
+        return;
+    }
+    RunSetup(0);
+}
+
+void FMCPBenchmark::RunSetup(int32 SetupIndex)
+{
+    if (SetupIndex < Setup.Num())
+    {
+        TSharedRef<FMCPBenchmark> Self = AsShared();
+        Bridge->EnqueueCommand(Setup[SetupIndex].Type, Setup[SetupIndex].Params, nullptr, [Self, SetupIndex](const FMCPResponse&)
+        {
+            // Setup only resets the fixture; a failure shows up in the measured requests
+            Self->RunSetup(SetupIndex + 1);
+        });
+        return;
+    }
+
+    {
+        FScopeLock ScopeLock(&Lock);
+        NextScheduled = 0;
+        InFlight = 0;
+        Completed = 0;
+        Results.Reset();
+        Results.SetNum(Families.Num());
+        LevelStartTime = FPlatformTime::Seconds();
+    }
+    Pump();
+}
+
+void FMCPBenchmark::Pump()
+{
+    // A request can complete synchronously inside EnqueueCommand (e.g. BRIDGE_BUSY), which pumps again.
+    // Only the outermost call loops, so that never turns into unbounded recursion.
+    if (PumpRequests.fetch_add(1) != 0)
+    {
+        return;
+    }
+
+    do
+    {
+        int32 FamilyIndex = INDEX_NONE;
+        {
+            FScopeLock ScopeLock(&Lock);
+            if (ConcurrencyLevels.IsValidIndex(LevelIndex) && InFlight < ConcurrencyLevels[LevelIndex] && NextScheduled < Schedule.Num())
+            {
+                FamilyIndex = Schedule[NextScheduled++];
+                ++InFlight;
+            }
+        }
+
+        if (FamilyIndex == INDEX_NONE)
+        {
+            continue;
+        }
+
+        // Submit outside the lock: completion may run on this thread before EnqueueCommand returns
+        const FRequest& Request = Families[FamilyIndex].Request;
+        const double StartTime = FPlatformTime::Seconds();
+        TSharedRef<FMCPBenchmark> Self = AsShared();
+        Bridge->EnqueueCommand(Request.Type, Request.Params, nullptr, [Self, FamilyIndex, StartTime](const FMCPResponse& Response)
+        {
+            Self->OnRequestComplete(FamilyIndex, StartTime, Response.bSuccess);
+        });
+
+        // Try for another slot before giving up this round
+        PumpRequests.fetch_add(1);
+    }
+    while (PumpRequests.fetch_sub(1) != 1);
+}
+
+void FMCPBenchmark::OnRequestComplete(int32 FamilyIndex, double StartTime, bool bSuccess)
+{
+    const double Seconds = FPlatformTime::Seconds() - StartTime;
+    bool bLevelDone = false;
+    {
+        FScopeLock ScopeLock(&Lock);
+        FFamilyResult& Result = Results[FamilyIndex];
+        Result.Latency.Record(Seconds);
+        if (!bSuccess)
+        {
+            ++Result.Errors;
+        }
+        --InFlight;
+        ++Completed;
+        bLevelDone = Completed == Schedule.Num();
+    }
+
+    if (bLevelDone)
+    {
+        FinishLevel();
+        StartLevel();
+    }
+    else
+    {
+        Pump();
+    }
+}
+
+void FMCPBenchmark::FinishLevel()
+{
+    FScopeLock ScopeLock(&Lock);
+    const double WallSeconds = FMath::Max(FPlatformTime::Seconds() - LevelStartTime, 1e-9);
+
+    uint64 TotalErrors = 0;
+    TSharedPtr<FJsonObject> FamiliesJson = MakeShared<FJsonObject>();
+    for (int32 FamilyIndex = 0; FamilyIndex < Families.Num(); ++FamilyIndex)
+    {
+        const FFamilyResult& Result = Results[FamilyIndex];
+        const FMCPLatencyHistogram& Latency = Result.Latency;
+        TotalErrors += Result.Errors;
+
+        TSharedPtr<FJsonObject> FamilyJson = MakeShared<FJsonObject>();
+        FamilyJson->SetStringField(TEXT("type"), Families[FamilyIndex].Request.Type);
+        FamilyJson->SetNumberField(TEXT("count"), (double)Latency.Count);
+        FamilyJson->SetNumberField(TEXT("errors"), (double)Result.Errors);
+        FamilyJson->SetNumberField(TEXT("throughput_rps"), Latency.Count / WallSeconds);
+        FamilyJson->SetNumberField(TEXT("mean_ms"), Latency.Count > 0 ? Latency.SumSeconds * 1000.0 / Latency.Count : 0.0);
+        FamilyJson->SetNumberField(TEXT("p50_ms"), Latency.GetQuantileMs(0.5));
+        FamilyJson->SetNumberField(TEXT("p95_ms"), Latency.GetQuantileMs(0.95));
+        FamilyJson->SetNumberField(TEXT("p99_ms"), Latency.GetQuantileMs(0.99));
+        FamilyJson->SetNumberField(TEXT("max_ms"), Latency.MaxSeconds * 1000.0);
+        FamiliesJson->SetObjectField(Families[FamilyIndex].Name, FamilyJson);
+    }
+
+    TSharedPtr<FJsonObject> LevelJson = MakeShared<FJsonObject>();
+    LevelJson->SetNumberField(TEXT("concurrency"), ConcurrencyLevels[LevelIndex]);
+    LevelJson->SetNumberField(TEXT("requests"), Schedule.Num());
+    LevelJson->SetNumberField(TEXT("errors"), (double)TotalErrors);
+    LevelJson->SetNumberField(TEXT("wall_seconds"), WallSeconds);
+    LevelJson->SetNumberField(TEXT("throughput_rps"), Schedule.Num() / WallSeconds);
+    LevelJson->SetObjectField(TEXT("families"), FamiliesJson);
+    LevelReports.Add(MakeShared<FJsonValueObject>(LevelJson));
+}
+
+void FMCPBenchmark::Finish()
+{
+    TSharedPtr<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetBoolField(TEXT("success"), true);
+    Report->SetStringField(TEXT("mode"), TEXT("in_process"));
+    Report->SetStringField(TEXT("engine_version"), FEngineVersion::Current().ToString());
+    if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UnrealCompanion")))
+    {
+        Report->SetStringField(TEXT("plugin_version"), Plugin->GetDescriptor().VersionName);
+    }
+    Report->SetArrayField(TEXT("levels"), LevelReports);
+
+    if (OnFinished)
+    {
+        FOnFinished Callback = MoveTemp(OnFinished);
+        Callback(Report);
+    }
+}
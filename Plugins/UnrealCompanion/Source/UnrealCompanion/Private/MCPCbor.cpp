@@ -0,0 +1,744 @@
+#include "MCPCbor.h"
+#include "MCPResponseWriter.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Math/Float16.h"
+#include "Misc/Base64.h"
+
+namespace
+{
+    // Major types (RFC 8949 section 3.1)
+    enum : uint8
+    {
+        MajorUnsigned = 0,
+        MajorNegative = 1,
+        MajorBytes = 2,
+        MajorText = 3,
+        MajorArray = 4,
+        MajorMap = 5,
+        MajorTag = 6,
+        MajorSimple = 7
+    };
+
+    // Additional-information value for indefinite lengths (and the "break" stop code in major 7)
+    static constexpr uint8 InfoIndefinite = 31;
+    static constexpr uint8 BreakCode = 0xFF;
+
+    // RFC 8746 typed arrays, RFC 8949 embedded JSON
+    enum : uint64
+    {
+        TagUint8 = 64,
+        TagUint16LE = 69,
+        TagUint32LE = 70,
+        TagSint8 = 72,
+        TagSint16LE = 77,
+        TagSint32LE = 78,
+        TagSint64LE = 79,
+        TagFloat32LE = 85,
+        TagFloat64LE = 86,
+        TagEmbeddedJson = 262
+    };
+
+    // =========================================================================
+    // ENCODING
+    // =========================================================================
+
+    void AppendBigEndian(TArray<uint8>& Buffer, uint64 Value, int32 Bytes)
+    {
+        for (int32 Shift = (Bytes - 1) * 8; Shift >= 0; Shift -= 8)
+        {
+            Buffer.Add((uint8)(Value >> Shift));
+        }
+    }
+
+    void AppendLittleEndian(TArray<uint8>& Buffer, uint64 Value, int32 Bytes)
+    {
+        for (int32 Index = 0; Index < Bytes; ++Index)
+        {
+            Buffer.Add((uint8)(Value >> (Index * 8)));
+        }
+    }
+
+    void WriteHead(TArray<uint8>& Buffer, uint8 Major, uint64 Argument)
+    {
+        const uint8 Prefix = (uint8)(Major << 5);
+        if (Argument < 24)
+        {
+            Buffer.Add(Prefix | (uint8)Argument);
+        }
+        else if (Argument <= 0xFF)
+        {
+            Buffer.Add(Prefix | 24);
+            Buffer.Add((uint8)Argument);
+        }
+        else if (Argument <= 0xFFFF)
+        {
+            Buffer.Add(Prefix | 25);
+            AppendBigEndian(Buffer, Argument, 2);
+        }
+        else if (Argument <= 0xFFFFFFFFull)
+        {
+            Buffer.Add(Prefix | 26);
+            AppendBigEndian(Buffer, Argument, 4);
+        }
+        else
+        {
+            Buffer.Add(Prefix | 27);
+            AppendBigEndian(Buffer, Argument, 8);
+        }
+    }
+
+    bool IsInt32(double Value)
+    {
+        return Value == FMath::FloorToDouble(Value) && Value >= (double)MIN_int32 && Value <= (double)MAX_int32;
+    }
+
+    /** Walks a JSON DOM and emits CBOR; mirrors FMCPResponseWriter::WriteValue */
+    class FCborEncoder
+    {
+    public:
+        explicit FCborEncoder(TArray<uint8>& InBuffer) : Buffer(InBuffer) {}
+
+        void WriteText(FStringView Text)
+        {
+            const int32 Utf8Len = Text.Len() > 0 ? FPlatformString::ConvertedLength<UTF8CHAR>(Text.GetData(), Text.Len()) : 0;
+            WriteHead(Buffer, MajorText, (uint64)Utf8Len);
+            if (Utf8Len > 0)
+            {
+                const int32 Offset = Buffer.AddUninitialized(Utf8Len);
+                FPlatformString::Convert(reinterpret_cast<UTF8CHAR*>(Buffer.GetData() + Offset), Utf8Len, Text.GetData(), Text.Len());
+            }
+        }
+
+        void WriteNumber(double Value)
+        {
+            // Integral values use the compact integer forms, like JSON prints them without a fraction
+            if (FMath::IsFinite(Value) && Value == FMath::FloorToDouble(Value) && FMath::Abs(Value) <= 9007199254740992.0)
+            {
+                if (Value >= 0.0)
+                {
+                    WriteHead(Buffer, MajorUnsigned, (uint64)Value);
+                }
+                else
+                {
+                    WriteHead(Buffer, MajorNegative, (uint64)(-1.0 - Value));
+                }
+                return;
+            }
+
+            uint64 Bits = 0;
+            FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+            Buffer.Add((uint8)((MajorSimple << 5) | 27));
+            AppendBigEndian(Buffer, Bits, 8);
+        }
+
+        void WriteBool(bool bValue)
+        {
+            Buffer.Add(bValue ? 0xF5 : 0xF4);
+        }
+
+        void WriteNull()
+        {
+            Buffer.Add(0xF6);
+        }
+
+        void WriteValue(const TSharedPtr<FJsonValue>& Value)
+        {
+            if (!Value.IsValid())
+            {
+                WriteNull();
+                return;
+            }
+
+            switch (Value->Type)
+            {
+                case EJson::String:
+                    Value->TryGetString(Scratch);
+                    WriteText(Scratch);
+                    break;
+                case EJson::Number:
+                {
+                    double Number = 0.0;
+                    Value->TryGetNumber(Number);
+                    WriteNumber(Number);
+                    break;
+                }
+                case EJson::Boolean:
+                {
+                    bool bValue = false;
+                    Value->TryGetBool(bValue);
+                    WriteBool(bValue);
+                    break;
+                }
+                case EJson::Array:
+                {
+                    const TArray<TSharedPtr<FJsonValue>>* Elements = nullptr;
+                    if (!Value->TryGetArray(Elements) || !Elements)
+                    {
+                        WriteHead(Buffer, MajorArray, 0);
+                    }
+                    else if (!TryWritePackedArray(*Elements))
+                    {
+                        WriteHead(Buffer, MajorArray, (uint64)Elements->Num());
+                        for (const TSharedPtr<FJsonValue>& Element : *Elements)
+                        {
+                            WriteValue(Element);
+                        }
+                    }
+                    break;
+                }
+                case EJson::Object:
+                {
+                    const TSharedPtr<FJsonObject>* Object = nullptr;
+                    if (Value->TryGetObject(Object) && Object && Object->IsValid())
+                    {
+                        WriteObject(**Object);
+                    }
+                    else
+                    {
+                        WriteNull();
+                    }
+                    break;
+                }
+                case EJson::None:
+                {
+                    // FMCPJsonValueRaw: keep the handler's JSON as-is rather than re-encoding it
+                    const TArray<uint8>& Utf8 = static_cast<const FMCPJsonValueRaw&>(*Value).GetUtf8();
+                    if (Utf8.Num() == 0)
+                    {
+                        WriteNull();
+                        break;
+                    }
+                    WriteHead(Buffer, MajorTag, TagEmbeddedJson);
+                    WriteHead(Buffer, MajorBytes, (uint64)Utf8.Num());
+                    Buffer.Append(Utf8);
+                    break;
+                }
+                case EJson::Null:
+                default:
+                    WriteNull();
+                    break;
+            }
+        }
+
+        void WriteObject(const FJsonObject& Object)
+        {
+            WriteHead(Buffer, MajorMap, (uint64)Object.Values.Num());
+            for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object.Values)
+            {
+                WriteText(Field.Key);
+                WriteValue(Field.Value);
+            }
+        }
+
+    private:
+        /** All-number arrays become one typed-array byte string: int32 when exact, float64 otherwise */
+        bool TryWritePackedArray(const TArray<TSharedPtr<FJsonValue>>& Elements)
+        {
+            if (Elements.Num() < MCPCbor::PackedArrayMinLength)
+            {
+                return false;
+            }
+
+            bool bAllInt32 = true;
+            for (const TSharedPtr<FJsonValue>& Element : Elements)
+            {
+                double Number = 0.0;
+                if (!Element.IsValid() || Element->Type != EJson::Number || !Element->TryGetNumber(Number))
+                {
+                    return false;
+                }
+                bAllInt32 = bAllInt32 && IsInt32(Number);
+            }
+
+            const int32 ElementSize = bAllInt32 ? 4 : 8;
+            WriteHead(Buffer, MajorTag, bAllInt32 ? TagSint32LE : TagFloat64LE);
+            WriteHead(Buffer, MajorBytes, (uint64)Elements.Num() * ElementSize);
+            Buffer.Reserve(Buffer.Num() + Elements.Num() * ElementSize);
+            for (const TSharedPtr<FJsonValue>& Element : Elements)
+            {
+                double Number = 0.0;
+                Element->TryGetNumber(Number);
+                if (bAllInt32)
+                {
+                    AppendLittleEndian(Buffer, (uint32)(int32)Number, 4);
+                }
+                else
+                {
+                    uint64 Bits = 0;
+                    FMemory::Memcpy(&Bits, &Number, sizeof(Bits));
+                    AppendLittleEndian(Buffer, Bits, 8);
+                }
+            }
+            return true;
+        }
+
+        TArray<uint8>& Buffer;
+        FString Scratch;
+    };
+
+    // =========================================================================
+    // DECODING
+    // =========================================================================
+
+    class FCborDecoder
+    {
+    public:
+        FCborDecoder(const uint8* InData, int32 InNum) : Data(InData), Num(InNum) {}
+
+        bool AtEnd() const { return Offset == Num; }
+        const FString& GetError() const { return Error; }
+
+        bool ReadValue(TSharedPtr<FJsonValue>& OutValue, int32 Depth)
+        {
+            if (Depth > MCPCbor::MaxDepth)
+            {
+                return Fail(TEXT("nesting too deep"));
+            }
+
+            uint8 Major = 0;
+            uint8 Info = 0;
+            uint64 Argument = 0;
+            if (!ReadHead(Major, Info, Argument))
+            {
+                return false;
+            }
+
+            switch (Major)
+            {
+                case MajorUnsigned:
+                    OutValue = MakeShared<FJsonValueNumber>((double)Argument);
+                    return true;
+                case MajorNegative:
+                    OutValue = MakeShared<FJsonValueNumber>(-1.0 - (double)Argument);
+                    return true;
+                case MajorBytes:
+                {
+                    // Untagged binary has no JSON equivalent: hand it to handlers as base64, like other binary params
+                    TArray<uint8> Bytes;
+                    if (!ReadString(MajorBytes, Info, Argument, Bytes))
+                    {
+                        return false;
+                    }
+                    OutValue = MakeShared<FJsonValueString>(FBase64::Encode(Bytes));
+                    return true;
+                }
+                case MajorText:
+                {
+                    TArray<uint8> Bytes;
+                    if (!ReadString(MajorText, Info, Argument, Bytes))
+                    {
+                        return false;
+                    }
+                    OutValue = MakeShared<FJsonValueString>(Utf8ToString(Bytes));
+                    return true;
+                }
+                case MajorArray:
+                    return ReadArray(Info, Argument, OutValue, Depth);
+                case MajorMap:
+                {
+                    TSharedPtr<FJsonObject> Object;
+                    if (!ReadMap(Info, Argument, Object, Depth))
+                    {
+                        return false;
+                    }
+                    OutValue = MakeShared<FJsonValueObject>(Object);
+                    return true;
+                }
+                case MajorTag:
+                    return ReadTagged(Argument, OutValue, Depth);
+                default:
+                    return ReadSimple(Info, Argument, OutValue);
+            }
+        }
+
+        bool ReadMap(uint8 Info, uint64 Argument, TSharedPtr<FJsonObject>& OutObject, int32 Depth)
+        {
+            OutObject = MakeShared<FJsonObject>();
+            const bool bIndefinite = Info == InfoIndefinite;
+            for (uint64 Index = 0; bIndefinite || Index < Argument; ++Index)
+            {
+                if (bIndefinite && ConsumeBreak())
+                {
+                    break;
+                }
+
+                TSharedPtr<FJsonValue> Key;
+                if (!ReadValue(Key, Depth + 1))
+                {
+                    return false;
+                }
+                FString KeyString;
+                if (!Key.IsValid() || (Key->Type != EJson::String && Key->Type != EJson::Number) || !Key->TryGetString(KeyString))
+                {
+                    return Fail(TEXT("map keys must be text"));
+                }
+
+                TSharedPtr<FJsonValue> Value;
+                if (!ReadValue(Value, Depth + 1))
+                {
+                    return false;
+                }
+                OutObject->SetField(KeyString, Value);
+            }
+            return true;
+        }
+
+    private:
+        bool Fail(const TCHAR* Message)
+        {
+            if (Error.IsEmpty())
+            {
+                Error = FString::Printf(TEXT("Invalid CBOR at byte %d: %s"), Offset, Message);
+            }
+            return false;
+        }
+
+        static FString Utf8ToString(const TArray<uint8>& Bytes)
+        {
+            FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+            return FString(Converted.Length(), Converted.Get());
+        }
+
+        bool ReadHead(uint8& OutMajor, uint8& OutInfo, uint64& OutArgument)
+        {
+            if (Offset >= Num)
+            {
+                return Fail(TEXT("unexpected end of data"));
+            }
+            const uint8 Initial = Data[Offset++];
+            OutMajor = Initial >> 5;
+            OutInfo = Initial & 0x1F;
+
+            if (OutInfo < 24)
+            {
+                OutArgument = OutInfo;
+                return true;
+            }
+            if (OutInfo == InfoIndefinite)
+            {
+                if (OutMajor == MajorUnsigned || OutMajor == MajorNegative || OutMajor == MajorTag)
+                {
+                    return Fail(TEXT("indefinite length not allowed here"));
+                }
+                OutArgument = 0;
+                return true;
+            }
+            if (OutInfo > 27)
+            {
+                return Fail(TEXT("reserved additional information"));
+            }
+
+            const int32 Bytes = 1 << (OutInfo - 24);
+            if (Num - Offset < Bytes)
+            {
+                return Fail(TEXT("unexpected end of data"));
+            }
+            OutArgument = 0;
+            for (int32 Index = 0; Index < Bytes; ++Index)
+            {
+                OutArgument = (OutArgument << 8) | Data[Offset++];
+            }
+            return true;
+        }
+
+        bool ConsumeBreak()
+        {
+            if (Offset < Num && Data[Offset] == BreakCode)
+            {
+                ++Offset;
+                return true;
+            }
+            return false;
+        }
+
+        /** Byte or text string, definite or chunked */
+        bool ReadString(uint8 Major, uint8 Info, uint64 Argument, TArray<uint8>& OutBytes)
+        {
+            if (Info != InfoIndefinite)
+            {
+                if (Argument > (uint64)(Num - Offset))
+                {
+                    return Fail(TEXT("string runs past the end of data"));
+                }
+                OutBytes.Append(Data + Offset, (int32)Argument);
+                Offset += (int32)Argument;
+                return true;
+            }
+
+            while (!ConsumeBreak())
+            {
+                uint8 ChunkMajor = 0;
+                uint8 ChunkInfo = 0;
+                uint64 ChunkLength = 0;
+                if (!ReadHead(ChunkMajor, ChunkInfo, ChunkLength))
+                {
+                    return false;
+                }
+                if (ChunkMajor != Major || ChunkInfo == InfoIndefinite)
+                {
+                    return Fail(TEXT("bad chunk in indefinite-length string"));
+                }
+                if (!ReadString(Major, ChunkInfo, ChunkLength, OutBytes))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool ReadArray(uint8 Info, uint64 Argument, TSharedPtr<FJsonValue>& OutValue, int32 Depth)
+        {
+            TArray<TSharedPtr<FJsonValue>> Elements;
+            const bool bIndefinite = Info == InfoIndefinite;
+            if (!bIndefinite)
+            {
+                // Every element takes at least one byte: never trust a length the payload cannot hold
+                if (Argument > (uint64)(Num - Offset))
+                {
+                    return Fail(TEXT("array runs past the end of data"));
+                }
+                Elements.Reserve((int32)Argument);
+            }
+
+            for (uint64 Index = 0; bIndefinite || Index < Argument; ++Index)
+            {
+                if (bIndefinite && ConsumeBreak())
+                {
+                    break;
+                }
+                TSharedPtr<FJsonValue> Element;
+                if (!ReadValue(Element, Depth + 1))
+                {
+                    return false;
+                }
+                Elements.Add(Element);
+            }
+            OutValue = MakeShared<FJsonValueArray>(Elements);
+            return true;
+        }
+
+        bool ReadTagged(uint64 Tag, TSharedPtr<FJsonValue>& OutValue, int32 Depth)
+        {
+            int32 ElementSize = 0;
+            switch (Tag)
+            {
+                case TagUint8: case TagSint8: ElementSize = 1; break;
+                case TagUint16LE: case TagSint16LE: ElementSize = 2; break;
+                case TagUint32LE: case TagSint32LE: case TagFloat32LE: ElementSize = 4; break;
+                case TagSint64LE: case TagFloat64LE: ElementSize = 8; break;
+                default: break;
+            }
+
+            if (ElementSize == 0 && Tag != TagEmbeddedJson)
+            {
+                // Unknown tags only annotate their content
+                return ReadValue(OutValue, Depth + 1);
+            }
+
+            uint8 Major = 0;
+            uint8 Info = 0;
+            uint64 Argument = 0;
+            if (!ReadHead(Major, Info, Argument))
+            {
+                return false;
+            }
+            if (Major != MajorBytes && !(Tag == TagEmbeddedJson && Major == MajorText))
+            {
+                return Fail(TEXT("typed array or embedded JSON tag must wrap a byte string"));
+            }
+            TArray<uint8> Bytes;
+            if (!ReadString(Major, Info, Argument, Bytes))
+            {
+                return false;
+            }
+
+            if (Tag == TagEmbeddedJson)
+            {
+                TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Utf8ToString(Bytes));
+                if (!FJsonSerializer::Deserialize(Reader, OutValue) || !OutValue.IsValid())
+                {
+                    return Fail(TEXT("embedded JSON does not parse"));
+                }
+                return true;
+            }
+
+            if (Bytes.Num() % ElementSize != 0)
+            {
+                return Fail(TEXT("typed array length is not a multiple of its element size"));
+            }
+
+            const int32 Count = Bytes.Num() / ElementSize;
+            TArray<TSharedPtr<FJsonValue>> Elements;
+            Elements.Reserve(Count);
+            for (int32 Index = 0; Index < Count; ++Index)
+            {
+                const uint8* Element = Bytes.GetData() + Index * ElementSize;
+                uint64 Raw = 0;
+                for (int32 Byte = ElementSize - 1; Byte >= 0; --Byte)
+                {
+                    Raw = (Raw << 8) | Element[Byte];
+                }
+
+                double Number = 0.0;
+                switch (Tag)
+                {
+                    case TagUint8: Number = (double)(uint8)Raw; break;
+                    case TagSint8: Number = (double)(int8)Raw; break;
+                    case TagUint16LE: Number = (double)(uint16)Raw; break;
+                    case TagSint16LE: Number = (double)(int16)Raw; break;
+                    case TagUint32LE: Number = (double)(uint32)Raw; break;
+                    case TagSint32LE: Number = (double)(int32)Raw; break;
+                    case TagSint64LE: Number = (double)(int64)Raw; break;
+                    case TagFloat32LE:
+                    {
+                        const uint32 Bits = (uint32)Raw;
+                        float Value = 0.0f;
+                        FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+                        Number = Value;
+                        break;
+                    }
+                    case TagFloat64LE:
+                        FMemory::Memcpy(&Number, &Raw, sizeof(Number));
+                        break;
+                    default:
+                        break;
+                }
+                Elements.Add(MakeShared<FJsonValueNumber>(Number));
+            }
+            OutValue = MakeShared<FJsonValueArray>(Elements);
+            return true;
+        }
+
+        bool ReadSimple(uint8 Info, uint64 Argument, TSharedPtr<FJsonValue>& OutValue)
+        {
+            switch (Info)
+            {
+                case 20: OutValue = MakeShared<FJsonValueBoolean>(false); return true;
+                case 21: OutValue = MakeShared<FJsonValueBoolean>(true); return true;
+                case 22:
+                case 23: OutValue = MakeShared<FJsonValueNull>(); return true;
+                case 25:
+                {
+                    FFloat16 Half;
+                    Half.Encoded = (uint16)Argument;
+                    OutValue = MakeShared<FJsonValueNumber>((double)Half.GetFloat());
+                    return true;
+                }
+                case 26:
+                {
+                    const uint32 Bits = (uint32)Argument;
+                    float Value = 0.0f;
+                    FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+                    OutValue = MakeShared<FJsonValueNumber>((double)Value);
+                    return true;
+                }
+                case 27:
+                {
+                    double Value = 0.0;
+                    FMemory::Memcpy(&Value, &Argument, sizeof(Value));
+                    OutValue = MakeShared<FJsonValueNumber>(Value);
+                    return true;
+                }
+                case InfoIndefinite:
+                    return Fail(TEXT("unexpected break"));
+                default:
+                    return Fail(TEXT("unsupported simple value"));
+            }
+        }
+
+        const uint8* Data;
+        int32 Num;
+        int32 Offset = 0;
+        FString Error;
+    };
+}
+
+bool MCPCbor::DecodeObject(const uint8* Data, int32 Num, TSharedPtr<FJsonObject>& OutObject, FString& OutError)
+{
+    FCborDecoder Decoder(Data, Num);
+    TSharedPtr<FJsonValue> Root;
+    if (!Decoder.ReadValue(Root, 0))
+    {
+        OutError = Decoder.GetError();
+        return false;
+    }
+
+    const TSharedPtr<FJsonObject>* Object = nullptr;
+    if (!Root.IsValid() || Root->Type != EJson::Object || !Root->TryGetObject(Object) || !Object)
+    {
+        OutError = TEXT("CBOR message must be a map");
+        return false;
+    }
+    if (!Decoder.AtEnd())
+    {
+        OutError = TEXT("Trailing bytes after CBOR message");
+        return false;
+    }
+
+    OutObject = *Object;
+    return true;
+}
+
+void MCPCbor::EncodeValue(const TSharedPtr<FJsonValue>& Value, TArray<uint8>& Buffer)
+{
+    FCborEncoder Encoder(Buffer);
+    Encoder.WriteValue(Value);
+}
+
+void MCPCbor::EncodeResponse(const FMCPResponse& Response, TArray<uint8>& Buffer)
+{
+    FCborEncoder Encoder(Buffer);
+
+    // Same fields, in the same order, as FMCPResponse::Write
+    const bool bEvent = !Response.Event.IsEmpty();
+    int32 FieldCount = bEvent ? 3 : 2;
+    if (!bEvent && !Response.bSuccess)
+    {
+        FieldCount += Response.ErrorCode.IsEmpty() ? 0 : 1;
+        FieldCount += Response.QueueDepth >= 0 ? 1 : 0;
+    }
+    FieldCount += Response.RequestId.IsValid() ? 1 : 0;
+    WriteHead(Buffer, MajorMap, (uint64)FieldCount);
+
+    Encoder.WriteText(TEXT("status"));
+    Encoder.WriteText(bEvent ? TEXT("event") : (Response.bSuccess ? TEXT("success") : TEXT("error")));
+    if (bEvent)
+    {
+        Encoder.WriteText(TEXT("event"));
+        Encoder.WriteText(Response.Event);
+    }
+    if (bEvent || Response.bSuccess)
+    {
+        Encoder.WriteText(TEXT("result"));
+        if (Response.Result.IsValid())
+        {
+            Encoder.WriteObject(*Response.Result);
+        }
+        else
+        {
+            Encoder.WriteNull();
+        }
+    }
+    else
+    {
+        Encoder.WriteText(TEXT("error"));
+        Encoder.WriteText(Response.Error);
+        if (!Response.ErrorCode.IsEmpty())
+        {
+            Encoder.WriteText(TEXT("error_code"));
+            Encoder.WriteText(Response.ErrorCode);
+        }
+        if (Response.QueueDepth >= 0)
+        {
+            Encoder.WriteText(TEXT("queue_depth"));
+            Encoder.WriteNumber(Response.QueueDepth);
+        }
+    }
+    if (Response.RequestId.IsValid())
+    {
+        Encoder.WriteText(TEXT("id"));
+        Encoder.WriteValue(Response.RequestId);
+    }
+}
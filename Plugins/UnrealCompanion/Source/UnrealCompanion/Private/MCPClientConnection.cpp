@@ -0,0 +1,406 @@
+#include "MCPClientConnection.h"
+#include "MCPFraming.h"
+#include "MCPCbor.h"
+#include "MCPMetrics.h"
+#include "MCPTraceLog.h"
+#include "UnrealCompanionBridge.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformTime.h"
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonReader.h"
+
+// How long a worker blocks waiting for data before re-checking bRunning.
+// This is not on the latency path: Wait() returns as soon as bytes arrive.
+static const FTimespan ClientWaitTimeout = FTimespan::FromMilliseconds(250);
+
+// Bytes requested per Recv call; messages larger than this are reassembled by FMCPFrameReader
+static const int32 ReceiveChunkSize = 64 * 1024;
+
+FMCPClientConnection::FMCPClientConnection(UUnrealCompanionBridge* InBridge, FSocket* InSocket, int32 InConnectionId)
+    : Bridge(InBridge)
+    , Socket(InSocket)
+    , Thread(nullptr)
+    , ConnectionId(InConnectionId)
+    , bRunning(true)
+    , bFinished(false)
+    , bAcceptsCompression(false)
+{
+    // Set socket options to improve connection stability
+    Socket->SetNoDelay(true);
+    Socket->SetNonBlocking(true);
+    int32 SocketBufferSize = 65536;  // 64KB buffer
+    Socket->SetSendBufferSize(SocketBufferSize, SocketBufferSize);
+    Socket->SetReceiveBufferSize(SocketBufferSize, SocketBufferSize);
+}
+
+FMCPClientConnection::~FMCPClientConnection()
+{
+    if (Thread)
+    {
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    if (Socket)
+    {
+        Socket->Close();
+        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+        Socket = nullptr;
+    }
+}
+
+bool FMCPClientConnection::Start()
+{
+    Thread = FRunnableThread::Create(
+        this,
+        *FString::Printf(TEXT("UnrealCompanionClient_%d"), ConnectionId),
+        0, TPri_Normal
+    );
+    return Thread != nullptr;
+}
+
+void FMCPClientConnection::Stop()
+{
+    bRunning = false;
+}
+
+uint32 FMCPClientConnection::Run()
+{
+    UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Client connected"), ConnectionId);
+
+    // Scratch buffer for a single Recv; frames are reassembled in FrameReader
+    TArray<uint8> RecvBuffer;
+    RecvBuffer.SetNumUninitialized(ReceiveChunkSize);
+    FMCPFrameReader FrameReader;
+
+    while (bRunning)
+    {
+        // Block until the socket is readable (or the timeout elapses so we can observe Stop())
+        if (!Socket->Wait(ESocketWaitConditions::WaitForRead, ClientWaitTimeout))
+        {
+            if (Socket->GetConnectionState() != SCS_Connected)
+            {
+                UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Connection lost"), ConnectionId);
+                break;
+            }
+            continue;
+        }
+
+        // Drain everything the kernel has for us before parsing
+        bool bClosed = false;
+        while (true)
+        {
+            int32 BytesRead = 0;
+            if (!Socket->Recv(RecvBuffer.GetData(), RecvBuffer.Num(), BytesRead))
+            {
+                int32 LastError = (int32)ISocketSubsystem::Get()->GetLastErrorCode();
+                if (LastError != SE_EWOULDBLOCK && LastError != SE_EINTR)
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection[%d]: Client disconnected or error. Last error code: %d"), ConnectionId, LastError);
+                    bClosed = true;
+                }
+                break;
+            }
+            if (BytesRead == 0)
+            {
+                UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Client disconnected (zero bytes)"), ConnectionId);
+                bClosed = true;
+                break;
+            }
+            FrameReader.Append(RecvBuffer.GetData(), BytesRead);
+            if (BytesRead < RecvBuffer.Num())
+            {
+                break;
+            }
+        }
+
+        FMCPFrame Frame;
+        while (FrameReader.TryPopFrame(Frame))
+        {
+            if (!ProcessFrame(Frame))
+            {
+                bClosed = true;
+                break;
+            }
+        }
+
+        if (FrameReader.HasError())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection[%d]: Protocol error, closing connection: %s"), ConnectionId, *FrameReader.GetError());
+            FMCPTraceLog::Get().DumpToLog(20);
+            break;
+        }
+
+        if (bClosed)
+        {
+            break;
+        }
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Worker stopping"), ConnectionId);
+    bFinished = true;
+    return 0;
+}
+
+bool FMCPClientConnection::ProcessFrame(const FMCPFrame& Frame)
+{
+    // Replies use the request's encoding; anything we cannot decode is answered in JSON
+    const uint8 Encoding = MCPFraming::GetPayloadEncoding(Frame.Flags);
+    if (Encoding != MCPFraming::PayloadJson && Encoding != MCPFraming::PayloadCbor)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection[%d]: Unsupported payload encoding 0x%02X"), ConnectionId, Encoding);
+        return SendResponse(FMCPResponse::MakeError(FString::Printf(TEXT("Unsupported payload encoding 0x%02X"), Encoding)),
+            Frame.Framing, MCPFraming::PayloadJson);
+    }
+    const uint8 ResponseFlags = Encoding;
+
+    if ((Frame.Flags & MCPFraming::FlagAcceptCompressed) && !bAcceptsCompression)
+    {
+        UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Client accepts compressed responses"), ConnectionId);
+        bAcceptsCompression = true;
+    }
+
+    TSharedPtr<FJsonObject> JsonObject;
+    FString DecodeError;
+    if (!DecodeRequest(Frame, JsonObject, DecodeError))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection[%d]: %s"), ConnectionId, *DecodeError);
+        return SendResponse(FMCPResponse::MakeError(DecodeError), Frame.Framing, ResponseFlags);
+    }
+
+    // "type" is what the Python server sends, "command" is the MCP-style alias
+    FString CommandType;
+    if (!JsonObject->TryGetStringField(TEXT("type"), CommandType) && !JsonObject->TryGetStringField(TEXT("command"), CommandType))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection[%d]: Missing 'type' field in command"), ConnectionId);
+        return SendResponse(FMCPResponse::MakeError(TEXT("Missing 'type' field in command")), Frame.Framing, ResponseFlags);
+    }
+
+    TSharedPtr<FJsonValue> RequestId = JsonObject->TryGetField(TEXT("id"));
+
+    FMCPTraceEntry Trace;
+    Trace.Timestamp = FPlatformTime::Seconds();
+    Trace.ConnectionId = ConnectionId;
+    Trace.Event = EMCPTraceEvent::Request;
+    Trace.Flags = Frame.Flags;
+    Trace.PayloadBytes = Frame.Payload.Num();
+    Trace.SetCommand(CommandType);
+    Trace.SetRequestId(RequestId);
+    FMCPTraceLog::Get().Record(Trace);
+
+    // Parameters are optional
+    TSharedPtr<FJsonObject> Params = MakeShareable(new FJsonObject());
+    const TSharedPtr<FJsonObject>* ParamsObject = nullptr;
+    if (JsonObject->TryGetObjectField(TEXT("params"), ParamsObject) && ParamsObject)
+    {
+        Params = *ParamsObject;
+    }
+
+    // Pipelined request: queue it and keep reading, the response carries the same id
+    if (RequestId.IsValid() && !RequestId->IsNull())
+    {
+        DispatchAsync(CommandType, Params, RequestId, Frame.Framing, ResponseFlags);
+        return true;
+    }
+
+    // Execute command (blocks this worker only — other clients keep being served)
+    const FMCPResponse Response = Bridge->ExecuteCommand(CommandType, Params);
+    if (!SendResponse(Response, Frame.Framing, ResponseFlags))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection[%d]: Failed to send response"), ConnectionId);
+        return false;
+    }
+    return true;
+}
+
+bool FMCPClientConnection::DecodeRequest(const FMCPFrame& Frame, TSharedPtr<FJsonObject>& OutObject, FString& OutError)
+{
+    const TArray<uint8>* Payload = &Frame.Payload;
+    TArray<uint8> Inflated;
+    if (Frame.Flags & MCPFraming::FlagCompressed)
+    {
+        if (!MCPFraming::DecompressPayload(Frame.Payload, Inflated, OutError))
+        {
+            return false;
+        }
+        Payload = &Inflated;
+    }
+
+    if (MCPFraming::GetPayloadEncoding(Frame.Flags) == MCPFraming::PayloadCbor)
+    {
+        UE_LOG(LogMCPTraffic, VeryVerbose, TEXT("MCPClientConnection[%d]: Received %d bytes (CBOR)"), ConnectionId, Frame.Payload.Num());
+        if (!MCPCbor::DecodeObject(Payload->GetData(), Payload->Num(), OutObject, OutError))
+        {
+            OutError = FString::Printf(TEXT("Failed to decode CBOR message: %s"), *OutError);
+            return false;
+        }
+        return true;
+    }
+
+    FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Payload->GetData()), Payload->Num());
+    const FString Message(Converted.Length(), Converted.Get());
+    UE_LOG(LogMCPTraffic, VeryVerbose, TEXT("MCPClientConnection[%d]: Received %d bytes: %s"), ConnectionId, Frame.Payload.Num(), *Message);
+
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
+    if (!FJsonSerializer::Deserialize(Reader, OutObject) || !OutObject.IsValid())
+    {
+        OutError = TEXT("Failed to parse JSON message");
+        return false;
+    }
+    return true;
+}
+
+void FMCPClientConnection::DispatchAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params,
+    const TSharedPtr<FJsonValue>& RequestId, EMCPFraming Framing, uint8 Flags)
+{
+    TWeakPtr<FMCPClientConnection> WeakThis = AsShared();
+    FCommandCompletionFunc Send = [WeakThis, Framing, Flags](const FMCPResponse& Response)
+    {
+        TSharedPtr<FMCPClientConnection> Owner = WeakThis.Pin();
+        if (!Owner.IsValid() || Owner->IsFinished())
+        {
+            return;
+        }
+
+        // Serialize where the command finished (the result tree is only guaranteed
+        // stable there), then hand the socket write to a worker so a slow client
+        // never stalls the editor
+        TArray<uint8> Frame;
+        FMCPTraceEntry Trace;
+        const int32 Offset = Owner->EncodeResponse(Response, Framing, Flags, Frame, Trace);
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis, Offset, Frame = MoveTemp(Frame), CommandType = Response.CommandType, Trace]() mutable
+        {
+            if (TSharedPtr<FMCPClientConnection> Connection = WeakThis.Pin())
+            {
+                if (!Connection->IsFinished() && !Connection->SendFrame(MoveTemp(Frame), Offset, CommandType, Trace))
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection[%d]: Failed to send pipelined response"), Connection->GetConnectionId());
+                }
+            }
+        });
+    };
+
+    // Only pipelining clients match frames by id, so only they can take event frames between responses
+    Bridge->EnqueueCommand(CommandType, Params, RequestId, Send, Send);
+}
+
+bool FMCPClientConnection::SendResponse(const FMCPResponse& Response, EMCPFraming Framing, uint8 Flags)
+{
+    TArray<uint8> Frame;
+    FMCPTraceEntry Trace;
+    const int32 Offset = EncodeResponse(Response, Framing, Flags, Frame, Trace);
+    return SendFrame(MoveTemp(Frame), Offset, Response.CommandType, Trace);
+}
+
+int32 FMCPClientConnection::EncodeResponse(const FMCPResponse& Response, EMCPFraming Framing, uint8 Flags, TArray<uint8>& OutFrame,
+    FMCPTraceEntry& OutTrace)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    OutFrame = ResponseBuffers.Acquire();
+    MCPFraming::BeginFrame(OutFrame);
+
+    // Legacy frames carry no flags, so they can only ever be JSON
+    if (Framing == EMCPFraming::LengthPrefixed && MCPFraming::GetPayloadEncoding(Flags) == MCPFraming::PayloadCbor)
+    {
+        MCPCbor::EncodeResponse(Response, OutFrame);
+    }
+    else
+    {
+        Flags = MCPFraming::PayloadJson;
+        FMCPResponseWriter Writer(OutFrame);
+        Response.Write(Writer);
+
+        if (UE_LOG_ACTIVE(LogMCPTraffic, VeryVerbose))
+        {
+            FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(OutFrame.GetData() + MCPFraming::HeaderSize), OutFrame.Num() - MCPFraming::HeaderSize);
+            UE_LOG(LogMCPTraffic, VeryVerbose, TEXT("MCPClientConnection[%d]: Sending %d bytes: %s"),
+                ConnectionId, Converted.Length(), *FString(Converted.Length(), Converted.Get()));
+        }
+    }
+
+    const int32 PayloadSize = OutFrame.Num() - MCPFraming::HeaderSize;
+    if (Framing == EMCPFraming::LengthPrefixed && bAcceptsCompression && PayloadSize >= MCPFraming::CompressionThreshold)
+    {
+        TArray<uint8> Compressed = ResponseBuffers.Acquire();
+        MCPFraming::BeginFrame(Compressed);
+        if (MCPFraming::CompressPayload(OutFrame.GetData() + MCPFraming::HeaderSize, PayloadSize, Compressed))
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("MCPClientConnection[%d]: Compressed %d-byte response to %d bytes"),
+                ConnectionId, PayloadSize, Compressed.Num() - MCPFraming::HeaderSize);
+            Swap(OutFrame, Compressed);
+            Flags |= MCPFraming::FlagCompressed;
+        }
+        ResponseBuffers.Release(MoveTemp(Compressed));
+    }
+
+    const int32 Offset = MCPFraming::EndFrame(OutFrame, Framing, Flags);
+    const double SerializeSeconds = FPlatformTime::Seconds() - StartTime;
+    FMCPMetrics::Get().RecordPhase(Response.CommandType, EMCPMetricPhase::Serialize, SerializeSeconds);
+
+    OutTrace.ConnectionId = ConnectionId;
+    OutTrace.Event = EMCPTraceEvent::Response;
+    OutTrace.Flags = Flags;
+    OutTrace.bSuccess = Response.bSuccess;
+    OutTrace.PayloadBytes = OutFrame.Num() - Offset;
+    OutTrace.ExecuteMs = (float)(Response.ExecuteSeconds * 1000.0);
+    OutTrace.SerializeMs = (float)(SerializeSeconds * 1000.0);
+    OutTrace.SetCommand(Response.CommandType);
+    OutTrace.SetRequestId(Response.RequestId);
+    return Offset;
+}
+
+bool FMCPClientConnection::SendFrame(TArray<uint8>&& Frame, int32 Offset, const FString& CommandType, FMCPTraceEntry& Trace)
+{
+    // Includes waiting for the lock: a response stuck behind another one is still send time to the client
+    const double StartTime = FPlatformTime::Seconds();
+    bool bSent = false;
+    {
+        FScopeLock Lock(&SendLock);
+        bSent = SendAll(Frame.GetData() + Offset, Frame.Num() - Offset);
+    }
+    const double EndTime = FPlatformTime::Seconds();
+    FMCPMetrics::Get().RecordPhase(CommandType, EMCPMetricPhase::Send, EndTime - StartTime);
+
+    Trace.Timestamp = EndTime;
+    Trace.SendMs = (float)((EndTime - StartTime) * 1000.0);
+    Trace.bSuccess &= bSent;
+    FMCPTraceLog::Get().Record(Trace);
+
+    ResponseBuffers.Release(MoveTemp(Frame));
+    return bSent;
+}
+
+bool FMCPClientConnection::SendAll(const uint8* Data, int32 Num)
+{
+    // Non-blocking sockets may accept only part of a large response per call
+    int32 Offset = 0;
+    while (Offset < Num)
+    {
+        int32 BytesSent = 0;
+        if (!Socket->Send(Data + Offset, Num - Offset, BytesSent))
+        {
+            int32 LastError = (int32)ISocketSubsystem::Get()->GetLastErrorCode();
+            if (LastError != SE_EWOULDBLOCK && LastError != SE_EINTR)
+            {
+                return false;
+            }
+            BytesSent = 0;
+        }
+
+        Offset += BytesSent;
+        if (Offset < Num && BytesSent == 0)
+        {
+            if (!Socket->Wait(ESocketWaitConditions::WaitForWrite, ClientWaitTimeout) && !bRunning)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
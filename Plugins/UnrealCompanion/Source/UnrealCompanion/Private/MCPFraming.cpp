@@ -0,0 +1,315 @@
+#include "MCPFraming.h"
+#include "Containers/StringConv.h"
+#include "Misc/Compression.h"
+
+// Compact once this many consumed bytes sit at the front of the buffer
+static const int32 CompactThreshold = 64 * 1024;
+
+// =========================================================================
+// ENCODING
+// =========================================================================
+
+void MCPFraming::EncodeFrame(const TArray<uint8>& Payload, EMCPFraming Framing, uint8 Flags, TArray<uint8>& OutFrame)
+{
+    OutFrame.Reset();
+
+    if (Framing == EMCPFraming::LengthPrefixed)
+    {
+        const uint32 Length = (uint32)Payload.Num();
+        OutFrame.Reserve(HeaderSize + Payload.Num());
+        OutFrame.Add(FrameMarker);
+        OutFrame.Add(Flags);
+        OutFrame.Add((uint8)((Length >> 24) & 0xFF));
+        OutFrame.Add((uint8)((Length >> 16) & 0xFF));
+        OutFrame.Add((uint8)((Length >> 8) & 0xFF));
+        OutFrame.Add((uint8)(Length & 0xFF));
+        OutFrame.Append(Payload);
+    }
+    else
+    {
+        OutFrame.Reserve(Payload.Num() + 1);
+        OutFrame.Append(Payload);
+        OutFrame.Add('\n');
+    }
+}
+
+void MCPFraming::EncodeStringFrame(const FString& Payload, EMCPFraming Framing, TArray<uint8>& OutFrame)
+{
+    // FTCHARToUTF8::Length() is the UTF-8 byte count, which differs from
+    // FString::Len() as soon as the payload contains non-ASCII characters
+    FTCHARToUTF8 Utf8(*Payload);
+    TArray<uint8> Bytes;
+    Bytes.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    EncodeFrame(Bytes, Framing, 0, OutFrame);
+}
+
+void MCPFraming::BeginFrame(TArray<uint8>& Buffer)
+{
+    Buffer.Reset();
+    Buffer.AddUninitialized(HeaderSize);
+}
+
+int32 MCPFraming::EndFrame(TArray<uint8>& Buffer, EMCPFraming Framing, uint8 Flags)
+{
+    check(Buffer.Num() >= HeaderSize);
+
+    if (Framing == EMCPFraming::LengthPrefixed)
+    {
+        const uint32 Length = (uint32)(Buffer.Num() - HeaderSize);
+        uint8* Header = Buffer.GetData();
+        Header[0] = FrameMarker;
+        Header[1] = Flags;
+        Header[2] = (uint8)((Length >> 24) & 0xFF);
+        Header[3] = (uint8)((Length >> 16) & 0xFF);
+        Header[4] = (uint8)((Length >> 8) & 0xFF);
+        Header[5] = (uint8)(Length & 0xFF);
+        return 0;
+    }
+
+    // Legacy frames have no header: skip the reserved bytes and terminate the document
+    Buffer.Add('\n');
+    return HeaderSize;
+}
+
+// Length prefix in front of the zlib stream (zlib itself does not record the original size)
+static const int32 CompressedPrefixSize = 4;
+
+bool MCPFraming::CompressPayload(const uint8* Data, int32 Num, TArray<uint8>& OutPayload)
+{
+    const int32 Start = OutPayload.Num();
+    const int32 Bound = FCompression::CompressMemoryBound(NAME_Zlib, Num);
+    OutPayload.AddUninitialized(CompressedPrefixSize + Bound);
+
+    uint8* Prefix = OutPayload.GetData() + Start;
+    Prefix[0] = (uint8)((Num >> 24) & 0xFF);
+    Prefix[1] = (uint8)((Num >> 16) & 0xFF);
+    Prefix[2] = (uint8)((Num >> 8) & 0xFF);
+    Prefix[3] = (uint8)(Num & 0xFF);
+
+    int32 CompressedSize = Bound;
+    if (!FCompression::CompressMemory(NAME_Zlib, Prefix + CompressedPrefixSize, CompressedSize, Data, Num)
+        || CompressedPrefixSize + CompressedSize >= Num)
+    {
+        OutPayload.SetNum(Start, EAllowShrinking::No);
+        return false;
+    }
+
+    OutPayload.SetNum(Start + CompressedPrefixSize + CompressedSize, EAllowShrinking::No);
+    return true;
+}
+
+bool MCPFraming::DecompressPayload(const TArray<uint8>& Payload, TArray<uint8>& OutPayload, FString& OutError)
+{
+    if (Payload.Num() < CompressedPrefixSize)
+    {
+        OutError = TEXT("Compressed payload is missing its length prefix");
+        return false;
+    }
+
+    const uint32 Length = ((uint32)Payload[0] << 24) | ((uint32)Payload[1] << 16) | ((uint32)Payload[2] << 8) | (uint32)Payload[3];
+    if ((int64)Length > MaxFrameSize)
+    {
+        OutError = FString::Printf(TEXT("Compressed payload inflates to %u bytes, over the %lld byte limit"), Length, MaxFrameSize);
+        return false;
+    }
+
+    OutPayload.SetNumUninitialized((int32)Length);
+    if (!FCompression::UncompressMemory(NAME_Zlib, OutPayload.GetData(), (int32)Length,
+        Payload.GetData() + CompressedPrefixSize, Payload.Num() - CompressedPrefixSize))
+    {
+        OutPayload.Reset();
+        OutError = TEXT("Failed to decompress payload");
+        return false;
+    }
+    return true;
+}
+
+FString FMCPFrame::PayloadAsString() const
+{
+    FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Payload.GetData()), Payload.Num());
+    return FString(Converted.Length(), Converted.Get());
+}
+
+// =========================================================================
+// DECODING
+// =========================================================================
+
+void FMCPFrameReader::Append(const uint8* Data, int32 Num)
+{
+    if (Num <= 0 || HasError())
+    {
+        return;
+    }
+    Compact();
+    Buffer.Append(Data, Num);
+}
+
+void FMCPFrameReader::Compact()
+{
+    if (ReadOffset == 0)
+    {
+        return;
+    }
+    if (ReadOffset == Buffer.Num())
+    {
+        Buffer.Reset();
+        LegacyScanOffset = 0;
+        ReadOffset = 0;
+        return;
+    }
+    if (ReadOffset >= CompactThreshold)
+    {
+        Buffer.RemoveAt(0, ReadOffset, EAllowShrinking::No);
+        LegacyScanOffset = FMath::Max(0, LegacyScanOffset - ReadOffset);
+        ReadOffset = 0;
+    }
+}
+
+void FMCPFrameReader::SkipInterFrameBytes()
+{
+    // Whitespace and NUL bytes between frames are ignored. NUL matters because
+    // clients probe the connection by sending a single '\0'.
+    while (ReadOffset < Buffer.Num())
+    {
+        const uint8 Byte = Buffer[ReadOffset];
+        if (Byte == 0 || Byte == ' ' || Byte == '\t' || Byte == '\r' || Byte == '\n')
+        {
+            ++ReadOffset;
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+bool FMCPFrameReader::TryPopFrame(FMCPFrame& OutFrame)
+{
+    if (HasError())
+    {
+        return false;
+    }
+
+    // Only skip separators when no legacy document is half-scanned
+    if (LegacyScanOffset <= ReadOffset)
+    {
+        SkipInterFrameBytes();
+    }
+
+    if (ReadOffset >= Buffer.Num())
+    {
+        return false;
+    }
+
+    const uint8 First = Buffer[ReadOffset];
+    if (First == MCPFraming::FrameMarker)
+    {
+        return TryPopLengthPrefixed(OutFrame);
+    }
+    if (First == '{')
+    {
+        return TryPopLegacy(OutFrame);
+    }
+
+    Error = FString::Printf(TEXT("Unexpected byte 0x%02X at start of frame"), First);
+    return false;
+}
+
+bool FMCPFrameReader::TryPopLengthPrefixed(FMCPFrame& OutFrame)
+{
+    const int32 Available = Buffer.Num() - ReadOffset;
+    if (Available < MCPFraming::HeaderSize)
+    {
+        return false;
+    }
+
+    const uint8* Header = Buffer.GetData() + ReadOffset;
+    const uint8 Flags = Header[1];
+    const uint32 Length = ((uint32)Header[2] << 24) | ((uint32)Header[3] << 16) | ((uint32)Header[4] << 8) | (uint32)Header[5];
+
+    if ((int64)Length > MCPFraming::MaxFrameSize)
+    {
+        Error = FString::Printf(TEXT("Frame of %u bytes exceeds the %lld byte limit"), Length, MCPFraming::MaxFrameSize);
+        return false;
+    }
+
+    if ((int64)Available < (int64)MCPFraming::HeaderSize + Length)
+    {
+        // Reserve up-front so a multi-megabyte frame doesn't grow the buffer step by step
+        Buffer.Reserve(ReadOffset + MCPFraming::HeaderSize + (int32)Length);
+        return false;
+    }
+
+    OutFrame.Framing = EMCPFraming::LengthPrefixed;
+    OutFrame.Flags = Flags;
+    OutFrame.Payload.Reset();
+    OutFrame.Payload.Append(Header + MCPFraming::HeaderSize, (int32)Length);
+    ReadOffset += MCPFraming::HeaderSize + (int32)Length;
+    return true;
+}
+
+bool FMCPFrameReader::TryPopLegacy(FMCPFrame& OutFrame)
+{
+    if (LegacyScanOffset <= ReadOffset)
+    {
+        // Starting a new document
+        LegacyScanOffset = ReadOffset;
+        LegacyDepth = 0;
+        bLegacyInString = false;
+        bLegacyEscape = false;
+    }
+
+    const int32 End = Buffer.Num();
+    for (int32 Index = LegacyScanOffset; Index < End; ++Index)
+    {
+        const uint8 Byte = Buffer[Index];
+
+        if (bLegacyInString)
+        {
+            if (bLegacyEscape)
+            {
+                bLegacyEscape = false;
+            }
+            else if (Byte == '\\')
+            {
+                bLegacyEscape = true;
+            }
+            else if (Byte == '"')
+            {
+                bLegacyInString = false;
+            }
+            continue;
+        }
+
+        if (Byte == '"')
+        {
+            bLegacyInString = true;
+        }
+        else if (Byte == '{' || Byte == '[')
+        {
+            ++LegacyDepth;
+        }
+        else if (Byte == '}' || Byte == ']')
+        {
+            --LegacyDepth;
+            if (LegacyDepth == 0)
+            {
+                const int32 DocumentLength = Index + 1 - ReadOffset;
+                OutFrame.Framing = EMCPFraming::Legacy;
+                OutFrame.Flags = 0;
+                OutFrame.Payload.Reset();
+                OutFrame.Payload.Append(Buffer.GetData() + ReadOffset, DocumentLength);
+                ReadOffset = Index + 1;
+                LegacyScanOffset = ReadOffset;
+                return true;
+            }
+        }
+    }
+
+    LegacyScanOffset = End;
+    if ((int64)(End - ReadOffset) > MCPFraming::MaxFrameSize)
+    {
+        Error = FString::Printf(TEXT("Unterminated JSON message exceeds the %lld byte limit"), MCPFraming::MaxFrameSize);
+    }
+    return false;
+}
@@ -0,0 +1,240 @@
+#include "MCPMetrics.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    const TCHAR* GetPhaseName(EMCPMetricPhase Phase)
+    {
+        switch (Phase)
+        {
+            case EMCPMetricPhase::QueueWait: return TEXT("queue_wait");
+            case EMCPMetricPhase::Execute: return TEXT("execute");
+            case EMCPMetricPhase::Serialize: return TEXT("serialize");
+            case EMCPMetricPhase::Send: return TEXT("send");
+            default: return TEXT("unknown");
+        }
+    }
+
+    static const double ReportedQuantiles[] = { 0.5, 0.95, 0.99 };
+
+    TSharedPtr<FJsonObject> HistogramToJson(const FMCPLatencyHistogram& Histogram)
+    {
+        TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+        Json->SetNumberField(TEXT("count"), (double)Histogram.Count);
+        Json->SetNumberField(TEXT("mean_ms"), Histogram.Count > 0 ? Histogram.SumSeconds * 1000.0 / Histogram.Count : 0.0);
+        Json->SetNumberField(TEXT("p50_ms"), Histogram.GetQuantileMs(0.5));
+        Json->SetNumberField(TEXT("p95_ms"), Histogram.GetQuantileMs(0.95));
+        Json->SetNumberField(TEXT("p99_ms"), Histogram.GetQuantileMs(0.99));
+        Json->SetNumberField(TEXT("max_ms"), Histogram.MaxSeconds * 1000.0);
+        return Json;
+    }
+}
+
+// =========================================================================
+// HISTOGRAM
+// =========================================================================
+
+void FMCPLatencyHistogram::Record(double Seconds)
+{
+    Seconds = FMath::Max(Seconds, 0.0);
+    const double Micros = Seconds * 1e6;
+
+    // Bucket i holds values up to 2^(i/4) us
+    int32 Index = 0;
+    if (Micros > 1.0)
+    {
+        Index = FMath::Clamp(FMath::CeilToInt32(FMath::Log2(Micros) * 4.0), 0, NumBuckets - 1);
+    }
+
+    ++Buckets[Index];
+    ++Count;
+    SumSeconds += Seconds;
+    MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+}
+
+void FMCPLatencyHistogram::Reset()
+{
+    *this = FMCPLatencyHistogram();
+}
+
+double FMCPLatencyHistogram::GetQuantileMs(double Q) const
+{
+    if (Count == 0)
+    {
+        return 0.0;
+    }
+
+    const uint64 Target = FMath::Max<uint64>(1, (uint64)FMath::CeilToDouble(FMath::Clamp(Q, 0.0, 1.0) * (double)Count));
+    uint64 Seen = 0;
+    for (int32 Index = 0; Index < NumBuckets; ++Index)
+    {
+        Seen += Buckets[Index];
+        if (Seen >= Target)
+        {
+            // Never report more than the largest value actually seen
+            const double UpperMs = FMath::Pow(2.0, Index / 4.0) / 1000.0;
+            return FMath::Min(UpperMs, MaxSeconds * 1000.0);
+        }
+    }
+    return MaxSeconds * 1000.0;
+}
+
+// =========================================================================
+// METRICS
+// =========================================================================
+
+FMCPMetrics& FMCPMetrics::Get()
+{
+    static FMCPMetrics Instance;
+    return Instance;
+}
+
+FMCPMetrics::FMCPMetrics()
+    : StartTime(FPlatformTime::Seconds())
+{
+}
+
+FMCPMetrics::FCommandStats& FMCPMetrics::FindOrAddLocked(const FString& CommandType)
+{
+    return Commands.FindOrAdd(CommandType);
+}
+
+void FMCPMetrics::RecordPhase(const FString& CommandType, EMCPMetricPhase Phase, double Seconds)
+{
+    if (CommandType.IsEmpty())
+    {
+        return;
+    }
+    FScopeLock ScopeLock(&Lock);
+    FindOrAddLocked(CommandType).Phases[(int32)Phase].Record(Seconds);
+}
+
+void FMCPMetrics::RecordCompletion(const FString& CommandType, bool bSuccess, double Seconds)
+{
+    if (CommandType.IsEmpty())
+    {
+        return;
+    }
+    FScopeLock ScopeLock(&Lock);
+    FCommandStats& Stats = FindOrAddLocked(CommandType);
+    ++(bSuccess ? Stats.Completed : Stats.Failed);
+    Stats.Phases[(int32)EMCPMetricPhase::Execute].Record(Seconds);
+}
+
+void FMCPMetrics::RecordRejection(const FString& CommandType)
+{
+    if (CommandType.IsEmpty())
+    {
+        return;
+    }
+    FScopeLock ScopeLock(&Lock);
+    ++FindOrAddLocked(CommandType).Rejected;
+}
+
+void FMCPMetrics::Reset()
+{
+    FScopeLock ScopeLock(&Lock);
+    Commands.Reset();
+    StartTime = FPlatformTime::Seconds();
+}
+
+TSharedPtr<FJsonObject> FMCPMetrics::BuildReport(int32 QueueDepth) const
+{
+    FScopeLock ScopeLock(&Lock);
+
+    // Most total execution time first: the tools worth optimising lead the report
+    TArray<const TPair<FString, FCommandStats>*> Sorted;
+    Sorted.Reserve(Commands.Num());
+    for (const TPair<FString, FCommandStats>& Pair : Commands)
+    {
+        Sorted.Add(&Pair);
+    }
+    Sorted.Sort([](const TPair<FString, FCommandStats>& A, const TPair<FString, FCommandStats>& B)
+    {
+        return A.Value.Phases[(int32)EMCPMetricPhase::Execute].SumSeconds > B.Value.Phases[(int32)EMCPMetricPhase::Execute].SumSeconds;
+    });
+
+    uint64 TotalCompleted = 0;
+    uint64 TotalFailed = 0;
+    uint64 TotalRejected = 0;
+    TSharedPtr<FJsonObject> CommandsJson = MakeShared<FJsonObject>();
+    for (const TPair<FString, FCommandStats>* Pair : Sorted)
+    {
+        const FCommandStats& Stats = Pair->Value;
+        const uint64 Requests = Stats.Completed + Stats.Failed + Stats.Rejected;
+        TotalCompleted += Stats.Completed;
+        TotalFailed += Stats.Failed;
+        TotalRejected += Stats.Rejected;
+
+        TSharedPtr<FJsonObject> CommandJson = MakeShared<FJsonObject>();
+        CommandJson->SetNumberField(TEXT("count"), (double)Requests);
+        CommandJson->SetNumberField(TEXT("errors"), (double)Stats.Failed);
+        CommandJson->SetNumberField(TEXT("rejected"), (double)Stats.Rejected);
+        CommandJson->SetNumberField(TEXT("error_rate"), Requests > 0 ? (double)(Stats.Failed + Stats.Rejected) / Requests : 0.0);
+        for (int32 PhaseIndex = 0; PhaseIndex < (int32)EMCPMetricPhase::Count; ++PhaseIndex)
+        {
+            const FMCPLatencyHistogram& Histogram = Stats.Phases[PhaseIndex];
+            if (Histogram.Count > 0)
+            {
+                CommandJson->SetObjectField(FString::Printf(TEXT("%s_ms"), GetPhaseName((EMCPMetricPhase)PhaseIndex)), HistogramToJson(Histogram));
+            }
+        }
+        CommandsJson->SetObjectField(Pair->Key, CommandJson);
+    }
+
+    TSharedPtr<FJsonObject> Totals = MakeShared<FJsonObject>();
+    Totals->SetNumberField(TEXT("completed"), (double)TotalCompleted);
+    Totals->SetNumberField(TEXT("errors"), (double)TotalFailed);
+    Totals->SetNumberField(TEXT("rejected"), (double)TotalRejected);
+
+    TSharedPtr<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetNumberField(TEXT("uptime_seconds"), FPlatformTime::Seconds() - StartTime);
+    Report->SetNumberField(TEXT("queue_depth"), QueueDepth);
+    Report->SetObjectField(TEXT("totals"), Totals);
+    Report->SetObjectField(TEXT("commands"), CommandsJson);
+    return Report;
+}
+
+FString FMCPMetrics::BuildPrometheusText(int32 QueueDepth) const
+{
+    FScopeLock ScopeLock(&Lock);
+
+    TStringBuilder<4096> Out;
+    Out << TEXT("# HELP unreal_companion_queue_depth Commands waiting for the game thread\n");
+    Out << TEXT("# TYPE unreal_companion_queue_depth gauge\n");
+    Out.Appendf(TEXT("unreal_companion_queue_depth %d\n"), QueueDepth);
+
+    Out << TEXT("# HELP unreal_companion_commands_total Requests by command and outcome\n");
+    Out << TEXT("# TYPE unreal_companion_commands_total counter\n");
+    for (const TPair<FString, FCommandStats>& Pair : Commands)
+    {
+        Out.Appendf(TEXT("unreal_companion_commands_total{command=\"%s\",outcome=\"success\"} %llu\n"), *Pair.Key, Pair.Value.Completed);
+        Out.Appendf(TEXT("unreal_companion_commands_total{command=\"%s\",outcome=\"error\"} %llu\n"), *Pair.Key, Pair.Value.Failed);
+        Out.Appendf(TEXT("unreal_companion_commands_total{command=\"%s\",outcome=\"rejected\"} %llu\n"), *Pair.Key, Pair.Value.Rejected);
+    }
+
+    Out << TEXT("# HELP unreal_companion_command_duration_seconds Time per command and phase\n");
+    Out << TEXT("# TYPE unreal_companion_command_duration_seconds summary\n");
+    for (const TPair<FString, FCommandStats>& Pair : Commands)
+    {
+        for (int32 PhaseIndex = 0; PhaseIndex < (int32)EMCPMetricPhase::Count; ++PhaseIndex)
+        {
+            const FMCPLatencyHistogram& Histogram = Pair.Value.Phases[PhaseIndex];
+            if (Histogram.Count == 0)
+            {
+                continue;
+            }
+            const TCHAR* PhaseName = GetPhaseName((EMCPMetricPhase)PhaseIndex);
+            for (double Quantile : ReportedQuantiles)
+            {
+                Out.Appendf(TEXT("unreal_companion_command_duration_seconds{command=\"%s\",phase=\"%s\",quantile=\"%g\"} %.6f\n"),
+                    *Pair.Key, PhaseName, Quantile, Histogram.GetQuantileMs(Quantile) / 1000.0);
+            }
+            Out.Appendf(TEXT("unreal_companion_command_duration_seconds_sum{command=\"%s\",phase=\"%s\"} %.6f\n"), *Pair.Key, PhaseName, Histogram.SumSeconds);
+            Out.Appendf(TEXT("unreal_companion_command_duration_seconds_count{command=\"%s\",phase=\"%s\"} %llu\n"), *Pair.Key, PhaseName, Histogram.Count);
+        }
+    }
+    return FString(Out.ToView());
+}
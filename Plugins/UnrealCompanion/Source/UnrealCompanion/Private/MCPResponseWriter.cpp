@@ -0,0 +1,362 @@
+#include "MCPResponseWriter.h"
+#include "Dom/JsonObject.h"
+#include "Misc/CString.h"
+
+// =========================================================================
+// WRITER
+// =========================================================================
+
+void FMCPResponseWriter::BeginElement()
+{
+    if (bAfterKey)
+    {
+        bAfterKey = false;
+        return;
+    }
+    if (Scopes.Num() > 0)
+    {
+        if (Scopes.Last())
+        {
+            Buffer.Add(',');
+        }
+        Scopes.Last() = true;
+    }
+}
+
+void FMCPResponseWriter::BeginObject()
+{
+    BeginElement();
+    Buffer.Add('{');
+    Scopes.Add(false);
+}
+
+void FMCPResponseWriter::EndObject()
+{
+    check(Scopes.Num() > 0 && !bAfterKey);
+    Scopes.Pop(EAllowShrinking::No);
+    Buffer.Add('}');
+}
+
+void FMCPResponseWriter::BeginArray()
+{
+    BeginElement();
+    Buffer.Add('[');
+    Scopes.Add(false);
+}
+
+void FMCPResponseWriter::EndArray()
+{
+    check(Scopes.Num() > 0 && !bAfterKey);
+    Scopes.Pop(EAllowShrinking::No);
+    Buffer.Add(']');
+}
+
+void FMCPResponseWriter::WriteKey(FStringView Key)
+{
+    check(!bAfterKey);
+    BeginElement();
+    WriteString(Key);
+    Buffer.Add(':');
+    bAfterKey = true;
+}
+
+void FMCPResponseWriter::WriteValue(FStringView Value)
+{
+    BeginElement();
+    WriteString(Value);
+}
+
+void FMCPResponseWriter::WriteValue(double Value)
+{
+    BeginElement();
+    if (!FMath::IsFinite(Value))
+    {
+        AppendAscii("null", 4);
+        return;
+    }
+
+    // Same precision as the engine writer: 17 significant digits keep large integers exact
+    ANSICHAR Digits[64];
+    const int32 Len = FCStringAnsi::Snprintf(Digits, UE_ARRAY_COUNT(Digits), "%.17g", Value);
+    AppendAscii(Digits, Len);
+}
+
+void FMCPResponseWriter::WriteValue(int64 Value)
+{
+    BeginElement();
+    ANSICHAR Digits[32];
+    const int32 Len = FCStringAnsi::Snprintf(Digits, UE_ARRAY_COUNT(Digits), "%lld", (long long)Value);
+    AppendAscii(Digits, Len);
+}
+
+void FMCPResponseWriter::WriteValue(bool Value)
+{
+    BeginElement();
+    if (Value)
+    {
+        AppendAscii("true", 4);
+    }
+    else
+    {
+        AppendAscii("false", 5);
+    }
+}
+
+void FMCPResponseWriter::WriteNull()
+{
+    BeginElement();
+    AppendAscii("null", 4);
+}
+
+void FMCPResponseWriter::WriteRawValue(const uint8* Utf8, int32 Num)
+{
+    BeginElement();
+    Buffer.Append(Utf8, Num);
+}
+
+void FMCPResponseWriter::WriteValue(const TSharedPtr<FJsonValue>& Value)
+{
+    if (!Value.IsValid())
+    {
+        WriteNull();
+        return;
+    }
+
+    switch (Value->Type)
+    {
+        case EJson::String:
+            Value->TryGetString(Scratch);
+            WriteValue(FStringView(Scratch));
+            break;
+        case EJson::Number:
+        {
+            double Number = 0.0;
+            Value->TryGetNumber(Number);
+            WriteValue(Number);
+            break;
+        }
+        case EJson::Boolean:
+        {
+            bool bValue = false;
+            Value->TryGetBool(bValue);
+            WriteValue(bValue);
+            break;
+        }
+        case EJson::Array:
+        {
+            BeginArray();
+            const TArray<TSharedPtr<FJsonValue>>* Elements = nullptr;
+            if (Value->TryGetArray(Elements) && Elements)
+            {
+                for (const TSharedPtr<FJsonValue>& Element : *Elements)
+                {
+                    WriteValue(Element);
+                }
+            }
+            EndArray();
+            break;
+        }
+        case EJson::Object:
+        {
+            const TSharedPtr<FJsonObject>* Object = nullptr;
+            if (Value->TryGetObject(Object) && Object && Object->IsValid())
+            {
+                WriteObject(**Object);
+            }
+            else
+            {
+                WriteNull();
+            }
+            break;
+        }
+        case EJson::None:
+        {
+            // The engine's own values always carry a concrete type; None is only used by FMCPJsonValueRaw
+            const TArray<uint8>& Utf8 = static_cast<const FMCPJsonValueRaw&>(*Value).GetUtf8();
+            if (Utf8.Num() > 0)
+            {
+                WriteRawValue(Utf8.GetData(), Utf8.Num());
+            }
+            else
+            {
+                WriteNull();
+            }
+            break;
+        }
+        case EJson::Null:
+        default:
+            WriteNull();
+            break;
+    }
+}
+
+void FMCPResponseWriter::WriteObject(const FJsonObject& Object)
+{
+    BeginObject();
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object.Values)
+    {
+        WriteKey(Field.Key);
+        WriteValue(Field.Value);
+    }
+    EndObject();
+}
+
+void FMCPResponseWriter::AppendAscii(const ANSICHAR* Text, int32 Len)
+{
+    Buffer.Append(reinterpret_cast<const uint8*>(Text), Len);
+}
+
+void FMCPResponseWriter::WriteString(FStringView Value)
+{
+    static const ANSICHAR HexDigits[] = "0123456789abcdef";
+
+    const TCHAR* Data = Value.GetData();
+    const int32 Len = Value.Len();
+
+    // Most strings are short ASCII: reserve for that case, non-ASCII runs grow the buffer as needed
+    Buffer.Reserve(Buffer.Num() + Len + 2);
+    Buffer.Add('"');
+
+    int32 Index = 0;
+    while (Index < Len)
+    {
+        const uint32 Char = (uint32)Data[Index];
+        if (Char >= 0x80)
+        {
+            // Transcode the whole non-ASCII run at once so UTF-16 surrogate pairs stay together
+            int32 RunEnd = Index + 1;
+            while (RunEnd < Len && (uint32)Data[RunEnd] >= 0x80)
+            {
+                ++RunEnd;
+            }
+            const int32 RunLen = RunEnd - Index;
+            const int32 Utf8Len = FPlatformString::ConvertedLength<UTF8CHAR>(Data + Index, RunLen);
+            const int32 Offset = Buffer.AddUninitialized(Utf8Len);
+            FPlatformString::Convert(reinterpret_cast<UTF8CHAR*>(Buffer.GetData() + Offset), Utf8Len, Data + Index, RunLen);
+            Index = RunEnd;
+            continue;
+        }
+
+        switch (Char)
+        {
+            case '"':  AppendAscii("\\\"", 2); break;
+            case '\\': AppendAscii("\\\\", 2); break;
+            case '\n': AppendAscii("\\n", 2); break;
+            case '\r': AppendAscii("\\r", 2); break;
+            case '\t': AppendAscii("\\t", 2); break;
+            case '\b': AppendAscii("\\b", 2); break;
+            case '\f': AppendAscii("\\f", 2); break;
+            default:
+                if (Char < 0x20)
+                {
+                    const ANSICHAR Escaped[6] = { '\\', 'u', '0', '0', HexDigits[Char >> 4], HexDigits[Char & 0xF] };
+                    AppendAscii(Escaped, 6);
+                }
+                else
+                {
+                    Buffer.Add((uint8)Char);
+                }
+                break;
+        }
+        ++Index;
+    }
+
+    Buffer.Add('"');
+}
+
+// =========================================================================
+// RESPONSE ENVELOPE
+// =========================================================================
+
+FMCPResponse FMCPResponse::MakeError(const FString& InError, const FString& InErrorCode,
+    const TSharedPtr<FJsonValue>& InRequestId, int32 InQueueDepth)
+{
+    FMCPResponse Response;
+    Response.bSuccess = false;
+    Response.Error = InError;
+    Response.ErrorCode = InErrorCode;
+    Response.RequestId = InRequestId;
+    Response.QueueDepth = InQueueDepth;
+    return Response;
+}
+
+void FMCPResponse::Write(FMCPResponseWriter& Writer) const
+{
+    // Field order matches the envelope the bridge used to build as an FJsonObject
+    Writer.BeginObject();
+    if (!Event.IsEmpty())
+    {
+        Writer.WriteField(TEXT("status"), TEXT("event"));
+        Writer.WriteField(TEXT("event"), Event);
+        Writer.WriteKey(TEXT("result"));
+        if (Result.IsValid())
+        {
+            Writer.WriteObject(*Result);
+        }
+        else
+        {
+            Writer.WriteNull();
+        }
+    }
+    else if (bSuccess)
+    {
+        Writer.WriteField(TEXT("status"), TEXT("success"));
+        Writer.WriteKey(TEXT("result"));
+        if (Result.IsValid())
+        {
+            Writer.WriteObject(*Result);
+        }
+        else
+        {
+            Writer.WriteNull();
+        }
+    }
+    else
+    {
+        Writer.WriteField(TEXT("status"), TEXT("error"));
+        Writer.WriteField(TEXT("error"), Error);
+        if (!ErrorCode.IsEmpty())
+        {
+            Writer.WriteField(TEXT("error_code"), ErrorCode);
+        }
+        if (QueueDepth >= 0)
+        {
+            Writer.WriteField(TEXT("queue_depth"), QueueDepth);
+        }
+    }
+    if (RequestId.IsValid())
+    {
+        Writer.WriteKey(TEXT("id"));
+        Writer.WriteValue(RequestId);
+    }
+    Writer.EndObject();
+}
+
+// =========================================================================
+// BUFFER POOL
+// =========================================================================
+
+TArray<uint8> FMCPBufferPool::Acquire()
+{
+    FScopeLock ScopeLock(&Lock);
+    if (Free.Num() > 0)
+    {
+        return Free.Pop(EAllowShrinking::No);
+    }
+    return TArray<uint8>();
+}
+
+void FMCPBufferPool::Release(TArray<uint8>&& Buffer)
+{
+    if (Buffer.Max() > MaxPooledCapacity)
+    {
+        return;
+    }
+
+    Buffer.Reset();
+    FScopeLock ScopeLock(&Lock);
+    if (Free.Num() < MaxPooledBuffers)
+    {
+        Free.Add(MoveTemp(Buffer));
+    }
+}
@@ -0,0 +1,127 @@
+#include "MCPSharedMemory.h"
+#include "UnrealCompanionSettings.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMCPSharedMemory, Log, All);
+
+namespace
+{
+    const uint8 RegionMagic[8] = { 'U', 'C', 'S', 'H', 'M', '0', '0', '1' };
+
+    void WriteUInt64(uint8* Dest, uint64 Value)
+    {
+        for (int32 Byte = 0; Byte < 8; ++Byte)
+        {
+            Dest[Byte] = (uint8)(Value >> (Byte * 8));
+        }
+    }
+}
+
+FMCPSharedMemory& FMCPSharedMemory::Get()
+{
+    static FMCPSharedMemory Instance;
+    return Instance;
+}
+
+bool FMCPSharedMemory::EnsureRegion_Locked(FString& OutError)
+{
+    if (Region)
+    {
+        return true;
+    }
+
+    const int32 SizeMB = GetDefault<UUnrealCompanionSettings>()->SharedMemoryMB;
+    if (SizeMB <= 0)
+    {
+        OutError = TEXT("Shared memory is disabled (SharedMemoryMB = 0)");
+        return false;
+    }
+
+    RegionName = FString::Printf(TEXT("UnrealCompanion_%u"), FPlatformProcess::GetCurrentProcessId());
+    const SIZE_T Size = (SIZE_T)SizeMB * 1024 * 1024;
+    Region = FPlatformMemory::MapNamedSharedMemoryRegion(RegionName, true,
+        (uint32)FPlatformMemory::ESharedMemoryAccess::Read | (uint32)FPlatformMemory::ESharedMemoryAccess::Write, Size);
+    if (!Region)
+    {
+        OutError = FString::Printf(TEXT("Could not create shared memory region %s"), *RegionName);
+        return false;
+    }
+
+    uint8* Base = static_cast<uint8*>(Region->GetAddress());
+    FMemory::Memzero(Base, HeaderSize);
+    FMemory::Memcpy(Base, RegionMagic, sizeof(RegionMagic));
+    WriteUInt64(Base + 8, Region->GetSize());
+    Head = HeaderSize;
+    LiveRecords.Reset();
+
+    UE_LOG(LogMCPSharedMemory, Display, TEXT("Shared memory region %s: %d MB"), *RegionName, SizeMB);
+    return true;
+}
+
+TSharedPtr<FJsonObject> FMCPSharedMemory::Write(const uint8* Data, int64 Num, FString& OutError)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (!EnsureRegion_Locked(OutError))
+    {
+        return nullptr;
+    }
+
+    const int64 RegionSize = (int64)Region->GetSize();
+    const int64 RecordSize = Align(RecordHeaderSize + Num, 16);
+    if (RecordSize > RegionSize - HeaderSize)
+    {
+        OutError = FString::Printf(TEXT("%lld bytes do not fit the %lld byte shared memory region"), Num, RegionSize - HeaderSize);
+        return nullptr;
+    }
+
+    int64 Offset = Head;
+    if (Offset + RecordSize > RegionSize)
+    {
+        Offset = HeaderSize;
+    }
+    const int64 End = Offset + RecordSize;
+
+    // Invalidate every record this one lands on before a byte of it changes
+    uint8* Base = static_cast<uint8*>(Region->GetAddress());
+    LiveRecords.RemoveAll([Base, Offset, End](const FRecord& Record)
+    {
+        if (Record.Offset < End && Offset < Record.End)
+        {
+            FMemory::Memzero(Base + Record.Offset, RecordHeaderSize);
+            return true;
+        }
+        return false;
+    });
+    FPlatformMisc::MemoryBarrier();
+
+    // Data first, header last: a reader never sees a valid header over unwritten bytes
+    const uint64 Sequence = NextSequence++;
+    FMemory::Memcpy(Base + Offset + RecordHeaderSize, Data, Num);
+    FPlatformMisc::MemoryBarrier();
+    WriteUInt64(Base + Offset + 8, (uint64)Num);
+    WriteUInt64(Base + Offset, Sequence);
+
+    LiveRecords.Add(FRecord{Offset, End});
+    Head = End;
+
+    TSharedPtr<FJsonObject> Handle = MakeShared<FJsonObject>();
+    Handle->SetStringField(TEXT("name"), RegionName);
+    Handle->SetNumberField(TEXT("size"), (double)RegionSize);
+    Handle->SetNumberField(TEXT("offset"), (double)(Offset + RecordHeaderSize));
+    Handle->SetNumberField(TEXT("length"), (double)Num);
+    Handle->SetNumberField(TEXT("sequence"), (double)Sequence);
+    return Handle;
+}
+
+void FMCPSharedMemory::Shutdown()
+{
+    FScopeLock ScopeLock(&Lock);
+    if (Region)
+    {
+        FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+        Region = nullptr;
+    }
+    LiveRecords.Reset();
+    Head = HeaderSize;
+}
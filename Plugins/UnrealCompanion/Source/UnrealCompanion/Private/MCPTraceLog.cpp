@@ -0,0 +1,189 @@
+#include "MCPTraceLog.h"
+#include "MCPFraming.h"
+#include "Dom/JsonValue.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+DEFINE_LOG_CATEGORY(LogMCPTraffic);
+
+namespace
+{
+    static_assert((FMCPTraceLog::Capacity & (FMCPTraceLog::Capacity - 1)) == 0, "Trace capacity must be a power of two");
+    static_assert(TIsTriviallyCopyable<FMCPTraceEntry>::Value, "Trace entries are copied into the ring as raw words");
+
+    void CopyTruncated(ANSICHAR* Dest, const FString& Source)
+    {
+        FCStringAnsi::Strncpy(Dest, TCHAR_TO_UTF8(*Source), FMCPTraceEntry::MaxNameLength);
+    }
+
+    const TCHAR* GetEncodingName(uint8 Flags)
+    {
+        return MCPFraming::GetPayloadEncoding(Flags) == MCPFraming::PayloadCbor ? TEXT("cbor") : TEXT("json");
+    }
+
+    FAutoConsoleCommand DumpTraceCommand(
+        TEXT("UnrealCompanion.DumpTrace"),
+        TEXT("Log the most recent MCP request/response summaries. Optional argument: number of entries (default 50)."),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+        {
+            const int32 MaxEntries = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 50;
+            FMCPTraceLog::Get().DumpToLog(MaxEntries > 0 ? MaxEntries : 50);
+        }));
+}
+
+void FMCPTraceEntry::SetCommand(const FString& InCommand)
+{
+    CopyTruncated(Command, InCommand);
+}
+
+void FMCPTraceEntry::SetRequestId(const TSharedPtr<FJsonValue>& InRequestId)
+{
+    RequestId[0] = '\0';
+    if (!InRequestId.IsValid() || InRequestId->IsNull())
+    {
+        return;
+    }
+
+    double Number = 0.0;
+    if (InRequestId->TryGetNumber(Number))
+    {
+        FCStringAnsi::Snprintf(RequestId, MaxNameLength, "%.0f", Number);
+        return;
+    }
+    FString Text;
+    if (InRequestId->TryGetString(Text))
+    {
+        CopyTruncated(RequestId, Text);
+    }
+}
+
+FMCPTraceLog& FMCPTraceLog::Get()
+{
+    static FMCPTraceLog Instance;
+    return Instance;
+}
+
+void FMCPTraceLog::Record(const FMCPTraceEntry& Entry)
+{
+    // Tickets start at 1 so a zero stamp always means "never written"
+    const uint64 Ticket = NextTicket.fetch_add(1, std::memory_order_relaxed) + 1;
+    FSlot& Slot = Slots[(Ticket - 1) & (Capacity - 1)];
+
+    // Claim the slot. It is still being written, or holds a newer entry, only if the ring
+    // wrapped around during another writer's copy: this entry is the one dropped then.
+    uint64 Current = Slot.Sequence.load(std::memory_order_relaxed);
+    do
+    {
+        if ((Current & 1) != 0 || Current >= Ticket * 2)
+        {
+            return;
+        }
+    }
+    while (!Slot.Sequence.compare_exchange_weak(Current, Ticket * 2 - 1, std::memory_order_relaxed));
+    // Keeps the "being written" mark ahead of the entry's words
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint64 Words[EntryWords] = {};
+    FMemory::Memcpy(Words, &Entry, sizeof(FMCPTraceEntry));
+    for (int32 Index = 0; Index < EntryWords; ++Index)
+    {
+        Slot.Words[Index].store(Words[Index], std::memory_order_relaxed);
+    }
+
+    // Publish: a reader that sees this ticket sees every word above
+    Slot.Sequence.store(Ticket * 2, std::memory_order_release);
+}
+
+void FMCPTraceLog::Snapshot(TArray<FMCPTraceEntry>& OutEntries, int32 MaxEntries) const
+{
+    OutEntries.Reset();
+    const uint64 Last = NextTicket.load(std::memory_order_acquire);
+    const uint64 Count = FMath::Min<uint64>(Last, (uint64)FMath::Clamp(MaxEntries, 0, Capacity));
+    OutEntries.Reserve((int32)Count);
+
+    uint64 Words[EntryWords];
+    for (uint64 Ticket = Last - Count + 1; Ticket <= Last; ++Ticket)
+    {
+        const FSlot& Slot = Slots[(Ticket - 1) & (Capacity - 1)];
+        if (Slot.Sequence.load(std::memory_order_acquire) != Ticket * 2)
+        {
+            continue;
+        }
+        for (int32 Index = 0; Index < EntryWords; ++Index)
+        {
+            Words[Index] = Slot.Words[Index].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // Overwritten while copying: drop it rather than report a torn entry
+        if (Slot.Sequence.load(std::memory_order_relaxed) == Ticket * 2)
+        {
+            FMCPTraceEntry Copy;
+            FMemory::Memcpy(&Copy, Words, sizeof(FMCPTraceEntry));
+            OutEntries.Add(Copy);
+        }
+    }
+}
+
+TSharedPtr<FJsonObject> FMCPTraceLog::BuildReport(int32 MaxEntries) const
+{
+    TArray<FMCPTraceEntry> Entries;
+    Snapshot(Entries, MaxEntries);
+
+    const double Now = FPlatformTime::Seconds();
+    TArray<TSharedPtr<FJsonValue>> EntriesJson;
+    EntriesJson.Reserve(Entries.Num());
+    for (const FMCPTraceEntry& Entry : Entries)
+    {
+        TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+        Json->SetStringField(TEXT("event"), Entry.Event == EMCPTraceEvent::Request ? TEXT("request") : TEXT("response"));
+        Json->SetNumberField(TEXT("age_ms"), (Now - Entry.Timestamp) * 1000.0);
+        Json->SetNumberField(TEXT("connection"), Entry.ConnectionId);
+        Json->SetStringField(TEXT("command"), UTF8_TO_TCHAR(Entry.Command));
+        if (Entry.RequestId[0] != '\0')
+        {
+            Json->SetStringField(TEXT("id"), UTF8_TO_TCHAR(Entry.RequestId));
+        }
+        Json->SetNumberField(TEXT("bytes"), Entry.PayloadBytes);
+        Json->SetStringField(TEXT("encoding"), GetEncodingName(Entry.Flags));
+        Json->SetBoolField(TEXT("compressed"), (Entry.Flags & MCPFraming::FlagCompressed) != 0);
+        if (Entry.Event == EMCPTraceEvent::Response)
+        {
+            Json->SetBoolField(TEXT("success"), Entry.bSuccess);
+            Json->SetNumberField(TEXT("execute_ms"), Entry.ExecuteMs);
+            Json->SetNumberField(TEXT("serialize_ms"), Entry.SerializeMs);
+            Json->SetNumberField(TEXT("send_ms"), Entry.SendMs);
+        }
+        EntriesJson.Add(MakeShared<FJsonValueObject>(Json));
+    }
+
+    TSharedPtr<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetNumberField(TEXT("recorded"), (double)NextTicket.load(std::memory_order_relaxed));
+    Report->SetNumberField(TEXT("capacity"), Capacity);
+    Report->SetArrayField(TEXT("entries"), EntriesJson);
+    return Report;
+}
+
+void FMCPTraceLog::DumpToLog(int32 MaxEntries) const
+{
+    TArray<FMCPTraceEntry> Entries;
+    Snapshot(Entries, MaxEntries);
+
+    const double Now = FPlatformTime::Seconds();
+    UE_LOG(LogMCPTraffic, Display, TEXT("Last %d of %llu MCP messages:"), Entries.Num(), NextTicket.load(std::memory_order_relaxed));
+    for (const FMCPTraceEntry& Entry : Entries)
+    {
+        if (Entry.Event == EMCPTraceEvent::Request)
+        {
+            UE_LOG(LogMCPTraffic, Display, TEXT("  -%8.1fms [%d] >>> %s id=%s %d bytes %s"),
+                (Now - Entry.Timestamp) * 1000.0, Entry.ConnectionId, UTF8_TO_TCHAR(Entry.Command), UTF8_TO_TCHAR(Entry.RequestId),
+                Entry.PayloadBytes, GetEncodingName(Entry.Flags));
+        }
+        else
+        {
+            UE_LOG(LogMCPTraffic, Display, TEXT("  -%8.1fms [%d] <<< %s id=%s %s %d bytes %s%s exec=%.1fms ser=%.1fms send=%.1fms"),
+                (Now - Entry.Timestamp) * 1000.0, Entry.ConnectionId, UTF8_TO_TCHAR(Entry.Command), UTF8_TO_TCHAR(Entry.RequestId),
+                Entry.bSuccess ? TEXT("OK") : TEXT("FAIL"), Entry.PayloadBytes, GetEncodingName(Entry.Flags),
+                (Entry.Flags & MCPFraming::FlagCompressed) ? TEXT("+zlib") : TEXT(""), Entry.ExecuteMs, Entry.SerializeMs, Entry.SendMs);
+        }
+    }
+}
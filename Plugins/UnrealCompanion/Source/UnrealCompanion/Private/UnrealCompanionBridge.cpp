@@ -1,5 +1,10 @@
 #include "UnrealCompanionBridge.h"
 #include "MCPServerRunnable.h"
+#include "MCPMetrics.h"
+#include "MCPTraceLog.h"
+#include "MCPBenchmark.h"
+#include "MCPSharedMemory.h"
+#include "UnrealCompanionStats.h"
 #include "Sockets.h"
 #include "SocketSubsystem.h"
 #include "HAL/RunnableThread.h"
@@ -11,8 +16,13 @@
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonWriter.h"
 #include "Async/Async.h"
+#include "RenderingThread.h"
 // Include command handlers
 #include "Commands/UnrealCompanionCommonUtils.h"
+#include "Commands/UnrealCompanionDeferredResponse.h"
+#include "Commands/UnrealCompanionPackageSaver.h"
+#include "Commands/UnrealCompanionNiagaraCompileQueue.h"
+#include "Commands/UnrealCompanionJobManager.h"
 #include "Commands/UnrealCompanionAssetCommands.h"
 #include "Commands/UnrealCompanionBlueprintCommands.h"
 #include "Commands/UnrealCompanionBlueprintNodeCommands.h"
@@ -33,7 +43,21 @@
 #include "Commands/UnrealCompanionSplineCommands.h"
 #include "Commands/UnrealCompanionEnvironmentCommands.h"
 #include "Commands/UnrealCompanionNiagaraCommands.h"
+#include "Commands/UnrealCompanionAssetIndex.h"
+#include "Commands/UnrealCompanionActorIndex.h"
+#include "Commands/UnrealCompanionNodeIndex.h"
+#include "Commands/UnrealCompanionEditorFocus.h"
+#include "Commands/UnrealCompanionBehaviorTreeCache.h"
+#include "Commands/UnrealCompanionHeightfieldCache.h"
+#include "Commands/UnrealCompanionResponseCache.h"
+#include "Commands/UnrealCompanionCompileSession.h"
+#include "Commands/UnrealCompanionScratch.h"
+#include "Commands/UnrealCompanionUndoPolicy.h"
+#include "Graph/GraphBatchValidation.h"
+#include "Graph/NodeCatalog.h"
+#include "Graph/NodeFactory/INodeFactory.h"
 #include "HAL/PlatformTime.h"
+#include "UnrealCompanionSettings.h"
 
 // Log category for MCP commands
 DEFINE_LOG_CATEGORY_STATIC(LogMCPBridge, Log, All);
@@ -43,29 +67,20 @@ DEFINE_LOG_CATEGORY_STATIC(LogMCPBridge, Log, All);
 #define MCP_SERVER_PORT 55557
 
 UUnrealCompanionBridge::UUnrealCompanionBridge()
+    // Groups whose commands need an editor module beyond the ones every session loads
+    : WidgetCommands({ TEXT("UMGEditor") })
+    , MaterialCommands({ TEXT("MaterialEditor") })
+    , LandscapeCommands({ TEXT("LandscapeEditor") })
+    , GeometryCommands({ TEXT("GeometryScriptingEditor") })
+    , NiagaraCommands({ TEXT("NiagaraEditor") })
 {
-    // Initialize all command handlers
-    AssetCommands = MakeShared<FUnrealCompanionAssetCommands>();
-    BlueprintCommands = MakeShared<FUnrealCompanionBlueprintCommands>();
-    NodeCommands = MakeShared<FUnrealCompanionBlueprintNodeCommands>();
-    GraphCommands = MakeShared<FUnrealCompanionGraphCommands>();
-    WidgetCommands = MakeShared<FUnrealCompanionUMGCommands>();
-    MaterialCommands = MakeShared<FUnrealCompanionMaterialCommands>();
-    WorldCommands = MakeShared<FUnrealCompanionWorldCommands>();
-    LevelCommands = MakeShared<FUnrealCompanionLevelCommands>();
-    LightCommands = MakeShared<FUnrealCompanionLightCommands>();
-    ViewportCommands = MakeShared<FUnrealCompanionViewportCommands>();
-    ProjectCommands = MakeShared<FUnrealCompanionProjectCommands>();
-    PythonCommands = MakeShared<FUnrealCompanionPythonCommands>();
-    ImportCommands = MakeShared<FUnrealCompanionImportCommands>();
-    LandscapeCommands = MakeShared<FUnrealCompanionLandscapeCommands>();
-    FoliageCommands = MakeShared<FUnrealCompanionFoliageCommands>();
-    GeometryCommands = MakeShared<FUnrealCompanionGeometryCommands>();
-    SplineCommands = MakeShared<FUnrealCompanionSplineCommands>();
-    EnvironmentCommands = MakeShared<FUnrealCompanionEnvironmentCommands>();
-    NiagaraCommands = MakeShared<FUnrealCompanionNiagaraCommands>();
-
-    // Build the command registry
+    // Capture sequences apply environment keyframes through the environment handler
+    ViewportCommands.OnCreated = [this](FUnrealCompanionViewportCommands& Viewport)
+    {
+        Viewport.SetEnvironmentCommands(EnvironmentCommands.Get());
+    };
+
+    // Build the command registry (no handler group exists until one of its commands runs)
     RegisterCommands();
 }
 
@@ -94,14 +109,22 @@ UUnrealCompanionBridge::~UUnrealCompanionBridge()
 
 void UUnrealCompanionBridge::RegisterCommands()
 {
+    // Registrations using WithParams<T>() are parsed and validated before they are queued
+    // (FUnrealCompanionParams); invalid requests come back as INVALID_PARAMS.
+    // Groups with a compile-time command table (GetCommandTable) are registered
+    // row by row with RegisterTable, each row bound straight to its handler method;
+    // typed params and affinity resolvers are then set on the rows that need them.
+    // The groups still on a HandleCommand lambda do work after the handler returns
+    // (editor focus, Content Browser sync) or are static.
+
     // ===========================================
     // ASSET COMMANDS (asset_*)
     // ===========================================
-    auto AssetHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return AssetCommands->HandleCommand(Cmd, P);
+    FCommandHandlerFunc AssetHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
+        return AssetCommands.Get()->HandleCommand(Cmd, P);
     };
     CommandRegistry.Add(TEXT("asset_create_folder"), AssetHandler);
-    CommandRegistry.Add(TEXT("asset_list"), AssetHandler);
+    CommandRegistry.Add(TEXT("asset_list"), FCommandRegistration(AssetHandler, EMCPThreadAffinity::AnyThread));
     CommandRegistry.Add(TEXT("asset_find"), AssetHandler);
     CommandRegistry.Add(TEXT("asset_delete"), AssetHandler);
     CommandRegistry.Add(TEXT("asset_rename"), AssetHandler);
@@ -109,18 +132,16 @@ void UUnrealCompanionBridge::RegisterCommands()
     CommandRegistry.Add(TEXT("asset_duplicate"), AssetHandler);
     CommandRegistry.Add(TEXT("asset_save"), AssetHandler);
     CommandRegistry.Add(TEXT("asset_save_all"), AssetHandler);
-    CommandRegistry.Add(TEXT("asset_exists"), AssetHandler);
-    CommandRegistry.Add(TEXT("asset_folder_exists"), AssetHandler);
-    CommandRegistry.Add(TEXT("asset_modify_batch"), AssetHandler);
-    CommandRegistry.Add(TEXT("asset_delete_batch"), AssetHandler);
-    CommandRegistry.Add(TEXT("asset_get_info"), AssetHandler);
-    CommandRegistry.Add(TEXT("asset_get_bounds"), AssetHandler);
+    CommandRegistry.Add(TEXT("asset_exists"), FCommandRegistration(AssetHandler, EMCPThreadAffinity::AnyThread));
+    CommandRegistry.Add(TEXT("asset_folder_exists"), FCommandRegistration(AssetHandler, EMCPThreadAffinity::AnyThread));
+    CommandRegistry.Add(TEXT("asset_modify_batch"), FCommandRegistration(AssetHandler).WithParams<FMCPStandardOnlyParams>());
+    CommandRegistry.Add(TEXT("asset_delete_batch"), FCommandRegistration(AssetHandler).WithParams<FMCPStandardOnlyParams>());
 
     // ===========================================
     // BLUEPRINT COMMANDS (blueprint_*)
     // ===========================================
-    auto BlueprintHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return BlueprintCommands->HandleCommand(Cmd, P);
+    FCommandHandlerFunc BlueprintHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
+        return BlueprintCommands.Get()->HandleCommand(Cmd, P);
     };
     CommandRegistry.Add(TEXT("blueprint_create"), BlueprintHandler);
     CommandRegistry.Add(TEXT("blueprint_create_interface"), BlueprintHandler);
@@ -133,80 +154,51 @@ void UUnrealCompanionBridge::RegisterCommands()
     CommandRegistry.Add(TEXT("blueprint_set_pawn_properties"), BlueprintHandler);
     CommandRegistry.Add(TEXT("blueprint_set_parent_class"), BlueprintHandler);
     CommandRegistry.Add(TEXT("blueprint_list_parent_classes"), BlueprintHandler);
-    CommandRegistry.Add(TEXT("blueprint_variable_batch"), BlueprintHandler);
-    CommandRegistry.Add(TEXT("blueprint_component_batch"), BlueprintHandler);
-    CommandRegistry.Add(TEXT("blueprint_function_batch"), BlueprintHandler);
+    CommandRegistry.Add(TEXT("blueprint_variable_batch"), FCommandRegistration(BlueprintHandler).WithParams<FMCPBlueprintVariableBatchParams>());
+    CommandRegistry.Add(TEXT("blueprint_component_batch"), FCommandRegistration(BlueprintHandler).WithParams<FMCPBlueprintComponentBatchParams>());
+    CommandRegistry.Add(TEXT("blueprint_function_batch"), FCommandRegistration(BlueprintHandler).WithParams<FMCPBlueprintFunctionBatchParams>());
 
     // ===========================================
     // GRAPH COMMANDS (graph_*)
     // ===========================================
-    auto GraphHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return GraphCommands->HandleCommand(Cmd, P);
+    RegisterTable(GraphCommands);
+    // Validated while parsing; a dry run is answered from that validation alone, off the game thread
+    FCommandRegistration& GraphBatch = CommandRegistry.FindChecked(TEXT("graph_batch"));
+    GraphBatch.AffinityResolver = [](const TSharedPtr<FJsonObject>& P)
+    {
+        bool bDryRun = false;
+        return P.IsValid() && P->TryGetBoolField(TEXT("dry_run"), bDryRun) && bDryRun
+            ? EMCPThreadAffinity::AnyThread : EMCPThreadAffinity::GameThread;
     };
-    CommandRegistry.Add(TEXT("graph_batch"), GraphHandler);
-    CommandRegistry.Add(TEXT("graph_node_create"), GraphHandler);
-    CommandRegistry.Add(TEXT("graph_node_delete"), GraphHandler);
-    CommandRegistry.Add(TEXT("graph_node_find"), GraphHandler);
-    CommandRegistry.Add(TEXT("graph_node_info"), GraphHandler);
-    CommandRegistry.Add(TEXT("graph_pin_connect"), GraphHandler);
-    CommandRegistry.Add(TEXT("graph_pin_disconnect"), GraphHandler);
-    CommandRegistry.Add(TEXT("graph_pin_set_value"), GraphHandler);
+    GraphBatch.WithParams<FMCPGraphBatchParams>();
+    CommandRegistry.FindChecked(TEXT("graph_node_find")).WithParams<FMCPGraphNodeFindParams>();
+    CommandRegistry.FindChecked(TEXT("graph_node_info")).WithParams<FMCPGraphNodeInfoParams>();
 
     // ===========================================
     // NODE COMMANDS (legacy - kept for backwards compatibility)
     // ===========================================
-    auto NodeHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return NodeCommands->HandleCommand(Cmd, P);
-    };
-    CommandRegistry.Add(TEXT("graph_node_search_available"), NodeHandler);
-    CommandRegistry.Add(TEXT("blueprint_add_variable"), NodeHandler);
-    CommandRegistry.Add(TEXT("blueprint_add_event_dispatcher"), NodeHandler);
-    CommandRegistry.Add(TEXT("blueprint_add_function"), NodeHandler);
-    CommandRegistry.Add(TEXT("blueprint_implement_interface"), NodeHandler);
-    CommandRegistry.Add(TEXT("blueprint_add_custom_event"), NodeHandler);
-    CommandRegistry.Add(TEXT("blueprint_set_variable_default"), NodeHandler);
-    CommandRegistry.Add(TEXT("blueprint_add_local_variable"), NodeHandler);
-    CommandRegistry.Add(TEXT("blueprint_get_info"), NodeHandler);
-    CommandRegistry.Add(TEXT("blueprint_remove_variable"), NodeHandler);
-    CommandRegistry.Add(TEXT("blueprint_remove_function"), NodeHandler);
-    CommandRegistry.Add(TEXT("blueprint_remove_component"), NodeHandler);
-    CommandRegistry.Add(TEXT("blueprint_get_compilation_messages"), NodeHandler);
+    RegisterTable(NodeCommands);
 
     // ===========================================
     // WIDGET COMMANDS (widget_*)
     // ===========================================
-    auto WidgetHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return WidgetCommands->HandleCommand(Cmd, P);
-    };
-    CommandRegistry.Add(TEXT("widget_create"), WidgetHandler);
-    CommandRegistry.Add(TEXT("widget_batch"), WidgetHandler);
-    CommandRegistry.Add(TEXT("widget_get_info"), WidgetHandler);
-    CommandRegistry.Add(TEXT("widget_add_to_viewport"), WidgetHandler);
-    CommandRegistry.Add(TEXT("widget_add_text_block"), WidgetHandler);
-    CommandRegistry.Add(TEXT("widget_add_button"), WidgetHandler);
-    CommandRegistry.Add(TEXT("widget_bind_event"), WidgetHandler);
-    CommandRegistry.Add(TEXT("widget_set_text_binding"), WidgetHandler);
+    RegisterTable(WidgetCommands);
 
     // ===========================================
     // MATERIAL COMMANDS (material_*)
     // ===========================================
-    auto MaterialHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return MaterialCommands->HandleCommand(Cmd, P);
-    };
-    CommandRegistry.Add(TEXT("material_create"), MaterialHandler);
-    CommandRegistry.Add(TEXT("material_create_instance"), MaterialHandler);
-    CommandRegistry.Add(TEXT("material_get_info"), MaterialHandler);
-    CommandRegistry.Add(TEXT("material_set_parameter"), MaterialHandler);
+    RegisterTable(MaterialCommands);
+    CommandRegistry.FindChecked(TEXT("material_instance_batch")).WithParams<FMCPStandardOnlyParams>();
 
     // ===========================================
     // WORLD COMMANDS (world_*)
     // ===========================================
-    auto WorldHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return WorldCommands->HandleCommand(Cmd, P);
+    FCommandHandlerFunc WorldHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
+        return WorldCommands.Get()->HandleCommand(Cmd, P);
     };
-    CommandRegistry.Add(TEXT("world_spawn_batch"), WorldHandler);
-    CommandRegistry.Add(TEXT("world_set_batch"), WorldHandler);
-    CommandRegistry.Add(TEXT("world_delete_batch"), WorldHandler);
+    CommandRegistry.Add(TEXT("world_spawn_batch"), FCommandRegistration(WorldHandler).WithParams<FMCPStandardOnlyParams>());
+    CommandRegistry.Add(TEXT("world_set_batch"), FCommandRegistration(WorldHandler).WithParams<FMCPStandardOnlyParams>());
+    CommandRegistry.Add(TEXT("world_delete_batch"), FCommandRegistration(WorldHandler).WithParams<FMCPStandardOnlyParams>());
     CommandRegistry.Add(TEXT("world_select_actors"), WorldHandler);
     CommandRegistry.Add(TEXT("world_get_selected_actors"), WorldHandler);
     CommandRegistry.Add(TEXT("world_duplicate_actor"), WorldHandler);
@@ -224,139 +216,121 @@ void UUnrealCompanionBridge::RegisterCommands()
     // ===========================================
     // LEVEL COMMANDS (level_*)
     // ===========================================
-    auto LevelHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return LevelCommands->HandleCommand(Cmd, P);
-    };
-    CommandRegistry.Add(TEXT("level_get_info"), LevelHandler);
-    CommandRegistry.Add(TEXT("level_open"), LevelHandler);
-    CommandRegistry.Add(TEXT("level_save"), LevelHandler);
-    CommandRegistry.Add(TEXT("level_create"), LevelHandler);
+    RegisterTable(LevelCommands);
 
     // ===========================================
     // LIGHT COMMANDS (light_*)
     // ===========================================
-    auto LightHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return LightCommands->HandleCommand(Cmd, P);
-    };
-    CommandRegistry.Add(TEXT("light_spawn"), LightHandler);
-    CommandRegistry.Add(TEXT("light_set_property"), LightHandler);
-    CommandRegistry.Add(TEXT("light_build"), LightHandler);
+    RegisterTable(LightCommands);
 
     // ===========================================
     // VIEWPORT COMMANDS (viewport_*, editor_*, play, console)
     // ===========================================
-    auto ViewportHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return ViewportCommands->HandleCommand(Cmd, P);
-    };
-    CommandRegistry.Add(TEXT("viewport_focus"), ViewportHandler);
-    CommandRegistry.Add(TEXT("viewport_screenshot"), ViewportHandler);
-    CommandRegistry.Add(TEXT("viewport_get_camera"), ViewportHandler);
-    CommandRegistry.Add(TEXT("viewport_set_camera"), ViewportHandler);
-    CommandRegistry.Add(TEXT("editor_play"), ViewportHandler);
-    CommandRegistry.Add(TEXT("play"), ViewportHandler);
-    CommandRegistry.Add(TEXT("editor_console"), ViewportHandler);
-    CommandRegistry.Add(TEXT("console"), ViewportHandler);
-    CommandRegistry.Add(TEXT("editor_undo"), ViewportHandler);
-    CommandRegistry.Add(TEXT("editor_redo"), ViewportHandler);
-    CommandRegistry.Add(TEXT("editor_focus_close"), ViewportHandler);
-    CommandRegistry.Add(TEXT("editor_focus_level"), ViewportHandler);
+    RegisterTable(ViewportCommands);
 
     // ===========================================
     // PROJECT COMMANDS (project_*)
     // ===========================================
-    auto ProjectHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return ProjectCommands->HandleCommand(Cmd, P);
-    };
-    CommandRegistry.Add(TEXT("project_create_input_mapping"), ProjectHandler);
-    CommandRegistry.Add(TEXT("project_create_input_action"), ProjectHandler);
-    CommandRegistry.Add(TEXT("project_add_to_mapping_context"), ProjectHandler);
+    RegisterTable(ProjectCommands);
 
     // ===========================================
     // PYTHON COMMANDS (python_*)
     // ===========================================
-    auto PythonHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return PythonCommands->HandleCommand(Cmd, P);
-    };
-    CommandRegistry.Add(TEXT("python_execute"), PythonHandler);
-    CommandRegistry.Add(TEXT("python_execute_file"), PythonHandler);
-    CommandRegistry.Add(TEXT("python_list_modules"), PythonHandler);
+    RegisterTable(PythonCommands);
 
     // ===========================================
     // CORE COMMANDS (core_*) — static handler
     // ===========================================
-    auto QueryHandler = [](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
+    FCommandHandlerFunc QueryHandler = [](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
         return FUnrealCompanionQueryCommands::HandleCommand(Cmd, P);
     };
-    CommandRegistry.Add(TEXT("core_query"), QueryHandler);
+    // Asset and folder queries only read the AssetRegistry → safe on a worker thread,
+    // unless the caller opted into loading the matched assets
+    CommandRegistry.Add(TEXT("core_query"), FCommandRegistration(QueryHandler, EMCPThreadAffinity::GameThread,
+        [](const TSharedPtr<FJsonObject>& P)
+        {
+            FString Type;
+            bool bLoad = false;
+            if (P.IsValid() && P->TryGetStringField(TEXT("type"), Type) && (Type == TEXT("asset") || Type == TEXT("folder"))
+                && !(P->TryGetBoolField(TEXT("load"), bLoad) && bLoad))
+            {
+                return EMCPThreadAffinity::AnyThread;
+            }
+            return EMCPThreadAffinity::GameThread;
+        }));
     CommandRegistry.Add(TEXT("core_get_info"), QueryHandler);
+    CommandRegistry.Add(TEXT("asset_get_info"), QueryHandler);
+    CommandRegistry.Add(TEXT("asset_get_bounds"), QueryHandler);
     CommandRegistry.Add(TEXT("core_save"), QueryHandler);
+    CommandRegistry.Add(TEXT("core_session"), QueryHandler);
 
     // ===========================================
     // IMPORT COMMANDS (asset_import*)
     // ===========================================
-    auto ImportHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return ImportCommands->HandleCommand(Cmd, P);
-    };
-    CommandRegistry.Add(TEXT("asset_import"), ImportHandler);
-    CommandRegistry.Add(TEXT("asset_import_batch"), ImportHandler);
-    CommandRegistry.Add(TEXT("asset_get_supported_formats"), ImportHandler);
+    RegisterTable(ImportCommands);
 
     // ===========================================
     // LANDSCAPE COMMANDS (landscape_*)
     // ===========================================
-    auto LandscapeHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return LandscapeCommands->HandleCommand(Cmd, P);
-    };
-    CommandRegistry.Add(TEXT("landscape_create"), LandscapeHandler);
-    CommandRegistry.Add(TEXT("landscape_sculpt"), LandscapeHandler);
-    CommandRegistry.Add(TEXT("landscape_import_heightmap"), LandscapeHandler);
-    CommandRegistry.Add(TEXT("landscape_paint_layer"), LandscapeHandler);
+    RegisterTable(LandscapeCommands);
 
     // ===========================================
     // FOLIAGE COMMANDS (foliage_*)
     // ===========================================
-    auto FoliageHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return FoliageCommands->HandleCommand(Cmd, P);
-    };
-    CommandRegistry.Add(TEXT("foliage_add_type"), FoliageHandler);
-    CommandRegistry.Add(TEXT("foliage_scatter"), FoliageHandler);
-    CommandRegistry.Add(TEXT("foliage_remove"), FoliageHandler);
+    RegisterTable(FoliageCommands);
 
     // ===========================================
     // GEOMETRY COMMANDS (geometry_*)
     // ===========================================
-    auto GeometryHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return GeometryCommands->HandleCommand(Cmd, P);
-    };
-    CommandRegistry.Add(TEXT("geometry_create"), GeometryHandler);
-    CommandRegistry.Add(TEXT("geometry_boolean"), GeometryHandler);
+    RegisterTable(GeometryCommands);
 
     // ===========================================
     // SPLINE COMMANDS (spline_*)
     // ===========================================
-    auto SplineHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return SplineCommands->HandleCommand(Cmd, P);
-    };
-    CommandRegistry.Add(TEXT("spline_create"), SplineHandler);
-    CommandRegistry.Add(TEXT("spline_scatter_meshes"), SplineHandler);
+    RegisterTable(SplineCommands);
 
     // ===========================================
     // ENVIRONMENT COMMANDS (environment_*)
     // ===========================================
-    auto EnvironmentHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return EnvironmentCommands->HandleCommand(Cmd, P);
-    };
-    CommandRegistry.Add(TEXT("environment_configure"), EnvironmentHandler);
+    RegisterTable(EnvironmentCommands);
 
     // ===========================================
     // NIAGARA COMMANDS (niagara_*)
     // ===========================================
-    auto NiagaraHandler = [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
-        return NiagaraCommands->HandleCommand(Cmd, P);
-    };
-    CommandRegistry.Add(TEXT("niagara_emitter_batch"), NiagaraHandler);
-    CommandRegistry.Add(TEXT("niagara_param_batch"), NiagaraHandler);
-    CommandRegistry.Add(TEXT("niagara_spawn"), NiagaraHandler);
+    RegisterTable(NiagaraCommands);
+
+    // ===========================================
+    // JOB COMMANDS (job_*) — long-running commands started elsewhere
+    // ===========================================
+    RegisterTable(FUnrealCompanionJobManager::Get());
+
+    // ===========================================
+    // BRIDGE COMMANDS (bridge_*)
+    // ===========================================
+    // These only read FMCPMetrics, FMCPTraceLog and an atomic: answer from a worker so a busy queue can still be inspected
+    CommandRegistry.Add(TEXT("bridge_metrics"), FCommandRegistration([this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
+        return HandleBridgeMetrics(P);
+    }, EMCPThreadAffinity::AnyThread));
+    CommandRegistry.Add(TEXT("bridge_trace"), FCommandRegistration([this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
+        return HandleBridgeTrace(P);
+    }, EMCPThreadAffinity::AnyThread));
+    // Only reads the registry, which is read-only once built
+    CommandRegistry.Add(TEXT("bridge_schema"), FCommandRegistration([this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
+        return HandleBridgeSchema(P);
+    }, EMCPThreadAffinity::AnyThread));
+    // Replays its mix through EnqueueCommand and replies when the last request finishes
+    CommandRegistry.Add(TEXT("bridge_benchmark"), FCommandRegistration([this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
+        return HandleBridgeBenchmark(P);
+    }, EMCPThreadAffinity::AnyThread));
+    CommandRegistry.Add(TEXT("bridge_shutdown"), [this](const FString& Cmd, const TSharedPtr<FJsonObject>& P) {
+        return HandleBridgeShutdown(P);
+    });
+
+    // Scheduling class is fixed per command: decided here, not per request
+    for (TPair<FString, FCommandRegistration>& Pair : CommandRegistry)
+    {
+        Pair.Value.Priority = GetCommandPriority(Pair.Key);
+    }
 
     UE_LOG(LogMCPBridge, Display, TEXT("Command registry initialized: %d commands registered"), CommandRegistry.Num());
 }
@@ -373,6 +347,23 @@ void UUnrealCompanionBridge::Initialize(FSubsystemCollectionBase& Collection)
     Port = MCP_SERVER_PORT;
     FIPv4Address::Parse(MCP_SERVER_HOST, ServerAddress);
 
+    // Parallel CI jobs on one host each pick their own port
+    FParse::Value(FCommandLine::Get(), TEXT("UnrealCompanionPort="), Port);
+
+    // Drain the command queue once per editor tick
+    CommandQueueTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateUObject(this, &UUnrealCompanionBridge::TickCommandQueue));
+
+    // Name/path lookups are served from a persistent index kept current by AssetRegistry events
+    FUnrealCompanionAssetIndex::Get().Initialize();
+    FUnrealCompanionActorIndex::Get().Initialize();
+    FNodeCatalog::Get().Initialize();
+    FUnrealCompanionResponseCache::Get().Initialize();
+
+    // Read by graph_batch validation on connection threads, so set up before the server starts
+    FNodeFactoryRegistry::Get().RegisterBuiltInFactories();
+    FPinSignatureCache::Get().Initialize();
+
     // Start the server automatically
     StartServer();
 }
@@ -381,7 +372,52 @@ void UUnrealCompanionBridge::Initialize(FSubsystemCollectionBase& Collection)
 void UUnrealCompanionBridge::Deinitialize()
 {
     UE_LOG(LogTemp, Display, TEXT("UnrealCompanionBridge: Shutting down"));
+
+    // Headless saves only happen on core_save; say so rather than write files during shutdown
+    if (const int32 DeferredSaves = FUnrealCompanionEditorFocus::Get().GetDeferredSaveCount())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UnrealCompanionBridge: %d deferred save(s) were never flushed (core_save scope='deferred')"), DeferredSaves);
+    }
+
+    // Finish a time-sliced save before the connections go away: its files must not be lost
+    FUnrealCompanionPackageSaver::Get().Shutdown();
+    FUnrealCompanionJobManager::Get().Shutdown();
+    FUnrealCompanionNiagaraCompileQueue::Get().Shutdown();
+    if (TSharedPtr<FUnrealCompanionUMGCommands> Widgets = WidgetCommands.GetIfCreated())
+    {
+        Widgets->Shutdown();
+    }
+    if (TSharedPtr<FUnrealCompanionGeometryCommands> Geometry = GeometryCommands.GetIfCreated())
+    {
+        Geometry->Shutdown();
+    }
+
     StopServer();
+
+    if (CommandQueueTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(CommandQueueTickerHandle);
+        CommandQueueTickerHandle.Reset();
+    }
+
+    // A client that disconnected mid-session would otherwise leave it open forever;
+    // the touched Blueprints stay dirty and compile on next use
+    if (FUnrealCompanionCompileSession::Get().IsActive())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UnrealCompanionBridge: Aborting open compile session"));
+        FUnrealCompanionCompileSession::Get().Abort();
+    }
+    FUnrealCompanionUndoPolicy::Get().EndSession(nullptr);
+
+    FUnrealCompanionAssetIndex::Get().Shutdown();
+    FUnrealCompanionActorIndex::Get().Shutdown();
+    FUnrealCompanionNodeIndex::Get().Shutdown();
+    FUnrealCompanionBehaviorTreeCache::Get().Shutdown();
+    FUnrealCompanionHeightfieldCache::Get().Shutdown();
+    FUnrealCompanionResponseCache::Get().Shutdown();
+    FPinSignatureCache::Get().Shutdown();
+    FNodeCatalog::Get().Shutdown();
+    FMCPSharedMemory::Get().Shutdown();
 }
 
 // Start the MCP server
@@ -430,6 +466,8 @@ void UUnrealCompanionBridge::StartServer()
 
     ListenerSocket = NewListenerSocket;
     bIsRunning = true;
+    bAcceptingCommands = true;
+    LastActivityTime = FPlatformTime::Seconds();
     UE_LOG(LogTemp, Display, TEXT("UnrealCompanionBridge: Server started on %s:%d"), *ServerAddress.ToString(), Port);
 
     // Start server thread
@@ -457,6 +495,11 @@ void UUnrealCompanionBridge::StopServer()
 
     bIsRunning = false;
 
+    // Release any connection thread blocked on a queued or deferred command before joining the threads
+    bAcceptingCommands = false;
+    FailPendingCommands(TEXT("Bridge is shutting down"));
+    FailDeferredReplies(TEXT("Bridge is shutting down"));
+
     // Clean up thread
     if (ServerThread)
     {
@@ -482,127 +525,648 @@ void UUnrealCompanionBridge::StopServer()
 }
 
 // Execute a command received from a client
-FString UUnrealCompanionBridge::ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+FMCPResponse UUnrealCompanionBridge::ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-    UE_LOG(LogMCPBridge, Display, TEXT(">>> MCP Command: %s"), *CommandType);
-    
+    // Already on the game thread: there is nothing to wait for
+    // (thread-affinity is ignored here, the game thread can run every command)
+    if (IsInGameThread())
+    {
+        return ExecuteCommandNow(CommandType, Params, nullptr);
+    }
+
     // Create a promise to wait for the result
-    TPromise<FString> Promise;
-    TFuture<FString> Future = Promise.GetFuture();
-    
-    // Queue execution on Game Thread
-    AsyncTask(ENamedThreads::GameThread, [this, CommandType, Params, Promise = MoveTemp(Promise)]() mutable
+    TSharedRef<TPromise<FMCPResponse>> Promise = MakeShared<TPromise<FMCPResponse>>();
+    TFuture<FMCPResponse> Future = Promise->GetFuture();
+
+    EnqueueCommand(CommandType, Params, nullptr, [Promise](const FMCPResponse& Response)
+    {
+        Promise->SetValue(Response);
+    });
+
+    // Wait in slices: a stopping server must release this thread even for work nothing fails
+    // on its behalf (an AnyThread command still running), or joining the connection deadlocks
+    const float TimeoutSeconds = GetDefault<UUnrealCompanionSettings>()->CommandTimeoutSeconds;
+    const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+    while (!Future.WaitFor(FTimespan::FromMilliseconds(250)))
+    {
+        if (!bAcceptingCommands)
+        {
+            return BuildErrorResponse(TEXT("BRIDGE_SHUTTING_DOWN"), TEXT("Bridge is shutting down"), nullptr);
+        }
+        if (FPlatformTime::Seconds() >= Deadline)
+        {
+            UE_LOG(LogMCPBridge, Warning, TEXT("<<< MCP TIMEOUT: %s (%.0f s)"), *CommandType, TimeoutSeconds);
+            return BuildErrorResponse(TEXT("COMMAND_TIMEOUT"),
+                FString::Printf(TEXT("%s did not finish within %.0f s"), *CommandType, TimeoutSeconds), nullptr);
+        }
+    }
+    return Future.Get();
+}
+
+void UUnrealCompanionBridge::EnqueueCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params,
+    const TSharedPtr<FJsonValue>& RequestId, FCommandCompletionFunc OnComplete, FCommandCompletionFunc OnEvent)
+{
+    if (!bAcceptingCommands)
+    {
+        FMCPMetrics::Get().RecordRejection(CommandType);
+        OnComplete(BuildErrorResponse(TEXT("BRIDGE_SHUTTING_DOWN"), TEXT("Bridge is shutting down"), RequestId));
+        return;
+    }
+    LastActivityTime = FPlatformTime::Seconds();
+
+    const FCommandRegistration* Registration = CommandRegistry.Find(CommandType);
+
+    // Typed commands are parsed here, on the caller's thread: invalid requests never reach a queue
+    TSharedPtr<const FMCPTypedParams> TypedParams;
+    FString ParamError;
+    if (!ParseTypedParams(CommandType, Registration, Params, TypedParams, ParamError))
+    {
+        FMCPMetrics::Get().RecordRejection(CommandType);
+        OnComplete(BuildErrorResponse(TEXT("INVALID_PARAMS"), ParamError, RequestId));
+        return;
+    }
+
+    // Repeated reads of unchanged assets are answered here. Only with nothing pending on the
+    // game thread: a write queued ahead of the read must be seen by it.
+    if (PendingGameThreadCommands.load() == 0 && FUnrealCompanionResponseCache::IsCacheable(CommandType, Params))
+    {
+        if (TSharedPtr<FJsonObject> Cached = FUnrealCompanionResponseCache::Get().Find(CommandType, Params))
+        {
+            OnComplete(FinalizeResponse(CommandType, Cached, RequestId, FPlatformTime::Seconds()));
+            return;
+        }
+    }
+
+    // Thread-safe commands skip the game-thread queue, under the same condition as the cache:
+    // a write still queued or running must be seen by a read sent after it
+    EMCPCommandPriority Priority = Registration ? Registration->Priority : GetCommandPriority(CommandType);
+    const EMCPThreadAffinity Affinity = Registration ? Registration->ResolveAffinity(Params) : EMCPThreadAffinity::GameThread;
+    if (Affinity == EMCPThreadAffinity::AnyThread && PendingGameThreadCommands.load() == 0)
+    {
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, CommandType, Registration, Params, TypedParams, RequestId, OnComplete = MoveTemp(OnComplete), OnEvent = MoveTemp(OnEvent)]() mutable
+        {
+            RunCommand(CommandType, Registration, Params, TypedParams, RequestId, MoveTemp(OnComplete), MoveTemp(OnEvent));
+        });
+        return;
+    }
+    if (Affinity == EMCPThreadAffinity::AnyThread)
+    {
+        // Queued behind the pending writes instead: the lowest class is drained last, in arrival
+        // order, so the read runs after everything queued before it
+        Priority = EMCPCommandPriority::Low;
+    }
+    else if (Affinity == EMCPThreadAffinity::RenderThread)
+    {
+        ENQUEUE_RENDER_COMMAND(UnrealCompanionCommand)([this, CommandType, Registration, Params, TypedParams, RequestId, OnComplete = MoveTemp(OnComplete), OnEvent = MoveTemp(OnEvent)](FRHICommandListImmediate&) mutable
+        {
+            RunCommand(CommandType, Registration, Params, TypedParams, RequestId, MoveTemp(OnComplete), MoveTemp(OnEvent));
+        });
+        return;
+    }
+
+    // Back-pressure: tell the client to slow down instead of growing the queue without bound
+    const int32 MaxQueueDepth = GetDefault<UUnrealCompanionSettings>()->MaxQueueDepth;
+    const int32 Depth = QueuedCommandCount.load();
+    if (Depth >= MaxQueueDepth)
+    {
+        FMCPMetrics::Get().RecordRejection(CommandType);
+        OnComplete(BuildErrorResponse(TEXT("BRIDGE_BUSY"),
+            FString::Printf(TEXT("Command queue is full (%d pending). Retry later."), Depth),
+            RequestId, Depth));
+        return;
+    }
+
+    FMCPQueuedCommand Queued;
+    Queued.CommandType = CommandType;
+    Queued.Registration = Registration;
+    Queued.Params = Params;
+    Queued.TypedParams = MoveTemp(TypedParams);
+    Queued.RequestId = RequestId;
+    Queued.Priority = Priority;
+    Queued.EnqueueTime = FPlatformTime::Seconds();
+    Queued.OnComplete = MoveTemp(OnComplete);
+    Queued.OnEvent = MoveTemp(OnEvent);
+
+    const int32 QueueIndex = (int32)Queued.Priority;
+    {
+        // The check at the top can pass just before StopServer drains the queue
+        FScopeLock Lock(&EnqueueLock);
+        if (bAcceptingCommands)
+        {
+            ++QueuedCommandCount;
+            ++PendingGameThreadCommands;
+            CommandQueues[QueueIndex].Enqueue(MoveTemp(Queued));
+            return;
+        }
+    }
+    FMCPMetrics::Get().RecordRejection(CommandType);
+    Queued.OnComplete(BuildErrorResponse(TEXT("BRIDGE_SHUTTING_DOWN"), TEXT("Bridge is shutting down"), RequestId));
+}
+
+bool UUnrealCompanionBridge::DequeueNextCommand(FMCPQueuedCommand& OutCommand)
+{
+    for (int32 QueueIndex = 0; QueueIndex < (int32)EMCPCommandPriority::Count; ++QueueIndex)
+    {
+        if (CommandQueues[QueueIndex].Dequeue(OutCommand))
+        {
+            --QueuedCommandCount;
+            return true;
+        }
+    }
+    return false;
+}
+
+EMCPCommandPriority UUnrealCompanionBridge::GetCommandPriority(const FString& CommandType)
+{
+    static const TSet<FString> CheapCommands = {
+        TEXT("ping"),
+        TEXT("core_get_info"),
+        TEXT("core_query"),
+        TEXT("asset_exists"),
+        TEXT("asset_folder_exists"),
+        TEXT("asset_get_info"),
+        TEXT("asset_get_bounds"),
+        TEXT("graph_node_find"),
+        TEXT("graph_node_info"),
+        TEXT("viewport_get_camera"),
+        TEXT("world_get_selected_actors"),
+        TEXT("blueprint_get_compilation_messages"),
+        TEXT("asset_get_supported_formats"),
+        TEXT("job_status"),
+        TEXT("job_list"),
+        TEXT("job_cancel"),
+    };
+    static const TSet<FString> HeavyCommands = {
+        TEXT("landscape_create"),
+        TEXT("landscape_sculpt"),
+        TEXT("landscape_import_heightmap"),
+        TEXT("landscape_paint_layer"),
+        TEXT("blueprint_compile"),
+        TEXT("light_build"),
+        TEXT("asset_import"),
+        TEXT("asset_import_batch"),
+        TEXT("asset_save_all"),
+        TEXT("core_save"),
+        TEXT("level_save"),
+        TEXT("foliage_scatter"),
+        TEXT("foliage_export"),
+        TEXT("foliage_import"),
+        TEXT("geometry_boolean"),
+        TEXT("geometry_pipeline"),
+    };
+
+    if (CheapCommands.Contains(CommandType))
+    {
+        return EMCPCommandPriority::High;
+    }
+    if (HeavyCommands.Contains(CommandType))
+    {
+        return EMCPCommandPriority::Low;
+    }
+    return EMCPCommandPriority::Normal;
+}
+
+FMCPResponse UUnrealCompanionBridge::BuildErrorResponse(const FString& ErrorCode, const FString& Message,
+    const TSharedPtr<FJsonValue>& RequestId, int32 QueueDepth)
+{
+    return FMCPResponse::MakeError(Message, ErrorCode, RequestId, QueueDepth);
+}
+
+bool UUnrealCompanionBridge::TickCommandQueue(float DeltaTime)
+{
+    const UUnrealCompanionSettings* Settings = GetDefault<UUnrealCompanionSettings>();
+    const double BudgetSeconds = Settings->GameThreadBudgetMs / 1000.0;
+    const double TickStart = FPlatformTime::Seconds();
+
+    // Run commands until the frame budget is spent. The first command always runs,
+    // otherwise a command longer than the budget would never execute.
+    FMCPQueuedCommand Queued;
+    int32 Executed = 0;
+    while (Executed < Settings->MaxCommandsPerTick)
+    {
+        if (Executed > 0 && FPlatformTime::Seconds() - TickStart >= BudgetSeconds)
+        {
+            break;
+        }
+        if (!DequeueNextCommand(Queued))
+        {
+            break;
+        }
+
+        FMCPMetrics::Get().RecordPhase(Queued.CommandType, EMCPMetricPhase::QueueWait, FPlatformTime::Seconds() - Queued.EnqueueTime);
+        RunCommand(Queued.CommandType, Queued.Registration, Queued.Params, Queued.TypedParams, Queued.RequestId, MoveTemp(Queued.OnComplete), MoveTemp(Queued.OnEvent));
+        --PendingGameThreadCommands;
+        ++Executed;
+    }
+
+    INC_DWORD_STAT_BY(STAT_UnrealCompanion_CommandsExecuted, Executed);
+    SET_DWORD_STAT(STAT_UnrealCompanion_QueueDepth, QueuedCommandCount.load());
+    return true;
+}
+
+void UUnrealCompanionBridge::FailPendingCommands(const FString& Reason)
+{
+    // Take the queue under the lock EnqueueCommand queues under, answer outside it
+    // (a completion may enqueue a socket write or re-enter the bridge)
+    TArray<FMCPQueuedCommand> Drained;
+    {
+        FScopeLock Lock(&EnqueueLock);
+        FMCPQueuedCommand Queued;
+        while (DequeueNextCommand(Queued))
+        {
+            --PendingGameThreadCommands;
+            Drained.Add(MoveTemp(Queued));
+        }
+    }
+
+    for (FMCPQueuedCommand& Queued : Drained)
     {
-        double StartTime = FPlatformTime::Seconds();
-        TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
-        
-        try
+        if (Queued.OnComplete)
         {
-            TSharedPtr<FJsonObject> ResultJson;
-            
-            // Ping command (special case — no handler needed)
-            if (CommandType == TEXT("ping"))
+            Queued.OnComplete(BuildErrorResponse(TEXT("BRIDGE_SHUTTING_DOWN"), Reason, Queued.RequestId));
+        }
+    }
+}
+
+void UUnrealCompanionBridge::FailDeferredReplies(const FString& Reason)
+{
+    TArray<TWeakPtr<FMCPPendingReply, ESPMode::ThreadSafe>> Outstanding;
+    {
+        FScopeLock Lock(&DeferredRepliesLock);
+        Outstanding = MoveTemp(DeferredReplies);
+        DeferredReplies.Reset();
+    }
+
+    // The handlers' own completions still fire later (a capture finishing its frame); Complete drops them
+    for (const TWeakPtr<FMCPPendingReply, ESPMode::ThreadSafe>& WeakReply : Outstanding)
+    {
+        TSharedPtr<FMCPPendingReply, ESPMode::ThreadSafe> Reply = WeakReply.Pin();
+        if (Reply.IsValid() && Reply->Complete(BuildErrorResponse(TEXT("BRIDGE_SHUTTING_DOWN"), Reason, Reply->RequestId)))
+        {
+            UE_LOG(LogMCPBridge, Display, TEXT("<<< MCP deferred reply failed on shutdown: %s"), *Reply->CommandType);
+        }
+    }
+}
+
+FMCPResponse UUnrealCompanionBridge::ExecuteCommandNow(const FString& CommandType, const TSharedPtr<FJsonObject>& Params,
+    const TSharedPtr<FJsonValue>& RequestId)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    const FCommandRegistration* Registration = CommandRegistry.Find(CommandType);
+    TSharedPtr<const FMCPTypedParams> TypedParams;
+    FString ParamError;
+    if (!ParseTypedParams(CommandType, Registration, Params, TypedParams, ParamError))
+    {
+        FMCPMetrics::Get().RecordRejection(CommandType);
+        return BuildErrorResponse(TEXT("INVALID_PARAMS"), ParamError, RequestId);
+    }
+    return FinalizeResponse(CommandType, InvokeHandler(CommandType, Registration, Params, TypedParams), RequestId, StartTime);
+}
+
+bool UUnrealCompanionBridge::ParseTypedParams(const FString& CommandType, const FCommandRegistration* Registration,
+    const TSharedPtr<FJsonObject>& Params, TSharedPtr<const FMCPTypedParams>& OutTypedParams, FString& OutError)
+{
+    if (!Registration || !Registration->ParamParser)
+    {
+        return true;
+    }
+
+    OutTypedParams = Registration->ParamParser(Params, OutError);
+    if (!OutTypedParams.IsValid())
+    {
+        UE_LOG(LogMCPBridge, Warning, TEXT("<<< MCP INVALID: %s - %s"), *CommandType, *OutError);
+        return false;
+    }
+    return true;
+}
+
+void UUnrealCompanionBridge::RunCommand(const FString& CommandType, const FCommandRegistration* Registration, const TSharedPtr<FJsonObject>& Params,
+    const TSharedPtr<const FMCPTypedParams>& TypedParams, const TSharedPtr<FJsonValue>& RequestId,
+    FCommandCompletionFunc OnComplete, FCommandCompletionFunc OnEvent)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    // A handler that defers its reply completes through this callback, possibly from another thread,
+    // after the bridge itself has moved on. FinalizeResponse is static, so nothing here needs the bridge.
+    TSharedRef<FMCPPendingReply, ESPMode::ThreadSafe> Reply = MakeShared<FMCPPendingReply, ESPMode::ThreadSafe>(MoveTemp(OnComplete));
+    Reply->CommandType = CommandType;
+    Reply->RequestId = RequestId;
+    // Events outlive the handler too (a job reports until it finishes)
+    FUnrealCompanionDeferredResponse::FEventSink EventSink;
+    if (OnEvent)
+    {
+        TSharedRef<FCommandCompletionFunc, ESPMode::ThreadSafe> SharedEvent = MakeShared<FCommandCompletionFunc, ESPMode::ThreadSafe>(MoveTemp(OnEvent));
+        EventSink = [CommandType, RequestId, SharedEvent](const FString& Event, const TSharedPtr<FJsonObject>& Payload)
+        {
+            FMCPResponse EventResponse;
+            EventResponse.bSuccess = true;
+            EventResponse.Event = Event;
+            EventResponse.Result = Payload;
+            EventResponse.RequestId = RequestId;
+            EventResponse.CommandType = CommandType;
+            (*SharedEvent)(EventResponse);
+        };
+    }
+
+    FUnrealCompanionDeferredResponse::FScope DeferScope([CommandType, RequestId, StartTime, Reply](const TSharedPtr<FJsonObject>& ResultJson)
+    {
+        if (!Reply->IsCompleted())
+        {
+            Reply->Complete(FinalizeResponse(CommandType, ResultJson, RequestId, StartTime));
+        }
+    }, MoveTemp(EventSink));
+
+    const bool bCacheable = IsInGameThread() && FUnrealCompanionResponseCache::IsCacheable(CommandType, Params);
+    const uint64 CacheGeneration = bCacheable ? FUnrealCompanionResponseCache::Get().GetGeneration() : 0;
+
+    TSharedPtr<FJsonObject> ResultJson = InvokeHandler(CommandType, Registration, Params, TypedParams);
+    if (DeferScope.WasDeferred())
+    {
+        UE_LOG(LogMCPBridge, Verbose, TEXT("<<< MCP deferred: %s"), *CommandType);
+        // Tracked so shutdown can answer it; checked under the lock FailDeferredReplies takes,
+        // so a reply deferred while the server stops is answered here instead
+        bool bRegistered = false;
+        {
+            FScopeLock Lock(&DeferredRepliesLock);
+            if (bAcceptingCommands)
             {
-                ResultJson = MakeShareable(new FJsonObject);
-                ResultJson->SetStringField(TEXT("message"), TEXT("pong"));
-                ResultJson->SetBoolField(TEXT("success"), true);
+                DeferredReplies.RemoveAllSwap([](const TWeakPtr<FMCPPendingReply, ESPMode::ThreadSafe>& WeakReply)
+                {
+                    const TSharedPtr<FMCPPendingReply, ESPMode::ThreadSafe> Pending = WeakReply.Pin();
+                    return !Pending.IsValid() || Pending->IsCompleted();
+                });
+                DeferredReplies.Add(Reply);
+                bRegistered = true;
             }
-            else
+        }
+        if (!bRegistered)
+        {
+            Reply->Complete(BuildErrorResponse(TEXT("BRIDGE_SHUTTING_DOWN"), TEXT("Bridge is shutting down"), RequestId));
+        }
+        return;
+    }
+
+    const FMCPResponse Response = FinalizeResponse(CommandType, ResultJson, RequestId, StartTime);
+    if (bCacheable && Response.bSuccess)
+    {
+        FUnrealCompanionResponseCache::Get().Store(CommandType, Params, Response.Result, CacheGeneration);
+    }
+    Reply->Complete(Response);
+}
+
+TSharedPtr<FJsonObject> UUnrealCompanionBridge::InvokeHandler(const FString& CommandType, const FCommandRegistration* Registration,
+    const TSharedPtr<FJsonObject>& Params, const TSharedPtr<const FMCPTypedParams>& TypedParams)
+{
+    UE_LOG(LogMCPBridge, Verbose, TEXT(">>> MCP Command: %s"), *CommandType);
+
+    TSharedPtr<FJsonObject> ResultJson;
+    try
+    {
+        // Ping command (special case — no handler needed)
+        if (CommandType == TEXT("ping"))
+        {
+            ResultJson = MakeShareable(new FJsonObject);
+            ResultJson->SetStringField(TEXT("message"), TEXT("pong"));
+            ResultJson->SetBoolField(TEXT("success"), true);
+        }
+        else
+        {
+            // Resolved once when the request arrived
+            if (Registration)
             {
-                // Registry lookup
-                FCommandHandlerFunc* Handler = CommandRegistry.Find(CommandType);
-                if (Handler)
+                UNREALCOMPANION_SCOPE_CYCLE_COUNTER(STAT_UnrealCompanion_Dispatch);
+                UNREALCOMPANION_TRACE_SCOPE_TEXT(*CommandType);
+                FUnrealCompanionParams::FScope ParamScope(TypedParams, Registration->ParamSchemaKey);
+                // Handler locals built on scratch allocators are released here, all at once
+                FUnrealCompanionScratch::FScope ScratchScope;
+                // One editor transaction per top-level command, sized against the undo budget
+                FUnrealCompanionUndoPolicy::FScope UndoScope(CommandType, Params);
+                if (!UndoScope.GetError().IsEmpty())
                 {
-                    ResultJson = (*Handler)(CommandType, Params);
+                    ResultJson = FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(TEXT("INVALID_PARAMS"), UndoScope.GetError());
                 }
                 else
                 {
-                    ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                    ResponseJson->SetStringField(TEXT("error"), FString::Printf(
-                        TEXT("Unknown command: %s. %d commands registered."),
-                        *CommandType, CommandRegistry.Num()));
-
-                    FString ResultString;
-                    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-                    FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-                    Promise.SetValue(ResultString);
-                    return;
+                    ResultJson = Registration->Handler(CommandType, Params);
+                    UndoScope.Finish(ResultJson);
                 }
             }
-            
-            // Check if the result contains an error
-            bool bSuccess = true;
-            FString ErrorMessage;
-            
-            if (!ResultJson.IsValid())
+            else
             {
-                bSuccess = false;
-                ErrorMessage = TEXT("Command returned null result");
+                ResultJson = MakeShareable(new FJsonObject);
+                ResultJson->SetBoolField(TEXT("success"), false);
+                ResultJson->SetStringField(TEXT("error"), FString::Printf(
+                    TEXT("Unknown command: %s. %d commands registered."),
+                    *CommandType, CommandRegistry.Num()));
             }
-            else if (ResultJson->HasField(TEXT("success")))
+        }
+    }
+    catch (const std::exception& e)
+    {
+        ResultJson = MakeShareable(new FJsonObject);
+        ResultJson->SetBoolField(TEXT("success"), false);
+        ResultJson->SetStringField(TEXT("error"), FString::Printf(TEXT("C++ exception: %s"), UTF8_TO_TCHAR(e.what())));
+        UE_LOG(LogMCPBridge, Error, TEXT("<<< MCP Exception: %s"), UTF8_TO_TCHAR(e.what()));
+    }
+    catch (...)
+    {
+        ResultJson = MakeShareable(new FJsonObject);
+        ResultJson->SetBoolField(TEXT("success"), false);
+        ResultJson->SetStringField(TEXT("error"), TEXT("Unknown C++ exception occurred"));
+        UE_LOG(LogMCPBridge, Error, TEXT("<<< MCP Unknown Exception"));
+    }
+    return ResultJson;
+}
+
+FMCPResponse UUnrealCompanionBridge::FinalizeResponse(const FString& CommandType, const TSharedPtr<FJsonObject>& ResultJson,
+    const TSharedPtr<FJsonValue>& RequestId, double StartTime)
+{
+    // Check if the result contains an error
+    bool bSuccess = true;
+    FString ErrorMessage;
+
+    if (!ResultJson.IsValid())
+    {
+        bSuccess = false;
+        ErrorMessage = TEXT("Command returned null result");
+    }
+    else if (ResultJson->HasField(TEXT("success")))
+    {
+        bSuccess = ResultJson->GetBoolField(TEXT("success"));
+        if (!bSuccess)
+        {
+            if (ResultJson->HasField(TEXT("error")))
             {
-                bSuccess = ResultJson->GetBoolField(TEXT("success"));
-                if (!bSuccess)
-                {
-                    if (ResultJson->HasField(TEXT("error")))
-                    {
-                        ErrorMessage = ResultJson->GetStringField(TEXT("error"));
-                    }
-                    else if (ResultJson->HasField(TEXT("message")))
-                    {
-                        ErrorMessage = ResultJson->GetStringField(TEXT("message"));
-                    }
-                    else
-                    {
-                        ErrorMessage = TEXT("Command failed (no error details provided)");
-                    }
-                }
+                ErrorMessage = ResultJson->GetStringField(TEXT("error"));
             }
-            
-            if (bSuccess)
+            else if (ResultJson->HasField(TEXT("message")))
             {
-                // Set success status and include the result
-                ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
-                ResponseJson->SetObjectField(TEXT("result"), ResultJson);
+                ErrorMessage = ResultJson->GetStringField(TEXT("message"));
             }
             else
             {
-                // Set error status and include the error message
-                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                ResponseJson->SetStringField(TEXT("error"), ErrorMessage);
+                ErrorMessage = TEXT("Command failed (no error details provided)");
             }
         }
-        catch (const std::exception& e)
-        {
-            ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-            ResponseJson->SetStringField(TEXT("error"), FString::Printf(TEXT("C++ exception: %s"), UTF8_TO_TCHAR(e.what())));
-            UE_LOG(LogMCPBridge, Error, TEXT("<<< MCP Exception: %s"), UTF8_TO_TCHAR(e.what()));
-        }
-        catch (...)
-        {
-            ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-            ResponseJson->SetStringField(TEXT("error"), TEXT("Unknown C++ exception occurred"));
-            UE_LOG(LogMCPBridge, Error, TEXT("<<< MCP Unknown Exception"));
-        }
-        
-        // Log completion with timing
-        double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
-        FString Status = ResponseJson->GetStringField(TEXT("status"));
-        if (Status == TEXT("success"))
+    }
+
+    FMCPResponse Response;
+    Response.bSuccess = bSuccess;
+    Response.RequestId = RequestId;
+    Response.CommandType = CommandType;
+    if (bSuccess)
+    {
+        Response.Result = ResultJson;
+    }
+    else
+    {
+        Response.Error = MoveTemp(ErrorMessage);
+    }
+
+    // Log completion with timing
+    const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+    Response.ExecuteSeconds = ElapsedSeconds;
+    FMCPMetrics::Get().RecordCompletion(CommandType, bSuccess, ElapsedSeconds);
+    const double ElapsedMs = ElapsedSeconds * 1000.0;
+    if (bSuccess)
+    {
+        UE_LOG(LogMCPBridge, Display, TEXT("<<< MCP OK: %s (%.1fms)"), *CommandType, ElapsedMs);
+    }
+    else
+    {
+        UE_LOG(LogMCPBridge, Warning, TEXT("<<< MCP FAIL: %s - %s (%.1fms)"), *CommandType, *Response.Error, ElapsedMs);
+    }
+    return Response;
+}
+
+TSharedPtr<FJsonObject> UUnrealCompanionBridge::HandleBridgeMetrics(const TSharedPtr<FJsonObject>& Params) const
+{
+    FString Format = TEXT("json");
+    bool bReset = false;
+    if (Params.IsValid())
+    {
+        Params->TryGetStringField(TEXT("format"), Format);
+        Params->TryGetBoolField(TEXT("reset"), bReset);
+    }
+
+    FMCPMetrics& Metrics = FMCPMetrics::Get();
+    const int32 QueueDepth = QueuedCommandCount.load();
+
+    TSharedPtr<FJsonObject> Result;
+    if (Format.Equals(TEXT("prometheus"), ESearchCase::IgnoreCase))
+    {
+        Result = MakeShared<FJsonObject>();
+        Result->SetStringField(TEXT("format"), TEXT("prometheus"));
+        Result->SetStringField(TEXT("text"), Metrics.BuildPrometheusText(QueueDepth));
+    }
+    else if (Format.Equals(TEXT("json"), ESearchCase::IgnoreCase))
+    {
+        Result = Metrics.BuildReport(QueueDepth);
+        Result->SetObjectField(TEXT("response_cache"), FUnrealCompanionResponseCache::Get().BuildReport());
+    }
+    else
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(
+            FString::Printf(TEXT("Unknown format '%s'. Valid: json, prometheus"), *Format));
+    }
+
+    if (bReset)
+    {
+        Metrics.Reset();
+        FUnrealCompanionResponseCache::Get().ResetStats();
+    }
+    Result->SetBoolField(TEXT("reset"), bReset);
+    Result->SetBoolField(TEXT("success"), true);
+    return Result;
+}
+
+TSharedPtr<FJsonObject> UUnrealCompanionBridge::HandleBridgeTrace(const TSharedPtr<FJsonObject>& Params) const
+{
+    int32 Limit = 100;
+    bool bLog = false;
+    if (Params.IsValid())
+    {
+        Params->TryGetNumberField(TEXT("limit"), Limit);
+        Params->TryGetBoolField(TEXT("log"), bLog);
+    }
+    Limit = FMath::Clamp(Limit, 1, FMCPTraceLog::Capacity);
+
+    if (bLog)
+    {
+        FMCPTraceLog::Get().DumpToLog(Limit);
+    }
+
+    TSharedPtr<FJsonObject> Result = FMCPTraceLog::Get().BuildReport(Limit);
+    Result->SetBoolField(TEXT("success"), true);
+    return Result;
+}
+
+TSharedPtr<FJsonObject> UUnrealCompanionBridge::HandleBridgeSchema(const TSharedPtr<FJsonObject>& Params) const
+{
+    static const TCHAR* AffinityNames[] = { TEXT("game_thread"), TEXT("any_thread"), TEXT("render_thread") };
+    static const TCHAR* PriorityNames[] = { TEXT("high"), TEXT("normal"), TEXT("low") };
+
+    // Untyped commands have no "params": the client can only check that they exist
+    TSharedPtr<FJsonObject> Commands = MakeShared<FJsonObject>();
+    for (const TPair<FString, FCommandRegistration>& Pair : CommandRegistry)
+    {
+        const FCommandRegistration& Registration = Pair.Value;
+        TSharedPtr<FJsonObject> CommandObj = MakeShared<FJsonObject>();
+        CommandObj->SetStringField(TEXT("affinity"), AffinityNames[(int32)Registration.Affinity]);
+        if (Registration.AffinityResolver)
         {
-            UE_LOG(LogMCPBridge, Display, TEXT("<<< MCP OK: %s (%.1fms)"), *CommandType, ElapsedMs);
+            CommandObj->SetBoolField(TEXT("dynamic_affinity"), true);
         }
-        else
+        CommandObj->SetStringField(TEXT("priority"), PriorityNames[(int32)Registration.Priority]);
+        if (Registration.ParamDescriber)
         {
-            FString ErrorMsg = ResponseJson->GetStringField(TEXT("error"));
-            UE_LOG(LogMCPBridge, Warning, TEXT("<<< MCP FAIL: %s - %s (%.1fms)"), *CommandType, *ErrorMsg, ElapsedMs);
+            CommandObj->SetObjectField(TEXT("params"), Registration.ParamDescriber());
         }
-        
-        FString ResultString;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-        FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-        Promise.SetValue(ResultString);
-    });
-    
-    return Future.Get();
+        Commands->SetObjectField(Pair.Key, CommandObj);
+    }
+
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetBoolField(TEXT("success"), true);
+    Result->SetNumberField(TEXT("count"), CommandRegistry.Num());
+    Result->SetObjectField(TEXT("commands"), Commands);
+    return Result;
+}
+
+TSharedPtr<FJsonObject> UUnrealCompanionBridge::HandleBridgeShutdown(const TSharedPtr<FJsonObject>& Params)
+{
+    // Someone may be working in an interactive editor; only the CI host exits on request
+    if (!IsRunningCommandlet())
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponseWithCode(TEXT("NOT_SUPPORTED"),
+            TEXT("bridge_shutdown only stops the UnrealCompanion commandlet"),
+            TEXT("Close the editor yourself, or run it with -run=UnrealCompanion"));
+    }
+
+    // The commandlet loop sees the request on its next pass, after this reply has gone out
+    RequestEngineExit(TEXT("bridge_shutdown"));
+
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetBoolField(TEXT("success"), true);
+    Result->SetNumberField(TEXT("deferred_saves"), FUnrealCompanionEditorFocus::Get().GetDeferredSaveCount());
+    return Result;
+}
+
+TSharedPtr<FJsonObject> UUnrealCompanionBridge::HandleBridgeBenchmark(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!FUnrealCompanionDeferredResponse::CanDefer())
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(
+            TEXT("bridge_benchmark must be sent over the socket: it replies after the whole mix has run"));
+    }
+
+    FString Error;
+    TSharedPtr<FMCPBenchmark> Run = FMCPBenchmark::Create(this, Params, Error);
+    if (!Run.IsValid())
+    {
+        return FUnrealCompanionCommonUtils::CreateErrorResponse(Error);
+    }
+
+    Run->Start(FUnrealCompanionDeferredResponse::Defer());
+    return nullptr;
 }
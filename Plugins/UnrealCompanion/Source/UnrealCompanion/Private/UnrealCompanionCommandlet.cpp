@@ -0,0 +1,138 @@
+#include "UnrealCompanionCommandlet.h"
+#include "UnrealCompanionBridge.h"
+#include "Commands/UnrealCompanionAssetIndex.h"
+#include "Commands/UnrealCompanionActorIndex.h"
+#include "Commands/UnrealCompanionEditorFocus.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "Editor.h"
+#include "FileHelpers.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadManager.h"
+#include "Misc/Parse.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMCPCommandlet, Log, All);
+
+namespace
+{
+    // Idle wait per loop pass; commands queued meanwhile run on the next pass
+    constexpr float LoopSleepSeconds = 0.002f;
+
+    // Passes keep running this long after an exit request so replies already queued reach their clients
+    constexpr double ShutdownGraceSeconds = 0.25;
+}
+
+UUnrealCompanionCommandlet::UUnrealCompanionCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+    ShowErrorCount = false;
+}
+
+int32 UUnrealCompanionCommandlet::Main(const FString& Params)
+{
+    UUnrealCompanionBridge* Bridge = GEditor ? GEditor->GetEditorSubsystem<UUnrealCompanionBridge>() : nullptr;
+    if (!Bridge || !Bridge->IsRunning())
+    {
+        UE_LOG(LogMCPCommandlet, Error, TEXT("The bridge did not start (port in use? see LogMCPBridge above)"));
+        return 1;
+    }
+
+    FString Map;
+    FParse::Value(*Params, TEXT("Map="), Map);
+    if (FParse::Param(*Params, TEXT("Prewarm")))
+    {
+        if (!Prewarm(Map))
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        // Lookups need the registry; without -Prewarm it fills in while clients work
+        IAssetRegistry::GetChecked().SearchAllAssets(false);
+        if (!Map.IsEmpty() && !UEditorLoadingAndSavingUtils::LoadMap(Map))
+        {
+            UE_LOG(LogMCPCommandlet, Error, TEXT("Could not load map %s"), *Map);
+            return 1;
+        }
+    }
+
+    double IdleExitSeconds = 0.0;
+    FParse::Value(*Params, TEXT("IdleExit="), IdleExitSeconds);
+
+    UE_LOG(LogMCPCommandlet, Display, TEXT("Serving commands (headless=%s)%s"),
+        FUnrealCompanionEditorFocus::Get().IsHeadless() ? TEXT("true") : TEXT("false"),
+        IdleExitSeconds > 0.0 ? *FString::Printf(TEXT(", exiting after %.0fs idle"), IdleExitSeconds) : TEXT(""));
+
+    IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+    double LastTime = FPlatformTime::Seconds();
+    double ExitDeadline = 0.0;
+    for (;;)
+    {
+        const double Now = FPlatformTime::Seconds();
+        const float DeltaTime = (float)(Now - LastTime);
+        LastTime = Now;
+
+        // What the editor's main loop would have run for the bridge: deferred game-thread work,
+        // the command queue ticker, and pending AssetRegistry results
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+        FTSTicker::GetCoreTicker().Tick(DeltaTime);
+        FThreadManager::Get().Tick();
+        AssetRegistry.Tick(DeltaTime);
+
+        if (ExitDeadline > 0.0)
+        {
+            if (Now >= ExitDeadline)
+            {
+                break;
+            }
+        }
+        else if (IsEngineExitRequested())
+        {
+            ExitDeadline = Now + ShutdownGraceSeconds;
+        }
+        else if (IdleExitSeconds > 0.0 && Now - Bridge->GetLastActivityTime() > IdleExitSeconds)
+        {
+            UE_LOG(LogMCPCommandlet, Display, TEXT("No command for %.0fs, exiting"), IdleExitSeconds);
+            break;
+        }
+
+        FPlatformProcess::Sleep(LoopSleepSeconds);
+    }
+
+    // Close the sockets and answer queued commands now rather than at subsystem teardown
+    Bridge->StopServer();
+    return 0;
+}
+
+bool UUnrealCompanionCommandlet::Prewarm(const FString& Map)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+    AssetRegistry.SearchAllAssets(true);
+    const int32 AssetCount = FUnrealCompanionAssetIndex::Get().Num();
+
+    int32 ActorCount = 0;
+    if (!Map.IsEmpty())
+    {
+        if (!UEditorLoadingAndSavingUtils::LoadMap(Map))
+        {
+            UE_LOG(LogMCPCommandlet, Error, TEXT("Could not load map %s"), *Map);
+            return false;
+        }
+        TArray<AActor*> Actors;
+        FUnrealCompanionActorIndex::Get().GetAllActors(GEditor->GetEditorWorldContext().World(), Actors);
+        ActorCount = Actors.Num();
+    }
+
+    UE_LOG(LogMCPCommandlet, Display, TEXT("Prewarmed %d assets, %d actors in %.2fs"),
+        AssetCount, ActorCount, FPlatformTime::Seconds() - StartTime);
+    return true;
+}
@@ -0,0 +1,14 @@
+#include "UnrealCompanionSettings.h"
+
+UUnrealCompanionSettings::UUnrealCompanionSettings()
+    : GameThreadBudgetMs(8.0f)
+    , MaxCommandsPerTick(64)
+    , MaxQueueDepth(1024)
+    , CommandTimeoutSeconds(600.0f)
+    , FocusMode(EUnrealCompanionFocusMode::Auto)
+    , SharedMemoryMB(64)
+    , UndoMode(EUnrealCompanionUndoMode::Command)
+    , UndoBudgetMB(256)
+    , UndoOverBudget(EUnrealCompanionUndoOverBudget::DropUndo)
+{
+}
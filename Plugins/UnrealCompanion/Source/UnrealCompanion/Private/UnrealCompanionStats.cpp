@@ -0,0 +1,12 @@
+#include "UnrealCompanionStats.h"
+
+DEFINE_STAT(STAT_UnrealCompanion_Dispatch);
+DEFINE_STAT(STAT_UnrealCompanion_GraphBatch);
+DEFINE_STAT(STAT_UnrealCompanion_FoliageScatter);
+DEFINE_STAT(STAT_UnrealCompanion_SplineScatter);
+DEFINE_STAT(STAT_UnrealCompanion_LandscapeSculpt);
+DEFINE_STAT(STAT_UnrealCompanion_Compile);
+DEFINE_STAT(STAT_UnrealCompanion_CommandsExecuted);
+DEFINE_STAT(STAT_UnrealCompanion_QueueDepth);
+
+UE_TRACE_CHANNEL_DEFINE(UnrealCompanionChannel);
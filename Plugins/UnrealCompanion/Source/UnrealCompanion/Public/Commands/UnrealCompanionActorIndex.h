@@ -0,0 +1,123 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+class UWorld;
+class ULevel;
+class USceneComponent;
+
+/**
+ * Maintained lookup index over the actors of the editor world.
+ *
+ * Replaces per-request TActorIterator walks: actors are indexed by object name,
+ * label, tag and class, plus a uniform spatial grid for radius/box queries.
+ * The index tracks a single world and is rebuilt lazily when a different world
+ * is queried, after undo/redo, or when streaming levels are added/removed.
+ * Individual actors are kept current from level actor added/deleted/moved,
+ * label-changed and property-changed hooks; Blueprint compiles (which reinstance
+ * actors) also trigger a rebuild. Grid cells follow each actor's root component
+ * transform, so moves that send no editor notification (Python, Sequencer,
+ * SetActorLocation) are seen too.
+ *
+ * Game thread only.
+ */
+class UNREALCOMPANION_API FUnrealCompanionActorIndex
+{
+public:
+    static FUnrealCompanionActorIndex& Get();
+
+    /** Subscribe to editor/engine actor events */
+    void Initialize();
+
+    /** Unsubscribe and drop all entries */
+    void Shutdown();
+
+    /**
+     * Exact object name or label match (case-sensitive, like the previous linear lookups).
+     * With RequiredClass, actors sharing the name but of another class are skipped.
+     */
+    AActor* FindByName(UWorld* World, const FString& NameOrLabel, const UClass* RequiredClass = nullptr);
+
+    /** Every actor whose object name or label equals NameOrLabel, ignoring case */
+    void FindAllByName(UWorld* World, const FString& NameOrLabel, TArray<AActor*>& OutActors);
+
+    /** Every actor whose object name or label contains Pattern, ignoring case (each actor once) */
+    void FindByNameSubstring(UWorld* World, const FString& Pattern, TArray<AActor*>& OutActors);
+
+    /** All actors in the world, in no particular order */
+    void GetAllActors(UWorld* World, TArray<AActor*>& OutActors);
+
+    void FindByTag(UWorld* World, FName Tag, TArray<AActor*>& OutActors);
+
+    /** Actors whose class name contains ClassFilter (same semantics as core_query class_filter) */
+    void FindByClassName(UWorld* World, const FString& ClassFilter, TArray<AActor*>& OutActors);
+
+    /** Actors whose location lies inside the sphere, sorted nearest first */
+    void FindInRadius(UWorld* World, const FVector& Center, double Radius, TArray<AActor*>& OutActors);
+
+    /** Actors whose location lies inside the box */
+    void FindInBox(UWorld* World, const FBox& Box, TArray<AActor*>& OutActors);
+
+    /** Re-read an actor's name/label/tags/location after it was changed by code (no editor notification) */
+    void NotifyActorChanged(AActor* Actor) { OnActorChanged(Actor); }
+
+    /** Force a rebuild on the next query */
+    void Invalidate() { IndexedWorld.Reset(); }
+
+private:
+    struct FEntry
+    {
+        FName Name;
+        FName Label;
+        TArray<FName> Tags;
+        FName ClassName;
+        FIntVector Cell;
+        // Root component whose transform updates move the actor between grid cells
+        TWeakObjectPtr<USceneComponent> Root;
+        FDelegateHandle RootMovedHandle;
+    };
+
+    void EnsureBuilt(UWorld* World);
+    void AddActor(AActor* Actor);
+    void RemoveActor(AActor* Actor);
+    void ReindexActor(AActor* Actor);
+    /** Move an indexed actor to the grid cell of its current location (cheap when it did not change cell) */
+    void UpdateCell(AActor* Actor);
+    /** Unbind every root component and drop all entries */
+    void ResetEntries();
+
+    bool IsIndexed(const AActor* Actor) const;
+    static FIntVector CellFor(const FVector& Location);
+
+    /** Candidates from every grid cell overlapping Box (a superset; callers test exact bounds) */
+    void GatherCandidatesInBox(const FBox& Box, TArray<AActor*>& OutActors) const;
+
+    // Engine/editor callbacks
+    void OnActorAdded(AActor* Actor);
+    void OnActorDeleted(AActor* Actor);
+    void OnActorChanged(AActor* Actor);
+    void OnObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& Event);
+    void OnLevelChanged(ULevel* Level, UWorld* World);
+
+    TWeakObjectPtr<UWorld> IndexedWorld;
+
+    TMap<TObjectKey<AActor>, FEntry> Entries;
+    TMap<FName, TArray<TWeakObjectPtr<AActor>>> ByName;
+    TMap<FName, TArray<TWeakObjectPtr<AActor>>> ByTag;
+    TMap<FName, TArray<TWeakObjectPtr<AActor>>> ByClass;
+    TMap<FIntVector, TArray<TWeakObjectPtr<AActor>>> Grid;
+
+    FDelegateHandle ActorAddedHandle;
+    FDelegateHandle ActorDeletedHandle;
+    FDelegateHandle ActorMovedHandle;
+    FDelegateHandle LabelChangedHandle;
+    FDelegateHandle PropertyChangedHandle;
+    FDelegateHandle LevelAddedHandle;
+    FDelegateHandle LevelRemovedHandle;
+    FDelegateHandle UndoRedoHandle;
+    FDelegateHandle MapOpenedHandle;
+    FDelegateHandle BlueprintCompiledHandle;
+};
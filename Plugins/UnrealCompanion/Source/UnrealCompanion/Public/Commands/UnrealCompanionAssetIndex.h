@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/TopLevelAssetPath.h"
+#include "Misc/ScopeRWLock.h"
+
+struct FAssetData;
+
+/**
+ * Persistent name/path index over the AssetRegistry.
+ *
+ * Resolving "BP_Player" used to mean GetAssets() over every asset of a class
+ * followed by linear string compares, on every command. The index is built
+ * once from the registry and then kept current from its added/removed/renamed
+ * delegates, so name and path lookups are hash lookups.
+ *
+ * Name keys are FNames, which compare case-insensitively; callers that prefer
+ * an exact-case match get it from the candidate list.
+ */
+class UNREALCOMPANION_API FUnrealCompanionAssetIndex
+{
+public:
+    static FUnrealCompanionAssetIndex& Get();
+
+    /** Subscribe to AssetRegistry events. The index itself is built on first lookup. Game thread only. */
+    void Initialize();
+
+    /** Unsubscribe and drop all entries */
+    void Shutdown();
+
+    /**
+     * Resolve an asset name, package path or object path to an object path.
+     * @param NameOrPath         "BP_Player", "/Game/BP_Player" or "/Game/BP_Player.BP_Player"
+     * @param Class              Only assets of this class are considered (nullptr = any)
+     * @param bIncludeSubclasses Also accept assets whose class derives from Class
+     * @param bAllowPartialMatch Fall back to a substring match on asset names (linear scan)
+     */
+    bool FindAsset(const FString& NameOrPath, const UClass* Class, bool bIncludeSubclasses,
+        bool bAllowPartialMatch, FSoftObjectPath& OutObjectPath);
+
+    /** Class of an indexed asset, empty if the path is not indexed. Safe from any thread. */
+    FTopLevelAssetPath GetAssetClass(const FSoftObjectPath& ObjectPath);
+
+    /** Number of indexed assets (builds the index if needed) */
+    int32 Num();
+
+private:
+    struct FEntry
+    {
+        FSoftObjectPath ObjectPath;
+        FTopLevelAssetPath ClassPath;
+    };
+
+    void EnsureBuilt();
+    void AddAsset_Locked(const FAssetData& AssetData);
+    void RemoveAsset_Locked(const FSoftObjectPath& ObjectPath);
+
+    static bool MatchesClass(const FEntry& Entry, const UClass* Class, bool bIncludeSubclasses);
+
+    // AssetRegistry callbacks
+    void OnAssetAdded(const FAssetData& AssetData);
+    void OnAssetRemoved(const FAssetData& AssetData);
+    void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+    /** Asset name -> every asset with that name (case-insensitive) */
+    TMap<FName, TArray<FEntry>> ByName;
+
+    /** Object path -> asset class */
+    TMap<FSoftObjectPath, FTopLevelAssetPath> ByObjectPath;
+
+    FRWLock Lock;
+    bool bBuilt = false;
+
+    FDelegateHandle AddedHandle;
+    FDelegateHandle RemovedHandle;
+    FDelegateHandle RenamedHandle;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonValue.h"
+#include "IO/IoHash.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UBehaviorTree;
+
+/**
+ * Flattened, cached Behavior Tree summaries for core_get_info type="behavior_tree".
+ *
+ * A tree is walked once into a preorder array of nodes (composites and tasks,
+ * with their decorators and services), each with its JSON already built. A
+ * node's id is its preorder index and every node knows where its subtree ends,
+ * so subtree and depth-limited queries are a slice of the array rather than a
+ * new walk.
+ *
+ * A summary is keyed by the package's saved hash from the AssetRegistry and
+ * dropped when any object in the tree's package is modified or changed in the
+ * editor, so it is rebuilt after an edit or a save and reused otherwise.
+ * Game thread only.
+ */
+class UNREALCOMPANION_API FUnrealCompanionBehaviorTreeCache
+{
+public:
+    static FUnrealCompanionBehaviorTreeCache& Get();
+
+    struct FNode
+    {
+        int32 Depth = 0;
+        /** One past the preorder index of the last node in this subtree */
+        int32 SubtreeEnd = 0;
+        TSharedPtr<FJsonValue> Json;
+    };
+
+    struct FTree
+    {
+        FIoHash SavedHash;
+        TArray<FNode> Nodes;
+        int32 TreeDepth = 0;
+    };
+
+    /** Summary of Tree, building it if it is missing or stale; bOutFromCache tells which */
+    TSharedPtr<const FTree> Find(UBehaviorTree* Tree, bool& bOutFromCache);
+
+    /** Preorder index for a node id ("node_12" or "12"), INDEX_NONE if malformed */
+    static int32 ParseNodeId(const FString& NodeId);
+
+    /** Unsubscribe and drop every summary */
+    void Shutdown();
+
+private:
+    struct FEntry
+    {
+        TWeakObjectPtr<UBehaviorTree> Tree;
+        TSharedPtr<const FTree> Summary;
+    };
+
+    static TSharedPtr<const FTree> Build(UBehaviorTree* Tree, const FIoHash& SavedHash);
+
+    void EnsureSubscribed();
+    void OnObjectChanged(UObject* Object);
+
+    /** Package name -> summary of the tree in it */
+    TMap<FName, FEntry> Entries;
+
+    FDelegateHandle ObjectModifiedHandle;
+    FDelegateHandle PropertyChangedHandle;
+};
@@ -2,6 +2,36 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/UnrealCompanionParams.h"
+
+/**
+ * blueprint_*_batch. The operation lists are checked for shape while parsing, on
+ * the connection thread, so a batch the handler would refuse (missing fields,
+ * unknown actions, duplicate component refs) is rejected before it is queued.
+ * Checks that need the Blueprint itself (does the variable exist?) stay in the
+ * handler, and dry runs always reach it.
+ */
+struct FMCPBlueprintBatchParams : FMCPTypedParams
+{
+    FString BlueprintName;
+};
+
+struct FMCPBlueprintVariableBatchParams : FMCPBlueprintBatchParams
+{
+    TArray<TSharedPtr<FJsonValue>> Operations;
+    static const TMCPParamSchema<FMCPBlueprintVariableBatchParams>& Schema();
+};
+
+struct FMCPBlueprintComponentBatchParams : FMCPBlueprintBatchParams
+{
+    static const TMCPParamSchema<FMCPBlueprintComponentBatchParams>& Schema();
+};
+
+struct FMCPBlueprintFunctionBatchParams : FMCPBlueprintBatchParams
+{
+    TArray<TSharedPtr<FJsonValue>> Operations;
+    static const TMCPParamSchema<FMCPBlueprintFunctionBatchParams>& Schema();
+};
 
 /**
  * Handler class for Blueprint-related MCP commands
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/UnrealCompanionCommandTable.h"
 
 /**
  * Handler class for Blueprint Node-related MCP commands
@@ -11,9 +12,12 @@ class UNREALCOMPANION_API FUnrealCompanionBlueprintNodeCommands
 public:
     FUnrealCompanionBlueprintNodeCommands();
 
-    // Handle blueprint node commands
+    // Handle blueprint node commands (callers outside the bridge; the bridge binds the table rows directly)
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Commands this group answers, registered by the bridge */
+    static TConstArrayView<TMCPCommandEntry<FUnrealCompanionBlueprintNodeCommands>> GetCommandTable();
+
 private:
     // Specific blueprint node command handlers
     TSharedPtr<FJsonObject> HandleConnectBlueprintNodes(const TSharedPtr<FJsonObject>& Params);
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Thread a command handler must run on.
+ * AnyThread handlers must not touch UObjects beyond thread-safe APIs
+ * (AssetRegistry queries, FAssetData, static data).
+ */
+enum class EMCPThreadAffinity : uint8
+{
+    GameThread,     // Default: queued and drained by the game-thread scheduler
+    AnyThread,      // Run immediately on a task-graph worker, bypassing the queue
+    RenderThread    // Enqueued as a render command
+};
+
+/**
+ * One row of a handler group's command table: the command name and the
+ * member that handles it.
+ */
+template <typename HandlerType>
+struct TMCPCommandEntry
+{
+    using FMethod = TSharedPtr<FJsonObject> (HandlerType::*)(const TSharedPtr<FJsonObject>&);
+
+    const TCHAR* Name;
+    FMethod Method;
+    EMCPThreadAffinity Affinity = EMCPThreadAffinity::GameThread;
+};
+
+/**
+ * Compile-time command tables.
+ *
+ * A handler group lists its commands once, as a constexpr array returned by a
+ * static GetCommandTable() (defined in the .cpp so the rows may name private
+ * members):
+ *
+ *     TConstArrayView<TMCPCommandEntry<FMyCommands>> FMyCommands::GetCommandTable()
+ *     {
+ *         static constexpr TMCPCommandEntry<FMyCommands> Table[] = {
+ *             { TEXT("my_create"), &FMyCommands::HandleCreate },
+ *             { TEXT("my_list"), &FMyCommands::HandleList, EMCPThreadAffinity::AnyThread },
+ *         };
+ *         static_assert(UnrealCompanionCommandTable::HasUniqueNames(Table), "Duplicate command name");
+ *         return Table;
+ *     }
+ *
+ * The bridge registers every row bound to its member (RegisterTable), so a
+ * request goes from the one registry lookup straight to the method: no second
+ * string match in an if/else HandleCommand chain. HandleCommand stays for
+ * callers outside the bridge and just scans the table (Dispatch).
+ */
+namespace UnrealCompanionCommandTable
+{
+    constexpr bool NamesEqual(const TCHAR* A, const TCHAR* B)
+    {
+        while (*A && *A == *B)
+        {
+            ++A;
+            ++B;
+        }
+        return *A == *B;
+    }
+
+    template <typename HandlerType, SIZE_T N>
+    constexpr bool HasUniqueNames(const TMCPCommandEntry<HandlerType> (&Table)[N])
+    {
+        for (SIZE_T I = 0; I < N; ++I)
+        {
+            for (SIZE_T J = I + 1; J < N; ++J)
+            {
+                if (NamesEqual(Table[I].Name, Table[J].Name))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /** Run CommandType from Table on Handler; null if the table has no such row */
+    template <typename HandlerType>
+    TSharedPtr<FJsonObject> Dispatch(HandlerType& Handler, TConstArrayView<TMCPCommandEntry<HandlerType>> Table,
+        const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+    {
+        for (const TMCPCommandEntry<HandlerType>& Entry : Table)
+        {
+            if (CommandType == Entry.Name)
+            {
+                return (Handler.*Entry.Method)(Params);
+            }
+        }
+        return nullptr;
+    }
+}
@@ -2,6 +2,9 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/UnrealCompanionScratch.h"
+#include "Math/RandomStream.h"
+#include "UObject/WeakObjectPtrTemplates.h"
 
 // Forward declarations
 class AActor;
@@ -18,6 +21,8 @@ class UK2Node_EnhancedInputAction;
 class UK2Node_Self;
 class UInputAction;
 class UFunction;
+class FProperty;
+class FStructProperty;
 
 /**
  * Common utilities for UnrealCompanion commands
@@ -84,6 +89,18 @@ public:
         int32 MaxOperations = 500;
     };
     static FMCPStandardParams GetStandardParams(const TSharedPtr<FJsonObject>& Params);
+
+    /**
+     * Seed for randomised commands: the "seed" field, or a fresh random one when absent.
+     * Commands echo it back so a layout can be regenerated exactly.
+     */
+    static int32 GetSeedFromParams(const TSharedPtr<FJsonObject>& Params);
+
+    /**
+     * Independent stream for item Index of a seeded job. Its values depend only on
+     * (Seed, Index), never on which thread runs the item or in what order.
+     */
+    static FRandomStream MakeIndexedRandomStream(int32 Seed, int32 Index);
     
     // =========================================================================
     // JSON Utilities
@@ -98,6 +115,17 @@ public:
     static TSharedPtr<FJsonValue> ActorToJson(AActor* Actor);
     static TSharedPtr<FJsonObject> ActorToJsonObject(AActor* Actor, bool bDetailed = false);
     
+    // Asset registry utilities (thread-safe: never load packages or touch UObjects)
+    static bool DoesAssetExistInRegistry(const FString& AssetPath);
+    static bool DoesFolderExistInRegistry(const FString& FolderPath);
+
+    /**
+     * Class path for an asset class filter: a full path ("/Script/Niagara.NiagaraSystem")
+     * or the short name of an asset class. Short names outside a small table of
+     * common non-Engine classes are assumed to live in /Script/Engine.
+     */
+    static FTopLevelAssetPath ResolveAssetClassPath(const FString& ClassName);
+    
     // Blueprint utilities
     static UBlueprint* FindBlueprint(const FString& BlueprintName);
     static UBlueprint* FindBlueprintByName(const FString& BlueprintName);
@@ -125,8 +153,79 @@ public:
     static UK2Node_Event* FindExistingEventNode(UEdGraph* Graph, const FString& EventName);
 
     // Property utilities
+
+    /** Set a property from JSON. PropertyName may walk into structs: "RelativeLocation.X" */
     static bool SetObjectProperty(UObject* Object, const FString& PropertyName, 
                                  const TSharedPtr<FJsonValue>& Value, FString& OutErrorMessage);
+
+    /** A property path resolved against one class, ready to store into any object of it */
+    struct FPropertyAccessor
+    {
+        enum class EKind : uint8 { Unsupported, Bool, Int, Float, Double, Str, Byte, Enum, Object, SoftObject, Struct };
+
+        /** Struct properties walked to reach Leaf, outermost first */
+        TArray<FStructProperty*, TInlineAllocator<2>> Path;
+        FProperty* Leaf = nullptr;
+        EKind Kind = EKind::Unsupported;
+    };
+
+    /** Resolve PropertyPath on Class once; false (with a message) if a segment is missing or not a struct */
+    static bool ResolvePropertyAccessor(const UClass* Class, const FString& PropertyPath,
+                                        FPropertyAccessor& OutAccessor, FString& OutErrorMessage);
+
+    /** Store Value through a resolved accessor. Object must be of the class it was resolved on */
+    static bool ApplyPropertyAccessor(UObject* Object, const FPropertyAccessor& Accessor, const FString& PropertyName,
+                                      const TSharedPtr<FJsonValue>& Value, FString& OutErrorMessage);
+
+    /**
+     * Per-batch memo for SetObjectProperty. While one is alive (game thread), each
+     * (class, property path) is resolved once, hits and misses alike, so a batch
+     * writing the same properties on thousands of objects pays for the lookup
+     * and type dispatch once per path. Batches may nest; the innermost one is used.
+     * Do not keep one open across a Blueprint compile: it holds FProperty pointers.
+     * Lives in command scratch memory: only inside a handler call.
+     */
+    struct FScopedPropertyCache
+    {
+        FScopedPropertyCache();
+        ~FScopedPropertyCache();
+
+        struct FEntry
+        {
+            FPropertyAccessor Accessor;
+            /** Set when the path did not resolve */
+            FString Error;
+        };
+        TScratchMap<TPair<const UClass*, FString>, FEntry> Entries;
+
+    private:
+        FScopedPropertyCache* Outer;
+    };
+
+    /**
+     * Coalesces structural-modify notifications for one Blueprint across a batch.
+     * Engine edits (AddMemberVariable, AddFunctionGraph, RemoveGraph...) each end in
+     * MarkBlueprintAsStructurallyModified, which regenerates the skeleton class and
+     * refreshes open editors. While the guard is alive the Blueprint reports
+     * BS_BeingCreated, which those calls already skip, and Finish() (or the
+     * destructor) restores the status and fires a single structural modify.
+     * Finish before anything that needs the skeleton or a compile. A guard on a
+     * Blueprint that is already suppressed (nested, or really being created) does nothing.
+     */
+    class FScopedBlueprintModification
+    {
+    public:
+        explicit FScopedBlueprintModification(UBlueprint* InBlueprint);
+        ~FScopedBlueprintModification();
+
+        /** End suppression; bModified fires the one structural modify */
+        void Finish(bool bModified = true);
+
+    private:
+        TWeakObjectPtr<UBlueprint> Blueprint;
+        uint8 SavedStatus = 0;
+        bool bActive = false;
+    };
     
     // =========================================================================
     // EDITOR NAVIGATION - Auto-open assets/graphs when modified
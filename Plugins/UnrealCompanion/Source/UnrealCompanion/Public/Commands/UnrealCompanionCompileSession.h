@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UBlueprint;
+class UMaterial;
+
+/**
+ * Deferred Blueprint and Material compilation across several commands.
+ *
+ * Outside a session every edit that asks for a compile gets one immediately,
+ * which is what single-shot clients expect. Between core_session begin and
+ * commit, those requests only mark the asset dirty and remember it; commit
+ * compiles each touched Blueprint exactly once (parents before children) and
+ * reports compiler messages per asset, then recompiles each touched Material
+ * once (one PostEditChange, one round of shader compilation).
+ *
+ * Sessions are bridge-wide, not per connection. Game thread only.
+ */
+class UNREALCOMPANION_API FUnrealCompanionCompileSession
+{
+public:
+    static FUnrealCompanionCompileSession& Get();
+
+    bool IsActive() const { return bActive; }
+
+    /** Start a session. Returns false if one is already open. */
+    bool Begin(const FString& Label);
+
+    /** Compile every touched Blueprint once and close the session */
+    TSharedPtr<FJsonObject> Commit();
+
+    /** Close the session without compiling (Blueprints stay dirty) */
+    TSharedPtr<FJsonObject> Abort();
+
+    TSharedPtr<FJsonObject> GetStatus() const;
+
+    /**
+     * Hand a compile request to the open session.
+     * @return true if the Blueprint was deferred (caller must not compile),
+     *         false if no session is open (caller compiles as usual)
+     */
+    bool DeferCompile(UBlueprint* Blueprint);
+    bool DeferCompile(UMaterial* Material);
+
+    /** An explicit compile happened: the asset no longer needs one at commit */
+    void NotifyCompiled(UBlueprint* Blueprint);
+    void NotifyCompiled(UMaterial* Material);
+
+    /** Compile and collect messages for one Blueprint (used by commit and blueprint_compile) */
+    static TSharedPtr<FJsonObject> CompileWithMessages(UBlueprint* Blueprint);
+
+    /**
+     * Compile several Blueprints in one pass of the Blueprint compilation manager
+     * (blueprint_compile with blueprint_names). The manager orders the queue
+     * parents first and reinstances once, so a child edited along with its parent
+     * compiles once instead of after its own compile and again after the parent's.
+     * One result per Blueprint in input order; messages are read from the nodes.
+     */
+    static TArray<TSharedPtr<FJsonValue>> CompileBatch(const TArray<UBlueprint*>& Blueprints, int32& OutFailed);
+
+private:
+    bool bActive = false;
+    FString SessionLabel;
+    double StartTime = 0.0;
+    int32 DeferredRequests = 0;
+
+    /** Insertion-ordered so reports follow the order assets were first touched */
+    TArray<TWeakObjectPtr<UBlueprint>> Pending;
+    TArray<TWeakObjectPtr<UMaterial>> PendingMaterials;
+};
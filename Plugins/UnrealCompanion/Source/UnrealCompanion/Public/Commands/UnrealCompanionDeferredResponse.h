@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Lets a command handler answer after it has returned.
+ *
+ * A handler that hands slow work to other threads (GPU readback, encoding,
+ * file I/O) calls Defer(), returns nullptr, and later invokes the returned
+ * completion exactly once, from any thread, with its result object. The
+ * bridge then builds and sends the response as if the handler had returned it.
+ *
+ * Deferral is only possible when the bridge dispatched the command through a
+ * path that can reply later (queued, pipelined or worker commands). On direct
+ * game-thread execution CanDefer() is false and the handler must do the work
+ * synchronously. Code that runs another handler inline should wrap it in
+ * FScope(nullptr) so the inner handler cannot take over the outer reply.
+ *
+ * Pipelined dispatches also carry an event sink: frames sent through it reach
+ * the client before (or after) the reply, tagged with the request's id, e.g.
+ * progress of a job the command started (FUnrealCompanionJobManager).
+ */
+class UNREALCOMPANION_API FUnrealCompanionDeferredResponse
+{
+public:
+    using FCompletion = TFunction<void(const TSharedPtr<FJsonObject>&)>;
+
+    /** Sends one event frame (Event name, payload) to the client of the running command; callable from any thread */
+    using FEventSink = TFunction<void(const FString&, const TSharedPtr<FJsonObject>&)>;
+
+    /** True if the command currently running on this thread may reply later */
+    static bool CanDefer();
+
+    /** Take over the reply for the running command. Check CanDefer() first. */
+    static FCompletion Defer();
+
+    /** Event sink of the running command, or an empty function if its client cannot receive events */
+    static FEventSink GetEventSink();
+
+    /** Bridge side: makes deferral available to the handler called inside this scope */
+    class FScope
+    {
+    public:
+        explicit FScope(FCompletion InCompletion, FEventSink InEventSink = nullptr);
+        ~FScope();
+
+        bool WasDeferred() const { return bDeferred; }
+
+    private:
+        friend class FUnrealCompanionDeferredResponse;
+
+        FCompletion Completion;
+        FEventSink EventSink;
+        FScope* Previous = nullptr;
+        bool bDeferred = false;
+    };
+
+private:
+    static thread_local FScope* CurrentScope;
+};
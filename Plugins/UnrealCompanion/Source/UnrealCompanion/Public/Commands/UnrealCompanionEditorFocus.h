@@ -3,8 +3,11 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Containers/Ticker.h"
 
 class UObject;
+class UPackage;
 class UBlueprint;
 class UEdGraph;
 class UEdGraphNode;
@@ -19,10 +22,16 @@ class UEdGraphNode;
  *   - Call SetError() if an error occurred (prevents closing)
  * 
  * The manager automatically:
- *   - Saves the previous asset before switching
+ *   - Saves the previous asset before switching (on a later tick when this
+ *     runs inside a transaction, such as a bridge command's)
  *   - Closes the previous asset editor (unless error)
  *   - Opens the new asset in the appropriate editor
  *   - Navigates to the correct graph/node if specified
+ *
+ * Headless (FocusMode setting; Auto picks it under -unattended, in a commandlet
+ * or without Slate) keeps the tracking but does no UI work: nothing is opened,
+ * navigated, synced or closed, and the auto-save at EndFocus only records the
+ * package until FlushDeferredSaves (core_save).
  */
 class UNREALCOMPANION_API FUnrealCompanionEditorFocus
 {
@@ -98,6 +107,21 @@ public:
     /** Enable/disable focus tracking */
     void SetEnabled(bool bInEnabled) { bEnabled = bInEnabled; }
 
+    /** True when editor UI work is skipped (see class comment) */
+    bool IsHeadless() const { return bHeadless; }
+
+    // =========================================================================
+    // DEFERRED SAVES (headless)
+    // =========================================================================
+
+    /** Save every package whose auto-save was deferred; the saver's result (null if it replies later) */
+    TSharedPtr<FJsonObject> FlushDeferredSaves();
+
+    /** Forget deferred saves (a full save already wrote them) */
+    void ClearDeferredSaves() { DeferredSaves.Reset(); }
+
+    int32 GetDeferredSaveCount() const { return DeferredSaves.Num(); }
+
     // =========================================================================
     // CONFIGURATION
     // =========================================================================
@@ -109,7 +133,7 @@ public:
     bool bAutoClose = true;
 
 private:
-    FUnrealCompanionEditorFocus() = default;
+    FUnrealCompanionEditorFocus();
     ~FUnrealCompanionEditorFocus() = default;
 
     // Non-copyable
@@ -118,6 +142,8 @@ private:
 
     // Internal methods
     bool SaveCurrentAsset();
+    /** Save PendingSaves once no transaction is open; keeps ticking until then */
+    bool SavePendingPackages(float DeltaTime);
     bool CloseCurrentAsset();
     bool OpenAssetEditor(UObject* Asset, const FString& GraphName = TEXT(""));
     bool NavigateToGraph(UBlueprint* Blueprint, const FString& GraphName);
@@ -131,6 +157,14 @@ private:
     bool bHasError = false;
     FString ErrorMessage;
     bool bEnabled = true;
+    bool bHeadless = false;
+
+    /** Packages EndFocus would have saved in headless mode, in first-touched order */
+    TArray<TWeakObjectPtr<UPackage>> DeferredSaves;
+
+    /** Auto-saves that came during a transaction (a bridge command's), saved on a later tick */
+    TArray<TWeakObjectPtr<UPackage>> PendingSaves;
+    FTSTicker::FDelegateHandle PendingSaveTicker;
 };
 
 // Convenience macros for common patterns
@@ -2,13 +2,26 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Commands/UnrealCompanionCommandTable.h"
+
+class ADirectionalLight;
+class AExponentialHeightFog;
+class ASkyLight;
+class USkyAtmosphereComponent;
 
 /**
  * Environment Commands for UnrealCompanion
  * 
  * Handles environment/atmosphere configuration:
  * - environment_configure: Unified environment tool with action parameter
- *   Actions: set_time_of_day, set_fog, setup_atmosphere, get_info
+ *   Actions: set_time_of_day, set_fog, apply, setup_atmosphere, get_info
+ *
+ * The sun, fog, sky light and sky atmosphere are found in one pass over the
+ * world and remembered while they stay valid. Setting properties writes the
+ * component fields and marks each touched component's render state dirty
+ * once, instead of a PostEditChange (construction script plus re-registration)
+ * per setting; "apply" sets sun, fog and sky light together in one call.
  */
 class UNREALCOMPANION_API FUnrealCompanionEnvironmentCommands
 {
@@ -17,6 +30,9 @@ public:
 
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Commands this group answers, registered by the bridge */
+    static TConstArrayView<TMCPCommandEntry<FUnrealCompanionEnvironmentCommands>> GetCommandTable();
+
 private:
     TSharedPtr<FJsonObject> HandleConfigure(const TSharedPtr<FJsonObject>& Params);
 
@@ -25,4 +41,34 @@ private:
     TSharedPtr<FJsonObject> HandleSetFog(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetupAtmosphere(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleGetInfo(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleApply(const TSharedPtr<FJsonObject>& Params);
+
+    struct FEnvironmentActors
+    {
+        ADirectionalLight* Sun = nullptr;
+        AExponentialHeightFog* Fog = nullptr;
+        ASkyLight* SkyLight = nullptr;
+        USkyAtmosphereComponent* Atmosphere = nullptr;
+    };
+
+    /** First of each environment actor in World; rescans only when one is missing or gone */
+    FEnvironmentActors ResolveEnvironment(UWorld* World);
+
+    /** Remember an actor spawned by an action so the next resolve finds it */
+    void RememberEnvironment(const FEnvironmentActors& Actors);
+
+    /** Sun settings from Params (time, sun_intensity, sun_color); false if none were given */
+    bool ApplySun(ADirectionalLight* Sun, const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonObject>& OutResult);
+
+    /** Fog settings from Params (density, height_falloff, start_distance, color, enabled, volumetric); false if none */
+    bool ApplyFog(AExponentialHeightFog* Fog, const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonObject>& OutResult);
+
+    /** Recapture a sky light that does not capture in real time, after the sun moved */
+    static bool RecaptureSkyLight(ASkyLight* SkyLight);
+
+    TWeakObjectPtr<UWorld> CachedWorld;
+    TWeakObjectPtr<ADirectionalLight> CachedSun;
+    TWeakObjectPtr<AExponentialHeightFog> CachedFog;
+    TWeakObjectPtr<ASkyLight> CachedSkyLight;
+    TWeakObjectPtr<USkyAtmosphereComponent> CachedAtmosphere;
 };
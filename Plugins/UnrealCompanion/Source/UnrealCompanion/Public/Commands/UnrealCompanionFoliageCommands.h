@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/UnrealCompanionCommandTable.h"
 
 // Forward declarations
 class AInstancedFoliageActor;
@@ -14,6 +15,8 @@ class UFoliageType;
  * - foliage_add_type: Create and configure a foliage type
  * - foliage_scatter: Scatter foliage instances in an area
  * - foliage_remove: Remove foliage instances from an area
+ * - foliage_export: Read instance transforms of an area as packed binary chunks
+ * - foliage_import: Add packed instance transforms in one batch per foliage type
  */
 class UNREALCOMPANION_API FUnrealCompanionFoliageCommands
 {
@@ -22,8 +25,13 @@ public:
 
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Commands this group answers, registered by the bridge */
+    static TConstArrayView<TMCPCommandEntry<FUnrealCompanionFoliageCommands>> GetCommandTable();
+
 private:
     TSharedPtr<FJsonObject> HandleAddType(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleScatter(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleRemove(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleExport(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleImport(const TSharedPtr<FJsonObject>& Params);
 };
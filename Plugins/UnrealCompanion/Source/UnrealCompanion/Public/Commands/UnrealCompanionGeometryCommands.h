@@ -2,13 +2,27 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Commands/UnrealCompanionCommandTable.h"
+
+class UDynamicMesh;
+class UDynamicMeshPool;
 
 /**
  * Geometry Commands for UnrealCompanion
- * 
+ *
  * Handles procedural geometry creation using Geometry Script:
  * - geometry_create: Create primitives (box, sphere, cylinder, cone, plane)
- * - geometry_boolean: Boolean operations (union, subtract, intersection)
+ * - geometry_boolean: Boolean operations (union, subtract, intersection) of one
+ *   target with any number of tools: tools whose bounds do not overlap are merged
+ *   into one pass, passes are folded pairwise in parallel (ParallelFor on plain
+ *   FDynamicMesh3 copies) and the target takes a single boolean at the end
+ * - geometry_pipeline: Run a list of primitive/boolean/transform/append ops on
+ *   named in-memory meshes and commit the result to an actor (or a static mesh
+ *   asset) once, so render data and collision are rebuilt a single time
+ *
+ * Pipeline meshes come from a UDynamicMeshPool and go back to it after every
+ * pipeline, so repeated pipelines reuse their allocations.
  */
 class UNREALCOMPANION_API FUnrealCompanionGeometryCommands
 {
@@ -17,10 +31,24 @@ public:
 
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Commands this group answers, registered by the bridge */
+    static TConstArrayView<TMCPCommandEntry<FUnrealCompanionGeometryCommands>> GetCommandTable();
+
+    /** Free the pooled meshes (bridge shutdown) */
+    void Shutdown();
+
 private:
     TSharedPtr<FJsonObject> HandleCreatePrimitive(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleBoolean(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandlePipeline(const TSharedPtr<FJsonObject>& Params);
+
+    /** Append a primitive of Type sized from Params (width, height, depth, radius, segments); false with OutError on unknown type */
+    static bool AppendPrimitive(UDynamicMesh* Mesh, const FString& Type, const TSharedPtr<FJsonObject>& Params, const FTransform& Transform, FString& OutError);
+
+    UDynamicMeshPool* GetMeshPool();
 
     // Helper to find ADynamicMeshActor by name/label
     class ADynamicMeshActor* FindDynamicMeshActorByName(const FString& ActorName);
+
+    TStrongObjectPtr<UDynamicMeshPool> MeshPool;
 };
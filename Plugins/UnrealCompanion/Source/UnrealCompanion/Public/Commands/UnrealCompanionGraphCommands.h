@@ -5,11 +5,65 @@
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
 #include "Graph/GraphTypes.h"
+#include "Commands/UnrealCompanionParams.h"
+#include "Graph/GraphBatchValidation.h"
+#include "Commands/UnrealCompanionCommandTable.h"
 
 class UEdGraph;
 class UEdGraphNode;
 class INodeFactory;
 
+/** Asset and graph selection shared by graph_* commands */
+struct FMCPGraphTargetParams : FMCPTypedParams
+{
+    FString AssetName;      // asset_name or blueprint_name
+    FString GraphName;      // Empty = EventGraph
+    FString GraphType;      // Optional type hint
+};
+
+/** graph_node_find */
+struct FMCPGraphNodeFindParams : FMCPGraphTargetParams
+{
+    FString NodeType;
+    FString ClassName;
+    FString VariableName;
+    FString EventName;
+    FString FunctionName;
+    bool bOnlyUnconnected = false;
+    bool bOnlyPure = false;
+    bool bOnlyImpure = false;
+
+    /** Return only nodes changed after this revision (negative = everything) */
+    double SinceRevision = -1.0;
+
+    static const TMCPParamSchema<FMCPGraphNodeFindParams>& Schema();
+};
+
+/** graph_node_info */
+struct FMCPGraphNodeInfoParams : FMCPGraphTargetParams
+{
+    FString NodeId;
+
+    /** Skip the node body if it hasn't changed after this revision (negative = always send) */
+    double SinceRevision = -1.0;
+
+    static const TMCPParamSchema<FMCPGraphNodeInfoParams>& Schema();
+};
+
+/**
+ * graph_batch. Parsing also validates the whole batch against cached metadata
+ * (FGraphBatchValidation), still on the connection thread: a batch that would
+ * fail is rejected with INVALID_PARAMS before it is queued, unless on_error is
+ * "continue" or it is a dry run. A dry run is answered from this validation
+ * alone, on a worker thread, and never touches the asset.
+ */
+struct FMCPGraphBatchParams : FMCPGraphTargetParams
+{
+    TSharedPtr<const FGraphBatchValidation> Validation;
+
+    static const TMCPParamSchema<FMCPGraphBatchParams>& Schema();
+};
+
 /**
  * Command handler for all graph-related MCP commands.
  * Replaces the old UnrealCompanionBlueprintNodeCommands for graph operations.
@@ -36,6 +90,9 @@ public:
      */
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Commands this group answers, registered by the bridge */
+    static TConstArrayView<TMCPCommandEntry<FUnrealCompanionGraphCommands>> GetCommandTable();
+
     /**
      * Check if this handler supports a command
      */
@@ -99,7 +156,7 @@ private:
     // =========================================================================
 
     /**
-     * Get the appropriate factory for a graph type
+     * Get the appropriate factory for a graph type (from FNodeFactoryRegistry)
      */
     TSharedPtr<INodeFactory> GetFactory(UnrealCompanionGraph::EGraphType GraphType);
 
@@ -114,6 +171,15 @@ private:
         FString& OutError
     );
 
+    /** Same, from already-parsed params */
+    bool ResolveAssetAndGraph(
+        const FMCPGraphTargetParams& Target,
+        UObject*& OutAsset,
+        UEdGraph*& OutGraph,
+        UnrealCompanionGraph::EGraphType& OutGraphType,
+        FString& OutError
+    );
+
     /**
      * Build a standard success response
      */
@@ -123,12 +189,4 @@ private:
      * Build a standard error response
      */
     TSharedPtr<FJsonObject> CreateErrorResponse(const FString& Error);
-
-private:
-    /** Registered node factories */
-    TMap<UnrealCompanionGraph::EGraphType, TSharedPtr<INodeFactory>> Factories;
-
-    /** Initialize factories on first use */
-    void InitializeFactories();
-    bool bFactoriesInitialized = false;
 };
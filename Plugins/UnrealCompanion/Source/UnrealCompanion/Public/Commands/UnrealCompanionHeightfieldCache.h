@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class ULandscapeInfo;
+
+/**
+ * Downsampled landscape heights for landscape_read_heights.
+ *
+ * Level L of a landscape is its height grid box-filtered by 2^L: texel (x, y)
+ * averages the vertices [x*2^L, (x+1)*2^L) of the extent on each axis (edge
+ * texels average what is left). Levels too large to keep are read on demand
+ * in row strips; from the first level at or under MaxCachedTexels upwards the
+ * pyramid is built once per landscape and kept, so an overview of a large
+ * landscape is a copy instead of a full heightmap read.
+ *
+ * Writes mark a rectangle dirty instead of dropping the pyramid: the next read
+ * re-reads only the base texels under it and rebuilds the coarser ones above.
+ * The landscape_* handlers invalidate what they write; editor sculpting is
+ * caught through OnObjectModified on the landscape components.
+ * Game thread only.
+ */
+class UNREALCOMPANION_API FUnrealCompanionHeightfieldCache
+{
+public:
+    static FUnrealCompanionHeightfieldCache& Get();
+
+    /** Largest level kept in memory, in texels (8 MB of heights) */
+    static constexpr int64 MaxCachedTexels = 4 * 1024 * 1024;
+
+    struct FLevel
+    {
+        int32 Width = 0;
+        int32 Height = 0;
+        TArray<uint16> Heights;
+    };
+
+    /**
+     * Heights of Region (inclusive landscape vertex coordinates, inside the extent) at Level.
+     * Texel (0, 0) starts at Region.Min on the fine levels and at Region.Min rounded down
+     * to the level's grid on the cached ones; OutOrigin is that vertex.
+     */
+    bool Read(ULandscapeInfo* Info, const FIntRect& Region, int32 Level, FLevel& OutLevel, FIntPoint& OutOrigin, bool& bOutFromCache);
+
+    /** Mark Region (inclusive vertex coordinates) as changed */
+    void Invalidate(ULandscapeInfo* Info, const FIntRect& Region);
+
+    /** Drop everything cached for Info */
+    void Invalidate(ULandscapeInfo* Info);
+
+    /** Unsubscribe and drop every pyramid */
+    void Shutdown();
+
+private:
+    struct FEntry
+    {
+        TWeakObjectPtr<ULandscapeInfo> Info;
+        FIntRect Extent;
+        int32 BaseLevel = 0;
+        /** Levels BaseLevel, BaseLevel + 1, ... down to a single texel */
+        TArray<FLevel> Levels;
+        /** Vertex rectangle changed since the pyramid was read, if bDirty */
+        FIntRect Dirty;
+        bool bDirty = false;
+    };
+
+    /** Box-filter Region of the landscape by 2^Level, reading it a strip of rows at a time */
+    static void ReadDownsampled(ULandscapeInfo* Info, const FIntRect& Region, int32 Level, FLevel& OutLevel);
+
+    /** Recompute the texels of Dst (half the size of Src) in [Min, Max] from Src */
+    static void DownsampleRect(const FLevel& Src, FLevel& Dst, const FIntPoint& Min, const FIntPoint& Max);
+
+    FEntry* FindOrBuild(ULandscapeInfo* Info, const FIntRect& Extent, bool& bOutFromCache);
+    void Refresh(FEntry& Entry);
+
+    void EnsureSubscribed();
+    void OnObjectModified(UObject* Object);
+
+    TArray<FEntry> Entries;
+
+    FDelegateHandle ObjectModifiedHandle;
+};
@@ -2,6 +2,10 @@
 
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
+#include "Commands/UnrealCompanionCommandTable.h"
+
+class UAssetImportTask;
+class UFbxFactory;
 
 /**
  * Import Commands for UnrealCompanion
@@ -16,6 +20,11 @@ public:
     FUnrealCompanionImportCommands();
     
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+    
+    /** Commands this group answers, registered by the bridge */
+    
+    static TConstArrayView<TMCPCommandEntry<FUnrealCompanionImportCommands>> GetCommandTable();
     
 private:
     /**
@@ -35,10 +44,14 @@ private:
     /**
      * Import multiple files in a batch.
      * 
+     * All tasks are built first and submitted in a single ImportAssetTasks call;
+     * packages are saved together in one pass afterwards.
+     * 
      * Params:
      * - files (array, required): Array of import specifications
      *   Each item: { source_path, destination, asset_name?, options? }
-     * - on_error (string): "continue" (default), "stop"
+     * - on_error (string): "continue" (default), "stop" (stops at the first item that
+     *   fails validation; the items before it are still imported)
      */
     TSharedPtr<FJsonObject> HandleImportBatch(const TSharedPtr<FJsonObject>& Params);
     
@@ -50,4 +63,12 @@ private:
     // Helper to perform the actual import
     bool ImportFile(const FString& SourcePath, const FString& DestinationPath, const FString& AssetName, 
                    bool bReplaceExisting, bool bAutomated, bool bSave, FString& OutAssetPath, FString& OutError);
+    
+    // Validate one import and build its task (nullptr + OutError on failure). SharedFbxFactory may be null.
+    UAssetImportTask* CreateImportTask(const FString& SourcePath, const FString& DestinationPath, const FString& AssetName,
+                   bool bReplaceExisting, bool bAutomated, bool bSave, UFbxFactory* SharedFbxFactory,
+                   FString& OutAssetPath, FString& OutError);
+    
+    // FBX/GLTF factory with the automated import settings
+    static UFbxFactory* CreateFbxFactory();
 };
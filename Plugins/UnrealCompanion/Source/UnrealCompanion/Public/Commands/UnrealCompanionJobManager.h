@@ -0,0 +1,118 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Containers/Ticker.h"
+#include "Commands/UnrealCompanionDeferredResponse.h"
+#include "Commands/UnrealCompanionCommandTable.h"
+
+/**
+ * Long-running editor work (lighting builds, large saves) tracked by job id.
+ *
+ * A heavy command starts a job and replies at once with its job_id instead of
+ * holding the connection until the work is done. The work itself runs wherever
+ * its owner puts it (the editor's async lighting build, a time-sliced ticker);
+ * the owner reports progress and the final result through SetProgress/Finish.
+ * job_status, job_list and job_cancel read and steer jobs from any connection.
+ *
+ * A pipelined request that asks for stream_progress also gets "job_progress"
+ * and "job_finished" event frames tagged with its id (see FMCPResponse::Event);
+ * plain request/response clients poll job_status instead.
+ *
+ * Finished jobs are kept, most recent first, so their result can still be read.
+ * Game thread only.
+ */
+class UNREALCOMPANION_API FUnrealCompanionJobManager
+{
+public:
+    static FUnrealCompanionJobManager& Get();
+
+    /** Owner callbacks. Tick runs once per core tick while the job is running; Cancel may be null (not cancellable). */
+    struct FHooks
+    {
+        TFunction<void(const FString& JobId)> Tick;
+        TFunction<void(const FString& JobId)> Cancel;
+    };
+
+    /** Finished jobs remembered for job_status / job_list */
+    static constexpr int32 MaxFinishedJobs = 32;
+
+    /** Minimum spacing of job_progress events per job */
+    static constexpr double ProgressEventInterval = 0.25;
+
+    /**
+     * Register a running job for Command. With bStreamProgress the running
+     * command's event sink (if its dispatch has one) receives progress events.
+     */
+    FString Start(const FString& Command, FHooks Hooks, bool bStreamProgress = false);
+
+    /** Progress in [0, 1], or negative when the owner cannot tell; Phase is a short free-form stage name */
+    void SetProgress(const FString& JobId, double Progress, const FString& Phase = FString());
+
+    /**
+     * End the job with Result (its "success" field decides succeeded/failed;
+     * a job asked to cancel ends as cancelled).
+     */
+    void Finish(const FString& JobId, const TSharedPtr<FJsonObject>& Result);
+
+    bool IsCancelRequested(const FString& JobId) const;
+
+    /** The usual reply of a command that started a job: success, job_id, status... */
+    TSharedPtr<FJsonObject> BuildStartedResponse(const FString& JobId) const;
+
+    /** job_status, job_list, job_cancel */
+    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+    /** Commands this group answers, registered by the bridge */
+    static TConstArrayView<TMCPCommandEntry<FUnrealCompanionJobManager>> GetCommandTable();
+
+    /** Cancel what can be cancelled and stop ticking (bridge shutdown) */
+    void Shutdown();
+
+private:
+    enum class EState : uint8
+    {
+        Running,
+        Succeeded,
+        Failed,
+        Cancelled
+    };
+
+    struct FJob
+    {
+        FString Id;
+        FString Command;
+        EState State = EState::Running;
+        double Progress = 0.0;
+        FString Phase;
+        double StartTime = 0.0;
+        double EndTime = 0.0;
+        bool bCancelRequested = false;
+        FHooks Hooks;
+        TSharedPtr<FJsonObject> Result;
+
+        FUnrealCompanionDeferredResponse::FEventSink EventSink;
+        double LastEventTime = 0.0;
+        int32 EventSeq = 0;
+    };
+
+    FJob* FindJob(const FString& JobId);
+    const FJob* FindJob(const FString& JobId) const;
+
+    TSharedPtr<FJsonObject> BuildJobJson(const FJob& Job, bool bIncludeResult) const;
+    void SendEvent(FJob& Job, const TCHAR* Event);
+    static const TCHAR* GetStateName(const FJob& Job);
+
+    TSharedPtr<FJsonObject> HandleStatus(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleList(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleCancel(const TSharedPtr<FJsonObject>& Params);
+
+    void EnsureTicker();
+    bool Tick(float DeltaTime);
+
+    /** Running jobs in start order, then finished ones moved to Finished */
+    TArray<TSharedPtr<FJob>> Running;
+    TArray<TSharedPtr<FJob>> Finished;
+    int32 NextJobNumber = 1;
+    FTSTicker::FDelegateHandle TickerHandle;
+};
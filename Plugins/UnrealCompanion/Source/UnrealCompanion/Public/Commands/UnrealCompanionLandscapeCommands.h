@@ -2,11 +2,20 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/UnrealCompanionCommandTable.h"
 
 // Forward declarations
 class ALandscape;
 class ULandscapeInfo;
 
+/** Brush falloff curve, resolved once per sculpt operation rather than per texel */
+enum class EMCPBrushFalloff : uint8
+{
+    Smooth,
+    Linear,
+    Hard
+};
+
 /**
  * Landscape Commands for UnrealCompanion
  * 
@@ -14,7 +23,8 @@ class ULandscapeInfo;
  * - landscape_create: Create a new landscape actor (UE 5.7 safe)
  * - landscape_sculpt: Sculpt terrain (raise, lower, flatten, noise, crater, canyon)
  * - landscape_import_heightmap: Import a heightmap image onto a landscape
- * - landscape_paint_layer: Paint material weight maps on landscape layers
+ * - landscape_paint_layer: Paint material weight maps on landscape layers (one or a batch of strokes)
+ * - landscape_read_heights: Read a region's heights, downsampled, as packed uint16 or float16
  */
 class UNREALCOMPANION_API FUnrealCompanionLandscapeCommands
 {
@@ -23,23 +33,27 @@ public:
 
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Commands this group answers, registered by the bridge */
+    static TConstArrayView<TMCPCommandEntry<FUnrealCompanionLandscapeCommands>> GetCommandTable();
+
 private:
     // Command handlers
     TSharedPtr<FJsonObject> HandleCreateLandscape(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSculptLandscape(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleImportHeightmap(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandlePaintLayer(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleReadHeights(const TSharedPtr<FJsonObject>& Params);
 
     // Sculpt operation helpers
-    void ApplyRaise(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, const FString& FalloffType);
-    void ApplyLower(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, const FString& FalloffType);
-    void ApplyFlatten(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, const FString& FalloffType);
-    void ApplySmooth(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, const FString& FalloffType);
-    void ApplyNoise(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, const FString& FalloffType, float Frequency, int32 Octaves, float Amplitude);
-    void ApplyCrater(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Depth, float RimHeight, const FString& FalloffType);
+    void ApplyRaise(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, EMCPBrushFalloff Falloff);
+    void ApplyLower(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, EMCPBrushFalloff Falloff);
+    void ApplyFlatten(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, EMCPBrushFalloff Falloff);
+    void ApplySmooth(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, EMCPBrushFalloff Falloff);
+    void ApplyNoise(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Intensity, EMCPBrushFalloff Falloff, float Frequency, int32 Octaves, float Amplitude);
+    void ApplyCrater(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, float Depth, float RimHeight, EMCPBrushFalloff Falloff);
     void ApplyCanyon(TArray<uint16>& HeightData, int32 Width, int32 Height, int32 CenterX, int32 CenterY, int32 RadiusInGrid, const FVector2D& Direction, float Depth, float CanyonWidth, float Roughness);
 
     // Utility
-    float CalculateFalloff(float NormalizedDistance, const FString& FalloffType);
+    static EMCPBrushFalloff ParseFalloff(const FString& FalloffType);
     ALandscape* FindLandscapeByName(const FString& ActorName);
 };
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/UnrealCompanionCommandTable.h"
 
 /**
  * Light Commands for UnrealCompanion
@@ -9,7 +10,7 @@
  * Handles lighting operations:
  * - spawn_light: Spawn a light actor
  * - set_light_property: Set light properties
- * - build_lighting: Build lighting for the level
+ * - build_lighting: Build lighting for the level, tracked as a job (job_status)
  */
 class UNREALCOMPANION_API FUnrealCompanionLightCommands
 {
@@ -18,8 +19,14 @@ public:
 
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Commands this group answers, registered by the bridge */
+    static TConstArrayView<TMCPCommandEntry<FUnrealCompanionLightCommands>> GetCommandTable();
+
 private:
     TSharedPtr<FJsonObject> HandleSpawnLight(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetLightProperty(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleBuildLighting(const TSharedPtr<FJsonObject>& Params);
+
+    /** Job of the last lighting build started here, reported when another one is refused */
+    FString LightingJobId;
 };
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/UnrealCompanionCommandTable.h"
 
 /**
  * Material Commands for UnrealCompanion
@@ -11,6 +12,7 @@
  * - create_material_instance: Create a material instance
  * - get_material_info: Get material properties
  * - set_material_parameter: Set material parameter
+ * - material_instance_batch: Set many parameters on many instances, one update per instance
  */
 class UNREALCOMPANION_API FUnrealCompanionMaterialCommands
 {
@@ -19,9 +21,13 @@ public:
 
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Commands this group answers, registered by the bridge */
+    static TConstArrayView<TMCPCommandEntry<FUnrealCompanionMaterialCommands>> GetCommandTable();
+
 private:
     TSharedPtr<FJsonObject> HandleCreateMaterial(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleCreateMaterialInstance(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleGetMaterialInfo(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetMaterialParameter(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleInstanceBatch(const TSharedPtr<FJsonObject>& Params);
 };
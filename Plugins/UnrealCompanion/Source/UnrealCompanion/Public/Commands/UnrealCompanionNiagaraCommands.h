@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/UnrealCompanionCommandTable.h"
 
 // Forward declarations
 class UNiagaraSystem;
@@ -24,6 +25,9 @@ public:
 
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Commands this group answers, registered by the bridge */
+    static TConstArrayView<TMCPCommandEntry<FUnrealCompanionNiagaraCommands>> GetCommandTable();
+
 private:
     // Command handlers
     TSharedPtr<FJsonObject> HandleEmitterBatch(const TSharedPtr<FJsonObject>& Params);
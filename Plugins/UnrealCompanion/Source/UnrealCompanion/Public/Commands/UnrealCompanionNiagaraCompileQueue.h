@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Containers/Ticker.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Commands/UnrealCompanionDeferredResponse.h"
+
+class UNiagaraSystem;
+
+/**
+ * Coalesced compile requests for Niagara systems.
+ *
+ * niagara_emitter_batch and the structural niagara_param_batch operations hand
+ * their system here instead of calling RequestCompile themselves. Requests are
+ * issued on the next core tick, one RequestCompile per system however many
+ * commands touched it in between; while a compile session (core_session) is
+ * open they are held until it closes.
+ *
+ * WaitForCompile lets a command reply only once the system's CPU and GPU
+ * scripts are compiled (or a timeout passed), with per-emitter readiness.
+ *
+ * Game thread only.
+ */
+class UNREALCOMPANION_API FUnrealCompanionNiagaraCompileQueue
+{
+public:
+    static FUnrealCompanionNiagaraCompileQueue& Get();
+
+    /** Queue a compile for System, coalesced with any other request still queued for it */
+    void Request(UNiagaraSystem* System);
+
+    bool IsPending(const UNiagaraSystem* System) const;
+
+    /** Issue System's queued compile now, if it has one (e.g. before spawning it) */
+    void Flush(UNiagaraSystem* System);
+
+    /**
+     * Flush System and wait for its compilation, then set Response's "compile"
+     * field to BuildCompileStatus. With a deferrable dispatch the wait is polled
+     * on the ticker, Response is sent when done and nullptr is returned;
+     * otherwise this blocks and returns Response.
+     */
+    TSharedPtr<FJsonObject> WaitForCompile(UNiagaraSystem* System, double TimeoutSeconds, const TSharedPtr<FJsonObject>& Response);
+
+    /** {ready, compiling, emitters: [{name, enabled, sim_target, ready}]} */
+    static TSharedPtr<FJsonObject> BuildCompileStatus(UNiagaraSystem* System);
+
+    /** Issue every queued compile and answer pending waits (bridge shutdown) */
+    void Shutdown();
+
+private:
+    struct FWaiter
+    {
+        TWeakObjectPtr<UNiagaraSystem> System;
+        TSharedPtr<FJsonObject> Response;
+        FUnrealCompanionDeferredResponse::FCompletion Completion;
+        double StartTime = 0.0;
+        double Deadline = 0.0;
+    };
+
+    void IssuePending();
+    void EnsureTicker();
+    bool Tick(float DeltaTime);
+
+    static void CompleteWaiter(FWaiter& Waiter, bool bTimedOut);
+
+    /** Insertion-ordered so systems compile in the order they were first touched */
+    TArray<TWeakObjectPtr<UNiagaraSystem>> Pending;
+    TArray<FWaiter> Waiters;
+    FTSTicker::FDelegateHandle TickerHandle;
+};
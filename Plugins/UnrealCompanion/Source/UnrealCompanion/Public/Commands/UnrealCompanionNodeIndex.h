@@ -0,0 +1,125 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+
+class UBlueprint;
+
+/**
+ * Project-wide index of Blueprint graph nodes, for core_query type="node" with
+ * no blueprint_name ("every node calling SetTimerByFunctionName").
+ *
+ * Each Blueprint is summarised once into a flat list of node records (graph,
+ * guid, class, title, kind and the function/event/variable it refers to). The
+ * summaries are saved under Saved/UnrealCompanion and keyed by the package's
+ * saved hash from the AssetRegistry, so a later session answers from disk
+ * without loading packages; a Blueprint that is loaded and dirty, or was saved
+ * since it was summarised, is re-read from memory. Blueprints with no valid
+ * summary are reported as unindexed until IndexBlueprints (a job) loads them.
+ *
+ * Summaries are immutable once built: Search takes a snapshot on the game
+ * thread and scans it with ParallelFor, one Blueprint per work item.
+ */
+class UNREALCOMPANION_API FUnrealCompanionNodeIndex
+{
+public:
+    static FUnrealCompanionNodeIndex& Get();
+
+    enum class ENodeKind : uint8
+    {
+        Other,
+        FunctionCall,
+        Event,
+        VariableGet,
+        VariableSet,
+        Macro
+    };
+
+    struct FNodeRecord
+    {
+        FName Graph;
+        FGuid NodeGuid;
+        FName NodeClass;
+        FString Title;
+        ENodeKind Kind = ENodeKind::Other;
+        // Function, event, variable or macro the node refers to, and the class that owns it
+        FName Member;
+        FName MemberParent;
+
+        /** Cache file layout (FMemoryArchive writes names as strings) */
+        friend FArchive& operator<<(FArchive& Ar, FNodeRecord& Node);
+    };
+
+    struct FBlueprintRecord
+    {
+        FString ObjectPath;
+        FIoHash SavedHash;
+        TArray<FNodeRecord> Nodes;
+    };
+
+    struct FQuery
+    {
+        /** Matches Member, else Title: wildcard if it has * or ?, substring otherwise (case-insensitive) */
+        FString Pattern;
+        /** Substring of the node class name */
+        FString NodeClass;
+        /** Substring of the member's owning class (e.g. "KismetSystemLibrary") */
+        FString MemberParent;
+        /** Substring of an event name; only event nodes match */
+        FString Event;
+        FString Graph;
+        /** Long package path the Blueprints must be under */
+        FString Path = TEXT("/Game");
+        int32 MaxResults = 100;
+    };
+
+    struct FMatch
+    {
+        TSharedPtr<const FBlueprintRecord> Blueprint;
+        int32 NodeIndex = INDEX_NONE;
+    };
+
+    struct FSearchResult
+    {
+        /** In Blueprint path order, then graph order */
+        TArray<FMatch> Matches;
+        int32 TotalMatches = 0;
+        int32 SearchedBlueprints = 0;
+        int32 IndexedFromMemory = 0;
+        int32 FromCache = 0;
+        TArray<FString> Unindexed;
+        double SearchMs = 0.0;
+    };
+
+    /** Game thread: refresh what memory can refresh, then search the snapshot in parallel */
+    FSearchResult Search(const FQuery& Query);
+
+    /**
+     * Start a job that loads and summarises the given Blueprints a few per
+     * tick, saving the cache when done. Returns the job id.
+     */
+    FString IndexBlueprints(const TArray<FString>& ObjectPaths, bool bStreamProgress = false);
+
+    static const TCHAR* GetKindName(ENodeKind Kind);
+
+    /** Write the cache to disk and drop everything */
+    void Shutdown();
+
+private:
+    void EnsureLoaded();
+    void SaveCache();
+    static FString GetCachePath();
+
+    static TSharedPtr<const FBlueprintRecord> BuildRecord(UBlueprint* Blueprint, const FIoHash& SavedHash);
+    static bool MatchesRecord(const FNodeRecord& Node, const FQuery& Query);
+
+    /** Object path -> summary */
+    TMap<FString, TSharedPtr<const FBlueprintRecord>> Records;
+    bool bLoaded = false;
+    bool bCacheDirty = false;
+
+    // Blueprints waiting for the indexing job
+    TArray<FString> IndexQueue;
+    int32 IndexQueueNext = 0;
+    FString IndexJobId;
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Containers/Ticker.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Commands/UnrealCompanionDeferredResponse.h"
+
+class UPackage;
+
+/**
+ * Batched package saving for asset_save_all, core_save and the editor-focus auto-save.
+ *
+ * Content packages are serialized with SAVE_Async, so disk writes overlap the
+ * serialization of the next package; the batch waits for outstanding writes
+ * once at the end. Map packages go through the editor's own map save path.
+ *
+ * Large batches run time-sliced on the core ticker within the scheduler's
+ * game-thread budget, so the editor keeps ticking while hundreds of packages
+ * are written; the reply is deferred until the last one is on disk and
+ * core_save scope="status" reports progress meanwhile. StartJob runs the same
+ * batch as a cancellable job (FUnrealCompanionJobManager) and replies at once.
+ *
+ * Game thread only. One batch at a time.
+ */
+class UNREALCOMPANION_API FUnrealCompanionPackageSaver
+{
+public:
+    static FUnrealCompanionPackageSaver& Get();
+
+    /** Dirty, saveable packages (skips transient, /Temp and never-saved maps) */
+    static void GatherDirtyPackages(bool bIncludeMaps, bool bIncludeContent, TArray<UPackage*>& OutPackages);
+
+    /**
+     * Save the given packages: time-sliced with a deferred reply when the batch is
+     * large and the dispatch allows it, otherwise right away.
+     * Returns nullptr when the reply was deferred.
+     */
+    TSharedPtr<FJsonObject> Save(const TArray<UPackage*>& Packages, bool bAllowTimeSlicing = true);
+
+    /**
+     * Save the given packages time-sliced under a job and return the job's
+     * started response; cancelling it stops before the next package.
+     */
+    TSharedPtr<FJsonObject> StartJob(const TArray<UPackage*>& Packages, bool bStreamProgress = false);
+
+    /** Save everything now, blocking until every file is written */
+    TSharedPtr<FJsonObject> SaveNow(const TArray<UPackage*>& Packages);
+
+    bool IsSaving() const { return bSaving; }
+
+    /** Progress of the running batch (or active=false) */
+    TSharedPtr<FJsonObject> GetStatus() const;
+
+    /** Finish a running batch synchronously so nothing is lost on shutdown */
+    void Shutdown();
+
+    /** Batches at or below this size are saved in one go */
+    static constexpr int32 TimeSliceThreshold = 16;
+
+private:
+    void Reset(const TArray<UPackage*>& Packages);
+
+    /** Save the next package; false when none are left */
+    bool SaveNextPackage();
+
+    TSharedPtr<FJsonObject> BuildResult();
+
+    /** Busy response while a batch is running */
+    TSharedPtr<FJsonObject> BuildBusyResponse() const;
+
+    void StartTicking();
+    bool Tick(float DeltaTime);
+
+    bool bSaving = false;
+    TArray<TWeakObjectPtr<UPackage>> Queue;
+    int32 NextIndex = 0;
+    TArray<FString> SavedPackages;
+    TArray<FString> FailedPackages;
+    int32 MapsSaved = 0;
+    double StartTime = 0.0;
+
+    // Set while the batch runs as a job; cancelling skips the rest of the queue
+    FString JobId;
+    bool bCancelRequested = false;
+
+    FUnrealCompanionDeferredResponse::FCompletion Completion;
+    FTSTicker::FDelegateHandle TickerHandle;
+};
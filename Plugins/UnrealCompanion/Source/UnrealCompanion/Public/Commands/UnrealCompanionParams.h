@@ -0,0 +1,401 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Commands/UnrealCompanionCommonUtils.h"
+
+/**
+ * Typed, validated command parameters.
+ *
+ * A command registered with a params struct is parsed exactly once, on the
+ * connection thread before it is queued. Malformed requests are rejected with
+ * INVALID_PARAMS without costing any game-thread time, and the handler reads
+ * plain struct fields instead of repeating TryGet*Field lookups.
+ *
+ * A params struct derives from FMCPTypedParams and describes itself with a
+ * static schema:
+ *
+ *     struct FMyParams : FMCPTypedParams
+ *     {
+ *         FString AssetName;
+ *         int32 Count = 1;
+ *         static const TMCPParamSchema<FMyParams>& Schema();
+ *     };
+ *
+ *     const TMCPParamSchema<FMyParams>& FMyParams::Schema()
+ *     {
+ *         static const TMCPParamSchema<FMyParams> Instance = TMCPParamSchema<FMyParams>()
+ *             .Required(TEXT("asset_name"), &FMyParams::AssetName)
+ *             .Optional(TEXT("count"), &FMyParams::Count);
+ *         return Instance;
+ *     }
+ *
+ * Handlers keep their usual (CommandType, Params) signature and call
+ * FUnrealCompanionParams::Get<FMyParams>(Params, Error). That returns the
+ * instance the bridge parsed for the running command, or parses Params on the
+ * spot when there is none for this Params object: a group's HandleCommand
+ * called directly rather than through the bridge registry, or one handler
+ * calling another with a Params object it built itself.
+ */
+struct UNREALCOMPANION_API FMCPTypedParams
+{
+    virtual ~FMCPTypedParams() = default;
+
+    /** dry_run, verbosity, on_error, max_operations, auto_compile (schemas that opt in with WithStandardParams) */
+    FUnrealCompanionCommonUtils::FMCPStandardParams Standard;
+    bool bHasStandard = false;
+
+    /** The request object, for fields a schema leaves untyped (operation lists, property bags) */
+    TSharedPtr<FJsonObject> Raw;
+};
+
+/** Readers used by TMCPParamSchema; each returns false if the JSON value has the wrong shape */
+namespace UnrealCompanionParams
+{
+    UNREALCOMPANION_API bool ReadValue(const FJsonValue& Value, FString& Out);
+    UNREALCOMPANION_API bool ReadValue(const FJsonValue& Value, bool& Out);
+    UNREALCOMPANION_API bool ReadValue(const FJsonValue& Value, int32& Out);
+    UNREALCOMPANION_API bool ReadValue(const FJsonValue& Value, float& Out);
+    UNREALCOMPANION_API bool ReadValue(const FJsonValue& Value, double& Out);
+    UNREALCOMPANION_API bool ReadValue(const FJsonValue& Value, FVector& Out);
+    UNREALCOMPANION_API bool ReadValue(const FJsonValue& Value, FRotator& Out);
+    UNREALCOMPANION_API bool ReadValue(const FJsonValue& Value, TArray<FString>& Out);
+    UNREALCOMPANION_API bool ReadValue(const FJsonValue& Value, TSharedPtr<FJsonObject>& Out);
+    UNREALCOMPANION_API bool ReadValue(const FJsonValue& Value, TArray<TSharedPtr<FJsonValue>>& Out);
+
+    /** Expected-type wording for validation errors */
+    inline const TCHAR* DescribeType(const FString*) { return TEXT("a string"); }
+    inline const TCHAR* DescribeType(const bool*) { return TEXT("a boolean"); }
+    inline const TCHAR* DescribeType(const int32*) { return TEXT("an integer"); }
+    inline const TCHAR* DescribeType(const float*) { return TEXT("a number"); }
+    inline const TCHAR* DescribeType(const double*) { return TEXT("a number"); }
+    inline const TCHAR* DescribeType(const FVector*) { return TEXT("an [x, y, z] array"); }
+    inline const TCHAR* DescribeType(const FRotator*) { return TEXT("a [pitch, yaw, roll] array"); }
+    inline const TCHAR* DescribeType(const TArray<FString>*) { return TEXT("an array of strings"); }
+    inline const TCHAR* DescribeType(const TSharedPtr<FJsonObject>*) { return TEXT("an object"); }
+    inline const TCHAR* DescribeType(const TArray<TSharedPtr<FJsonValue>>*) { return TEXT("an array"); }
+
+    /** Type names in the exported schema (bridge_schema), read by the Python client's validator */
+    inline const TCHAR* SchemaType(const FString*) { return TEXT("string"); }
+    inline const TCHAR* SchemaType(const bool*) { return TEXT("boolean"); }
+    inline const TCHAR* SchemaType(const int32*) { return TEXT("integer"); }
+    inline const TCHAR* SchemaType(const float*) { return TEXT("number"); }
+    inline const TCHAR* SchemaType(const double*) { return TEXT("number"); }
+    inline const TCHAR* SchemaType(const FVector*) { return TEXT("vector"); }
+    inline const TCHAR* SchemaType(const FRotator*) { return TEXT("rotator"); }
+    inline const TCHAR* SchemaType(const TArray<FString>*) { return TEXT("string_array"); }
+    inline const TCHAR* SchemaType(const TSharedPtr<FJsonObject>*) { return TEXT("object"); }
+    inline const TCHAR* SchemaType(const TArray<TSharedPtr<FJsonValue>>*) { return TEXT("array"); }
+
+    /** Parse and validate the standard fields; stricter than GetStandardParams (unknown enum values are errors) */
+    UNREALCOMPANION_API bool ParseStandard(const TSharedPtr<FJsonObject>& Params,
+        FUnrealCompanionCommonUtils::FMCPStandardParams& Out, FString& OutError);
+
+    /** The standard fields ParseStandard rejects values of, as schema fields */
+    UNREALCOMPANION_API TArray<TSharedPtr<FJsonValue>> DescribeStandard();
+}
+
+/**
+ * Declarative field list for one params struct. Built once (function-local
+ * static) and read-only afterwards, so Parse is safe from any thread.
+ */
+template <typename ParamsType>
+class TMCPParamSchema
+{
+public:
+    template <typename MemberType, typename OwnerType>
+    TMCPParamSchema& Required(const TCHAR* Name, MemberType OwnerType::* Member)
+    {
+        AddField(Name, Member, true);
+        return *this;
+    }
+
+    template <typename MemberType, typename OwnerType>
+    TMCPParamSchema& Optional(const TCHAR* Name, MemberType OwnerType::* Member)
+    {
+        AddField(Name, Member, false);
+        return *this;
+    }
+
+    /** Alternative key for the previous field (first one present wins) */
+    TMCPParamSchema& Alias(const TCHAR* Name)
+    {
+        check(Fields.Num() > 0);
+        Fields.Last().Aliases.Add(Name);
+        return *this;
+    }
+
+    /** Restrict the previous (string) field to a fixed set of values, compared case-insensitively; empty passes */
+    TMCPParamSchema& OneOf(std::initializer_list<const TCHAR*> Values)
+    {
+        check(Fields.Num() > 0);
+        for (const TCHAR* Value : Values)
+        {
+            Fields.Last().AllowedValues.Add(Value);
+        }
+        return *this;
+    }
+
+    /** Also parse and validate dry_run, verbosity, on_error, max_operations and auto_compile */
+    TMCPParamSchema& WithStandardParams()
+    {
+        bStandardParams = true;
+        return *this;
+    }
+
+    /**
+     * Whole-request check run after every field parsed (cross-field rules, nested
+     * operation lists). Runs on the connection thread like the rest of Parse, so it
+     * must not touch UObjects; it may fill derived fields of the struct.
+     */
+    TMCPParamSchema& Validate(TFunction<bool(ParamsType&, FString&)> InValidator)
+    {
+        Validator = MoveTemp(InValidator);
+        return *this;
+    }
+
+    bool Parse(const TSharedPtr<FJsonObject>& Params, ParamsType& Out, FString& OutError) const
+    {
+        Out.Raw = Params;
+        if (bStandardParams)
+        {
+            if (!UnrealCompanionParams::ParseStandard(Params, Out.Standard, OutError))
+            {
+                return false;
+            }
+            Out.bHasStandard = true;
+        }
+
+        for (const FField& Field : Fields)
+        {
+            const FString* FoundName = nullptr;
+            TSharedPtr<FJsonValue> Value = FindValue(Params, Field, FoundName);
+            if (!Value.IsValid())
+            {
+                if (Field.bRequired)
+                {
+                    OutError = Field.Aliases.Num() > 0
+                        ? FString::Printf(TEXT("Missing required parameter '%s' (or '%s')"), *Field.Name, *FString::Join(Field.Aliases, TEXT("', '")))
+                        : FString::Printf(TEXT("Missing required parameter '%s'"), *Field.Name);
+                    return false;
+                }
+                continue;
+            }
+            if (!Field.Read(*Value, Out))
+            {
+                OutError = FString::Printf(TEXT("Parameter '%s' must be %s"), **FoundName, Field.TypeName);
+                return false;
+            }
+            if (Field.AllowedValues.Num() > 0)
+            {
+                // An empty string means "no filter", as it did before validation existed
+                FString Text;
+                Value->TryGetString(Text);
+                if (!Text.IsEmpty() && !Field.AllowedValues.ContainsByPredicate([&Text](const FString& Allowed) { return Allowed.Equals(Text, ESearchCase::IgnoreCase); }))
+                {
+                    OutError = FString::Printf(TEXT("Parameter '%s' must be one of: %s (got '%s')"),
+                        **FoundName, *FString::Join(Field.AllowedValues, TEXT(", ")), *Text);
+                    return false;
+                }
+            }
+        }
+        return !Validator || Validator(Out, OutError);
+    }
+
+    /**
+     * The schema as data: {fields: [{name, type, required, aliases, one_of}],
+     * standard, server_checks}. server_checks is set when a Validate rule adds
+     * checks the field list cannot express.
+     */
+    TSharedPtr<FJsonObject> Describe() const
+    {
+        TArray<TSharedPtr<FJsonValue>> FieldValues;
+        for (const FField& Field : Fields)
+        {
+            TSharedPtr<FJsonObject> FieldObj = MakeShared<FJsonObject>();
+            FieldObj->SetStringField(TEXT("name"), Field.Name);
+            FieldObj->SetStringField(TEXT("type"), Field.SchemaTypeName);
+            FieldObj->SetBoolField(TEXT("required"), Field.bRequired);
+            if (Field.Aliases.Num() > 0)
+            {
+                FieldObj->SetArrayField(TEXT("aliases"), ToJsonStrings(Field.Aliases));
+            }
+            if (Field.AllowedValues.Num() > 0)
+            {
+                FieldObj->SetArrayField(TEXT("one_of"), ToJsonStrings(Field.AllowedValues));
+            }
+            FieldValues.Add(MakeShared<FJsonValueObject>(FieldObj));
+        }
+
+        TSharedPtr<FJsonObject> SchemaObj = MakeShared<FJsonObject>();
+        SchemaObj->SetArrayField(TEXT("fields"), FieldValues);
+        if (bStandardParams)
+        {
+            SchemaObj->SetArrayField(TEXT("standard"), UnrealCompanionParams::DescribeStandard());
+        }
+        SchemaObj->SetBoolField(TEXT("server_checks"), (bool)Validator);
+        return SchemaObj;
+    }
+
+private:
+    struct FField
+    {
+        FString Name;
+        TArray<FString> Aliases;
+        TArray<FString> AllowedValues;
+        const TCHAR* TypeName = TEXT("");
+        const TCHAR* SchemaTypeName = TEXT("");
+        bool bRequired = false;
+        TFunction<bool(const FJsonValue&, ParamsType&)> Read;
+    };
+
+    template <typename MemberType, typename OwnerType>
+    void AddField(const TCHAR* Name, MemberType OwnerType::* Member, bool bRequired)
+    {
+        static_assert(std::is_base_of_v<OwnerType, ParamsType>, "Member must belong to the params struct or one of its bases");
+
+        FField& Field = Fields.AddDefaulted_GetRef();
+        Field.Name = Name;
+        Field.bRequired = bRequired;
+        Field.TypeName = UnrealCompanionParams::DescribeType(static_cast<const MemberType*>(nullptr));
+        Field.SchemaTypeName = UnrealCompanionParams::SchemaType(static_cast<const MemberType*>(nullptr));
+        Field.Read = [Member](const FJsonValue& Value, ParamsType& Out)
+        {
+            return UnrealCompanionParams::ReadValue(Value, static_cast<OwnerType&>(Out).*Member);
+        };
+    }
+
+    static TArray<TSharedPtr<FJsonValue>> ToJsonStrings(const TArray<FString>& Values)
+    {
+        TArray<TSharedPtr<FJsonValue>> Out;
+        for (const FString& Value : Values)
+        {
+            Out.Add(MakeShared<FJsonValueString>(Value));
+        }
+        return Out;
+    }
+
+    /** JSON null counts as absent, like TryGet*Field */
+    static TSharedPtr<FJsonValue> FindValue(const TSharedPtr<FJsonObject>& Params, const FField& Field, const FString*& OutName)
+    {
+        if (!Params.IsValid())
+        {
+            return nullptr;
+        }
+        TSharedPtr<FJsonValue> Value = Params->TryGetField(Field.Name);
+        if (Value.IsValid() && !Value->IsNull())
+        {
+            OutName = &Field.Name;
+            return Value;
+        }
+        for (const FString& Alias : Field.Aliases)
+        {
+            Value = Params->TryGetField(Alias);
+            if (Value.IsValid() && !Value->IsNull())
+            {
+                OutName = &Alias;
+                return Value;
+            }
+        }
+        return nullptr;
+    }
+
+    TArray<FField> Fields;
+    bool bStandardParams = false;
+    TFunction<bool(ParamsType&, FString&)> Validator;
+};
+
+/**
+ * Registry glue and per-command access to parsed params.
+ */
+class UNREALCOMPANION_API FUnrealCompanionParams
+{
+public:
+    /** Type-erased parser stored in the command registry. Returns null and fills OutError on invalid input. */
+    using FParser = TFunction<TSharedPtr<const FMCPTypedParams>(const TSharedPtr<FJsonObject>&, FString&)>;
+
+    /** Type-erased TMCPParamSchema::Describe stored in the command registry */
+    using FDescriber = TFunction<TSharedPtr<FJsonObject>()>;
+
+    /** Identity of a params type (its schema's address) */
+    template <typename ParamsType>
+    static const void* GetSchemaKey()
+    {
+        return &ParamsType::Schema();
+    }
+
+    template <typename ParamsType>
+    static FParser MakeParser()
+    {
+        return [](const TSharedPtr<FJsonObject>& Params, FString& OutError) -> TSharedPtr<const FMCPTypedParams>
+        {
+            TSharedPtr<ParamsType> Parsed = MakeShared<ParamsType>();
+            if (!ParamsType::Schema().Parse(Params, *Parsed, OutError))
+            {
+                return nullptr;
+            }
+            return Parsed;
+        };
+    }
+
+    template <typename ParamsType>
+    static FDescriber MakeDescriber()
+    {
+        return []() { return ParamsType::Schema().Describe(); };
+    }
+
+    /**
+     * Params for the running command: the bridge's pre-parsed instance when it
+     * belongs to this exact Params object, otherwise a fresh parse.
+     * @return null (with OutError set) if Params fail validation
+     */
+    template <typename ParamsType>
+    static TSharedPtr<const ParamsType> Get(const TSharedPtr<FJsonObject>& Params, FString& OutError)
+    {
+        if (TSharedPtr<const FMCPTypedParams> Current = FindCurrent(Params, GetSchemaKey<ParamsType>()))
+        {
+            return StaticCastSharedPtr<const ParamsType>(Current);
+        }
+
+        TSharedPtr<ParamsType> Parsed = MakeShared<ParamsType>();
+        if (!ParamsType::Schema().Parse(Params, *Parsed, OutError))
+        {
+            return nullptr;
+        }
+        return Parsed;
+    }
+
+    /** Standard params already parsed for this Params object, if any (any schema) */
+    static const FUnrealCompanionCommonUtils::FMCPStandardParams* FindStandard(const TSharedPtr<FJsonObject>& Params);
+
+    /** Bridge side: exposes the pre-parsed params to the handler called inside this scope */
+    class FScope
+    {
+    public:
+        FScope(TSharedPtr<const FMCPTypedParams> InParsed, const void* InSchemaKey);
+        ~FScope();
+
+    private:
+        friend class FUnrealCompanionParams;
+
+        TSharedPtr<const FMCPTypedParams> Parsed;
+        const void* SchemaKey = nullptr;
+        FScope* Previous = nullptr;
+    };
+
+private:
+    /** Pre-parsed params for exactly this Params object; SchemaKey null matches any schema */
+    static TSharedPtr<const FMCPTypedParams> FindCurrent(const TSharedPtr<FJsonObject>& Params, const void* SchemaKey);
+
+    static thread_local FScope* CurrentScope;
+};
+
+/**
+ * Params for commands that only need the standard fields validated up front
+ * (the *_batch commands); everything else stays in Raw.
+ */
+struct UNREALCOMPANION_API FMCPStandardOnlyParams : FMCPTypedParams
+{
+    static const TMCPParamSchema<FMCPStandardOnlyParams>& Schema();
+};
@@ -2,14 +2,23 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/UnrealCompanionCommandTable.h"
 
 /**
  * Python Commands for UnrealCompanion
- * 
+ *
  * Handles Python code execution within Unreal Engine:
  * - python_execute: Execute Python code
  * - python_execute_file: Execute Python file
  * - python_list_modules: List available modules
+ *
+ * With a "context" or a "result" expression, code runs through a small
+ * runtime module installed in the interpreter once per session: each named
+ * context is a globals dict that survives between calls (imports and helpers
+ * stay loaded), compiled code objects are cached by content hash so a repeated
+ * script is not re-parsed or even re-sent, and "result" is evaluated in the
+ * context and returned as JSON along with the captured stdout and any traceback.
+ * Without either, code runs in __main__ as before.
  */
 class UNREALCOMPANION_API FUnrealCompanionPythonCommands
 {
@@ -18,8 +27,28 @@ public:
 
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Commands this group answers, registered by the bridge */
+    static TConstArrayView<TMCPCommandEntry<FUnrealCompanionPythonCommands>> GetCommandTable();
+
 private:
     TSharedPtr<FJsonObject> HandleExecute(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleExecuteFile(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleListModules(const TSharedPtr<FJsonObject>& Params);
+
+    /** True for calls that ask for a context, a result or a context reset */
+    static bool WantsRuntime(const TSharedPtr<FJsonObject>& Params);
+
+    /** Run Code (compiled as Filename) in the context named by Params through the runtime */
+    TSharedPtr<FJsonObject> RunInContext(const FString& Code, const FString& Filename, const TSharedPtr<FJsonObject>& Params);
+
+    /** Install the runtime module if this session has not yet */
+    bool EnsureRuntime(FString& OutError);
+
+    bool bRuntimeReady = false;
+
+    /**
+     * Hashes the runtime has compiled; those calls send only the hash. The
+     * runtime evicts on its own and answers "missing_code", which resends.
+     */
+    TSet<FString> CompiledHashes;
 };
@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
 
+class UWorld;
+class UWorldPartition;
+
 /**
  * Unified query commands for UnrealCompanion.
  * Handles searches across assets, actors, nodes, and folders.
@@ -19,11 +22,18 @@ private:
     static TSharedPtr<FJsonObject> HandleQuery(const TSharedPtr<FJsonObject>& Params);
     static TSharedPtr<FJsonObject> HandleGetInfo(const TSharedPtr<FJsonObject>& Params);
     static TSharedPtr<FJsonObject> HandleSave(const TSharedPtr<FJsonObject>& Params);
+    static TSharedPtr<FJsonObject> HandleSession(const TSharedPtr<FJsonObject>& Params);
     
     // Query type-specific handlers
     static TSharedPtr<FJsonObject> QueryAsset(const TSharedPtr<FJsonObject>& Params);
     static TSharedPtr<FJsonObject> QueryActor(const TSharedPtr<FJsonObject>& Params);
+    /** Actors of a World Partition map from their descriptors, loaded or not; also load/unload */
+    static TSharedPtr<FJsonObject> QueryActorDescriptors(const TSharedPtr<FJsonObject>& Params, UWorld* World, const FString& Action);
+    /** Pin (load) or unpin the actors in guids, or those CollectMatches finds when guids is absent */
+    static TSharedPtr<FJsonObject> LoadActorDescriptors(const TSharedPtr<FJsonObject>& Params, UWorldPartition* WorldPartition,
+        bool bLoad, TFunctionRef<int32(TArray<FGuid>&, int32)> CollectMatches, bool bHasFilter);
     static TSharedPtr<FJsonObject> QueryNode(const TSharedPtr<FJsonObject>& Params);
+    static TSharedPtr<FJsonObject> QueryNodeProjectWide(const TSharedPtr<FJsonObject>& Params);
     static TSharedPtr<FJsonObject> QueryFolder(const TSharedPtr<FJsonObject>& Params);
     
     // GetInfo type-specific handlers
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Commands/UnrealCompanionDeferredResponse.h"
+
+/**
+ * Sort key of one core_query match: Number, then Text (case-insensitive),
+ * then Id (exact). Id must be unique within a query so the order is total.
+ */
+struct UNREALCOMPANION_API FUnrealCompanionQueryKey
+{
+    double Number = 0.0;
+    FString Text;
+    FString Id;
+
+    bool operator<(const FUnrealCompanionQueryKey& Other) const;
+};
+
+/**
+ * The Limit smallest keys among the matches offered, with their items, in
+ * O(log Limit) per match and O(Limit) memory. One extra is kept to tell
+ * whether anything follows the page.
+ */
+template <typename ItemType>
+class TUnrealCompanionQueryTopK
+{
+public:
+    explicit TUnrealCompanionQueryTopK(int32 InLimit) : Limit(FMath::Max(InLimit, 0)) {}
+
+    /** Whether Key is small enough to be kept */
+    bool WouldKeep(const FUnrealCompanionQueryKey& Key) const
+    {
+        return Heap.Num() <= Limit || Key < Heap.HeapTop().Key;
+    }
+
+    void Add(FUnrealCompanionQueryKey&& Key, const ItemType& Item)
+    {
+        if (!WouldKeep(Key))
+        {
+            return;
+        }
+        Heap.HeapPush(FEntry{ MoveTemp(Key), Item }, FLargestFirst());
+        if (Heap.Num() > Limit + 1)
+        {
+            Heap.HeapPopDiscard(FLargestFirst(), EAllowShrinking::No);
+        }
+    }
+
+    struct FEntry
+    {
+        FUnrealCompanionQueryKey Key;
+        ItemType Item;
+    };
+
+    /** The page in ascending key order; bOutHasMore if a match was left out */
+    TArray<FEntry> TakeSorted(bool& bOutHasMore)
+    {
+        TArray<FEntry> Sorted = MoveTemp(Heap);
+        Sorted.Sort([](const FEntry& A, const FEntry& B) { return A.Key < B.Key; });
+        bOutHasMore = Sorted.Num() > Limit;
+        if (bOutHasMore)
+        {
+            Sorted.SetNum(Limit);
+        }
+        return Sorted;
+    }
+
+private:
+    struct FLargestFirst
+    {
+        bool operator()(const FEntry& A, const FEntry& B) const { return B.Key < A.Key; }
+    };
+
+    int32 Limit;
+    TArray<FEntry> Heap;
+};
+
+/**
+ * Paging and streaming of core_query results.
+ *
+ * A sorted query returns at most max_results matches in key order, plus a
+ * next_cursor when more remain. The cursor holds the last key returned
+ * (keyset paging, not an offset), so actors or assets added or removed
+ * between pages neither shift nor repeat the ones after it. It is bound to
+ * the query's filters and sort: reusing it with other filters is an error.
+ *
+ * sort="none" keeps the scan order and returns matches as they are found;
+ * such a query has no cursor.
+ *
+ * With stream=true, a client that can receive events (pipelined requests)
+ * gets the results as "query_results" event frames of chunk_size matches,
+ * and the final reply carries only the counts and the cursor. JSON is only
+ * ever built for one chunk at a time.
+ */
+class UNREALCOMPANION_API FUnrealCompanionQueryPager
+{
+public:
+    static constexpr int32 DefaultPageSize = 100;
+    static constexpr int32 DefaultChunkSize = 256;
+
+    /** Reads sort, cursor, max_results, stream and chunk_size; Sorts lists the sort names this query type knows */
+    FUnrealCompanionQueryPager(const TSharedPtr<FJsonObject>& Params, const FString& DefaultSort, std::initializer_list<const TCHAR*> Sorts);
+
+    bool IsValid() const { return Error.IsEmpty(); }
+    TSharedPtr<FJsonObject> CreateErrorResponse() const;
+
+    const FString& GetSort() const { return Sort; }
+    bool IsSorted() const { return Sort != TEXT("none"); }
+    int32 GetPageSize() const { return PageSize; }
+
+    /** Whether a match sorts after the cursor (always true without one) */
+    bool IsAfterCursor(const FUnrealCompanionQueryKey& Key) const;
+
+    /** Append one result in page order; flushed as an event once a chunk is full */
+    void Emit(const TSharedPtr<FJsonObject>& Result);
+    int32 GetEmitted() const { return Emitted; }
+
+    /** More matches follow the last one emitted, which had LastKey */
+    void SetNextCursor(const FUnrealCompanionQueryKey& LastKey);
+
+    /**
+     * Page one scan. ForEachMatch(Visit) calls Visit(Item) for every match in
+     * scan order; MakeKey(Item) is only called in sorted mode, ToJson(Item)
+     * only for the matches on the page. Returns the number of matches.
+     */
+    template <typename ItemType, typename ForEachMatchFn, typename MakeKeyFn, typename ToJsonFn>
+    int32 Page(ForEachMatchFn&& ForEachMatch, MakeKeyFn&& MakeKey, ToJsonFn&& ToJson)
+    {
+        int32 Matched = 0;
+        if (!IsSorted())
+        {
+            // As found: the first chunk goes out before the scan is over
+            ForEachMatch([&](const ItemType& Item)
+            {
+                if (Matched++ < PageSize)
+                {
+                    Emit(ToJson(Item));
+                }
+            });
+            bHasMore = Matched > Emitted;
+            return Matched;
+        }
+
+        TUnrealCompanionQueryTopK<ItemType> TopK(PageSize);
+        ForEachMatch([&](const ItemType& Item)
+        {
+            ++Matched;
+            FUnrealCompanionQueryKey Key = MakeKey(Item);
+            if (IsAfterCursor(Key))
+            {
+                TopK.Add(MoveTemp(Key), Item);
+            }
+        });
+
+        bool bMore = false;
+        TArray<typename TUnrealCompanionQueryTopK<ItemType>::FEntry> Entries = TopK.TakeSorted(bMore);
+        for (const typename TUnrealCompanionQueryTopK<ItemType>::FEntry& Entry : Entries)
+        {
+            Emit(ToJson(Entry.Item));
+        }
+        if (bMore && Entries.Num() > 0)
+        {
+            SetNextCursor(Entries.Last().Key);
+        }
+        return Matched;
+    }
+
+    /** Flush the last chunk and write count, results (unless streamed), sort, next_cursor and has_more */
+    void Finish(const TSharedPtr<FJsonObject>& ResultObj);
+
+private:
+    void FlushChunk();
+    FString EncodeCursor(const FUnrealCompanionQueryKey& Key) const;
+    bool DecodeCursor(const FString& Encoded);
+
+    FString Sort;
+    /** Hash of every param that changes what matches, so a cursor cannot cross queries */
+    uint32 QueryHash = 0;
+    TOptional<FUnrealCompanionQueryKey> Cursor;
+    int32 PageSize = DefaultPageSize;
+    int32 ChunkSize = DefaultChunkSize;
+    FString Error;
+    /** Set for errors that are not about the cursor (unknown sort); empty = INVALID_CURSOR */
+    FString ParamsErrorHint;
+
+    FUnrealCompanionDeferredResponse::FEventSink EventSink;
+    TArray<TSharedPtr<FJsonValue>> Results;
+    int32 Emitted = 0;
+    int32 ChunksSent = 0;
+    FString NextCursor;
+    bool bHasMore = false;
+};
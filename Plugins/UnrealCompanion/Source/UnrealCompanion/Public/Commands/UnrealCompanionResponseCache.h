@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/ObjectSaveContext.h"
+
+struct FAssetData;
+struct FPropertyChangedEvent;
+class UPackage;
+
+/**
+ * Replies of the idempotent info reads (core_get_info, material_get_info,
+ * blueprint_get_info), kept so that asking again about an unchanged asset is
+ * answered on the connection thread without queuing for the game thread.
+ *
+ * An entry is keyed by the command and its params in canonical form (keys
+ * sorted, request_id left out) and remembers the packages it was read from:
+ * the target asset's, plus its parent materials or parent Blueprints. Each
+ * watched package has a revision, bumped when it is dirtied, modified, edited
+ * or saved; an entry is only served while every one of its revisions is the
+ * one it was read at. Assets added, removed or renamed bump a global epoch,
+ * since they can change what a name resolves to, and so does a Blueprint
+ * compile, which reaches classes beyond the one compiled.
+ *
+ * Lookups are thread-safe; Store and the invalidation delegates run on the
+ * game thread. Failed replies and actor info are never kept.
+ */
+class UNREALCOMPANION_API FUnrealCompanionResponseCache
+{
+public:
+    static FUnrealCompanionResponseCache& Get();
+
+    /** Oldest-used entries are dropped past this */
+    static constexpr int32 MaxEntries = 256;
+
+    /** Subscribe to the invalidation delegates (game thread) */
+    void Initialize();
+
+    /** Unsubscribe and drop every entry */
+    void Shutdown();
+
+    /** Whether replies to this command and params may be kept */
+    static bool IsCacheable(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+    /** The kept reply for this request if nothing it was read from changed since; null otherwise. Any thread. */
+    TSharedPtr<FJsonObject> Find(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+    /** Count of changes seen so far; capture it before running a handler and pass it to Store */
+    uint64 GetGeneration() const;
+
+    /**
+     * Keep a successful reply. Skipped if anything changed while the handler ran
+     * or its target cannot be resolved to a loaded asset. Game thread.
+     */
+    void Store(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonObject>& Result, uint64 ReadGeneration);
+
+    /** Forget everything (e.g. after an operation the delegates do not see) */
+    void Invalidate();
+
+    /** {entries, hits, misses, stores, hit_rate} for bridge_metrics */
+    TSharedPtr<FJsonObject> BuildReport() const;
+
+    void ResetStats();
+
+private:
+    struct FEntry
+    {
+        TSharedPtr<FJsonObject> Result;
+        uint64 Epoch = 0;
+        /** Package name and its revision when the reply was read */
+        TArray<TPair<FName, uint64>, TInlineAllocator<4>> Packages;
+        double LastUsed = 0.0;
+    };
+
+    static FString MakeKey(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+    /** Packages the reply depends on, target first; false if the target is not loaded */
+    static bool ResolvePackages(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, TArray<FName, TInlineAllocator<4>>& OutPackages);
+
+    void BumpPackage(const UPackage* Package);
+    void BumpPackage(FName PackageName);
+    void BumpEpoch();
+
+    void OnObjectChanged(UObject* Object);
+    void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+    void OnPackageDirtied(UPackage* Package, bool bWasDirty);
+    void OnPackageSaved(const FString& Filename, UPackage* Package, FObjectPostSaveContext Context);
+    void OnAssetAdded(const FAssetData& AssetData);
+    void OnAssetRemoved(const FAssetData& AssetData);
+    void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+    void OnBlueprintCompiled();
+
+    mutable FCriticalSection Lock;
+    TMap<FString, FEntry> Entries;
+    /** Revision of every package an entry depends on */
+    TMap<FName, uint64> Revisions;
+    uint64 Epoch = 0;
+    /** Every change seen, watched or not */
+    uint64 Generation = 0;
+
+    uint64 Hits = 0;
+    uint64 Misses = 0;
+    uint64 Stores = 0;
+
+    FDelegateHandle ObjectModifiedHandle;
+    FDelegateHandle PropertyChangedHandle;
+    FDelegateHandle PackageDirtiedHandle;
+    FDelegateHandle PackageSavedHandle;
+    FDelegateHandle AssetAddedHandle;
+    FDelegateHandle AssetRemovedHandle;
+    FDelegateHandle AssetRenamedHandle;
+    FDelegateHandle BlueprintCompiledHandle;
+};
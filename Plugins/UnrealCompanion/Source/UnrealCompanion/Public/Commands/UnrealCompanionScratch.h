@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/MemStack.h"
+
+/**
+ * Per-command scratch memory.
+ *
+ * The bridge opens an FScope around every top-level handler call: a mark on the
+ * calling thread's FMemStack, popped when the handler returns. Containers built
+ * on FAllocator (TScratchArray, TScratchMap, TScratchSet) take their storage
+ * from that stack with a pointer bump and free nothing until the mark pops, so
+ * a batch's ref maps and lookup memos cost no global-allocator traffic and
+ * leave no fragmentation behind. A scope opened while another is active on the
+ * same thread (a handler running another group's HandleCommand, as viewport
+ * sequences do with environment_configure) marks nothing: its allocations are
+ * freed with the outer command's.
+ *
+ * Only for locals whose lifetime ends inside the handler call. Never put a
+ * scratch container in a response, a cache, a typed params struct or a lambda
+ * that outlives the call (deferred replies, jobs). Element destructors still
+ * run, so FString and TSharedPtr elements are fine; their own heap storage is
+ * not scratch.
+ */
+class UNREALCOMPANION_API FUnrealCompanionScratch
+{
+public:
+    using FAllocator = TMemStackAllocator<>;
+    using FSetAllocator = TSetAllocator<TSparseArrayAllocator<FAllocator, FAllocator>, TInlineAllocator<1, FAllocator>>;
+
+    /** True while a scope is open on this thread */
+    static bool IsActive();
+
+    /** Bridge side (or any code running handlers outside the bridge): scratch lifetime of one command */
+    class FScope
+    {
+    public:
+        FScope();
+        ~FScope();
+
+        FScope(const FScope&) = delete;
+        FScope& operator=(const FScope&) = delete;
+
+    private:
+        /** Only the outermost scope on a thread marks the stack */
+        TOptional<FMemMark> Mark;
+    };
+
+private:
+    static thread_local int32 Depth;
+};
+
+template <typename ElementType>
+using TScratchArray = TArray<ElementType, FUnrealCompanionScratch::FAllocator>;
+
+template <typename KeyType, typename ValueType>
+using TScratchMap = TMap<KeyType, ValueType, FUnrealCompanionScratch::FSetAllocator>;
+
+template <typename ElementType>
+using TScratchSet = TSet<ElementType, DefaultKeyFuncs<ElementType>, FUnrealCompanionScratch::FSetAllocator>;
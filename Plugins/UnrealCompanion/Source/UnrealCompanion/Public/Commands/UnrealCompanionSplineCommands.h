@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/UnrealCompanionCommandTable.h"
 
 /**
  * Spline Commands for UnrealCompanion
@@ -9,6 +10,9 @@
  * Handles spline actor operations:
  * - spline_create: Create a spline actor with points (or add points to existing)
  * - spline_scatter_meshes: Scatter static mesh instances along a spline
+ * - spline_sample: Evaluate many points along a spline in one call
+ *
+ * Scatter and sample both go through FUnrealCompanionSplineSampler.
  */
 class UNREALCOMPANION_API FUnrealCompanionSplineCommands
 {
@@ -17,9 +21,16 @@ public:
 
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Commands this group answers, registered by the bridge */
+    static TConstArrayView<TMCPCommandEntry<FUnrealCompanionSplineCommands>> GetCommandTable();
+
 private:
     TSharedPtr<FJsonObject> HandleCreateSpline(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleScatterMeshes(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleSample(const TSharedPtr<FJsonObject>& Params);
+
+    /** spline_sample cap per call */
+    static constexpr int32 MaxSamples = 100000;
 
     // Helper to find an actor with a SplineComponent by name
     AActor* FindSplineActorByName(const FString& ActorName);
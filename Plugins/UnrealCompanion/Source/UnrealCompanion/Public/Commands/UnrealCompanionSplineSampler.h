@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SplineComponent.h"
+
+/**
+ * Batched evaluation of one spline (spline_sample, spline_scatter_meshes).
+ *
+ * USplineComponent's *AtDistanceAlongSpline calls binary-search the
+ * distance -> input key table on every call. The sampler copies the curves
+ * and the component transform once, converts a whole ascending list of
+ * distances to input keys in one sweep over that table, then evaluates the
+ * samples in parallel. The copy makes evaluation independent of the component,
+ * so the Sample* functions can run on any thread once constructed.
+ *
+ * Construct on the game thread.
+ */
+class UNREALCOMPANION_API FUnrealCompanionSplineSampler
+{
+public:
+    explicit FUnrealCompanionSplineSampler(const USplineComponent* Spline);
+
+    struct FSample
+    {
+        double Distance = 0.0;
+        float InputKey = 0.0f;
+        FVector Location = FVector::ZeroVector;
+        FQuat Rotation = FQuat::Identity;
+        FVector Tangent = FVector::ZeroVector;
+        FVector Scale = FVector::OneVector;
+    };
+
+    /** Below this many samples evaluation stays on the calling thread */
+    static constexpr int32 MinParallelSamples = 256;
+
+    double GetLength() const { return Length; }
+
+    /** 0, Spacing, 2*Spacing... up to the length */
+    TArray<double> MakeDistancesBySpacing(double Spacing) const;
+
+    /** Count evenly spaced distances, both ends included */
+    TArray<double> MakeDistancesByCount(int32 Count) const;
+
+    /**
+     * Evaluate every distance (clamped to the spline). Ascending distances take
+     * the single sweep; an out-of-order one restarts it with a binary search.
+     */
+    void Sample(TConstArrayView<double> Distances, ESplineCoordinateSpace::Type Space, TArray<FSample>& OutSamples) const;
+
+private:
+    float GetKeyAtDistance(double Distance, int32& InOutSegment) const;
+
+    FSplineCurves Curves;
+    FTransform ComponentTransform;
+    FVector DefaultUpVector = FVector::UpVector;
+    double Length = 0.0;
+};
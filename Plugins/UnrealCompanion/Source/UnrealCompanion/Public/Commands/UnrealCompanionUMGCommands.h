@@ -2,6 +2,9 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Containers/Ticker.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Commands/UnrealCompanionCommandTable.h"
 
 class UWidgetBlueprint;
 class UWidget;
@@ -15,6 +18,7 @@ class UNREALCOMPANION_API FUnrealCompanionUMGCommands
 {
 public:
     FUnrealCompanionUMGCommands();
+    ~FUnrealCompanionUMGCommands();
 
     /**
      * Handle UMG-related commands
@@ -24,6 +28,12 @@ public:
      */
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Commands this group answers, registered by the bridge */
+    static TConstArrayView<TMCPCommandEntry<FUnrealCompanionUMGCommands>> GetCommandTable();
+
+    /** Compile every Widget Blueprint still queued by defer_compile (bridge shutdown) */
+    void Shutdown();
+
 private:
     // =========================================================================
     // MAIN COMMANDS
@@ -42,11 +52,16 @@ private:
      * Batch widget operations: add, modify, remove widgets
      * Params:
      *   - widget_name: Target Widget Blueprint name or path
-     *   - widgets: Array of widgets to add [{ref, type, name, parent, slot, properties}]
+     *   - widgets: Array of widgets to add [{ref, type, name, parent, parent_ref, slot, properties}]
+     *     All widgets are constructed first and parented second, so parent_ref and
+     *     parent may name any widget of the batch regardless of array order.
      *   - modify: Array of modifications [{name, slot, properties}]
      *   - remove: Array of widget names to remove
      *   - on_error: "rollback", "continue", "stop"
      *   - dry_run: Validate without executing
+     *   - defer_compile: Queue the compile instead of compiling before replying;
+     *     every batch queued for the same Widget Blueprint before the next editor
+     *     tick shares one compile (default: false)
      */
     TSharedPtr<FJsonObject> HandleWidgetBatch(const TSharedPtr<FJsonObject>& Params);
 
@@ -93,4 +108,23 @@ private:
 
     /** Get supported widget types */
     static TArray<FString> GetSupportedWidgetTypes();
+
+    // =========================================================================
+    // COMPILE QUEUE
+    // =========================================================================
+
+    /** Compile now, or hand the Blueprint to an open compile session */
+    void CompileWidgetBlueprint(UWidgetBlueprint* WidgetBP);
+
+    /** Compile on the next core tick, coalesced with other requests for the same Blueprint */
+    void QueueCompile(UWidgetBlueprint* WidgetBP);
+
+    /** Compile WidgetBP now if it is queued (before something reads its generated class) */
+    void FlushCompile(UWidgetBlueprint* WidgetBP);
+
+    bool TickCompileQueue(float DeltaTime);
+
+    /** Insertion-ordered so Blueprints compile in the order they were first touched */
+    TArray<TWeakObjectPtr<UWidgetBlueprint>> PendingCompile;
+    FTSTicker::FDelegateHandle CompileTickerHandle;
 };
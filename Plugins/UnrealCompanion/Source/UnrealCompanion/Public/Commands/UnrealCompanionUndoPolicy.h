@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "UnrealCompanionSettings.h"
+
+/**
+ * Bridge-wide undo policy: how much of the editor's undo buffer commands may use.
+ *
+ * The bridge runs every game-thread command inside one editor transaction
+ * (FScope). Transactions handlers open themselves nest into it and Modify()
+ * calls of handlers that open none are recorded too, so a command or a whole
+ * batch is one undo step. The transaction always ends with the command: none
+ * stays open between commands, whatever the client does next. The "undo" param
+ * of a command (or UndoMode in the settings) picks what happens to that step:
+ *
+ *   "command"  one undo step per command
+ *   "session"  inside core_session, each command is still one undo step, named
+ *              after the session ("MCP Session <label>: <command>")
+ *   "none"     the changes stay and the step is discarded when the command
+ *              ends, so nothing is left in the undo buffer. The snapshot is
+ *              still recorded while the command runs: this does not lower a
+ *              command's peak memory, only what the buffer keeps
+ *
+ * A command whose snapshot exceeds UndoBudgetMB loses it (or, with
+ * UndoOverBudget = Reject or "undo_over_budget": "reject", is rolled back and
+ * fails).
+ *
+ * core_session abort undoes the steps the session's commands left, in any
+ * mode ("command" steps too).
+ *
+ * Commands that walk the undo history, delete assets, load or save packages,
+ * play worlds or run scripts run outside any bridge transaction. Game thread
+ * only.
+ */
+class UNREALCOMPANION_API FUnrealCompanionUndoPolicy
+{
+public:
+    static FUnrealCompanionUndoPolicy& Get();
+
+    static bool ParseMode(const FString& Text, EUnrealCompanionUndoMode& OutMode);
+    static const TCHAR* ModeToString(EUnrealCompanionUndoMode Mode);
+
+    /** core_session begin: "undo" in Params, or UndoMode from the settings */
+    bool BeginSession(const TSharedPtr<FJsonObject>& Params, const FString& Label, FString& OutError);
+
+    /** core_session commit: end the grouping. Adds the undo summary to Result. */
+    void EndSession(const TSharedPtr<FJsonObject>& Result);
+
+    /**
+     * core_session abort: undo the session's steps, newest first, and end the grouping.
+     * Stops at the first step that is no longer on top of the undo history (an edit made
+     * since sits above it); that step and older ones are kept. Changes made without an
+     * undo step ("none", or dropped over budget) cannot be rolled back.
+     */
+    void AbortSession(const TSharedPtr<FJsonObject>& Result);
+
+    /** {mode, steps, without_undo} of the open session, if any */
+    void AddStatus(const TSharedPtr<FJsonObject>& Result) const;
+
+    /** The undo scope of one bridge command */
+    class UNREALCOMPANION_API FScope
+    {
+    public:
+        FScope(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+        ~FScope();
+
+        FScope(const FScope&) = delete;
+        FScope& operator=(const FScope&) = delete;
+
+        /** A malformed "undo" or "undo_over_budget"; the command must not run */
+        const FString& GetError() const { return Error; }
+
+        /** After the handler: close the transaction and apply the budget, annotating or replacing ResultJson */
+        void Finish(TSharedPtr<FJsonObject>& ResultJson);
+
+    private:
+        FString Error;
+        EUnrealCompanionUndoMode Mode = EUnrealCompanionUndoMode::Command;
+        EUnrealCompanionUndoOverBudget OverBudget = EUnrealCompanionUndoOverBudget::DropUndo;
+        int32 TransactionIndex = INDEX_NONE;
+        bool bOwnsTransaction = false;
+    };
+
+private:
+    /** {mode, steps, without_undo} of the current or just-ended session */
+    void AddSummary(const TSharedPtr<FJsonObject>& Result) const;
+
+    /** Size of the innermost open transaction in bytes, and whether it recorded anything */
+    static int64 GetOpenTransactionSize(bool& bOutHasRecords);
+
+    static int64 GetBudgetBytes();
+
+    bool bSessionActive = false;
+    EUnrealCompanionUndoMode SessionMode = EUnrealCompanionUndoMode::Command;
+    FString SessionLabel;
+    /** Undo steps the session's commands left, oldest first */
+    TArray<FGuid> SessionStepIds;
+    /** Session commands whose changes were kept without an undo step */
+    int32 SessionWithoutUndo = 0;
+};
@@ -2,6 +2,9 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/UnrealCompanionCommandTable.h"
+
+class FUnrealCompanionEnvironmentCommands;
 
 /**
  * Viewport Commands for UnrealCompanion
@@ -11,6 +14,10 @@
  * - take_screenshot: Capture viewport screenshot
  * - get_viewport_camera: Get current camera transform
  * - set_viewport_camera: Set camera transform
+ * - viewport_capture_sequence: Capture a list of camera/environment keyframes,
+ *   one keyframe per editor frame, in a single request. Each keyframe is applied,
+ *   drawn and its readback queued on the same tick; frames stream back as
+ *   "capture_frame" events when the client can receive them.
  */
 class UNREALCOMPANION_API FUnrealCompanionViewportCommands
 {
@@ -19,11 +26,18 @@ public:
 
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Commands this group answers, registered by the bridge */
+    static TConstArrayView<TMCPCommandEntry<FUnrealCompanionViewportCommands>> GetCommandTable();
+
+    /** Environment handler used for keyframe "environment" settings (environment_configure action "apply") */
+    void SetEnvironmentCommands(const TSharedPtr<FUnrealCompanionEnvironmentCommands>& InEnvironmentCommands);
+
 private:
     TSharedPtr<FJsonObject> HandleFocusViewport(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleTakeScreenshot(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleGetViewportCamera(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetViewportCamera(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleCaptureSequence(const TSharedPtr<FJsonObject>& Params);
     
     // Play In Editor control
     TSharedPtr<FJsonObject> HandlePlay(const TSharedPtr<FJsonObject>& Params);
@@ -38,4 +52,6 @@ private:
     // Focus management
     TSharedPtr<FJsonObject> HandleFocusClose(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleFocusLevel(const TSharedPtr<FJsonObject>& Params);
+
+    TWeakPtr<FUnrealCompanionEnvironmentCommands> EnvironmentCommands;
 };
@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "EdGraph/EdGraphPin.h"
+#include "Graph/GraphTypes.h"
+#include "Misc/ScopeRWLock.h"
+
+class UEdGraphNode;
+
+/** One pin of a node as it was when the node was created */
+struct FCachedPinSignature
+{
+    FString Name;
+    FString FriendlyName;
+    bool bOutput = false;
+    bool bExec = false;
+
+    /** FEdGraphPinType, with the sub-category object kept as a path so it can be read off the game thread */
+    FName PinCategory;
+    FName PinSubCategory;
+    FString SubCategoryObjectPath;
+    EPinContainerType ContainerType = EPinContainerType::None;
+};
+
+/**
+ * Pin layouts of the nodes graph_batch has created, so a later batch can check
+ * its connections without the graph.
+ *
+ * A layout is keyed by the graph type and the node spec that produced it (type
+ * plus every creation param except ref and position): two "function_call"
+ * nodes for the same function get the same pins. Layouts that depend on
+ * Blueprint-defined members (variables, macros, Blueprint functions and events,
+ * user structs and classes) are dropped on every Blueprint compile; hot reload
+ * drops everything. Niagara layouts are not kept, their pins follow script
+ * assets.
+ *
+ * Record runs on the game thread; Find is safe from any thread.
+ */
+class UNREALCOMPANION_API FPinSignatureCache
+{
+public:
+    static FPinSignatureCache& Get();
+
+    /** Layouts beyond this are dropped wholesale; they come back as batches run */
+    static constexpr int32 MaxEntries = 4096;
+
+    /** Subscribe to Blueprint compiles and hot reload (game thread) */
+    void Initialize();
+
+    /** Unsubscribe and drop every layout */
+    void Shutdown();
+
+    static FString MakeKey(UnrealCompanionGraph::EGraphType GraphType, const TSharedPtr<FJsonObject>& NodeSpec);
+
+    /** Remember the pins of a node just created from NodeSpec. Game thread. */
+    void Record(UnrealCompanionGraph::EGraphType GraphType, const TSharedPtr<FJsonObject>& NodeSpec, const UEdGraphNode* Node);
+
+    /** The layout last recorded for this key. Any thread. */
+    bool Find(const FString& Key, TArray<FCachedPinSignature>& OutPins) const;
+
+    int32 Num() const;
+
+private:
+    struct FEntry
+    {
+        TArray<FCachedPinSignature> Pins;
+        /** Depends on something a Blueprint compile can change */
+        bool bBlueprintDependent = false;
+    };
+
+    static bool DependsOnBlueprintMembers(const UEdGraphNode* Node);
+
+    void OnBlueprintCompiled();
+    void Empty();
+
+    mutable FRWLock Lock;
+    TMap<FString, FEntry> Entries;
+
+    FDelegateHandle BlueprintCompiledHandle;
+    FDelegateHandle ReloadCompleteHandle;
+};
+
+/**
+ * Checks a whole graph_batch request without touching the editor: the target
+ * graph type comes from graph_type or the asset index, node types from
+ * FNodeFactoryRegistry and pin layouts from FPinSignatureCache. Runs on the
+ * connection thread while the request is parsed.
+ *
+ * Errors are what the batch would certainly fail on: malformed entries, node
+ * types the graph's factory does not make, duplicate or unknown refs, node ids
+ * that are not GUIDs, missing pin names, and (for nodes with a cached layout)
+ * unknown pins, exec-to-data links, links between two inputs or two outputs,
+ * and (in Blueprint-type graphs) data links between pin types that neither
+ * match, nor involve a wildcard, nor have a known autocast.
+ * Warnings cover what can only be known on the game thread: an asset not yet in
+ * the registry, connections to existing nodes or uncached node layouts, and
+ * links whose types hang on an autocast or a class/struct relationship.
+ */
+struct UNREALCOMPANION_API FGraphBatchValidation
+{
+    UnrealCompanionGraph::EGraphType GraphType = UnrealCompanionGraph::EGraphType::Unknown;
+    bool bAssetFound = false;
+
+    /** "connections[3]: ..." */
+    TArray<FString> Errors;
+    TArray<FString> Warnings;
+
+    int32 NodesPlanned = 0;
+    int32 ConnectionsPlanned = 0;
+    int32 PinValuesPlanned = 0;
+    int32 ExistingNodeOps = 0;
+
+    /** Connections whose both ends were checked against cached layouts */
+    int32 ConnectionsChecked = 0;
+
+    /** Of those, links whose pin types can only be confirmed on the game thread */
+    int32 ConnectionsTypeUnchecked = 0;
+
+    bool IsValid() const { return Errors.Num() == 0; }
+
+    /** Validate Params (the raw graph_batch request) against cached metadata */
+    static FGraphBatchValidation Run(const TSharedPtr<FJsonObject>& Params, const FString& AssetName, const FString& GraphTypeHint);
+
+    /** First errors joined, for INVALID_PARAMS */
+    FString Summarize() const;
+
+    /** dry_run reply: {dry_run, valid, errors, warnings, graph_type, would_*} */
+    TSharedPtr<FJsonObject> ToDryRunResponse() const;
+
+private:
+    void AddError(const TCHAR* Section, int32 Index, const FString& Ref, const FString& Message);
+};
@@ -0,0 +1,85 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UEdGraph;
+class UEdGraphNode;
+class FJsonObject;
+
+/**
+ * Layered (Sugiyama-style) auto-layout for any UEdGraph.
+ *
+ * Nodes are split into flow nodes, laid out in layers left to right, and data
+ * nodes, placed next to the flow nodes that consume them. In graphs with exec
+ * pins (K2) the flow is the exec wiring and pure nodes are data nodes; in graphs
+ * without (Material, Animation) every link is flow and there are no data nodes.
+ *
+ * Cost is linear in nodes + links, plus a bounded number of barycentre sweeps
+ * to reduce crossings, so it stays interactive on graphs of thousands of nodes.
+ */
+namespace UnrealCompanionLayout
+{
+    enum class EArrangeMode : uint8
+    {
+        /** Layers left to right, nodes aligned with their predecessors */
+        Layered,
+        /** Each flow on one horizontal line, data nodes stacked above */
+        Straight,
+        /** Layers with tighter vertical stacking */
+        Compact
+    };
+
+    /** "layered" (default), "straight" or "compact" */
+    EArrangeMode ParseArrangeMode(const FString& ModeString);
+    const TCHAR* GetArrangeModeName(EArrangeMode Mode);
+
+    struct FLayoutSettings
+    {
+        EArrangeMode Mode = EArrangeMode::Layered;
+        float HorizontalSpacing = 400.0f;
+        float VerticalSpacing = 150.0f;
+        /** Vertical space between separate flows */
+        float FlowSpacing = 300.0f;
+        /** Place data nodes next to their consumers rather than in a column */
+        bool bAlignDataNodes = true;
+        /** Upper bound on crossing-minimisation sweeps (each is one pass down and one up) */
+        int32 MaxCrossingSweeps = 8;
+    };
+
+    struct FLayoutResult
+    {
+        TMap<UEdGraphNode*, FVector2D> Positions;
+        int32 NodesArranged = 0;
+        int32 Flows = 0;
+        int32 MaxLayer = 0;
+        int32 DataNodes = 0;
+        /** Crossings between adjacent layers before and after minimisation */
+        int32 InitialCrossings = 0;
+        int32 Crossings = 0;
+        int32 CrossingSweeps = 0;
+
+        TSharedPtr<FJsonObject> ToJson() const;
+    };
+
+    /**
+     * Lay out Nodes (comments are skipped) considering only links between them.
+     * Positions start at the origin; nothing is written to the nodes.
+     */
+    FLayoutResult ComputeLayout(const TArray<UEdGraphNode*>& Nodes, const FLayoutSettings& Settings);
+
+    /** Lay out and move every node of Graph */
+    FLayoutResult ArrangeGraph(UEdGraph* Graph, const FLayoutSettings& Settings);
+
+    /**
+     * Incremental layout: lay out and move only Nodes, leaving the rest of Graph
+     * untouched. The block is placed right of the untouched nodes feeding into
+     * it, else left of those it feeds, else below the rest of the graph.
+     */
+    FLayoutResult ArrangeSubgraph(UEdGraph* Graph, const TArray<UEdGraphNode*>& Nodes, const FLayoutSettings& Settings);
+
+    /** Write positions to the nodes (and to Material expressions); returns nodes moved */
+    int32 ApplyLayout(const FLayoutResult& Result);
+
+} // namespace UnrealCompanionLayout
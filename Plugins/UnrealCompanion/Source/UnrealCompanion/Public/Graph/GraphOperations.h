@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Graph/GraphTypes.h"
+#include "UObject/WeakObjectPtrTemplates.h"
 
 class UEdGraph;
 class UBlueprint;
@@ -139,10 +140,66 @@ namespace UnrealCompanionGraph
     bool CompileIfNeeded(UObject* Asset, bool bForce = false, FString* OutError = nullptr);
 
     /**
-     * Mark an asset as modified (dirty)
+     * Mark an asset as modified (dirty).
+     * For a Material this also copies the graph's links into its expressions and
+     * leaves it pending a recompile (see IsCompilePending).
      */
     void MarkAsModified(UObject* Asset);
 
+    /**
+     * Whether a Material has graph edits that no PostEditChange has compiled yet.
+     * Always false for other assets.
+     */
+    bool IsCompilePending(UObject* Asset);
+
+    /**
+     * Material edits made while one is alive share a single recompile.
+     *
+     * MarkAsModified and CompileIfNeeded on a Material only record it, and pin
+     * connections skip the Material Editor's per-link refresh (which recompiles
+     * the preview material). When the outermost batch closes each recorded
+     * Material has its expression links rebuilt from the graph once and, if a
+     * compile was requested, gets one PreEditChange/PostEditChange.
+     *
+     * With bDeferShaderCompile the compile is held instead: the Material stays
+     * pending until a later CompileIfNeeded outside a deferring batch (graph_batch
+     * with auto_compile and no operations is the explicit way) or the commit of a
+     * compile session. Batches may nest; an inner batch hands its Materials to
+     * the outer one.
+     * Game thread only.
+     */
+    struct FScopedMaterialEditBatch
+    {
+        explicit FScopedMaterialEditBatch(bool bInDeferShaderCompile = false);
+        ~FScopedMaterialEditBatch();
+
+        /** Innermost live batch, or nullptr */
+        static FScopedMaterialEditBatch* Find();
+
+        /**
+         * Called before a graph edit that would refresh the Material Editor:
+         * true if Graph belongs to a Material and a batch will refresh it on close.
+         */
+        static bool DeferGraphChanged(const UEdGraph* Graph);
+
+    private:
+        friend bool CompileIfNeeded(UObject*, bool, FString*);
+        friend void MarkAsModified(UObject*);
+
+        struct FEntry
+        {
+            TWeakObjectPtr<UMaterial> Material;
+            bool bCompileRequested = false;
+            bool bGraphChanged = false;
+        };
+
+        FEntry& FindOrAdd(UMaterial* Material);
+
+        TArray<FEntry> Touched;
+        bool bDeferShaderCompile;
+        FScopedMaterialEditBatch* Outer;
+    };
+
     /**
      * Mark an asset as structurally modified (needs recompile)
      */
@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UEdGraph;
+class UEdGraphNode;
+
+/**
+ * Per-graph revision counter and per-node change stamps, for delta reads
+ * (graph_node_find / graph_node_info with since_revision).
+ *
+ * Sync hashes every node's observable state (class, position, enabled state,
+ * comment, compiler message, pins, default values and links) and compares it
+ * with the previous sync. If anything differs the graph's revision advances
+ * and the changed nodes are stamped with it. That is a hash pass over the
+ * graph, not a serialisation, so "what changed since N" costs O(graph) cheap
+ * work plus O(delta) output.
+ *
+ * Revisions come from one process-wide counter seeded from the wall clock, so a
+ * revision from another graph's history, an earlier editor session or pruned
+ * tombstones is out of range and gets a full answer rather than a wrong delta.
+ * Game thread only.
+ */
+class UNREALCOMPANION_API FGraphRevisionTracker
+{
+public:
+    static FGraphRevisionTracker& Get();
+
+    /** Removals remembered per graph; asking from before the oldest one gives a full result */
+    static constexpr int32 MaxTombstones = 4096;
+
+    struct FDelta
+    {
+        int64 Revision = 0;
+
+        /** SinceRevision was out of range: Changed holds every node and Removed is empty */
+        bool bFull = false;
+
+        /** In graph order */
+        TArray<UEdGraphNode*> Changed;
+        TArray<FGuid> Removed;
+    };
+
+    /** Bring Graph's stamps up to date; returns its current revision */
+    int64 Sync(UEdGraph* Graph);
+
+    /** Sync, then collect the nodes added or modified, and those removed, after SinceRevision */
+    FDelta GetChangesSince(UEdGraph* Graph, int64 SinceRevision);
+
+    /** Revision at which the node last changed as of the last Sync, or 0 if untracked */
+    int64 GetNodeRevision(const UEdGraph* Graph, const FGuid& NodeGuid) const;
+
+    /** Whether SinceRevision lies inside Graph's remembered history (as of the last Sync) */
+    bool IsWithinHistory(const UEdGraph* Graph, int64 SinceRevision) const;
+
+private:
+    struct FNodeStamp
+    {
+        TWeakObjectPtr<UEdGraphNode> Node;
+        uint32 Hash = 0;
+        uint32 SyncPass = 0;
+        int64 ChangedAt = 0;
+    };
+
+    struct FTombstone
+    {
+        FGuid NodeGuid;
+        int64 RemovedAt = 0;
+    };
+
+    struct FGraphState
+    {
+        TWeakObjectPtr<UEdGraph> Graph;
+        int64 Revision = 0;
+        // Oldest SinceRevision a delta can be computed from
+        int64 Horizon = 0;
+        uint32 SyncPass = 0;
+        TMap<FGuid, FNodeStamp> Nodes;
+        TArray<FTombstone> Tombstones;
+    };
+
+    FGraphState& FindOrAddState(UEdGraph* Graph);
+    int64 NextRevision();
+
+    TMap<TObjectKey<UEdGraph>, FGraphState> States;
+    int64 LastRevision = 0;
+};
@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UBlueprint;
+class UClass;
+class UEdGraph;
+class UFunction;
+enum class EModuleChangeReason;
+
+/**
+ * Kind of Blueprint node action a catalogue entry creates
+ */
+enum class ENodeCatalogKind : uint8
+{
+    Function,   // BlueprintCallable / BlueprintPure function
+    Event,      // BlueprintImplementableEvent / BlueprintNativeEvent
+    Macro       // Macro graph from a loaded macro library
+};
+
+/**
+ * One searchable node action
+ */
+struct FNodeCatalogEntry
+{
+    ENodeCatalogKind Kind = ENodeCatalogKind::Function;
+    FName Name;
+    FString NameLower;
+    FString ClassName;
+    FString Category;
+    TWeakObjectPtr<UFunction> Function;
+    TWeakObjectPtr<UEdGraph> MacroGraph;
+};
+
+/**
+ * Search hit with its relevance score (higher is better)
+ */
+struct FNodeCatalogMatch
+{
+    const FNodeCatalogEntry* Entry = nullptr;
+    int32 Score = 0;
+};
+
+/**
+ * Prebuilt catalogue of Blueprint node actions (callable functions, events, macros).
+ *
+ * Built once when the bridge starts instead of walking every UClass on each
+ * graph_node_search_available call. Newly loaded modules are added
+ * incrementally, and a Blueprint compile re-catalogues only the compiled
+ * Blueprints' generated classes (their old entries are dropped). Hot reload
+ * marks the catalogue stale and it is rebuilt on the next query.
+ *
+ * Searches go through a trigram index on lowercased names and are ranked
+ * (exact > prefix > word start > substring, shorter names first), so results
+ * are stable and a miss costs a few hash lookups. FK2NodeFactory reuses the
+ * catalogue to resolve functions and macros outside the usual libraries.
+ *
+ * Game thread only.
+ */
+class FNodeCatalog
+{
+public:
+    static FNodeCatalog& Get();
+
+    /** Subscribe to module/reload/compile events and build the catalogue */
+    void Initialize();
+    void Shutdown();
+
+    /**
+     * Ranked search.
+     * @param SearchTerm  Case-insensitive substring of the action name (empty = everything)
+     * @param ClassFilter Substring of the owning class name (empty = any)
+     */
+    void Search(const FString& SearchTerm, const FString& ClassFilter, int32 MaxResults, TArray<FNodeCatalogMatch>& OutMatches);
+
+    /** First callable function with this exact name (case-insensitive), in any class */
+    UFunction* FindFunction(FName FunctionName);
+
+    /** Macro graph with this exact name (case-insensitive) from any loaded macro library */
+    UEdGraph* FindMacro(FName MacroName);
+
+    int32 Num() { EnsureBuilt(); return Entries.Num(); }
+
+    /** Rebuild on next query */
+    void MarkStale() { bStale = true; }
+
+private:
+    void EnsureBuilt();
+    void Rebuild();
+
+    void AddClass(UClass* Class);
+    void AddMacroLibraries();
+    void AddMacroLibrary(UBlueprint* Blueprint);
+    void AddEntry(FNodeCatalogEntry&& Entry);
+
+    /** Drop the entries owned by this class (or macro library) name; returns how many */
+    int32 RemoveEntriesOf(const FString& OwnerName);
+
+    static bool ShouldCatalogueClass(const UClass* Class);
+    static int32 ScoreMatch(const FNodeCatalogEntry& Entry, const FString& TermLower);
+    static void ForEachTrigram(const FString& Lower, TFunctionRef<void(uint32)> Visitor);
+
+    void OnModulesChanged(FName ModuleName, EModuleChangeReason Reason);
+    void OnBlueprintPreCompile(UBlueprint* Blueprint);
+    void OnBlueprintCompiled();
+
+    TArray<FNodeCatalogEntry> Entries;
+    TSet<TWeakObjectPtr<UClass>> CataloguedClasses;
+
+    /** Name -> entry indices (FName keys are case-insensitive) */
+    TMap<FName, TArray<int32>> ByName;
+
+    /** Lowercase trigram -> entry indices containing it */
+    TMap<uint32, TArray<int32>> Trigrams;
+
+    /** Blueprints announced by OnBlueprintPreCompile, re-catalogued once the batch compiled */
+    TArray<TWeakObjectPtr<UBlueprint>> PendingCompiled;
+
+    /**
+     * Entries dropped since the last rebuild. They stay in Entries (indices
+     * are baked into ByName and Trigrams) with cleared object pointers, which
+     * every query already skips; a rebuild compacts them once they add up.
+     */
+    int32 NumRemoved = 0;
+
+    bool bStale = true;
+
+    FDelegateHandle ModulesChangedHandle;
+    FDelegateHandle ReloadCompleteHandle;
+    FDelegateHandle BlueprintPreCompileHandle;
+    FDelegateHandle BlueprintCompiledHandle;
+};
@@ -4,13 +4,21 @@
 
 #include "CoreMinimal.h"
 #include "Graph/NodeFactory/INodeFactory.h"
+#include "Commands/UnrealCompanionScratch.h"
 
 class UAnimBlueprint;
 class UAnimGraphNode_Base;
+class UAnimGraphNode_StateMachine;
+class UAnimStateNodeBase;
+class UAnimStateTransitionNode;
 
 /**
  * Node factory for Animation Blueprint graphs.
  * Handles creation of UAnimGraphNode-derived nodes.
+ *
+ * BuildStateMachine creates a whole state machine (states with their pose
+ * graphs, transitions with their rule graphs, the entry link) from one spec,
+ * for graph_batch "state_machines"; the caller compiles once afterwards.
  */
 class FAnimationNodeFactory : public INodeFactory
 {
@@ -43,6 +51,49 @@ public:
 
     virtual TArray<FString> GetRequiredParams(const FString& NodeType) const override;
 
+    /**
+     * Per-batch memo for sequence and blend space lookups.
+     * While one is alive (game thread), a name or path is resolved and loaded
+     * once, hits and misses alike. Batches may nest; the innermost one is used.
+     * Lives in command scratch memory: only inside a handler call.
+     */
+    struct FScopedAssetBatch
+    {
+        FScopedAssetBatch();
+        ~FScopedAssetBatch();
+
+        TScratchMap<FString, UObject*> Assets;
+
+    private:
+        friend class FAnimationNodeFactory;
+        FScopedAssetBatch* Outer;
+    };
+
+    /** What BuildStateMachine created */
+    struct FStateMachineBuild
+    {
+        UAnimGraphNode_StateMachine* MachineNode = nullptr;
+        bool bCreatedMachine = false;
+        /** State (or conduit) name -> node, including states that already existed */
+        TMap<FString, UAnimStateNodeBase*> States;
+        TArray<UAnimStateTransitionNode*> Transitions;
+        int32 StatesCreated = 0;
+        int32 PoseNodesCreated = 0;
+        int32 RulesBound = 0;
+        /** Per-item problems; the rest of the machine is still built */
+        TArray<FString> Errors;
+    };
+
+    /**
+     * Create or extend a state machine in an anim graph from Spec:
+     *   name, position, machine_id (extend an existing machine instead),
+     *   states:      [{name, position, sequence | blend_space, conduit}],
+     *   transitions: [{from, to, rule (bool variable), negate, value, automatic, crossfade, bidirectional}],
+     *   entry:       state the machine starts in
+     * Returns false with OutError only if nothing could be built.
+     */
+    bool BuildStateMachine(UEdGraph* Graph, const TSharedPtr<FJsonObject>& Spec, FStateMachineBuild& OutBuild, FString& OutError);
+
 private:
     // =========================================================================
     // Node Creation Methods
@@ -85,4 +136,13 @@ private:
 
     /** Get the Animation Blueprint from a graph */
     UAnimBlueprint* GetAnimBlueprintFromGraph(UEdGraph* Graph) const;
+
+    /** Load an asset of Class by object path or asset name, memoised by the active FScopedAssetBatch */
+    UObject* FindAnimAsset(const FString& NameOrPath, UClass* Class) const;
+
+    /** Fill a state's pose graph with a sequence or blend space player wired to its result */
+    bool BuildStatePose(UAnimStateNodeBase* State, const TSharedPtr<FJsonObject>& StateSpec, FStateMachineBuild& OutBuild);
+
+    /** Set a transition's rule from TransitionSpec (bool variable, constant or automatic) */
+    bool BuildTransitionRule(UAnimStateTransitionNode* Transition, const TSharedPtr<FJsonObject>& TransitionSpec, FStateMachineBuild& OutBuild);
 };
@@ -106,6 +106,14 @@ public:
         return Instance;
     }
 
+    /**
+     * Register the built-in factories (Blueprint, Widget, Material, Animation, Niagara).
+     * Called on the game thread before the bridge accepts connections and a no-op
+     * afterwards, so lookups (batch validation on connection threads) never race
+     * a registration.
+     */
+    void RegisterBuiltInFactories();
+
     /**
      * Register a factory for a graph type
      */
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Graph/NodeFactory/INodeFactory.h"
+#include "Commands/UnrealCompanionScratch.h"
 
 class UBlueprint;
 class UK2Node;
@@ -45,6 +46,32 @@ public:
 
     virtual TArray<FString> GetOptionalParams(const FString& NodeType) const override;
 
+    /**
+     * Per-batch memo for class and function resolution.
+     * While one is alive (game thread), every lookup — hits and misses — is answered
+     * from it after the first time, so a batch creating 200 nodes against the same
+     * class resolves it once. Batches may nest; the innermost one is used.
+     * Lives in command scratch memory: only inside a handler call.
+     */
+    struct FScopedResolutionBatch
+    {
+        FScopedResolutionBatch();
+        ~FScopedResolutionBatch();
+
+        TScratchMap<FString, UClass*> Classes;
+        TScratchMap<FString, UFunction*> Functions;
+
+    private:
+        friend class FK2NodeFactory;
+        FScopedResolutionBatch* Outer;
+    };
+
+    /**
+     * Drop every memoised resolution (global and active batches).
+     * Hooked to Blueprint compiles, asset additions, module loads and hot reload.
+     */
+    static void InvalidateResolutionCache();
+
 private:
     // =========================================================================
     // Node Creation Methods
@@ -113,8 +140,9 @@ private:
     /** Get the Blueprint from a graph */
     UBlueprint* GetBlueprintFromGraph(UEdGraph* Graph) const;
 
-    /** Find a class by name (tries various prefixes) */
+    /** Find a class by name (tries various prefixes). Memoised, including misses. */
     UClass* FindClassByName(const FString& ClassName) const;
+    UClass* ResolveClassByName(const FString& ClassName) const;
 
     /** Find a struct by name */
     UScriptStruct* FindStructByName(const FString& StructName) const;
@@ -122,6 +150,7 @@ private:
     /** Find an enum by name */
     UEnum* FindEnumByName(const FString& EnumName) const;
 
-    /** Find a function by name (searches multiple libraries) */
+    /** Find a function by name (searches multiple libraries). Memoised, including misses. */
     UFunction* FindFunctionByName(const FString& FunctionName, UClass* TargetClass = nullptr) const;
+    UFunction* ResolveFunctionByName(const FString& FunctionName, UClass* TargetClass) const;
 };
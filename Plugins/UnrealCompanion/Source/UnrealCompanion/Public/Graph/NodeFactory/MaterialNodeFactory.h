@@ -94,4 +94,7 @@ private:
     /** Create a material expression and add it to the material */
     template<typename T>
     T* CreateMaterialExpression(UMaterial* Material, FVector2D Position);
+
+    /** Add the graph node for one new expression (without rebuilding the graph) */
+    UEdGraphNode* AddGraphNode(UEdGraph* Graph, UMaterialExpression* Expression) const;
 };
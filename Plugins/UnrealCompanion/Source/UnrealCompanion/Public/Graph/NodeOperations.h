@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "EdGraph/EdGraphNode.h"
 #include "Graph/GraphTypes.h"
+#include "Commands/UnrealCompanionScratch.h"
 
 class UEdGraph;
 class UBlueprint;
@@ -149,6 +150,13 @@ namespace UnrealCompanionNode
         UnrealCompanionGraph::EInfoVerbosity Verbosity = UnrealCompanionGraph::EInfoVerbosity::Normal
     );
 
+    /**
+     * Every link leaving the node's output pins, as {source_pin, target_id, target_pin}.
+     * Each link is reported once, from its source node, so a delta that lists a node's
+     * outgoing links in full replaces whatever the client had for it.
+     */
+    TArray<TSharedPtr<FJsonValue>> BuildOutputLinks(UEdGraphNode* Node);
+
     /**
      * Get a safe display name for the node (won't crash on invalid nodes)
      */
@@ -170,4 +178,56 @@ namespace UnrealCompanionNode
      */
     UEdGraph* GetGraph(UEdGraphNode* Node);
 
+    // =========================================================================
+    // BATCH INDEX
+    // =========================================================================
+
+    /**
+     * Transient GUID and pin-name index for one graph, alive for one batch.
+     * While one is alive (game thread), FindByGuid and UnrealCompanionPin::FindPin
+     * on that graph are hash lookups instead of scans of Graph->Nodes / Node->Pins.
+     * Node GUIDs are indexed on construction; a node's pin table is built on its
+     * first pin lookup and dropped whenever its pins change (reconstruct, split,
+     * recombine). Indexes may nest; the innermost one for the graph is used.
+     * Lives in command scratch memory: only inside a handler call.
+     */
+    struct FScopedGraphIndex
+    {
+        explicit FScopedGraphIndex(UEdGraph* InGraph);
+        ~FScopedGraphIndex();
+
+        /** Innermost live index for Graph, or nullptr */
+        static FScopedGraphIndex* Find(const UEdGraph* Graph);
+
+        /** Keep live indexes in step with nodes added or removed outside a full rebuild */
+        static void NotifyNodeAdded(UEdGraphNode* Node);
+        static void NotifyNodeRemoved(UEdGraphNode* Node);
+
+        /** Drop Node's pin table in every live index (its Pins array changed) */
+        static void NotifyPinsChanged(UEdGraphNode* Node);
+
+        UEdGraphNode* FindNode(const FGuid& Guid);
+
+        /** Same matching rules as UnrealCompanionPin::FindPin */
+        UEdGraphPin* FindPin(UEdGraphNode* Node, const FString& PinName, EEdGraphPinDirection Direction);
+
+    private:
+        struct FPinTable
+        {
+            // Pin count when built; a mismatch means the pins changed behind our back
+            int32 PinCount = 0;
+
+            // Candidates per name (FString keys hash and compare case-insensitively),
+            // in FindPin's priority order: visible PinName, visible FriendlyName, hidden
+            TScratchMap<FString, TArray<UEdGraphPin*, TInlineAllocator<2, FUnrealCompanionScratch::FAllocator>>> ByName;
+        };
+
+        const FPinTable& GetPinTable(UEdGraphNode* Node);
+
+        UEdGraph* Graph;
+        TScratchMap<FGuid, UEdGraphNode*> Nodes;
+        TScratchMap<const UEdGraphNode*, FPinTable> PinTables;
+        FScopedGraphIndex* Outer;
+    };
+
 } // namespace UnrealCompanionNode
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+#include "MCPMetrics.h"
+#include <atomic>
+
+class UUnrealCompanionBridge;
+
+/**
+ * In-process replay of a command mix through the bridge's own scheduler
+ * (EnqueueCommand), for the bridge_benchmark command.
+ *
+ * The mix is a list of command families, each one request repeated
+ * `iterations` times. Families are interleaved round-robin and replayed
+ * once per concurrency level with at most that many requests in flight.
+ * Optional setup commands run one at a time before each level, unmeasured,
+ * to reset a fixture. Latency is enqueue-to-completion, so it includes
+ * queue wait but no socket or client time (the Python load generator in
+ * utils/benchmark.py measures that end to end).
+ *
+ * The run is fully asynchronous: nothing blocks while it is in flight,
+ * and OnFinished is called once, from whichever thread completed the last
+ * request.
+ */
+class UNREALCOMPANION_API FMCPBenchmark : public TSharedFromThis<FMCPBenchmark>
+{
+public:
+	using FOnFinished = TFunction<void(const TSharedPtr<FJsonObject>&)>;
+
+	static constexpr int32 MaxConcurrency = 64;
+	static constexpr int32 MaxRequestsPerLevel = 100000;
+
+	/** Validate and build a run from bridge_benchmark params; null (with OutError) if invalid */
+	static TSharedPtr<FMCPBenchmark> Create(UUnrealCompanionBridge* InBridge, const TSharedPtr<FJsonObject>& Params, FString& OutError);
+
+	/** Start the first level; the report is delivered to InOnFinished */
+	void Start(FOnFinished InOnFinished);
+
+private:
+	struct FRequest
+	{
+		FString Type;
+		TSharedPtr<FJsonObject> Params;
+	};
+
+	struct FFamily
+	{
+		FString Name;
+		FRequest Request;
+		int32 Iterations = 0;
+	};
+
+	struct FFamilyResult
+	{
+		FMCPLatencyHistogram Latency;
+		uint64 Errors = 0;
+	};
+
+	explicit FMCPBenchmark(UUnrealCompanionBridge* InBridge) : Bridge(InBridge) {}
+
+	/** Begin the next level, or finish if there is none */
+	void StartLevel();
+
+	/** Run setup command SetupIndex, then the next one, then the measured requests */
+	void RunSetup(int32 SetupIndex);
+
+	/** Submit requests until the level's concurrency is reached or the schedule is exhausted */
+	void Pump();
+
+	void OnRequestComplete(int32 FamilyIndex, double StartTime, bool bSuccess);
+
+	/** Close the current level's results into LevelReports */
+	void FinishLevel();
+
+	void Finish();
+
+	UUnrealCompanionBridge* Bridge;
+	TArray<FFamily> Families;
+	TArray<FRequest> Setup;
+	TArray<int32> ConcurrencyLevels;
+
+	// Round-robin order of family indices for one level
+	TArray<int32> Schedule;
+
+	// Pump() calls waiting to be served; only the caller that raised it from 0 loops
+	std::atomic<int32> PumpRequests{0};
+
+	FCriticalSection Lock;
+	int32 LevelIndex = -1;
+	int32 NextScheduled = 0;
+	int32 InFlight = 0;
+	int32 Completed = 0;
+	double LevelStartTime = 0.0;
+	TArray<FFamilyResult> Results;
+	TArray<TSharedPtr<FJsonValue>> LevelReports;
+	FOnFinished OnFinished;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+struct FMCPResponse;
+
+/**
+ * CBOR (RFC 8949) payload encoding, the binary alternative to UTF-8 JSON.
+ *
+ * A client opts in per frame by setting the CBOR encoding in the frame flags
+ * (see MCPFraming); the response to a CBOR request is CBOR as well. Requests
+ * decode into the same FJsonObject params the handlers already take, so no
+ * handler needs to know which encoding a client picked.
+ *
+ * Numeric arrays travel packed, as RFC 8746 typed arrays:
+ * - tag 78 (int32, little endian) and tag 86 (float64, little endian) are
+ *   produced for responses with at least PackedArrayMinLength numbers;
+ * - tags 64, 69, 70, 72, 77, 78, 79, 85 and 86 are accepted in requests.
+ *
+ * Pre-encoded JSON fragments in a result (FMCPJsonValueRaw) are emitted as
+ * tag 262 (embedded JSON) byte strings instead of being re-encoded.
+ */
+namespace MCPCbor
+{
+	/** Numeric arrays shorter than this are written element by element */
+	static constexpr int32 PackedArrayMinLength = 16;
+
+	/** Nesting limit for decoding, so a hostile payload cannot exhaust the stack */
+	static constexpr int32 MaxDepth = 64;
+
+	/** Decode a CBOR map into a JSON object. Returns false (with OutError) on malformed input. */
+	UNREALCOMPANION_API bool DecodeObject(const uint8* Data, int32 Num, TSharedPtr<FJsonObject>& OutObject, FString& OutError);
+
+	/** Append one value */
+	UNREALCOMPANION_API void EncodeValue(const TSharedPtr<FJsonValue>& Value, TArray<uint8>& Buffer);
+
+	/** Append a response envelope (same fields as the JSON envelope) */
+	UNREALCOMPANION_API void EncodeResponse(const FMCPResponse& Response, TArray<uint8>& Buffer);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "MCPFraming.h"
+#include "MCPResponseWriter.h"
+#include "Templates/SharedPointer.h"
+
+class FJsonObject;
+class FJsonValue;
+
+class FSocket;
+class FRunnableThread;
+class UUnrealCompanionBridge;
+struct FMCPTraceEntry;
+
+/**
+ * One accepted MCP client.
+ * Each connection owns its socket and a dedicated worker thread, so a slow or
+ * idle client never blocks the accept loop or any other client.
+ * Reads are readiness-driven (FSocket::Wait) — there are no fixed sleeps on the
+ * request path, the wait timeout only bounds how fast Stop() is noticed.
+ */
+class FMCPClientConnection : public FRunnable, public TSharedFromThis<FMCPClientConnection>
+{
+public:
+	FMCPClientConnection(UUnrealCompanionBridge* InBridge, FSocket* InSocket, int32 InConnectionId);
+	virtual ~FMCPClientConnection();
+
+	/** Spawn the worker thread. Returns false if the thread could not be created. */
+	bool Start();
+
+	/** True once the worker has left its receive loop (client gone or Stop() called). */
+	bool IsFinished() const { return bFinished; }
+
+	int32 GetConnectionId() const { return ConnectionId; }
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	/** Parse and execute one request. Returns false if the connection should be closed. */
+	bool ProcessFrame(const FMCPFrame& Frame);
+
+	/** Decode a request payload (inflating it first if compressed) into the command object */
+	bool DecodeRequest(const FMCPFrame& Frame, TSharedPtr<FJsonObject>& OutObject, FString& OutError);
+
+	/** Encode a response with the request's framing and payload encoding and write all of it */
+	bool SendResponse(const FMCPResponse& Response, EMCPFraming Framing, uint8 Flags);
+
+	/**
+	 * Serialize a response straight into a pooled buffer, framed in place. Returns the frame's start offset.
+	 * OutTrace gets the response summary, completed and recorded by SendFrame.
+	 */
+	int32 EncodeResponse(const FMCPResponse& Response, EMCPFraming Framing, uint8 Flags, TArray<uint8>& OutFrame,
+		FMCPTraceEntry& OutTrace);
+
+	/** Write an encoded frame and return its buffer to the pool; the write is timed under CommandType and traced */
+	bool SendFrame(TArray<uint8>&& Frame, int32 Offset, const FString& CommandType, FMCPTraceEntry& Trace);
+	bool SendAll(const uint8* Data, int32 Num);
+
+	/** Queue a pipelined request; its response is sent from a background task */
+	void DispatchAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params,
+		const TSharedPtr<FJsonValue>& RequestId, EMCPFraming Framing, uint8 Flags);
+
+	UUnrealCompanionBridge* Bridge;
+	FSocket* Socket;
+	FRunnableThread* Thread;
+	int32 ConnectionId;
+	FThreadSafeBool bRunning;
+	FThreadSafeBool bFinished;
+
+	// Set once the client advertises FlagAcceptCompressed; large responses are deflated from then on
+	FThreadSafeBool bAcceptsCompression;
+
+	// Responses can be written by the worker and by completion tasks concurrently
+	FCriticalSection SendLock;
+
+	// Send buffers reused across responses (the worker and completion tasks both draw from it)
+	FMCPBufferPool ResponseBuffers;
+};
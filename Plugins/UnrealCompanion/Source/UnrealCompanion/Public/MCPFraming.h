@@ -0,0 +1,144 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Wire framing for the MCP TCP protocol.
+ *
+ * Two framings are accepted on the same port and detected per message:
+ *
+ * - Framed (preferred): a 6-byte header followed by the payload
+ *     [0xFE marker][flags][payload length, uint32 big-endian][payload bytes]
+ *   The marker can never start a UTF-8 JSON document, so it is unambiguous.
+ *   The flags byte describes how the payload is encoded: its low nibble is
+ *   the payload encoding (PayloadJson or PayloadCbor), the high nibble holds
+ *   transforms applied on top of it (FlagCompressed).
+ *
+ * - Legacy: a bare UTF-8 JSON object, optionally followed by a newline.
+ *   The reader tracks brace depth (string/escape aware) to find its end, so
+ *   documents split across several Recv calls are reassembled correctly.
+ *
+ * Responses are written with the same framing and payload encoding the
+ * request arrived with. Legacy frames are always JSON.
+ *
+ * Compression: a client that sets FlagAcceptCompressed on a request gets
+ * every response of at least CompressionThreshold bytes deflated (zlib) for
+ * the rest of the connection. A compressed payload is
+ *     [uncompressed length, uint32 big-endian][zlib stream]
+ * and is marked with FlagCompressed; requests may be compressed the same way.
+ */
+enum class EMCPFraming : uint8
+{
+	Legacy,
+	LengthPrefixed
+};
+
+namespace MCPFraming
+{
+	/** First byte of every length-prefixed frame */
+	static constexpr uint8 FrameMarker = 0xFE;
+
+	/** Marker + flags + uint32 length */
+	static constexpr int32 HeaderSize = 6;
+
+	/** Upper bound for a single frame; larger frames are rejected instead of buffered */
+	static constexpr int64 MaxFrameSize = 256ll * 1024 * 1024;
+
+	/** Payload encodings (low nibble of the flags byte) */
+	static constexpr uint8 PayloadJson = 0x00;
+	static constexpr uint8 PayloadCbor = 0x01;
+	static constexpr uint8 PayloadEncodingMask = 0x0F;
+
+	inline uint8 GetPayloadEncoding(uint8 Flags) { return Flags & PayloadEncodingMask; }
+
+	/** The payload is zlib-compressed (see CompressPayload) */
+	static constexpr uint8 FlagCompressed = 0x10;
+
+	/** Request only: the client can read compressed responses */
+	static constexpr uint8 FlagAcceptCompressed = 0x20;
+
+	/** Smaller responses are not worth the CPU time */
+	static constexpr int32 CompressionThreshold = 64 * 1024;
+
+	/**
+	 * Append the compressed form of Data (length prefix + zlib stream) to OutPayload.
+	 * @return false if compression failed or would not make the payload smaller; OutPayload is left as it was
+	 */
+	UNREALCOMPANION_API bool CompressPayload(const uint8* Data, int32 Num, TArray<uint8>& OutPayload);
+
+	/** Inflate a FlagCompressed payload. Returns false (with OutError) on malformed input. */
+	UNREALCOMPANION_API bool DecompressPayload(const TArray<uint8>& Payload, TArray<uint8>& OutPayload, FString& OutError);
+
+	/**
+	 * Encode a UTF-8 payload into a wire frame.
+	 * Legacy framing appends a newline terminator, LengthPrefixed prepends the header.
+	 */
+	UNREALCOMPANION_API void EncodeFrame(const TArray<uint8>& Payload, EMCPFraming Framing, uint8 Flags, TArray<uint8>& OutFrame);
+
+	/** Convert a string to UTF-8 (full byte length, not character count) and encode it */
+	UNREALCOMPANION_API void EncodeStringFrame(const FString& Payload, EMCPFraming Framing, TArray<uint8>& OutFrame);
+
+	/**
+	 * In-place framing for payloads written straight into the send buffer.
+	 * BeginFrame resets the buffer and reserves the header; EndFrame fills the
+	 * header in (or appends the legacy terminator) and returns the offset the
+	 * frame starts at, so the payload is never copied.
+	 */
+	UNREALCOMPANION_API void BeginFrame(TArray<uint8>& Buffer);
+	UNREALCOMPANION_API int32 EndFrame(TArray<uint8>& Buffer, EMCPFraming Framing, uint8 Flags);
+}
+
+/**
+ * One decoded request frame.
+ */
+struct FMCPFrame
+{
+	EMCPFraming Framing = EMCPFraming::Legacy;
+	uint8 Flags = 0;
+	TArray<uint8> Payload;
+
+	/** Payload decoded as UTF-8 text */
+	FString PayloadAsString() const;
+};
+
+/**
+ * Streaming reassembly buffer.
+ * Feed it whatever Recv returns; pop complete frames as they become available.
+ * The buffer grows on demand and is compacted as frames are consumed.
+ */
+class UNREALCOMPANION_API FMCPFrameReader
+{
+public:
+	/** Append raw bytes received from the socket */
+	void Append(const uint8* Data, int32 Num);
+
+	/**
+	 * Try to extract the next complete frame.
+	 * @return true if OutFrame was filled. false if more data is needed or on error
+	 *         (check HasError()); a reader in error state must be discarded.
+	 */
+	bool TryPopFrame(FMCPFrame& OutFrame);
+
+	bool HasError() const { return !Error.IsEmpty(); }
+	const FString& GetError() const { return Error; }
+
+	/** Bytes currently buffered but not yet consumed */
+	int32 GetBufferedBytes() const { return Buffer.Num() - ReadOffset; }
+
+private:
+	void Compact();
+	void SkipInterFrameBytes();
+	bool TryPopLengthPrefixed(FMCPFrame& OutFrame);
+	bool TryPopLegacy(FMCPFrame& OutFrame);
+
+	TArray<uint8> Buffer;
+	int32 ReadOffset = 0;
+
+	// Legacy scan state, kept across calls so partial documents are not rescanned
+	int32 LegacyScanOffset = 0;
+	int32 LegacyDepth = 0;
+	bool bLegacyInString = false;
+	bool bLegacyEscape = false;
+
+	FString Error;
+};
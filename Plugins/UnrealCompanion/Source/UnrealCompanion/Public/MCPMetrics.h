@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Phases of a command's round trip, timed separately so a slow tool can be
+ * told apart from a congested queue or a slow client.
+ */
+enum class EMCPMetricPhase : uint8
+{
+	QueueWait,	// Enqueued -> picked up by the game-thread scheduler
+	Execute,	// Handler call (including a deferred reply's async work)
+	Serialize,	// Response envelope -> wire bytes
+	Send,		// Socket write
+	Count
+};
+
+/**
+ * Fixed-size latency histogram: log-scale buckets, four per power of two,
+ * from 1 us to about an hour. Quantiles are bucket upper bounds, so they are
+ * at most ~19% high; good enough to rank tools, and recording never allocates.
+ */
+struct FMCPLatencyHistogram
+{
+	static constexpr int32 NumBuckets = 128;
+
+	void Record(double Seconds);
+	void Reset();
+
+	/** Upper bound of the bucket holding quantile Q (0..1), in milliseconds; 0 when empty */
+	double GetQuantileMs(double Q) const;
+
+	uint32 Buckets[NumBuckets] = {};
+	uint64 Count = 0;
+	double SumSeconds = 0.0;
+	double MaxSeconds = 0.0;
+};
+
+/**
+ * Per-command counters and histograms for the bridge, exposed by the
+ * bridge_metrics command. Recording is thread-safe (connection threads,
+ * the game thread and task workers all record).
+ */
+class UNREALCOMPANION_API FMCPMetrics
+{
+public:
+	static FMCPMetrics& Get();
+
+	/** A phase finished for CommandType (ignored for an empty name) */
+	void RecordPhase(const FString& CommandType, EMCPMetricPhase Phase, double Seconds);
+
+	/** A handler completed; Seconds is its execution time */
+	void RecordCompletion(const FString& CommandType, bool bSuccess, double Seconds);
+
+	/** A request was refused before reaching a handler (INVALID_PARAMS, BRIDGE_BUSY, ...) */
+	void RecordRejection(const FString& CommandType);
+
+	void Reset();
+
+	/** {uptime_seconds, queue_depth, totals, commands: {name: {...}}} */
+	TSharedPtr<FJsonObject> BuildReport(int32 QueueDepth) const;
+
+	/** Prometheus text exposition format (counters, summaries and a queue gauge) */
+	FString BuildPrometheusText(int32 QueueDepth) const;
+
+private:
+	FMCPMetrics();
+
+	struct FCommandStats
+	{
+		uint64 Completed = 0;
+		uint64 Failed = 0;
+		uint64 Rejected = 0;
+		FMCPLatencyHistogram Phases[(int32)EMCPMetricPhase::Count];
+	};
+
+	FCommandStats& FindOrAddLocked(const FString& CommandType);
+
+	mutable FCriticalSection Lock;
+	TMap<FString, FCommandStats> Commands;
+	double StartTime = 0.0;
+};
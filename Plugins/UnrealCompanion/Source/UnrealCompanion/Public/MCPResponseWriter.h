@@ -0,0 +1,162 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonValue.h"
+#include "Misc/ScopeLock.h"
+
+class FJsonObject;
+
+/**
+ * Streaming JSON writer that emits UTF-8 straight into a byte buffer.
+ *
+ * This is the response path's replacement for TJsonWriter<> -> FString ->
+ * FTCHARToUTF8: strings are transcoded once, directly into the output, and
+ * nothing is allocated apart from buffer growth. Output is the condensed form
+ * the engine writer produces (no whitespace, "%.17g" numbers), except that
+ * non-finite numbers are written as null instead of invalid JSON.
+ *
+ * Calls must be well nested. Inside an object every value is preceded by a
+ * key; inside an array, never.
+ */
+class UNREALCOMPANION_API FMCPResponseWriter
+{
+public:
+	explicit FMCPResponseWriter(TArray<uint8>& InBuffer) : Buffer(InBuffer) {}
+
+	void BeginObject();
+	void EndObject();
+	void BeginArray();
+	void EndArray();
+
+	void BeginObject(FStringView Key) { WriteKey(Key); BeginObject(); }
+	void BeginArray(FStringView Key) { WriteKey(Key); BeginArray(); }
+
+	/** Key of the next value in the enclosing object */
+	void WriteKey(FStringView Key);
+
+	void WriteValue(FStringView Value);
+	void WriteValue(const TCHAR* Value) { WriteValue(FStringView(Value)); }
+	void WriteValue(const FString& Value) { WriteValue(FStringView(Value)); }
+	void WriteValue(double Value);
+	void WriteValue(int32 Value) { WriteValue((int64)Value); }
+	void WriteValue(int64 Value);
+	void WriteValue(bool Value);
+	void WriteNull();
+
+	/** Serialize a DOM value or object (handlers that still return FJsonObject trees) */
+	void WriteValue(const TSharedPtr<FJsonValue>& Value);
+	void WriteObject(const FJsonObject& Object);
+
+	/** Splice one complete, already-encoded UTF-8 JSON value */
+	void WriteRawValue(const uint8* Utf8, int32 Num);
+
+	template <typename ValueType>
+	void WriteField(FStringView Key, const ValueType& Value)
+	{
+		WriteKey(Key);
+		WriteValue(Value);
+	}
+
+private:
+	/** Separator before an element, unless it directly follows its key */
+	void BeginElement();
+	void WriteString(FStringView Value);
+	void AppendAscii(const ANSICHAR* Text, int32 Len);
+
+	TArray<uint8>& Buffer;
+
+	// One entry per open container: true once it holds an element
+	TArray<bool, TInlineAllocator<32>> Scopes;
+	bool bAfterKey = false;
+
+	// Reused for DOM strings so copying them out of FJsonValueString stops allocating once warm
+	FString Scratch;
+};
+
+/**
+ * Pre-encoded UTF-8 JSON embedded in an FJsonObject result.
+ *
+ * Lets a handler stream a large part of its result (a node list, a query page)
+ * with FMCPResponseWriter while returning the usual FJsonObject:
+ *
+ *     TArray<uint8> Nodes;
+ *     FMCPResponseWriter Writer(Nodes);
+ *     Writer.BeginArray(); ... Writer.EndArray();
+ *     Response->SetField(TEXT("nodes"), MakeShared<FMCPJsonValueRaw>(MoveTemp(Nodes)));
+ *
+ * The bridge splices the bytes into the response verbatim. The value reports
+ * EJson::None and is opaque to the engine's DOM accessors and serializer, so
+ * only use it for fields no other handler reads back.
+ */
+class UNREALCOMPANION_API FMCPJsonValueRaw : public FJsonValue
+{
+public:
+	explicit FMCPJsonValueRaw(TArray<uint8>&& InUtf8) : Utf8(MoveTemp(InUtf8)) { Type = EJson::None; }
+
+	const TArray<uint8>& GetUtf8() const { return Utf8; }
+
+protected:
+	virtual FString GetType() const override { return TEXT("Raw"); }
+
+private:
+	TArray<uint8> Utf8;
+};
+
+/**
+ * A finished command: the status/result/error envelope fields plus the
+ * handler's result tree. Serialized once, by whoever sends it, into a buffer
+ * it owns (see FMCPBufferPool) instead of being wrapped in another FJsonObject.
+ */
+struct UNREALCOMPANION_API FMCPResponse
+{
+	bool bSuccess = false;
+
+	/** Handler result, emitted as "result" on success */
+	TSharedPtr<FJsonObject> Result;
+
+	/** Emitted as "error" (and optionally "error_code"/"queue_depth") on failure */
+	FString Error;
+	FString ErrorCode;
+	int32 QueueDepth = -1;
+
+	/** Client's request id, echoed so pipelined responses can be matched */
+	TSharedPtr<FJsonValue> RequestId;
+
+	/**
+	 * Set on an event frame (e.g. "job_progress") pushed for RequestId before or
+	 * after its reply: emitted as status "event" plus "event", with the payload in
+	 * "result". Never set on the command's reply itself.
+	 */
+	FString Event;
+
+	/** Command that produced the response; not serialized, only used to attribute send-side metrics */
+	FString CommandType;
+
+	/** Handler time, for the trace ring; not serialized */
+	double ExecuteSeconds = 0.0;
+
+	static FMCPResponse MakeError(const FString& InError, const FString& InErrorCode = FString(),
+		const TSharedPtr<FJsonValue>& InRequestId = nullptr, int32 InQueueDepth = -1);
+
+	/** Append the envelope as UTF-8 JSON */
+	void Write(FMCPResponseWriter& Writer) const;
+};
+
+/**
+ * Small thread-safe free list of send buffers, one pool per connection.
+ * Buffers keep their capacity between responses; oversized ones are dropped
+ * so a single huge reply does not pin its memory for the connection's lifetime.
+ */
+class UNREALCOMPANION_API FMCPBufferPool
+{
+public:
+	TArray<uint8> Acquire();
+	void Release(TArray<uint8>&& Buffer);
+
+private:
+	static constexpr int32 MaxPooledBuffers = 4;
+	static constexpr int32 MaxPooledCapacity = 4 * 1024 * 1024;
+
+	FCriticalSection Lock;
+	TArray<TArray<uint8>> Free;
+};
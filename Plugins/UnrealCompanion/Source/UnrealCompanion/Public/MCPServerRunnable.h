@@ -2,13 +2,18 @@
 
 #include "CoreMinimal.h"
 #include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
 #include "Sockets.h"
 #include "Interfaces/IPv4/IPv4Address.h"
 
 class UUnrealCompanionBridge;
+class FMCPClientConnection;
 
 /**
- * Runnable class for the MCP server thread
+ * Runnable class for the MCP server thread.
+ * Only accepts connections: every client is handed to its own FMCPClientConnection
+ * worker, so several agents (Python server, web-ui, CI scripts) can talk to the
+ * editor concurrently.
  */
 class FMCPServerRunnable : public FRunnable
 {
@@ -23,12 +28,15 @@ public:
 	virtual void Exit() override;
 
 protected:
-	void HandleClientConnection(TSharedPtr<FSocket> ClientSocket);
-	void ProcessMessage(TSharedPtr<FSocket> Client, const FString& Message);
+	void AcceptPendingConnection();
+	void ReapFinishedConnections();
+	void CloseAllConnections();
 
 private:
 	UUnrealCompanionBridge* Bridge;
 	TSharedPtr<FSocket> ListenerSocket;
-	TSharedPtr<FSocket> ClientSocket;
-	bool bRunning;
-}; 
\ No newline at end of file
+	// Live client workers. Only touched from the server thread.
+	TArray<TSharedPtr<FMCPClientConnection>> Connections;
+	int32 NextConnectionId;
+	FThreadSafeBool bRunning;
+};
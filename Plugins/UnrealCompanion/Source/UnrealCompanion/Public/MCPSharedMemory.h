@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformMemory.h"
+
+/**
+ * Shared-memory side channel for large binary results (screenshots, heightmaps, mesh data).
+ *
+ * Clients on the same machine can ask a command to put its bulk bytes here
+ * instead of base64 in the reply or a file on disk; the reply then carries a
+ * handle and the client maps the region and reads them in place. The region is
+ * a named OS shared-memory object ("UnrealCompanion_<pid>", SharedMemoryMB in
+ * the settings), created on the first write and used as a ring:
+ *
+ *     [0, 64)     header: "UCSHM001", region size (uint64 LE), reserved
+ *     record      [sequence uint64 LE][length uint64 LE][data, padded to 16]
+ *
+ * Nothing is ever acknowledged. A new record overwrites the oldest ones, and
+ * before it does, the writer zeroes their headers, so a client that checks the
+ * record header against the handle both before and after it reads can tell
+ * the bytes are still the ones it asked for. A reader that is too slow sees a
+ * mismatch and has to request the data again.
+ *
+ * Thread-safe.
+ */
+class UNREALCOMPANION_API FMCPSharedMemory
+{
+public:
+	static FMCPSharedMemory& Get();
+
+	/** Region header plus the per-record header, in bytes */
+	static constexpr int64 HeaderSize = 64;
+	static constexpr int64 RecordHeaderSize = 16;
+
+	/**
+	 * Copy Num bytes into the ring.
+	 * @return the handle ({"name", "size", "offset", "length", "sequence"}, offset pointing at
+	 *         the data), or null with OutError when shared memory is disabled, unavailable on
+	 *         this platform, or the data does not fit
+	 */
+	TSharedPtr<FJsonObject> Write(const uint8* Data, int64 Num, FString& OutError);
+
+	/** Unmap (and on POSIX unlink) the region; the next Write maps a new one */
+	void Shutdown();
+
+private:
+	FMCPSharedMemory() = default;
+
+	struct FRecord
+	{
+		int64 Offset = 0;
+		int64 End = 0;
+	};
+
+	bool EnsureRegion_Locked(FString& OutError);
+
+	FCriticalSection Lock;
+	FPlatformMemory::FSharedMemoryRegion* Region = nullptr;
+	FString RegionName;
+
+	/** Next record offset */
+	int64 Head = HeaderSize;
+	uint64 NextSequence = 1;
+
+	/** Records that may still be read, oldest first */
+	TArray<FRecord> LiveRecords;
+};
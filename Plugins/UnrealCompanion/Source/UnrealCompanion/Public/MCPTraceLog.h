@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include <atomic>
+
+class FJsonValue;
+
+/**
+ * Request/response bodies. Silent unless raised explicitly, e.g.
+ * `Log LogMCPTraffic VeryVerbose` in the editor console: bodies can be
+ * megabytes, and formatting them costs more than most commands.
+ */
+UNREALCOMPANION_API DECLARE_LOG_CATEGORY_EXTERN(LogMCPTraffic, Log, All);
+
+enum class EMCPTraceEvent : uint8
+{
+	Request,	// Frame decoded on a connection
+	Response	// Frame written back (or the write failed)
+};
+
+/**
+ * Summary of one message on the wire. Plain data so it can be copied in and
+ * out of the ring without locks; names are truncated to fit.
+ */
+struct FMCPTraceEntry
+{
+	static constexpr int32 MaxNameLength = 48;
+
+	double Timestamp = 0.0;
+	int32 ConnectionId = -1;
+	int32 PayloadBytes = 0;		// As sent on the wire (after compression)
+	float ExecuteMs = 0.0f;		// Responses only
+	float SerializeMs = 0.0f;	// Responses only
+	float SendMs = 0.0f;		// Responses only
+	EMCPTraceEvent Event = EMCPTraceEvent::Request;
+	uint8 Flags = 0;			// Frame flags (encoding, compression)
+	bool bSuccess = true;
+	ANSICHAR Command[MaxNameLength] = {};
+	ANSICHAR RequestId[MaxNameLength] = {};
+
+	void SetCommand(const FString& InCommand);
+	void SetRequestId(const TSharedPtr<FJsonValue>& InRequestId);
+};
+
+/**
+ * Fixed-size ring of the most recent message summaries, replacing per-message
+ * Display logging on the connection threads. Recording is lock-free: a writer
+ * takes a ticket, marks its slot as being written, stores the entry and then
+ * publishes the ticket with a release store. Readers check the ticket before
+ * and after copying and drop entries overwritten meanwhile. Read with the
+ * bridge_trace command or the UnrealCompanion.DumpTrace console command.
+ */
+class UNREALCOMPANION_API FMCPTraceLog
+{
+public:
+	static constexpr int32 Capacity = 1024;
+
+	static FMCPTraceLog& Get();
+
+	void Record(const FMCPTraceEntry& Entry);
+
+	/** Up to MaxEntries most recent entries, oldest first */
+	void Snapshot(TArray<FMCPTraceEntry>& OutEntries, int32 MaxEntries = Capacity) const;
+
+	/** {recorded, entries: [...]} for the newest MaxEntries entries */
+	TSharedPtr<FJsonObject> BuildReport(int32 MaxEntries) const;
+
+	/** Write the newest MaxEntries entries to LogMCPTraffic at Display */
+	void DumpToLog(int32 MaxEntries) const;
+
+private:
+	FMCPTraceLog() = default;
+
+	static constexpr int32 EntryWords = (sizeof(FMCPTraceEntry) + sizeof(uint64) - 1) / sizeof(uint64);
+
+	struct FSlot
+	{
+		// Ticket * 2 once the entry is published, odd while a writer is storing it, 0 if never written
+		std::atomic<uint64> Sequence{0};
+		// The entry's bytes, stored word by word so a reader racing a writer never reads a torn word
+		std::atomic<uint64> Words[EntryWords];
+	};
+
+	std::atomic<uint64> NextTicket{0};
+	FSlot Slots[Capacity];
+};
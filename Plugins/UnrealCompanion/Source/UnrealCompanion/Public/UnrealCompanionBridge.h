@@ -8,6 +8,13 @@
 #include "Json.h"
 #include "Interfaces/IPv4/IPv4Address.h"
 #include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "MCPResponseWriter.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/ScopeLock.h"
+#include "Modules/ModuleManager.h"
+#include <atomic>
 // Command handlers (organized by category)
 #include "Commands/UnrealCompanionAssetCommands.h"
 #include "Commands/UnrealCompanionBlueprintCommands.h"
@@ -29,13 +36,190 @@
 #include "Commands/UnrealCompanionSplineCommands.h"
 #include "Commands/UnrealCompanionEnvironmentCommands.h"
 #include "Commands/UnrealCompanionNiagaraCommands.h"
+#include "Commands/UnrealCompanionParams.h"
+#include "Commands/UnrealCompanionCommandTable.h"
 #include "UnrealCompanionBridge.generated.h"
 
 // Command handler function type for registry
 using FCommandHandlerFunc = TFunction<TSharedPtr<FJsonObject>(const FString&, const TSharedPtr<FJsonObject>&)>;
 
+// Completion callback for queued commands, invoked on the thread that ran the command
+// (or the thread that finished a deferred reply)
+using FCommandCompletionFunc = TFunction<void(const FMCPResponse&)>;
+
+// Optional per-request affinity override (e.g. core_query is thread-safe only for asset/folder queries)
+using FCommandAffinityFunc = TFunction<EMCPThreadAffinity(const TSharedPtr<FJsonObject>&)>;
+
+/**
+ * Scheduling class of a command. Higher classes are always drained first, so
+ * cheap reads never wait behind a burst of sculpts or compiles.
+ */
+enum class EMCPCommandPriority : uint8
+{
+	High,	// Cheap reads (ping, core_get_info, ...)
+	Normal,
+	Low,	// Heavy writes (landscape_sculpt, blueprint_compile, ...)
+	Count
+};
+
+/**
+ * One entry in the command registry.
+ * A request resolves its entry once, on arrival; the queue, the scheduler and
+ * InvokeHandler reuse that pointer instead of hashing the name again.
+ */
+struct FCommandRegistration
+{
+	FCommandRegistration() = default;
+	FCommandRegistration(FCommandHandlerFunc InHandler, EMCPThreadAffinity InAffinity = EMCPThreadAffinity::GameThread,
+		FCommandAffinityFunc InAffinityResolver = nullptr)
+		: Handler(MoveTemp(InHandler))
+		, Affinity(InAffinity)
+		, AffinityResolver(MoveTemp(InAffinityResolver))
+	{
+	}
+
+	/** Parse and validate requests into ParamsType before they are queued (see FUnrealCompanionParams) */
+	template <typename ParamsType>
+	FCommandRegistration& WithParams()
+	{
+		ParamParser = FUnrealCompanionParams::MakeParser<ParamsType>();
+		ParamSchemaKey = FUnrealCompanionParams::GetSchemaKey<ParamsType>();
+		ParamDescriber = FUnrealCompanionParams::MakeDescriber<ParamsType>();
+		return *this;
+	}
+
+	/** Affinity for a specific request */
+	EMCPThreadAffinity ResolveAffinity(const TSharedPtr<FJsonObject>& Params) const
+	{
+		return AffinityResolver ? AffinityResolver(Params) : Affinity;
+	}
+
+	FCommandHandlerFunc Handler;
+	EMCPThreadAffinity Affinity = EMCPThreadAffinity::GameThread;
+	FCommandAffinityFunc AffinityResolver;
+
+	// Optional typed params: set by WithParams, null for untyped commands
+	FUnrealCompanionParams::FParser ParamParser;
+	const void* ParamSchemaKey = nullptr;
+	FUnrealCompanionParams::FDescriber ParamDescriber;
+
+	// Set from GetCommandPriority once the registry is built
+	EMCPCommandPriority Priority = EMCPCommandPriority::Normal;
+};
+
+/**
+ * A command handler group, created on the first command that needs it.
+ *
+ * Creation also loads the editor modules the group's commands rely on, so a
+ * session that never sends landscape_* or niagara_* never starts those modules
+ * on the bridge's behalf. Groups with modules must first be used on the game
+ * thread (every such group only has game-thread commands); the others may be
+ * created from any thread.
+ */
+template <typename HandlerType>
+class TMCPLazyCommandGroup
+{
+public:
+	explicit TMCPLazyCommandGroup(TArray<FName> InModules = TArray<FName>())
+		: Modules(MoveTemp(InModules))
+	{
+	}
+
+	/** Runs once, right after creation (wiring to other groups) */
+	TFunction<void(HandlerType&)> OnCreated;
+
+	/** The group, created on the first call */
+	TSharedRef<HandlerType> Get()
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (!Instance.IsValid())
+		{
+			check(Modules.Num() == 0 || IsInGameThread());
+			for (const FName& Module : Modules)
+			{
+				FModuleManager::Get().LoadModule(Module);
+			}
+			Instance = MakeShared<HandlerType>();
+			if (OnCreated)
+			{
+				OnCreated(*Instance);
+			}
+		}
+		return Instance.ToSharedRef();
+	}
+
+	/** The group if a command already created it, null otherwise (never creates) */
+	TSharedPtr<HandlerType> GetIfCreated()
+	{
+		FScopeLock ScopeLock(&Lock);
+		return Instance;
+	}
+
+	void Reset()
+	{
+		FScopeLock ScopeLock(&Lock);
+		Instance.Reset();
+	}
+
+private:
+	TArray<FName> Modules;
+	TSharedPtr<HandlerType> Instance;
+	FCriticalSection Lock;
+};
+
 class FMCPServerRunnable;
 
+/**
+ * A command waiting in the bridge queue.
+ * RequestId is echoed back unchanged as "id" so pipelining clients can match
+ * out-of-order responses to their requests.
+ */
+struct FMCPQueuedCommand
+{
+	FString CommandType;
+	TSharedPtr<FJsonObject> Params;
+	TSharedPtr<const FMCPTypedParams> TypedParams;	// Set when the command registered a params schema
+	const FCommandRegistration* Registration = nullptr;	// Resolved on arrival; null for ping and unknown commands
+	TSharedPtr<FJsonValue> RequestId;
+	EMCPCommandPriority Priority = EMCPCommandPriority::Normal;
+	double EnqueueTime = 0.0;
+	FCommandCompletionFunc OnComplete;
+	FCommandCompletionFunc OnEvent;	// Optional: receives event frames (FMCPResponse::Event) for this request
+};
+
+/**
+ * The reply of a command that is running or has deferred its response.
+ * Complete() forwards only the first response, so shutdown can fail a deferred
+ * reply that its handler (a screenshot capture, a save) completes later.
+ */
+struct FMCPPendingReply
+{
+	explicit FMCPPendingReply(FCommandCompletionFunc InOnComplete) : OnComplete(MoveTemp(InOnComplete)) {}
+
+	/** Hand Response to the client unless a response was already sent. Returns false if it was. */
+	bool Complete(const FMCPResponse& Response)
+	{
+		if (bCompleted.exchange(true))
+		{
+			return false;
+		}
+		if (OnComplete)
+		{
+			OnComplete(Response);
+		}
+		return true;
+	}
+
+	bool IsCompleted() const { return bCompleted.load(); }
+
+	FString CommandType;
+	TSharedPtr<FJsonValue> RequestId;
+
+private:
+	FCommandCompletionFunc OnComplete;
+	std::atomic<bool> bCompleted{false};
+};
+
 /**
  * Editor subsystem for MCP Bridge
  * Handles communication between external tools and the Unreal Editor
@@ -55,10 +239,12 @@ class FMCPServerRunnable;
  * - Project: project_* (project settings)
  * - Landscape: landscape_* (terrain creation, sculpting, painting)
  * - Foliage: foliage_* (vegetation scattering)
- * - Geometry: geometry_* (procedural geometry via Geometry Script)
+ * - Geometry: geometry_* (procedural geometry via Geometry Script, pooled pipelines)
  * - Spline: spline_* (spline creation, mesh scattering along splines)
  * - Environment: environment_* (atmosphere, fog, time of day)
  * - Niagara: niagara_* (emitter manipulation, parameters, spawning)
+ * - Job: job_* (status and cancellation of long-running commands)
+ * - Bridge: bridge_* (latency and throughput metrics, command schema)
  */
 UCLASS()
 class UNREALCOMPANION_API UUnrealCompanionBridge : public UEditorSubsystem
@@ -78,8 +264,25 @@ public:
 	void StopServer();
 	bool IsRunning() const { return bIsRunning; }
 
-	// Command execution
-	FString ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+	/** FPlatformTime::Seconds() of the last command a client sent (server start if none yet) */
+	double GetLastActivityTime() const { return LastActivityTime.load(); }
+
+	/**
+	 * Command execution: blocks the calling thread until the command has run, at most
+	 * CommandTimeoutSeconds, and returns BRIDGE_SHUTTING_DOWN as soon as the server stops
+	 */
+	FMCPResponse ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+	/**
+	 * Dispatch a command without waiting for it.
+	 * Game-thread commands are queued for the scheduler, AnyThread commands start
+	 * immediately on a worker, RenderThread commands are enqueued as render commands.
+	 * Safe to call from any thread. OnComplete is invoked on the executing thread.
+	 * @param RequestId Optional client id, echoed as "id" in the response
+	 * @param OnEvent Optional sink for event frames the command pushes (job progress), from any thread
+	 */
+	void EnqueueCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params,
+		const TSharedPtr<FJsonValue>& RequestId, FCommandCompletionFunc OnComplete, FCommandCompletionFunc OnEvent = nullptr);
 
 private:
 	// Server state
@@ -92,30 +295,142 @@ private:
 	FIPv4Address ServerAddress;
 	uint16 Port;
 
-	// Command handler instances (organized by category)
-	TSharedPtr<FUnrealCompanionAssetCommands> AssetCommands;           // asset_*
-	TSharedPtr<FUnrealCompanionBlueprintCommands> BlueprintCommands;   // blueprint_*
-	TSharedPtr<FUnrealCompanionBlueprintNodeCommands> NodeCommands;    // node_* (legacy)
-	TSharedPtr<FUnrealCompanionGraphCommands> GraphCommands;           // graph_* (new)
-	TSharedPtr<FUnrealCompanionUMGCommands> WidgetCommands;            // widget_*
-	TSharedPtr<FUnrealCompanionMaterialCommands> MaterialCommands;     // material_*
-	TSharedPtr<FUnrealCompanionWorldCommands> WorldCommands;           // world_*
-	TSharedPtr<FUnrealCompanionLevelCommands> LevelCommands;           // level_*
-	TSharedPtr<FUnrealCompanionLightCommands> LightCommands;           // light_*
-	TSharedPtr<FUnrealCompanionViewportCommands> ViewportCommands;     // viewport_*
-	TSharedPtr<FUnrealCompanionProjectCommands> ProjectCommands;       // project_*
-	TSharedPtr<FUnrealCompanionPythonCommands> PythonCommands;         // python_*
-	TSharedPtr<FUnrealCompanionImportCommands> ImportCommands;         // asset_import*
-	TSharedPtr<FUnrealCompanionLandscapeCommands> LandscapeCommands;     // landscape_*
-	TSharedPtr<FUnrealCompanionFoliageCommands> FoliageCommands;       // foliage_*
-	TSharedPtr<FUnrealCompanionGeometryCommands> GeometryCommands;     // geometry_*
-	TSharedPtr<FUnrealCompanionSplineCommands> SplineCommands;         // spline_*
-	TSharedPtr<FUnrealCompanionEnvironmentCommands> EnvironmentCommands; // environment_*
-	TSharedPtr<FUnrealCompanionNiagaraCommands> NiagaraCommands;       // niagara_*
-
-	// Command registry: maps command name → handler function
-	TMap<FString, FCommandHandlerFunc> CommandRegistry;
+	// Command handler groups (organized by category), each created on first use
+	TMCPLazyCommandGroup<FUnrealCompanionAssetCommands> AssetCommands;           // asset_*
+	TMCPLazyCommandGroup<FUnrealCompanionBlueprintCommands> BlueprintCommands;   // blueprint_*
+	TMCPLazyCommandGroup<FUnrealCompanionBlueprintNodeCommands> NodeCommands;    // node_* (legacy)
+	TMCPLazyCommandGroup<FUnrealCompanionGraphCommands> GraphCommands;           // graph_* (new)
+	TMCPLazyCommandGroup<FUnrealCompanionUMGCommands> WidgetCommands;            // widget_*
+	TMCPLazyCommandGroup<FUnrealCompanionMaterialCommands> MaterialCommands;     // material_*
+	TMCPLazyCommandGroup<FUnrealCompanionWorldCommands> WorldCommands;           // world_*
+	TMCPLazyCommandGroup<FUnrealCompanionLevelCommands> LevelCommands;           // level_*
+	TMCPLazyCommandGroup<FUnrealCompanionLightCommands> LightCommands;           // light_*
+	TMCPLazyCommandGroup<FUnrealCompanionViewportCommands> ViewportCommands;     // viewport_*
+	TMCPLazyCommandGroup<FUnrealCompanionProjectCommands> ProjectCommands;       // project_*
+	TMCPLazyCommandGroup<FUnrealCompanionPythonCommands> PythonCommands;         // python_*
+	TMCPLazyCommandGroup<FUnrealCompanionImportCommands> ImportCommands;         // asset_import*
+	TMCPLazyCommandGroup<FUnrealCompanionLandscapeCommands> LandscapeCommands;     // landscape_*
+	TMCPLazyCommandGroup<FUnrealCompanionFoliageCommands> FoliageCommands;       // foliage_*
+	TMCPLazyCommandGroup<FUnrealCompanionGeometryCommands> GeometryCommands;     // geometry_*
+	TMCPLazyCommandGroup<FUnrealCompanionSplineCommands> SplineCommands;         // spline_*
+	TMCPLazyCommandGroup<FUnrealCompanionEnvironmentCommands> EnvironmentCommands; // environment_*
+	TMCPLazyCommandGroup<FUnrealCompanionNiagaraCommands> NiagaraCommands;       // niagara_*
+
+	// Command registry: maps command name → handler function + thread affinity.
+	// Read-only after construction, so it can be looked up from any thread.
+	TMap<FString, FCommandRegistration> CommandRegistry;
 
 	// Register all commands in the registry
 	void RegisterCommands();
+
+	/** Register every row of a group's compile-time command table, bound straight to its method */
+	template <typename HandlerType>
+	void RegisterTable(TMCPLazyCommandGroup<HandlerType>& Group)
+	{
+		for (const TMCPCommandEntry<HandlerType>& Entry : HandlerType::GetCommandTable())
+		{
+			const typename TMCPCommandEntry<HandlerType>::FMethod Method = Entry.Method;
+			CommandRegistry.Add(Entry.Name, FCommandRegistration([&Group, Method](const FString& Cmd, const TSharedPtr<FJsonObject>& P)
+			{
+				return ((*Group.Get()).*Method)(P);
+			}, Entry.Affinity));
+		}
+	}
+
+	/** Same, for a group that lives for the whole editor session (a singleton) */
+	template <typename HandlerType>
+	void RegisterTable(HandlerType& Handler)
+	{
+		for (const TMCPCommandEntry<HandlerType>& Entry : HandlerType::GetCommandTable())
+		{
+			const typename TMCPCommandEntry<HandlerType>::FMethod Method = Entry.Method;
+			CommandRegistry.Add(Entry.Name, FCommandRegistration([&Handler, Method](const FString& Cmd, const TSharedPtr<FJsonObject>& P)
+			{
+				return (Handler.*Method)(P);
+			}, Entry.Affinity));
+		}
+	}
+
+	// Command queues (one per priority): filled by connection threads, drained on the game thread by the core ticker
+	TQueue<FMCPQueuedCommand, EQueueMode::Mpsc> CommandQueues[(int32)EMCPCommandPriority::Count];
+	std::atomic<int32> QueuedCommandCount{0};
+	// Queued plus running game-thread commands; the response cache only answers while it is zero
+	std::atomic<int32> PendingGameThreadCommands{0};
+	FTSTicker::FDelegateHandle CommandQueueTickerHandle;
+	FThreadSafeBool bAcceptingCommands;
+	// Held while a command is checked against bAcceptingCommands and queued, and while FailPendingCommands
+	// drains: a command is either drained on shutdown or rejected, never left in the queue
+	FCriticalSection EnqueueLock;
+	std::atomic<double> LastActivityTime{0.0};
+
+	/** Drain queued commands within the configured frame budget (game thread) */
+	bool TickCommandQueue(float DeltaTime);
+
+	/** Pop the next command, highest priority first (game thread) */
+	bool DequeueNextCommand(FMCPQueuedCommand& OutCommand);
+
+	/** Scheduling class for a command name */
+	static EMCPCommandPriority GetCommandPriority(const FString& CommandType);
+
+	/** Error response for a command that never reached a handler (busy, shutting down) */
+	static FMCPResponse BuildErrorResponse(const FString& ErrorCode, const FString& Message,
+		const TSharedPtr<FJsonValue>& RequestId, int32 QueueDepth = -1);
+
+	/** Parse a typed command's params (no-op for untyped commands). Returns false, logged, on invalid input. */
+	static bool ParseTypedParams(const FString& CommandType, const FCommandRegistration* Registration,
+		const TSharedPtr<FJsonObject>& Params, TSharedPtr<const FMCPTypedParams>& OutTypedParams, FString& OutError);
+
+	/** Run one command on the calling thread and build its response (no deferral possible) */
+	FMCPResponse ExecuteCommandNow(const FString& CommandType, const TSharedPtr<FJsonObject>& Params,
+		const TSharedPtr<FJsonValue>& RequestId);
+
+	/**
+	 * Run one command on the calling thread and hand the response to OnComplete.
+	 * The handler may defer its reply (FUnrealCompanionDeferredResponse); OnComplete
+	 * then runs later on whichever thread finishes the work. OnEvent, if set, is
+	 * exposed to the handler as its event sink.
+	 */
+	void RunCommand(const FString& CommandType, const FCommandRegistration* Registration, const TSharedPtr<FJsonObject>& Params,
+		const TSharedPtr<const FMCPTypedParams>& TypedParams, const TSharedPtr<FJsonValue>& RequestId,
+		FCommandCompletionFunc OnComplete, FCommandCompletionFunc OnEvent = nullptr);
+
+	/**
+	 * Call the handler of an already resolved command (Registration null: ping or unknown);
+	 * unknown commands and exceptions become failed results.
+	 * TypedParams (may be null) are exposed to the handler through FUnrealCompanionParams.
+	 */
+	TSharedPtr<FJsonObject> InvokeHandler(const FString& CommandType, const FCommandRegistration* Registration,
+		const TSharedPtr<FJsonObject>& Params, const TSharedPtr<const FMCPTypedParams>& TypedParams = nullptr);
+
+	/**
+	 * Turn a handler result into the status/result/error envelope (any thread).
+	 * The result tree is not copied or wrapped; the sender serializes it once, straight to UTF-8.
+	 */
+	static FMCPResponse FinalizeResponse(const FString& CommandType, const TSharedPtr<FJsonObject>& ResultJson,
+		const TSharedPtr<FJsonValue>& RequestId, double StartTime);
+
+	/** Answer every queued command with an error (used on shutdown so no client waits forever) */
+	void FailPendingCommands(const FString& Reason);
+
+	/** Answer every deferred reply still outstanding with an error (shutdown, after FailPendingCommands) */
+	void FailDeferredReplies(const FString& Reason);
+
+	// Replies handlers have deferred, until they complete; weak so an abandoned completion frees its reply
+	FCriticalSection DeferredRepliesLock;
+	TArray<TWeakPtr<FMCPPendingReply, ESPMode::ThreadSafe>> DeferredReplies;
+
+	/** bridge_metrics: per-command latency histograms, counts and queue depth (JSON or Prometheus text) */
+	TSharedPtr<FJsonObject> HandleBridgeMetrics(const TSharedPtr<FJsonObject>& Params) const;
+
+	/** bridge_schema: every registered command with its affinity, priority and typed params schema */
+	TSharedPtr<FJsonObject> HandleBridgeSchema(const TSharedPtr<FJsonObject>& Params) const;
+
+	/** bridge_trace: the most recent request/response summaries from FMCPTraceLog */
+	TSharedPtr<FJsonObject> HandleBridgeTrace(const TSharedPtr<FJsonObject>& Params) const;
+
+	/** bridge_shutdown: end the UnrealCompanion commandlet's loop (refused inside an interactive editor) */
+	TSharedPtr<FJsonObject> HandleBridgeShutdown(const TSharedPtr<FJsonObject>& Params);
+
+	/** bridge_benchmark: replay a command mix at several concurrency levels, reply with per-family throughput and latency */
+	TSharedPtr<FJsonObject> HandleBridgeBenchmark(const TSharedPtr<FJsonObject>& Params);
 };
\ No newline at end of file
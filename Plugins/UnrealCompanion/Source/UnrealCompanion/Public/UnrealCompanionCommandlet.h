@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UnrealCompanionCommandlet.generated.h"
+
+/**
+ * Hosts the bridge without the editor UI, for CI.
+ *
+ *   UnrealEditor-Cmd Project.uproject -run=UnrealCompanion -unattended
+ *       [-UnrealCompanionPort=55557] [-Prewarm] [-Map=/Game/Maps/Main] [-IdleExit=600]
+ *
+ * The bridge subsystem starts as in the editor (same command registry, same
+ * server threads); the commandlet only replaces the editor's main loop with a
+ * minimal one that runs game-thread tasks, the core ticker (the command queue)
+ * and the AssetRegistry. Editor focus is headless in a commandlet, so nothing
+ * opens editors and saves wait for core_save.
+ *
+ * -Prewarm finishes the asset scan and builds the asset index (and, with -Map,
+ * the actor index) before the first client connects. The loop ends on
+ * bridge_shutdown, on an engine exit request (Ctrl+C), or after -IdleExit
+ * seconds without a command.
+ */
+UCLASS()
+class UNREALCOMPANION_API UUnrealCompanionCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UUnrealCompanionCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** Load Map (if any), then block until the AssetRegistry and the indexes are ready */
+	static bool Prewarm(const FString& Map);
+};
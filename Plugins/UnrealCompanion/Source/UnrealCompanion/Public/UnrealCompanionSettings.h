@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "UnrealCompanionSettings.generated.h"
+
+/** Whether commands drive editor UI (open, navigate, save and close asset editors) */
+UENUM()
+enum class EUnrealCompanionFocusMode : uint8
+{
+	/** Headless with -unattended, in a commandlet or without Slate; interactive otherwise */
+	Auto,
+	/** Always open and navigate editors, save and close on each modifying command */
+	Interactive,
+	/** Never touch editor UI; saves wait for core_save */
+	Headless
+};
+
+/** How bridge commands are grouped in the editor's undo history */
+UENUM()
+enum class EUnrealCompanionUndoMode : uint8
+{
+	/** One undo step per command */
+	Command,
+	/** One undo step per command, named after the open core_session */
+	Session,
+	/** Changes are kept but not undoable: each command's step is discarded once it ends */
+	None
+};
+
+/** What happens to a command whose undo snapshot is larger than UndoBudgetMB */
+UENUM()
+enum class EUnrealCompanionUndoOverBudget : uint8
+{
+	/** Keep the changes, drop the snapshot (the command cannot be undone) */
+	DropUndo,
+	/** Roll the command back and fail it with UNDO_BUDGET_EXCEEDED */
+	Reject
+};
+
+/**
+ * Project settings for the Unreal Companion bridge.
+ * Editor Preferences → Plugins → Unreal Companion.
+ */
+UCLASS(Config = EditorPerProjectUserSettings, meta = (DisplayName = "Unreal Companion"))
+class UNREALCOMPANION_API UUnrealCompanionSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UUnrealCompanionSettings();
+
+	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
+
+	/**
+	 * Editor frame time (ms) the bridge may spend running queued commands per tick.
+	 * At least one command always runs per tick, so a single heavy command can exceed it.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Scheduler", meta = (ClampMin = "0.5", UIMin = "1", UIMax = "50"))
+	float GameThreadBudgetMs;
+
+	/** Hard cap on commands executed per tick, whatever the budget */
+	UPROPERTY(Config, EditAnywhere, Category = "Scheduler", meta = (ClampMin = "1"))
+	int32 MaxCommandsPerTick;
+
+	/** Queued commands above which new requests are rejected with BRIDGE_BUSY */
+	UPROPERTY(Config, EditAnywhere, Category = "Scheduler", meta = (ClampMin = "1"))
+	int32 MaxQueueDepth;
+
+	/**
+	 * Seconds a client without request ids waits for a command before it gets COMMAND_TIMEOUT.
+	 * The command itself keeps running; its late result is dropped.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Scheduler", meta = (ClampMin = "1", UIMax = "3600"))
+	float CommandTimeoutSeconds;
+
+	/** Editor focus profile; Headless suits build agents where no one watches the editor */
+	UPROPERTY(Config, EditAnywhere, Category = "Editor Focus")
+	EUnrealCompanionFocusMode FocusMode;
+
+	/** Size of the shared-memory ring local clients read large binary results from; 0 disables it */
+	UPROPERTY(Config, EditAnywhere, Category = "Transport", meta = (ClampMin = "0", UIMax = "1024"))
+	int32 SharedMemoryMB;
+
+	/** Undo grouping of commands that do not pass "undo" themselves */
+	UPROPERTY(Config, EditAnywhere, Category = "Undo")
+	EUnrealCompanionUndoMode UndoMode;
+
+	/**
+	 * Largest undo snapshot (MB) one command may leave in the undo buffer; 0 means no
+	 * limit.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Undo", meta = (ClampMin = "0", UIMax = "4096"))
+	int32 UndoBudgetMB;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Undo")
+	EUnrealCompanionUndoOverBudget UndoOverBudget;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * Profiling hooks for command handlers.
+ *
+ * - `stat UnrealCompanion` shows dispatch, graph batch, scatter, sculpt and
+ *   compile times plus queue depth in the viewport.
+ * - In Unreal Insights, capture with `-trace=cpu,UnrealCompanion`: every
+ *   command shows up as a CPU event named after it, with the main phases of
+ *   the heavy handlers nested inside, so a hitch can be attributed to a tool.
+ */
+DECLARE_STATS_GROUP(TEXT("UnrealCompanion"), STATGROUP_UnrealCompanion, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Command Dispatch"), STAT_UnrealCompanion_Dispatch, STATGROUP_UnrealCompanion, UNREALCOMPANION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Graph Batch"), STAT_UnrealCompanion_GraphBatch, STATGROUP_UnrealCompanion, UNREALCOMPANION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Foliage Scatter"), STAT_UnrealCompanion_FoliageScatter, STATGROUP_UnrealCompanion, UNREALCOMPANION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spline Scatter"), STAT_UnrealCompanion_SplineScatter, STATGROUP_UnrealCompanion, UNREALCOMPANION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Landscape Sculpt"), STAT_UnrealCompanion_LandscapeSculpt, STATGROUP_UnrealCompanion, UNREALCOMPANION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Blueprint Compile"), STAT_UnrealCompanion_Compile, STATGROUP_UnrealCompanion, UNREALCOMPANION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Commands Executed (per frame)"), STAT_UnrealCompanion_CommandsExecuted, STATGROUP_UnrealCompanion, UNREALCOMPANION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Queue Depth"), STAT_UnrealCompanion_QueueDepth, STATGROUP_UnrealCompanion, UNREALCOMPANION_API);
+
+UE_TRACE_CHANNEL_EXTERN(UnrealCompanionChannel, UNREALCOMPANION_API);
+
+/** Stat counter plus an Insights event of the same name, for a whole handler or phase */
+#define UNREALCOMPANION_SCOPE_CYCLE_COUNTER(Stat) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, UnrealCompanionChannel); \
+	SCOPE_CYCLE_COUNTER(Stat)
+
+/** Insights-only event for a phase inside a handler; Name is a string literal */
+#define UNREALCOMPANION_TRACE_SCOPE(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, UnrealCompanionChannel)
+
+/** Insights event with a runtime name (one per command, named after it) */
+#define UNREALCOMPANION_TRACE_SCOPE_TEXT(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(Name, UnrealCompanionChannel)
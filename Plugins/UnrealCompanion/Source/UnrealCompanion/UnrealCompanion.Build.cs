@@ -52,6 +52,8 @@ public class UnrealCompanion : ModuleRules
 				"KismetCompiler",
 				"BlueprintGraph",
 				"Projects",
+				"RenderCore",          // For ENQUEUE_RENDER_COMMAND (render-thread command affinity)
+				"RHI",                 // For FRHIGPUTextureReadback (async viewport screenshots)
 				"AssetRegistry",
 					"PythonScriptPlugin",  // For python_execute commands
 			"AnimGraph",           // For Animation Blueprint graphs
@@ -63,6 +65,7 @@ public class UnrealCompanion : ModuleRules
 				"Foliage",             // For AInstancedFoliageActor, UFoliageType (runtime)
 				"GeometryCore",        // For FDynamicMesh3 core types
 				"GeometryScriptingCore", // For UGeometryScriptLibrary_* functions
+				"GeometryAlgorithms",  // For FMeshBoolean (parallel multi-tool booleans)
 				"GeometryFramework",   // For UDynamicMesh, ADynamicMeshActor
 				"DynamicMesh",         // For DynamicMeshComponent
 				"MeshDescription"      // For mesh data types
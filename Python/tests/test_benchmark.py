@@ -0,0 +1,131 @@
+"""Unit tests for utils/benchmark.py (bridge benchmark and load generator)."""
+
+import json
+import socket
+import sys
+import threading
+from pathlib import Path
+
+# Add parent directory to path for imports
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from utils.benchmark import (
+    default_mix,
+    default_setup,
+    graph_chain,
+    interleave,
+    quantile,
+    run_socket_level,
+    summarize_family,
+)
+from utils.framing import decode_payload, encode_frame, read_frame
+
+
+class TestMix:
+    """Tests for the default mix and its schedule."""
+
+    def test_default_mix_covers_required_families(self):
+        families = {entry["family"] for entry in default_mix()}
+        assert {"ping", "core_query", "graph_batch_10", "graph_batch_100", "graph_batch_1000",
+                "world_spawn_batch", "foliage_scatter", "landscape_sculpt"} <= families
+
+    def test_graph_chain_sizes(self):
+        for size in (10, 100, 1000):
+            params = graph_chain("BP_Test", size)
+            assert len(params["nodes"]) == size
+            assert len(params["connections"]) == size - 1
+            assert params["auto_compile"] is False
+
+    def test_scale_keeps_at_least_one_iteration(self):
+        assert all(entry["iterations"] >= 1 for entry in default_mix(scale=0.001))
+
+    def test_interleave_is_round_robin(self):
+        mix = [{"type": "a", "iterations": 3}, {"type": "b", "iterations": 1}, {"type": "c", "iterations": 2}]
+        assert interleave(mix) == [0, 1, 2, 0, 2, 0]
+
+    def test_mix_is_json_serializable(self):
+        json.dumps({"mix": default_mix(), "setup": default_setup()})
+
+
+class TestSummary:
+    """Tests for latency summaries."""
+
+    def test_quantile_nearest_rank(self):
+        values = [float(v) for v in range(1, 101)]
+        assert quantile(values, 0.5) == 50.0
+        assert quantile(values, 0.99) == 99.0
+        assert quantile(values, 1.0) == 100.0
+        assert quantile([], 0.5) == 0.0
+
+    def test_summarize_family(self):
+        summary = summarize_family("ping", [3.0, 1.0, 2.0], errors=1, wall_seconds=2.0)
+        assert summary["count"] == 3
+        assert summary["errors"] == 1
+        assert summary["throughput_rps"] == 1.5
+        assert summary["p50_ms"] == 2.0
+        assert summary["max_ms"] == 3.0
+
+
+class _FakeBridge:
+    """Framed server that answers every request, failing the ones named 'fail'."""
+
+    def __init__(self):
+        self.listener = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        self.listener.bind(("127.0.0.1", 0))
+        self.listener.listen(16)
+        self.port = self.listener.getsockname()[1]
+        self.received = []
+        self.lock = threading.Lock()
+        threading.Thread(target=self._accept, daemon=True).start()
+
+    def _accept(self):
+        while True:
+            try:
+                conn, _ = self.listener.accept()
+            except OSError:
+                return
+            threading.Thread(target=self._serve, args=(conn,), daemon=True).start()
+
+    def _serve(self, conn):
+        with conn:
+            while True:
+                try:
+                    flags, payload = read_frame(conn)
+                except (ConnectionError, OSError):
+                    return
+                request = decode_payload(flags, payload)
+                with self.lock:
+                    self.received.append(request["type"])
+                if request["type"] == "fail":
+                    response = {"status": "error", "error": "boom"}
+                else:
+                    response = {"status": "success", "result": {"success": True}}
+                conn.sendall(encode_frame(json.dumps(response).encode("utf-8")))
+
+    def close(self):
+        self.listener.close()
+
+
+class TestSocketMode:
+    """End-to-end socket mode against a fake bridge."""
+
+    def test_level_report(self):
+        bridge = _FakeBridge()
+        try:
+            mix = [
+                {"family": "ping", "type": "ping", "params": {}, "iterations": 20},
+                {"family": "broken", "type": "fail", "params": {}, "iterations": 5},
+            ]
+            setup = [{"type": "reset", "params": {}}]
+            level = run_socket_level(mix, setup, concurrency=4, port=bridge.port, timeout=5.0)
+        finally:
+            bridge.close()
+
+        assert level["concurrency"] == 4
+        assert level["requests"] == 25
+        assert level["errors"] == 5
+        assert level["families"]["ping"]["count"] == 20
+        assert level["families"]["ping"]["errors"] == 0
+        assert level["families"]["broken"]["errors"] == 5
+        assert bridge.received[0] == "reset"
+        assert bridge.received.count("ping") == 20
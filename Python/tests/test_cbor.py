@@ -0,0 +1,109 @@
+"""Unit tests for utils/cbor.py (binary wire format)."""
+
+import json
+import struct
+import sys
+from pathlib import Path
+
+import pytest
+
+# Add parent directory to path for imports
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from utils import cbor
+from utils.framing import (
+    FLAG_CBOR,
+    HEADER_SIZE,
+    PAYLOAD_ENCODING_MASK,
+    decode_header,
+    decode_payload,
+    encode_cbor_frame,
+)
+
+
+class TestRoundtrip:
+    """Values survive dumps/loads unchanged."""
+
+    def test_scalars_and_containers(self):
+        message = {
+            "type": "world_spawn_batch",
+            "params": {"count": 3, "scale": 1.5, "negative": -42, "on": True, "off": False, "none": None},
+            "name": "Épée",
+            "nested": [[1, "a"], {"k": []}],
+        }
+        assert cbor.loads(cbor.dumps(message)) == message
+
+    def test_large_integers(self):
+        values = [0, 23, 24, 255, 256, 65535, 65536, 2 ** 32, 2 ** 40, -1, -25, -(2 ** 40)]
+        assert cbor.loads(cbor.dumps(values)) == values
+
+
+class TestPackedArrays:
+    """Numeric lists travel as RFC 8746 typed arrays."""
+
+    def test_short_lists_are_not_packed(self):
+        encoded = cbor.dumps(list(range(cbor.PACKED_ARRAY_MIN_LENGTH - 1)))
+        assert encoded[0] >> 5 == 4  # plain array
+
+    def test_int32_list_uses_tag_78(self):
+        values = list(range(-100000, 100000, 997))
+        encoded = cbor.dumps(values)
+        assert encoded[:2] == bytes([0xD8, cbor.TAG_SINT32_LE])
+        assert len(encoded) < len(json.dumps(values))
+        assert cbor.loads(encoded) == values
+
+    def test_float_list_uses_tag_86(self):
+        values = [i * 0.25 for i in range(32)]
+        encoded = cbor.dumps(values)
+        assert encoded[:2] == bytes([0xD8, cbor.TAG_FLOAT64_LE])
+        assert cbor.loads(encoded) == values
+
+    def test_mixed_list_is_not_packed(self):
+        values = list(range(20)) + ["x"]
+        assert cbor.loads(cbor.dumps(values)) == values
+
+    def test_float32_typed_array_decodes(self):
+        payload = struct.pack("<3f", 1.0, 2.5, -4.0)
+        encoded = bytes([0xD8, 85, 0x40 | len(payload)]) + payload
+        assert cbor.loads(encoded) == [1.0, 2.5, -4.0]
+
+
+class TestDecoding:
+    """Decoder edge cases."""
+
+    def test_embedded_json_tag(self):
+        raw = b'[{"id":1}]'
+        encoded = bytes([0xD9, 0x01, 0x06, 0x40 | len(raw)]) + raw
+        assert cbor.loads(encoded) == [{"id": 1}]
+
+    def test_indefinite_containers(self):
+        # {_ "a": [_ 1, 2]}
+        encoded = bytes([0xBF, 0x61, ord("a"), 0x9F, 0x01, 0x02, 0xFF, 0xFF])
+        assert cbor.loads(encoded) == {"a": [1, 2]}
+
+    def test_half_float(self):
+        assert cbor.loads(bytes([0xF9, 0x3E, 0x00])) == 1.5
+
+    def test_truncated_input_rejected(self):
+        with pytest.raises(ValueError):
+            cbor.loads(cbor.dumps({"name": "value"})[:-2])
+
+    def test_trailing_bytes_rejected(self):
+        with pytest.raises(ValueError):
+            cbor.loads(cbor.dumps(1) + b"\x00")
+
+
+class TestCborFrames:
+    """CBOR payloads in wire frames."""
+
+    def test_frame_sets_cbor_flag(self):
+        message = {"type": "foliage_scatter", "params": {"seeds": list(range(1000))}}
+        frame = encode_cbor_frame(message)
+        flags, length = decode_header(frame[:HEADER_SIZE])
+        assert flags & PAYLOAD_ENCODING_MASK == FLAG_CBOR
+        assert length == len(frame) - HEADER_SIZE
+        assert decode_payload(flags, frame[HEADER_SIZE:]) == message
+
+    def test_unknown_encoding_rejected(self):
+        with pytest.raises(ValueError):
+            decode_payload(0x0E, b"{}")
@@ -0,0 +1,118 @@
+"""Unit tests for utils/command_schema.py (client-side validation against bridge_schema)."""
+
+import sys
+from pathlib import Path
+
+# Add parent directory to path for imports
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from utils.command_schema import CommandSchema, SchemaCache
+
+# Shaped like a bridge_schema reply
+SCHEMA = {
+    "success": True,
+    "count": 3,
+    "commands": {
+        "graph_node_find": {
+            "affinity": "game_thread",
+            "priority": "high",
+            "params": {
+                "fields": [
+                    {"name": "blueprint_name", "type": "string", "required": True, "aliases": ["asset_path"]},
+                    {"name": "node_type", "type": "string", "required": False,
+                     "one_of": ["event", "custom_event", "function_call"]},
+                    {"name": "only_pure", "type": "boolean", "required": False},
+                    {"name": "since_revision", "type": "integer", "required": False},
+                    {"name": "position", "type": "vector", "required": False},
+                ],
+                "server_checks": False,
+            },
+        },
+        "world_spawn_batch": {
+            "affinity": "game_thread",
+            "priority": "normal",
+            "params": {
+                "fields": [],
+                "standard": [
+                    {"name": "verbosity", "one_of": ["minimal", "normal", "full"]},
+                    {"name": "on_error", "one_of": ["rollback", "continue", "stop"]},
+                ],
+                "server_checks": False,
+            },
+        },
+        "asset_list": {"affinity": "any_thread", "priority": "normal"},
+    },
+}
+
+
+class TestValidate:
+    def setup_method(self):
+        self.schema = CommandSchema(SCHEMA)
+
+    def test_valid_request_passes(self):
+        params = {"blueprint_name": "/Game/BP_Door", "node_type": "Event", "only_pure": True}
+        assert self.schema.validate("graph_node_find", params) is None
+
+    def test_missing_required_names_aliases(self):
+        error = self.schema.validate("graph_node_find", {"node_type": "event"})
+        assert error == "Missing required parameter 'blueprint_name' (or 'asset_path')"
+
+    def test_alias_and_null_as_absent(self):
+        assert self.schema.validate("graph_node_find", {"asset_path": "/Game/BP"}) is None
+        assert self.schema.validate("graph_node_find", {"blueprint_name": None}) is not None
+
+    def test_one_of_is_case_insensitive_and_empty_passes(self):
+        assert self.schema.validate("graph_node_find", {"blueprint_name": "BP", "node_type": ""}) is None
+        error = self.schema.validate("graph_node_find", {"blueprint_name": "BP", "node_type": "macro"})
+        assert error.startswith("Parameter 'node_type' must be one of: event, custom_event")
+
+    def test_types_accept_json_value_conversions(self):
+        lenient = {"blueprint_name": 12, "only_pure": 1, "since_revision": "7", "position": [1, "2", 3.5, 9]}
+        assert self.schema.validate("graph_node_find", lenient) is None
+
+    def test_wrong_types_rejected(self):
+        assert self.schema.validate("graph_node_find", {"blueprint_name": ["BP"]}) == \
+            "Parameter 'blueprint_name' must be a string"
+        assert self.schema.validate("graph_node_find", {"blueprint_name": "BP", "since_revision": "abc"}) == \
+            "Parameter 'since_revision' must be an integer"
+        assert self.schema.validate("graph_node_find", {"blueprint_name": "BP", "position": [1, 2]}) == \
+            "Parameter 'position' must be an [x, y, z] array"
+
+    def test_standard_enums_checked(self):
+        assert self.schema.validate("world_spawn_batch", {"verbosity": "FULL"}) is None
+        error = self.schema.validate("world_spawn_batch", {"on_error": "ignore"})
+        assert error == "Parameter 'on_error' must be one of: rollback, continue, stop (got 'ignore')"
+
+    def test_untyped_and_unknown_commands_pass(self):
+        assert self.schema.validate("asset_list", {"anything": object()}) is None
+        assert self.schema.validate("ping", {}) is None
+        assert self.schema.knows("asset_list") and not self.schema.knows("ping")
+        assert self.schema.affinity("asset_list") == "any_thread"
+
+
+class TestSchemaCache:
+    def test_fetches_once(self):
+        calls = []
+        cache = SchemaCache(lambda: calls.append(1) or {"status": "success", "result": SCHEMA})
+        assert cache.validate("graph_node_find", {}) is not None
+        assert cache.validate("graph_node_find", {"blueprint_name": "BP"}) is None
+        assert len(calls) == 1
+
+    def test_no_reply_retries(self):
+        replies = [None, {"status": "error", "error": "Timeout receiving Unreal response"},
+                   {"status": "success", "result": SCHEMA}]
+        cache = SchemaCache(lambda: replies.pop(0))
+        assert cache.get() is None
+        assert cache.get() is None
+        assert cache.get() is not None
+
+    def test_plugin_without_schema_not_asked_again(self):
+        calls = []
+        reply = {"status": "error", "error": "Unknown command: bridge_schema. 150 commands registered."}
+        cache = SchemaCache(lambda: calls.append(1) or reply)
+        assert cache.validate("graph_node_find", {}) is None
+        assert cache.validate("graph_node_find", {}) is None
+        assert len(calls) == 1
+        cache.reset()
+        cache.get()
+        assert len(calls) == 2
@@ -0,0 +1,76 @@
+"""Unit tests for utils/foliage_transforms.py (foliage_export/import records)."""
+
+import base64
+import struct
+import sys
+from pathlib import Path
+
+import pytest
+
+# Add parent directory to path for imports
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from utils.foliage_transforms import (
+    RECORD_SIZE,
+    decode_export,
+    encode_instances,
+    export_to_import,
+    pack_instances,
+    unpack_instances,
+)
+
+TREE = (1000000.125, -250.5, 42.0, 0.0, 90.0, 0.0, 1.0, 1.0, 1.5)
+ROCK = (-3.0, 7.0, 0.25, 5.0, 180.0, -5.0, 0.5, 0.5, 0.5)
+
+
+class TestRecords:
+    def test_record_matches_plugin_layout(self):
+        assert RECORD_SIZE == 48
+        data = pack_instances([TREE])
+        assert struct.unpack_from("<3d", data, 0) == TREE[:3]
+        assert struct.unpack_from("<6f", data, 24) == TREE[3:]
+
+    def test_round_trip_keeps_double_location(self):
+        assert unpack_instances(pack_instances([TREE, ROCK])) == [TREE, ROCK]
+
+    def test_truncated_data_rejected(self):
+        with pytest.raises(ValueError):
+            unpack_instances(pack_instances([TREE])[:-4])
+
+    def test_encode_is_base64_of_records(self):
+        assert base64.b64decode(encode_instances([ROCK])) == pack_instances([ROCK])
+
+
+def make_export():
+    return {
+        "success": True,
+        "types": [
+            {"name": "Tree_FT", "mesh": "/Game/SM_Tree", "count": 3, "chunks": [
+                {"seq": 1, "type": 0, "count": 1, "data": encode_instances([ROCK])},
+                {"seq": 0, "type": 0, "count": 2, "data": encode_instances([TREE, TREE])},
+            ]},
+            {"name": "Grass", "foliage_type": "/Game/FT_Grass.FT_Grass", "count": 1, "chunks": [
+                {"seq": 2, "type": 1, "count": 1, "data": encode_instances([ROCK])},
+            ]},
+        ],
+    }
+
+
+class TestExport:
+    def test_decode_orders_chunks_by_seq(self):
+        decoded = decode_export(make_export())
+        assert decoded["/Game/SM_Tree"] == [TREE, TREE, ROCK]
+        assert decoded["/Game/FT_Grass.FT_Grass"] == [ROCK]
+
+    def test_unresolved_handle_rejected(self):
+        result = make_export()
+        chunk = result["types"][1]["chunks"][0]
+        del chunk["data"]
+        chunk["shared_memory"] = {"name": "UnrealCompanion_1", "offset": 64, "length": 48, "sequence": 3}
+        with pytest.raises(ValueError):
+            decode_export(result)
+
+    def test_export_to_import_keeps_chunks_and_targets(self):
+        entries = export_to_import(make_export())
+        assert [set(e) for e in entries] == [{"mesh", "data"}, {"mesh", "data"}, {"foliage_type", "data"}]
+        assert entries[2]["foliage_type"] == "/Game/FT_Grass.FT_Grass"
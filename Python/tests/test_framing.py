@@ -0,0 +1,118 @@
+"""Unit tests for utils/framing.py (TCP wire framing)."""
+
+import json
+import socket
+import sys
+import threading
+from pathlib import Path
+
+import pytest
+
+# Add parent directory to path for imports
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from utils.framing import (
+    FLAG_ACCEPT_COMPRESSED,
+    FLAG_COMPRESSED,
+    FLAG_JSON,
+    FRAME_MARKER,
+    HEADER_SIZE,
+    MAX_FRAME_SIZE,
+    compress_payload,
+    decode_header,
+    decode_payload,
+    decompress_payload,
+    encode_frame,
+    encode_json_frame,
+    read_frame,
+)
+
+
+class TestEncodeFrame:
+    """Tests for frame encoding."""
+
+    def test_header_layout(self):
+        frame = encode_frame(b"abc")
+        assert frame[0] == FRAME_MARKER
+        assert frame[1] == 0
+        assert int.from_bytes(frame[2:6], "big") == 3
+        assert frame[HEADER_SIZE:] == b"abc"
+
+    def test_length_is_utf8_bytes_not_characters(self):
+        """Non-ASCII text must be measured in bytes."""
+        frame = encode_json_frame({"name": "Épée"})
+        _, length = decode_header(frame[:HEADER_SIZE])
+        assert length == len(frame) - HEADER_SIZE
+        assert json.loads(frame[HEADER_SIZE:].decode("utf-8")) == {"name": "Épée"}
+
+    def test_oversized_payload_rejected(self):
+        with pytest.raises(ValueError):
+            encode_frame(b"x" * (MAX_FRAME_SIZE + 1))
+
+
+class TestCompression:
+    """Tests for compressed payloads."""
+
+    def test_requests_advertise_compression(self):
+        frame = encode_json_frame({"type": "ping"})
+        assert frame[1] == FLAG_JSON | FLAG_ACCEPT_COMPRESSED
+
+    def test_compressed_payload_roundtrip(self):
+        message = {"nodes": [{"id": i, "title": "Print String"} for i in range(5000)]}
+        payload = json.dumps(message).encode("utf-8")
+        compressed = compress_payload(payload)
+        assert len(compressed) < len(payload) // 4
+        assert decode_payload(FLAG_JSON | FLAG_COMPRESSED, compressed) == message
+
+    def test_length_mismatch_rejected(self):
+        compressed = compress_payload(b"x" * 1000)
+        tampered = (999).to_bytes(4, "big") + compressed[4:]
+        with pytest.raises(ValueError):
+            decompress_payload(tampered)
+
+    def test_oversized_length_rejected(self):
+        with pytest.raises(ValueError):
+            decompress_payload((MAX_FRAME_SIZE + 1).to_bytes(4, "big") + b"\x78\x9c")
+
+
+class TestDecodeHeader:
+    """Tests for header validation."""
+
+    def test_bad_marker_rejected(self):
+        with pytest.raises(ValueError):
+            decode_header(b"{\x00\x00\x00\x00\x01")
+
+    def test_short_header_rejected(self):
+        with pytest.raises(ValueError):
+            decode_header(b"\xfe\x00")
+
+
+class TestReadFrame:
+    """Tests for reading frames from a socket."""
+
+    def test_roundtrip_large_payload(self):
+        """Payloads larger than a single recv are reassembled."""
+        payload = json.dumps({"items": list(range(200000))}).encode("utf-8")
+        left, right = socket.socketpair()
+        try:
+            frame = encode_frame(payload)
+            # Send from a thread: the payload is larger than the socket buffer
+            sender = threading.Thread(target=lambda: (left.sendall(frame[:100]), left.sendall(frame[100:])))
+            sender.start()
+            flags, received = read_frame(right)
+            sender.join()
+            assert flags == 0
+            assert received == payload
+        finally:
+            left.close()
+            right.close()
+
+    def test_closed_mid_frame_raises(self):
+        left, right = socket.socketpair()
+        try:
+            left.sendall(encode_frame(b"hello world")[:8])
+            left.close()
+            with pytest.raises(ConnectionError):
+                read_frame(right)
+        finally:
+            right.close()
@@ -0,0 +1,156 @@
+"""Unit tests for utils/router.py (multi-editor command routing)."""
+
+import sys
+import threading
+from pathlib import Path
+
+import pytest
+
+# Add parent directory to path for imports
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from utils.router import (
+    CommandRouter,
+    Instance,
+    decode_router_cursor,
+    encode_router_cursor,
+    extract_paths,
+    merge_query_results,
+    parse_instances,
+)
+
+
+def ok(result):
+    return {"status": "success", "result": result}
+
+
+class FakeEditors:
+    """Records which port each command went to and answers from a table."""
+
+    def __init__(self, replies=None):
+        self.calls = []
+        self.replies = replies or {}
+        self.lock = threading.Lock()
+
+    def __call__(self, port, command, params):
+        with self.lock:
+            self.calls.append((port, command, dict(params)))
+        reply = self.replies.get(port)
+        return reply(params) if callable(reply) else (reply or ok({"success": True}))
+
+
+def make_router(spec, replies=None):
+    editors = FakeEditors(replies)
+    return CommandRouter(parse_instances(spec), editors), editors
+
+
+class TestParseInstances:
+    def test_ports_and_prefixes(self):
+        instances = parse_instances("55557=/Game/Forest,/Game/Maps/Forest/;55558")
+        assert [i.port for i in instances] == [55557, 55558]
+        assert instances[0].prefixes == ("/Game/Forest", "/Game/Maps/Forest")
+        assert instances[1].prefixes == ()
+
+    def test_duplicate_port_rejected(self):
+        with pytest.raises(ValueError):
+            parse_instances("55557;55557=/Game/A")
+
+
+class TestExtractPaths:
+    def test_path_keys_and_lists(self):
+        params = {"material_path": "/Game/A/M", "name": "/not/a/path/key",
+                  "instances": ["/Game/B/MI", {"path": "/Game/C/MI"}]}
+        assert extract_paths(params) == ["/Game/A/M", "/Game/B/MI", "/Game/C/MI"]
+
+    def test_names_are_not_paths(self):
+        assert extract_paths({"blueprint_name": "BP_Player", "path": ""}) == []
+
+
+class TestRoute:
+    def test_longest_prefix_wins(self):
+        router, _ = make_router("1=/Game;2=/Game/Forest")
+        assert router.route("asset_create", {"path": "/Game/Forest/Trees/T1"}).port == 2
+        assert router.route("asset_create", {"path": "/Game/Desert/D1"}).port == 1
+
+    def test_prefix_matches_whole_segments(self):
+        router, _ = make_router("1=/Game/Forest;2")
+        assert router.route("asset_create", {"path": "/Game/ForestOld/X"}).port == 2
+
+    def test_level_affinity_follows_last_routed_path(self):
+        router, _ = make_router("1=/Game/Maps/A;2=/Game/Maps/B")
+        assert router.route("world_create_actor", {}).port == 1
+        router.route("level_open", {"level_path": "/Game/Maps/B/Main"})
+        assert router.route("world_create_actor", {"actor_name": "Cube"}).port == 2
+
+    def test_unowned_path_goes_to_least_busy_pool_instance(self):
+        router, _ = make_router("1=/Game/A;2;3")
+        router.instances[1].in_flight = 4
+        assert router.route("asset_create", {"path": "/Game/Shared/X"}).port == 3
+
+
+class TestFanOut:
+    def test_owned_path_is_not_fanned_out(self):
+        router, editors = make_router("1=/Game/A;2=/Game/B")
+        router.send_command("core_query", {"type": "asset", "path": "/Game/B"})
+        assert [call[0] for call in editors.calls] == [2]
+
+    def test_assets_deduplicated_across_instances(self):
+        router, editors = make_router("1=/Game/A;2=/Game/B", {
+            1: ok({"results": [{"path": "/Game/A/X"}, {"path": "/Game/Shared"}], "total_found": 2}),
+            2: ok({"results": [{"path": "/Game/Shared"}, {"path": "/Game/B/Y"}], "total_found": 2}),
+        })
+        response = router.send_command("core_query", {"type": "asset", "action": "list"})
+        result = response["result"]
+        assert sorted(r["path"] for r in result["results"]) == ["/Game/A/X", "/Game/B/Y", "/Game/Shared"]
+        assert result["count"] == 3
+        assert sorted(call[0] for call in editors.calls) == [1, 2]
+
+    def test_actors_kept_per_instance(self):
+        router, _ = make_router("1;2", {
+            1: ok({"results": [{"name": "Cube"}], "total_found": 1}),
+            2: ok({"results": [{"name": "Cube"}], "total_found": 1}),
+        })
+        result = router.send_command("core_query", {"type": "actor"})["result"]
+        assert sorted(r["instance"] for r in result["results"]) == [1, 2]
+        assert result["total_found"] == 2
+
+    def test_cursor_resumes_only_instances_with_more(self):
+        router, editors = make_router("1;2", {
+            1: ok({"results": [], "next_cursor": "c1"}),
+            2: ok({"results": []}),
+        })
+        first = router.send_command("core_query", {"type": "actor"})["result"]
+        assert decode_router_cursor(first["next_cursor"]) == {1: "c1"}
+
+        editors.calls.clear()
+        router.send_command("core_query", {"type": "actor", "cursor": first["next_cursor"]})
+        assert [(call[0], call[2]["cursor"]) for call in editors.calls] == [(1, "c1")]
+
+    def test_failed_instance_reported(self):
+        router, _ = make_router("1;2", {
+            1: ok({"results": [{"name": "A"}]}),
+            2: {"status": "error", "error": "down"},
+        })
+        result = router.send_command("core_query", {"type": "actor"})["result"]
+        assert result["instance_errors"] == {"2": "down"}
+        assert result["count"] == 1
+
+
+class TestMerge:
+    def test_exists_is_any(self):
+        merged = merge_query_results("asset", "exists", {1: ok({"exists": False}), 2: ok({"exists": True})})
+        assert merged["result"]["exists"] is True
+
+    def test_all_failed_is_error(self):
+        merged = merge_query_results("asset", "list", {1: None})
+        assert merged["status"] == "error"
+
+    def test_cursor_round_trip(self):
+        assert decode_router_cursor(encode_router_cursor({55557: "abc", 55558: "d=="})) == {55557: "abc", 55558: "d=="}
+
+
+def test_in_flight_released_after_send():
+    router, _ = make_router("1")
+    router.send_command("ping", {})
+    assert router.instances[0].in_flight == 0
+    assert isinstance(router.instances[0], Instance)
@@ -0,0 +1,108 @@
+"""Unit tests for utils/shared_memory.py (shared-memory ring reader)."""
+
+import base64
+import os
+import struct
+import sys
+from multiprocessing import shared_memory
+from pathlib import Path
+
+import pytest
+
+# Add parent directory to path for imports
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from utils import shared_memory as ucshm
+from utils.shared_memory import (
+    HEADER_SIZE,
+    MAGIC,
+    RECORD_HEADER_SIZE,
+    SharedBlobUnavailable,
+    read_blob,
+    resolve_base64_field,
+)
+
+
+class FakeRing:
+    """Writes records the way FMCPSharedMemory does."""
+
+    def __init__(self, size=4096):
+        self.name = f"UCTest_{os.getpid()}_{id(self)}"
+        self.region = shared_memory.SharedMemory(name=self.name, create=True, size=size)
+        self.region.buf[:len(MAGIC)] = MAGIC
+        struct.pack_into("<Q", self.region.buf, 8, size)
+        self.head = HEADER_SIZE
+        self.sequence = 0
+
+    def write(self, data):
+        self.sequence += 1
+        offset = self.head
+        struct.pack_into("<QQ", self.region.buf, offset, self.sequence, len(data))
+        data_offset = offset + RECORD_HEADER_SIZE
+        self.region.buf[data_offset:data_offset + len(data)] = data
+        self.head = data_offset + ((len(data) + 15) // 16) * 16
+        return {"name": self.name, "size": self.region.size, "offset": data_offset,
+                "length": len(data), "sequence": self.sequence}
+
+    def close(self):
+        ucshm.close_all()
+        self.region.close()
+        if os.name == "posix":
+            # The reader unregistered the name from this process's resource tracker; unlink expects it
+            from multiprocessing import resource_tracker
+            resource_tracker.register(self.region._name, "shared_memory")  # noqa: SLF001
+        self.region.unlink()
+
+
+class TestReadBlob:
+    """Tests for reading records out of the ring."""
+
+    def test_reads_record(self):
+        ring = FakeRing()
+        handle = ring.write(b"\x89PNG payload")
+        try:
+            assert read_blob(handle) == b"\x89PNG payload"
+        finally:
+            ring.close()
+
+    def test_overwritten_record_is_rejected(self):
+        ring = FakeRing()
+        handle = ring.write(b"old")
+        try:
+            struct.pack_into("<QQ", ring.region.buf, handle["offset"] - RECORD_HEADER_SIZE, 0, 0)
+            with pytest.raises(SharedBlobUnavailable):
+                read_blob(handle)
+        finally:
+            ring.close()
+
+    def test_out_of_range_handle_is_rejected(self):
+        ring = FakeRing()
+        handle = ring.write(b"abc")
+        try:
+            handle["offset"] = ring.region.size
+            with pytest.raises(SharedBlobUnavailable):
+                read_blob(handle)
+        finally:
+            ring.close()
+
+    def test_missing_region_is_rejected(self):
+        with pytest.raises(SharedBlobUnavailable):
+            read_blob({"name": "UCTest_missing_region", "offset": 80, "length": 1, "sequence": 1})
+
+
+class TestResolveBase64Field:
+    """Tests for turning a handle back into an inline field."""
+
+    def test_replaces_handle(self):
+        ring = FakeRing()
+        try:
+            result = {"success": True, "shared_memory": ring.write(b"image bytes")}
+            resolve_base64_field(result, "image_base64")
+            assert "shared_memory" not in result
+            assert base64.b64decode(result["image_base64"]) == b"image bytes"
+        finally:
+            ring.close()
+
+    def test_without_handle_is_unchanged(self):
+        result = {"success": True, "image_base64": "AAAA"}
+        assert resolve_base64_field(result, "image_base64") == {"success": True, "image_base64": "AAAA"}
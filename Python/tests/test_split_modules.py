@@ -81,6 +81,8 @@ FOLIAGE_TOOLS = [
     "foliage_add_type",
     "foliage_scatter",
     "foliage_remove",
+    "foliage_export",
+    "foliage_import",
 ]
 
 
@@ -95,8 +97,8 @@ class TestFoliageTools:
         from tools.foliage_tools import register_foliage_tools
         mock_mcp = create_mock_mcp()
         register_foliage_tools(mock_mcp)
-        assert len(mock_mcp._registered_tools) == 3, (
-            f"Expected 3 foliage tools, got {len(mock_mcp._registered_tools)}: "
+        assert len(mock_mcp._registered_tools) == 5, (
+            f"Expected 5 foliage tools, got {len(mock_mcp._registered_tools)}: "
             f"{mock_mcp._registered_tools}"
         )
 
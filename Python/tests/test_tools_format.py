@@ -201,13 +201,13 @@ class TestToolCount:
                 tools = get_tool_functions(filepath)
                 total_tools += len(tools)
         
-        # We expect 76 tools detected by AST parsing.
+        # We expect 79 tools detected by AST parsing.
         # Note: meshy_tools.py registers 11 tools dynamically (not via @mcp.tool decorator),
-        # so total MCP tools is 87 but AST-detectable tools is 76.
-        assert total_tools == 76, (
-            f"Expected 76 AST-detectable tools, found {total_tools}. "
+        # so total MCP tools is 90 but AST-detectable tools is 79.
+        assert total_tools == 79, (
+            f"Expected 79 AST-detectable tools, found {total_tools}. "
             "Update this count if tools were added/removed. "
-            "Total MCP tools including dynamic registration is 87."
+            "Total MCP tools including dynamic registration is 90."
         )
     
     def test_per_file_tool_count(self):
@@ -171,9 +171,9 @@ class TestToolRegistration:
         mock_mcp = self.create_mock_mcp()
         register_all_tools(mock_mcp)
         
-        # Should have 87 tools total
-        assert len(mock_mcp._registered_tools) == 87, (
-            f"Expected 87 tools, got {len(mock_mcp._registered_tools)}: "
+        # Should have 90 tools total
+        assert len(mock_mcp._registered_tools) == 90, (
+            f"Expected 90 tools, got {len(mock_mcp._registered_tools)}: "
             f"{mock_mcp._registered_tools}"
         )
 
@@ -0,0 +1,130 @@
+"""Checks the plugin's list of commands that run outside the bridge transaction.
+
+The bridge wraps every game-thread command in one editor transaction
+(FUnrealCompanionUndoPolicy::FScope). Deleting assets resets the undo buffer,
+saves and level loads refuse to run inside a transaction, and undo/redo, PIE,
+the console and scripts can do any of those. A command whose handler reaches
+one of these calls must be listed in IsOutsideTransactions
+(UnrealCompanionUndoPolicy.cpp).
+
+The plugin cannot be built here, so these tests read its sources: each command
+is mapped to its handler (command table rows and CommandType == TEXT(...)
+branches), and the handler and the functions of the same file it calls are
+searched for the calls below.
+"""
+
+import re
+from pathlib import Path
+from typing import Dict, Set
+
+import pytest
+
+PLUGIN_SOURCE = Path(__file__).parent.parent.parent / "Plugins" / "UnrealCompanion" / "Source" / "UnrealCompanion"
+COMMANDS_DIR = PLUGIN_SOURCE / "Private" / "Commands"
+UNDO_POLICY_CPP = COMMANDS_DIR / "UnrealCompanionUndoPolicy.cpp"
+
+# Calls that must not run inside a bridge transaction, by what they do
+UNSAFE_CALLS = {
+    "delete": r"ObjectTools::(?:Force)?DeleteObjects|ObjectTools::DeleteAssets|UEditorAssetLibrary::Delete\w+",
+    "save": r"UPackage::SavePackage|UEditorLoadingAndSavingUtils::Save\w+|FEditorFileUtils::Save\w+"
+            r"|UEditorAssetLibrary::Save\w+|FUnrealCompanionPackageSaver::Get\(\)\.(?:Save|SaveNow|StartJob)\b"
+            r"|FlushDeferredSaves|->bSave\s*=",
+    "load": r"FEditorFileUtils::LoadMap|UEditorLoadingAndSavingUtils::(?:LoadMap|New\w*Map)|GEditor->NewMap",
+    "undo": r"GEditor->(?:Undo|Redo)Transaction",
+    "play": r"RequestPlaySession",
+    "console": r"GEditor->Exec\(",
+    "script": r"ExecPythonCommand",
+    "lighting": r"GEditor->BuildLighting",
+}
+
+# Handles its own transactions (session steps, abort)
+EXEMPT = {"core_session"}
+
+_FUNCTION_RE = re.compile(r"(\w+)\s*\([^;{}]*\)\s*(?:const\s*)?\n( *)\{\n(.*?)\n\2\}", re.S)
+_KEYWORDS = {"if", "for", "while", "switch", "catch", "return"}
+_TABLE_ROW_RE = re.compile(r'\{\s*TEXT\("(\w+)"\)\s*,\s*&\w+::(\w+)')
+_BRANCH_RE = re.compile(r'CommandType\s*==\s*TEXT\("(\w+)"\)')
+_HANDLER_CALL_RE = re.compile(r"\b(Handle\w+)\s*\(")
+
+
+def outside_transaction_commands() -> Set[str]:
+    source = UNDO_POLICY_CPP.read_text()
+    body = re.search(r"bool IsOutsideTransactions\(.*?\n    \}", source, re.S)
+    assert body, "IsOutsideTransactions not found in UnrealCompanionUndoPolicy.cpp"
+    return set(re.findall(r'TEXT\("(\w+)"\)', body.group(0)))
+
+
+def function_bodies(source: str) -> Dict[str, str]:
+    bodies: Dict[str, str] = {}
+    for match in _FUNCTION_RE.finditer(source):
+        name = match.group(1)
+        if name not in _KEYWORDS:
+            bodies[name] = bodies.get(name, "") + match.group(3)
+    return bodies
+
+
+def command_handlers(source: str) -> Dict[str, Set[str]]:
+    """Command name -> handler functions, from table rows and CommandType branches."""
+    handlers: Dict[str, Set[str]] = {}
+    for command, method in _TABLE_ROW_RE.findall(source):
+        handlers.setdefault(command, set()).add(method)
+    branches = list(_BRANCH_RE.finditer(source))
+    for i, match in enumerate(branches):
+        end = branches[i + 1].start() if i + 1 < len(branches) else len(source)
+        call = _HANDLER_CALL_RE.search(source, match.end(), end)
+        if call:
+            handlers.setdefault(match.group(1), set()).add(call.group(1))
+    return handlers
+
+
+def unsafe_functions(bodies: Dict[str, str]) -> Dict[str, str]:
+    """Function -> the kind of unsafe call it reaches, following calls within the file."""
+    unsafe: Dict[str, str] = {}
+    for name, body in bodies.items():
+        for kind, pattern in UNSAFE_CALLS.items():
+            if re.search(pattern, body):
+                unsafe[name] = kind
+                break
+    changed = True
+    while changed:
+        changed = False
+        for name, body in bodies.items():
+            if name in unsafe:
+                continue
+            for callee, kind in list(unsafe.items()):
+                if re.search(rf"\b{callee}\s*\(", body):
+                    unsafe[name] = kind
+                    changed = True
+                    break
+    return unsafe
+
+
+def unsafe_commands() -> Dict[str, str]:
+    """Command name -> the kind of unsafe call its handler reaches."""
+    commands: Dict[str, str] = {}
+    for path in sorted(COMMANDS_DIR.glob("*.cpp")):
+        source = path.read_text()
+        unsafe = unsafe_functions(function_bodies(source))
+        for command, methods in command_handlers(source).items():
+            for method in methods:
+                if method in unsafe:
+                    commands[command] = unsafe[method]
+    return commands
+
+
+class TestOutsideTransactions:
+    def test_scan_finds_commands(self):
+        commands = unsafe_commands()
+        # Guards the scan itself: these go through three different dispatch styles
+        assert commands.get("asset_delete") == "delete"
+        assert commands.get("level_open") == "load"
+        assert commands.get("core_save") == "save"
+        assert commands.get("editor_undo") == "undo"
+
+    @pytest.mark.parametrize("command,kind", sorted(unsafe_commands().items()))
+    def test_unsafe_command_listed(self, command: str, kind: str):
+        if command in EXEMPT:
+            pytest.skip(f"{command} manages its own transactions")
+        assert command in outside_transaction_commands(), (
+            f"{command} reaches a {kind} call; add it to IsOutsideTransactions in UnrealCompanionUndoPolicy.cpp"
+        )
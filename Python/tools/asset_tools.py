@@ -53,13 +53,19 @@ def register_asset_tools(mcp: FastMCP):
         on_error: str = "continue",
         dry_run: bool = False,
         path: str = None,
-        focus_editor: bool = True
+        focus_editor: bool = True,
+        fixup_redirectors: bool = False
     ) -> Dict[str, Any]:
         """
         Batch asset modifications: rename, move, duplicate.
         
         Replaces: asset_rename, asset_move, asset_duplicate
         
+        All renames and moves are submitted together, so reference fixup runs
+        once for the whole batch. Duplicates run first, in order; an operation
+        on the destination of an earlier rename/move (rename then move)
+        simply extends it.
+        
         Args:
             operations: List of operations:
                 - action: "rename", "move", or "duplicate"
@@ -71,9 +77,11 @@ def register_asset_tools(mcp: FastMCP):
             dry_run: Validate without executing
             path: Optional folder path to sync Content Browser to after operations
             focus_editor: Auto-sync Content Browser to path (default: True)
+            fixup_redirectors: Fix up referencers and remove the redirectors left
+                behind by the renames, in one pass (default: False)
             
         Returns:
-            Results of each operation
+            Results of each operation (redirectors_fixed with fixup_redirectors)
             
         Examples:
             # Rename a single asset
@@ -94,6 +102,8 @@ def register_asset_tools(mcp: FastMCP):
         }
         if path:
             params["path"] = path
+        if fixup_redirectors:
+            params["fixup_redirectors"] = True
         return send_command("asset_modify_batch", params)
 
     @mcp.tool()
@@ -108,6 +118,9 @@ def register_asset_tools(mcp: FastMCP):
         """
         Delete multiple assets at once.
         
+        The assets are deleted as one set (one reference check, one garbage
+        collection) rather than one by one.
+        
         Args:
             assets: List of asset paths to delete
             force: Force delete even if asset has references
@@ -192,17 +205,22 @@ def register_asset_tools(mcp: FastMCP):
         """
         Import multiple external files at once.
         
+        All files are submitted to the importer together and the imported
+        packages are saved in a single pass at the end.
+        
         Args:
             files: List of import specifications:
                 - source_path (required): Full path to source file
                 - destination (required): Content path for import
                 - asset_name (optional): Name for the imported asset
                 - replace_existing (optional): Replace if exists (default: True)
-            on_error: "continue" (default) or "stop" on first error
+            on_error: "continue" (default) or "stop" at the first file that fails
+                validation (missing source, existing asset without replace)
             
         Returns:
             imported: Number of successfully imported files
             failed: Number of failed imports
+            saved_assets: Number of assets written by the final save
             results: List of imported asset paths
             errors: List of error details
             
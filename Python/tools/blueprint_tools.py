@@ -93,13 +93,19 @@ def register_blueprint_tools(mcp: FastMCP):
     @mcp.tool()
     def blueprint_compile(
         ctx: Context,
-        blueprint_name: str
+        blueprint_name: str = None,
+        blueprint_names: List[str] = None
     ) -> Dict[str, Any]:
         """
-        Compile a Blueprint.
+        Compile a Blueprint, or several in one pass.
         
         Args:
             blueprint_name: Name or path of the Blueprint to compile
+            blueprint_names: Compile all of these together (e.g. a base class and its
+                             children after editing both). The compiler orders them
+                             parents first and each compiles once. Returns compiled,
+                             failed, compile_ms, not_found[] and results[] with
+                             {blueprint, status, success, errors[], warnings[]}
             
         Returns:
             Response containing:
@@ -113,6 +119,8 @@ def register_blueprint_tools(mcp: FastMCP):
             - errors: list of {node_id, node_title, graph, message} (if any)
             - warnings: list of {node_id, node_title, graph, message} (if any)
         """
+        if blueprint_names:
+            return send_command("blueprint_compile", {"blueprint_names": blueprint_names})
         return send_command("blueprint_compile", {"blueprint_name": blueprint_name})
 
     # Note: blueprint_get_info is now in query_tools.py as get_info(type="blueprint")
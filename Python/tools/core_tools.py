@@ -18,6 +18,7 @@ def register_core_tools(mcp: FastMCP):
     """Register unified core tools with the MCP server."""
     
     from utils.helpers import send_command
+    from utils.shared_memory import resolve_base64_field
 
     @mcp.tool()
     def core_query(
@@ -29,16 +30,23 @@ def register_core_tools(mcp: FastMCP):
         pattern: str = None,
         class_filter: str = None,
         max_results: int = 100,
+        cursor: str = None,
         recursive: bool = True,
+        include: List[str] = None,
+        load: bool = False,
         # Actor specific
         tag: str = None,
         center: List[float] = None,
         radius: float = None,
+        box_min: List[float] = None,
+        box_max: List[float] = None,
         # Node specific
         blueprint_name: str = None,
         graph_name: str = None,
         node_type: str = None,
-        event_type: str = None
+        event_type: str = None,
+        # Job specific
+        job_id: str = None
     ) -> Dict[str, Any]:
         """
         Unified search/query tool for all entity types.
@@ -48,29 +56,54 @@ def register_core_tools(mcp: FastMCP):
                   world_find_actors_in_radius, node_find, node_get_graph_nodes
         
         Args:
-            type: Entity type - "asset", "actor", "node", "folder"
-            action: Action - "list", "find", "exists"
+            type: Entity type - "asset", "actor", "node", "folder", "job"
+            action: Action - "list", "find", "exists"; for jobs "list", "status", "cancel";
+                    for actors on World Partition maps also "load" and "unload"
             
             # For type: "asset" or "folder"
             path: Path to search in or check existence
             pattern: Name pattern (for find)
             class_filter: Filter by class (Blueprint, StaticMesh, etc.)
-            max_results: Maximum results to return
+            max_results: Maximum results to return (the page size)
+            cursor: next_cursor of the previous page, to fetch the next one
+                    with the same filters. Results come sorted (assets by path,
+                    actors by name or nearest first, nodes by graph/Blueprint),
+                    so pages neither repeat nor skip as the project changes.
             recursive: Search subdirectories
+            include: Asset extras read from the AssetRegistry - "tags", "size"
+                     (results always have class, and parent_class for Blueprints).
+                     For actors, ["unloaded"] searches World Partition actor
+                     descriptors instead, so actors in unloaded cells are found
+                     without loading them. For actor load/unload, the guids to
+                     load or unload.
+            load: Load every matched asset to report memory_size. Asset queries
+                  never load packages otherwise.
             
             # For type: "actor"
             tag: Filter by actor tag
             center: [X, Y, Z] center point for radius search
-            radius: Search radius
+            radius: Search radius (results sorted nearest first)
+            box_min: [X, Y, Z] minimum corner for box search (with box_max)
+            box_max: [X, Y, Z] maximum corner for box search
+            (load/unload take the guids in include, or else every actor matching
+            these filters up to max_results; loaded actors are pinned so they
+            stay loaded, and unload skips actors with unsaved changes)
             
             # For type: "node"
-            blueprint_name: Target blueprint
+            blueprint_name: Target blueprint. Omit it to search every Blueprint under
+                            path via the node index (pattern matches the called
+                            function/event/variable, class_filter its owning class;
+                            load=True indexes Blueprints not summarised yet, as a job)
             graph_name: Specific graph (default: EventGraph)
             node_type: Filter by node type
             event_type: Filter by event type
             
+            # For type: "job" (light_build, core_save run_async=True)
+            job_id: Job to report on or cancel (status/cancel)
+            
         Returns:
-            Response with search results
+            Response with search results: results, count, total_found,
+            has_more and next_cursor when more pages follow
             
         Examples:
             # List all blueprints in a folder
@@ -91,12 +124,36 @@ def register_core_tools(mcp: FastMCP):
             # Find actors in radius
             core_query(type="actor", action="find", center=[0, 0, 0], radius=1000)
             
+            # Find actors inside a box
+            core_query(type="actor", action="find", box_min=[-500, -500, 0], box_max=[500, 500, 300])
+            
             # Find nodes in blueprint
             core_query(type="node", action="list", blueprint_name="BP_Player")
             
             # Find specific event
             core_query(type="node", action="find", blueprint_name="BP_Player", event_type="BeginPlay")
+            
+            # Every node calling a function, across all Blueprints
+            core_query(type="node", action="find", pattern="SetTimerByFunctionName")
+            
+            # Page through every actor, 500 at a time
+            page = core_query(type="actor", action="list", max_results=500)
+            page = core_query(type="actor", action="list", max_results=500, cursor=page["next_cursor"])
+            
+            # Find actors in unloaded World Partition cells, then load just those
+            found = core_query(type="actor", action="find", class_filter="BP_Door", include=["unloaded"])
+            core_query(type="actor", action="load", include=[a["guid"] for a in found["results"]])
+            
+            # Follow a lighting build started with light_build
+            core_query(type="job", action="status", job_id="job-1")
         """
+        if type == "job":
+            # Jobs live in the bridge's job manager, not in the query handlers
+            job_params = {}
+            if job_id is not None:
+                job_params["job_id"] = job_id
+            return send_command(f"job_{action}", job_params)
+
         params = {
             "type": type,
             "action": action
@@ -111,14 +168,27 @@ def register_core_tools(mcp: FastMCP):
             params["class_filter"] = class_filter
         if max_results != 100:
             params["max_results"] = max_results
+        if cursor:
+            params["cursor"] = cursor
         if not recursive:
             params["recursive"] = recursive
+        if include:
+            if type == "actor" and action in ("load", "unload"):
+                params["guids"] = include
+            else:
+                params["include"] = include
+        if load:
+            params["load"] = load
         if tag is not None:
             params["tag"] = tag
         if center is not None:
             params["center"] = center
         if radius is not None:
             params["radius"] = radius
+        if box_min is not None:
+            params["box_min"] = box_min
+        if box_max is not None:
+            params["box_max"] = box_max
         if blueprint_name is not None:
             params["blueprint_name"] = blueprint_name
         if graph_name is not None:
@@ -137,6 +207,7 @@ def register_core_tools(mcp: FastMCP):
         path: str = None,
         # Blueprint specific
         info_type: str = "all",
+        fields: List[str] = None,
         # Node specific
         blueprint_name: str = None,
         node_id: str = None,
@@ -144,7 +215,15 @@ def register_core_tools(mcp: FastMCP):
         # Actor specific
         actor_name: str = None,
         # Asset specific
-        include_bounds: bool = False
+        include_bounds: bool = False,
+        detail: bool = False,
+        # Behavior tree specific
+        max_depth: int = None,
+        # Landscape specific
+        bounds: List[float] = None,
+        resolution: int = 256,
+        height_format: str = "uint16",
+        shared_memory: bool = False
     ) -> Dict[str, Any]:
         """
         Unified information tool for all entity types.
@@ -154,13 +233,29 @@ def register_core_tools(mcp: FastMCP):
         
         Args:
             type: Entity type - "asset", "blueprint", "node", "actor", "material",
-                  "niagara", "anim_blueprint", "behavior_tree"
+                  "niagara", "anim_blueprint", "behavior_tree", "landscape"
             path: Asset/Blueprint/Material/Niagara/AnimBP/BehaviorTree path
             info_type: For blueprints - "all", "variables", "functions", "components", "interfaces"
+            fields: For blueprint / anim_blueprint - only compute these fields, e.g.
+                    ["variables.name", "functions"] ("a.b" picks one key of a).
+                    Only registry-tag fields (parent_class, native_parent_class,
+                    interfaces, skeleton) on an unloaded asset are answered from
+                    the AssetRegistry without loading the asset (source="asset_registry")
             blueprint_name: For nodes - target blueprint
-            node_id: For nodes - node GUID
-            actor_name: For actors - actor name
+            node_id: For nodes - node GUID. For behavior_tree - subtree root ("node_5")
+            actor_name: For actors - actor name. For landscape - the landscape actor
             include_bounds: For assets - include bounding box for meshes
+            detail: For assets - load the asset for exact mesh stats and bounds.
+                    Without it, an unloaded mesh is answered from AssetRegistry tags
+                    (source="asset_registry"): LOD 0 vertices/triangles, LOD and
+                    material counts, and bounds as an approximate size only
+            max_depth: For behavior_tree - levels below the root (or node_id) to return
+            bounds: For landscape - world [min_x, min_y, max_x, max_y] to read (default: all)
+            resolution: For landscape - texels on the long side of the result (1-4096)
+            height_format: For landscape - "uint16" (raw heightmap) or "float16"
+                           (cm above the actor)
+            shared_memory: For landscape - move the heights from the editor through
+                           shared memory instead of base64 JSON (same machine only)
             
         Returns:
             Response with entity information
@@ -194,14 +289,40 @@ def register_core_tools(mcp: FastMCP):
             # Get Behavior Tree info (nodes hierarchy, decorators, services)
             core_get_info(type="behavior_tree", path="/Game/AI/BT_Enemy")
             # Returns: blackboard, nodes[] (id, class, category, depth, parent_id,
-            #          decorators[], services[]), node_count, tree_depth
+            #          children[], decorators[], services[]), node_count,
+            #          total_node_count, tree_depth, cached
+            
+            # One branch, two levels deep (ids are stable until the tree changes)
+            core_get_info(type="behavior_tree", path="/Game/AI/BT_Enemy",
+                          node_id="node_5", max_depth=2)
+            
+            # Landscape heights, box-filtered down to 512 texels on the long side
+            core_get_info(type="landscape", actor_name="Landscape", resolution=512)
+            # Returns: data (base64, little-endian, row-major), width, height, format,
+            #          origin, texel_size, height_offset, height_scale, level, cached
+            #          z = height_offset + (value - 32768) * height_scale for uint16
         """
+        if type == "landscape":
+            params = {"resolution": resolution, "format": height_format}
+            if actor_name is not None:
+                params["actor_name"] = actor_name
+            if bounds is not None:
+                params["bounds"] = bounds
+            if shared_memory:
+                params["shared_memory"] = True
+            response = send_command("landscape_read_heights", params)
+            if shared_memory and isinstance(response.get("result"), dict):
+                resolve_base64_field(response["result"], "data")
+            return response
+        
         params = {"type": type}
         
         if path is not None:
             params["path"] = path
         if info_type != "all":
             params["info_type"] = info_type
+        if fields:
+            params["fields"] = fields
         if blueprint_name is not None:
             params["blueprint_name"] = blueprint_name
         if node_id is not None:
@@ -212,6 +333,10 @@ def register_core_tools(mcp: FastMCP):
             params["actor_name"] = actor_name
         if include_bounds:
             params["include_bounds"] = include_bounds
+        if detail:
+            params["detail"] = True
+        if max_depth is not None:
+            params["max_depth"] = max_depth
             
         return send_command("core_get_info", params)
 
@@ -219,19 +344,32 @@ def register_core_tools(mcp: FastMCP):
     def core_save(
         ctx: Context,
         scope: str = "all",
-        path: str = None
+        path: str = None,
+        run_async: bool = False
     ) -> Dict[str, Any]:
         """
         Unified save tool for assets, levels, and all.
         
         Replaces: asset_save, asset_save_all, level_save
         
+        "all"/"dirty" save every dirty package in one batch with background
+        file writes. Large batches are time-sliced so the editor stays
+        responsive; the reply arrives once everything is on disk, and
+        scope="status" reports progress from another connection meanwhile.
+        
+        On a headless editor, assets edited by tools are not saved one by one;
+        scope="deferred" saves them in one batch ("all"/"dirty" include them).
+        
         Args:
-            scope: What to save - "all", "dirty", "level", "asset"
+            scope: What to save - "all", "dirty", "level", "asset", "deferred", "status"
             path: For scope="asset" - specific asset path to save
+            run_async: For "all"/"dirty" - reply with a job_id at once and save in
+                       the background; follow or cancel it with core_query(type="job")
             
         Returns:
-            Response indicating save result
+            Response indicating save result (saved, maps_saved, failed,
+            failed_packages, elapsed_ms for batch saves; active, processed,
+            total, progress, headless, deferred_saves for scope="status")
             
         Examples:
             # Save everything
@@ -249,6 +387,55 @@ def register_core_tools(mcp: FastMCP):
         params = {"scope": scope}
         if path is not None:
             params["path"] = path
+        if run_async:
+            params["async"] = True
         return send_command("core_save", params)
 
-    logger.info("Core tools registered successfully (3 tools: core_query, core_get_info, core_save)")
+    @mcp.tool()
+    def core_session(
+        ctx: Context,
+        action: str,
+        label: str = None,
+        undo: str = None
+    ) -> Dict[str, Any]:
+        """
+        Defer Blueprint compilation across many edits, then compile each asset once.
+        
+        Between begin and commit, every edit that would normally compile a
+        Blueprint (graph_batch, blueprint_*_batch, node_add_batch, widget_batch...)
+        only marks it dirty. Commit compiles every touched Blueprint exactly once,
+        parents before children, and returns compiler messages per asset.
+        Material graph edits are held too; commit recompiles each touched
+        Material once, after the Blueprints.
+        blueprint_compile still compiles immediately.
+        
+        Args:
+            action: "begin", "commit", "abort" (undo the session's edits and close
+                    without compiling) or "status"
+            label: Optional name for the session (begin only), echoed in results
+            undo: Undo grouping for the session's commands (begin only):
+                  "session" - one undo step per command, named after the
+                              session
+                  "command" - one undo step per command (default)
+                  "none"    - no undo for the session's edits (generated content);
+                              abort cannot roll them back
+            
+        Returns:
+            commit: {compiled, deferred_requests, failed, compile_ms,
+                     results: [{blueprint, status, errors, warnings} | {material, success}],
+                     undo: {mode, steps, without_undo}}
+            abort: {left_dirty, undo: {mode, steps, without_undo, rolled_back, kept}}
+            
+        Examples:
+            core_session(action="begin", label="inventory_setup")
+            graph_batch(...)   # x N, no compile in between
+            core_session(action="commit")
+        """
+        params = {"action": action}
+        if label is not None:
+            params["label"] = label
+        if undo is not None:
+            params["undo"] = undo
+        return send_command("core_session", params)
+
+    logger.info("Core tools registered successfully (4 tools: core_query, core_get_info, core_save, core_session)")
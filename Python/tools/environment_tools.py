@@ -30,7 +30,9 @@ def register_environment_tools(mcp: FastMCP):
         start_distance: float = None,
         color: List[float] = None,
         enabled: bool = None,
-        volumetric: bool = None
+        volumetric: bool = None,
+        sky_light_intensity: float = None,
+        recapture_sky: bool = None
     ) -> Dict[str, Any]:
         """
         Configure the level environment (sun, fog, atmosphere).
@@ -41,6 +43,8 @@ def register_environment_tools(mcp: FastMCP):
             action: What to configure:
                 - "set_time_of_day": Set sun position via time (0-24h)
                 - "set_fog": Configure exponential height fog
+                - "apply": Sun, fog and sky light settings in one call
+                  (any of the parameters below); never spawns actors
                 - "setup_atmosphere": Create all missing environment actors
                   (sun, sky atmosphere, sky light, fog)
                 - "get_info": Get current environment state
@@ -58,6 +62,13 @@ def register_environment_tools(mcp: FastMCP):
                 enabled: Enable/disable fog
                 volumetric: Enable/disable volumetric fog
 
+            For "apply":
+                Any of the set_time_of_day and set_fog parameters, plus
+                sky_light_intensity: Sky light intensity
+                recapture_sky: Recapture the sky light (default: when the sun changed)
+                Returns sun/fog/sky_light objects for what changed, "missing"
+                for settings whose actor is not in the level, and apply_ms.
+
         Returns:
             Varies by action. All include success: true/false.
 
@@ -73,6 +84,10 @@ def register_environment_tools(mcp: FastMCP):
             environment_configure(action="set_fog", density=0.05,
                                 volumetric=True, color=[0.7, 0.8, 0.9])
 
+            # Whole look in one round trip
+            environment_configure(action="apply", time=7.0, sun_intensity=6.0,
+                                density=0.03, sky_light_intensity=1.5)
+
             # Check current state
             environment_configure(action="get_info")
         """
@@ -95,6 +110,10 @@ def register_environment_tools(mcp: FastMCP):
             params["enabled"] = enabled
         if volumetric is not None:
             params["volumetric"] = volumetric
+        if sky_light_intensity is not None:
+            params["sky_light_intensity"] = sky_light_intensity
+        if recapture_sky is not None:
+            params["recapture_sky"] = recapture_sky
         return send_command("environment_configure", params)
 
     logger.info("Environment tools registered successfully (1 tool: environment_configure)")
@@ -1,6 +1,6 @@
 """
 Foliage Tools for UnrealCompanion.
-Foliage type registration, instance scattering, and removal.
+Foliage type registration, instance scattering, removal, export and import.
 
 Naming convention: foliage_*
 """
@@ -17,6 +17,7 @@ def register_foliage_tools(mcp: FastMCP):
     """Register foliage tools with the MCP server."""
 
     from utils.helpers import send_command
+    from utils.shared_memory import resolve_base64_field
 
     @mcp.tool()
     def foliage_add_type(
@@ -88,7 +89,9 @@ def register_foliage_tools(mcp: FastMCP):
         scale_range: List[float] = None,
         align_to_normal: bool = False,
         random_yaw: bool = True,
-        min_distance: float = 0.0
+        min_distance: float = 0.0,
+        distribution: str = None,
+        seed: int = None
     ) -> Dict[str, Any]:
         """
         Scatter foliage instances in an area with ground-snapping raycasts.
@@ -100,7 +103,7 @@ def register_foliage_tools(mcp: FastMCP):
         Args:
             mesh: Path to StaticMesh asset (e.g., "/Game/Meshes/SM_Rock_01")
             center: [X, Y, Z] center of scatter area in world coordinates
-            count: Number of instances to place (1-10000, default: 100)
+            count: Number of instances to place (1-100000, default: 100)
             radius: Scatter radius (circular area). Default: 5000
             box: [minX, minY, maxX, maxY] for rectangular scatter area
                  (overrides radius if provided)
@@ -108,11 +111,19 @@ def register_foliage_tools(mcp: FastMCP):
             align_to_normal: Align to surface normal (default: False)
             random_yaw: Random yaw rotation (default: True)
             min_distance: Minimum distance between instances (default: 0, no limit)
+            distribution: "random" (default) - uniform points, too-close ones rejected
+                          "blue_noise" - Poisson-disk points, evenly spread with no
+                          spacing rejections (spacing = min_distance, or wider if the
+                          area fits far more than count)
+            seed: Random seed; the same seed reproduces the same layout
+                  (default: random, echoed back as "seed")
 
         Returns:
             instances_placed: Actual number of instances placed
             instances_requested: Number requested
             attempts: Total placement attempts (some may fail due to no ground)
+            distribution: Mode used; "spacing" is also returned for blue_noise
+            seed: Seed used (pass it back to regenerate this layout)
 
         Example:
             # Scatter rocks in a circular area
@@ -129,6 +140,11 @@ def register_foliage_tools(mcp: FastMCP):
             foliage_scatter(mesh="/Game/Meshes/SM_Tree",
                           center=[0, 0, 0],
                           box=[-5000, -5000, 5000, 5000], count=100)
+
+            # Evenly spaced trees, no clumps and no wasted samples
+            foliage_scatter(mesh="/Game/Meshes/SM_Tree",
+                          center=[0, 0, 0], radius=50000, count=5000,
+                          distribution="blue_noise")
         """
         params = {
             "mesh": mesh,
@@ -144,25 +160,39 @@ def register_foliage_tools(mcp: FastMCP):
             params["box"] = box
         if scale_range is not None:
             params["scale_range"] = scale_range
+        if distribution is not None:
+            params["distribution"] = distribution
+        if seed is not None:
+            params["seed"] = seed
         return send_command("foliage_scatter", params)
 
     @mcp.tool()
     def foliage_remove(
         ctx: Context,
-        center: List[float],
+        center: List[float] = None,
         radius: float = 5000.0,
-        mesh: str = None
+        mesh: str = None,
+        box: List[float] = None,
+        polygon: List[List[float]] = None
     ) -> Dict[str, Any]:
         """
-        Remove foliage instances within a radius.
+        Remove foliage instances within a sphere, box or polygon.
+
+        Uses the foliage spatial hash, so cost scales with the instances
+        inside the region rather than the total instance count.
 
         Args:
-            center: [X, Y, Z] center of removal area
+            center: [X, Y, Z] center of removal sphere
             radius: Removal radius in world units (default: 5000)
             mesh: Optional StaticMesh path to filter removal.
                   If not provided, removes ALL foliage types in the area.
+            box: Optional box instead of a sphere: [minX, minY, maxX, maxY]
+                 (any height) or [minX, minY, minZ, maxX, maxY, maxZ]
+            polygon: Optional XY polygon instead of a sphere: [[x, y], ...]
+                     (at least 3 points, any height). Takes precedence over box.
 
         Returns:
+            region: "sphere", "box" or "polygon"
             instances_removed: Number of instances removed
 
         Example:
@@ -172,13 +202,126 @@ def register_foliage_tools(mcp: FastMCP):
             # Remove only rocks
             foliage_remove(center=[0, 0, 0], radius=5000,
                          mesh="/Game/Meshes/SM_Rock_01")
+
+            # Clear a road corridor
+            foliage_remove(polygon=[[0, -300], [8000, -300], [8000, 300], [0, 300]])
         """
-        params = {
-            "center": center,
-            "radius": radius
-        }
+        params = {"radius": radius}
+        if center is not None:
+            params["center"] = center
         if mesh:
             params["mesh"] = mesh
+        if box is not None:
+            params["box"] = box
+        if polygon is not None:
+            params["polygon"] = polygon
         return send_command("foliage_remove", params)
 
-    logger.info("Foliage tools registered successfully (3 tools: foliage_add_type, foliage_scatter, foliage_remove)")
+    @mcp.tool()
+    def foliage_export(
+        ctx: Context,
+        center: List[float] = None,
+        radius: float = None,
+        mesh: str = None,
+        box: List[float] = None,
+        polygon: List[List[float]] = None,
+        chunk_size: int = 65536,
+        shared_memory: bool = False
+    ) -> Dict[str, Any]:
+        """
+        Read foliage instance transforms as packed binary, per foliage type.
+
+        Without center, radius, box or polygon, exports every instance in
+        the level. Regions work as in foliage_remove and use the same spatial
+        hash. Each instance is a 48-byte little-endian record:
+        location float64 x3, rotation float32 x3 (pitch, yaw, roll),
+        scale float32 x3 (see utils/foliage_transforms.py).
+
+        Args:
+            center: [X, Y, Z] center of an export sphere
+            radius: Sphere radius (default: 5000 when center is given)
+            mesh: Optional StaticMesh path; only export this mesh's type
+            box: [minX, minY, maxX, maxY] (any height) or
+                 [minX, minY, minZ, maxX, maxY, maxZ]
+            polygon: XY polygon [[x, y], ...] (any height). Takes precedence over box.
+            chunk_size: Instances per chunk (1-1048576, default: 65536)
+            shared_memory: Move the chunks through the editor's shared-memory
+                           ring instead of base64 in the reply (same machine
+                           only); they are returned as "data" all the same
+
+        Returns:
+            count: Instances exported
+            stride: Bytes per instance (48)
+            types: [{name, mesh, foliage_type (asset types only), count,
+                     chunks: [{seq, count, data}]}]
+
+        Example:
+            # Copy a forest patch 20 km east
+            # (export_to_import is in utils/foliage_transforms.py)
+            forest = foliage_export(box=[0, 0, 10000, 10000])
+            foliage_import(types=export_to_import(forest["result"]), offset=[2000000, 0, 0])
+        """
+        params = {"chunk_size": chunk_size}
+        if center is not None:
+            params["center"] = center
+        if radius is not None:
+            params["radius"] = radius
+        if mesh:
+            params["mesh"] = mesh
+        if box is not None:
+            params["box"] = box
+        if polygon is not None:
+            params["polygon"] = polygon
+        if shared_memory:
+            params["shared_memory"] = True
+        response = send_command("foliage_export", params)
+        if shared_memory and isinstance(response.get("result"), dict):
+            # The ring overwrites old records: copy each chunk out before returning
+            for entry in response["result"].get("types", []):
+                for chunk in entry.get("chunks", []):
+                    resolve_base64_field(chunk, "data")
+        return response
+
+    @mcp.tool()
+    def foliage_import(
+        ctx: Context,
+        types: List[Dict],
+        offset: List[float] = None
+    ) -> Dict[str, Any]:
+        """
+        Add foliage instances in bulk from packed transforms.
+
+        Each foliage type gets a single bulk add (one spatial hash and
+        cluster tree rebuild), even if its instances come in several entries.
+        All entries are checked before anything is added.
+
+        Args:
+            types: One dict per foliage type, {mesh or foliage_type, data or transforms}:
+                   mesh: StaticMesh path; uses the level's foliage type for it,
+                         or registers one with default settings
+                   foliage_type: FoliageType asset path (kept settings); mesh
+                                 is the fallback if it does not load
+                   data: base64 of 48-byte records (foliage_export layout)
+                   transforms: flat numbers, 9 per instance:
+                               x, y, z, pitch, yaw, roll, sx, sy, sz
+            offset: [X, Y, Z] added to every location (default: none)
+
+        Returns:
+            instances_added: Total instances added
+            types: [{name, mesh, instances_added}]
+
+        Example:
+            # Two trees from an external tool
+            foliage_import(types=[{"mesh": "/Game/Meshes/SM_Tree",
+                                   "transforms": [0, 0, 0, 0, 45, 0, 1, 1, 1,
+                                                  500, 0, 0, 0, 90, 0, 1.2, 1.2, 1.2]}])
+
+            # Re-import an export (utils.foliage_transforms.export_to_import)
+            foliage_import(types=export_to_import(forest["result"]))
+        """
+        params = {"types": types}
+        if offset is not None:
+            params["offset"] = offset
+        return send_command("foliage_import", params)
+
+    logger.info("Foliage tools registered successfully (5 tools: foliage_add_type, foliage_scatter, foliage_remove, foliage_export, foliage_import)")
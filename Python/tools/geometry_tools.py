@@ -21,7 +21,7 @@ def register_geometry_tools(mcp: FastMCP):
     @mcp.tool()
     def geometry_create(
         ctx: Context,
-        type: str,
+        type: str = None,
         name: str = "GeometryActor",
         location: List[float] = None,
         rotation: List[float] = None,
@@ -30,7 +30,12 @@ def register_geometry_tools(mcp: FastMCP):
         height: float = 100.0,
         depth: float = 100.0,
         radius: float = 50.0,
-        segments: int = 16
+        segments: int = 16,
+        operations: List[Dict] = None,
+        actor: str = None,
+        output: str = None,
+        static_mesh_path: str = None,
+        spawn_actor: bool = True
     ) -> Dict[str, Any]:
         """
         Create a procedural geometry primitive using Geometry Script.
@@ -38,6 +43,11 @@ def register_geometry_tools(mcp: FastMCP):
         Creates a DynamicMeshActor with the specified primitive shape.
         Can be combined with geometry_boolean for complex shapes.
 
+        With `operations`, runs a whole build in memory instead: each op edits
+        a named mesh ("mesh", default "main") and only the final mesh is
+        written to an actor, so render data and collision are rebuilt once.
+        Prefer this over chains of geometry_create + geometry_boolean.
+
         Args:
             type: Primitive type - "box", "sphere", "cylinder", "cone", "plane"
             name: Actor label (default: "GeometryActor")
@@ -49,11 +59,24 @@ def register_geometry_tools(mcp: FastMCP):
             depth: Depth for box (default: 100)
             radius: Radius for sphere/cylinder/cone (default: 50)
             segments: Segment count for curved shapes (default: 16)
+            operations: Pipeline ops, in order (type is then ignored):
+                {"op": "box"|"sphere"|"cylinder"|"cone"|"plane", "mesh", dims, location, rotation, scale}
+                {"op": "boolean", "mesh", "tool", "operation", location/rotation/scale of the tool, "keep"}
+                {"op": "append", "mesh", "source", location/rotation/scale, "keep"}
+                {"op": "transform", "mesh", location, rotation, scale}
+                Tool/source meshes are released after use unless "keep": true.
+            actor: Existing DynamicMeshActor whose mesh the pipeline replaces
+            output: Mesh to commit (default: the last op's mesh)
+            static_mesh_path: Also write the result to this static mesh asset
+                (e.g. "/Game/Meshes/SM_Arch"); created if missing, not saved
+            spawn_actor: Spawn a new actor when no `actor` is given (default: True)
 
         Returns:
             actor_name: Internal actor name
             actor_label: Display label
             type: Primitive type created
+            With operations: operations, output, triangle_count, vertex_count,
+            static_mesh, pipeline_ms; failed_op on error
 
         Example:
             # Create a rock-like sphere
@@ -63,7 +86,37 @@ def register_geometry_tools(mcp: FastMCP):
             # Create a wall
             geometry_create(type="box", name="Wall",
                           location=[0, 0, 150], width=1000, height=300, depth=50)
+
+            # Wall with a doorway, built in one commit and kept as an asset
+            geometry_create(name="DoorWall", location=[0, 0, 150], operations=[
+                {"op": "box", "width": 1000, "height": 300, "depth": 50},
+                {"op": "box", "mesh": "door", "width": 120, "height": 220, "depth": 100},
+                {"op": "boolean", "tool": "door", "location": [0, 0, -40]},
+            ], static_mesh_path="/Game/Meshes/SM_DoorWall")
         """
+        if operations:
+            params = {
+                "operations": operations,
+                "name": name,
+                "spawn_actor": spawn_actor
+            }
+            if location:
+                params["location"] = location
+            if rotation:
+                params["rotation"] = rotation
+            if scale:
+                params["scale"] = scale
+            if actor:
+                params["actor"] = actor
+            if output:
+                params["output"] = output
+            if static_mesh_path:
+                params["static_mesh_path"] = static_mesh_path
+            return send_command("geometry_pipeline", params)
+
+        if not type:
+            return {"success": False, "error": "Either 'type' or 'operations' is required"}
+
         params = {
             "type": type,
             "name": name,
@@ -85,38 +138,55 @@ def register_geometry_tools(mcp: FastMCP):
     def geometry_boolean(
         ctx: Context,
         target_actor: str,
-        tool_actor: str,
+        tool_actor: str = None,
         operation: str = "subtract",
-        delete_tool: bool = True
+        delete_tool: bool = True,
+        tool_actors: List[str] = None
     ) -> Dict[str, Any]:
         """
-        Perform a boolean operation between two DynamicMeshActors.
+        Perform a boolean operation between a DynamicMeshActor and one or more tools.
 
-        Modifies the target mesh by combining it with the tool mesh.
-        The tool actor can optionally be deleted after the operation.
+        Modifies the target mesh by combining it with the tool meshes.
+        The tool actors can optionally be deleted after the operation.
+        Many tools (e.g. 100 window cutters) go in ONE call: tools that do not
+        overlap share a pass, passes are combined in parallel and the target
+        is rebuilt once.
 
         Args:
             target_actor: Name/label of the target DynamicMeshActor (result goes here)
             tool_actor: Name/label of the tool DynamicMeshActor (used to cut/add)
             operation: Boolean operation - "union", "subtract", "intersection"
-            delete_tool: Delete the tool actor after operation (default: True)
+            delete_tool: Delete the tool actors after operation (default: True)
+            tool_actors: More tool actors, applied together with tool_actor
 
         Returns:
             operation: The operation performed
             target_actor: Target actor name
-            tool_deleted: Whether tool was deleted
+            tool_deleted: Whether tools were deleted
+            tool_count, passes, reduce_booleans: How the tools were batched
+            timings: gather/prepare/group/reduce/apply/total milliseconds
 
         Example:
             # Carve a hole in terrain
             geometry_create(type="box", name="Terrain", location=[0,0,0], width=1000, height=200, depth=1000)
             geometry_create(type="cylinder", name="Hole", location=[0,0,0], radius=100, height=300)
             geometry_boolean(target_actor="Terrain", tool_actor="Hole", operation="subtract")
+
+            # Carve all windows at once
+            geometry_boolean(target_actor="Facade", tool_actors=["Win_0", "Win_1", "Win_2"])
         """
-        return send_command("geometry_boolean", {
+        if not tool_actor and not tool_actors:
+            return {"success": False, "error": "Either 'tool_actor' or 'tool_actors' is required"}
+
+        params = {
             "target_actor": target_actor,
-            "tool_actor": tool_actor,
             "operation": operation,
             "delete_tool": delete_tool
-        })
+        }
+        if tool_actor:
+            params["tool_actor"] = tool_actor
+        if tool_actors:
+            params["tool_actors"] = tool_actors
+        return send_command("geometry_boolean", params)
 
     logger.info("Geometry tools registered successfully (2 tools: geometry_create, geometry_boolean)")
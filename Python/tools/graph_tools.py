@@ -19,6 +19,16 @@ from mcp.server.fastmcp import FastMCP, Context
 
 logger = logging.getLogger("UnrealCompanion")
 
+# Keys that make a "state_machine" node entry a whole-machine build
+_STATE_MACHINE_BUILD_KEYS = ("states", "transitions", "entry", "machine_id")
+
+
+def _is_state_machine_spec(node: Dict[str, Any]) -> bool:
+    """A nodes entry describing a whole state machine rather than a bare machine node."""
+    return (isinstance(node, dict)
+            and str(node.get("type", "")).lower() == "state_machine"
+            and any(key in node for key in _STATE_MACHINE_BUILD_KEYS))
+
 
 def register_graph_tools(mcp: FastMCP):
     """Register graph manipulation tools with the MCP server."""
@@ -37,8 +47,9 @@ def register_graph_tools(mcp: FastMCP):
         max_results: int = 50
     ) -> Dict[str, Any]:
         """
-        Search for Blueprint nodes (functions) that can be added to a graph.
+        Search for Blueprint nodes (functions, events, macros) that can be added to a graph.
         Useful to discover what functions are available before adding them.
+        Results are ranked: exact name, then prefix, then word start, then substring.
         
         Args:
             search_term: Optional. Search in function names (e.g., "Print", "Get", "Asset")
@@ -46,7 +57,8 @@ def register_graph_tools(mcp: FastMCP):
             max_results: Maximum number of results to return (default: 50)
             
         Returns:
-            Response containing list of available nodes with their signatures
+            Response containing list of available nodes with their signatures,
+            each tagged with "kind" (function/event/macro) and a relevance "score"
             
         Examples:
             - graph_node_search_available(search_term="Print") - Find all Print functions
@@ -88,6 +100,7 @@ def register_graph_tools(mcp: FastMCP):
         verbosity: str = "normal",
         auto_arrange: bool = False,
         auto_arrange_mode: str = "layered",
+        defer_shader_compile: bool = False,
         focus_editor: bool = True
     ) -> Dict[str, Any]:
         """
@@ -134,17 +147,33 @@ def register_graph_tools(mcp: FastMCP):
                 - source_pin: Source pin name
                 - target_ref/target_id: Target node reference or GUID
                 - target_pin: Target pin name
+
+            # Animation Blueprints (graph_name="AnimGraph")
+            A "state_machine" entry in nodes with states/transitions (or machine_id)
+            builds a whole state machine in one transaction:
+                - ref / name / position: the machine node (or machine_id to extend one)
+                - states: [{name, sequence | blend_space, conduit, position}]
+                - transitions: [{from, to, rule (bool variable), negate, value,
+                  automatic, crossfade, bidirectional}]
+                - entry: name of the starting state
+                Machines are built after the other nodes; the Animation Blueprint
+                compiles once at the end.
                 
             # Options
             graph_name: Target graph (default: EventGraph)
             on_error: Error strategy: "rollback" (default), "continue", "stop"
-            dry_run: Validate without executing
+            dry_run: Validate without executing. Answered off the game thread from
+                cached metadata; the asset is never modified.
             verbosity: Response detail: "minimal", "normal" (default), "full"
-            auto_arrange: Auto-arrange nodes after creation
+            auto_arrange: Auto-arrange the nodes created by this batch (existing nodes stay put)
             auto_arrange_mode: Layout mode - "layered" (default), "straight", or "compact"
-                - layered: Traditional vertical layout with layers per exec flow
+                - layered: Layers per exec flow, aligned and ordered to reduce wire crossings
                 - straight: All exec nodes on same Y line (horizontal timeline)
                 - compact: Minimize vertical space with tighter stacking
+            defer_shader_compile: Materials only - apply the edits but hold the recompile
+                (and shader compilation) until a later graph_batch on the same material
+                without it, even one with no operations. The response reports
+                shader_compile_pending.
             focus_editor: Auto-open Blueprint editor and navigate to graph (default: True)
                 - Opens the Blueprint in editor
                 - Navigates to the modified graph
@@ -243,9 +272,14 @@ def register_graph_tools(mcp: FastMCP):
             "auto_arrange_mode": auto_arrange_mode,
             "focus_editor": focus_editor
         }
-        # Node operations
+        # Node operations (whole state machines go to the bridge's state_machines list)
         if nodes:
-            params["nodes"] = nodes
+            machines = [n for n in nodes if _is_state_machine_spec(n)]
+            plain = [n for n in nodes if not _is_state_machine_spec(n)]
+            if plain:
+                params["nodes"] = plain
+            if machines:
+                params["state_machines"] = machines
         if remove:
             params["remove"] = remove
         if break_links:
@@ -270,6 +304,8 @@ def register_graph_tools(mcp: FastMCP):
             params["connections"] = connections
         if graph_name:
             params["graph_name"] = graph_name
+        if defer_shader_compile:
+            params["defer_shader_compile"] = True
             
         return send_command("graph_batch", params)
 
@@ -289,7 +325,8 @@ def register_graph_tools(mcp: FastMCP):
         only_unconnected: bool = False,
         only_pure: bool = False,
         only_impure: bool = False,
-        graph_name: str = None
+        graph_name: str = None,
+        since_revision: int = None
     ) -> Dict[str, Any]:
         """
         Find nodes in a graph with powerful filtering options.
@@ -312,9 +349,13 @@ def register_graph_tools(mcp: FastMCP):
             only_pure: Only return pure nodes (no exec pins)
             only_impure: Only return impure nodes (has exec pins)
             graph_name: Target graph name (default: EventGraph)
+            since_revision: Only return nodes changed after this revision (from a previous
+                            response's "revision"), plus "removed" node GUIDs and each
+                            returned node's outgoing "links". If the revision is too old
+                            the response has "full": true and lists every match.
             
         Returns:
-            List of matching nodes with info including:
+            "revision" of the graph, and a list of matching nodes with info including:
             - node_id: Node GUID
             - title: Node display title
             - is_pure: Whether the node is pure (no exec pins)
@@ -355,6 +396,8 @@ def register_graph_tools(mcp: FastMCP):
             params["only_impure"] = True
         if graph_name:
             params["graph_name"] = graph_name
+        if since_revision is not None:
+            params["since_revision"] = since_revision
         return send_command("graph_node_find", params)
 
     @mcp.tool()
@@ -362,7 +405,8 @@ def register_graph_tools(mcp: FastMCP):
         ctx: Context,
         asset_name: str,
         node_id: str,
-        graph_name: str = None
+        graph_name: str = None,
+        since_revision: int = None
     ) -> Dict[str, Any]:
         """
         Get detailed information about a node.
@@ -371,9 +415,11 @@ def register_graph_tools(mcp: FastMCP):
             asset_name: Name or path of the target asset
             node_id: Node GUID
             graph_name: Target graph name (default: EventGraph)
+            since_revision: If the node hasn't changed after this revision, return
+                            "unchanged": true instead of the node
             
         Returns:
-            Full node info including all pins
+            Full node info including all pins, plus "revision" and "node_revision"
         """
         params = {
             "asset_name": asset_name,
@@ -381,6 +427,8 @@ def register_graph_tools(mcp: FastMCP):
         }
         if graph_name:
             params["graph_name"] = graph_name
+        if since_revision is not None:
+            params["since_revision"] = since_revision
         return send_command("graph_node_info", params)
 
     logger.info("Graph tools registered successfully (4 tools: graph_batch, graph_node_search_available, graph_node_find, graph_node_info)")
@@ -172,13 +172,17 @@ def register_landscape_tools(mcp: FastMCP):
         ctx: Context,
         actor_name: str,
         heightmap_path: str,
-        scale_z: float = 1.0
+        scale_z: float = 1.0,
+        chunk_rows: int = None
     ) -> Dict[str, Any]:
         """
         Import a heightmap image onto an existing landscape.
 
         The image is automatically resampled to fit the landscape dimensions.
         Supports PNG (8/16-bit grayscale) and RAW (uint16) formats.
+        RAW files are streamed from disk a chunk of rows at a time, so very large
+        heightmaps never sit in memory whole; PNGs are decoded once, then written
+        in chunks.
 
         Args:
             actor_name: Name of the target Landscape actor
@@ -186,11 +190,15 @@ def register_landscape_tools(mcp: FastMCP):
                            (e.g., "/tmp/heightmap.png" or "/Users/me/terrain.raw")
             scale_z: Vertical scale multiplier (default: 1.0)
                     Higher values = more dramatic height differences
+            chunk_rows: Landscape rows written per chunk (default: 256, 16-8192).
+                    Lower = less peak memory, higher = fewer landscape updates
 
         Returns:
             image_width, image_height: Source image dimensions
             landscape_width, landscape_height: Landscape grid dimensions
             vertices_modified: Number of vertices updated
+            streamed: True if the source was read from disk chunk by chunk (RAW)
+            chunks: Number of chunks written
 
         Example:
             # Import a PNG heightmap
@@ -200,11 +208,14 @@ def register_landscape_tools(mcp: FastMCP):
                 scale_z=1.5
             )
         """
-        return send_command("landscape_import_heightmap", {
+        params = {
             "actor_name": actor_name,
             "heightmap_path": heightmap_path,
             "scale_z": scale_z
-        })
+        }
+        if chunk_rows is not None:
+            params["chunk_rows"] = chunk_rows
+        return send_command("landscape_import_heightmap", params)
 
     @mcp.tool()
     def landscape_paint_layer(
@@ -213,24 +224,40 @@ def register_landscape_tools(mcp: FastMCP):
         layer_name: str,
         position: List[float] = None,
         radius: float = 5000.0,
-        strength: float = 1.0
+        strength: float = 1.0,
+        falloff: str = "smooth",
+        strokes: List[Dict] = None
     ) -> Dict[str, Any]:
         """
         Paint a material layer on the landscape.
 
         Paints weight map data for a landscape material layer.
         Layers must be created in the Landscape editor first.
+        Each stroke blends the layer toward full weight
+        (w += (1 - w) * strength * falloff), and the other layers are
+        renormalised in the same write.
+
+        With strokes, every stroke is applied in one call: each layer's
+        weights are read once for the area under all its strokes and
+        written once. Where different layers overlap, the layer painted
+        last wins.
 
         Args:
             actor_name: Name of the Landscape actor
-            layer_name: Name of the material layer to paint
+            layer_name: Name of the material layer to paint (default for strokes)
             position: [X, Y] world coordinates for paint center
             radius: Paint radius in world units (default: 5000)
             strength: Paint strength 0.0-1.0 (default: 1.0)
+            falloff: "smooth" (default), "linear", or "hard"
+            strokes: Batch of strokes, each with position and optionally
+                     layer_name, radius, strength, falloff (defaults: the
+                     top-level values). Replaces position.
 
         Returns:
-            layer_name: Name of the painted layer
-            vertices_painted: Number of vertices affected
+            layer_name: Name of the layer painted last
+            strokes_applied: Strokes inside the landscape
+            vertices_painted: Number of vertices written
+            layers: Per layer - layer_name, strokes, vertices_painted
 
         Example:
             landscape_paint_layer(
@@ -240,6 +267,19 @@ def register_landscape_tools(mcp: FastMCP):
                 radius=3000,
                 strength=0.8
             )
+
+            # A path of rock with a grass edge, one read and write per layer
+            landscape_paint_layer(
+                actor_name="Landscape",
+                layer_name="Rock",
+                radius=800,
+                strokes=[
+                    {"position": [0, 0]},
+                    {"position": [600, 200]},
+                    {"position": [1200, 300], "strength": 0.6},
+                    {"position": [1200, 900], "layer_name": "Grass", "falloff": "linear"}
+                ]
+            )
         """
         params = {
             "actor_name": actor_name,
@@ -249,6 +289,10 @@ def register_landscape_tools(mcp: FastMCP):
         }
         if position:
             params["position"] = position
+        if falloff != "smooth":
+            params["falloff"] = falloff
+        if strokes:
+            params["strokes"] = strokes
         return send_command("landscape_paint_layer", params)
 
     logger.info("Landscape tools registered successfully (4 tools: landscape_create, landscape_sculpt, landscape_import_heightmap, landscape_paint_layer)")
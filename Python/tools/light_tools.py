@@ -83,11 +83,14 @@ def register_light_tools(mcp: FastMCP):
         """
         Build lighting for the current level.
         
+        The build runs in the background; poll
+        core_query(type="job", action="status", job_id=...) until it finishes.
+        
         Args:
             quality: Build quality: "preview", "medium", "high", "production"
             
         Returns:
-            Response indicating that lighting build was started
+            job_id and status ("running") of the lighting build job
         """
         return send_command("light_build", {"quality": quality})
 
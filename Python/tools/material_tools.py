@@ -8,7 +8,7 @@ Naming convention: material_*
 """
 
 import logging
-from typing import Dict, Any
+from typing import Dict, Any, List
 from mcp.server.fastmcp import FastMCP, Context
 
 logger = logging.getLogger("UnrealCompanion")
@@ -64,23 +64,70 @@ def register_material_tools(mcp: FastMCP):
     @mcp.tool()
     def material_set_parameter(
         ctx: Context,
-        material_path: str,
-        parameter_name: str,
-        value: Any,
-        parameter_type: str = "scalar"
+        material_path: str = None,
+        parameter_name: str = None,
+        value: Any = None,
+        parameter_type: str = "scalar",
+        instances: List[Any] = None,
+        parameters: List[Dict] = None,
+        save: bool = True,
+        dry_run: bool = False,
+        on_error: str = "rollback"
     ) -> Dict[str, Any]:
         """
-        Set a parameter value on a Material Instance.
-        
+        Set parameter values on Material Instances.
+
+        Single mode sets one parameter on one instance. Batch mode (instances)
+        sets many parameters on many instances in one call: parameter infos
+        are resolved once per parent, static switches are recompiled once per
+        instance, and each instance gets a single update and save.
+
         Args:
-            material_path: Path to the material instance
-            parameter_name: Name of the parameter to set
+            material_path: Path to the material instance (single mode)
+            parameter_name: Name of the parameter to set (single mode)
             value: Value to set (number for scalar, [r,g,b,a] for vector, path for texture)
             parameter_type: Type of parameter: "scalar", "vector", or "texture"
-            
+            instances: Batch mode - instance paths, or {path, parameters} objects
+                       for per-instance values
+            parameters: Batch mode - [{name, value, type?}] applied to every
+                        instance. type is "scalar", "vector", "texture" or
+                        "static_switch"; when omitted the parent's type is used.
+            save: Batch mode - save the modified instances (default: True)
+            dry_run: Batch mode - validate only, change nothing
+            on_error: Batch mode - "rollback" (apply nothing if any value is
+                      invalid) or "continue" (apply the valid ones)
+
         Returns:
-            Response indicating success or failure
+            Single mode: success, material, parameter, type
+            Batch mode: completed, failed, parameters_set, parents,
+            results (path, parameters_set, recompiled), errors
+
+        Example:
+            # Re-tint a library, with one instance also switching off detail
+            material_set_parameter(
+                instances=[
+                    "/Game/Materials/MI_Rock_A",
+                    "/Game/Materials/MI_Rock_B",
+                    {"path": "/Game/Materials/MI_Rock_C",
+                     "parameters": [{"name": "UseDetail", "value": False}]}
+                ],
+                parameters=[
+                    {"name": "Tint", "value": [0.6, 0.5, 0.4, 1.0]},
+                    {"name": "Roughness", "value": 0.8}
+                ]
+            )
         """
+        if instances:
+            params = {
+                "instances": instances,
+                "save": save,
+                "dry_run": dry_run,
+                "on_error": on_error
+            }
+            if parameters:
+                params["parameters"] = parameters
+            return send_command("material_instance_batch", params)
+
         return send_command("material_set_parameter", {
             "material_path": material_path,
             "parameter_name": parameter_name,
@@ -22,7 +22,9 @@ def register_niagara_tools(mcp: FastMCP):
         ctx: Context,
         system_path: str,
         operations: List[Dict[str, Any]],
-        on_error: str = "continue"
+        on_error: str = "continue",
+        wait_for_compile: bool = False,
+        compile_timeout: float = 60.0
     ) -> Dict[str, Any]:
         """
         Batch operations on Niagara system emitters: add, remove, enable, disable.
@@ -35,9 +37,15 @@ def register_niagara_tools(mcp: FastMCP):
                 - For "add": emitter_path (path to source NiagaraEmitter asset)
                 - For "add": name (optional custom name for the new emitter)
             on_error: Error strategy: "continue" (default) or "stop"
+            wait_for_compile: Reply only once the system's scripts are compiled.
+                Otherwise the compile is queued and issued once per system on the
+                next editor tick (or at core_session commit).
+            compile_timeout: Seconds to wait at most with wait_for_compile
             
         Returns:
-            Results of each operation with success_count and error_count
+            Results of each operation with success_count and error_count,
+            compile_queued, and with wait_for_compile a compile object
+            {ready, compiling, timed_out, wait_ms, emitters: [{name, sim_target, ready}]}
             
         Examples:
             # Enable/disable emitters
@@ -70,6 +78,9 @@ def register_niagara_tools(mcp: FastMCP):
             "operations": operations,
             "on_error": on_error
         }
+        if wait_for_compile:
+            params["wait_for_compile"] = True
+            params["compile_timeout"] = compile_timeout
         return send_command("niagara_emitter_batch", params)
 
     @mcp.tool()
@@ -77,7 +88,9 @@ def register_niagara_tools(mcp: FastMCP):
         ctx: Context,
         system_path: str,
         operations: List[Dict[str, Any]],
-        on_error: str = "continue"
+        on_error: str = "continue",
+        wait_for_compile: bool = False,
+        compile_timeout: float = 60.0
     ) -> Dict[str, Any]:
         """
         Batch operations on Niagara system user parameters: add, set, remove.
@@ -90,9 +103,15 @@ def register_niagara_tools(mcp: FastMCP):
                 - For "add": type (Float, Int, Bool, Vector, Vector2, Vector4, Color)
                 - For "add"/"set": value (number, bool, or array for vector/color)
             on_error: Error strategy: "continue" (default) or "stop"
+            wait_for_compile: Reply only once the system's scripts are compiled.
+                Otherwise the compile is queued and issued once per system on the
+                next editor tick (or at core_session commit).
+            compile_timeout: Seconds to wait at most with wait_for_compile
             
         Returns:
-            Results of each operation with success_count and error_count
+            Results of each operation with success_count and error_count,
+            compile_queued, and with wait_for_compile a compile object
+            {ready, compiling, timed_out, wait_ms, emitters: [{name, sim_target, ready}]}
             
         Examples:
             # Add user parameters
@@ -127,6 +146,9 @@ def register_niagara_tools(mcp: FastMCP):
             "operations": operations,
             "on_error": on_error
         }
+        if wait_for_compile:
+            params["wait_for_compile"] = True
+            params["compile_timeout"] = compile_timeout
         return send_command("niagara_param_batch", params)
 
     @mcp.tool()
@@ -27,7 +27,10 @@ def register_python_tools(mcp: FastMCP):
         ctx: Context,
         code: str,
         confirmation_token: str = "",
-        timeout: int = 30
+        timeout: int = 30,
+        context: str = None,
+        result: str = None,
+        reset_context: bool = False
     ) -> Dict[str, Any]:
         """
         ⚠️ DANGEROUS TOOL - REQUIRES USER CONFIRMATION ⚠️
@@ -54,22 +57,46 @@ def register_python_tools(mcp: FastMCP):
         - Use world_* tools instead of unreal.EditorLevelLibrary
         - Use asset_* tools instead of unreal.AssetToolsHelpers
         
+        PERSISTENT CONTEXTS (fast repeated calls):
+        With `context` and/or `result`, code runs in a named context whose
+        globals persist between calls (`unreal` is pre-imported), compiled
+        code is cached by content hash, and the value of `result` comes back
+        as JSON instead of being printed to the Output Log.
+
         Args:
             code: Python code to execute. Can be multi-line.
             confirmation_token: Token from first call. Required for execution.
             timeout: Timeout in seconds (default: 30)
-            
+            context: Name of a persistent execution context (e.g. "level_tools")
+            result: Expression evaluated after `code` in the context and
+                    returned as "result" (unreal objects become their path)
+            reset_context: Start the context from empty globals first
+
         Returns:
-            Response containing execution result or error
+            Response containing execution result or error.
+            With context/result: result, output (captured stdout), cached
+            (compile skipped), exec_ms; a traceback in "error" on failure.
+
+        Example:
+            python_execute(code="import my_helpers", context="tools")
+            python_execute(code="", context="tools",
+                           result="my_helpers.count_lights()")
         """
         operation_key = code  # Use code as the operation key
+        operation_data = {"code": code, "timeout": timeout}
+        if context is not None:
+            operation_data["context"] = context
+        if result is not None:
+            operation_data["result"] = result
+        if reset_context:
+            operation_data["reset_context"] = True
         
         if not confirmation_token:
             # Step 1: Request confirmation
             result = request_confirmation(
                 tool_name="python_execute",
                 risk_level="CRITICAL",
-                operation_data={"code": code, "timeout": timeout},
+                operation_data=operation_data,
                 operation_key=operation_key,
                 description="User confirmation required to execute Python code.",
                 effect="Can execute any Python code with full system access. Cannot be whitelisted.",
@@ -82,7 +109,7 @@ def register_python_tools(mcp: FastMCP):
         validation = validate_confirmation(
             confirmation_token=confirmation_token,
             tool_name="python_execute",
-            operation_data={"code": code, "timeout": timeout},
+            operation_data=operation_data,
             operation_key=operation_key
         )
         
@@ -91,16 +118,15 @@ def register_python_tools(mcp: FastMCP):
         
         # Token valid - execute
         logger.info("Executing confirmed Python code")
-        return send_command("python_execute", {
-            "code": code,
-            "timeout": timeout
-        })
+        return send_command("python_execute", operation_data)
 
     @mcp.tool()
     def python_execute_file(
         ctx: Context,
         file_path: str,
-        confirmation_token: str = ""
+        confirmation_token: str = "",
+        context: str = None,
+        result: str = None
     ) -> Dict[str, Any]:
         """
         ⚠️ DANGEROUS TOOL - REQUIRES USER CONFIRMATION ⚠️
@@ -123,6 +149,9 @@ def register_python_tools(mcp: FastMCP):
         Args:
             file_path: Path to the Python file to execute (must be in project)
             confirmation_token: Token from first call. Required for execution.
+            context: Run in this persistent context (see python_execute); an
+                     unchanged file is not recompiled
+            result: Expression evaluated after the file, returned as JSON
             
         Returns:
             Response containing execution result or error
@@ -141,13 +170,18 @@ def register_python_tools(mcp: FastMCP):
                 return {"success": False, "error": f"Blocked: Cannot execute files from {suspicious}", "blocked": True}
         
         operation_key = file_path
+        operation_data = {"file_path": file_path}
+        if context is not None:
+            operation_data["context"] = context
+        if result is not None:
+            operation_data["result"] = result
         
         if not confirmation_token:
             # Step 1: Request confirmation
             result = request_confirmation(
                 tool_name="python_execute_file",
                 risk_level="CRITICAL",
-                operation_data={"file_path": file_path},
+                operation_data=operation_data,
                 operation_key=operation_key,
                 description="User confirmation required to execute Python file.",
                 effect="Can execute any Python file with full system access. Cannot be whitelisted.",
@@ -160,7 +194,7 @@ def register_python_tools(mcp: FastMCP):
         validation = validate_confirmation(
             confirmation_token=confirmation_token,
             tool_name="python_execute_file",
-            operation_data={"file_path": file_path},
+            operation_data=operation_data,
             operation_key=operation_key
         )
         
@@ -169,9 +203,7 @@ def register_python_tools(mcp: FastMCP):
         
         # Token valid - execute
         logger.info(f"Executing confirmed Python file: {file_path}")
-        return send_command("python_execute_file", {
-            "file_path": file_path
-        })
+        return send_command("python_execute_file", operation_data)
 
     @mcp.tool()
     def python_list_modules(
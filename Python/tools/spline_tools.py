@@ -72,12 +72,16 @@ def register_spline_tools(mcp: FastMCP):
     def spline_scatter_meshes(
         ctx: Context,
         spline_actor: str,
-        mesh: str,
+        mesh: str = None,
         spacing: float = 500.0,
         random_offset: float = 0.0,
         scale_range: List[float] = None,
         align_to_spline: bool = True,
-        random_yaw: bool = False
+        random_yaw: bool = False,
+        seed: int = None,
+        output: str = None,
+        count: int = None,
+        space: str = "world"
     ) -> Dict[str, Any]:
         """
         Scatter static mesh instances along a spline path.
@@ -93,10 +97,23 @@ def register_spline_tools(mcp: FastMCP):
             scale_range: [min, max] random scale range (default: [1.0, 1.0])
             align_to_spline: Orient meshes along spline direction (default: True)
             random_yaw: Add random yaw rotation (default: False)
+            seed: Random seed; the same seed reproduces the same layout
+                  (default: random, echoed back as "seed")
+            output: "actors" (default) - one StaticMeshActor per placement
+                    "instanced" - one actor with a single HISM component holding all
+                    placements (use for long fences/rows: far fewer actors and draw calls)
+                    "samples" - place nothing; return the sampled points instead
+                    (mesh not needed; spacing, or count evenly spaced samples)
+            count: With output="samples", number of samples, both ends included
+            space: With output="samples", "world" (default) or "local"
 
         Returns:
             instances_placed: Number of mesh instances placed
             spline_length: Total spline length
+            seed: Seed used (pass it back to regenerate this layout)
+            output: Mode used; "actor_name" is also returned for "instanced"
+            With output="samples": samples [{distance, key, location, rotation}],
+            sample_count, sample_ms
 
         Example:
             # Place fence posts along a path
@@ -116,7 +133,21 @@ def register_spline_tools(mcp: FastMCP):
                 scale_range=[0.5, 2.0],
                 random_yaw=True
             )
+
+            # Sample 50 points along a road for custom placement logic
+            spline_scatter_meshes(spline_actor="Road", output="samples", count=50)
         """
+        if output == "samples":
+            sample_params = {"spline_actor": spline_actor, "space": space}
+            if count is not None:
+                sample_params["count"] = count
+            else:
+                sample_params["spacing"] = spacing
+            return send_command("spline_sample", sample_params)
+
+        if not mesh:
+            return {"success": False, "error": "'mesh' is required unless output='samples'"}
+
         params = {
             "spline_actor": spline_actor,
             "mesh": mesh,
@@ -127,6 +158,10 @@ def register_spline_tools(mcp: FastMCP):
         }
         if scale_range:
             params["scale_range"] = scale_range
+        if seed is not None:
+            params["seed"] = seed
+        if output is not None:
+            params["output"] = output
         return send_command("spline_scatter_meshes", params)
 
     logger.info("Spline tools registered successfully (2 tools: spline_create, spline_scatter_meshes)")
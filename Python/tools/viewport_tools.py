@@ -16,6 +16,7 @@ def register_viewport_tools(mcp: FastMCP):
     """Register viewport and screenshot tools with the MCP server."""
     
     from utils.helpers import send_command
+    from utils.shared_memory import resolve_base64_field
 
     @mcp.tool()
     def viewport_get_camera(
@@ -82,22 +83,83 @@ def register_viewport_tools(mcp: FastMCP):
         ctx: Context,
         width: int = 1920,
         height: int = 1080,
-        filename: str = None
+        filename: str = None,
+        filepath: str = None,
+        inline: bool = False,
+        shared_memory: bool = False,
+        async_capture: bool = True,
+        keyframes: List[Dict] = None,
+        restore_camera: bool = True
     ) -> Dict[str, Any]:
         """
         Capture a screenshot of the editor viewport.
-        
+
+        The capture is asynchronous by default: the GPU copy, PNG encoding and
+        file write happen off the game thread and the reply arrives when the
+        image is ready, so the editor never stalls on the readback.
+
         Args:
             width: Screenshot width in pixels (default: 1920)
             height: Screenshot height in pixels (default: 1080)
-            filename: Optional filename (without extension). If not provided, uses timestamp.
-            
+            filename: Optional filename (without extension), saved under
+                      Saved/Screenshots/UnrealCompanion. If not provided, uses timestamp.
+            filepath: Optional absolute output path (overrides filename)
+            inline: Return the PNG as base64 in "image_base64". With inline=True and
+                    no filename/filepath, nothing is written to disk.
+            shared_memory: Like inline, but the PNG travels through the editor's
+                    shared-memory ring instead of the socket (same machine only).
+                    The result still carries "image_base64".
+            async_capture: Use the non-blocking readback pipeline (default: True)
+            keyframes: Capture a sequence in one call instead of a single shot. Each
+                       keyframe may set "location", "rotation", "time" (sun hour) and
+                       "environment" (environment_configure "apply" settings) and an
+                       optional "filename". One keyframe is applied and captured per
+                       editor frame. Files default to <filename or "Sequence">_0000.png.
+            restore_camera: Put the camera back after a sequence (default: True)
+
         Returns:
-            Response containing the screenshot file path
+            Response containing the screenshot file path and/or inline image,
+            width, height, bytes and async. A sequence returns "frames" (one
+            result per keyframe, with its index), frame_count, failed, total_ms
+            and frames_per_second.
+
+        Example:
+            # Sun sweep from dawn to dusk, 24 frames, one request
+            viewport_screenshot(filename="sweep",
+                                keyframes=[{"time": 6 + h * 0.5} for h in range(25)])
         """
+        if keyframes:
+            params = {"keyframes": keyframes}
+            if filename:
+                params["filename"] = filename
+            if inline:
+                params["inline"] = True
+            if shared_memory:
+                params["shared_memory"] = True
+            if not async_capture:
+                params["async"] = False
+            if not restore_camera:
+                params["restore_camera"] = False
+            response = send_command("viewport_capture_sequence", params)
+            if shared_memory:
+                for frame in (response.get("result") or {}).get("frames", []):
+                    resolve_base64_field(frame, "image_base64")
+            return response
+
         params = {"width": width, "height": height}
         if filename:
             params["filename"] = filename
-        return send_command("viewport_screenshot", params)
+        if filepath:
+            params["filepath"] = filepath
+        if inline:
+            params["inline"] = True
+        if shared_memory:
+            params["shared_memory"] = True
+        if not async_capture:
+            params["async"] = False
+        response = send_command("viewport_screenshot", params)
+        if shared_memory and isinstance(response.get("result"), dict):
+            resolve_base64_field(response["result"], "image_base64")
+        return response
 
     logger.info("Viewport tools registered successfully (4 tools)")
@@ -49,7 +49,8 @@ def register_widget_tools(mcp: FastMCP):
         modify: Optional[List[Dict[str, Any]]] = None,
         remove: Optional[List[str]] = None,
         on_error: str = "continue",
-        dry_run: bool = False
+        dry_run: bool = False,
+        defer_compile: bool = False
     ) -> Dict[str, Any]:
         """
         Batch widget operations: add, modify, and remove widgets in a Widget Blueprint.
@@ -69,7 +70,7 @@ def register_widget_tools(mcp: FastMCP):
                     - Direct path: "/Game/UI/WBP_ProgressBar"
                 - name: Widget name in the tree
                 - parent: Existing widget name to add to
-                - parent_ref: OR ref of widget created in this batch
+                - parent_ref: OR ref of widget created in this batch (may come later in the list)
                 - is_variable: Expose as variable (default: false)
                 - slot: Slot properties (depends on parent type):
                     For CanvasPanel: position, size, anchors, alignment, auto_size, z_order
@@ -94,6 +95,9 @@ def register_widget_tools(mcp: FastMCP):
             
             on_error: Error strategy - "rollback", "continue", "stop"
             dry_run: Validate without executing
+            defer_compile: Queue the compile; batches queued for the same Widget
+                Blueprint before the next editor tick share one compile
+                (response has compile_queued=True). Default compiles once per call.
             
         Returns:
             Results with added/modified/removed counts and any errors
@@ -136,6 +140,8 @@ def register_widget_tools(mcp: FastMCP):
             "dry_run": dry_run
         }
         
+        if defer_compile:
+            params["defer_compile"] = True
         if widgets:
             params["widgets"] = widgets
         if modify:
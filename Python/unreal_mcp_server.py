@@ -11,6 +11,7 @@ import json
 from contextlib import asynccontextmanager
 from typing import AsyncIterator, Dict, Any, Optional
 from mcp.server.fastmcp import FastMCP
+from utils.framing import decode_payload, encode_cbor_frame, encode_json_frame, read_frame
 
 # Configure logging with more detailed format
 # Note: Use stderr for terminal output (stdout is used by MCP for JSON communication)
@@ -54,15 +55,23 @@ logger = logging.getLogger("UnrealCompanion")
 
 # Configuration
 UNREAL_HOST = "127.0.0.1"
-UNREAL_PORT = 55557
+# Override for a bridge started on another port (-UnrealCompanionPort=, e.g. parallel CI commandlets)
+UNREAL_PORT = int(os.environ.get("UNREAL_MCP_PORT", "55557"))
+
+# Several editors to shard work across ("port=/Game/Prefix,...;port;..."); see utils/router.py
+UNREAL_INSTANCES = os.environ.get("UNREAL_MCP_INSTANCES", "")
+
+# Payload encoding for requests: "json" (default) or "cbor" (compact, numeric arrays packed)
+WIRE_FORMAT = os.environ.get("UNREAL_MCP_WIRE_FORMAT", "json").lower()
 
 class UnrealConnection:
     """Connection to an Unreal Engine instance."""
     
-    def __init__(self):
+    def __init__(self, port: int = None):
         """Initialize the connection."""
         self.socket = None
         self.connected = False
+        self.port = port or UNREAL_PORT
     
     def connect(self) -> bool:
         """Connect to the Unreal Engine instance."""
@@ -75,7 +84,7 @@ class UnrealConnection:
                     pass
                 self.socket = None
             
-            logger.info(f"Connecting to Unreal at {UNREAL_HOST}:{UNREAL_PORT}...")
+            logger.info(f"Connecting to Unreal at {UNREAL_HOST}:{self.port}...")
             self.socket = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
             self.socket.settimeout(5)  # 5 second timeout
             
@@ -87,7 +96,7 @@ class UnrealConnection:
             self.socket.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 65536)
             self.socket.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, 65536)
             
-            self.socket.connect((UNREAL_HOST, UNREAL_PORT))
+            self.socket.connect((UNREAL_HOST, self.port))
             self.connected = True
             logger.info("Connected to Unreal Engine")
             return True
@@ -107,46 +116,15 @@ class UnrealConnection:
         self.socket = None
         self.connected = False
 
-    def receive_full_response(self, sock, buffer_size=4096) -> bytes:
-        """Receive a complete response from Unreal, handling chunked data."""
-        chunks = []
-        sock.settimeout(5)  # 5 second timeout
+    def receive_full_response(self, sock) -> Dict[str, Any]:
+        """Receive and decode one complete framed response from Unreal."""
+        sock.settimeout(5)  # 5 second timeout between chunks
         try:
-            while True:
-                chunk = sock.recv(buffer_size)
-                if not chunk:
-                    if not chunks:
-                        raise Exception("Connection closed before receiving data")
-                    break
-                chunks.append(chunk)
-                
-                # Process the data received so far
-                data = b''.join(chunks)
-                decoded_data = data.decode('utf-8')
-                
-                # Try to parse as JSON to check if complete
-                try:
-                    json.loads(decoded_data)
-                    logger.info(f"Received complete response ({len(data)} bytes)")
-                    return data
-                except json.JSONDecodeError:
-                    # Not complete JSON yet, continue reading
-                    logger.debug(f"Received partial response, waiting for more data...")
-                    continue
-                except Exception as e:
-                    logger.warning(f"Error processing response chunk: {str(e)}")
-                    continue
+            flags, payload = read_frame(sock)
+            logger.info(f"Received complete response ({len(payload)} bytes)")
+            return decode_payload(flags, payload)
         except socket.timeout:
             logger.warning("Socket timeout during receive")
-            if chunks:
-                # If we have some data already, try to use it
-                data = b''.join(chunks)
-                try:
-                    json.loads(data.decode('utf-8'))
-                    logger.info(f"Using partial response after timeout ({len(data)} bytes)")
-                    return data
-                except:
-                    pass
             raise Exception("Timeout receiving Unreal response")
         except Exception as e:
             logger.error(f"Error during receive: {str(e)}")
@@ -175,17 +153,16 @@ class UnrealConnection:
                 "params": params or {}  # Use Unity's params or {} pattern
             }
             
-            # Send without newline, exactly like Unity
-            command_json = json.dumps(command_obj)
-            logger.info(f"Sending command: {command_json}")
-            self.socket.sendall(command_json.encode('utf-8'))
+            # Length-prefixed frame: the plugin reassembles payloads of any size
+            frame = encode_cbor_frame(command_obj) if WIRE_FORMAT == "cbor" else encode_json_frame(command_obj)
+            logger.info(f"Sending command: {command} ({len(frame)} bytes)")
+            self.socket.sendall(frame)
             
             # Read response using improved handler
-            response_data = self.receive_full_response(self.socket)
-            response = json.loads(response_data.decode('utf-8'))
+            response = self.receive_full_response(self.socket)
             
             # Log complete response for debugging
-            logger.info(f"Complete response from Unreal: {response}")
+            logger.debug(f"Complete response from Unreal: {response}")
             
             # Check for both error formats: {"status": "error", ...} and {"success": false, ...}
             if response.get("status") == "error":
@@ -264,6 +241,20 @@ def get_unreal_connection() -> Optional[UnrealConnection]:
         logger.error(f"Error getting Unreal connection: {e}")
         return None
 
+# Multi-editor router, when UNREAL_MCP_INSTANCES is set
+_router = None
+
+def get_router():
+    """Get the command router, or None when the server talks to a single editor."""
+    global _router
+    if _router is None and UNREAL_INSTANCES:
+        from utils.router import CommandRouter, parse_instances
+        # A fresh connection per command: routed commands run concurrently on different editors
+        _router = CommandRouter(parse_instances(UNREAL_INSTANCES),
+                                lambda port, command, params: UnrealConnection(port).send_command(command, params))
+        logger.info(f"Routing across editors on ports {[i.port for i in _router.instances]}")
+    return _router
+
 @asynccontextmanager
 async def server_lifespan(server: FastMCP) -> AsyncIterator[Dict[str, Any]]:
     """Handle server startup and shutdown."""
@@ -0,0 +1,321 @@
+"""
+Bridge benchmark: replay a command mix against a running editor and report
+throughput and tail latency per command family, as JSON.
+
+Two ways to run the same mix:
+
+- socket (default): N client connections, one request in flight each, so the
+  numbers include framing, the socket and the plugin's connection threads.
+- bridge: one bridge_benchmark request; the plugin replays the mix through
+  its own scheduler, so the numbers are queue + execute time only.
+
+Run it against a scratch level (it creates a Blueprint, a small landscape,
+foliage and actors under the BridgeBenchmark names):
+
+    python -m utils.benchmark --concurrency 1,4,16 --output bench.json
+
+Compare the JSON across plugin versions to spot regressions.
+"""
+
+import argparse
+import json
+import math
+import socket
+import sys
+import threading
+import time
+from typing import Any, Dict, Iterable, List, Optional
+
+from utils.framing import (
+    decode_payload,
+    encode_cbor_frame,
+    encode_json_frame,
+    read_frame,
+)
+
+DEFAULT_HOST = "127.0.0.1"
+DEFAULT_PORT = 55557
+DEFAULT_CONCURRENCY = [1, 4, 16]
+
+FIXTURE_FOLDER = "/Game/BridgeBenchmark"
+FIXTURE_BLUEPRINT = "BP_BridgeBenchmark"
+FIXTURE_LANDSCAPE = "BridgeBenchmarkLandscape"
+FIXTURE_MESH = "/Engine/BasicShapes/Cube.Cube"
+
+
+def graph_chain(blueprint_name: str, node_count: int) -> Dict[str, Any]:
+    """graph_batch params that add a BeginPlay event followed by a chain of PrintString calls."""
+    nodes = [{"ref": "begin", "type": "event", "event_name": "ReceiveBeginPlay", "position": [0, 0]}]
+    connections = []
+    previous = "begin"
+    for index in range(node_count - 1):
+        ref = f"print_{index}"
+        nodes.append({
+            "ref": ref,
+            "type": "function_call",
+            "function_name": "PrintString",
+            "position": [300 * (index + 1), 0],
+        })
+        connections.append({"source_ref": previous, "source_pin": "then", "target_ref": ref, "target_pin": "execute"})
+        previous = ref
+    return {
+        "blueprint_name": blueprint_name,
+        "nodes": nodes,
+        "connections": connections,
+        "on_error": "continue",
+        "verbosity": "minimal",
+        "auto_compile": False,
+        "focus_editor": False,
+    }
+
+
+def default_setup() -> List[Dict[str, Any]]:
+    """Commands that reset the fixture before each concurrency level (failures are expected on a fresh level)."""
+    blueprint_path = f"{FIXTURE_FOLDER}/{FIXTURE_BLUEPRINT}"
+    return [
+        {"type": "asset_delete", "params": {"path": blueprint_path}},
+        {"type": "blueprint_create", "params": {"name": FIXTURE_BLUEPRINT, "parent_class": "Actor", "path": FIXTURE_FOLDER}},
+        {"type": "world_delete_actor", "params": {"name": FIXTURE_LANDSCAPE}},
+        {"type": "landscape_create", "params": {"size_x": 2, "size_y": 2, "section_size": 63, "name": FIXTURE_LANDSCAPE}},
+        {"type": "foliage_remove", "params": {"center": [0, 0, 0], "radius": 1000000.0, "mesh": FIXTURE_MESH}},
+    ]
+
+
+def default_mix(scale: float = 1.0) -> List[Dict[str, Any]]:
+    """
+    The standard mix: cheap control-plane calls, graph batches of three sizes
+    and the heavy world-building tools. `scale` multiplies every iteration count.
+    """
+    def iterations(count: int) -> int:
+        return max(1, int(round(count * scale)))
+
+    return [
+        {"family": "ping", "type": "ping", "params": {}, "iterations": iterations(200)},
+        {"family": "core_query", "type": "core_query",
+         "params": {"type": "asset", "action": "list", "path": "/Game", "max_results": 100},
+         "iterations": iterations(100)},
+        {"family": "graph_batch_10", "type": "graph_batch",
+         "params": graph_chain(FIXTURE_BLUEPRINT, 10), "iterations": iterations(20)},
+        {"family": "graph_batch_100", "type": "graph_batch",
+         "params": graph_chain(FIXTURE_BLUEPRINT, 100), "iterations": iterations(10)},
+        {"family": "graph_batch_1000", "type": "graph_batch",
+         "params": graph_chain(FIXTURE_BLUEPRINT, 1000), "iterations": iterations(3)},
+        {"family": "world_spawn_batch", "type": "world_spawn_batch",
+         "params": {
+             "actors": [{"ref": f"a{i}", "type": "StaticMeshActor", "location": [i * 200.0, 5000.0, 0.0]} for i in range(50)],
+             "on_error": "continue", "verbosity": "minimal", "focus_editor": False,
+         },
+         "iterations": iterations(10)},
+        {"family": "foliage_scatter", "type": "foliage_scatter",
+         "params": {"mesh": FIXTURE_MESH, "center": [6300.0, 6300.0, 0.0], "radius": 5000.0, "count": 500, "seed": 7},
+         "iterations": iterations(10)},
+        {"family": "landscape_sculpt", "type": "landscape_sculpt",
+         "params": {
+             "actor_name": FIXTURE_LANDSCAPE,
+             "operations": [
+                 {"type": "raise", "center": [6300.0, 6300.0], "radius": 3000.0, "intensity": 0.1},
+                 {"type": "smooth", "center": [6300.0, 6300.0], "radius": 3000.0, "intensity": 0.5},
+             ],
+         },
+         "iterations": iterations(10)},
+    ]
+
+
+def interleave(mix: List[Dict[str, Any]]) -> List[int]:
+    """Round-robin order of family indices, each repeated `iterations` times (same order as the plugin)."""
+    remaining = [max(1, int(entry.get("iterations", 10))) for entry in mix]
+    order: List[int] = []
+    while any(remaining):
+        for index, count in enumerate(remaining):
+            if count > 0:
+                remaining[index] -= 1
+                order.append(index)
+    return order
+
+
+def quantile(sorted_values: List[float], q: float) -> float:
+    """Nearest-rank quantile of an ascending list (0 when empty)."""
+    if not sorted_values:
+        return 0.0
+    rank = max(1, math.ceil(q * len(sorted_values)))
+    return sorted_values[min(rank, len(sorted_values)) - 1]
+
+
+def summarize_family(command_type: str, latencies_ms: List[float], errors: int, wall_seconds: float) -> Dict[str, Any]:
+    """Per-family block of the report; same fields as the plugin's bridge_benchmark."""
+    ordered = sorted(latencies_ms)
+    count = len(ordered)
+    return {
+        "type": command_type,
+        "count": count,
+        "errors": errors,
+        "throughput_rps": count / wall_seconds if wall_seconds > 0 else 0.0,
+        "mean_ms": sum(ordered) / count if count else 0.0,
+        "p50_ms": quantile(ordered, 0.50),
+        "p95_ms": quantile(ordered, 0.95),
+        "p99_ms": quantile(ordered, 0.99),
+        "max_ms": ordered[-1] if ordered else 0.0,
+    }
+
+
+def _is_success(response: Dict[str, Any]) -> bool:
+    if response.get("status") == "error" or response.get("success") is False:
+        return False
+    result = response.get("result")
+    return not (isinstance(result, dict) and result.get("success") is False)
+
+
+class _Client:
+    """One blocking connection: send a framed request, wait for its response."""
+
+    def __init__(self, host: str, port: int, wire_format: str, timeout: float):
+        self.encode = encode_cbor_frame if wire_format == "cbor" else encode_json_frame
+        self.sock = socket.create_connection((host, port), timeout=timeout)
+        self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+
+    def call(self, command_type: str, params: Dict[str, Any]) -> Dict[str, Any]:
+        self.sock.sendall(self.encode({"type": command_type, "params": params}))
+        flags, payload = read_frame(self.sock)
+        return decode_payload(flags, payload)
+
+    def close(self) -> None:
+        try:
+            self.sock.close()
+        except OSError:
+            pass
+
+
+def run_socket_level(mix: List[Dict[str, Any]], setup: List[Dict[str, Any]], concurrency: int,
+                     host: str = DEFAULT_HOST, port: int = DEFAULT_PORT, wire_format: str = "json",
+                     timeout: float = 300.0) -> Dict[str, Any]:
+    """Replay the mix once with `concurrency` connections and return that level's report."""
+    setup_client = _Client(host, port, wire_format, timeout)
+    try:
+        for entry in setup:
+            setup_client.call(entry["type"], entry.get("params", {}))
+    finally:
+        setup_client.close()
+
+    order = interleave(mix)
+    cursor = iter(order)
+    cursor_lock = threading.Lock()
+    latencies: List[List[float]] = [[] for _ in mix]
+    errors = [0] * len(mix)
+    results_lock = threading.Lock()
+    failures: List[BaseException] = []
+
+    def worker() -> None:
+        try:
+            client = _Client(host, port, wire_format, timeout)
+        except OSError as exc:
+            failures.append(exc)
+            return
+        try:
+            while True:
+                with cursor_lock:
+                    index = next(cursor, None)
+                if index is None:
+                    return
+                entry = mix[index]
+                start = time.perf_counter()
+                try:
+                    ok = _is_success(client.call(entry["type"], entry.get("params", {})))
+                except (OSError, ValueError) as exc:
+                    failures.append(exc)
+                    return
+                elapsed_ms = (time.perf_counter() - start) * 1000.0
+                with results_lock:
+                    latencies[index].append(elapsed_ms)
+                    if not ok:
+                        errors[index] += 1
+        finally:
+            client.close()
+
+    started = time.perf_counter()
+    threads = [threading.Thread(target=worker, daemon=True) for _ in range(concurrency)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    wall_seconds = max(time.perf_counter() - started, 1e-9)
+
+    if failures and not any(latencies):
+        raise ConnectionError(f"Benchmark level failed: {failures[0]}")
+
+    families = {}
+    for index, entry in enumerate(mix):
+        name = entry.get("family") or entry["type"]
+        families[name] = summarize_family(entry["type"], latencies[index], errors[index], wall_seconds)
+
+    completed = sum(len(values) for values in latencies)
+    return {
+        "concurrency": concurrency,
+        "requests": completed,
+        "errors": sum(errors),
+        "transport_failures": len(failures),
+        "wall_seconds": wall_seconds,
+        "throughput_rps": completed / wall_seconds,
+        "families": families,
+    }
+
+
+def run_socket(mix: List[Dict[str, Any]], setup: List[Dict[str, Any]], levels: Iterable[int], **kwargs) -> Dict[str, Any]:
+    """Full report for the socket mode."""
+    return {
+        "success": True,
+        "mode": "socket",
+        "wire_format": kwargs.get("wire_format", "json"),
+        "levels": [run_socket_level(mix, setup, level, **kwargs) for level in levels],
+    }
+
+
+def run_in_bridge(mix: List[Dict[str, Any]], setup: List[Dict[str, Any]], levels: Iterable[int],
+                  host: str = DEFAULT_HOST, port: int = DEFAULT_PORT, wire_format: str = "json",
+                  timeout: float = 3600.0) -> Dict[str, Any]:
+    """Full report for the in-process mode (one bridge_benchmark request)."""
+    client = _Client(host, port, wire_format, timeout)
+    try:
+        response = client.call("bridge_benchmark", {"mix": mix, "setup": setup, "concurrency": list(levels)})
+    finally:
+        client.close()
+    if not _is_success(response):
+        raise RuntimeError(f"bridge_benchmark failed: {response.get('error') or response}")
+    return response.get("result", response)
+
+
+def main(argv: Optional[List[str]] = None) -> int:
+    parser = argparse.ArgumentParser(description="Benchmark the Unreal Companion bridge.")
+    parser.add_argument("--mode", choices=["socket", "bridge"], default="socket")
+    parser.add_argument("--concurrency", default=",".join(str(c) for c in DEFAULT_CONCURRENCY),
+                        help="Comma-separated client concurrency levels (default: 1,4,16)")
+    parser.add_argument("--scale", type=float, default=1.0, help="Multiply every family's iteration count")
+    parser.add_argument("--mix", help="JSON file with {\"mix\": [...], \"setup\": [...]} replacing the default mix")
+    parser.add_argument("--wire-format", choices=["json", "cbor"], default="json")
+    parser.add_argument("--host", default=DEFAULT_HOST)
+    parser.add_argument("--port", type=int, default=DEFAULT_PORT)
+    parser.add_argument("--output", help="Write the JSON report here instead of stdout")
+    args = parser.parse_args(argv)
+
+    levels = [int(value) for value in args.concurrency.split(",") if value.strip()]
+    if args.mix:
+        with open(args.mix, "r", encoding="utf-8") as handle:
+            recorded = json.load(handle)
+        mix, setup = recorded["mix"], recorded.get("setup", [])
+    else:
+        mix, setup = default_mix(args.scale), default_setup()
+
+    runner = run_in_bridge if args.mode == "bridge" else run_socket
+    report = runner(mix, setup, levels, host=args.host, port=args.port, wire_format=args.wire_format)
+    report["generated_at"] = time.strftime("%Y-%m-%dT%H:%M:%SZ", time.gmtime())
+
+    text = json.dumps(report, indent=2)
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as handle:
+            handle.write(text)
+    else:
+        print(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
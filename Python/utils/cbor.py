@@ -0,0 +1,234 @@
+"""
+CBOR (RFC 8949) codec for the binary wire format.
+
+Only the subset the plugin speaks is implemented: maps, arrays, text, byte
+strings, integers, floats, booleans and null, plus
+
+- RFC 8746 typed arrays: lists of at least PACKED_ARRAY_MIN_LENGTH numbers
+  are written as one little-endian byte string (tag 78 for int32, tag 86 for
+  float64) and decoded back into lists,
+- tag 262 (embedded JSON), which the plugin uses for pre-encoded results.
+
+Decoding mirrors the plugin: untagged byte strings become base64 text so the
+result is always JSON-compatible.
+"""
+
+import base64
+import json
+import struct
+from typing import Any, List, Tuple
+
+PACKED_ARRAY_MIN_LENGTH = 16
+MAX_DEPTH = 64
+
+TAG_SINT32_LE = 78
+TAG_FLOAT64_LE = 86
+TAG_EMBEDDED_JSON = 262
+
+# Typed-array tag -> struct format character (all little endian)
+_TYPED_ARRAYS = {
+    64: "B",
+    69: "H",
+    70: "I",
+    72: "b",
+    77: "h",
+    78: "i",
+    79: "q",
+    85: "f",
+    86: "d",
+}
+
+_INT32_MIN = -(2 ** 31)
+_INT32_MAX = 2 ** 31 - 1
+
+
+def _head(major: int, value: int) -> bytes:
+    """Encode a major type and its argument."""
+    prefix = major << 5
+    if value < 24:
+        return bytes([prefix | value])
+    if value <= 0xFF:
+        return bytes([prefix | 24, value])
+    if value <= 0xFFFF:
+        return bytes([prefix | 25]) + struct.pack(">H", value)
+    if value <= 0xFFFFFFFF:
+        return bytes([prefix | 26]) + struct.pack(">I", value)
+    return bytes([prefix | 27]) + struct.pack(">Q", value)
+
+
+def _is_number(value: Any) -> bool:
+    return isinstance(value, (int, float)) and not isinstance(value, bool)
+
+
+def _packed_array(values: List[Any]) -> bytes:
+    """Typed-array encoding for an all-number list, or b"" if it does not qualify."""
+    if len(values) < PACKED_ARRAY_MIN_LENGTH or not all(_is_number(v) for v in values):
+        return b""
+    if all(isinstance(v, int) and _INT32_MIN <= v <= _INT32_MAX for v in values):
+        tag, payload = TAG_SINT32_LE, struct.pack(f"<{len(values)}i", *values)
+    else:
+        tag, payload = TAG_FLOAT64_LE, struct.pack(f"<{len(values)}d", *(float(v) for v in values))
+    return _head(6, tag) + _head(2, len(payload)) + payload
+
+
+def _encode(value: Any, out: bytearray) -> None:
+    if value is None:
+        out.append(0xF6)
+    elif value is True:
+        out.append(0xF5)
+    elif value is False:
+        out.append(0xF4)
+    elif isinstance(value, int):
+        if value >= 0:
+            out += _head(0, value)
+        else:
+            out += _head(1, -1 - value)
+    elif isinstance(value, float):
+        out.append(0xFB)
+        out += struct.pack(">d", value)
+    elif isinstance(value, str):
+        data = value.encode("utf-8")
+        out += _head(3, len(data))
+        out += data
+    elif isinstance(value, (bytes, bytearray)):
+        out += _head(2, len(value))
+        out += value
+    elif isinstance(value, (list, tuple)):
+        packed = _packed_array(list(value))
+        if packed:
+            out += packed
+        else:
+            out += _head(4, len(value))
+            for item in value:
+                _encode(item, out)
+    elif isinstance(value, dict):
+        out += _head(5, len(value))
+        for key, item in value.items():
+            _encode(str(key), out)
+            _encode(item, out)
+    else:
+        raise TypeError(f"Cannot CBOR-encode {type(value).__name__}")
+
+
+def dumps(value: Any) -> bytes:
+    """Serialize a JSON-compatible value to CBOR."""
+    out = bytearray()
+    _encode(value, out)
+    return bytes(out)
+
+
+class _Decoder:
+    """Recursive-descent decoder over one buffer."""
+
+    def __init__(self, data: bytes):
+        self.data = data
+        self.offset = 0
+
+    def _take(self, size: int) -> bytes:
+        if self.offset + size > len(self.data):
+            raise ValueError("Unexpected end of CBOR data")
+        chunk = self.data[self.offset:self.offset + size]
+        self.offset += size
+        return chunk
+
+    def _head(self) -> Tuple[int, int, int]:
+        initial = self._take(1)[0]
+        major, info = initial >> 5, initial & 0x1F
+        if info < 24:
+            return major, info, info
+        if info == 31:
+            if major in (0, 1, 6):
+                raise ValueError("Indefinite length not allowed here")
+            return major, info, 0
+        if info > 27:
+            raise ValueError("Reserved additional information in CBOR head")
+        return major, info, int.from_bytes(self._take(1 << (info - 24)), "big")
+
+    def _is_break(self) -> bool:
+        if self.offset < len(self.data) and self.data[self.offset] == 0xFF:
+            self.offset += 1
+            return True
+        return False
+
+    def _string(self, major: int, info: int, length: int) -> bytes:
+        if info != 31:
+            return self._take(length)
+        chunks = []
+        while not self._is_break():
+            chunk_major, chunk_info, chunk_length = self._head()
+            if chunk_major != major or chunk_info == 31:
+                raise ValueError("Bad chunk in indefinite-length string")
+            chunks.append(self._take(chunk_length))
+        return b"".join(chunks)
+
+    def value(self, depth: int = 0) -> Any:
+        if depth > MAX_DEPTH:
+            raise ValueError("CBOR nesting too deep")
+        major, info, argument = self._head()
+
+        if major == 0:
+            return argument
+        if major == 1:
+            return -1 - argument
+        if major == 2:
+            return base64.b64encode(self._string(2, info, argument)).decode("ascii")
+        if major == 3:
+            return self._string(3, info, argument).decode("utf-8")
+        if major == 4:
+            items = []
+            while (info == 31 and not self._is_break()) or (info != 31 and len(items) < argument):
+                items.append(self.value(depth + 1))
+            return items
+        if major == 5:
+            result = {}
+            count = 0
+            while (info == 31 and not self._is_break()) or (info != 31 and count < argument):
+                key = self.value(depth + 1)
+                if not isinstance(key, (str, int)) or isinstance(key, bool):
+                    raise ValueError("CBOR map keys must be text")
+                result[str(key)] = self.value(depth + 1)
+                count += 1
+            return result
+        if major == 6:
+            return self._tagged(argument, depth)
+
+        if info == 20:
+            return False
+        if info == 21:
+            return True
+        if info in (22, 23):
+            return None
+        if info == 25:
+            return struct.unpack(">e", argument.to_bytes(2, "big"))[0]
+        if info == 26:
+            return struct.unpack(">f", argument.to_bytes(4, "big"))[0]
+        if info == 27:
+            return struct.unpack(">d", argument.to_bytes(8, "big"))[0]
+        raise ValueError(f"Unsupported CBOR simple value {info}")
+
+    def _tagged(self, tag: int, depth: int) -> Any:
+        if tag not in _TYPED_ARRAYS and tag != TAG_EMBEDDED_JSON:
+            return self.value(depth + 1)
+
+        major, info, argument = self._head()
+        if major != 2 and not (tag == TAG_EMBEDDED_JSON and major == 3):
+            raise ValueError("Typed array or embedded JSON tag must wrap a byte string")
+        data = self._string(major, info, argument)
+
+        if tag == TAG_EMBEDDED_JSON:
+            return json.loads(data.decode("utf-8"))
+
+        code = _TYPED_ARRAYS[tag]
+        size = struct.calcsize(code)
+        if len(data) % size:
+            raise ValueError("Typed array length is not a multiple of its element size")
+        return list(struct.unpack(f"<{len(data) // size}{code}", data))
+
+
+def loads(data: bytes) -> Any:
+    """Deserialize one CBOR item; trailing bytes are an error."""
+    decoder = _Decoder(bytes(data))
+    result = decoder.value()
+    if decoder.offset != len(decoder.data):
+        raise ValueError("Trailing bytes after CBOR message")
+    return result
@@ -0,0 +1,164 @@
+"""
+Client-side request validation against the plugin's command schema.
+
+The plugin exports its command registry with bridge_schema: every command
+with its thread affinity and scheduling priority, and for commands with typed
+params the field list the bridge validates before queueing (name, type,
+required, aliases, one_of). A request that would come back INVALID_PARAMS is
+rejected here instead, without a round trip.
+
+The checks mirror the bridge's own and are no stricter: scalar types accept
+the same conversions as FJsonValue (numbers as strings, booleans as numbers,
+...), null counts as absent, and an empty string passes a one_of. Commands
+the schema does not list are sent as-is (ping, or a plugin newer than the
+schema), and rules the field list cannot express (server_checks) are left to
+the bridge.
+"""
+
+import threading
+from typing import Any, Callable, Dict, List, Optional
+
+# Same wording as the bridge's TMCPParamSchema errors
+_TYPE_WORDING = {
+    "string": "a string",
+    "boolean": "a boolean",
+    "integer": "an integer",
+    "number": "a number",
+    "vector": "an [x, y, z] array",
+    "rotator": "a [pitch, yaw, roll] array",
+    "string_array": "an array of strings",
+    "object": "an object",
+    "array": "an array",
+}
+
+
+def _is_number_like(value: Any) -> bool:
+    """FJsonValue::TryGetNumber: numbers, booleans and numeric strings."""
+    if isinstance(value, (bool, int, float)):
+        return True
+    if isinstance(value, str):
+        try:
+            float(value)
+            return True
+        except ValueError:
+            return False
+    return False
+
+
+def _is_scalar(value: Any) -> bool:
+    """FJsonValue::TryGetString / TryGetBool: any string, number or boolean."""
+    return isinstance(value, (str, bool, int, float))
+
+
+def _is_triple(value: Any) -> bool:
+    return isinstance(value, list) and len(value) >= 3 and all(_is_number_like(v) for v in value[:3])
+
+
+_TYPE_CHECKS: Dict[str, Callable[[Any], bool]] = {
+    "string": _is_scalar,
+    "boolean": _is_scalar,
+    "integer": _is_number_like,
+    "number": _is_number_like,
+    "vector": _is_triple,
+    "rotator": _is_triple,
+    "string_array": lambda v: isinstance(v, list) and all(_is_scalar(e) for e in v),
+    "object": lambda v: isinstance(v, dict),
+    "array": lambda v: isinstance(v, list),
+}
+
+
+def _check_one_of(name: str, value: Any, allowed: List[str]) -> Optional[str]:
+    if not isinstance(value, str) or not value:
+        return None
+    if any(value.lower() == a.lower() for a in allowed):
+        return None
+    return f"Parameter '{name}' must be one of: {', '.join(allowed)} (got '{value}')"
+
+
+class CommandSchema:
+    """The registry exported by bridge_schema; read-only once built."""
+
+    def __init__(self, schema: Dict[str, Any]):
+        self.commands: Dict[str, Dict[str, Any]] = dict(schema.get("commands") or {})
+
+    def knows(self, command: str) -> bool:
+        return command in self.commands
+
+    def affinity(self, command: str) -> Optional[str]:
+        entry = self.commands.get(command)
+        return entry.get("affinity") if entry else None
+
+    def validate(self, command: str, params: Optional[Dict[str, Any]]) -> Optional[str]:
+        """Error message the bridge would answer INVALID_PARAMS with, None if the request passes."""
+        entry = self.commands.get(command)
+        if not entry or "params" not in entry:
+            return None
+        spec = entry["params"]
+        params = params or {}
+
+        # The bridge checks the standard fields first, then the declared ones in order
+        for field in spec.get("standard") or []:
+            error = _check_one_of(field["name"], params.get(field["name"]), field.get("one_of") or [])
+            if error:
+                return error
+
+        for field in spec.get("fields") or []:
+            name = field["name"]
+            aliases = field.get("aliases") or []
+            found, value = None, None
+            for key in [name, *aliases]:
+                if params.get(key) is not None:
+                    found, value = key, params[key]
+                    break
+            if found is None:
+                if field.get("required"):
+                    if aliases:
+                        return f"Missing required parameter '{name}' (or '{', '.join(aliases)}')"
+                    return f"Missing required parameter '{name}'"
+                continue
+            field_type = field.get("type", "")
+            check = _TYPE_CHECKS.get(field_type)
+            if check and not check(value):
+                return f"Parameter '{found}' must be {_TYPE_WORDING.get(field_type, field_type)}"
+            if field.get("one_of"):
+                error = _check_one_of(found, value, field["one_of"])
+                if error:
+                    return error
+        return None
+
+
+class SchemaCache:
+    """
+    Fetches the schema once per process, on first use; thread-safe.
+
+    fetch sends bridge_schema and returns the raw response. Without a schema
+    requests go unvalidated: a failed fetch (not connected, timeout) is retried
+    on the next request, a plugin without bridge_schema is not asked again.
+    """
+
+    def __init__(self, fetch: Callable[[], Optional[Dict[str, Any]]]):
+        self._fetch = fetch
+        self._lock = threading.Lock()
+        self._schema: Optional[CommandSchema] = None
+        self._unavailable = False
+
+    def get(self) -> Optional[CommandSchema]:
+        with self._lock:
+            if self._schema is None and not self._unavailable:
+                response = self._fetch()
+                result = (response or {}).get("result")
+                if isinstance(result, dict) and "commands" in result:
+                    self._schema = CommandSchema(result)
+                elif "Unknown command" in str((response or {}).get("error", "")):
+                    self._unavailable = True
+            return self._schema
+
+    def reset(self):
+        """Forget the schema (reconnected to a rebuilt plugin)."""
+        with self._lock:
+            self._schema = None
+            self._unavailable = False
+
+    def validate(self, command: str, params: Optional[Dict[str, Any]]) -> Optional[str]:
+        schema = self.get()
+        return schema.validate(command, params) if schema else None
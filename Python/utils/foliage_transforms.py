@@ -0,0 +1,75 @@
+"""
+Packed foliage instance records (foliage_export / foliage_import).
+
+Each instance is 48 little-endian bytes:
+
+    location  float64 x3   world units
+    rotation  float32 x3   pitch, yaw, roll in degrees
+    scale     float32 x3
+
+foliage_export returns the records in chunks of base64 "data" (or a
+shared-memory handle); foliage_import takes the same "data", or the nine
+numbers per instance flattened into "transforms".
+"""
+
+import base64
+import struct
+from typing import Any, Dict, Iterable, List, Sequence, Tuple
+
+RECORD = struct.Struct("<3d6f")
+RECORD_SIZE = RECORD.size  # 48
+
+Instance = Tuple[float, float, float, float, float, float, float, float, float]
+
+
+def pack_instances(instances: Iterable[Sequence[float]]) -> bytes:
+    """Pack (x, y, z, pitch, yaw, roll, sx, sy, sz) tuples into records."""
+    return b"".join(RECORD.pack(*instance) for instance in instances)
+
+
+def unpack_instances(data: bytes) -> List[Instance]:
+    """Records back to (x, y, z, pitch, yaw, roll, sx, sy, sz) tuples."""
+    if len(data) % RECORD_SIZE:
+        raise ValueError(f"{len(data)} bytes is not a multiple of the {RECORD_SIZE}-byte record")
+    return list(RECORD.iter_unpack(data))
+
+
+def encode_instances(instances: Iterable[Sequence[float]]) -> str:
+    """Base64 "data" for a foliage_import entry."""
+    return base64.b64encode(pack_instances(instances)).decode("ascii")
+
+
+def decode_export(result: Dict[str, Any]) -> Dict[str, List[Instance]]:
+    """
+    Instances of a foliage_export result by mesh (or foliage_type, or name),
+    in the order their chunks were sent.
+
+    Chunks still holding a shared-memory handle must be resolved first
+    (utils.shared_memory.resolve_base64_field(chunk, "data")).
+    """
+    by_type: Dict[str, List[Instance]] = {}
+    for entry in result.get("types", []):
+        key = entry.get("mesh") or entry.get("foliage_type") or entry.get("name", "")
+        instances = by_type.setdefault(key, [])
+        for chunk in sorted(entry.get("chunks", []), key=lambda c: c.get("seq", 0)):
+            if "data" not in chunk:
+                raise ValueError(f"chunk {chunk.get('seq')} of {key} has no data: "
+                                 f"{chunk.get('shared_memory_error', 'unresolved shared_memory handle')}")
+            instances.extend(unpack_instances(base64.b64decode(chunk["data"])))
+    return by_type
+
+
+def export_to_import(result: Dict[str, Any]) -> List[Dict[str, Any]]:
+    """
+    "types" for foliage_import from a foliage_export result, without decoding
+    the records: each chunk becomes one entry, and the plugin merges entries of
+    the same type into a single bulk add.
+    """
+    entries = []
+    for entry in result.get("types", []):
+        target = {k: entry[k] for k in ("mesh", "foliage_type") if k in entry}
+        for chunk in entry.get("chunks", []):
+            if "data" not in chunk:
+                raise ValueError(f"chunk {chunk.get('seq')} has no data; resolve shared_memory handles first")
+            entries.append({**target, "data": chunk["data"]})
+    return entries
@@ -0,0 +1,128 @@
+"""
+Wire framing for the TCP link to the Unreal plugin.
+
+Every message is sent as a 6-byte header followed by the payload:
+
+    [0xFE marker][flags][payload length, uint32 big-endian][payload bytes]
+
+The plugin answers with the same framing, so responses of any size are read
+in one pass without guessing where the JSON document ends. The low nibble of
+the flags byte selects the payload encoding (UTF-8 JSON or CBOR); the plugin
+replies in the encoding the request used.
+
+Requests carry FLAG_ACCEPT_COMPRESSED, so large responses (64 KB and up) come
+back zlib-compressed with FLAG_COMPRESSED set. A compressed payload is the
+uncompressed length (uint32 big-endian) followed by the zlib stream.
+"""
+
+import json
+import socket
+import struct
+import zlib
+from typing import Any, Dict, Tuple
+
+from utils import cbor
+
+FRAME_MARKER = 0xFE
+HEADER_SIZE = 6
+MAX_FRAME_SIZE = 256 * 1024 * 1024
+
+# Payload encodings carried in the flags byte (low nibble)
+FLAG_JSON = 0x00
+FLAG_CBOR = 0x01
+PAYLOAD_ENCODING_MASK = 0x0F
+
+# Transforms (high nibble)
+FLAG_COMPRESSED = 0x10
+FLAG_ACCEPT_COMPRESSED = 0x20
+
+_HEADER = struct.Struct(">BBI")
+
+
+def encode_frame(payload: bytes, flags: int = FLAG_JSON) -> bytes:
+    """Prefix a payload with the frame header."""
+    if len(payload) > MAX_FRAME_SIZE:
+        raise ValueError(f"Frame of {len(payload)} bytes exceeds the {MAX_FRAME_SIZE} byte limit")
+    return _HEADER.pack(FRAME_MARKER, flags, len(payload)) + payload
+
+
+def encode_json_frame(message: Dict[str, Any], flags: int = FLAG_ACCEPT_COMPRESSED) -> bytes:
+    """Serialize a message as UTF-8 JSON and frame it."""
+    return encode_frame(json.dumps(message, ensure_ascii=False).encode("utf-8"), FLAG_JSON | flags)
+
+
+def encode_cbor_frame(message: Dict[str, Any], flags: int = FLAG_ACCEPT_COMPRESSED) -> bytes:
+    """Serialize a message as CBOR (numeric lists packed) and frame it."""
+    return encode_frame(cbor.dumps(message), FLAG_CBOR | flags)
+
+
+def compress_payload(payload: bytes) -> bytes:
+    """Compress a payload for a FLAG_COMPRESSED frame."""
+    return struct.pack(">I", len(payload)) + zlib.compress(payload)
+
+
+def decompress_payload(payload: bytes) -> bytes:
+    """Inflate a FLAG_COMPRESSED payload, checking it against its length prefix."""
+    if len(payload) < 4:
+        raise ValueError("Compressed payload is missing its length prefix")
+    (length,) = struct.unpack(">I", payload[:4])
+    if length > MAX_FRAME_SIZE:
+        raise ValueError(f"Compressed payload inflates to {length} bytes, over the {MAX_FRAME_SIZE} byte limit")
+    inflater = zlib.decompressobj()
+    data = inflater.decompress(payload[4:], length)
+    if len(data) != length or inflater.unconsumed_tail:
+        raise ValueError("Compressed payload does not match its length prefix")
+    return data
+
+
+def decode_payload(flags: int, payload: bytes) -> Any:
+    """Decode a frame payload according to its flags."""
+    if flags & FLAG_COMPRESSED:
+        payload = decompress_payload(payload)
+    encoding = flags & PAYLOAD_ENCODING_MASK
+    if encoding == FLAG_JSON:
+        return json.loads(payload.decode("utf-8"))
+    if encoding == FLAG_CBOR:
+        return cbor.loads(payload)
+    raise ValueError(f"Unsupported payload encoding 0x{encoding:02X}")
+
+
+def decode_header(header: bytes) -> Tuple[int, int]:
+    """
+    Parse a frame header.
+
+    Returns:
+        (flags, payload_length)
+    """
+    if len(header) != HEADER_SIZE:
+        raise ValueError(f"Frame header must be {HEADER_SIZE} bytes, got {len(header)}")
+    marker, flags, length = _HEADER.unpack(header)
+    if marker != FRAME_MARKER:
+        raise ValueError(f"Invalid frame marker 0x{marker:02X}")
+    if length > MAX_FRAME_SIZE:
+        raise ValueError(f"Frame of {length} bytes exceeds the {MAX_FRAME_SIZE} byte limit")
+    return flags, length
+
+
+def _recv_exact(sock: socket.socket, size: int) -> bytes:
+    """Read exactly `size` bytes or raise if the peer closes first."""
+    buffer = bytearray(size)
+    view = memoryview(buffer)
+    received = 0
+    while received < size:
+        count = sock.recv_into(view[received:], size - received)
+        if count == 0:
+            raise ConnectionError("Connection closed before the full frame was received")
+        received += count
+    return bytes(buffer)
+
+
+def read_frame(sock: socket.socket) -> Tuple[int, bytes]:
+    """
+    Read one complete frame from a socket.
+
+    Returns:
+        (flags, payload)
+    """
+    flags, length = decode_header(_recv_exact(sock, HEADER_SIZE))
+    return flags, _recv_exact(sock, length)
@@ -4,10 +4,16 @@ Common utilities to avoid code duplication across tool files.
 """
 
 import logging
+import os
 from typing import Dict, Any, Optional, List
 
+from utils.command_schema import SchemaCache
+
 logger = logging.getLogger("UnrealCompanion")
 
+# Requests are checked against the plugin's bridge_schema before they are sent; "false" sends them unchecked
+VALIDATE_REQUESTS = os.environ.get("UNREAL_MCP_VALIDATE", "true").lower() != "false"
+
 
 def get_unreal_connection():
     """Get connection to Unreal Engine. Centralized import."""
@@ -15,6 +21,12 @@ def get_unreal_connection():
     return _get_connection()
 
 
+def get_router():
+    """Get the multi-editor router (None with a single editor). Centralized import."""
+    from unreal_mcp_server import get_router as _get_router
+    return _get_router()
+
+
 def send_command(command: str, params: Dict[str, Any]) -> Dict[str, Any]:
     """
     Send a command to Unreal Engine with standard error handling.
@@ -34,12 +46,21 @@ def send_command(command: str, params: Dict[str, Any]) -> Dict[str, Any]:
     logger.info(f">>> {command}({params_summary})")
     
     try:
-        unreal = get_unreal_connection()
-        if not unreal:
-            logger.error(f"<<< {command} FAILED: No connection")
-            return {"success": False, "error": "Failed to connect to Unreal Engine"}
-        
-        response = unreal.send_command(command, params)
+        # Requests the bridge would answer INVALID_PARAMS never leave the process
+        invalid = _schema_cache.validate(command, params) if VALIDATE_REQUESTS else None
+        if invalid:
+            logger.error(f"<<< {command} INVALID (client-side): {invalid}")
+            return {"status": "error", "error": invalid, "error_code": "INVALID_PARAMS"}
+
+        router = get_router()
+        if router:
+            response = router.send_command(command, params)
+        else:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error(f"<<< {command} FAILED: No connection")
+                return {"success": False, "error": "Failed to connect to Unreal Engine"}
+            response = unreal.send_command(command, params)
         elapsed = (time.time() - start_time) * 1000  # ms
         
         if response is None:
@@ -61,6 +82,18 @@ def send_command(command: str, params: Dict[str, Any]) -> Dict[str, Any]:
         return {"success": False, "error": str(e)}
 
 
+def _fetch_schema() -> Optional[Dict[str, Any]]:
+    """bridge_schema from the editor (any one when routing: every instance runs the same plugin)."""
+    router = get_router()
+    if router:
+        return router.send_command("bridge_schema", {})
+    unreal = get_unreal_connection()
+    return unreal.send_command("bridge_schema", {}) if unreal else None
+
+
+_schema_cache = SchemaCache(_fetch_schema)
+
+
 def _summarize_params(params: Dict[str, Any], max_length: int = 100) -> str:
     """Summarize params for logging (truncate large values)."""
     if not params:
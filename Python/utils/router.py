@@ -0,0 +1,248 @@
+"""
+Router that shards commands across several editor processes.
+
+One editor runs every command on one game thread. To generate content for
+independent maps and folders in parallel, start one editor per shard, each
+on its own port (-UnrealCompanionPort=), and list them in
+UNREAL_MCP_INSTANCES. Each instance can own content path prefixes:
+
+    UNREAL_MCP_INSTANCES="55557=/Game/Forest,/Game/Maps/Forest;55558=/Game/Desert;55559"
+
+Routing, per command:
+- A content path in the params (path, *_path, blueprint_name, level, ...)
+  goes to the instance owning its longest matching prefix. That instance
+  becomes the active one, so later level-scoped commands that name no path
+  (world_*, actors, lights, core_save) follow it: level affinity.
+- A path no instance owns goes to the least busy instance that owns no
+  prefixes (the shared pool); with no pool, to the active instance.
+- No path at all goes to the active instance (the first one until a path
+  was routed).
+- core_query without an owned path runs on every instance at once and
+  the pages are merged (see merge_query_results).
+
+Without UNREAL_MCP_INSTANCES the server talks to one editor as before.
+"""
+
+import base64
+import json
+import logging
+import threading
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import dataclass
+from typing import Any, Callable, Dict, List, Optional, Sequence, Tuple
+
+logger = logging.getLogger("UnrealCompanion")
+
+# Prefix of a cursor that holds one cursor per instance
+ROUTER_CURSOR_PREFIX = "router:"
+
+# Params whose string values are content paths
+_PATH_KEYS = ("path", "blueprint_name", "level", "level_name", "map", "destination",
+              "package", "folder", "asset", "target", "parent")
+_PATH_LIST_KEYS = ("paths", "assets", "asset_paths", "instances", "packages")
+
+# Query types whose results are per-editor, not per-project: kept from every instance
+_PER_INSTANCE_QUERY_TYPES = ("actor", "job")
+
+SendFunc = Callable[[int, str, Dict[str, Any]], Optional[Dict[str, Any]]]
+
+
+@dataclass
+class Instance:
+    """One editor bridge."""
+    port: int
+    prefixes: Tuple[str, ...] = ()
+    in_flight: int = 0
+
+    def match_length(self, path: str) -> int:
+        """Length of the longest owned prefix of path, 0 if none."""
+        best = 0
+        for prefix in self.prefixes:
+            if path == prefix or path.startswith(prefix.rstrip("/") + "/") or path.startswith(prefix + "."):
+                best = max(best, len(prefix))
+        return best
+
+
+def parse_instances(spec: str) -> List[Instance]:
+    """Parse "port=prefix,prefix;port;..." into instances, in order."""
+    instances = []
+    for entry in spec.split(";"):
+        entry = entry.strip()
+        if not entry:
+            continue
+        port_text, _, prefix_text = entry.partition("=")
+        prefixes = tuple(p.strip().rstrip("/") for p in prefix_text.split(",") if p.strip())
+        instances.append(Instance(port=int(port_text.strip()), prefixes=prefixes))
+    if len({i.port for i in instances}) != len(instances):
+        raise ValueError(f"UNREAL_MCP_INSTANCES lists a port twice: {spec}")
+    return instances
+
+
+def extract_paths(params: Dict[str, Any]) -> List[str]:
+    """Content paths named in params, in parameter order (one level into lists and objects)."""
+    paths = []
+
+    def add(value):
+        if isinstance(value, str) and value.startswith("/"):
+            paths.append(value)
+        elif isinstance(value, dict):
+            for key, inner in value.items():
+                if key in _PATH_KEYS or key.endswith("_path"):
+                    add(inner)
+
+    for key, value in (params or {}).items():
+        if key in _PATH_KEYS or key.endswith("_path"):
+            add(value)
+        elif key in _PATH_LIST_KEYS and isinstance(value, list):
+            for item in value:
+                add(item)
+    return paths
+
+
+def encode_router_cursor(cursors: Dict[int, str]) -> str:
+    raw = json.dumps({str(port): cursor for port, cursor in cursors.items()}, separators=(",", ":"))
+    return ROUTER_CURSOR_PREFIX + base64.urlsafe_b64encode(raw.encode("utf-8")).decode("ascii")
+
+
+def decode_router_cursor(cursor: str) -> Dict[int, str]:
+    raw = base64.urlsafe_b64decode(cursor[len(ROUTER_CURSOR_PREFIX):].encode("ascii"))
+    return {int(port): value for port, value in json.loads(raw).items()}
+
+
+def merge_query_results(query_type: str, action: str, responses: Dict[int, Dict[str, Any]]) -> Dict[str, Any]:
+    """
+    Merge one core_query page from each instance.
+
+    Actor (and job) results are per editor: all are kept, each tagged with its
+    instance port, and total_found adds up. Assets, folders and nodes come from
+    the shared project on disk, so results are de-duplicated by path (or
+    blueprint/graph/id) and total_found is the largest instance count. The page
+    holds each instance's own page; next_cursor resumes every instance that has
+    more.
+    """
+    ok = {port: r for port, r in responses.items() if r and r.get("status") == "success"}
+    errors = {str(port): (r or {}).get("error", "No response") for port, r in responses.items() if port not in ok}
+    if not ok:
+        return {"status": "error", "error": "core_query failed on every instance", "instance_errors": errors}
+
+    per_instance = query_type in _PER_INSTANCE_QUERY_TYPES
+    merged: Dict[str, Any] = {"success": True, "type": query_type, "action": action}
+    results: List[Dict[str, Any]] = []
+    seen = set()
+    total_found = 0
+    cursors: Dict[int, str] = {}
+
+    for port, response in ok.items():
+        result = response.get("result") or {}
+        if action == "exists":
+            merged["exists"] = merged.get("exists", False) or bool(result.get("exists"))
+            continue
+        for item in result.get("results", []):
+            if per_instance:
+                item = dict(item, instance=port)
+            else:
+                key = item.get("path") or (item.get("blueprint"), item.get("graph"), item.get("id"))
+                if key in seen:
+                    continue
+                seen.add(key)
+            results.append(item)
+        found = result.get("total_found", len(result.get("results", [])))
+        total_found = total_found + found if per_instance else max(total_found, found)
+        if result.get("next_cursor"):
+            cursors[port] = result["next_cursor"]
+
+    if action != "exists":
+        merged["results"] = results
+        merged["count"] = len(results)
+        merged["total_found"] = total_found
+        merged["has_more"] = bool(cursors)
+        if cursors:
+            merged["next_cursor"] = encode_router_cursor(cursors)
+    merged["instances"] = sorted(ok)
+    if errors:
+        merged["instance_errors"] = errors
+    return {"status": "success", "result": merged}
+
+
+class CommandRouter:
+    """Routes commands across editor instances; thread-safe."""
+
+    def __init__(self, instances: Sequence[Instance], send: SendFunc):
+        if not instances:
+            raise ValueError("CommandRouter needs at least one instance")
+        self.instances = list(instances)
+        self._send = send
+        self._lock = threading.Lock()
+        self._active = self.instances[0]
+
+    def owner_of(self, path: str) -> Optional[Instance]:
+        best, best_length = None, 0
+        for instance in self.instances:
+            length = instance.match_length(path)
+            if length > best_length:
+                best, best_length = instance, length
+        return best
+
+    def route(self, command: str, params: Dict[str, Any]) -> Instance:
+        """Instance that should run command; updates the active instance."""
+        paths = extract_paths(params)
+        with self._lock:
+            for path in paths:
+                owner = self.owner_of(path)
+                if owner is not None:
+                    self._active = owner
+                    return owner
+            if paths:
+                pool = [i for i in self.instances if not i.prefixes]
+                if pool:
+                    return min(pool, key=lambda i: i.in_flight)
+            return self._active
+
+    def should_fan_out(self, command: str, params: Dict[str, Any]) -> bool:
+        if command != "core_query" or len(self.instances) < 2:
+            return False
+        cursor = params.get("cursor")
+        if cursor and not cursor.startswith(ROUTER_CURSOR_PREFIX):
+            return False
+        return not any(self.owner_of(path) for path in extract_paths(params))
+
+    def send_command(self, command: str, params: Dict[str, Any]) -> Optional[Dict[str, Any]]:
+        if self.should_fan_out(command, params):
+            return self._fan_out_query(params)
+        return self._send_to(self.route(command, params), command, params)
+
+    def _send_to(self, instance: Instance, command: str, params: Dict[str, Any]) -> Optional[Dict[str, Any]]:
+        with self._lock:
+            instance.in_flight += 1
+        try:
+            logger.debug(f"Routing {command} to :{instance.port}")
+            return self._send(instance.port, command, params)
+        finally:
+            with self._lock:
+                instance.in_flight -= 1
+
+    def _fan_out_query(self, params: Dict[str, Any]) -> Dict[str, Any]:
+        targets: Dict[int, Dict[str, Any]] = {}
+        cursor = params.get("cursor")
+        if cursor:
+            try:
+                cursors = decode_router_cursor(cursor)
+            except (ValueError, json.JSONDecodeError) as e:
+                return {"status": "error", "error": f"Malformed router cursor: {e}"}
+            for instance in self.instances:
+                if instance.port in cursors:
+                    targets[instance.port] = dict(params, cursor=cursors[instance.port])
+        else:
+            targets = {instance.port: params for instance in self.instances}
+
+        by_port = {instance.port: instance for instance in self.instances}
+        with ThreadPoolExecutor(max_workers=len(targets) or 1) as pool:
+            futures = {port: pool.submit(self._send_to, by_port[port], "core_query", p) for port, p in targets.items()}
+            responses = {}
+            for port, future in futures.items():
+                try:
+                    responses[port] = future.result()
+                except Exception as e:  # one editor down must not sink the others' results
+                    responses[port] = {"status": "error", "error": str(e)}
+
+        return merge_query_results(params.get("type", ""), params.get("action", "list"), responses)
@@ -0,0 +1,115 @@
+"""
+Reader for the plugin's shared-memory ring (large binary results).
+
+When the server runs on the same machine as the editor, commands that
+produce bulk bytes (viewport_screenshot with shared_memory=True, ...) can
+leave them in a named shared-memory region instead of inlining base64 in
+the reply. The reply then carries a handle:
+
+    {"name": "UnrealCompanion_1234", "size": 67108864,
+     "offset": 4112, "length": 183920, "sequence": 17}
+
+The region starts with a 64-byte header ("UCSHM001", region size); each
+record is [sequence uint64 LE][length uint64 LE][data]. The ring is never
+acknowledged: the plugin overwrites the oldest records, zeroing their
+headers first, so the record header is checked before and after the copy.
+A blob that was overwritten raises SharedBlobUnavailable; ask again.
+"""
+
+import base64
+import struct
+from multiprocessing import shared_memory
+from typing import Any, Dict
+
+MAGIC = b"UCSHM001"
+HEADER_SIZE = 64
+RECORD_HEADER_SIZE = 16
+
+_RECORD_HEADER = struct.Struct("<QQ")
+
+# Mapped regions by name; a region lives as long as the editor process
+_regions: Dict[str, shared_memory.SharedMemory] = {}
+
+
+class SharedBlobUnavailable(Exception):
+    """The handle's region cannot be opened, or its record was overwritten."""
+
+
+def _open_region(name: str) -> shared_memory.SharedMemory:
+    region = _regions.get(name)
+    if region is not None:
+        return region
+    try:
+        try:
+            # 3.13+: do not let the resource tracker unlink the editor's region on exit
+            region = shared_memory.SharedMemory(name=name, create=False, track=False)
+        except TypeError:
+            region = shared_memory.SharedMemory(name=name, create=False)
+            _untrack(region)
+    except (FileNotFoundError, OSError, ValueError) as e:
+        raise SharedBlobUnavailable(f"Cannot open shared memory region {name}: {e}") from e
+    if bytes(region.buf[:len(MAGIC)]) != MAGIC:
+        region.close()
+        raise SharedBlobUnavailable(f"{name} is not an Unreal Companion shared memory region")
+    _regions[name] = region
+    return region
+
+
+def _untrack(region: shared_memory.SharedMemory) -> None:
+    try:
+        from multiprocessing import resource_tracker
+        resource_tracker.unregister(region._name, "shared_memory")  # noqa: SLF001
+    except Exception:
+        pass
+
+
+def _record_matches(buf: memoryview, offset: int, length: int, sequence: int) -> bool:
+    return _RECORD_HEADER.unpack_from(buf, offset - RECORD_HEADER_SIZE) == (sequence, length)
+
+
+def read_blob(handle: Dict[str, Any]) -> bytes:
+    """Copy the bytes a handle points at out of the ring."""
+    name = handle["name"]
+    offset = int(handle["offset"])
+    length = int(handle["length"])
+    sequence = int(handle["sequence"])
+
+    region = _open_region(name)
+    buf = region.buf
+    if offset - RECORD_HEADER_SIZE < HEADER_SIZE or offset + length > len(buf):
+        raise SharedBlobUnavailable(f"Handle out of range for {name}")
+
+    if not _record_matches(buf, offset, length, sequence):
+        raise SharedBlobUnavailable(f"Record {sequence} was overwritten before it was read")
+    data = bytes(buf[offset:offset + length])
+    if not _record_matches(buf, offset, length, sequence):
+        raise SharedBlobUnavailable(f"Record {sequence} was overwritten while it was read")
+    return data
+
+
+def resolve_base64_field(result: Dict[str, Any], field: str) -> Dict[str, Any]:
+    """
+    Replace result["shared_memory"] with the blob base64-encoded in result[field].
+
+    Leaves the result alone if it has no handle. If the blob is gone, the handle
+    stays and "shared_memory_error" explains why.
+    """
+    handle = result.get("shared_memory") if isinstance(result, dict) else None
+    if not isinstance(handle, dict):
+        return result
+    try:
+        result[field] = base64.b64encode(read_blob(handle)).decode("ascii")
+        del result["shared_memory"]
+    except SharedBlobUnavailable as e:
+        result["shared_memory_error"] = str(e)
+    return result
+
+
+def close_all() -> None:
+    """Unmap every region (the editor owns and removes them)."""
+    for region in _regions.values():
+        try:
+            region.close()
+        except BufferError:
+            pass
+    _regions.clear()